@@ -0,0 +1,182 @@
+//===-- flang/benchmarks/RuntimeBenchmarks.cpp ------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Benchmarks of the runtime's MATMUL and reduction intrinsics on contiguous
+// arrays, which take their fast paths, and on array sections, which do not.
+
+#include "../runtime/cpp-type.h"
+#include "../runtime/descriptor.h"
+#include "../runtime/matmul.h"
+#include "../runtime/reduction.h"
+#include "benchmark/benchmark.h"
+#include <cstdint>
+
+using namespace Fortran::runtime;
+using Fortran::common::TypeCategory;
+
+namespace {
+
+// Returns an allocated array of the given shape whose elements alternate
+// between 2 and 0.5, so that neither the sums nor the products overflow.
+template <TypeCategory CAT, int KIND>
+OwningPtr<Descriptor> MakeArray(SubscriptValue rows, SubscriptValue columns) {
+  using Element = CppTypeFor<CAT, KIND>;
+  int rank{columns > 0 ? 2 : 1};
+  auto result{Descriptor::Create(CAT, KIND, nullptr, rank, nullptr,
+      CFI_attribute_allocatable)};
+  result->GetDimension(0).SetBounds(1, rows);
+  if (rank == 2) {
+    result->GetDimension(1).SetBounds(1, columns);
+  }
+  result->Allocate();
+  Element *p{result->OffsetElement<Element>()};
+  for (std::size_t j{0}; j < result->Elements(); ++j) {
+    p[j] = static_cast<Element>(j % 2 == 0 ? 2.0 : 0.5);
+  }
+  return result;
+}
+
+// Establishes 'section' as every other column of the rank-2 'array'.
+void MakeColumnSection(Descriptor &section, const Descriptor &array) {
+  section.Establish(array.type(), array.ElementBytes(), nullptr, 2, nullptr,
+      CFI_attribute_pointer);
+  section.raw().base_addr = array.raw().base_addr;
+  section.GetDimension(0) = array.GetDimension(0);
+  auto &columns{section.GetDimension(1)};
+  columns.SetBounds(1, (array.GetDimension(1).Extent() + 1) / 2);
+  columns.SetByteStride(2 * array.GetDimension(1).ByteStride());
+}
+
+// MATMUL of two square matrices into a preallocated result.
+template <TypeCategory CAT, int KIND>
+void BM_Matmul(benchmark::State &state) {
+  SubscriptValue n{state.range(0)};
+  auto x{MakeArray<CAT, KIND>(n, n)};
+  auto y{MakeArray<CAT, KIND>(n, n)};
+  auto result{MakeArray<CAT, KIND>(n, n)};
+  for (auto _ : state) {
+    RTNAME(MatmulDirect)(*result, *x, *y, __FILE__, __LINE__);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK_TEMPLATE(BM_Matmul, TypeCategory::Real, 4)->Arg(64)->Arg(400);
+BENCHMARK_TEMPLATE(BM_Matmul, TypeCategory::Real, 8)->Arg(64)->Arg(400);
+BENCHMARK_TEMPLATE(BM_Matmul, TypeCategory::Complex, 8)->Arg(64)->Arg(200);
+BENCHMARK_TEMPLATE(BM_Matmul, TypeCategory::Integer, 4)->Arg(64)->Arg(400);
+
+// MATMUL of a vector and a matrix.
+void BM_MatmulVectorMatrix(benchmark::State &state) {
+  SubscriptValue n{state.range(0)};
+  auto v{MakeArray<TypeCategory::Real, 8>(n, 0)};
+  auto y{MakeArray<TypeCategory::Real, 8>(n, n)};
+  auto result{MakeArray<TypeCategory::Real, 8>(n, 0)};
+  for (auto _ : state) {
+    RTNAME(MatmulDirect)(*result, *v, *y, __FILE__, __LINE__);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_MatmulVectorMatrix)->Arg(1000);
+
+// MATMUL whose second argument is not contiguous; it takes the general path.
+void BM_MatmulSection(benchmark::State &state) {
+  SubscriptValue n{state.range(0)};
+  auto x{MakeArray<TypeCategory::Real, 8>(n, n)};
+  auto y{MakeArray<TypeCategory::Real, 8>(n, 2 * n)};
+  auto result{MakeArray<TypeCategory::Real, 8>(n, n)};
+  StaticDescriptor<2> statDesc;
+  Descriptor &ySection{statDesc.descriptor()};
+  MakeColumnSection(ySection, *y);
+  for (auto _ : state) {
+    RTNAME(MatmulDirect)(*result, *x, ySection, __FILE__, __LINE__);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n * n);
+}
+BENCHMARK(BM_MatmulSection)->Arg(64)->Arg(400);
+
+constexpr SubscriptValue reductionElements{1 << 22};
+
+void BM_SumInteger4(benchmark::State &state) {
+  auto x{MakeArray<TypeCategory::Integer, 4>(reductionElements, 0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RTNAME(SumInteger4)(*x, __FILE__, __LINE__));
+  }
+  state.SetItemsProcessed(state.iterations() * reductionElements);
+}
+BENCHMARK(BM_SumInteger4);
+
+void BM_SumReal8(benchmark::State &state) {
+  auto x{MakeArray<TypeCategory::Real, 8>(reductionElements, 0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RTNAME(SumReal8)(*x, __FILE__, __LINE__));
+  }
+  state.SetItemsProcessed(state.iterations() * reductionElements);
+}
+BENCHMARK(BM_SumReal8);
+
+void BM_ProductReal8(benchmark::State &state) {
+  auto x{MakeArray<TypeCategory::Real, 8>(reductionElements, 0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RTNAME(ProductReal8)(*x, __FILE__, __LINE__));
+  }
+  state.SetItemsProcessed(state.iterations() * reductionElements);
+}
+BENCHMARK(BM_ProductReal8);
+
+void BM_MaxvalReal8(benchmark::State &state) {
+  auto x{MakeArray<TypeCategory::Real, 8>(reductionElements, 0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RTNAME(MaxvalReal8)(*x, __FILE__, __LINE__));
+  }
+  state.SetItemsProcessed(state.iterations() * reductionElements);
+}
+BENCHMARK(BM_MaxvalReal8);
+
+void BM_Norm2Real8(benchmark::State &state) {
+  auto x{MakeArray<TypeCategory::Real, 8>(reductionElements, 0)};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RTNAME(Norm2_8)(*x, __FILE__, __LINE__));
+  }
+  state.SetItemsProcessed(state.iterations() * reductionElements);
+}
+BENCHMARK(BM_Norm2Real8);
+
+// SUM of a square matrix with DIM=1 (along the columns) or DIM=2.
+void BM_SumDimReal8(benchmark::State &state) {
+  int dim{static_cast<int>(state.range(0))};
+  SubscriptValue n{2048};
+  auto x{MakeArray<TypeCategory::Real, 8>(n, n)};
+  StaticDescriptor<1, true> statDesc;
+  Descriptor &result{statDesc.descriptor()};
+  for (auto _ : state) {
+    RTNAME(SumDim)(result, *x, dim, __FILE__, __LINE__);
+    result.Destroy();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_SumDimReal8)->Arg(1)->Arg(2);
+
+// SUM of a section that is not contiguous; it takes the general path.
+void BM_SumSectionReal8(benchmark::State &state) {
+  SubscriptValue n{2048};
+  auto x{MakeArray<TypeCategory::Real, 8>(n, 2 * n)};
+  StaticDescriptor<2> statDesc;
+  Descriptor &section{statDesc.descriptor()};
+  MakeColumnSection(section, *x);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RTNAME(SumReal8)(section, __FILE__, __LINE__));
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_SumSectionReal8);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -212,6 +212,13 @@ public:
   /// compilation.
   unsigned needProvenanceRangeToCharBlockMappings_ : 1;
 
+  /// Write a trace of the time spent in each phase of the compilation, in the
+  /// Chrome trace event format (-ftime-trace)
+  unsigned timeTrace_ : 1;
+
+  /// Minimum duration, in microseconds, of the traced events
+  unsigned timeTraceGranularity_ = 500;
+
   /// Input values from `-fget-definition`
   struct GetDefinitionVals {
     unsigned line;
@@ -249,7 +256,7 @@ public:
 public:
   FrontendOptions()
       : showHelp_(false), showVersion_(false), instrumentedParse_(false),
-        needProvenanceRangeToCharBlockMappings_(false) {}
+        needProvenanceRangeToCharBlockMappings_(false), timeTrace_(false) {}
 
   // Return the appropriate input kind for a file extension. For example,
   /// "*.f" would return Language::Fortran.
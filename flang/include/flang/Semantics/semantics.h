@@ -123,6 +123,12 @@ public:
     return *this;
   }
 
+  // The module files that could not be read, so that each one is only
+  // searched for and reported once per compilation
+  std::set<std::string> &unreadableModuleFiles() {
+    return unreadableModuleFiles_;
+  }
+
   const DeclTypeSpec &MakeNumericType(TypeCategory, int kind = 0);
   const DeclTypeSpec &MakeLogicalType(int kind = 0);
 
@@ -202,6 +208,7 @@ private:
       activeIndexVars_;
   UnorderedSymbolSet errorSymbols_;
   std::set<std::string> tempNames_;
+  std::set<std::string> unreadableModuleFiles_;
 };
 
 class Semantics {
@@ -199,6 +199,14 @@ static bool ParseFrontendArgs(FrontendOptions &opts, llvm::opt::ArgList &args,
   opts.outputFile_ = args.getLastArgValue(clang::driver::options::OPT_o);
   opts.showHelp_ = args.hasArg(clang::driver::options::OPT_help);
   opts.showVersion_ = args.hasArg(clang::driver::options::OPT_version);
+  opts.timeTrace_ = args.hasArg(clang::driver::options::OPT_ftime_trace);
+  if (const llvm::opt::Arg *a = args.getLastArg(
+          clang::driver::options::OPT_ftime_trace_granularity_EQ)) {
+    if (llvm::StringRef(a->getValue())
+            .getAsInteger(10, opts.timeTraceGranularity_))
+      diags.Report(clang::diag::err_drv_invalid_value)
+          << a->getAsString(args) << a->getValue();
+  }
 
   // Get the input kind (from the value passed via `-x`)
   InputKind dashX(Language::Unknown);
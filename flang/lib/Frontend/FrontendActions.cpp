@@ -22,6 +22,7 @@
 #include "flang/Semantics/unparse-with-symbols.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/TimeProfiler.h"
 #include <clang/Basic/Diagnostic.h>
 #include <memory>
 
@@ -51,7 +52,10 @@ bool PrescanAction::BeginSourceFileAction(CompilerInstance &c1) {
   Fortran::parser::Options parserOptions = ci.invocation().fortranOpts();
 
   // Prescan. In case of failure, report and return.
-  ci.parsing().Prescan(currentInputPath, parserOptions);
+  {
+    llvm::TimeTraceScope timeScope("Prescan", currentInputPath);
+    ci.parsing().Prescan(currentInputPath, parserOptions);
+  }
 
   if (!ci.parsing().messages().empty() &&
       (ci.invocation().warnAsErr() ||
@@ -86,7 +90,10 @@ bool PrescanAndParseAction::BeginSourceFileAction(CompilerInstance &c1) {
   }
 
   // Prescan. In case of failure, report and return.
-  ci.parsing().Prescan(currentInputPath, parserOptions);
+  {
+    llvm::TimeTraceScope timeScope("Prescan", currentInputPath);
+    ci.parsing().Prescan(currentInputPath, parserOptions);
+  }
 
   if (ci.parsing().messages().AnyFatalError()) {
     const unsigned diagID = ci.diagnostics().getCustomDiagID(
@@ -98,7 +105,10 @@ bool PrescanAndParseAction::BeginSourceFileAction(CompilerInstance &c1) {
   }
 
   // Parse. In case of failure, report and return.
-  ci.parsing().Parse(llvm::outs());
+  {
+    llvm::TimeTraceScope timeScope("Parse", currentInputPath);
+    ci.parsing().Parse(llvm::outs());
+  }
 
   if (ci.parsing().messages().AnyFatalError()) {
     unsigned diagID = ci.diagnostics().getCustomDiagID(
@@ -122,7 +132,10 @@ bool PrescanAndSemaAction::BeginSourceFileAction(CompilerInstance &c1) {
   Fortran::parser::Options parserOptions = ci.invocation().fortranOpts();
 
   // Prescan. In case of failure, report and return.
-  ci.parsing().Prescan(currentInputPath, parserOptions);
+  {
+    llvm::TimeTraceScope timeScope("Prescan", currentInputPath);
+    ci.parsing().Prescan(currentInputPath, parserOptions);
+  }
 
   if (!ci.parsing().messages().empty() &&
       (ci.invocation().warnAsErr() ||
@@ -136,7 +149,10 @@ bool PrescanAndSemaAction::BeginSourceFileAction(CompilerInstance &c1) {
   }
 
   // Parse. In case of failure, report and return.
-  ci.parsing().Parse(llvm::outs());
+  {
+    llvm::TimeTraceScope timeScope("Parse", currentInputPath);
+    ci.parsing().Parse(llvm::outs());
+  }
 
   if (!ci.parsing().messages().empty() &&
       (ci.invocation().warnAsErr() ||
@@ -162,7 +178,10 @@ bool PrescanAndSemaAction::BeginSourceFileAction(CompilerInstance &c1) {
   auto &semantics = this->semantics();
 
   // Run semantic checks
-  semantics.Perform();
+  {
+    llvm::TimeTraceScope timeScope("Semantic analysis", currentInputPath);
+    semantics.Perform();
+  }
 
   // Report the diagnostics from the semantic checks
   semantics.EmitMessages(ci.semaOutputStream());
@@ -18,6 +18,7 @@
 #include "flang/Semantics/tools.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <fstream>
@@ -804,12 +805,17 @@ Scope *ModFileReader::Read(const SourceName &name, Scope *ancestor) {
       return it->second->scope();
     }
   }
+  auto path{ModFileName(name, ancestorName, context_.moduleFileSuffix())};
+  if (context_.unreadableModuleFiles().count(path) > 0) {
+    // This file could not be read for an earlier USE, which reported why.
+    return nullptr;
+  }
+  llvm::TimeTraceScope timeScope{"Read module file", path};
   parser::Parsing parsing{context_.allCookedSources()};
   parser::Options options;
   options.isModuleFile = true;
   options.features.Enable(common::LanguageFeature::BackslashEscapes);
   options.searchDirectories = context_.searchDirectories();
-  auto path{ModFileName(name, ancestorName, context_.moduleFileSuffix())};
   const auto *sourceFile{parsing.Prescan(path, options)};
   if (parsing.messages().AnyFatalError()) {
     for (auto &msg : parsing.messages().messages()) {
@@ -854,9 +860,12 @@ Scope *ModFileReader::Read(const SourceName &name, Scope *ancestor) {
   return modSymbol.scope();
 }
 
+// Report an error reading a module file; later USEs of it report nothing
 parser::Message &ModFileReader::Say(const SourceName &name,
     const std::string &ancestor, parser::MessageFixedText &&msg,
     const std::string &arg) {
+  context_.unreadableModuleFiles().insert(
+      ModFileName(name, ancestor, context_.moduleFileSuffix()));
   return context_.Say(name, "Cannot read module file for %s: %s"_err_en_US,
       parser::MessageFormattedText{ancestor.empty()
               ? "module '%s'"_en_US
@@ -18,6 +18,8 @@
 #include "io-stmt.h"
 #include "terminator.h"
 #include "flang/Common/uint128.h"
+#include <algorithm>
+#include <limits>
 
 namespace Fortran::runtime::io::descr {
 template <typename A>
@@ -30,6 +32,19 @@ inline A &ExtractElement(IoStatementState &io, const Descriptor &descriptor,
   return *p;
 }
 
+// On output, a repeated data edit descriptor like 10I5 is applied to as many
+// consecutive elements as it can be at once, rather than being looked up
+// again in the FORMAT for each of them.
+template <Direction DIR>
+inline int MaxDataEditRepeat(std::size_t remainingElements) {
+  if constexpr (DIR == Direction::Output) {
+    return static_cast<int>(std::min<std::size_t>(
+        remainingElements, std::numeric_limits<int>::max()));
+  } else {
+    return 1;
+  }
+}
+
 // Per-category descriptor-based I/O templates
 
 // TODO (perhaps as a nontrivial but small starter project): implement
@@ -42,23 +57,27 @@ inline bool FormattedIntegerIO(
   std::size_t numElements{descriptor.Elements()};
   SubscriptValue subscripts[maxRank];
   descriptor.GetLowerBounds(subscripts);
-  for (std::size_t j{0}; j < numElements; ++j) {
-    if (auto edit{io.GetNextDataEdit()}) {
-      A &x{ExtractElement<A>(io, descriptor, subscripts)};
-      if constexpr (DIR == Direction::Output) {
-        if (!EditIntegerOutput(io, *edit, static_cast<std::int64_t>(x))) {
-          return false;
+  for (std::size_t j{0}; j < numElements;) {
+    if (auto edit{io.GetNextDataEdit(
+            MaxDataEditRepeat<DIR>(numElements - j))}) {
+      for (int k{std::max(1, edit->repeat)}; k > 0; --k, ++j) {
+        A &x{ExtractElement<A>(io, descriptor, subscripts)};
+        if constexpr (DIR == Direction::Output) {
+          if (!EditIntegerOutput(io, *edit, static_cast<std::int64_t>(x))) {
+            return false;
+          }
+        } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
+          if (!EditIntegerInput(io, *edit, reinterpret_cast<void *>(&x),
+                  static_cast<int>(sizeof(A)))) {
+            return false;
+          }
         }
-      } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
-        if (!EditIntegerInput(io, *edit, reinterpret_cast<void *>(&x),
-                static_cast<int>(sizeof(A)))) {
-          return false;
+        if (!descriptor.IncrementSubscripts(subscripts) &&
+            j + 1 < numElements) {
+          io.GetIoErrorHandler().Crash(
+              "FormattedIntegerIO: subscripts out of bounds");
         }
       }
-      if (!descriptor.IncrementSubscripts(subscripts) && j + 1 < numElements) {
-        io.GetIoErrorHandler().Crash(
-            "FormattedIntegerIO: subscripts out of bounds");
-      }
     } else {
       return false;
     }
@@ -73,22 +92,26 @@ inline bool FormattedRealIO(
   SubscriptValue subscripts[maxRank];
   descriptor.GetLowerBounds(subscripts);
   using RawType = typename RealOutputEditing<KIND>::BinaryFloatingPoint;
-  for (std::size_t j{0}; j < numElements; ++j) {
-    if (auto edit{io.GetNextDataEdit()}) {
-      RawType &x{ExtractElement<RawType>(io, descriptor, subscripts)};
-      if constexpr (DIR == Direction::Output) {
-        if (!RealOutputEditing<KIND>{io, x}.Edit(*edit)) {
-          return false;
+  for (std::size_t j{0}; j < numElements;) {
+    if (auto edit{io.GetNextDataEdit(
+            MaxDataEditRepeat<DIR>(numElements - j))}) {
+      for (int k{std::max(1, edit->repeat)}; k > 0; --k, ++j) {
+        RawType &x{ExtractElement<RawType>(io, descriptor, subscripts)};
+        if constexpr (DIR == Direction::Output) {
+          if (!RealOutputEditing<KIND>{io, x}.Edit(*edit)) {
+            return false;
+          }
+        } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
+          if (!EditRealInput<KIND>(io, *edit, reinterpret_cast<void *>(&x))) {
+            return false;
+          }
         }
-      } else if (edit->descriptor != DataEdit::ListDirectedNullValue) {
-        if (!EditRealInput<KIND>(io, *edit, reinterpret_cast<void *>(&x))) {
-          return false;
+        if (!descriptor.IncrementSubscripts(subscripts) &&
+            j + 1 < numElements) {
+          io.GetIoErrorHandler().Crash(
+              "FormattedRealIO: subscripts out of bounds");
         }
       }
-      if (!descriptor.IncrementSubscripts(subscripts) && j + 1 < numElements) {
-        io.GetIoErrorHandler().Crash(
-            "FormattedRealIO: subscripts out of bounds");
-      }
     } else {
       return false;
     }
@@ -9,9 +9,54 @@
 #include "edit-output.h"
 #include "flang/Common/uint128.h"
 #include <algorithm>
+#include <cstring>
 
 namespace Fortran::runtime::io {
 
+// Assembles the parts of a numeric output field so that they can be emitted
+// all at once, rather than each digit string, point, and run of padding by
+// a separate Emit() through the I/O statement and unit.
+class OutputField {
+public:
+  explicit OutputField(IoStatementState &io) : io_{io} {}
+  bool Append(const char *p, std::size_t n) {
+    if (length_ + n > sizeof buffer_) {
+      if (!Flush()) {
+        return false;
+      }
+      if (n > sizeof buffer_) {
+        return io_.Emit(p, n);
+      }
+    }
+    std::memcpy(buffer_ + length_, p, n);
+    length_ += n;
+    return true;
+  }
+  bool AppendRepeated(char ch, std::size_t n) {
+    if (length_ + n > sizeof buffer_) {
+      if (!Flush()) {
+        return false;
+      }
+      if (n > sizeof buffer_) {
+        return io_.EmitRepeated(ch, n);
+      }
+    }
+    std::memset(buffer_ + length_, ch, n);
+    length_ += n;
+    return true;
+  }
+  bool Flush() {
+    std::size_t n{length_};
+    length_ = 0;
+    return n == 0 || io_.Emit(buffer_, n);
+  }
+
+private:
+  IoStatementState &io_;
+  std::size_t length_{0};
+  char buffer_[128];
+};
+
 template <typename INT, typename UINT>
 bool EditIntegerOutput(IoStatementState &io, const DataEdit &edit, INT n) {
   char buffer[130], *end = &buffer[sizeof buffer], *p = end;
@@ -87,9 +132,11 @@ bool EditIntegerOutput(IoStatementState &io, const DataEdit &edit, INT n) {
     }
     leadingSpaces = 1;
   }
-  return io.EmitRepeated(' ', leadingSpaces) &&
-      io.Emit(n < 0 ? "-" : "+", signChars) &&
-      io.EmitRepeated('0', leadingZeroes) && io.Emit(p, digits);
+  OutputField field{io};
+  return field.AppendRepeated(' ', leadingSpaces) &&
+      field.Append(n < 0 ? "-" : "+", signChars) &&
+      field.AppendRepeated('0', leadingZeroes) && field.Append(p, digits) &&
+      field.Flush();
 }
 
 // Formats the exponent (see table 13.1 for all the cases)
@@ -241,15 +288,17 @@ bool RealOutputEditing<binaryPrecision>::EditEorDOutput(const DataEdit &edit) {
       zeroesBeforePoint = 1;
       ++totalLength;
     }
+    OutputField field{io_};
     return EmitPrefix(edit, totalLength, width) &&
-        io_.Emit(converted.str, signLength + digitsBeforePoint) &&
-        io_.EmitRepeated('0', zeroesBeforePoint) &&
-        io_.Emit(edit.modes.editingFlags & decimalComma ? "," : ".", 1) &&
-        io_.EmitRepeated('0', zeroesAfterPoint) &&
-        io_.Emit(
+        field.Append(converted.str, signLength + digitsBeforePoint) &&
+        field.AppendRepeated('0', zeroesBeforePoint) &&
+        field.Append(edit.modes.editingFlags & decimalComma ? "," : ".", 1) &&
+        field.AppendRepeated('0', zeroesAfterPoint) &&
+        field.Append(
             converted.str + signLength + digitsBeforePoint, digitsAfterPoint) &&
-        io_.EmitRepeated('0', trailingZeroes) &&
-        io_.Emit(exponent, expoLength) && EmitSuffix(edit);
+        field.AppendRepeated('0', trailingZeroes) &&
+        field.Append(exponent, expoLength) && field.Flush() &&
+        EmitSuffix(edit);
   }
 }
 
@@ -311,15 +360,17 @@ bool RealOutputEditing<binaryPrecision>::EditFOutput(const DataEdit &edit) {
       zeroesBeforePoint = 1;
       ++totalLength;
     }
+    OutputField field{io_};
     return EmitPrefix(edit, totalLength, width) &&
-        io_.Emit(converted.str, signLength + digitsBeforePoint) &&
-        io_.EmitRepeated('0', zeroesBeforePoint) &&
-        io_.Emit(edit.modes.editingFlags & decimalComma ? "," : ".", 1) &&
-        io_.EmitRepeated('0', zeroesAfterPoint) &&
-        io_.Emit(
+        field.Append(converted.str, signLength + digitsBeforePoint) &&
+        field.AppendRepeated('0', zeroesBeforePoint) &&
+        field.Append(edit.modes.editingFlags & decimalComma ? "," : ".", 1) &&
+        field.AppendRepeated('0', zeroesAfterPoint) &&
+        field.Append(
             converted.str + signLength + digitsBeforePoint, digitsAfterPoint) &&
-        io_.EmitRepeated('0', trailingZeroes) &&
-        io_.EmitRepeated(' ', trailingBlanks_) && EmitSuffix(edit);
+        field.AppendRepeated('0', trailingZeroes) &&
+        field.AppendRepeated(' ', trailingBlanks_) && field.Flush() &&
+        EmitSuffix(edit);
   }
 }
 
@@ -373,32 +373,46 @@ DataEdit FormatControl<CONTEXT>::GetNextDataEdit(
   int repeat{CueUpNextDataEdit(context)};
   auto start{offset_};
   DataEdit edit;
-  edit.descriptor = static_cast<char>(Capitalize(GetNextChar(context)));
-  if (edit.descriptor == 'E') {
-    edit.variation = static_cast<char>(Capitalize(PeekNext()));
-    if (edit.variation >= 'A' && edit.variation <= 'Z') {
-      ++offset_;
+  ParsedDataEdits::Entry &parsed{context.parsedDataEdits()[start]};
+  if (parsed.start == start) {
+    edit.descriptor = parsed.descriptor;
+    edit.variation = parsed.variation;
+    edit.width = parsed.width;
+    edit.digits = parsed.digits;
+    edit.expoDigits = parsed.expoDigits;
+    offset_ = parsed.end;
+  } else {
+    edit.descriptor = static_cast<char>(Capitalize(GetNextChar(context)));
+    if (edit.descriptor == 'E') {
+      edit.variation = static_cast<char>(Capitalize(PeekNext()));
+      if (edit.variation >= 'A' && edit.variation <= 'Z') {
+        ++offset_;
+      }
     }
-  }
 
-  if (edit.descriptor == 'A') { // width is optional for A[w]
-    auto ch{PeekNext()};
-    if (ch >= '0' && ch <= '9') {
+    if (edit.descriptor == 'A') { // width is optional for A[w]
+      auto ch{PeekNext()};
+      if (ch >= '0' && ch <= '9') {
+        edit.width = GetIntField(context);
+      }
+    } else {
       edit.width = GetIntField(context);
     }
-  } else {
-    edit.width = GetIntField(context);
-  }
-  edit.modes = context.mutableModes();
-  if (PeekNext() == '.') {
-    ++offset_;
-    edit.digits = GetIntField(context);
-    CharType ch{PeekNext()};
-    if (ch == 'e' || ch == 'E' || ch == 'd' || ch == 'D') {
+    if (PeekNext() == '.') {
       ++offset_;
-      edit.expoDigits = GetIntField(context);
+      edit.digits = GetIntField(context);
+      CharType ch{PeekNext()};
+      if (ch == 'e' || ch == 'E' || ch == 'd' || ch == 'D') {
+        ++offset_;
+        edit.expoDigits = GetIntField(context);
+      }
+    }
+    if (!context.InError()) {
+      parsed = ParsedDataEdits::Entry{start, offset_, edit.descriptor,
+          edit.variation, edit.width, edit.digits, edit.expoDigits};
     }
   }
+  edit.modes = context.mutableModes();
 
   // Handle repeated nonparenthesized edit descriptors
   if (repeat > 1) {
@@ -59,8 +59,32 @@ struct DataEdit {
   int repeat{1};
 };
 
+// The data edit descriptors that a FormatControl parsed most recently,
+// indexed by their offsets in the FORMAT, so that repeated and reverted
+// edit descriptors need not be parsed again for each data item.  This is
+// kept by the I/O statement rather than in FormatControl, which must stay
+// small; see GetNeededSize().
+class ParsedDataEdits {
+public:
+  struct Entry {
+    int start{-1}; // offset in the FORMAT of the descriptor
+    int end{0}; // offset in the FORMAT just after it
+    char descriptor{'\0'};
+    char variation{'\0'};
+    std::optional<int> width;
+    std::optional<int> digits;
+    std::optional<int> expoDigits;
+  };
+  Entry &operator[](int start) { return entries_[start % maxEntries]; }
+
+private:
+  static constexpr int maxEntries{4};
+  Entry entries_[maxEntries];
+};
+
 // FormatControl<A> requires that A have these member functions;
 // these default implementations just crash if called.
+// A must also have mutableModes() and parsedDataEdits().
 struct DefaultFormatControlCallbacks : public IoErrorHandler {
   using IoErrorHandler::IoErrorHandler;
   DataEdit GetNextDataEdit(int = 1);
@@ -404,8 +404,10 @@ ExternalFileUnit *IoStatementState::GetExternalFileUnit() const {
 bool IoStatementState::EmitRepeated(char ch, std::size_t n) {
   return std::visit(
       [=](auto &x) {
-        for (std::size_t j{0}; j < n; ++j) {
-          if (!x.get().Emit(&ch, 1)) {
+        char chunk[64];
+        std::memset(chunk, ch, std::min(n, sizeof chunk));
+        for (std::size_t j{0}; j < n; j += sizeof chunk) {
+          if (!x.get().Emit(chunk, std::min(n - j, sizeof chunk))) {
             return false;
           }
         }
@@ -48,7 +48,13 @@ struct OutputStatementState {};
 template <Direction D>
 using IoDirectionState = std::conditional_t<D == Direction::Input,
     InputStatementState, OutputStatementState>;
-struct FormattedIoStatementState {};
+class FormattedIoStatementState {
+public:
+  ParsedDataEdits &parsedDataEdits() { return parsedDataEdits_; }
+
+private:
+  ParsedDataEdits parsedDataEdits_;
+};
 
 // The Cookie type in the I/O API is a pointer (for C) to this class.
 class IoStatementState {
@@ -24,6 +24,7 @@
 #include "descriptor.h"
 #include "terminator.h"
 #include "tools.h"
+#include <algorithm>
 
 namespace Fortran::runtime {
 
@@ -52,6 +53,59 @@ private:
   Result sum_{};
 };
 
+// Fast paths for MATMUL of numeric arrays that are all contiguous.
+//
+// The general implementation below computes each element of the result as
+// a dot product, visiting the elements of the arguments by subscripts.
+// Here, the rows of X are processed in blocks, and the partial sums for
+// a block of a column of the result are kept in a local array.  So the
+// innermost loop runs over a column of X with unit stride and without a
+// loop-carried dependence, which allows it to be vectorized, and each
+// block of X is reused from cache for every column of Y.  The elements of
+// the result are still accumulated in the order of K and in the precision
+// of the Accumulator, so the results are the same.
+static constexpr SubscriptValue matmulRowBlock{64};
+
+// M*M -> M, and M*V -> V with cols == 1
+template <typename ACCUM, typename RESULT, typename XT, typename YT>
+static inline void MatrixTimesMatrix(RESULT *product, SubscriptValue rows,
+    SubscriptValue cols, const XT *x, const YT *y, SubscriptValue n) {
+  ACCUM sums[matmulRowBlock];
+  for (SubscriptValue i0{0}; i0 < rows; i0 += matmulRowBlock) {
+    SubscriptValue block{std::min(rows - i0, matmulRowBlock)};
+    for (SubscriptValue j{0}; j < cols; ++j) {
+      for (SubscriptValue i{0}; i < block; ++i) {
+        sums[i] = ACCUM{};
+      }
+      const XT *xColumn{x + i0};
+      const YT *yColumn{y + j * n};
+      for (SubscriptValue k{0}; k < n; ++k, xColumn += rows) {
+        ACCUM yValue{static_cast<ACCUM>(yColumn[k])};
+        for (SubscriptValue i{0}; i < block; ++i) {
+          sums[i] += static_cast<ACCUM>(xColumn[i]) * yValue;
+        }
+      }
+      RESULT *resultColumn{product + i0 + j * rows};
+      for (SubscriptValue i{0}; i < block; ++i) {
+        resultColumn[i] = sums[i];
+      }
+    }
+  }
+}
+
+// V*M -> V
+template <typename ACCUM, typename RESULT, typename XT, typename YT>
+static inline void VectorTimesMatrix(RESULT *product, SubscriptValue cols,
+    const XT *x, const YT *y, SubscriptValue n) {
+  for (SubscriptValue j{0}; j < cols; ++j, y += n) {
+    ACCUM sum{};
+    for (SubscriptValue k{0}; k < n; ++k) {
+      sum += static_cast<ACCUM>(x[k]) * static_cast<ACCUM>(y[k]);
+    }
+    product[j] = sum;
+  }
+}
+
 // Implements an instance of MATMUL for given argument types.
 template <bool IS_ALLOCATING, TypeCategory RCAT, int RKIND, typename XT,
     typename YT>
@@ -93,6 +147,22 @@ static inline void DoMatmul(
         static_cast<std::intmax_t>(n),
         static_cast<std::intmax_t>(y.GetDimension(0).Extent()));
   }
+  if constexpr (RCAT != TypeCategory::Logical) {
+    if (x.IsContiguous() && y.IsContiguous() && result.IsContiguous()) {
+      using Accum = typename Accumulator<RCAT, RKIND, XT, YT>::Result;
+      WriteResult *product{result.template OffsetElement<WriteResult>()};
+      const XT *xp{x.OffsetElement<XT>()};
+      const YT *yp{y.OffsetElement<YT>()};
+      if (resRank == 2) { // M*M -> M
+        MatrixTimesMatrix<Accum>(product, extent[0], extent[1], xp, yp, n);
+      } else if (xRank == 2) { // M*V -> V
+        MatrixTimesMatrix<Accum>(product, extent[0], 1, xp, yp, n);
+      } else { // V*M -> V
+        VectorTimesMatrix<Accum>(product, extent[0], xp, yp, n);
+      }
+      return;
+    }
+  }
   SubscriptValue xAt[2], yAt[2], resAt[2];
   x.GetLowerBounds(xAt);
   y.GetLowerBounds(yAt);
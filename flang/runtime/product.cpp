@@ -23,10 +23,13 @@ public:
   template <typename A> void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(product_);
   }
-  template <typename A> bool AccumulateAt(const SubscriptValue at[]) {
-    product_ *= *array_.Element<A>(at);
+  template <typename A> bool Accumulate(A x) {
+    product_ *= x;
     return product_ != 0;
   }
+  template <typename A> bool AccumulateAt(const SubscriptValue at[]) {
+    return Accumulate(*array_.Element<A>(at));
+  }
 
 private:
   const Descriptor &array_;
@@ -42,10 +45,13 @@ public:
     *p = {static_cast<ResultPart>(product_.real()),
         static_cast<ResultPart>(product_.imag())};
   }
-  template <typename A> bool AccumulateAt(const SubscriptValue at[]) {
-    product_ *= *array_.Element<A>(at);
+  template <typename A> bool Accumulate(const A &z) {
+    product_ *= z;
     return true;
   }
+  template <typename A> bool AccumulateAt(const SubscriptValue at[]) {
+    return Accumulate(*array_.Element<A>(at));
+  }
 
 private:
   const Descriptor &array_;
@@ -25,6 +25,8 @@
 #include "descriptor.h"
 #include "terminator.h"
 #include "tools.h"
+#include <type_traits>
+#include <utility>
 
 namespace Fortran::runtime {
 
@@ -35,6 +37,17 @@ namespace Fortran::runtime {
 // AccumulateAt() member function that applies supplied subscripts to the
 // array and does something with a scalar element, and a GetResult()
 // member function that copies a final result into its destination.
+// Accumulators whose results do not depend on the positions of the elements
+// also support an Accumulate() member function that takes an element's
+// value; contiguous arrays and the elements along a dimension are then
+// visited with a pointer, without any subscript arithmetic.
+
+template <typename ACCUMULATOR, typename TYPE, typename = void>
+struct AccumulatesValues : std::false_type {};
+template <typename ACCUMULATOR, typename TYPE>
+struct AccumulatesValues<ACCUMULATOR, TYPE,
+    std::void_t<decltype(std::declval<ACCUMULATOR &>().Accumulate(
+        std::declval<const TYPE &>()))>> : std::true_type {};
 
 // Total reduction of the array argument to a scalar (or to a vector in the
 // cases of FINDLOC, MAXLOC, & MINLOC).  These are the cases without DIM= or
@@ -67,6 +80,17 @@ inline void DoTotalReduction(const Descriptor &x, int dim,
     }
   }
   // No MASK=, or scalar MASK=.TRUE.
+  if constexpr (AccumulatesValues<ACCUMULATOR, TYPE>::value) {
+    if (x.IsContiguous()) {
+      const TYPE *p{x.OffsetElement<TYPE>()};
+      for (auto elements{x.Elements()}; elements--; ++p) {
+        if (!accumulator.Accumulate(*p)) {
+          break; // cut short, result is known
+        }
+      }
+      return;
+    }
+  }
   for (auto elements{x.Elements()}; elements--; x.IncrementSubscripts(xAt)) {
     if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
       break; // cut short, result is known
@@ -117,11 +141,20 @@ inline void ReduceDimToScalar(const Descriptor &x, int zeroBasedDim,
   SubscriptValue xAt[maxRank];
   GetExpandedSubscripts(xAt, x, zeroBasedDim, subscripts);
   const auto &dim{x.GetDimension(zeroBasedDim)};
-  SubscriptValue at{dim.LowerBound()};
-  for (auto n{dim.Extent()}; n-- > 0; ++at) {
-    xAt[zeroBasedDim] = at;
-    if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
-      break;
+  if constexpr (AccumulatesValues<ACCUMULATOR, TYPE>::value) {
+    const char *p{x.Element<char>(xAt)};
+    for (auto n{dim.Extent()}; n-- > 0; p += dim.ByteStride()) {
+      if (!accumulator.Accumulate(*reinterpret_cast<const TYPE *>(p))) {
+        break;
+      }
+    }
+  } else {
+    SubscriptValue at{dim.LowerBound()};
+    for (auto n{dim.Extent()}; n-- > 0; ++at) {
+      xAt[zeroBasedDim] = at;
+      if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
+        break;
+      }
     }
   }
 #ifdef _MSC_VER // work around MSVC spurious error
@@ -27,10 +27,13 @@ public:
   template <typename A> void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(xor_);
   }
-  template <typename A> bool AccumulateAt(const SubscriptValue at[]) {
-    xor_ ^= *array_.Element<A>(at);
+  template <typename A> bool Accumulate(A x) {
+    xor_ ^= x;
     return true;
   }
+  template <typename A> bool AccumulateAt(const SubscriptValue at[]) {
+    return Accumulate(*array_.Element<A>(at));
+  }
 
 private:
   const Descriptor &array_;
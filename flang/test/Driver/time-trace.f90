@@ -0,0 +1,20 @@
+! Test that -ftime-trace writes a trace in the Chrome trace format, with an
+! event for each phase of the frontend.
+
+! RUN: rm -rf %t && mkdir -p %t
+! RUN: %flang_fc1 -fsyntax-only -ftime-trace -ftime-trace-granularity=0 -o %t/time-trace.o %s
+! RUN: cat %t/time-trace.json \
+! RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+! RUN:   | FileCheck %s
+
+! CHECK:      "beginningOfTime": {{[0-9]{16},}}
+! CHECK-NEXT: "traceEvents": [
+! CHECK-DAG:  "name": "Prescan"
+! CHECK-DAG:  "name": "Parse"
+! CHECK-DAG:  "name": "Semantic analysis"
+! CHECK-DAG:  "detail": "{{.*}}time-trace.f90"
+! CHECK-DAG:  "name": "process_name"
+
+program p
+  print *, 'hello'
+end program
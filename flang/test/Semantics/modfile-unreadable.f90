@@ -0,0 +1,21 @@
+! Test that a module file that cannot be read is reported once, at its first
+! USE, and not again for each later USE of the same module.
+
+! RUN: rm -rf %t && mkdir -p %t
+! RUN: echo 'not a module file' > %t/bad.mod
+! RUN: not %flang_fc1 -fsyntax-only -I %t %s 2>&1 \
+! RUN:   | FileCheck %s --implicit-check-not="Cannot read module file"
+
+! CHECK: error: Cannot read module file for module 'bad': File has invalid checksum:
+
+subroutine s1
+  use bad
+end subroutine
+
+subroutine s2
+  use bad
+end subroutine
+
+program p
+  use bad
+end program
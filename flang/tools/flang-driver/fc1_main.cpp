@@ -20,6 +20,8 @@
 #include "llvm/Option/Arg.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptTable.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #include <cstdio>
 
@@ -53,9 +55,33 @@ int fc1_main(llvm::ArrayRef<const char *> argv, const char *argv0) {
   if (!success)
     return 1;
 
+  const FrontendOptions &frontendOpts = flang->frontendOpts();
+  if (frontendOpts.timeTrace_)
+    llvm::timeTraceProfilerInitialize(
+        frontendOpts.timeTraceGranularity_, argv0);
+
   // Execute the frontend actions.
   success = ExecuteCompilerInvocation(flang.get());
 
+  if (llvm::timeTraceProfilerEnabled()) {
+    // Name the trace after the output file, or else after the first input.
+    llvm::SmallString<128> path(frontendOpts.outputFile_);
+    if ((path.empty() || path == "-") && !frontendOpts.inputs_.empty() &&
+        frontendOpts.inputs_[0].IsFile())
+      path = frontendOpts.inputs_[0].file();
+    if (path.empty() || path == "-")
+      path = "flang";
+    llvm::sys::path::replace_extension(path, "json");
+    if (llvm::Error err = llvm::timeTraceProfilerWrite(path, path)) {
+      const unsigned diagID = flang->diagnostics().getCustomDiagID(
+          clang::DiagnosticsEngine::Error, "Could not write time trace %0: %1");
+      flang->diagnostics().Report(diagID)
+          << path << llvm::toString(std::move(err));
+      success = false;
+    }
+    llvm::timeTraceProfilerCleanup();
+  }
+
   // Delete output files to free Compiler Instance
   flang->ClearOutputFiles(/*EraseFiles=*/false);
 
@@ -33,9 +33,11 @@ public:
   void Report(const DataEdit &);
   ResultsTy results;
   MutableModes &mutableModes() { return mutableModes_; }
+  ParsedDataEdits &parsedDataEdits() { return parsedDataEdits_; }
 
 private:
   MutableModes mutableModes_;
+  ParsedDataEdits parsedDataEdits_;
 };
 
 bool TestFormatContext::Emit(const char *s, std::size_t len) {
@@ -96,3 +96,70 @@ TEST(Matmul, Basic) {
   EXPECT_TRUE(
       static_cast<bool>(*result.ZeroBasedIndexedElement<std::uint16_t>(3)));
 }
+
+TEST(Matmul, ContiguousAndStrided) {
+  // X(70,5) is larger than a block of rows; each of its elements is also
+  // stored in every other element of XWIDE(140,5) for a strided view.
+  static constexpr int rows{70}, n{5}, cols{3};
+  std::vector<double> xData, xWideData;
+  for (int k{0}; k < n; ++k) {
+    for (int i{0}; i < rows; ++i) {
+      xData.push_back(i - 2 * k);
+      xWideData.push_back(i - 2 * k);
+      xWideData.push_back(-1000);
+    }
+  }
+  std::vector<float> yData;
+  for (int j{0}; j < cols; ++j) {
+    for (int k{0}; k < n; ++k) {
+      yData.push_back(k + 0.5f * j);
+    }
+  }
+  auto x{MakeArray<TypeCategory::Real, 8>(std::vector<int>{rows, n}, xData)};
+  auto xWide{MakeArray<TypeCategory::Real, 8>(
+      std::vector<int>{2 * rows, n}, xWideData)};
+  auto y{MakeArray<TypeCategory::Real, 4>(std::vector<int>{n, cols}, yData)};
+  auto v{MakeArray<TypeCategory::Real, 4>(
+      std::vector<int>{n}, std::vector<float>{1, -1, 2, -2, 3})};
+  StaticDescriptor<2> stridedStatDesc;
+  Descriptor &xStrided{stridedStatDesc.descriptor()};
+  static const SubscriptValue xExtent[]{rows, n};
+  xStrided.Establish(TypeCategory::Real, 8, xWide->OffsetElement(), 2,
+      xExtent, CFI_attribute_pointer);
+  xStrided.GetDimension(0).SetByteStride(2 * sizeof(double));
+  xStrided.GetDimension(1).SetByteStride(2 * rows * sizeof(double));
+
+  StaticDescriptor<2, true> statDesc;
+  Descriptor &result{statDesc.descriptor()};
+  for (const Descriptor *xArg : {&*x, &xStrided}) {
+    RTNAME(Matmul)(result, *xArg, *y, __FILE__, __LINE__);
+    ASSERT_EQ(result.rank(), 2);
+    EXPECT_EQ(result.GetDimension(0).Extent(), rows);
+    EXPECT_EQ(result.GetDimension(1).Extent(), cols);
+    ASSERT_EQ(result.type(), (TypeCode{TypeCategory::Real, 8}));
+    for (int j{0}; j < cols; ++j) {
+      for (int i{0}; i < rows; ++i) {
+        double expect{0};
+        for (int k{0}; k < n; ++k) {
+          expect += xData[i + k * rows] * yData[k + j * n];
+        }
+        EXPECT_EQ(
+            *result.ZeroBasedIndexedElement<double>(i + j * rows), expect)
+            << "(" << i << "," << j << ")";
+      }
+    }
+    result.Destroy();
+
+    RTNAME(Matmul)(result, *xArg, *v, __FILE__, __LINE__);
+    ASSERT_EQ(result.rank(), 1);
+    EXPECT_EQ(result.GetDimension(0).Extent(), rows);
+    for (int i{0}; i < rows; ++i) {
+      double expect{0};
+      for (int k{0}; k < n; ++k) {
+        expect += xData[i + k * rows] * *v->ZeroBasedIndexedElement<float>(k);
+      }
+      EXPECT_EQ(*result.ZeroBasedIndexedElement<double>(i), expect) << i;
+    }
+    result.Destroy();
+  }
+}
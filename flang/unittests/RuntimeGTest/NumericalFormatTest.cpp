@@ -242,6 +242,71 @@ TEST(IOApiTests, DescriptorOutputTest) {
       << std::string{buffer, sizeof buffer} << "'";
 }
 
+TEST(IOApiTests, ArrayOutputTest) {
+  static constexpr int bufferSize{64};
+  char buffer[bufferSize];
+  static constexpr int rank{1};
+  static constexpr int extent{5};
+  static const SubscriptValue extents[]{extent};
+  StaticDescriptor<rank> staticDescriptor;
+  Descriptor &desc{staticDescriptor.descriptor()};
+
+  // Repeated edit descriptors apply to several elements at once, up to the
+  // end of the array or of the repetition.
+  std::int32_t integers[extent]{1, -22, 333, 0, 55555};
+  desc.Establish(TypeCategory::Integer, sizeof integers[0], &integers, rank,
+      extents);
+  std::tuple<const char *, const char *> integerFormats[]{
+      {"(5I6)", "     1   -22   333     0 55555"},
+      {"('[',3I4,']',I3.3,2I4)", "[   1 -22 333]000****"},
+      {"(I2,2(I4,I3))", " 1 -22333   0***"},
+  };
+  for (const auto &[format, expect] : integerFormats) {
+    auto cookie{IONAME(BeginInternalFormattedOutput)(
+        buffer, bufferSize, format, std::strlen(format))};
+    IONAME(OutputDescriptor)(cookie, desc);
+    auto status{IONAME(EndIoStatement)(cookie)};
+    ASSERT_EQ(status, 0) << "arrayOutputTest: '" << format
+                         << "' failed, status " << static_cast<int>(status);
+    EXPECT_TRUE(
+        CompareFormattedStrings(expect, std::string{buffer, sizeof buffer}))
+        << "arrayOutputTest: '" << format << "' got '"
+        << std::string{buffer, sizeof buffer} << "'";
+  }
+
+  double reals[extent]{1.5, -0.25, 1.0e10, 0.0, 3.0};
+  desc.Establish(TypeCategory::Real, sizeof reals[0], &reals, rank, extents);
+  std::tuple<const char *, const char *> realFormats[]{
+      {"(5F7.2)", "   1.50  -0.25*******   0.00   3.00"},
+      {"(2F6.2,2ES10.2,G9.3)", "  1.50 -0.25  1.00E+10  0.00E+00 3.00    "},
+      {"(5(E10.3))",
+          " 0.150E+01-0.250E+00 0.100E+11 0.000E+00 0.300E+01"},
+  };
+  for (const auto &[format, expect] : realFormats) {
+    auto cookie{IONAME(BeginInternalFormattedOutput)(
+        buffer, bufferSize, format, std::strlen(format))};
+    IONAME(OutputDescriptor)(cookie, desc);
+    auto status{IONAME(EndIoStatement)(cookie)};
+    ASSERT_EQ(status, 0) << "arrayOutputTest: '" << format
+                         << "' failed, status " << static_cast<int>(status);
+    EXPECT_TRUE(
+        CompareFormattedStrings(expect, std::string{buffer, sizeof buffer}))
+        << "arrayOutputTest: '" << format << "' got '"
+        << std::string{buffer, sizeof buffer} << "'";
+  }
+
+  // List-directed output of the whole array
+  auto cookie{IONAME(BeginInternalListOutput)(buffer, bufferSize)};
+  IONAME(OutputDescriptor)(cookie, desc);
+  auto status{IONAME(EndIoStatement)(cookie)};
+  ASSERT_EQ(status, 0) << "arrayOutputTest: list-directed failed, status "
+                       << static_cast<int>(status);
+  EXPECT_TRUE(CompareFormattedStrings(" 1.5 -.25 10000000000. 0. 3.",
+      std::string{buffer, sizeof buffer}))
+      << "arrayOutputTest: list-directed got '"
+      << std::string{buffer, sizeof buffer} << "'";
+}
+
 //------------------------------------------------------------------------------
 /// Tests for output formatting real values
 //------------------------------------------------------------------------------
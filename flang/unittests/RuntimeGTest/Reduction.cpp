@@ -28,6 +28,42 @@ TEST(Reductions, SumInt4) {
   EXPECT_EQ(sum, 21) << sum;
 }
 
+TEST(Reductions, SumStrided) {
+  // ARRAY(2:4:2,:) of
+  //   1  5  9
+  //   2  6 10
+  //   3  7 11
+  //   4  8 12
+  auto array{MakeArray<TypeCategory::Real, 8>(std::vector<int>{4, 3},
+      std::vector<double>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12})};
+  StaticDescriptor<2> sectionStatDesc;
+  Descriptor &section{sectionStatDesc.descriptor()};
+  static const SubscriptValue extent[]{2, 3};
+  section.Establish(TypeCategory::Real, 8, array->OffsetElement<double>() + 1,
+      2, extent, CFI_attribute_pointer);
+  section.GetDimension(0).SetByteStride(2 * sizeof(double));
+  section.GetDimension(1).SetByteStride(4 * sizeof(double));
+  EXPECT_EQ(RTNAME(SumReal8)(*array, __FILE__, __LINE__), 78);
+  EXPECT_EQ(RTNAME(SumReal8)(section, __FILE__, __LINE__), 42);
+  EXPECT_EQ(RTNAME(ProductReal8)(section, __FILE__, __LINE__),
+      2.0 * 4 * 6 * 8 * 10 * 12);
+  StaticDescriptor<1, true> statDesc;
+  Descriptor &sum{statDesc.descriptor()};
+  RTNAME(SumDim)(sum, section, 1, __FILE__, __LINE__);
+  EXPECT_EQ(sum.rank(), 1);
+  EXPECT_EQ(sum.GetDimension(0).Extent(), 3);
+  EXPECT_EQ(*sum.ZeroBasedIndexedElement<double>(0), 6);
+  EXPECT_EQ(*sum.ZeroBasedIndexedElement<double>(1), 14);
+  EXPECT_EQ(*sum.ZeroBasedIndexedElement<double>(2), 22);
+  sum.Destroy();
+  RTNAME(SumDim)(sum, section, 2, __FILE__, __LINE__);
+  EXPECT_EQ(sum.rank(), 1);
+  EXPECT_EQ(sum.GetDimension(0).Extent(), 2);
+  EXPECT_EQ(*sum.ZeroBasedIndexedElement<double>(0), 18);
+  EXPECT_EQ(*sum.ZeroBasedIndexedElement<double>(1), 24);
+  sum.Destroy();
+}
+
 TEST(Reductions, DimMaskProductInt4) {
   std::vector<int> shape{2, 3};
   auto array{MakeArray<TypeCategory::Integer, 4>(
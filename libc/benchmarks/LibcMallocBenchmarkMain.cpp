@@ -0,0 +1,382 @@
+//===-- Multithreaded malloc benchmark ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Each thread keeps a fixed number of live blocks and repeatedly replaces a
+// random one with a new block, whose size follows one of the memcpy size
+// distributions or is uniform. Optionally, a share of the blocks is handed to
+// the next thread to free, which exercises the paths returning memory to the
+// thread that did not allocate it.
+//
+// The throughput of the whole process is measured for each thread count.
+//
+// The llvm-libc allocator only knows about the threads created by its own
+// thrd_create, so it is measured on such threads. The host's C library does not
+// know about them, so they must not call its allocator or lock its mutexes:
+// everything they use is allocated up front, and locked with `mtx_lock`.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibcBenchmark.h"
+#include "MemorySizeDistributions.h"
+#include "src/threads/mtx_lock.h"
+#include "src/threads/mtx_unlock.h"
+#include "src/threads/thrd_create.h"
+#include "src/threads/thrd_join.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace __llvm_libc {
+
+extern void *malloc(size_t);
+extern void free(void *);
+
+} // namespace __llvm_libc
+
+namespace llvm {
+namespace libc_benchmarks {
+
+enum Allocator { llvm_libc, system };
+
+static cl::opt<std::string>
+    StudyName("study-name", cl::desc("The name for this study"), cl::Required);
+
+static cl::opt<Allocator> AllocatorUnderTest(
+    "allocator", cl::desc("Sets the allocator to benchmark:"),
+    cl::values(clEnumValN(llvm_libc, "llvm-libc", "__llvm_libc::malloc"),
+               clEnumValN(system, "system", "The host's malloc")),
+    cl::init(llvm_libc));
+
+static cl::list<unsigned>
+    ThreadCountList("thread-counts",
+                    cl::desc("The comma separated thread counts to measure"),
+                    cl::CommaSeparated);
+
+static cl::opt<std::string> SizeDistributionName(
+    "size-distribution-name",
+    cl::desc("The memcpy distribution the allocation sizes follow, sizes are "
+             "uniform up to --max-size if not set"));
+
+static cl::opt<uint32_t>
+    MaxSize("max-size", cl::desc("The maximum size of uniform allocations"),
+            cl::init(1024));
+
+static cl::opt<uint32_t>
+    LiveBlocks("live-blocks",
+               cl::desc("The number of blocks each thread keeps allocated"),
+               cl::init(1024));
+
+static cl::opt<uint32_t> Operations(
+    "operations",
+    cl::desc("The number of malloc/free pairs performed by each thread"),
+    cl::init(1'000'000));
+
+static cl::opt<uint32_t> RemoteFreePercent(
+    "remote-free-percent",
+    cl::desc("The percentage of blocks freed by another thread"),
+    cl::init(0));
+
+static cl::opt<std::string> Output("output",
+                                   cl::desc("Specify output filename"),
+                                   cl::value_desc("filename"), cl::init("-"));
+
+static cl::opt<uint32_t>
+    NumTrials("num-trials", cl::desc("The number of benchmarks run to perform"),
+              cl::init(1));
+
+// Samples are generated ahead of time and cycled through, so that the
+// benchmark measures the allocator rather than the random number generator.
+static constexpr size_t SampleCount = 1 << 14;
+
+struct AllocatorFunctions {
+  void *(*Malloc)(size_t);
+  void (*Free)(void *);
+};
+
+static AllocatorFunctions getAllocatorFunctions() {
+  switch (AllocatorUnderTest) {
+  case llvm_libc:
+    return {&__llvm_libc::malloc, &__llvm_libc::free};
+  case system:
+    return {&::malloc, &::free};
+  }
+  llvm_unreachable("Unknown allocator");
+}
+
+static std::function<unsigned(std::mt19937_64 &)> getSizeSampler() {
+  if (SizeDistributionName.empty()) {
+    if (MaxSize == 0)
+      report_fatal_error("--" + Twine(MaxSize.ArgStr) + " must be positive");
+    const unsigned Max = MaxSize;
+    return [Max](std::mt19937_64 &Gen) {
+      return std::uniform_int_distribution<unsigned>(1, Max)(Gen);
+    };
+  }
+  std::map<StringRef, MemorySizeDistribution> Map;
+  for (MemorySizeDistribution Distribution : getMemcpySizeDistributions())
+    Map[Distribution.Name] = Distribution;
+  if (Map.count(SizeDistributionName) == 0) {
+    std::string Message;
+    raw_string_ostream Stream(Message);
+    Stream << "Unknown --" << SizeDistributionName.ArgStr << "='"
+           << SizeDistributionName << "', available distributions:\n";
+    for (const auto &Pair : Map)
+      Stream << "'" << Pair.first << "'\n";
+    report_fatal_error(Twine(Stream.str()));
+  }
+  const ArrayRef<double> Probabilities =
+      Map[SizeDistributionName].Probabilities;
+  std::discrete_distribution<unsigned> Distribution(Probabilities.begin(),
+                                                    Probabilities.end());
+  return [Distribution](std::mt19937_64 &Gen) mutable {
+    return Distribution(Gen);
+  };
+}
+
+// Blocks handed from one thread to the next for it to free.
+struct RemoteQueue {
+  // A zero initialized `mtx_t` is an unlocked plain mutex.
+  mtx_t Mutex{};
+  std::vector<void *> Blocks;
+};
+
+class QueueLock {
+  RemoteQueue &Queue;
+
+public:
+  explicit QueueLock(RemoteQueue &Queue) : Queue(Queue) {
+    __llvm_libc::mtx_lock(&Queue.Mutex);
+  }
+  ~QueueLock() { __llvm_libc::mtx_unlock(&Queue.Mutex); }
+};
+
+class Worker {
+  const AllocatorFunctions Functions;
+  std::vector<unsigned> Sizes;
+  std::vector<unsigned> Slots;
+  std::vector<bool> Remote;
+  std::vector<void *> Blocks;
+  std::vector<void *> Outgoing;
+  std::vector<void *> Received;
+  RemoteQueue &Inbox;
+  RemoteQueue &Outbox;
+
+  // Frees the blocks other threads handed to this one.
+  void drainInbox() {
+    {
+      QueueLock Lock(Inbox);
+      Received.swap(Inbox.Blocks);
+    }
+    for (void *Block : Received)
+      Functions.Free(Block);
+    Received.clear();
+  }
+
+public:
+  Worker(AllocatorFunctions Functions,
+         std::function<unsigned(std::mt19937_64 &)> SizeSampler,
+         unsigned Seed, RemoteQueue &Inbox, RemoteQueue &Outbox)
+      : Functions(Functions), Sizes(SampleCount), Slots(SampleCount),
+        Remote(SampleCount), Blocks(LiveBlocks), Inbox(Inbox),
+        Outbox(Outbox) {
+    std::mt19937_64 Gen(Seed);
+    std::uniform_int_distribution<unsigned> SlotDistribution(0,
+                                                             LiveBlocks - 1);
+    std::bernoulli_distribution RemoteDistribution(RemoteFreePercent / 100.0);
+    for (size_t I = 0; I < SampleCount; ++I) {
+      Sizes[I] = SizeSampler(Gen);
+      Slots[I] = SlotDistribution(Gen);
+      Remote[I] = RemoteDistribution(Gen);
+    }
+    // At most `SampleCount` blocks are handed over at once, and `Operations`
+    // blocks in all. The received blocks are swapped with the inbox, so both
+    // need the capacity of the whole run.
+    if (RemoteFreePercent != 0) {
+      Outgoing.reserve(SampleCount);
+      Received.reserve(Operations);
+    }
+  }
+
+  void run() {
+    for (size_t I = 0; I < Operations; ++I) {
+      const size_t Sample = I % SampleCount;
+      void *&Block = Blocks[Slots[Sample]];
+      if (Block != nullptr && Remote[Sample])
+        Outgoing.push_back(Block);
+      else
+        Functions.Free(Block);
+      Block = Functions.Malloc(Sizes[Sample]);
+      if (Block == nullptr)
+        report_fatal_error("Out of memory");
+      // Touch the block like a program initializing it would.
+      *static_cast<volatile char *>(Block) = 0;
+      if (Sample == SampleCount - 1) {
+        if (!Outgoing.empty()) {
+          QueueLock Lock(Outbox);
+          Outbox.Blocks.insert(Outbox.Blocks.end(), Outgoing.begin(),
+                               Outgoing.end());
+          Outgoing.clear();
+        }
+        drainInbox();
+      }
+    }
+    for (void *Block : Outgoing)
+      Functions.Free(Block);
+    Outgoing.clear();
+    for (void *&Block : Blocks) {
+      Functions.Free(Block);
+      Block = nullptr;
+    }
+  }
+
+  // Frees what was handed to this thread after all threads are done.
+  void finish() { drainInbox(); }
+};
+
+struct ThreadState {
+  Worker *W;
+  std::atomic<unsigned> *Ready;
+  std::atomic<bool> *Start;
+};
+
+static int runThread(void *Arg) {
+  ThreadState &State = *static_cast<ThreadState *>(Arg);
+  State.Ready->fetch_add(1);
+  while (!State.Start->load())
+    std::this_thread::yield();
+  State.W->run();
+  return 0;
+}
+
+// Returns the duration of `Operations` malloc/free pairs on each of
+// `ThreadCount` threads running concurrently.
+static Duration measure(unsigned ThreadCount, unsigned Trial) {
+  const AllocatorFunctions Functions = getAllocatorFunctions();
+  std::vector<RemoteQueue> Queues(ThreadCount);
+  if (RemoteFreePercent != 0)
+    for (RemoteQueue &Queue : Queues)
+      Queue.Blocks.reserve(Operations);
+  std::vector<std::unique_ptr<Worker>> Workers;
+  for (unsigned I = 0; I < ThreadCount; ++I)
+    Workers.push_back(std::make_unique<Worker>(
+        Functions, getSizeSampler(), Trial * ThreadCount + I, Queues[I],
+        Queues[(I + 1) % ThreadCount]));
+
+  std::atomic<unsigned> Ready(0);
+  std::atomic<bool> Start(false);
+  std::vector<ThreadState> States(ThreadCount);
+  for (unsigned I = 0; I < ThreadCount; ++I)
+    States[I] = {Workers[I].get(), &Ready, &Start};
+  std::vector<thrd_t> LibcThreads;
+  std::vector<std::thread> SystemThreads;
+  if (AllocatorUnderTest == llvm_libc) {
+    LibcThreads.resize(ThreadCount);
+    for (unsigned I = 0; I < ThreadCount; ++I)
+      if (__llvm_libc::thrd_create(&LibcThreads[I], runThread, &States[I]) !=
+          thrd_success)
+        report_fatal_error("Could not create a thread");
+  } else {
+    for (unsigned I = 0; I < ThreadCount; ++I)
+      SystemThreads.emplace_back(runThread, &States[I]);
+  }
+  while (Ready.load() != ThreadCount)
+    std::this_thread::yield();
+
+  const auto StartTime = std::chrono::steady_clock::now();
+  Start.store(true);
+  for (thrd_t &Thread : LibcThreads) {
+    int Result;
+    __llvm_libc::thrd_join(&Thread, &Result);
+  }
+  for (std::thread &Thread : SystemThreads)
+    Thread.join();
+  const auto EndTime = std::chrono::steady_clock::now();
+
+  for (auto &W : Workers)
+    W->finish();
+  return EndTime - StartTime;
+}
+
+static void writeResults(ArrayRef<unsigned> ThreadCounts,
+                         ArrayRef<std::vector<Duration>> Durations) {
+  std::error_code EC;
+  raw_fd_ostream FOS(Output, EC);
+  if (EC)
+    report_fatal_error(Twine("Could not open file: ")
+                           .concat(EC.message())
+                           .concat(", ")
+                           .concat(Output));
+  json::OStream JOS(FOS, /*IndentSize=*/2);
+  JOS.object([&]() {
+    JOS.attribute("StudyName", StudyName);
+    JOS.attribute("Allocator", AllocatorUnderTest == llvm_libc
+                                   ? "llvm-libc"
+                                   : "system");
+    JOS.attribute("SizeDistributionName", SizeDistributionName);
+    JOS.attribute("LiveBlocks", int64_t(LiveBlocks));
+    JOS.attribute("Operations", int64_t(Operations));
+    JOS.attribute("RemoteFreePercent", int64_t(RemoteFreePercent));
+    JOS.attributeArray("Measurements", [&]() {
+      for (size_t I = 0; I < ThreadCounts.size(); ++I)
+        JOS.object([&]() {
+          JOS.attribute("Threads", int64_t(ThreadCounts[I]));
+          // Seconds per malloc/free pair for the whole process.
+          JOS.attributeArray("Seconds", [&]() {
+            for (const Duration D : Durations[I])
+              JOS.value(D.count() / (double(Operations) * ThreadCounts[I]));
+          });
+        });
+    });
+  });
+  FOS << "\n";
+}
+
+void main() {
+  checkRequirements();
+  std::vector<unsigned> ThreadCounts(ThreadCountList.begin(),
+                                    ThreadCountList.end());
+  if (ThreadCounts.empty())
+    ThreadCounts.push_back(1);
+  if (LiveBlocks == 0)
+    report_fatal_error("--" + Twine(LiveBlocks.ArgStr) + " must be positive");
+  if (RemoteFreePercent > 100)
+    report_fatal_error("--" + Twine(RemoteFreePercent.ArgStr) +
+                       " must be at most 100");
+
+  std::vector<std::vector<Duration>> Durations(ThreadCounts.size());
+  for (size_t I = 0; I < ThreadCounts.size(); ++I) {
+    if (ThreadCounts[I] == 0)
+      report_fatal_error("--" + Twine(ThreadCountList.ArgStr) +
+                         " must be positive");
+    for (unsigned Trial = 0; Trial < NumTrials; ++Trial)
+      Durations[I].push_back(measure(ThreadCounts[I], Trial));
+  }
+  writeResults(ThreadCounts, Durations);
+}
+
+} // namespace libc_benchmarks
+} // namespace llvm
+
+int main(int argc, char **argv) {
+  llvm::cl::ParseCommandLineOptions(argc, argv);
+#ifndef NDEBUG
+  static_assert(
+      false,
+      "For reproducibility benchmarks should not be compiled in DEBUG mode.");
+#endif
+  llvm::libc_benchmarks::main();
+  return EXIT_SUCCESS;
+}
@@ -17,17 +17,23 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
 
+#if defined(__i386__) || defined(__x86_64__)
+#include "src/string/x86_64/memory_variants.h"
+#define LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+#endif
+
 namespace __llvm_libc {
 
 extern void *memcpy(void *__restrict, const void *__restrict, size_t);
 extern void *memset(void *, int, size_t);
+extern int memcmp(const void *, const void *, size_t);
 
 } // namespace __llvm_libc
 
 namespace llvm {
 namespace libc_benchmarks {
 
-enum Function { memcpy, memset };
+enum Function { memcpy, memset, memcmp };
 
 static cl::opt<std::string>
     StudyName("study-name", cl::desc("The name for this study"), cl::Required);
@@ -35,9 +41,16 @@ static cl::opt<std::string>
 static cl::opt<Function>
     MemoryFunction("function", cl::desc("Sets the function to benchmark:"),
                    cl::values(clEnumVal(memcpy, "__llvm_libc::memcpy"),
-                              clEnumVal(memset, "__llvm_libc::memset")),
+                              clEnumVal(memset, "__llvm_libc::memset"),
+                              clEnumVal(memcmp, "__llvm_libc::memcmp")),
                    cl::Required);
 
+static cl::opt<std::string> FunctionVariant(
+    "function-variant",
+    cl::desc("The implementation of the function to benchmark, defaults to "
+             "the one selected at runtime for the host.\n"
+             "On x86: sse2, sse2_erms, avx2, avx2_erms, avx512 or avx512_erms"));
+
 static cl::opt<std::string>
     SizeDistributionName("size-distribution-name",
                          cl::desc("The name of the distribution to use"));
@@ -75,44 +88,133 @@ struct ParameterType {
   unsigned SizeBytes : 16;   // max : 16 KiB - 1
 };
 
+#ifdef LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+// Returns the variant named by `--function-variant`.
+static __llvm_libc::x86::MemoryVariant getMemoryVariant() {
+  using namespace __llvm_libc::x86;
+  for (unsigned I = 0; I < kMemoryVariantCount; ++I) {
+    const auto Variant = static_cast<MemoryVariant>(I);
+    if (FunctionVariant != get_variant_name(Variant))
+      continue;
+    if (!is_supported(Variant, get_cpu_features()))
+      report_fatal_error("--" + Twine(FunctionVariant.ArgStr) + "='" +
+                         FunctionVariant + "' is not supported by the host");
+    return Variant;
+  }
+  report_fatal_error("Unknown --" + Twine(FunctionVariant.ArgStr) + "='" +
+                     FunctionVariant + "'");
+}
+#endif
+
+// Returns the implementation to benchmark: the dispatched function or one of
+// its variants.
+template <typename FunctionType, typename GetVariantType>
+static FunctionType getFunction(FunctionType Dispatched,
+                                GetVariantType GetVariant) {
+  if (FunctionVariant.empty())
+    return Dispatched;
+#ifdef LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+  return GetVariant(getMemoryVariant());
+#else
+  (void)GetVariant;
+  report_fatal_error("--" + Twine(FunctionVariant.ArgStr) +
+                     " is not supported on this architecture");
+#endif
+}
+
+// Names the function in the study, suffixed with the variant if any.
+static std::string getFunctionName(StringRef Name) {
+  if (FunctionVariant.empty())
+    return Name.str();
+  return (Name + "_" + FunctionVariant).str();
+}
+
+#ifdef LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+#define LIBC_BENCHMARK_VARIANTS(Name) &__llvm_libc::x86::get_##Name##_variant
+#else
+#define LIBC_BENCHMARK_VARIANTS(Name) nullptr
+#endif
+
 struct MemcpyBenchmark {
   static constexpr auto GetDistributions = &getMemcpySizeDistributions;
   static constexpr size_t BufferCount = 2;
-  static void amend(Study &S) { S.Configuration.Function = "memcpy"; }
+  static void amend(Study &S) {
+    S.Configuration.Function = getFunctionName("memcpy");
+  }
 
   MemcpyBenchmark(const size_t BufferSize)
-      : SrcBuffer(BufferSize), DstBuffer(BufferSize) {}
+      : SrcBuffer(BufferSize), DstBuffer(BufferSize),
+        Function(getFunction(&__llvm_libc::memcpy,
+                             LIBC_BENCHMARK_VARIANTS(memcpy))) {}
 
   inline auto functor() {
     return [this](ParameterType P) {
-      __llvm_libc::memcpy(DstBuffer + P.OffsetBytes, SrcBuffer + P.OffsetBytes,
-                          P.SizeBytes);
+      Function(DstBuffer + P.OffsetBytes, SrcBuffer + P.OffsetBytes,
+               P.SizeBytes);
       return DstBuffer + P.OffsetBytes;
     };
   }
 
   AlignedBuffer SrcBuffer;
   AlignedBuffer DstBuffer;
+  void *(*const Function)(void *__restrict, const void *__restrict, size_t);
 };
 
 struct MemsetBenchmark {
   static constexpr auto GetDistributions = &getMemsetSizeDistributions;
   static constexpr size_t BufferCount = 1;
-  static void amend(Study &S) { S.Configuration.Function = "memset"; }
+  static void amend(Study &S) {
+    S.Configuration.Function = getFunctionName("memset");
+  }
 
-  MemsetBenchmark(const size_t BufferSize) : DstBuffer(BufferSize) {}
+  MemsetBenchmark(const size_t BufferSize)
+      : DstBuffer(BufferSize),
+        Function(getFunction(&__llvm_libc::memset,
+                             LIBC_BENCHMARK_VARIANTS(memset))) {}
 
   inline auto functor() {
     return [this](ParameterType P) {
-      __llvm_libc::memset(DstBuffer + P.OffsetBytes, P.OffsetBytes & 0xFF,
-                          P.SizeBytes);
+      Function(DstBuffer + P.OffsetBytes, P.OffsetBytes & 0xFF, P.SizeBytes);
       return DstBuffer + P.OffsetBytes;
     };
   }
 
   AlignedBuffer DstBuffer;
+  void *(*const Function)(void *, int, size_t);
+};
+
+// Compares buffers of equal contents, which is the worst case for a given
+// size.
+struct MemcmpBenchmark {
+  static constexpr auto GetDistributions = &getMemcmpSizeDistributions;
+  static constexpr size_t BufferCount = 2;
+  static void amend(Study &S) {
+    S.Configuration.Function = getFunctionName("memcmp");
+    S.Configuration.MemcmpMismatchAt = 0;
+  }
+
+  MemcmpBenchmark(const size_t BufferSize)
+      : LhsBuffer(BufferSize), RhsBuffer(BufferSize),
+        Function(getFunction(&__llvm_libc::memcmp,
+                             LIBC_BENCHMARK_VARIANTS(memcmp))) {
+    for (size_t I = 0; I < BufferSize; ++I)
+      LhsBuffer[I] = RhsBuffer[I] = static_cast<char>(I);
+  }
+
+  inline auto functor() {
+    return [this](ParameterType P) {
+      return Function(LhsBuffer + P.OffsetBytes, RhsBuffer + P.OffsetBytes,
+                      P.SizeBytes);
+    };
+  }
+
+  AlignedBuffer LhsBuffer;
+  AlignedBuffer RhsBuffer;
+  int (*const Function)(const void *, const void *, size_t);
 };
 
+#undef LIBC_BENCHMARK_VARIANTS
+
 template <typename Benchmark> struct Harness : Benchmark {
   using Benchmark::functor;
 
@@ -319,6 +421,8 @@ std::unique_ptr<IBenchmark> getMemfunctionBenchmark() {
     return std::make_unique<MemfunctionBenchmark<MemcpyBenchmark>>();
   case memset:
     return std::make_unique<MemfunctionBenchmark<MemsetBenchmark>>();
+  case memcmp:
+    return std::make_unique<MemfunctionBenchmark<MemcmpBenchmark>>();
   }
 }
 
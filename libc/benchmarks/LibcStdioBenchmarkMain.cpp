@@ -0,0 +1,210 @@
+//===-- Log writing stdio benchmark ---------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Writes log lines to a stream the way a service logging its requests would,
+// either with fprintf or with preformatted fwrite calls, and measures the time
+// per line. The same workload runs on the llvm-libc streams or on the host's.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibcBenchmark.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace __llvm_libc {
+
+struct FILE;
+extern FILE *fopen(const char *__restrict, const char *__restrict);
+extern int fclose(FILE *);
+extern int fprintf(FILE *__restrict, const char *__restrict, ...);
+extern size_t fwrite(const void *__restrict, size_t, size_t,
+                     FILE *__restrict);
+
+} // namespace __llvm_libc
+
+namespace llvm {
+namespace libc_benchmarks {
+
+enum Implementation { llvm_libc, system };
+enum Workload { log_lines, float_lines, fwrite_lines };
+
+static cl::opt<std::string>
+    StudyName("study-name", cl::desc("The name for this study"), cl::Required);
+
+static cl::opt<Implementation> ImplementationUnderTest(
+    "implementation", cl::desc("Sets the stdio implementation to benchmark:"),
+    cl::values(clEnumValN(llvm_libc, "llvm-libc", "The __llvm_libc streams"),
+               clEnumValN(system, "system", "The host's streams")),
+    cl::init(llvm_libc));
+
+static cl::opt<Workload> WorkloadUnderTest(
+    "workload", cl::desc("Sets the kind of lines written:"),
+    cl::values(
+        clEnumValN(log_lines, "log", "fprintf of strings and integers"),
+        clEnumValN(float_lines, "float", "fprintf of floating point values"),
+        clEnumValN(fwrite_lines, "fwrite", "fwrite of preformatted lines")),
+    cl::init(log_lines));
+
+static cl::opt<std::string>
+    Target("target", cl::desc("The file the lines are written to"),
+           cl::value_desc("filename"), cl::init("/dev/null"));
+
+static cl::opt<uint32_t> Lines("lines",
+                               cl::desc("The number of lines per trial"),
+                               cl::init(1'000'000));
+
+static cl::opt<std::string> Output("output",
+                                   cl::desc("Specify output filename"),
+                                   cl::value_desc("filename"), cl::init("-"));
+
+static cl::opt<uint32_t>
+    NumTrials("num-trials", cl::desc("The number of benchmarks run to perform"),
+              cl::init(1));
+
+// The fields of the lines are generated ahead of time and cycled through.
+static constexpr size_t SampleCount = 1 << 12;
+
+struct Sample {
+  const char *Level;
+  const char *User;
+  unsigned Status;
+  int RequestId;
+  size_t Bytes;
+  double Latency;
+  char Preformatted[96];
+  size_t PreformattedSize;
+};
+
+static std::vector<Sample> makeSamples() {
+  static const char *const Levels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+  static const char *const Users[] = {"alice", "bob", "carol", "dave",
+                                      "eve-from-accounting"};
+  static const unsigned Statuses[] = {200, 201, 204, 301, 404, 500};
+  std::mt19937_64 Gen(0);
+  std::vector<Sample> Samples(SampleCount);
+  for (size_t I = 0; I < SampleCount; ++I) {
+    Sample &S = Samples[I];
+    S.Level = Levels[Gen() % 4];
+    S.User = Users[Gen() % 5];
+    S.Status = Statuses[Gen() % 6];
+    S.RequestId = static_cast<int>(Gen() % 10'000'000);
+    S.Bytes = Gen() % (1 << 20);
+    S.Latency = std::exponential_distribution<double>(0.1)(Gen);
+    const int Size = ::snprintf(S.Preformatted, sizeof(S.Preformatted),
+                                "[%s] request=%d user=%s status=%u bytes=%zu\n",
+                                S.Level, S.RequestId, S.User, S.Status,
+                                S.Bytes);
+    S.PreformattedSize = static_cast<size_t>(Size);
+  }
+  return Samples;
+}
+
+// Writes the lines with the functions of one implementation.
+template <typename FileT, FileT *(*Open)(const char *, const char *),
+          int (*Close)(FileT *), int (*Printf)(FileT *, const char *, ...),
+          size_t (*Write)(const void *, size_t, size_t, FileT *)>
+static Duration writeLines(ArrayRef<Sample> Samples) {
+  FileT *File = Open(Target.c_str(), "w");
+  if (File == nullptr)
+    report_fatal_error("Could not open " + Twine(Target));
+  const auto StartTime = std::chrono::steady_clock::now();
+  for (size_t I = 0; I < Lines; ++I) {
+    const Sample &S = Samples[I % SampleCount];
+    switch (WorkloadUnderTest) {
+    case log_lines:
+      Printf(File, "[%s] request=%d user=%s status=%u bytes=%zu\n", S.Level,
+             S.RequestId, S.User, S.Status, S.Bytes);
+      break;
+    case float_lines:
+      Printf(File, "[%s] request=%d latency=%.3f ms load=%g\n", S.Level,
+             S.RequestId, S.Latency, S.Latency / 7);
+      break;
+    case fwrite_lines:
+      Write(S.Preformatted, 1, S.PreformattedSize, File);
+      break;
+    }
+  }
+  // Closing flushes what is left in the buffer, which is part of the cost.
+  Close(File);
+  const auto EndTime = std::chrono::steady_clock::now();
+  return EndTime - StartTime;
+}
+
+static Duration measure(ArrayRef<Sample> Samples) {
+  switch (ImplementationUnderTest) {
+  case llvm_libc:
+    return writeLines<__llvm_libc::FILE, &__llvm_libc::fopen,
+                      &__llvm_libc::fclose, &__llvm_libc::fprintf,
+                      &__llvm_libc::fwrite>(Samples);
+  case system:
+    return writeLines<::FILE, &::fopen, &::fclose, &::fprintf, &::fwrite>(
+        Samples);
+  }
+  llvm_unreachable("Unknown implementation");
+}
+
+static void writeResults(ArrayRef<Duration> Durations) {
+  std::error_code EC;
+  raw_fd_ostream FOS(Output, EC);
+  if (EC)
+    report_fatal_error(Twine("Could not open file: ")
+                           .concat(EC.message())
+                           .concat(", ")
+                           .concat(Output));
+  json::OStream JOS(FOS, /*IndentSize=*/2);
+  JOS.object([&]() {
+    JOS.attribute("StudyName", StudyName);
+    JOS.attribute("Implementation", ImplementationUnderTest == llvm_libc
+                                        ? "llvm-libc"
+                                        : "system");
+    JOS.attribute("Workload", WorkloadUnderTest == log_lines ? "log"
+                              : WorkloadUnderTest == float_lines
+                                  ? "float"
+                                  : "fwrite");
+    JOS.attribute("Target", Target);
+    JOS.attribute("Lines", int64_t(Lines));
+    // Seconds per line.
+    JOS.attributeArray("Seconds", [&]() {
+      for (const Duration D : Durations)
+        JOS.value(D.count() / double(Lines));
+    });
+  });
+  FOS << "\n";
+}
+
+void main() {
+  checkRequirements();
+  if (Lines == 0)
+    report_fatal_error("--" + Twine(Lines.ArgStr) + " must be positive");
+  const std::vector<Sample> Samples = makeSamples();
+  std::vector<Duration> Durations;
+  for (unsigned Trial = 0; Trial < NumTrials; ++Trial)
+    Durations.push_back(measure(Samples));
+  writeResults(Durations);
+}
+
+} // namespace libc_benchmarks
+} // namespace llvm
+
+int main(int argc, char **argv) {
+  llvm::cl::ParseCommandLineOptions(argc, argv);
+#ifndef NDEBUG
+  static_assert(
+      false,
+      "For reproducibility benchmarks should not be compiled in DEBUG mode.");
+#endif
+  llvm::libc_benchmarks::main();
+  return EXIT_SUCCESS;
+}
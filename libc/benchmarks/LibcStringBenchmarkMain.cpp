@@ -0,0 +1,347 @@
+//===-- String search benchmark -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures the time per call of one of the string search functions on strings
+// of a given length, placed at every alignment. Each call scans the whole
+// string: the searched characters are at its end, or absent.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LibcBenchmark.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include "src/string/x86_64/memory_variants.h"
+#define LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+#endif
+
+namespace __llvm_libc {
+
+extern size_t strlen(const char *);
+extern char *strchr(const char *, int);
+extern void *memchr(const void *, int, size_t);
+extern char *strstr(const char *, const char *);
+extern size_t strspn(const char *, const char *);
+extern size_t strcspn(const char *, const char *);
+extern char *strpbrk(const char *, const char *);
+
+} // namespace __llvm_libc
+
+namespace llvm {
+namespace libc_benchmarks {
+
+enum Implementation { llvm_libc, system };
+enum Function { strlen, strchr, memchr, strstr, strspn, strcspn, strpbrk };
+
+static cl::opt<std::string>
+    StudyName("study-name", cl::desc("The name for this study"), cl::Required);
+
+static cl::opt<Implementation> ImplementationUnderTest(
+    "implementation", cl::desc("Sets the implementation to benchmark:"),
+    cl::values(clEnumValN(llvm_libc, "llvm-libc", "The __llvm_libc functions"),
+               clEnumValN(system, "system", "The host's functions")),
+    cl::init(llvm_libc));
+
+static cl::opt<Function> StringFunction(
+    "function", cl::desc("Sets the function to benchmark:"),
+    cl::values(clEnumVal(strlen, "strlen"),
+               clEnumVal(strchr, "strchr, of the last character"),
+               clEnumVal(memchr, "memchr, of the last character"),
+               clEnumVal(strstr, "strstr, of the end of the string"),
+               clEnumVal(strspn, "strspn, of a set holding every character"),
+               clEnumVal(strcspn, "strcspn, of a set holding no character"),
+               clEnumVal(strpbrk, "strpbrk, of a set holding no character")),
+    cl::Required);
+
+static cl::opt<std::string> FunctionVariant(
+    "function-variant",
+    cl::desc("The implementation of strlen, strchr or memchr to benchmark, "
+             "defaults to the one selected at runtime for the host.\n"
+             "On x86: sse2 or avx2"));
+
+static cl::opt<uint32_t> Length("length",
+                                cl::desc("The length of the strings"),
+                                cl::init(64));
+
+static cl::opt<uint32_t>
+    NeedleLength("needle-length",
+                 cl::desc("The length of the strstr needle, at most --length"),
+                 cl::init(8));
+
+static cl::opt<uint32_t> SetSize("set-size",
+                                 cl::desc("The number of characters in the "
+                                          "strspn, strcspn and strpbrk set"),
+                                 cl::init(8));
+
+static cl::opt<uint32_t> Calls("calls",
+                               cl::desc("The number of calls per trial"),
+                               cl::init(1'000'000));
+
+static cl::opt<std::string> Output("output",
+                                   cl::desc("Specify output filename"),
+                                   cl::value_desc("filename"), cl::init("-"));
+
+static cl::opt<uint32_t>
+    NumTrials("num-trials", cl::desc("The number of benchmarks run to perform"),
+              cl::init(1));
+
+static const char *const FunctionNames[] = {
+    "strlen", "strchr", "memchr", "strstr", "strspn", "strcspn", "strpbrk"};
+
+// One string per alignment within a cache line.
+static constexpr size_t StringCount = 64;
+
+struct Workload {
+  // The strings, each followed by its terminator.
+  std::vector<char> Buffer;
+  std::vector<const char *> Strings;
+  // The needle of strstr, the set of strspn, strcspn and strpbrk.
+  std::string Argument;
+};
+
+// Strings are made of lower case letters, the sets of strcspn and strpbrk of
+// upper case letters. For strchr, memchr and strstr the end of the strings is
+// unique.
+static Workload makeWorkload() {
+  std::mt19937_64 Gen(0);
+  Workload W;
+  const size_t Stride = alignTo(Length + 1, 64) + 1;
+  W.Buffer.resize(StringCount * Stride + 64);
+  for (size_t I = 0; I < StringCount; ++I) {
+    char *String = W.Buffer.data() + I * Stride;
+    for (size_t J = 0; J < Length; ++J)
+      String[J] = 'a' + Gen() % 26;
+    if (Length > 0 && (StringFunction == strchr || StringFunction == memchr))
+      String[Length - 1] = '!';
+    if (StringFunction == strstr && Length >= NeedleLength)
+      std::memset(String + Length - NeedleLength, '!', NeedleLength);
+    if (StringFunction == strspn)
+      for (size_t J = 0; J < Length; ++J)
+        String[J] = 'a' + Gen() % SetSize;
+    String[Length] = '\0';
+    W.Strings.push_back(String);
+  }
+  switch (StringFunction) {
+  case strstr:
+    W.Argument.assign(NeedleLength, '!');
+    break;
+  case strspn:
+    for (size_t I = 0; I < SetSize; ++I)
+      W.Argument.push_back('a' + I);
+    break;
+  case strcspn:
+  case strpbrk:
+    for (size_t I = 0; I < SetSize; ++I)
+      W.Argument.push_back('A' + I);
+    break;
+  default:
+    break;
+  }
+  return W;
+}
+
+#ifdef LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+// Returns the variant named by `--function-variant`.
+static __llvm_libc::x86::MemoryVariant getMemoryVariant() {
+  using namespace __llvm_libc::x86;
+  for (const MemoryVariant Variant :
+       {MemoryVariant::SSE2, MemoryVariant::AVX2}) {
+    if (FunctionVariant != get_variant_name(Variant))
+      continue;
+    if (!is_supported(Variant, get_cpu_features()))
+      report_fatal_error("--" + Twine(FunctionVariant.ArgStr) + "='" +
+                         FunctionVariant + "' is not supported by the host");
+    return Variant;
+  }
+  report_fatal_error("Unknown --" + Twine(FunctionVariant.ArgStr) + "='" +
+                     FunctionVariant + "'");
+}
+#endif
+
+// Returns the implementation to benchmark: the dispatched function or the
+// host's function.
+template <typename FunctionType>
+static FunctionType getFunction(FunctionType Dispatched, FunctionType System) {
+  if (ImplementationUnderTest == system)
+    return System;
+  if (!FunctionVariant.empty())
+    report_fatal_error("--" + Twine(FunctionVariant.ArgStr) +
+                       " is not supported for this function");
+  return Dispatched;
+}
+
+// Same as above, or one of the variants of the dispatched function.
+template <typename FunctionType, typename GetVariantType>
+static FunctionType getFunction(FunctionType Dispatched, FunctionType System,
+                                GetVariantType GetVariant) {
+  if (ImplementationUnderTest == system || FunctionVariant.empty())
+    return getFunction(Dispatched, System);
+#ifdef LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+  return GetVariant(getMemoryVariant());
+#else
+  (void)GetVariant;
+  report_fatal_error("--" + Twine(FunctionVariant.ArgStr) +
+                     " is not supported on this architecture");
+#endif
+}
+
+#ifdef LIBC_BENCHMARK_HAS_FUNCTION_VARIANTS
+#define LIBC_BENCHMARK_VARIANTS(Name) &__llvm_libc::x86::get_##Name##_variant
+#else
+#define LIBC_BENCHMARK_VARIANTS(Name) nullptr
+#endif
+
+// Calls `Call` on every string in turn and returns the total time. The
+// results are accumulated so that the calls can not be optimized away.
+template <typename CallType>
+static Duration callOnStrings(const Workload &W, CallType Call) {
+  size_t Sink = 0;
+  const auto StartTime = std::chrono::steady_clock::now();
+  for (size_t I = 0; I < Calls; ++I)
+    Sink += Call(W.Strings[I % StringCount]);
+  const auto EndTime = std::chrono::steady_clock::now();
+  benchmark::DoNotOptimize(Sink);
+  return EndTime - StartTime;
+}
+
+static uintptr_t toInteger(const void *Pointer) {
+  return reinterpret_cast<uintptr_t>(Pointer);
+}
+
+// The host's functions, with the signature of the C library rather than the
+// const correct overloads of C++.
+static char *systemStrchr(const char *S, int C) {
+  return const_cast<char *>(::strchr(S, C));
+}
+static void *systemMemchr(const void *S, int C, size_t N) {
+  return const_cast<void *>(::memchr(S, C, N));
+}
+static char *systemStrstr(const char *S, const char *Needle) {
+  return const_cast<char *>(::strstr(S, Needle));
+}
+static char *systemStrpbrk(const char *S, const char *Set) {
+  return const_cast<char *>(::strpbrk(S, Set));
+}
+
+static Duration measure(const Workload &W) {
+  const char *Argument = W.Argument.c_str();
+  const size_t Size = Length;
+  switch (StringFunction) {
+  case strlen: {
+    const auto Function = getFunction<size_t (*)(const char *)>(
+        &__llvm_libc::strlen, &::strlen, LIBC_BENCHMARK_VARIANTS(strlen));
+    return callOnStrings(W, [=](const char *S) { return Function(S); });
+  }
+  case strchr: {
+    const auto Function = getFunction(&__llvm_libc::strchr, &systemStrchr,
+                                      LIBC_BENCHMARK_VARIANTS(strchr));
+    return callOnStrings(
+        W, [=](const char *S) { return toInteger(Function(S, '!')); });
+  }
+  case memchr: {
+    const auto Function = getFunction(&__llvm_libc::memchr, &systemMemchr,
+                                      LIBC_BENCHMARK_VARIANTS(memchr));
+    return callOnStrings(
+        W, [=](const char *S) { return toInteger(Function(S, '!', Size)); });
+  }
+  case strstr: {
+    const auto Function = getFunction(&__llvm_libc::strstr, &systemStrstr);
+    return callOnStrings(W, [=](const char *S) {
+      return toInteger(Function(S, Argument));
+    });
+  }
+  case strspn: {
+    const auto Function = getFunction<size_t (*)(const char *, const char *)>(
+        &__llvm_libc::strspn, &::strspn);
+    return callOnStrings(W,
+                         [=](const char *S) { return Function(S, Argument); });
+  }
+  case strcspn: {
+    const auto Function = getFunction<size_t (*)(const char *, const char *)>(
+        &__llvm_libc::strcspn, &::strcspn);
+    return callOnStrings(W,
+                         [=](const char *S) { return Function(S, Argument); });
+  }
+  case strpbrk: {
+    const auto Function = getFunction(&__llvm_libc::strpbrk, &systemStrpbrk);
+    return callOnStrings(W, [=](const char *S) {
+      return toInteger(Function(S, Argument));
+    });
+  }
+  }
+  llvm_unreachable("Unknown function");
+}
+
+#undef LIBC_BENCHMARK_VARIANTS
+
+static void writeResults(ArrayRef<Duration> Durations) {
+  std::error_code EC;
+  raw_fd_ostream FOS(Output, EC);
+  if (EC)
+    report_fatal_error(Twine("Could not open file: ")
+                           .concat(EC.message())
+                           .concat(", ")
+                           .concat(Output));
+  json::OStream JOS(FOS, /*IndentSize=*/2);
+  JOS.object([&]() {
+    JOS.attribute("StudyName", StudyName);
+    JOS.attribute("Implementation", ImplementationUnderTest == llvm_libc
+                                        ? "llvm-libc"
+                                        : "system");
+    JOS.attribute("Function", FunctionNames[StringFunction]);
+    JOS.attribute("FunctionVariant", FunctionVariant);
+    JOS.attribute("Length", int64_t(Length));
+    JOS.attribute("Calls", int64_t(Calls));
+    // Seconds per call.
+    JOS.attributeArray("Seconds", [&]() {
+      for (const Duration D : Durations)
+        JOS.value(D.count() / double(Calls));
+    });
+  });
+  FOS << "\n";
+}
+
+void main() {
+  checkRequirements();
+  if (Calls == 0)
+    report_fatal_error("--" + Twine(Calls.ArgStr) + " must be positive");
+  if (StringFunction == strstr && (NeedleLength == 0 || NeedleLength > Length))
+    report_fatal_error("--" + Twine(NeedleLength.ArgStr) +
+                       " must be between 1 and --" + Twine(Length.ArgStr));
+  if (SetSize == 0 || SetSize > 26)
+    report_fatal_error("--" + Twine(SetSize.ArgStr) +
+                       " must be between 1 and 26");
+  const Workload W = makeWorkload();
+  std::vector<Duration> Durations;
+  for (unsigned Trial = 0; Trial < NumTrials; ++Trial)
+    Durations.push_back(measure(W));
+  writeResults(Durations);
+}
+
+} // namespace libc_benchmarks
+} // namespace llvm
+
+int main(int argc, char **argv) {
+  llvm::cl::ParseCommandLineOptions(argc, argv);
+#ifndef NDEBUG
+  static_assert(
+      false,
+      "For reproducibility benchmarks should not be compiled in DEBUG mode.");
+#endif
+  llvm::libc_benchmarks::main();
+  return EXIT_SUCCESS;
+}
@@ -35,6 +35,10 @@ static constexpr long mmapSyscallNumber = SYS_mmap;
 // example, mmap can pick up the page size from here.
 AppProperties app;
 
+// Defined when stdio is linked in, so that programs not using it do not pull
+// it in just to flush the streams at exit.
+[[gnu::weak]] int flush_open_streams();
+
 // TODO: The function is x86_64 specific. Move it to config/linux/app.h
 // and generalize it. Also, dynamic loading is not handled currently.
 void initTLS() {
@@ -146,7 +150,9 @@ extern "C" void _start() {
 
   __llvm_libc::initTLS();
 
-  __llvm_libc::syscall(SYS_exit,
-                       main(args->argc, reinterpret_cast<char **>(args->argv),
-                            reinterpret_cast<char **>(env_ptr)));
+  int ret_val = main(args->argc, reinterpret_cast<char **>(args->argv),
+                     reinterpret_cast<char **>(env_ptr));
+  if (__llvm_libc::flush_open_streams != nullptr)
+    __llvm_libc::flush_open_streams();
+  __llvm_libc::syscall(SYS_exit, ret_val);
 }
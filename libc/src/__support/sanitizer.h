@@ -49,4 +49,16 @@
 #define SANITIZER_MEMORY_INITIALIZED(ptr, size)
 #endif
 
+// The word at a time and vector string functions read aligned blocks which
+// may extend past the end of the string. An aligned block never crosses a page
+// boundary so these reads are safe, but the sanitizers report them.
+#if LLVM_LIBC_HAVE_MEMORY_SANITIZER
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS                                       \
+  __attribute__((no_sanitize("address", "memory")))
+#elif LLVM_LIBC_HAVE_ADDRESS_SANITIZER
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS __attribute__((no_sanitize("address")))
+#else
+#define LLVM_LIBC_NO_SANITIZE_OOB_ACCESS
+#endif
+
 #endif // LLVM_LIBC_SRC_SUPPORT_SANITIZER_H
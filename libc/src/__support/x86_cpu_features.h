@@ -0,0 +1,94 @@
+//===-- Runtime detection of x86 CPU features -------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_SUPPORT_X86_CPU_FEATURES_H
+#define LLVM_LIBC_SRC_SUPPORT_X86_CPU_FEATURES_H
+
+#if !defined(__i386__) && !defined(__x86_64__)
+#error "x86_cpu_features.h is only meant for x86 targets."
+#endif
+
+#include "src/__support/common.h"
+
+#include <stdint.h> // uint32_t, uint64_t
+
+namespace __llvm_libc {
+namespace x86 {
+
+// The features of the running processor that implementations are selected on.
+// A vector extension is only reported when the operating system also saves
+// the registers it uses across context switches.
+struct CpuFeatures {
+  bool SSE2 = false;
+  bool AVX2 = false;
+  bool AVX512F = false;
+  bool AVX512BW = false;
+  // Enhanced `rep movsb` / `rep stosb`.
+  bool ERMS = false;
+  // Fast short `rep movsb`.
+  bool FSRM = false;
+};
+
+struct CpuidResult {
+  uint32_t EAX, EBX, ECX, EDX;
+};
+
+static inline CpuidResult cpuid(uint32_t Leaf, uint32_t SubLeaf = 0) {
+  CpuidResult R;
+  LIBC_INLINE_ASM("cpuid"
+                  : "=a"(R.EAX), "=b"(R.EBX), "=c"(R.ECX), "=d"(R.EDX)
+                  : "a"(Leaf), "c"(SubLeaf));
+  return R;
+}
+
+// Reads extended control register `Register`, which requires OSXSAVE.
+static inline uint64_t xgetbv(uint32_t Register) {
+  uint32_t Low, High;
+  LIBC_INLINE_ASM("xgetbv" : "=a"(Low), "=d"(High) : "c"(Register));
+  return (static_cast<uint64_t>(High) << 32) | Low;
+}
+
+static inline bool has_bit(uint32_t Value, unsigned Bit) {
+  return (Value >> Bit) & 1U;
+}
+
+// Queries the running processor. This executes `cpuid`, which is slow enough
+// that callers are expected to query once and remember the result.
+static inline CpuFeatures get_cpu_features() {
+  CpuFeatures Features;
+  const uint32_t MaxLeaf = cpuid(0).EAX;
+  if (MaxLeaf < 1)
+    return Features;
+
+  const CpuidResult Leaf1 = cpuid(1);
+  Features.SSE2 = has_bit(Leaf1.EDX, 26);
+
+  // XCR0 bits: 1 = SSE state, 2 = AVX state, 5-7 = AVX-512 state.
+  bool OSSavesYmm = false;
+  bool OSSavesZmm = false;
+  if (has_bit(Leaf1.ECX, 27)) {
+    const uint64_t XCR0 = xgetbv(0);
+    OSSavesYmm = (XCR0 & 0x6) == 0x6;
+    OSSavesZmm = (XCR0 & 0xe6) == 0xe6;
+  }
+
+  if (MaxLeaf < 7)
+    return Features;
+  const CpuidResult Leaf7 = cpuid(7, 0);
+  Features.AVX2 = OSSavesYmm && has_bit(Leaf7.EBX, 5);
+  Features.ERMS = has_bit(Leaf7.EBX, 9);
+  Features.AVX512F = OSSavesZmm && has_bit(Leaf7.EBX, 16);
+  Features.AVX512BW = Features.AVX512F && has_bit(Leaf7.EBX, 30);
+  Features.FSRM = has_bit(Leaf7.EDX, 4);
+  return Features;
+}
+
+} // namespace x86
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_SUPPORT_X86_CPU_FEATURES_H
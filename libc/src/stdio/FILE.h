@@ -14,12 +14,43 @@
 
 namespace __llvm_libc {
 
+// A stream reads and writes through the functions it is created with. A FILE
+// without a buffer passes every call straight to them.
 struct FILE {
-  mtx_t lock;
+  mtx_t lock = {};
 
+  // Return the number of bytes transferred. A short count means an error or,
+  // for `read`, the end of the file. Errors are reported with `error`.
   using write_function_t = size_t(FILE *, const char *, size_t);
-
-  write_function_t *write;
+  using read_function_t = size_t(FILE *, char *, size_t);
+  // Releases the resources of the stream, returns 0 on success.
+  using close_function_t = int(FILE *);
+  // Moves the file position by `offset` bytes from the current one, returns 0
+  // on success. Streams which cannot seek leave it null.
+  using seek_function_t = int(FILE *, long);
+
+  write_function_t *write = nullptr;
+  read_function_t *read = nullptr;
+  close_function_t *close = nullptr;
+  seek_function_t *seek = nullptr;
+
+  enum BufferMode : unsigned char { Unbuffered, LineBuffered, FullyBuffered };
+
+  // The buffer holds either pending output, `buffer[0, write_end)`, or input
+  // read ahead, `buffer[read_pos, read_end)`, never both.
+  char *buffer = nullptr;
+  size_t buffer_size = 0;
+  size_t write_end = 0;
+  size_t read_pos = 0;
+  size_t read_end = 0;
+  BufferMode mode = Unbuffered;
+
+  bool error = false;
+  bool eof = false;
+
+  // Links in the list of open streams, which are flushed at exit.
+  FILE *prev = nullptr;
+  FILE *next = nullptr;
 };
 
 } // namespace __llvm_libc
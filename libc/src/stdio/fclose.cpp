@@ -0,0 +1,33 @@
+//===-- Implementation of fclose ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/fclose.h"
+
+#include "include/stdio.h" // For EOF.
+#include "src/__support/common.h"
+#include "src/stdio/file_ops.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, fclose, (__llvm_libc::FILE * stream)) {
+  // The stream leaves the open streams first, as flush_open_streams takes the
+  // lock of the list before the locks of the streams.
+  remove_open_stream(stream);
+  int ret;
+  {
+    FileLock lock(stream);
+    ret = flush_unlocked(stream);
+  }
+  // The close function may free the stream, so it is called without the lock
+  // held. Using the stream concurrently with fclose is undefined anyway.
+  if (stream->close != nullptr && stream->close(stream) != 0)
+    ret = EOF;
+  return ret;
+}
+
+} // namespace __llvm_libc
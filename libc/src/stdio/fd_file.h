@@ -0,0 +1,54 @@
+//===-- Streams on file descriptors -----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_FD_FILE_H
+#define LLVM_LIBC_SRC_STDIO_FD_FILE_H
+
+#include "src/stdio/FILE.h"
+
+#include <stddef.h>
+
+namespace __llvm_libc {
+
+struct FdFile : FILE {
+  int fd;
+  // Set on the line buffered standard output, which is switched to full
+  // buffering on its first write if `fd` is not a terminal.
+  bool check_terminal = false;
+
+  constexpr FdFile(int fd, char *buffer, size_t buffer_size, BufferMode mode,
+                   close_function_t *close_function, FILE *prev_stream,
+                   FILE *next_stream, bool check_terminal = false)
+      : FILE(), fd(fd), check_terminal(check_terminal) {
+    write = &fd_write;
+    read = &fd_read;
+    seek = &fd_seek;
+    close = close_function;
+    this->buffer = buffer;
+    this->buffer_size = buffer_size;
+    this->mode = mode;
+    prev = prev_stream;
+    next = next_stream;
+  }
+
+  static size_t fd_write(FILE *stream, const char *data, size_t size);
+  static size_t fd_read(FILE *stream, char *data, size_t size);
+  static int fd_seek(FILE *stream, long offset);
+  // Closes the descriptor and frees the memory of streams made by `fopen`.
+  static int fd_close(FILE *stream);
+  // Closes the descriptor of a standard stream.
+  static int fd_close_static(FILE *stream);
+};
+
+// Returns a new stream on `path` opened with the `fopen` `mode`, or nullptr
+// with errno set.
+FdFile *open_fd_file(const char *path, const char *mode);
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_FD_FILE_H
@@ -0,0 +1,23 @@
+//===-- Implementation of fflush ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/fflush.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/file_ops.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, fflush, (__llvm_libc::FILE * stream)) {
+  if (stream == nullptr)
+    return flush_open_streams();
+  FileLock lock(stream);
+  return flush_unlocked(stream);
+}
+
+} // namespace __llvm_libc
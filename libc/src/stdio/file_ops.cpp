@@ -0,0 +1,195 @@
+//===-- Implementation of the buffered operations on FILE -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/file_ops.h"
+
+#include "include/stdio.h" // For EOF.
+#include "include/threads.h"
+#include "src/stdio/fd_file.h"
+#include "src/stdio/standard_streams.h"
+#include "src/string/memmove.h"
+#include "src/string/memrchr.h"
+
+namespace __llvm_libc {
+
+static char stdin_buffer[kFileBufferSize];
+static char stdout_buffer[kFileBufferSize];
+
+// The standard streams are constant initialized as the initial list of open
+// streams. Standard error is unbuffered.
+static FdFile standard_files[] = {
+    {0, stdin_buffer, kFileBufferSize, FILE::FullyBuffered,
+     &FdFile::fd_close_static, nullptr, &standard_files[1]},
+    {1, stdout_buffer, kFileBufferSize, FILE::LineBuffered,
+     &FdFile::fd_close_static, &standard_files[0], &standard_files[2], true},
+    {2, nullptr, 0, FILE::Unbuffered, &FdFile::fd_close_static,
+     &standard_files[1], nullptr},
+};
+
+FILE *stdin = &standard_files[0];
+FILE *stdout = &standard_files[1];
+FILE *stderr = &standard_files[2];
+
+static mtx_t open_streams_lock;
+static FILE *open_streams = &standard_files[0];
+
+namespace {
+
+class OpenStreamsLock {
+  const bool locked;
+
+public:
+  OpenStreamsLock() : locked(is_multithreaded()) {
+    if (locked)
+      __llvm_libc::mtx_lock(&open_streams_lock);
+  }
+  ~OpenStreamsLock() {
+    if (locked)
+      __llvm_libc::mtx_unlock(&open_streams_lock);
+  }
+};
+
+} // namespace
+
+// Passes `size` bytes to the write function of `stream` and records errors.
+static size_t write_through(FILE *stream, const char *data, size_t size) {
+  if (size == 0)
+    return 0;
+  const size_t written = stream->write(stream, data, size);
+  if (written != size)
+    stream->error = true;
+  return written;
+}
+
+// Drops the input read ahead, moving the file position back to the position
+// of the stream, so that output or a later read continues from there. Streams
+// which cannot seek, like pipes, just lose it.
+static void drop_read_ahead(FILE *stream) {
+  const size_t unread = stream->read_end - stream->read_pos;
+  stream->read_pos = stream->read_end = 0;
+  if (unread != 0 && stream->seek != nullptr)
+    stream->seek(stream, -static_cast<long>(unread));
+}
+
+size_t write_unlocked_slow(FILE *stream, const char *data, size_t size) {
+  drop_read_ahead(stream);
+
+  if (stream->mode == FILE::Unbuffered || stream->buffer_size == 0)
+    return write_through(stream, data, size);
+
+  // Data which does not fit in the buffer flushes it. Large writes then go
+  // directly to the write function instead of being split in buffer sized
+  // chunks.
+  if (size > stream->buffer_size - stream->write_end) {
+    if (flush_unlocked(stream) != 0)
+      return 0;
+    if (size >= stream->buffer_size)
+      return write_through(stream, data, size);
+  }
+  __llvm_libc::memcpy(stream->buffer + stream->write_end, data, size);
+  stream->write_end += size;
+
+  // The data is buffered, so it counts as written even if the flush fails.
+  // The error is recorded in the stream.
+  if (stream->mode == FILE::LineBuffered &&
+      __llvm_libc::memrchr(data, '\n', size) != nullptr)
+    flush_unlocked(stream);
+  return size;
+}
+
+size_t read_unlocked(FILE *stream, char *data, size_t size) {
+  if (stream->write_end != 0 && flush_unlocked(stream) != 0)
+    return 0;
+
+  size_t copied = stream->read_end - stream->read_pos;
+  if (copied >= size) {
+    __llvm_libc::memcpy(data, stream->buffer + stream->read_pos, size);
+    stream->read_pos += size;
+    return size;
+  }
+  __llvm_libc::memcpy(data, stream->buffer + stream->read_pos, copied);
+  stream->read_pos = stream->read_end = 0;
+
+  while (copied < size) {
+    const size_t remaining = size - copied;
+    // Large reads bypass the buffer.
+    if (stream->mode == FILE::Unbuffered || remaining >= stream->buffer_size) {
+      const size_t count = stream->read(stream, data + copied, remaining);
+      if (count == 0) {
+        if (!stream->error)
+          stream->eof = true;
+        break;
+      }
+      copied += count;
+      continue;
+    }
+    const size_t count =
+        stream->read(stream, stream->buffer, stream->buffer_size);
+    if (count == 0) {
+      if (!stream->error)
+        stream->eof = true;
+      break;
+    }
+    const size_t used = count < remaining ? count : remaining;
+    __llvm_libc::memcpy(data + copied, stream->buffer, used);
+    copied += used;
+    stream->read_pos = used;
+    stream->read_end = count;
+  }
+  return copied;
+}
+
+int flush_unlocked(FILE *stream) {
+  drop_read_ahead(stream);
+  const size_t pending = stream->write_end;
+  if (pending == 0)
+    return 0;
+  const size_t written = write_through(stream, stream->buffer, pending);
+  if (written != pending) {
+    // Keep what was not written for a later attempt.
+    __llvm_libc::memmove(stream->buffer, stream->buffer + written,
+                         pending - written);
+    stream->write_end = pending - written;
+    return EOF;
+  }
+  stream->write_end = 0;
+  return 0;
+}
+
+void add_open_stream(FILE *stream) {
+  OpenStreamsLock lock;
+  stream->prev = nullptr;
+  stream->next = open_streams;
+  if (open_streams != nullptr)
+    open_streams->prev = stream;
+  open_streams = stream;
+}
+
+void remove_open_stream(FILE *stream) {
+  OpenStreamsLock lock;
+  if (stream->prev != nullptr)
+    stream->prev->next = stream->next;
+  else if (open_streams == stream)
+    open_streams = stream->next;
+  if (stream->next != nullptr)
+    stream->next->prev = stream->prev;
+  stream->prev = stream->next = nullptr;
+}
+
+int flush_open_streams() {
+  OpenStreamsLock lock;
+  int result = 0;
+  for (FILE *stream = open_streams; stream != nullptr; stream = stream->next) {
+    FileLock stream_lock(stream);
+    if (stream->write_end != 0 && flush_unlocked(stream) != 0)
+      result = EOF;
+  }
+  return result;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,84 @@
+//===-- Buffered operations on FILE -----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The `_unlocked` functions require the caller to hold the lock of the stream,
+// which `FileLock` takes only once the process is multithreaded.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_FILE_OPS_H
+#define LLVM_LIBC_SRC_STDIO_FILE_OPS_H
+
+#include "src/__support/common.h"
+#include "src/stdio/FILE.h"
+#include "src/string/memcpy.h"
+#include "src/threads/mtx_lock.h"
+#include "src/threads/mtx_unlock.h"
+#include "src/threads/multithreaded.h"
+
+#include <stddef.h>
+
+namespace __llvm_libc {
+
+class FileLock {
+  FILE *stream;
+  const bool locked;
+
+public:
+  explicit FileLock(FILE *stream)
+      : stream(stream), locked(is_multithreaded()) {
+    if (locked)
+      __llvm_libc::mtx_lock(&stream->lock);
+  }
+
+  ~FileLock() {
+    if (locked)
+      __llvm_libc::mtx_unlock(&stream->lock);
+  }
+
+  FileLock(const FileLock &) = delete;
+  FileLock &operator=(const FileLock &) = delete;
+};
+
+// The default buffer size of streams.
+constexpr size_t kFileBufferSize = 8192;
+
+size_t write_unlocked_slow(FILE *stream, const char *data, size_t size);
+
+// Writes `size` bytes to `stream`, returns the number of bytes written.
+static inline size_t write_unlocked(FILE *stream, const char *data,
+                                    size_t size) {
+  // Appending to the buffer of a fully buffered stream is the common case,
+  // everything else is handled out of line.
+  if (likely(stream->mode == FILE::FullyBuffered &&
+             stream->read_end == stream->read_pos &&
+             size <= stream->buffer_size - stream->write_end)) {
+    __llvm_libc::memcpy(stream->buffer + stream->write_end, data, size);
+    stream->write_end += size;
+    return size;
+  }
+  return write_unlocked_slow(stream, data, size);
+}
+
+// Reads up to `size` bytes from `stream`, returns the number of bytes read.
+size_t read_unlocked(FILE *stream, char *data, size_t size);
+
+// Writes the pending output of `stream`, returns 0 on success and EOF on
+// error. Input read ahead is dropped.
+int flush_unlocked(FILE *stream);
+
+// Makes `stream` part of the open streams, which are flushed at exit.
+void add_open_stream(FILE *stream);
+void remove_open_stream(FILE *stream);
+
+// Flushes every open stream, returns 0 on success and EOF if any failed.
+int flush_open_streams();
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_FILE_OPS_H
@@ -0,0 +1,21 @@
+//===-- Implementation of fopen -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/fopen.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/fd_file.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(__llvm_libc::FILE *, fopen,
+                   (const char *__restrict path, const char *__restrict mode)) {
+  return open_fd_file(path, mode);
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,24 @@
+//===-- Implementation of fread -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/fread.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/file_ops.h"
+#include "src/stdio/fread_unlocked.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(size_t, fread,
+                   (void *__restrict ptr, size_t size, size_t nmeb,
+                    __llvm_libc::FILE *__restrict stream)) {
+  FileLock lock(stream);
+  return __llvm_libc::fread_unlocked(ptr, size, nmeb, stream);
+}
+
+} // namespace __llvm_libc
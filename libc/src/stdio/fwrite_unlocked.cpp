@@ -0,0 +1,32 @@
+//===-- Implementation of fwrite_unlocked ---------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/fwrite_unlocked.h"
+
+#include "include/errno.h" // For EOVERFLOW.
+#include "src/__support/common.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdio/file_ops.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(size_t, fwrite_unlocked,
+                   (const void *__restrict ptr, size_t size, size_t nmeb,
+                    __llvm_libc::FILE *__restrict stream)) {
+  if (size == 0 || nmeb == 0)
+    return 0;
+  size_t total;
+  if (__builtin_mul_overflow(size, nmeb, &total)) {
+    stream->error = true;
+    llvmlibc_errno = EOVERFLOW;
+    return 0;
+  }
+  return write_unlocked(stream, reinterpret_cast<const char *>(ptr), total) / size;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,168 @@
+//===-- Linux implementation of streams on file descriptors ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/fd_file.h"
+
+#include "config/linux/syscall.h" // For internal syscall function.
+#include "include/errno.h"        // For error macros.
+#include "include/sys/syscall.h"  // For syscall numbers.
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdio/file_ops.h"
+#include "src/stdlib/free.h"
+#include "src/stdlib/malloc.h"
+
+#include <asm/ioctls.h>   // For TCGETS.
+#include <asm/termbits.h> // For struct termios.
+#include <linux/fcntl.h>  // For open flags and AT_FDCWD.
+#include <linux/fs.h>     // For SEEK_CUR.
+#include <new>            // For placement new.
+
+namespace __llvm_libc {
+
+static bool is_terminal(int fd) {
+  struct termios t;
+  return __llvm_libc::syscall(SYS_ioctl, fd, TCGETS,
+                              reinterpret_cast<long>(&t)) == 0;
+}
+
+size_t FdFile::fd_write(FILE *stream, const char *data, size_t size) {
+  FdFile *file = static_cast<FdFile *>(stream);
+  if (file->check_terminal) {
+    // This is the first write to the standard output. The data being written
+    // is already in the line buffer, so the mode change only affects the
+    // following writes.
+    file->check_terminal = false;
+    if (!is_terminal(file->fd))
+      file->mode = FILE::FullyBuffered;
+  }
+  size_t written = 0;
+  while (written < size) {
+    long ret = __llvm_libc::syscall(SYS_write, file->fd, data + written,
+                                    size - written);
+    if (ret == -EINTR)
+      continue;
+    if (ret <= 0) {
+      if (ret < 0)
+        llvmlibc_errno = -ret;
+      break;
+    }
+    written += ret;
+  }
+  return written;
+}
+
+size_t FdFile::fd_read(FILE *stream, char *data, size_t size) {
+  FdFile *file = static_cast<FdFile *>(stream);
+  for (;;) {
+    long ret = __llvm_libc::syscall(SYS_read, file->fd, data, size);
+    if (ret == -EINTR)
+      continue;
+    if (ret < 0) {
+      llvmlibc_errno = -ret;
+      stream->error = true;
+      return 0;
+    }
+    return ret;
+  }
+}
+
+int FdFile::fd_seek(FILE *stream, long offset) {
+  // Seeking is only used internally, so failures, like on a pipe, leave errno
+  // alone.
+  long ret = __llvm_libc::syscall(SYS_lseek, static_cast<FdFile *>(stream)->fd,
+                                  offset, SEEK_CUR);
+  return ret < 0 ? -1 : 0;
+}
+
+int FdFile::fd_close_static(FILE *stream) {
+  long ret = __llvm_libc::syscall(SYS_close, static_cast<FdFile *>(stream)->fd);
+  if (ret < 0) {
+    llvmlibc_errno = -ret;
+    return -1;
+  }
+  return 0;
+}
+
+int FdFile::fd_close(FILE *stream) {
+  int ret = fd_close_static(stream);
+  // The buffer is allocated along with the stream.
+  __llvm_libc::free(stream);
+  return ret;
+}
+
+// Returns the flags for the openat syscall matching the fopen `mode`, or -1 if
+// `mode` is not valid.
+static int open_flags(const char *mode) {
+  int flags;
+  switch (*mode++) {
+  case 'r':
+    flags = 0;
+    break;
+  case 'w':
+    flags = O_CREAT | O_TRUNC;
+    break;
+  case 'a':
+    flags = O_CREAT | O_APPEND;
+    break;
+  default:
+    return -1;
+  }
+  bool update = false;
+  for (; *mode != '\0'; ++mode) {
+    switch (*mode) {
+    case '+':
+      update = true;
+      break;
+    case 'b':
+      break;
+    case 'x':
+      flags |= O_EXCL;
+      break;
+    case 'e':
+      flags |= O_CLOEXEC;
+      break;
+    default:
+      return -1;
+    }
+  }
+  if (update)
+    return flags | O_RDWR;
+  return flags | ((flags & O_CREAT) ? O_WRONLY : O_RDONLY);
+}
+
+FdFile *open_fd_file(const char *path, const char *mode) {
+  const int flags = open_flags(mode);
+  if (flags < 0) {
+    llvmlibc_errno = EINVAL;
+    return nullptr;
+  }
+
+  // The stream and its buffer are a single allocation, which is made first so
+  // that no descriptor leaks if it fails.
+  void *memory = __llvm_libc::malloc(sizeof(FdFile) + kFileBufferSize);
+  if (memory == nullptr) {
+    llvmlibc_errno = ENOMEM;
+    return nullptr;
+  }
+
+  long fd = __llvm_libc::syscall(SYS_openat, AT_FDCWD, path, flags, 0666);
+  if (fd < 0) {
+    __llvm_libc::free(memory);
+    llvmlibc_errno = -fd;
+    return nullptr;
+  }
+
+  char *buffer = static_cast<char *>(memory) + sizeof(FdFile);
+  FdFile *file = new (memory) FdFile(fd, buffer, kFileBufferSize,
+                                     FILE::FullyBuffered, &FdFile::fd_close,
+                                     nullptr, nullptr);
+  add_open_stream(file);
+  return file;
+}
+
+} // namespace __llvm_libc
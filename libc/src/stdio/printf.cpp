@@ -0,0 +1,27 @@
+//===-- Implementation of printf ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/printf.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/printf_core/printf_main.h"
+#include "src/stdio/standard_streams.h"
+
+#include <stdarg.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, printf, (const char *__restrict format, ...)) {
+  va_list vlist;
+  va_start(vlist, format);
+  const int ret = printf_core::vfprintf_internal(stdout, format, vlist);
+  va_end(vlist);
+  return ret;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,201 @@
+//===-- Conversions of printf ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/printf_core/converter.h"
+
+#include "src/stdio/printf_core/int_converter.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+void write_padded(Writer *writer, const FormatSection &section,
+                  const char *prefix, size_t prefix_len, size_t zeroes,
+                  const char *body, size_t body_len) {
+  const size_t len = prefix_len + zeroes + body_len;
+  const size_t padding = size_t(section.min_width) > len
+                             ? size_t(section.min_width) - len
+                             : 0;
+  if (!(section.flags & LEFT_JUSTIFIED))
+    writer->write_chars(' ', padding);
+  if (prefix_len != 0)
+    writer->write(prefix, prefix_len);
+  writer->write_chars('0', zeroes);
+  writer->write(body, body_len);
+  if (section.flags & LEFT_JUSTIFIED)
+    writer->write_chars(' ', padding);
+}
+
+static void convert_int(Writer *writer, const FormatSection &section) {
+  uintmax_t value = section.conv_val_raw;
+  char prefix[2];
+  size_t prefix_len = 0;
+  unsigned base = 10;
+  switch (section.conv_name) {
+  case 'd':
+  case 'i':
+    if (static_cast<intmax_t>(value) < 0) {
+      value = -value;
+      prefix[prefix_len++] = '-';
+    } else if (section.flags & FORCE_SIGN) {
+      prefix[prefix_len++] = '+';
+    } else if (section.flags & SPACE_PREFIX) {
+      prefix[prefix_len++] = ' ';
+    }
+    break;
+  case 'o':
+    base = 8;
+    break;
+  case 'x':
+  case 'X':
+    base = 16;
+    if ((section.flags & ALTERNATE_FORM) && value != 0) {
+      prefix[prefix_len++] = '0';
+      prefix[prefix_len++] = section.conv_name;
+    }
+    break;
+  }
+
+  char buffer[kIntBufferSize];
+  char *const end = buffer + kIntBufferSize;
+  size_t len = 0;
+  // A zero precision makes zero print no digits.
+  if (value != 0 || section.precision != 0) {
+    switch (base) {
+    case 10:
+      len = format_decimal(value, end);
+      break;
+    case 8:
+      len = format_octal(value, end);
+      break;
+    default:
+      len = format_hex(value, end, section.conv_name == 'X');
+      break;
+    }
+  }
+
+  size_t zeroes = 0;
+  if (section.precision >= 0) {
+    if (size_t(section.precision) > len)
+      zeroes = section.precision - len;
+  } else if ((section.flags & LEADING_ZEROES) &&
+             !(section.flags & LEFT_JUSTIFIED)) {
+    if (size_t(section.min_width) > prefix_len + len)
+      zeroes = section.min_width - prefix_len - len;
+  }
+  // The alternate form of %o starts with a zero.
+  if (base == 8 && (section.flags & ALTERNATE_FORM) && zeroes == 0 &&
+      (len == 0 || end[-len] != '0'))
+    zeroes = 1;
+  write_padded(writer, section, prefix, prefix_len, zeroes, end - len, len);
+}
+
+static void convert_pointer(Writer *writer, const FormatSection &section) {
+  if (section.conv_val_ptr == nullptr) {
+    static constexpr char kNil[] = "(nil)";
+    write_padded(writer, section, nullptr, 0, 0, kNil, sizeof(kNil) - 1);
+    return;
+  }
+  char buffer[kIntBufferSize];
+  char *const end = buffer + kIntBufferSize;
+  const size_t len =
+      format_hex(reinterpret_cast<uintptr_t>(section.conv_val_ptr), end, false);
+  write_padded(writer, section, "0x", 2, 0, end - len, len);
+}
+
+static void convert_string(Writer *writer, const FormatSection &section) {
+  const char *str = static_cast<const char *>(section.conv_val_ptr);
+  if (str == nullptr)
+    str = "(null)";
+  // With a precision, the string does not need to be null terminated.
+  size_t len = 0;
+  if (section.precision >= 0) {
+    while (len < size_t(section.precision) && str[len] != '\0')
+      ++len;
+  } else {
+    while (str[len] != '\0')
+      ++len;
+  }
+  write_padded(writer, section, nullptr, 0, 0, str, len);
+}
+
+static void convert_write_int(Writer *writer, const FormatSection &section) {
+  const size_t count = writer->get_chars_written();
+  void *ptr = section.conv_val_ptr;
+  switch (section.length_modifier) {
+  case LengthModifier::hh:
+    *static_cast<signed char *>(ptr) = count;
+    return;
+  case LengthModifier::h:
+    *static_cast<short *>(ptr) = count;
+    return;
+  case LengthModifier::l:
+    *static_cast<long *>(ptr) = count;
+    return;
+  case LengthModifier::ll:
+  case LengthModifier::L:
+    *static_cast<long long *>(ptr) = count;
+    return;
+  case LengthModifier::j:
+    *static_cast<intmax_t *>(ptr) = count;
+    return;
+  case LengthModifier::z:
+  case LengthModifier::t:
+    *static_cast<ptrdiff_t *>(ptr) = count;
+    return;
+  case LengthModifier::none:
+    *static_cast<int *>(ptr) = count;
+    return;
+  }
+}
+
+void convert(Writer *writer, const FormatSection &section) {
+  if (!section.has_conv) {
+    writer->write(section.raw_string, section.raw_len);
+    return;
+  }
+  switch (section.conv_name) {
+  case 'c': {
+    const char c = static_cast<char>(section.conv_val_raw);
+    write_padded(writer, section, nullptr, 0, 0, &c, 1);
+    return;
+  }
+  case 's':
+    convert_string(writer, section);
+    return;
+  case 'd':
+  case 'i':
+  case 'o':
+  case 'u':
+  case 'x':
+  case 'X':
+    convert_int(writer, section);
+    return;
+  case 'f':
+  case 'F':
+  case 'e':
+  case 'E':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    convert_float(writer, section);
+    return;
+  case 'p':
+    convert_pointer(writer, section);
+    return;
+  case 'n':
+    convert_write_int(writer, section);
+    return;
+  }
+}
+
+} // namespace printf_core
+} // namespace __llvm_libc
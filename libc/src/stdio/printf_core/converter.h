@@ -0,0 +1,36 @@
+//===-- Conversions of printf -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_PRINTF_CORE_CONVERTER_H
+#define LLVM_LIBC_SRC_STDIO_PRINTF_CORE_CONVERTER_H
+
+#include "src/stdio/printf_core/core_structs.h"
+#include "src/stdio/printf_core/writer.h"
+
+#include <stddef.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+// Writes the conversion of `section` to `writer`.
+void convert(Writer *writer, const FormatSection &section);
+
+// Writes the floating point conversions, %f, %e, %g and %a.
+void convert_float(Writer *writer, const FormatSection &section);
+
+// Writes `prefix` and `body` separated by `zeroes` zeros, padded with spaces
+// to `min_width` according to `flags`. The converters compute the zeros
+// themselves, as their meaning differs between conversions.
+void write_padded(Writer *writer, const FormatSection &section,
+                  const char *prefix, size_t prefix_len, size_t zeroes,
+                  const char *body, size_t body_len);
+
+} // namespace printf_core
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_PRINTF_CORE_CONVERTER_H
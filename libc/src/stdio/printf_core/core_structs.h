@@ -0,0 +1,58 @@
+//===-- Structures shared by the parts of printf ----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_PRINTF_CORE_CORE_STRUCTS_H
+#define LLVM_LIBC_SRC_STDIO_PRINTF_CORE_CORE_STRUCTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+enum class LengthModifier { none, hh, h, l, ll, j, z, t, L };
+
+enum FormatFlags : uint8_t {
+  LEFT_JUSTIFIED = 0x01, // -
+  FORCE_SIGN = 0x02,     // +
+  SPACE_PREFIX = 0x04,   // space
+  ALTERNATE_FORM = 0x08, // #
+  LEADING_ZEROES = 0x10, // 0
+};
+
+// A piece of the format string, either raw text or a conversion along with
+// the argument it converts. `raw_string` always covers the whole piece, so that
+// an unknown conversion can be written out as is.
+struct FormatSection {
+  bool has_conv = false;
+
+  const char *raw_string = nullptr;
+  size_t raw_len = 0;
+
+  uint8_t flags = 0;
+  LengthModifier length_modifier = LengthModifier::none;
+  int min_width = 0;
+  // Negative when no precision is specified.
+  int precision = -1;
+  char conv_name = '\0';
+
+  // The argument of the conversion. Integers are stored sign or zero extended
+  // according to the length modifier, so that the converters do not need to
+  // know the argument type.
+  union {
+    uintmax_t conv_val_raw = 0;
+    void *conv_val_ptr;
+    double conv_val_double;
+    long double conv_val_long_double;
+  };
+};
+
+} // namespace printf_core
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_PRINTF_CORE_CORE_STRUCTS_H
@@ -0,0 +1,520 @@
+//===-- Floating point conversions of printf ------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// The decimal conversions expand the binary value exactly. A finite value is
+// m * 2^e with an integer m, which is the integer m * 2^e when e >= 0 and the
+// decimal m * 5^-e * 10^e otherwise. That integer is computed in base 10^9 and
+// rounded to the requested number of digits, ties to even, so the output is
+// correctly rounded for any precision.
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/printf_core/converter.h"
+
+#include "src/stdio/printf_core/int_converter.h"
+#include "utils/FPUtil/FPBits.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+namespace {
+
+// A finite value is mantissa * 2^exponent.
+struct FloatParts {
+  bool negative;
+  bool is_inf;
+  bool is_nan;
+  uint64_t mantissa;
+  int exponent;
+};
+
+FloatParts decompose(double value) {
+  fputil::FPBits<double> bits(value);
+  FloatParts parts;
+  parts.negative = bits.encoding.sign;
+  parts.is_inf = bits.isInf();
+  parts.is_nan = bits.isNaN();
+  parts.mantissa = bits.encoding.mantissa;
+  int biased_exponent = bits.encoding.exponent;
+  if (biased_exponent == 0)
+    biased_exponent = 1;
+  else
+    parts.mantissa |= uint64_t(1) << fputil::MantissaWidth<double>::value;
+  parts.exponent = biased_exponent - fputil::FPBits<double>::exponentBias -
+                   fputil::MantissaWidth<double>::value;
+  return parts;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+constexpr bool kLongDoubleIsExact = true;
+
+FloatParts decompose(long double value) {
+  fputil::FPBits<long double> bits(value);
+  FloatParts parts;
+  parts.negative = bits.encoding.sign;
+  parts.is_inf = bits.isInf();
+  parts.is_nan = bits.isNaN();
+  parts.mantissa = (uint64_t(bits.encoding.implicitBit) << 63) |
+                   uint64_t(bits.encoding.mantissa);
+  parts.exponent = bits.getExponent() - 63;
+  return parts;
+}
+#else
+// TODO: Expand the 113 bits mantissa of quad precision exactly. Until then, a
+// long double wider than double, such as the quad precision one of AArch64 or
+// RISC-V, is printed as the nearest double: with at most 17 significant
+// digits, and as an infinity or zero outside of the range of double.
+constexpr bool kLongDoubleIsExact = false;
+
+FloatParts decompose(long double value) {
+  return decompose(static_cast<double>(value));
+}
+#endif
+
+constexpr uint32_t kPow10[] = {1,      10,      100,      1000,     10000,
+                               100000, 1000000, 10000000, 100000000};
+constexpr uint32_t kLimbBase = 1000000000;
+
+// The largest limb counts needed by the exact expansions, with a few limbs to
+// spare. A double needs 767 digits and an x87 long double 11515.
+constexpr size_t kDoubleLimbs = 90;
+constexpr size_t kLongDoubleLimbs = kLongDoubleIsExact ? 1285 : kDoubleLimbs;
+
+// An unsigned integer in base 10^9 whose digits are indexed from the most
+// significant one.
+template <size_t MaxLimbs> class DecimalNumber {
+  uint32_t limbs[MaxLimbs]; // Least significant first.
+  size_t size;
+  size_t top_digits; // The number of digits of the most significant limb.
+
+  void update_top_digits() {
+    top_digits = 1;
+    while (top_digits < 9 && limbs[size - 1] >= kPow10[top_digits])
+      ++top_digits;
+  }
+
+  void multiply(uint32_t factor) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < size; ++i) {
+      const uint64_t product = uint64_t(limbs[i]) * factor + carry;
+      limbs[i] = static_cast<uint32_t>(product % kLimbBase);
+      carry = product / kLimbBase;
+    }
+    for (; carry != 0; carry /= kLimbBase)
+      limbs[size++] = static_cast<uint32_t>(carry % kLimbBase);
+  }
+
+public:
+  // Sets the number to the integer n such that mantissa * 2^exponent is
+  // n * 10^decimal_exponent.
+  void set(uint64_t mantissa, int exponent, int &decimal_exponent) {
+    // Trailing zero bits only make the number longer when exponent < 0.
+    if (mantissa != 0 && exponent < 0) {
+      int shift = __builtin_ctzll(mantissa);
+      if (shift > -exponent)
+        shift = -exponent;
+      mantissa >>= shift;
+      exponent += shift;
+    }
+    size = 0;
+    do {
+      limbs[size++] = static_cast<uint32_t>(mantissa % kLimbBase);
+      mantissa /= kLimbBase;
+    } while (mantissa != 0);
+
+    decimal_exponent = 0;
+    if (exponent >= 0) {
+      for (; exponent > 0; exponent -= 29)
+        multiply(uint32_t(1) << (exponent < 29 ? exponent : 29));
+    } else {
+      decimal_exponent = exponent;
+      // 5^13 is the largest power of five below 2^32.
+      constexpr uint32_t kPow5[] = {1,         5,         25,       125,
+                                    625,       3125,      15625,    78125,
+                                    390625,    1953125,   9765625,  48828125,
+                                    244140625, 1220703125};
+      for (int k = -exponent; k > 0; k -= 13)
+        multiply(kPow5[k < 13 ? k : 13]);
+    }
+    update_top_digits();
+  }
+
+  void set_small(uint32_t value) {
+    limbs[0] = value;
+    size = 1;
+    update_top_digits();
+  }
+
+  bool is_zero() const { return size == 1 && limbs[0] == 0; }
+
+  // Returns whether any digit after the one at `index` is not zero.
+  bool has_nonzero_digits_after(ptrdiff_t index) const {
+    if (index + 1 >= length())
+      return false;
+    const size_t rest = length() - index - 1;
+    for (size_t i = 0; i < rest / 9; ++i)
+      if (limbs[i] != 0)
+        return true;
+    return limbs[rest / 9] % kPow10[rest % 9] != 0;
+  }
+
+  ptrdiff_t length() const { return top_digits + 9 * (size - 1); }
+
+  // Returns the digit at `index`, counted from the most significant digit.
+  // Digits outside of the number are zero.
+  unsigned digit(ptrdiff_t index) const {
+    if (index < 0 || index >= length())
+      return 0;
+    if (size_t(index) < top_digits)
+      return limbs[size - 1] / kPow10[top_digits - 1 - index] % 10;
+    const size_t low = index - top_digits;
+    return limbs[size - 2 - low / 9] / kPow10[8 - low % 9] % 10;
+  }
+
+  // Rounds to the `keep` most significant digits, ties to even, and sets the
+  // other digits to zero. The length grows by one when all the kept digits
+  // are nines.
+  void round_to(ptrdiff_t keep) {
+    const ptrdiff_t len = length();
+    if (keep >= len)
+      return;
+    const size_t dropped = len - keep;
+
+    const unsigned first_dropped = digit(keep);
+    const bool rest_nonzero = has_nonzero_digits_after(keep);
+    const bool round_up =
+        first_dropped > 5 ||
+        (first_dropped == 5 && (rest_nonzero || digit(keep - 1) % 2 != 0));
+
+    const size_t limb = dropped / 9;
+    for (size_t i = 0; i < limb; ++i)
+      limbs[i] = 0;
+    limbs[limb] -= limbs[limb] % kPow10[dropped % 9];
+    if (round_up) {
+      uint32_t carry = kPow10[dropped % 9];
+      for (size_t i = limb; carry != 0; ++i) {
+        if (i == size) {
+          limbs[size++] = carry;
+          break;
+        }
+        limbs[i] += carry;
+        carry = 0;
+        if (limbs[i] >= kLimbBase) {
+          limbs[i] -= kLimbBase;
+          carry = 1;
+        }
+      }
+    }
+    update_top_digits();
+  }
+};
+
+template <typename Number>
+void write_digits(Writer *writer, const Number &number, ptrdiff_t from,
+                  ptrdiff_t to) {
+  for (ptrdiff_t i = from; i < to; ++i)
+    writer->write_char(static_cast<char>('0' + number.digit(i)));
+}
+
+// Pads a number whose text is streamed after the call to `begin` and before
+// the call to `end`.
+class Padding {
+  Writer *writer;
+  const FormatSection &section;
+  size_t padding = 0;
+
+public:
+  Padding(Writer *writer, const FormatSection &section)
+      : writer(writer), section(section) {}
+
+  // `prefix` is the sign and radix, which zero padding follows.
+  void begin(const char *prefix, size_t prefix_len, size_t body_len) {
+    const size_t len = prefix_len + body_len;
+    padding = size_t(section.min_width) > len ? section.min_width - len : 0;
+    if (section.flags & LEFT_JUSTIFIED) {
+      writer->write(prefix, prefix_len);
+      return;
+    }
+    if (section.flags & LEADING_ZEROES) {
+      writer->write(prefix, prefix_len);
+      writer->write_chars('0', padding);
+      padding = 0;
+      return;
+    }
+    writer->write_chars(' ', padding);
+    padding = 0;
+    writer->write(prefix, prefix_len);
+  }
+
+  void end() { writer->write_chars(' ', padding); }
+};
+
+size_t sign_prefix(const FormatSection &section, bool negative, char *prefix) {
+  if (negative)
+    prefix[0] = '-';
+  else if (section.flags & FORCE_SIGN)
+    prefix[0] = '+';
+  else if (section.flags & SPACE_PREFIX)
+    prefix[0] = ' ';
+  else
+    return 0;
+  return 1;
+}
+
+bool is_upper(char conv_name) { return conv_name >= 'A' && conv_name <= 'Z'; }
+
+void write_inf_or_nan(Writer *writer, const FormatSection &section,
+                      const FloatParts &parts) {
+  char prefix[1];
+  const size_t prefix_len = sign_prefix(section, parts.negative, prefix);
+  const char *body;
+  if (is_upper(section.conv_name))
+    body = parts.is_inf ? "INF" : "NAN";
+  else
+    body = parts.is_inf ? "inf" : "nan";
+  // Zero padding does not apply.
+  const size_t len = prefix_len + 3;
+  const size_t padding =
+      size_t(section.min_width) > len ? section.min_width - len : 0;
+  if (!(section.flags & LEFT_JUSTIFIED))
+    writer->write_chars(' ', padding);
+  writer->write(prefix, prefix_len);
+  writer->write(body, 3);
+  if (section.flags & LEFT_JUSTIFIED)
+    writer->write_chars(' ', padding);
+}
+
+// %f: `precision` digits after the decimal point.
+template <typename Number>
+void write_fixed(Writer *writer, const FormatSection &section,
+                 const char *prefix, size_t prefix_len, Number &number,
+                 int decimal_exponent, size_t precision) {
+  const ptrdiff_t keep = number.length() + decimal_exponent + precision;
+  if (keep <= 0) {
+    // The value is below one unit of the last digit, it rounds to that unit
+    // if above its half. The tie rounds to the even zero.
+    const bool round_up =
+        keep == 0 &&
+        (number.digit(0) > 5 ||
+         (number.digit(0) == 5 && number.has_nonzero_digits_after(0)));
+    number.set_small(round_up ? 1 : 0);
+    decimal_exponent = round_up ? -static_cast<int>(precision) : 0;
+  } else {
+    number.round_to(keep);
+  }
+
+  const ptrdiff_t int_digits = number.length() + decimal_exponent;
+  const bool point = precision != 0 || (section.flags & ALTERNATE_FORM);
+  const size_t body_len = (int_digits > 0 ? int_digits : 1) + point + precision;
+
+  Padding padding(writer, section);
+  padding.begin(prefix, prefix_len, body_len);
+  if (int_digits > 0)
+    write_digits(writer, number, 0, int_digits);
+  else
+    writer->write_char('0');
+  if (point)
+    writer->write_char('.');
+  write_digits(writer, number, int_digits, int_digits + precision);
+  padding.end();
+}
+
+// %e: one digit before the decimal point and `precision` after it.
+template <typename Number>
+void write_exponential(Writer *writer, const FormatSection &section,
+                       const char *prefix, size_t prefix_len, Number &number,
+                       int decimal_exponent, size_t precision) {
+  int exponent = 0;
+  if (!number.is_zero()) {
+    number.round_to(precision + 1);
+    exponent = number.length() - 1 + decimal_exponent;
+  }
+
+  char exponent_buffer[kIntBufferSize];
+  char *const exponent_end = exponent_buffer + kIntBufferSize;
+  size_t exponent_len =
+      format_decimal(exponent < 0 ? -exponent : exponent, exponent_end);
+  if (exponent_len < 2)
+    exponent_buffer[kIntBufferSize - ++exponent_len] = '0';
+
+  const bool point = precision != 0 || (section.flags & ALTERNATE_FORM);
+  const size_t body_len = 1 + point + precision + 2 + exponent_len;
+
+  Padding padding(writer, section);
+  padding.begin(prefix, prefix_len, body_len);
+  write_digits(writer, number, 0, 1);
+  if (point)
+    writer->write_char('.');
+  write_digits(writer, number, 1, 1 + precision);
+  writer->write_char(is_upper(section.conv_name) ? 'E' : 'e');
+  writer->write_char(exponent < 0 ? '-' : '+');
+  writer->write(exponent_end - exponent_len, exponent_len);
+  padding.end();
+}
+
+// %g: `precision` significant digits, in the style of %f unless the exponent
+// is too small or too large, without trailing zeros unless the alternate form
+// is requested.
+template <typename Number>
+void write_general(Writer *writer, const FormatSection &section,
+                   const char *prefix, size_t prefix_len, Number &number,
+                   int decimal_exponent, size_t precision) {
+  if (precision == 0)
+    precision = 1;
+  int exponent = 0;
+  if (!number.is_zero()) {
+    number.round_to(precision);
+    exponent = number.length() - 1 + decimal_exponent;
+  }
+
+  // The index of the last nonzero significant digit.
+  ptrdiff_t last_nonzero = -1;
+  if (!(section.flags & ALTERNATE_FORM)) {
+    const ptrdiff_t len = number.length();
+    for (ptrdiff_t i = (ptrdiff_t(precision) < len ? precision : len) - 1;
+         i >= 0; --i)
+      if (number.digit(i) != 0) {
+        last_nonzero = i;
+        break;
+      }
+  }
+
+  if (ptrdiff_t(precision) > exponent && exponent >= -4) {
+    ptrdiff_t fraction_digits = precision - 1 - exponent;
+    if (!(section.flags & ALTERNATE_FORM) &&
+        last_nonzero - exponent < fraction_digits)
+      fraction_digits = last_nonzero > exponent ? last_nonzero - exponent : 0;
+    write_fixed(writer, section, prefix, prefix_len, number, decimal_exponent,
+                fraction_digits);
+  } else {
+    ptrdiff_t fraction_digits = precision - 1;
+    if (!(section.flags & ALTERNATE_FORM) && last_nonzero < fraction_digits)
+      fraction_digits = last_nonzero > 0 ? last_nonzero : 0;
+    write_exponential(writer, section, prefix, prefix_len, number,
+                      decimal_exponent, fraction_digits);
+  }
+}
+
+template <size_t MaxLimbs>
+void convert_decimal(Writer *writer, const FormatSection &section,
+                     const FloatParts &parts, const char *prefix,
+                     size_t prefix_len) {
+  DecimalNumber<MaxLimbs> number;
+  int decimal_exponent;
+  number.set(parts.mantissa, parts.exponent, decimal_exponent);
+  const size_t precision = section.precision < 0 ? 6 : section.precision;
+  switch (section.conv_name) {
+  case 'f':
+  case 'F':
+    write_fixed(writer, section, prefix, prefix_len, number, decimal_exponent,
+                precision);
+    return;
+  case 'e':
+  case 'E':
+    write_exponential(writer, section, prefix, prefix_len, number,
+                      decimal_exponent, precision);
+    return;
+  default:
+    write_general(writer, section, prefix, prefix_len, number,
+                  decimal_exponent, precision);
+    return;
+  }
+}
+
+// %a: the hexadecimal digits of the mantissa, normalized to a leading one,
+// followed by the binary exponent.
+void convert_hex(Writer *writer, const FormatSection &section,
+                 const FloatParts &parts, char *prefix, size_t prefix_len) {
+  const bool upper = is_upper(section.conv_name);
+  prefix[prefix_len++] = '0';
+  prefix[prefix_len++] = upper ? 'X' : 'x';
+
+  // The leading digit and 16 fraction digits.
+  unsigned lead = 0;
+  uint64_t fraction = 0;
+  int exponent = 0;
+  if (parts.mantissa != 0) {
+    const int msb = 63 - __builtin_clzll(parts.mantissa);
+    lead = 1;
+    fraction = msb == 0 ? 0 : parts.mantissa << (64 - msb);
+    exponent = parts.exponent + msb;
+  }
+
+  size_t precision;
+  if (section.precision < 0) {
+    precision = fraction == 0 ? 0 : 16 - __builtin_ctzll(fraction) / 4;
+  } else {
+    precision = section.precision;
+    if (precision < 16) {
+      // Round ties to even, the leading digit can become a two.
+      const unsigned dropped = 64 - 4 * precision;
+      const __uint128_t value = (__uint128_t(lead) << 64) | fraction;
+      const __uint128_t half = __uint128_t(1) << (dropped - 1);
+      const __uint128_t rest = value & ((half << 1) - 1);
+      __uint128_t kept = value >> dropped;
+      if (rest > half || (rest == half && (kept & 1) != 0))
+        ++kept;
+      lead = static_cast<unsigned>(kept >> (4 * precision));
+      fraction = precision == 0
+                     ? 0
+                     : static_cast<uint64_t>(kept) << (64 - 4 * precision);
+    }
+  }
+
+  char exponent_buffer[kIntBufferSize];
+  char *const exponent_end = exponent_buffer + kIntBufferSize;
+  const size_t exponent_len =
+      format_decimal(exponent < 0 ? -exponent : exponent, exponent_end);
+
+  const bool point = precision != 0 || (section.flags & ALTERNATE_FORM);
+  const size_t body_len = 1 + point + precision + 2 + exponent_len;
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+  Padding padding(writer, section);
+  padding.begin(prefix, prefix_len, body_len);
+  writer->write_char(digits[lead]);
+  if (point)
+    writer->write_char('.');
+  for (size_t i = 0; i < precision; ++i) {
+    writer->write_char(digits[fraction >> 60]);
+    fraction <<= 4;
+  }
+  writer->write_char(upper ? 'P' : 'p');
+  writer->write_char(exponent < 0 ? '-' : '+');
+  writer->write(exponent_end - exponent_len, exponent_len);
+  padding.end();
+}
+
+} // namespace
+
+void convert_float(Writer *writer, const FormatSection &section) {
+  const bool is_long_double = section.length_modifier == LengthModifier::L;
+  const FloatParts parts = is_long_double
+                               ? decompose(section.conv_val_long_double)
+                               : decompose(section.conv_val_double);
+  if (parts.is_inf || parts.is_nan) {
+    write_inf_or_nan(writer, section, parts);
+    return;
+  }
+
+  char prefix[3];
+  const size_t prefix_len = sign_prefix(section, parts.negative, prefix);
+  if (section.conv_name == 'a' || section.conv_name == 'A')
+    convert_hex(writer, section, parts, prefix, prefix_len);
+  else if (is_long_double)
+    convert_decimal<kLongDoubleLimbs>(writer, section, parts, prefix,
+                                      prefix_len);
+  else
+    convert_decimal<kDoubleLimbs>(writer, section, parts, prefix, prefix_len);
+}
+
+} // namespace printf_core
+} // namespace __llvm_libc
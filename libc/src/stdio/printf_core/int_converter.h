@@ -0,0 +1,74 @@
+//===-- Integer to string conversions of printf -----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_PRINTF_CORE_INT_CONVERTER_H
+#define LLVM_LIBC_SRC_STDIO_PRINTF_CORE_INT_CONVERTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+// Large enough for the octal digits of a 64 bit integer.
+constexpr size_t kIntBufferSize = 24;
+
+// The functions below write the digits of `value` so that they end at `end`
+// and return their number.
+
+static inline size_t format_decimal(uintmax_t value, char *end) {
+  // Two digits at a time halves the number of divisions.
+  static constexpr char kDigitPairs[] = "00010203040506070809"
+                                        "10111213141516171819"
+                                        "20212223242526272829"
+                                        "30313233343536373839"
+                                        "40414243444546474849"
+                                        "50515253545556575859"
+                                        "60616263646566676869"
+                                        "70717273747576777879"
+                                        "80818283848586878889"
+                                        "90919293949596979899";
+  char *cur = end;
+  while (value >= 100) {
+    const unsigned pair = static_cast<unsigned>(value % 100) * 2;
+    value /= 100;
+    *--cur = kDigitPairs[pair + 1];
+    *--cur = kDigitPairs[pair];
+  }
+  if (value >= 10) {
+    *--cur = kDigitPairs[value * 2 + 1];
+    *--cur = kDigitPairs[value * 2];
+  } else {
+    *--cur = static_cast<char>('0' + value);
+  }
+  return end - cur;
+}
+
+static inline size_t format_octal(uintmax_t value, char *end) {
+  char *cur = end;
+  do {
+    *--cur = static_cast<char>('0' + (value & 7));
+    value >>= 3;
+  } while (value != 0);
+  return end - cur;
+}
+
+static inline size_t format_hex(uintmax_t value, char *end, bool upper) {
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  char *cur = end;
+  do {
+    *--cur = digits[value & 15];
+    value >>= 4;
+  } while (value != 0);
+  return end - cur;
+}
+
+} // namespace printf_core
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_PRINTF_CORE_INT_CONVERTER_H
@@ -0,0 +1,242 @@
+//===-- Format string parser of printf ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/printf_core/parser.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+static inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+// Saturates instead of overflowing, such widths fail later anyway.
+static int parse_number(const char *str, size_t &pos) {
+  int value = 0;
+  for (; is_digit(str[pos]); ++pos) {
+    const int digit = str[pos] - '0';
+    value = value > (INT32_MAX - digit) / 10 ? INT32_MAX : value * 10 + digit;
+  }
+  return value;
+}
+
+FormatSection Parser::get_next_section() {
+  FormatSection section;
+  const size_t start = cur_pos;
+  if (str[cur_pos] == '%' && str[cur_pos + 1] != '%') {
+    ++cur_pos;
+    section.has_conv = true;
+    parse_conversion(section);
+    section.raw_string = str + start;
+    section.raw_len = cur_pos - start;
+    return section;
+  }
+
+  // `%%` starts a raw section beginning with its second `%`.
+  size_t raw_start = start;
+  if (str[cur_pos] == '%') {
+    ++raw_start;
+    cur_pos += 2;
+  }
+  // A local position, as stores to the member may alias the string.
+  size_t pos = cur_pos;
+  while (str[pos] != '%' && str[pos] != '\0')
+    ++pos;
+  cur_pos = pos;
+  section.raw_string = str + raw_start;
+  section.raw_len = cur_pos - raw_start;
+  return section;
+}
+
+void Parser::parse_conversion(FormatSection &section) {
+  for (;; ++cur_pos) {
+    switch (str[cur_pos]) {
+    case '-':
+      section.flags |= LEFT_JUSTIFIED;
+      continue;
+    case '+':
+      section.flags |= FORCE_SIGN;
+      continue;
+    case ' ':
+      section.flags |= SPACE_PREFIX;
+      continue;
+    case '#':
+      section.flags |= ALTERNATE_FORM;
+      continue;
+    case '0':
+      section.flags |= LEADING_ZEROES;
+      continue;
+    }
+    break;
+  }
+
+  if (str[cur_pos] == '*') {
+    ++cur_pos;
+    int width = args.next_var<int>();
+    if (width < 0) {
+      section.flags |= LEFT_JUSTIFIED;
+      width = width == INT32_MIN ? INT32_MAX : -width;
+    }
+    section.min_width = width;
+  } else {
+    section.min_width = parse_number(str, cur_pos);
+  }
+
+  if (str[cur_pos] == '.') {
+    ++cur_pos;
+    if (str[cur_pos] == '*') {
+      ++cur_pos;
+      // A negative precision is taken as if it were omitted.
+      const int precision = args.next_var<int>();
+      section.precision = precision < 0 ? -1 : precision;
+    } else {
+      section.precision = parse_number(str, cur_pos);
+    }
+  }
+
+  switch (str[cur_pos]) {
+  case 'h':
+    ++cur_pos;
+    section.length_modifier = LengthModifier::h;
+    if (str[cur_pos] == 'h') {
+      ++cur_pos;
+      section.length_modifier = LengthModifier::hh;
+    }
+    break;
+  case 'l':
+    ++cur_pos;
+    section.length_modifier = LengthModifier::l;
+    if (str[cur_pos] == 'l') {
+      ++cur_pos;
+      section.length_modifier = LengthModifier::ll;
+    }
+    break;
+  case 'j':
+    ++cur_pos;
+    section.length_modifier = LengthModifier::j;
+    break;
+  case 'z':
+    ++cur_pos;
+    section.length_modifier = LengthModifier::z;
+    break;
+  case 't':
+    ++cur_pos;
+    section.length_modifier = LengthModifier::t;
+    break;
+  case 'L':
+    ++cur_pos;
+    section.length_modifier = LengthModifier::L;
+    break;
+  }
+
+  section.conv_name = str[cur_pos];
+  // A format string ending in the middle of a conversion is written as is.
+  if (section.conv_name != '\0')
+    ++cur_pos;
+  fetch_argument(section);
+}
+
+template <typename T> static inline uintmax_t sign_extend(T value) {
+  return static_cast<uintmax_t>(static_cast<intmax_t>(value));
+}
+
+void Parser::fetch_argument(FormatSection &section) {
+  switch (section.conv_name) {
+  case 'c':
+    section.conv_val_raw = static_cast<unsigned char>(args.next_var<int>());
+    return;
+  case 'd':
+  case 'i':
+    switch (section.length_modifier) {
+    case LengthModifier::hh:
+      section.conv_val_raw =
+          sign_extend(static_cast<signed char>(args.next_var<int>()));
+      return;
+    case LengthModifier::h:
+      section.conv_val_raw =
+          sign_extend(static_cast<short>(args.next_var<int>()));
+      return;
+    case LengthModifier::l:
+      section.conv_val_raw = sign_extend(args.next_var<long>());
+      return;
+    case LengthModifier::ll:
+    case LengthModifier::L:
+      section.conv_val_raw = sign_extend(args.next_var<long long>());
+      return;
+    case LengthModifier::j:
+      section.conv_val_raw = sign_extend(args.next_var<intmax_t>());
+      return;
+    case LengthModifier::z:
+    case LengthModifier::t:
+      section.conv_val_raw = sign_extend(args.next_var<ptrdiff_t>());
+      return;
+    case LengthModifier::none:
+      section.conv_val_raw = sign_extend(args.next_var<int>());
+      return;
+    }
+    return;
+  case 'o':
+  case 'u':
+  case 'x':
+  case 'X':
+    switch (section.length_modifier) {
+    case LengthModifier::hh:
+      section.conv_val_raw =
+          static_cast<unsigned char>(args.next_var<unsigned>());
+      return;
+    case LengthModifier::h:
+      section.conv_val_raw =
+          static_cast<unsigned short>(args.next_var<unsigned>());
+      return;
+    case LengthModifier::l:
+      section.conv_val_raw = args.next_var<unsigned long>();
+      return;
+    case LengthModifier::ll:
+    case LengthModifier::L:
+      section.conv_val_raw = args.next_var<unsigned long long>();
+      return;
+    case LengthModifier::j:
+      section.conv_val_raw = args.next_var<uintmax_t>();
+      return;
+    case LengthModifier::z:
+    case LengthModifier::t:
+      section.conv_val_raw = args.next_var<size_t>();
+      return;
+    case LengthModifier::none:
+      section.conv_val_raw = args.next_var<unsigned>();
+      return;
+    }
+    return;
+  case 'f':
+  case 'F':
+  case 'e':
+  case 'E':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    if (section.length_modifier == LengthModifier::L)
+      section.conv_val_long_double = args.next_var<long double>();
+    else
+      section.conv_val_double = args.next_var<double>();
+    return;
+  case 's':
+  case 'p':
+  case 'n':
+    section.conv_val_ptr = args.next_var<void *>();
+    return;
+  default:
+    // Unknown conversions do not consume an argument.
+    section.has_conv = false;
+    return;
+  }
+}
+
+} // namespace printf_core
+} // namespace __llvm_libc
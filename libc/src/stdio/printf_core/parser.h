@@ -0,0 +1,54 @@
+//===-- Format string parser of printf --------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_PRINTF_CORE_PARSER_H
+#define LLVM_LIBC_SRC_STDIO_PRINTF_CORE_PARSER_H
+
+#include "src/stdio/printf_core/core_structs.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+class ArgList {
+  va_list vlist;
+
+public:
+  explicit ArgList(va_list vlist) { va_copy(this->vlist, vlist); }
+  ~ArgList() { va_end(vlist); }
+
+  ArgList(const ArgList &) = delete;
+  ArgList &operator=(const ArgList &) = delete;
+
+  template <typename T> T next_var() { return va_arg(vlist, T); }
+};
+
+// Splits the format string in sections and fetches the argument of each
+// conversion in order. Positional arguments (`%1$d`) are not supported.
+class Parser {
+  const char *str;
+  size_t cur_pos = 0;
+  ArgList &args;
+
+  void parse_conversion(FormatSection &section);
+  void fetch_argument(FormatSection &section);
+
+public:
+  Parser(const char *str, ArgList &args) : str(str), args(args) {}
+
+  // Returns the next section, whose `raw_len` is zero at the end of the format
+  // string.
+  FormatSection get_next_section();
+};
+
+} // namespace printf_core
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_PRINTF_CORE_PARSER_H
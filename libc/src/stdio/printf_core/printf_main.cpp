@@ -0,0 +1,84 @@
+//===-- The driver of printf ----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/printf_core/printf_main.h"
+
+#include "include/errno.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdio/file_ops.h"
+#include "src/stdio/printf_core/converter.h"
+
+#include <stdint.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+int printf_main(Writer *writer, const char *__restrict format, ArgList &args) {
+  Parser parser(format, args);
+  for (FormatSection section = parser.get_next_section();
+       section.raw_len != 0; section = parser.get_next_section())
+    convert(writer, section);
+
+  writer->flush();
+  if (writer->has_failed())
+    return -1;
+  const size_t count = writer->get_chars_written();
+  if (count > size_t(INT32_MAX)) {
+    llvmlibc_errno = EOVERFLOW;
+    return -1;
+  }
+  return static_cast<int>(count);
+}
+
+static int write_to_file(void *output, const char *data, size_t len) {
+  FILE *stream = static_cast<FILE *>(output);
+  return write_unlocked(stream, data, len) == len ? 0 : -1;
+}
+
+int vfprintf_internal(FILE *__restrict stream, const char *__restrict format,
+                      va_list vlist) {
+  ArgList args(vlist);
+  Writer writer(stream, &write_to_file);
+  // The lock is held for the whole call, so that the output of concurrent
+  // calls is not interleaved.
+  FileLock lock(stream);
+  return printf_main(&writer, format, args);
+}
+
+namespace {
+
+struct StringOutput {
+  char *cur;
+  // The space left, excluding the null terminator.
+  size_t available;
+};
+
+} // namespace
+
+static int write_to_string(void *output, const char *data, size_t len) {
+  StringOutput *string = static_cast<StringOutput *>(output);
+  const size_t copied = len < string->available ? len : string->available;
+  __llvm_libc::memcpy(string->cur, data, copied);
+  string->cur += copied;
+  string->available -= copied;
+  return 0;
+}
+
+int vsnprintf_internal(char *__restrict buffer, size_t buffer_size,
+                       const char *__restrict format, va_list vlist) {
+  ArgList args(vlist);
+  StringOutput output{buffer, buffer_size == 0 ? 0 : buffer_size - 1};
+  Writer writer(&output, &write_to_string);
+  const int ret = printf_main(&writer, format, args);
+  if (buffer_size != 0)
+    *output.cur = '\0';
+  return ret;
+}
+
+} // namespace printf_core
+} // namespace __llvm_libc
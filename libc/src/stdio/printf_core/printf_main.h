@@ -0,0 +1,36 @@
+//===-- The driver of printf ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_PRINTF_CORE_PRINTF_MAIN_H
+#define LLVM_LIBC_SRC_STDIO_PRINTF_CORE_PRINTF_MAIN_H
+
+#include "src/stdio/FILE.h"
+#include "src/stdio/printf_core/parser.h"
+#include "src/stdio/printf_core/writer.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+// Writes the formatted output to `writer`, returns the number of characters
+// written or a negative value on error.
+int printf_main(Writer *writer, const char *__restrict format, ArgList &args);
+
+// The internals of the vfprintf and vsnprintf entrypoints, shared with the
+// other members of the family.
+int vfprintf_internal(FILE *__restrict stream, const char *__restrict format,
+                      va_list vlist);
+int vsnprintf_internal(char *__restrict buffer, size_t buffer_size,
+                       const char *__restrict format, va_list vlist);
+
+} // namespace printf_core
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_PRINTF_CORE_PRINTF_MAIN_H
@@ -0,0 +1,52 @@
+//===-- Output of printf --------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/printf_core/writer.h"
+
+#include "src/string/memcpy.h"
+#include "src/string/memory_utils/memset_utils.h"
+
+namespace __llvm_libc {
+namespace printf_core {
+
+void Writer::flush() {
+  if (used != 0 && raw_write(output, buffer, used) < 0)
+    failed = true;
+  used = 0;
+}
+
+void Writer::write_slow(const char *data, size_t len) {
+  flush();
+  chars_written += len;
+  // Large pieces are not copied to the buffer.
+  if (len >= kBufferSize) {
+    if (raw_write(output, data, len) < 0)
+      failed = true;
+    return;
+  }
+  __llvm_libc::memcpy(buffer, data, len);
+  used = len;
+}
+
+void Writer::write_repeated(char c, size_t count) {
+  if (count > kBufferSize - used)
+    flush();
+  while (count > kBufferSize) {
+    GeneralPurposeMemset(buffer, c, kBufferSize);
+    used = kBufferSize;
+    chars_written += kBufferSize;
+    count -= kBufferSize;
+    flush();
+  }
+  GeneralPurposeMemset(buffer + used, c, count);
+  used += count;
+  chars_written += count;
+}
+
+} // namespace printf_core
+} // namespace __llvm_libc
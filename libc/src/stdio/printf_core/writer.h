@@ -0,0 +1,78 @@
+//===-- Output of printf --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_PRINTF_CORE_WRITER_H
+#define LLVM_LIBC_SRC_STDIO_PRINTF_CORE_WRITER_H
+
+#include "src/__support/common.h"
+#include "src/string/memcpy.h"
+
+#include <stddef.h>
+
+namespace __llvm_libc {
+namespace printf_core {
+
+// Writes `len` bytes to `output`, returns a negative value on error.
+using WriteFunc = int (*)(void *output, const char *data, size_t len);
+
+// Collects the output of a printf call in a small buffer, so that the many
+// short pieces of a format reach the output in a few calls. It also counts what
+// is written and remembers the first error, so that the converters do not have
+// to check every write.
+class Writer {
+  static constexpr size_t kBufferSize = 256;
+
+  void *output;
+  WriteFunc raw_write;
+  size_t chars_written = 0;
+  size_t used = 0;
+  bool failed = false;
+  char buffer[kBufferSize];
+
+  void write_slow(const char *data, size_t len);
+  void write_repeated(char c, size_t count);
+
+public:
+  Writer(void *output, WriteFunc raw_write)
+      : output(output), raw_write(raw_write) {}
+
+  void write(const char *data, size_t len) {
+    if (likely(len <= kBufferSize - used)) {
+      __llvm_libc::memcpy(buffer + used, data, len);
+      used += len;
+      chars_written += len;
+      return;
+    }
+    write_slow(data, len);
+  }
+
+  void write_char(char c) {
+    if (unlikely(used == kBufferSize))
+      flush();
+    buffer[used++] = c;
+    ++chars_written;
+  }
+
+  // Writes `count` copies of `c`, as used for padding.
+  void write_chars(char c, size_t count) {
+    if (count != 0)
+      write_repeated(c, count);
+  }
+
+  // Passes the buffered output on, which must be done before the output is
+  // used.
+  void flush();
+
+  size_t get_chars_written() const { return chars_written; }
+  bool has_failed() const { return failed; }
+};
+
+} // namespace printf_core
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_PRINTF_CORE_WRITER_H
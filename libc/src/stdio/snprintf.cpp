@@ -0,0 +1,29 @@
+//===-- Implementation of snprintf ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/snprintf.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/printf_core/printf_main.h"
+
+#include <stdarg.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, snprintf,
+                   (char *__restrict buffer, size_t buffer_size,
+                    const char *__restrict format, ...)) {
+  va_list vlist;
+  va_start(vlist, format);
+  const int ret =
+      printf_core::vsnprintf_internal(buffer, buffer_size, format, vlist);
+  va_end(vlist);
+  return ret;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,31 @@
+//===-- Implementation of sprintf -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/sprintf.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/printf_core/printf_main.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, sprintf,
+                   (char *__restrict buffer, const char *__restrict format,
+                    ...)) {
+  va_list vlist;
+  va_start(vlist, format);
+  // The buffer is assumed to be large enough.
+  const int ret =
+      printf_core::vsnprintf_internal(buffer, SIZE_MAX, format, vlist);
+  va_end(vlist);
+  return ret;
+}
+
+} // namespace __llvm_libc
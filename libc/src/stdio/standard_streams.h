@@ -0,0 +1,22 @@
+//===-- The standard streams ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDIO_STANDARD_STREAMS_H
+#define LLVM_LIBC_SRC_STDIO_STANDARD_STREAMS_H
+
+#include "src/stdio/FILE.h"
+
+namespace __llvm_libc {
+
+extern FILE *stdin;
+extern FILE *stdout;
+extern FILE *stderr;
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDIO_STANDARD_STREAMS_H
@@ -0,0 +1,22 @@
+//===-- Implementation of vfprintf ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/vfprintf.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/printf_core/printf_main.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, vfprintf,
+                   (__llvm_libc::FILE *__restrict stream,
+                    const char *__restrict format, va_list vlist)) {
+  return printf_core::vfprintf_internal(stream, format, vlist);
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,22 @@
+//===-- Implementation of vsnprintf ---------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/vsnprintf.h"
+
+#include "src/__support/common.h"
+#include "src/stdio/printf_core/printf_main.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(int, vsnprintf,
+                   (char *__restrict buffer, size_t buffer_size,
+                    const char *__restrict format, va_list vlist)) {
+  return printf_core::vsnprintf_internal(buffer, buffer_size, format, vlist);
+}
+
+} // namespace __llvm_libc
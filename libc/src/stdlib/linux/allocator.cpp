@@ -0,0 +1,520 @@
+//===-- Implementation of the internal allocator --------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/linux/allocator.h"
+
+#include "include/errno.h"    // For ENOMEM.
+#include "include/sys/mman.h" // For PROT_* and MAP_* macros.
+#include "include/threads.h"  // For mtx_t definition.
+#include "src/__support/common.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/string/memory_utils/memset_utils.h"
+#include "src/sys/mman/mmap.h"
+#include "src/sys/mman/munmap.h"
+#include "src/threads/mtx_lock.h"
+#include "src/threads/multithreaded.h"
+#include "src/threads/mtx_unlock.h"
+
+#include <stdint.h> // For uintptr_t, SIZE_MAX.
+
+namespace __llvm_libc {
+namespace allocator {
+
+namespace {
+
+// Slabs and the headers of large mappings are aligned on `kSlabSize`.
+constexpr size_t kSlabSize = size_t(1) << 18;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kPageSize = 4096;
+
+// Sizes up to 128 bytes are rounded to a multiple of 16, larger sizes to one
+// of the four classes splitting each power of two interval.
+constexpr size_t kMaxSmallSize = 32768;
+constexpr unsigned kNumSizeClasses = 40;
+
+// Each thread caches up to about this many bytes of free objects per size
+// class, within the object count bounds below.
+constexpr size_t kThreadCacheBytes = 32768;
+constexpr unsigned kMinCachedObjects = 4;
+constexpr unsigned kMaxCachedObjects = 64;
+
+// Threads created by thrd_create share this many caches, see `SharedCaches`.
+// Their stacks are at least `1 << kThreadStackShift` bytes long.
+constexpr unsigned kNumSharedCaches = 64;
+constexpr unsigned kThreadStackShift = 16;
+
+// Completely free slabs kept around for any size class to reuse.
+constexpr unsigned kMaxEmptySlabs = 8;
+
+// Freed large mappings kept around for reuse, within both bounds.
+constexpr unsigned kMaxCachedLargeChunks = 8;
+constexpr size_t kMaxCachedLargeBytes = size_t(32) << 20;
+
+enum class ChunkKind : uint32_t { Slab = 0x51AB, Large = 0x1A26E };
+
+struct ChunkHeader {
+  ChunkKind Kind;
+};
+
+struct FreeObject {
+  FreeObject *Next;
+};
+
+struct Slab : ChunkHeader {
+  uint32_t SizeClass;
+  uint32_t ObjectSize;
+  // The number of objects held by users and thread caches.
+  uint32_t Used;
+  // Objects past `Bump` have never been allocated, which spares touching the
+  // pages of a fresh slab before they are needed.
+  char *Bump;
+  char *End;
+  FreeObject *FreeList;
+  // Links in the partial list of the size class.
+  Slab *Prev;
+  Slab *Next;
+  bool IsPartial;
+};
+
+static_assert(sizeof(Slab) <= kHeaderSize, "Slab header is too large.");
+
+struct LargeChunk : ChunkHeader {
+  char *MapBase;
+  size_t MapSize;
+};
+
+static_assert(sizeof(LargeChunk) <= kHeaderSize, "Large header is too large.");
+
+struct SizeClassState {
+  // A zero initialized `mtx_t` is an unlocked plain mutex.
+  mtx_t Lock;
+  // The slabs with free or never allocated objects.
+  Slab *Partial;
+  unsigned PartialCount;
+};
+
+struct ThreadCache {
+  FreeObject *Lists[kNumSizeClasses];
+  uint32_t Counts[kNumSizeClasses];
+};
+
+SizeClassState SizeClasses[kNumSizeClasses];
+
+mtx_t EmptySlabsLock;
+Slab *EmptySlabs;
+unsigned EmptySlabCount;
+
+mtx_t LargeChunksLock;
+LargeChunk *LargeChunks[kMaxCachedLargeChunks];
+unsigned LargeChunkCount;
+size_t LargeChunkBytes;
+
+// The cache is trivially destructible, so threads exit without returning the
+// objects it holds. They stay allocated from the point of view of their slab.
+static thread_local ThreadCache Cache;
+
+// Threads created by thrd_create do not get their own TLS area yet (see the
+// TODO in thrd_create.cpp), so they cannot use `Cache`, which they would share
+// with the thread that created them. Once there are such threads, every thread
+// uses one of these caches instead, picked by hashing its stack address, under
+// the lock of the cache, taken before any other allocator lock. Threads on
+// distinct stacks mostly get distinct caches, so that the lock is rarely
+// contended. The objects left in `Cache` of the first thread stay there.
+struct alignas(64) SharedCache {
+  mtx_t Lock;
+  ThreadCache Cache;
+};
+
+SharedCache SharedCaches[kNumSharedCaches];
+
+class LockGuard {
+  mtx_t *Mutex;
+
+public:
+  explicit LockGuard(mtx_t *M) : Mutex(M) { __llvm_libc::mtx_lock(Mutex); }
+  ~LockGuard() { __llvm_libc::mtx_unlock(Mutex); }
+};
+
+// A thread created by thrd_create has its stack in one or two windows of
+// `1 << kThreadStackShift` bytes, shared with at most one other such thread.
+// Threads sharing a window share a cache, and a thread whose stack crosses a
+// window boundary may use two caches, which are only less efficient.
+static inline unsigned get_shared_cache_index() {
+  const uint64_t Window =
+      reinterpret_cast<uintptr_t>(__builtin_frame_address(0)) >>
+      kThreadStackShift;
+  // Fibonacci hashing, as the stacks of successive threads are often adjacent.
+  return (Window * 0x9E3779B97F4A7C15ULL) >> (64 - 6);
+}
+
+static_assert(kNumSharedCaches == 1 << 6, "Update the hash above.");
+
+// Gives the cache of the calling thread, locked while it may be shared, see
+// `SharedCaches`.
+class CacheGuard {
+  mtx_t *Lock;
+
+public:
+  ThreadCache *TC;
+
+  CacheGuard() {
+    if (likely(!is_multithreaded())) {
+      Lock = nullptr;
+      TC = &Cache;
+      return;
+    }
+    SharedCache &Shared = SharedCaches[get_shared_cache_index()];
+    Lock = &Shared.Lock;
+    __llvm_libc::mtx_lock(Lock);
+    TC = &Shared.Cache;
+  }
+  ~CacheGuard() {
+    if (unlikely(Lock != nullptr))
+      __llvm_libc::mtx_unlock(Lock);
+  }
+};
+
+static inline uintptr_t align_up(uintptr_t Value, size_t Alignment) {
+  return (Value + Alignment - 1) & ~(uintptr_t(Alignment) - 1);
+}
+
+static inline unsigned get_size_class(size_t Size) {
+  if (Size <= 128)
+    return Size <= 16 ? 0 : (Size - 1) / 16;
+  const unsigned Log = 63 - __builtin_clzll(Size - 1);
+  const unsigned Step = ((Size - 1) >> (Log - 2)) & 3;
+  return 8 + (Log - 7) * 4 + Step;
+}
+
+static inline size_t get_class_size(unsigned SizeClass) {
+  if (SizeClass < 8)
+    return (SizeClass + 1) * 16;
+  const unsigned Log = 7 + (SizeClass - 8) / 4;
+  const unsigned Step = (SizeClass - 8) % 4;
+  return (size_t(1) << Log) + (Step + 1) * (size_t(1) << (Log - 2));
+}
+
+static_assert(kMaxSmallSize % kHeaderSize == 0,
+              "The largest size class must be aligned like slab objects.");
+
+// Objects start on a multiple of their size past the slab header, so they are
+// aligned on `Alignment` when both are multiples of it.
+static inline unsigned get_aligned_size_class(size_t Size, size_t Alignment) {
+  unsigned SizeClass = get_size_class(Size);
+  while ((get_class_size(SizeClass) & (Alignment - 1)) != 0)
+    ++SizeClass;
+  return SizeClass;
+}
+
+static inline unsigned get_cache_capacity(size_t ObjectSize) {
+  const size_t Capacity = kThreadCacheBytes / ObjectSize;
+  if (Capacity < kMinCachedObjects)
+    return kMinCachedObjects;
+  if (Capacity > kMaxCachedObjects)
+    return kMaxCachedObjects;
+  return Capacity;
+}
+
+// Every block returned to the user lies within `kSlabSize` bytes after its
+// header, and is only aligned on `kSlabSize` if it is a large block with such
+// an alignment, whose header is then exactly `kSlabSize` bytes before it.
+static inline ChunkHeader *get_header(const void *Ptr) {
+  const uintptr_t Address = reinterpret_cast<uintptr_t>(Ptr);
+  uintptr_t Base = Address & ~(uintptr_t(kSlabSize) - 1);
+  if (Base == Address)
+    Base -= kSlabSize;
+  return reinterpret_cast<ChunkHeader *>(Base);
+}
+
+static char *map(size_t Size) {
+  void *Region = __llvm_libc::mmap(nullptr, Size, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return Region == MAP_FAILED ? nullptr : static_cast<char *>(Region);
+}
+
+// Maps `Size` bytes starting at an `Alignment` boundary, plus `Offset` bytes
+// before it, and unmaps what is left of the region on both sides.
+static char *map_aligned(size_t Offset, size_t Size, size_t Alignment) {
+  const size_t RegionSize = align_up(Offset + Size, kPageSize) + Alignment;
+  char *Region = map(RegionSize);
+  if (Region == nullptr)
+    return nullptr;
+  char *Start = reinterpret_cast<char *>(
+      align_up(reinterpret_cast<uintptr_t>(Region) + Offset, Alignment) -
+      Offset);
+  char *End = Start + align_up(Offset + Size, kPageSize);
+  if (Start != Region)
+    __llvm_libc::munmap(Region, Start - Region);
+  if (End != Region + RegionSize)
+    __llvm_libc::munmap(End, Region + RegionSize - End);
+  return Start;
+}
+
+static void push_partial(SizeClassState &State, Slab *S) {
+  S->Prev = nullptr;
+  S->Next = State.Partial;
+  if (State.Partial != nullptr)
+    State.Partial->Prev = S;
+  State.Partial = S;
+  S->IsPartial = true;
+  ++State.PartialCount;
+}
+
+static void remove_partial(SizeClassState &State, Slab *S) {
+  if (S->Prev != nullptr)
+    S->Prev->Next = S->Next;
+  else
+    State.Partial = S->Next;
+  if (S->Next != nullptr)
+    S->Next->Prev = S->Prev;
+  S->IsPartial = false;
+  --State.PartialCount;
+}
+
+static Slab *get_slab(unsigned SizeClass) {
+  Slab *S = nullptr;
+  {
+    LockGuard Guard(&EmptySlabsLock);
+    if (EmptySlabs != nullptr) {
+      S = EmptySlabs;
+      EmptySlabs = S->Next;
+      --EmptySlabCount;
+    }
+  }
+  if (S == nullptr) {
+    S = reinterpret_cast<Slab *>(map_aligned(0, kSlabSize, kSlabSize));
+    if (S == nullptr)
+      return nullptr;
+  }
+  const size_t ObjectSize = get_class_size(SizeClass);
+  S->Kind = ChunkKind::Slab;
+  S->SizeClass = SizeClass;
+  S->ObjectSize = ObjectSize;
+  S->Used = 0;
+  S->Bump = reinterpret_cast<char *>(S) + kHeaderSize;
+  S->End = S->Bump + (kSlabSize - kHeaderSize) / ObjectSize * ObjectSize;
+  S->FreeList = nullptr;
+  S->IsPartial = false;
+  return S;
+}
+
+static void release_slab(Slab *S) {
+  {
+    LockGuard Guard(&EmptySlabsLock);
+    if (EmptySlabCount < kMaxEmptySlabs) {
+      S->Next = EmptySlabs;
+      EmptySlabs = S;
+      ++EmptySlabCount;
+      return;
+    }
+  }
+  __llvm_libc::munmap(S, kSlabSize);
+}
+
+// Moves up to half the cache capacity of objects from the slabs of
+// `SizeClass` to the empty cache list of the class.
+static bool refill(ThreadCache &TC, unsigned SizeClass) {
+  const unsigned BatchSize =
+      get_cache_capacity(get_class_size(SizeClass)) / 2;
+  SizeClassState &State = SizeClasses[SizeClass];
+  FreeObject *List = nullptr;
+  unsigned Count = 0;
+
+  LockGuard Guard(&State.Lock);
+  while (Count < BatchSize) {
+    Slab *S = State.Partial;
+    if (S == nullptr) {
+      S = get_slab(SizeClass);
+      if (S == nullptr)
+        break;
+      push_partial(State, S);
+    }
+    for (; Count < BatchSize; ++Count) {
+      FreeObject *Object;
+      if (S->FreeList != nullptr) {
+        Object = S->FreeList;
+        S->FreeList = Object->Next;
+      } else if (S->Bump != S->End) {
+        Object = reinterpret_cast<FreeObject *>(S->Bump);
+        S->Bump += S->ObjectSize;
+      } else {
+        break;
+      }
+      ++S->Used;
+      Object->Next = List;
+      List = Object;
+    }
+    if (S->FreeList == nullptr && S->Bump == S->End)
+      remove_partial(State, S);
+  }
+
+  TC.Lists[SizeClass] = List;
+  TC.Counts[SizeClass] = Count;
+  return Count != 0;
+}
+
+// Returns `Count` objects from the cache list of `SizeClass` to their slabs.
+static void flush(ThreadCache &TC, unsigned SizeClass, unsigned Count) {
+  SizeClassState &State = SizeClasses[SizeClass];
+
+  LockGuard Guard(&State.Lock);
+  for (; Count != 0; --Count) {
+    FreeObject *Object = TC.Lists[SizeClass];
+    TC.Lists[SizeClass] = Object->Next;
+    --TC.Counts[SizeClass];
+
+    Slab *S = static_cast<Slab *>(get_header(Object));
+    Object->Next = S->FreeList;
+    S->FreeList = Object;
+    --S->Used;
+    if (!S->IsPartial)
+      push_partial(State, S);
+    // Keep one slab per size class even when it is empty, so that a thread
+    // repeatedly allocating and freeing a batch does not map and unmap it.
+    if (S->Used == 0 && State.PartialCount > 1) {
+      remove_partial(State, S);
+      release_slab(S);
+    }
+  }
+}
+
+static inline void *allocate_small(unsigned SizeClass) {
+  CacheGuard Guard;
+  ThreadCache &TC = *Guard.TC;
+  FreeObject *Object = TC.Lists[SizeClass];
+  if (unlikely(Object == nullptr)) {
+    if (!refill(TC, SizeClass))
+      return nullptr;
+    Object = TC.Lists[SizeClass];
+  }
+  TC.Lists[SizeClass] = Object->Next;
+  --TC.Counts[SizeClass];
+  return Object;
+}
+
+static inline void deallocate_small(Slab *S, void *Ptr) {
+  CacheGuard Guard;
+  ThreadCache &TC = *Guard.TC;
+  const unsigned SizeClass = S->SizeClass;
+  FreeObject *Object = static_cast<FreeObject *>(Ptr);
+  Object->Next = TC.Lists[SizeClass];
+  TC.Lists[SizeClass] = Object;
+  const uint32_t Count = ++TC.Counts[SizeClass];
+  if (unlikely(Count > get_cache_capacity(S->ObjectSize)))
+    flush(TC, SizeClass, Count / 2);
+}
+
+// Takes a cached large mapping of at least `MapSize` bytes, as long as it is
+// not much larger, so that a small block does not hold on to a huge mapping.
+static LargeChunk *take_cached_large(size_t MapSize) {
+  LockGuard Guard(&LargeChunksLock);
+  for (unsigned I = 0; I < LargeChunkCount; ++I) {
+    LargeChunk *Chunk = LargeChunks[I];
+    if (Chunk->MapSize < MapSize || Chunk->MapSize / 2 > MapSize)
+      continue;
+    LargeChunks[I] = LargeChunks[--LargeChunkCount];
+    LargeChunkBytes -= Chunk->MapSize;
+    return Chunk;
+  }
+  return nullptr;
+}
+
+static void release_large(LargeChunk *Chunk) {
+  {
+    LockGuard Guard(&LargeChunksLock);
+    if (LargeChunkCount < kMaxCachedLargeChunks &&
+        LargeChunkBytes + Chunk->MapSize <= kMaxCachedLargeBytes) {
+      LargeChunks[LargeChunkCount++] = Chunk;
+      LargeChunkBytes += Chunk->MapSize;
+      return;
+    }
+  }
+  __llvm_libc::munmap(Chunk->MapBase, Chunk->MapSize);
+}
+
+// Large blocks get their own mapping. The header is placed on the `kSlabSize`
+// boundary preceding the block, or `kSlabSize` bytes before it when the block
+// itself must be aligned on such a boundary. Every mapping starts on a
+// `kSlabSize` boundary, so a freed one can be reused for any block with a
+// smaller alignment; its first `Size` bytes are cleared if `Zero` is set, a
+// fresh mapping being zero filled already.
+static void *allocate_large(size_t Size, size_t Alignment, bool Zero) {
+  if (Size > SIZE_MAX / 2 || Alignment > SIZE_MAX / 4)
+    return nullptr;
+  size_t Offset;
+  char *Start;
+  if (Alignment < kSlabSize) {
+    Offset = Alignment < kHeaderSize ? kHeaderSize : Alignment;
+    if (LargeChunk *Chunk =
+            take_cached_large(align_up(Offset + Size, kPageSize))) {
+      char *Ptr = Chunk->MapBase + Offset;
+      if (Zero)
+        GeneralPurposeMemset(Ptr, 0, Size);
+      return Ptr;
+    }
+    Start = map_aligned(0, Offset + Size, kSlabSize);
+  } else {
+    Offset = kSlabSize;
+    Start = map_aligned(Offset, Size, Alignment);
+  }
+  if (Start == nullptr)
+    return nullptr;
+  LargeChunk *Header = reinterpret_cast<LargeChunk *>(Start);
+  Header->Kind = ChunkKind::Large;
+  Header->MapBase = Start;
+  Header->MapSize = align_up(Offset + Size, kPageSize);
+  return Start + Offset;
+}
+
+} // namespace
+
+void *allocate(size_t Size, size_t Alignment) {
+  void *Ptr;
+  if (likely(Size <= kMaxSmallSize && Alignment <= kHeaderSize))
+    Ptr = allocate_small(get_aligned_size_class(Size, Alignment));
+  else
+    Ptr = allocate_large(Size, Alignment, /*Zero=*/false);
+  if (unlikely(Ptr == nullptr))
+    llvmlibc_errno = ENOMEM;
+  return Ptr;
+}
+
+void *allocate_zeroed(size_t Size) {
+  if (Size > kMaxSmallSize) {
+    void *Ptr = allocate_large(Size, kMinAlignment, /*Zero=*/true);
+    if (unlikely(Ptr == nullptr))
+      llvmlibc_errno = ENOMEM;
+    return Ptr;
+  }
+  void *Ptr = allocate(Size);
+  if (likely(Ptr != nullptr))
+    GeneralPurposeMemset(static_cast<char *>(Ptr), 0, Size);
+  return Ptr;
+}
+
+void deallocate(void *Ptr) {
+  if (Ptr == nullptr)
+    return;
+  ChunkHeader *Header = get_header(Ptr);
+  if (likely(Header->Kind == ChunkKind::Slab)) {
+    deallocate_small(static_cast<Slab *>(Header), Ptr);
+    return;
+  }
+  release_large(static_cast<LargeChunk *>(Header));
+}
+
+size_t usable_size(const void *Ptr) {
+  ChunkHeader *Header = get_header(Ptr);
+  if (Header->Kind == ChunkKind::Slab)
+    return static_cast<Slab *>(Header)->ObjectSize;
+  LargeChunk *Large = static_cast<LargeChunk *>(Header);
+  return Large->MapBase + Large->MapSize - static_cast<const char *>(Ptr);
+}
+
+} // namespace allocator
+} // namespace __llvm_libc
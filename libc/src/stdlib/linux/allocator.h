@@ -0,0 +1,52 @@
+//===-- Internal allocator used by malloc and friends -----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Small requests are served from size class slabs: 256 KiB regions, aligned
+// on their size, which start with a header describing the size class and are
+// then carved into objects of that class. Each thread keeps a cache of free
+// objects per size class so that most allocations and deallocations neither
+// lock nor share cache lines with other threads. Caches are refilled from and
+// flushed to the slabs in batches, under a lock per size class.
+//
+// Requests larger than the largest size class get their own mapping, which
+// also starts with a header. Since every allocation lives in a slab or large
+// mapping, the header of any pointer returned to the user is found by masking
+// its address, and no per-object metadata is needed.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STDLIB_LINUX_ALLOCATOR_H
+#define LLVM_LIBC_SRC_STDLIB_LINUX_ALLOCATOR_H
+
+#include <stddef.h> // size_t
+
+namespace __llvm_libc {
+namespace allocator {
+
+// The alignment of every allocation, that of `max_align_t`.
+constexpr size_t kMinAlignment = 16;
+
+// Returns a block of at least `Size` bytes aligned on `Alignment`, a power of
+// two, or nullptr with errno set to ENOMEM.
+void *allocate(size_t Size, size_t Alignment = kMinAlignment);
+
+// Same as `allocate` but the block is zero-filled.
+void *allocate_zeroed(size_t Size);
+
+// Releases a block returned by `allocate` or `allocate_zeroed`, nullptr is
+// ignored.
+void deallocate(void *Ptr);
+
+// Returns the number of bytes usable from `Ptr`, which is at least the size
+// it was allocated with.
+size_t usable_size(const void *Ptr);
+
+} // namespace allocator
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STDLIB_LINUX_ALLOCATOR_H
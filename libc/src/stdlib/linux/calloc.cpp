@@ -0,0 +1,26 @@
+//===-- Implementation of calloc ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/calloc.h"
+#include "include/errno.h" // For ENOMEM.
+#include "src/__support/common.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdlib/linux/allocator.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(void *, calloc, (size_t num, size_t size)) {
+  size_t total;
+  if (__builtin_mul_overflow(num, size, &total)) {
+    llvmlibc_errno = ENOMEM;
+    return nullptr;
+  }
+  return allocator::allocate_zeroed(total);
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,38 @@
+//===-- Implementation of realloc -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/realloc.h"
+#include "src/__support/common.h"
+#include "src/stdlib/linux/allocator.h"
+#include "src/string/memcpy.h"
+
+namespace __llvm_libc {
+
+LLVM_LIBC_FUNCTION(void *, realloc, (void *ptr, size_t size)) {
+  if (ptr == nullptr)
+    return allocator::allocate(size);
+  if (size == 0) {
+    allocator::deallocate(ptr);
+    return nullptr;
+  }
+
+  // Shrinking by less than half, or growing within the slack of the block,
+  // keeps it in place.
+  const size_t usable = allocator::usable_size(ptr);
+  if (size <= usable && size >= usable / 2)
+    return ptr;
+
+  void *new_ptr = allocator::allocate(size);
+  if (new_ptr == nullptr)
+    return nullptr;
+  __llvm_libc::memcpy(new_ptr, ptr, size < usable ? size : usable);
+  allocator::deallocate(ptr);
+  return new_ptr;
+}
+
+} // namespace __llvm_libc
@@ -0,0 +1,92 @@
+//===-- Memcmp utils --------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LIBC_SRC_STRING_MEMORY_UTILS_MEMCMP_UTILS_H
+#define LIBC_SRC_STRING_MEMORY_UTILS_MEMCMP_UTILS_H
+
+#include "src/string/memory_utils/utils.h"
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint16_t, uint32_t, uint64_t
+
+namespace __llvm_libc {
+
+// All the functions below return the difference between the first mismatching
+// bytes, as unsigned chars, or zero when there is none. This is what the
+// simple byte loop implementation of memcmp returns.
+
+static inline int CmpByte(const char *lhs, const char *rhs, size_t offset) {
+  return static_cast<unsigned char>(lhs[offset]) -
+         static_cast<unsigned char>(rhs[offset]);
+}
+
+// Returns the index of the first set bit in the non zero `mask`.
+static inline size_t FirstSetBit(uint32_t mask) { return __builtin_ctz(mask); }
+static inline size_t FirstSetBit(uint64_t mask) {
+  return __builtin_ctzll(mask);
+}
+
+// A block comparator exposes its size as `kBlockSize` and compares blocks of
+// that size with `Cmp(lhs, rhs)`.
+
+// Compares scalar blocks of 2, 4 or 8 bytes. The xor of the loaded words has a
+// bit set in every mismatching byte, and the lowest one belongs to the first
+// of them on little endian targets.
+template <size_t kSize> struct ScalarCmpWord { using type = uint32_t; };
+template <> struct ScalarCmpWord<8> { using type = uint64_t; };
+
+template <size_t kSize> struct ScalarCmp {
+  static_assert(kSize == 2 || kSize == 4 || kSize == 8,
+                "unsupported block size");
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "mismatch index computation assumes little endian");
+  static constexpr size_t kBlockSize = kSize;
+  using Word = typename ScalarCmpWord<kSize>::type;
+
+  static int Cmp(const char *lhs, const char *rhs) {
+    Word a = 0, b = 0;
+    __builtin_memcpy(&a, lhs, kBlockSize);
+    __builtin_memcpy(&b, rhs, kBlockSize);
+    const Word mismatch = a ^ b;
+    if (mismatch == 0)
+      return 0;
+    return CmpByte(lhs, rhs, FirstSetBit(mismatch) / 8);
+  }
+};
+
+// Compares the first and the last `kBlockSize` bytes, which overlap. The first
+// mismatch of the last block is the first overall when the first block is
+// equal.
+//
+// Precondition: `count >= kBlockSize && count <= 2 * kBlockSize`.
+template <typename Block>
+static inline int CmpBlockOverlap(const char *lhs, const char *rhs,
+                                  size_t count) {
+  if (const int result = Block::Cmp(lhs, rhs))
+    return result;
+  const size_t offset = count - Block::kBlockSize;
+  return Block::Cmp(lhs + offset, rhs + offset);
+}
+
+// Compares `count` bytes by blocks of `kBlockSize` bytes, the last block
+// overlapping with the previous one.
+//
+// Precondition: `count >= kBlockSize`.
+template <typename Block>
+static inline int CmpBlocks(const char *lhs, const char *rhs, size_t count) {
+  constexpr size_t kBlockSize = Block::kBlockSize;
+  for (size_t offset = 0; offset + kBlockSize < count; offset += kBlockSize)
+    if (const int result = Block::Cmp(lhs + offset, rhs + offset))
+      return result;
+  const size_t offset = count - kBlockSize;
+  return Block::Cmp(lhs + offset, rhs + offset);
+}
+
+} // namespace __llvm_libc
+
+#endif //  LIBC_SRC_STRING_MEMORY_UTILS_MEMCMP_UTILS_H
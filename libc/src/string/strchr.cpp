@@ -7,19 +7,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "src/string/strchr.h"
+#include "src/string/string_utils.h"
 
 #include "src/__support/common.h"
 
 namespace __llvm_libc {
 
-// TODO: Look at performance benefits of comparing words.
 LLVM_LIBC_FUNCTION(char *, strchr, (const char *src, int c)) {
-  unsigned char *str =
-      const_cast<unsigned char *>(reinterpret_cast<const unsigned char *>(src));
   const unsigned char ch = c;
-  for (; *str && *str != ch; ++str)
-    ;
-  return *str == ch ? reinterpret_cast<char *>(str) : nullptr;
+  char *str = internal::find_first_character_or_null(src, ch);
+  return static_cast<unsigned char>(*str) == ch ? str : nullptr;
 }
 
 } // namespace __llvm_libc
@@ -9,41 +9,136 @@
 #ifndef LIBC_SRC_STRING_STRING_UTILS_H
 #define LIBC_SRC_STRING_STRING_UTILS_H
 
+#include "src/__support/sanitizer.h"
 #include "utils/CPP/Bitset.h"
 #include <stddef.h> // size_t
+#include <stdint.h> // uintptr_t
 
 namespace __llvm_libc {
 namespace internal {
 
+// The generic implementations below scan strings a word at a time. Words are
+// only loaded from aligned addresses, so a load never reaches into the page
+// following the one holding the end of the string.
+using Word = uintptr_t;
+
+static inline bool is_word_aligned(const void *ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % sizeof(Word) == 0;
+}
+
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline Word
+load_aligned_word(const void *ptr) {
+  Word word;
+  __builtin_memcpy(&word, __builtin_assume_aligned(ptr, sizeof(Word)),
+                   sizeof(Word));
+  return word;
+}
+
+// Returns a word with every byte set to `byte`.
+static constexpr Word repeat_byte(unsigned char byte) {
+  return (~Word(0) / 0xFF) * byte;
+}
+
+// Returns whether one of the bytes of `word` is zero.
+static constexpr bool has_zero_byte(Word word) {
+  return ((word - repeat_byte(0x01)) & ~word & repeat_byte(0x80)) != 0;
+}
+
 // Returns the length of a string, denoted by the first occurrence
 // of a null terminator.
-static inline size_t string_length(const char *src) {
-  size_t length;
-  for (length = 0; *src; ++src, ++length)
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline size_t
+string_length(const char *src) {
+  const char *ptr = src;
+  for (; !is_word_aligned(ptr); ++ptr)
+    if (*ptr == '\0')
+      return ptr - src;
+  while (!has_zero_byte(load_aligned_word(ptr)))
+    ptr += sizeof(Word);
+  for (; *ptr; ++ptr)
     ;
-  return length;
+  return ptr - src;
 }
 
 // Returns the first occurrence of 'ch' within the first 'n' characters of
 // 'src'. If 'ch' is not found, returns nullptr.
-static inline void *find_first_character(const unsigned char *src,
-                                         unsigned char ch, size_t n) {
+//
+// The words may extend past the end of an array shorter than 'n' bytes whose
+// contents contain 'ch', as happens for strnlen.
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline void *
+find_first_character(const unsigned char *src, unsigned char ch, size_t n) {
+  for (; n && !is_word_aligned(src); --n, ++src)
+    if (*src == ch)
+      return const_cast<unsigned char *>(src);
+  const Word pattern = repeat_byte(ch);
+  for (; n >= sizeof(Word); n -= sizeof(Word), src += sizeof(Word))
+    if (has_zero_byte(load_aligned_word(src) ^ pattern))
+      break;
   for (; n && *src != ch; --n, ++src)
     ;
   return n ? const_cast<unsigned char *>(src) : nullptr;
 }
 
+// Returns the first occurrence of 'ch' or of the null terminator in 'src'.
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline char *
+find_first_character_or_null(const char *src, unsigned char ch) {
+  const unsigned char *str = reinterpret_cast<const unsigned char *>(src);
+  for (; !is_word_aligned(str); ++str)
+    if (*str == ch || *str == '\0')
+      return reinterpret_cast<char *>(const_cast<unsigned char *>(str));
+  const Word pattern = repeat_byte(ch);
+  for (;; str += sizeof(Word)) {
+    const Word word = load_aligned_word(str);
+    if (has_zero_byte(word) || has_zero_byte(word ^ pattern))
+      break;
+  }
+  for (; *str != ch && *str != '\0'; ++str)
+    ;
+  return reinterpret_cast<char *>(const_cast<unsigned char *>(str));
+}
+
+// Returns the set of the characters of 'segment'.
+static inline cpp::Bitset<256> make_character_set(const char *segment) {
+  cpp::Bitset<256> bitset;
+  for (; *segment; ++segment)
+    bitset.set(static_cast<unsigned char>(*segment));
+  return bitset;
+}
+
+// Returns the maximum length span that contains only characters found in
+// 'segment'.
+static inline size_t span(const char *src, const char *segment) {
+  const unsigned char *str = reinterpret_cast<const unsigned char *>(src);
+  if (segment[0] == '\0')
+    return 0;
+  if (segment[1] == '\0') {
+    const unsigned char ch = segment[0];
+    for (; *str == ch; ++str)
+      ;
+    return str - reinterpret_cast<const unsigned char *>(src);
+  }
+  // The null terminator is never part of the set, it stops the scan without
+  // being tested separately.
+  const cpp::Bitset<256> bitset = make_character_set(segment);
+  for (; bitset.test(*str); ++str)
+    ;
+  return str - reinterpret_cast<const unsigned char *>(src);
+}
+
 // Returns the maximum length span that contains only characters not found in
 // 'segment'. If no characters are found, returns the length of 'src'.
 static inline size_t complementary_span(const char *src, const char *segment) {
-  const char *initial = src;
-  cpp::Bitset<256> bitset;
-
-  for (; *segment; ++segment)
-    bitset.set(*segment);
-  for (; *src && !bitset.test(*src); ++src)
+  if (segment[0] == '\0')
+    return string_length(src);
+  if (segment[1] == '\0')
+    return find_first_character_or_null(src, segment[0]) - src;
+  // Adding the null terminator to the set stops the scan at the end of the
+  // string with a single test per character.
+  cpp::Bitset<256> bitset = make_character_set(segment);
+  bitset.set(0);
+  const unsigned char *str = reinterpret_cast<const unsigned char *>(src);
+  for (; !bitset.test(*str); ++str)
     ;
-  return src - initial;
+  return str - reinterpret_cast<const unsigned char *>(src);
 }
 
 // Given the similarities between strtok and strtok_r, we can implement both
@@ -58,19 +153,17 @@ static inline size_t complementary_span(const char *src, const char *segment) {
 static inline char *string_token(char *__restrict src,
                                  const char *__restrict delimiter_string,
                                  char **__restrict saveptr) {
-  cpp::Bitset<256> delimiter_set;
-  for (; *delimiter_string; ++delimiter_string)
-    delimiter_set.set(*delimiter_string);
+  const cpp::Bitset<256> delimiter_set = make_character_set(delimiter_string);
 
   src = src ? src : *saveptr;
-  for (; *src && delimiter_set.test(*src); ++src)
+  for (; *src && delimiter_set.test(static_cast<unsigned char>(*src)); ++src)
     ;
   if (!*src) {
     *saveptr = src;
     return nullptr;
   }
   char *token = src;
-  for (; *src && !delimiter_set.test(*src); ++src)
+  for (; *src && !delimiter_set.test(static_cast<unsigned char>(*src)); ++src)
     ;
   if (*src) {
     *src = '\0';
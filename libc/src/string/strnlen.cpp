@@ -7,7 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "src/string/strnlen.h"
-#include "src/string/string_utils.h"
+#include "src/string/memchr.h"
 
 #include "src/__support/common.h"
 #include <stddef.h>
@@ -15,8 +15,7 @@
 namespace __llvm_libc {
 
 LLVM_LIBC_FUNCTION(size_t, strnlen, (const char *src, size_t n)) {
-  const void *temp = internal::find_first_character(
-      reinterpret_cast<const unsigned char *>(src), '\0', n);
+  const void *temp = __llvm_libc::memchr(src, '\0', n);
   return temp ? reinterpret_cast<const char *>(temp) - src : n;
 }
 
@@ -9,20 +9,13 @@
 #include "src/string/strspn.h"
 
 #include "src/__support/common.h"
-#include "utils/CPP/Bitset.h"
+#include "src/string/string_utils.h"
 #include <stddef.h>
 
 namespace __llvm_libc {
 
 LLVM_LIBC_FUNCTION(size_t, strspn, (const char *src, const char *segment)) {
-  const char *initial = src;
-  cpp::Bitset<256> bitset;
-
-  for (; *segment; ++segment)
-    bitset.set(*segment);
-  for (; *src && bitset.test(*src); ++src)
-    ;
-  return src - initial;
+  return internal::span(src, segment);
 }
 
 } // namespace __llvm_libc
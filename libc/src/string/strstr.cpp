@@ -9,21 +9,150 @@
 #include "src/string/strstr.h"
 
 #include "src/__support/common.h"
+#include "src/string/memchr.h"
+#include "src/string/memcmp.h"
+#include "src/string/strchr.h"
+#include "utils/CPP/Bitset.h"
 #include <stddef.h>
 
 namespace __llvm_libc {
 
-// TODO: This is a simple brute force implementation. This can be
-// improved upon using well known string matching algorithms.
-LLVM_LIBC_FUNCTION(char *, strstr, (const char *haystack, const char *needle)) {
-  for (size_t i = 0; haystack[i]; ++i) {
-    size_t j;
-    for (j = 0; haystack[i + j] && haystack[i + j] == needle[j]; ++j)
+// Returns the start of the maximal suffix of `needle` for the lexicographic
+// order on bytes, or for the reverse order if `reversed` is set, and stores the
+// period of that suffix in `period`.
+static size_t maximal_suffix(const unsigned char *needle, size_t length,
+                             bool reversed, size_t &period) {
+  // `start` is the start of the suffix minus one, `candidate` the start of a
+  // competing suffix and `k` the offset being compared in both.
+  size_t start = static_cast<size_t>(-1);
+  size_t candidate = 0;
+  size_t k = 1;
+  period = 1;
+  while (candidate + k < length) {
+    const unsigned char a = needle[start + k];
+    const unsigned char b = needle[candidate + k];
+    if (a == b) {
+      if (k == period) {
+        candidate += period;
+        k = 1;
+      } else {
+        ++k;
+      }
+    } else if (reversed ? a < b : a > b) {
+      candidate += k;
+      k = 1;
+      period = candidate - start;
+    } else {
+      start = candidate++;
+      k = period = 1;
+    }
+  }
+  return start + 1;
+}
+
+// The two way string matching algorithm of Crochemore and Perrin, which runs
+// in linear time and constant space. The needle is split at a critical
+// position: its right part is matched left to right first, then its left part
+// right to left. On a mismatch, the needle shifts by the distance the
+// factorization guarantees, and, before any comparison, by the distance the
+// last byte of the window requires, as in Boyer-Moore-Horspool.
+//
+// The end of the haystack is discovered with memchr as the window moves, so
+// that a long haystack is never scanned past the match.
+static char *two_way_search(const unsigned char *haystack,
+                            const unsigned char *needle) {
+  // The bytes of the needle, and the distance from the last occurrence of each
+  // of them to the end of the needle.
+  cpp::Bitset<256> needle_bytes;
+  size_t shift[256];
+  size_t length = 0;
+  for (; needle[length] != '\0'; ++length) {
+    if (haystack[length] == '\0')
+      return nullptr;
+    needle_bytes.set(needle[length]);
+    shift[needle[length]] = length + 1;
+  }
+
+  size_t period, reversed_period;
+  size_t critical = maximal_suffix(needle, length, false, period);
+  const size_t reversed_critical =
+      maximal_suffix(needle, length, true, reversed_period);
+  if (reversed_critical > critical) {
+    critical = reversed_critical;
+    period = reversed_period;
+  }
+
+  // When the left part repeats in the right part, the needle is periodic and
+  // the prefix matched before a shift by the period is remembered in `memory`.
+  // Otherwise the shift can be larger and nothing is remembered.
+  size_t memory_after_shift;
+  if (__llvm_libc::memcmp(needle, needle + period, critical) == 0) {
+    memory_after_shift = length - period;
+  } else {
+    // `critical` is not zero here: an empty left part always repeats.
+    memory_after_shift = 0;
+    period = (critical - 1 > length - critical ? critical - 1
+                                               : length - critical) +
+             1;
+  }
+
+  size_t memory = 0;
+  const unsigned char *known_end = haystack;
+  for (;;) {
+    // Makes sure that the window is within the haystack.
+    if (static_cast<size_t>(known_end - haystack) < length) {
+      const size_t grow = length | 63;
+      const void *end = __llvm_libc::memchr(known_end, '\0', grow);
+      if (end != nullptr) {
+        known_end = reinterpret_cast<const unsigned char *>(end);
+        if (static_cast<size_t>(known_end - haystack) < length)
+          return nullptr;
+      } else {
+        known_end += grow;
+      }
+    }
+
+    const unsigned char last = haystack[length - 1];
+    if (!needle_bytes.test(last)) {
+      haystack += length;
+      memory = 0;
+      continue;
+    }
+    if (const size_t skip = length - shift[last]) {
+      haystack += skip < memory ? memory : skip;
+      memory = 0;
+      continue;
+    }
+
+    // Right part, left to right.
+    size_t k = critical > memory ? critical : memory;
+    for (; k < length && needle[k] == haystack[k]; ++k)
       ;
-    if (!needle[j])
-      return const_cast<char *>(haystack + i);
+    if (k < length) {
+      haystack += k - critical + 1;
+      memory = 0;
+      continue;
+    }
+    // Left part, right to left.
+    for (k = critical; k > memory && needle[k - 1] == haystack[k - 1]; --k)
+      ;
+    if (k <= memory)
+      return const_cast<char *>(reinterpret_cast<const char *>(haystack));
+    haystack += period;
+    memory = memory_after_shift;
   }
-  return nullptr;
+}
+
+LLVM_LIBC_FUNCTION(char *, strstr, (const char *haystack, const char *needle)) {
+  if (needle[0] == '\0')
+    return const_cast<char *>(haystack);
+  // Most candidate positions are rejected on their first byte, which strchr
+  // skips to with vector comparisons.
+  haystack = __llvm_libc::strchr(haystack, needle[0]);
+  if (haystack == nullptr || needle[1] == '\0')
+    return const_cast<char *>(haystack);
+  return two_way_search(reinterpret_cast<const unsigned char *>(haystack),
+                        reinterpret_cast<const unsigned char *>(needle));
 }
 
 } // namespace __llvm_libc
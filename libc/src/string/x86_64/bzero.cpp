@@ -0,0 +1,47 @@
+//===-- Implementation of bzero -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/bzero.h"
+#include "src/__support/common.h"
+#include "src/string/x86_64/memory_variants.h"
+#include "src/string/x86_64/memset_implementations.h"
+
+namespace __llvm_libc {
+namespace x86 {
+
+#define LLVM_LIBC_BZERO_VARIANT(NAME, TARGET, VECTOR_SIZE, USE_REP_STOSB)      \
+  TARGET static void NAME(void *ptr, size_t count) {                           \
+    memset_x86<VECTOR_SIZE, USE_REP_STOSB>(reinterpret_cast<char *>(ptr), 0,   \
+                                           count);                             \
+  }
+
+LLVM_LIBC_BZERO_VARIANT(bzero_sse2, LLVM_LIBC_X86_TARGET_SSE2, 16, false)
+LLVM_LIBC_BZERO_VARIANT(bzero_sse2_erms, LLVM_LIBC_X86_TARGET_SSE2, 16, true)
+LLVM_LIBC_BZERO_VARIANT(bzero_avx2, LLVM_LIBC_X86_TARGET_AVX2, 32, false)
+LLVM_LIBC_BZERO_VARIANT(bzero_avx2_erms, LLVM_LIBC_X86_TARGET_AVX2, 32, true)
+LLVM_LIBC_BZERO_VARIANT(bzero_avx512, LLVM_LIBC_X86_TARGET_AVX512, 64, false)
+LLVM_LIBC_BZERO_VARIANT(bzero_avx512_erms, LLVM_LIBC_X86_TARGET_AVX512, 64,
+                        true)
+
+#undef LLVM_LIBC_BZERO_VARIANT
+
+BzeroFunction get_bzero_variant(MemoryVariant Variant) {
+  static constexpr BzeroFunction kVariants[kMemoryVariantCount] = {
+      bzero_sse2,      bzero_sse2_erms, bzero_avx2,
+      bzero_avx2_erms, bzero_avx512,    bzero_avx512_erms};
+  return kVariants[static_cast<unsigned>(Variant)];
+}
+
+} // namespace x86
+
+LLVM_LIBC_FUNCTION(void, bzero, (void *ptr, size_t count)) {
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(BzeroFunction, get_bzero_variant, ptr, count);
+}
+
+} // namespace __llvm_libc
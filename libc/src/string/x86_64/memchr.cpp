@@ -0,0 +1,43 @@
+//===-- Implementation of memchr ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/memchr.h"
+#include "src/__support/common.h"
+#include "src/string/x86_64/memory_variants.h"
+#include "src/string/x86_64/string_search_implementations.h"
+
+namespace __llvm_libc {
+namespace x86 {
+
+LLVM_LIBC_X86_TARGET_SSE2 LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static void *
+memchr_sse2(const void *src, int c, size_t count) {
+  return memchr_x86<Sse2Searcher>(reinterpret_cast<const char *>(src),
+                                static_cast<unsigned char>(c), count);
+}
+
+LLVM_LIBC_X86_TARGET_AVX2 LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static void *
+memchr_avx2(const void *src, int c, size_t count) {
+  return memchr_x86<Avx2Searcher>(reinterpret_cast<const char *>(src),
+                                static_cast<unsigned char>(c), count);
+}
+
+MemchrFunction get_memchr_variant(MemoryVariant Variant) {
+  static constexpr MemchrFunction kVariants[kMemoryVariantCount] = {
+      memchr_sse2, memchr_sse2, memchr_avx2,
+      memchr_avx2, memchr_avx2, memchr_avx2};
+  return kVariants[static_cast<unsigned>(Variant)];
+}
+
+} // namespace x86
+
+LLVM_LIBC_FUNCTION(void *, memchr, (const void *src, int c, size_t count)) {
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(MemchrFunction, get_memchr_variant, src, c, count);
+}
+
+} // namespace __llvm_libc
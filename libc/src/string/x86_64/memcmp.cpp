@@ -0,0 +1,120 @@
+//===-- Implementation of memcmp ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/memcmp.h"
+#include "src/__support/common.h"
+#include "src/string/memory_utils/memcmp_utils.h"
+#include "src/string/x86_64/memory_variants.h"
+
+#include <immintrin.h>
+#include <stddef.h> // size_t
+#include <stdint.h> // uint32_t, uint64_t
+
+namespace __llvm_libc {
+
+// Vector block comparators, the mask has a bit set for every mismatching byte.
+
+struct Sse2Cmp {
+  static constexpr size_t kBlockSize = 16;
+  static int Cmp(const char *lhs, const char *rhs) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs));
+    const uint32_t mismatch = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xFFFF;
+    if (mismatch == 0)
+      return 0;
+    return CmpByte(lhs, rhs, FirstSetBit(mismatch));
+  }
+};
+
+struct Avx2Cmp {
+  static constexpr size_t kBlockSize = 32;
+  __attribute__((target("avx2"))) static int Cmp(const char *lhs,
+                                                 const char *rhs) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs));
+    const __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs));
+    const uint32_t mismatch = ~static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    if (mismatch == 0)
+      return 0;
+    return CmpByte(lhs, rhs, FirstSetBit(mismatch));
+  }
+};
+
+struct Avx512Cmp {
+  static constexpr size_t kBlockSize = 64;
+  __attribute__((target("avx512f,avx512bw"))) static int
+  Cmp(const char *lhs, const char *rhs) {
+    const __m512i a = _mm512_loadu_si512(lhs);
+    const __m512i b = _mm512_loadu_si512(rhs);
+    const uint64_t mismatch = _mm512_cmpneq_epi8_mask(a, b);
+    if (mismatch == 0)
+      return 0;
+    return CmpByte(lhs, rhs, FirstSetBit(mismatch));
+  }
+};
+
+// Like memcpy, memcmp favors small sizes: for all but one of the production
+// size distributions (see benchmarks/MemorySizeDistributions.cpp) 70% to 99%
+// of the calls are for 16 bytes or less, and are served by at most two scalar
+// comparisons. Up to 32 bytes, where 75% to 100% of the calls fall, two 16
+// bytes vector comparisons suffice. Past that, the widest vectors are used.
+//
+// `WideCmp` is the block comparator for the widest vector register of the
+// variant, the variant itself is compiled for the corresponding target.
+template <typename WideCmp>
+static inline int memcmp_x86(const char *lhs, const char *rhs, size_t count) {
+  if (count == 0)
+    return 0;
+  if (count == 1)
+    return CmpByte(lhs, rhs, 0);
+  if (count < 4)
+    return CmpBlockOverlap<ScalarCmp<2>>(lhs, rhs, count);
+  if (count < 8)
+    return CmpBlockOverlap<ScalarCmp<4>>(lhs, rhs, count);
+  if (count <= 16)
+    return CmpBlockOverlap<ScalarCmp<8>>(lhs, rhs, count);
+  if (count <= 32 || WideCmp::kBlockSize == 16)
+    return CmpBlocks<Sse2Cmp>(lhs, rhs, count);
+  if (count <= 64 || WideCmp::kBlockSize == 32)
+    return CmpBlocks<Avx2Cmp>(lhs, rhs, count);
+  return CmpBlocks<WideCmp>(lhs, rhs, count);
+}
+
+namespace x86 {
+
+#define LLVM_LIBC_MEMCMP_VARIANT(NAME, TARGET, WIDE_CMP)                       \
+  TARGET static int NAME(const void *lhs, const void *rhs, size_t count) {     \
+    return memcmp_x86<WIDE_CMP>(reinterpret_cast<const char *>(lhs),           \
+                                reinterpret_cast<const char *>(rhs), count);   \
+  }
+
+LLVM_LIBC_MEMCMP_VARIANT(memcmp_sse2, LLVM_LIBC_X86_TARGET_SSE2, Sse2Cmp)
+LLVM_LIBC_MEMCMP_VARIANT(memcmp_avx2, LLVM_LIBC_X86_TARGET_AVX2, Avx2Cmp)
+LLVM_LIBC_MEMCMP_VARIANT(memcmp_avx512, LLVM_LIBC_X86_TARGET_AVX512, Avx512Cmp)
+
+#undef LLVM_LIBC_MEMCMP_VARIANT
+
+MemcmpFunction get_memcmp_variant(MemoryVariant Variant) {
+  // memcmp has no use for `rep` prefixed instructions.
+  static constexpr MemcmpFunction kVariants[kMemoryVariantCount] = {
+      memcmp_sse2, memcmp_sse2,   memcmp_avx2,
+      memcmp_avx2, memcmp_avx512, memcmp_avx512};
+  return kVariants[static_cast<unsigned>(Variant)];
+}
+
+} // namespace x86
+
+LLVM_LIBC_FUNCTION(int, memcmp,
+                   (const void *lhs, const void *rhs, size_t count)) {
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(MemcmpFunction, get_memcmp_variant, lhs, rhs, count);
+}
+
+} // namespace __llvm_libc
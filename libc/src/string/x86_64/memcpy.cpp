@@ -9,6 +9,7 @@
 #include "src/string/memcpy.h"
 #include "src/__support/common.h"
 #include "src/string/memory_utils/memcpy_utils.h"
+#include "src/string/x86_64/memory_variants.h"
 
 namespace __llvm_libc {
 
@@ -16,22 +17,21 @@ namespace __llvm_libc {
 constexpr bool kUseOnlyRepMovsb =
     LLVM_LIBC_IS_DEFINED(LLVM_LIBC_MEMCPY_X86_USE_ONLY_REPMOVSB);
 
-// kRepMovsBSize == -1 : Only CopyAligned is used.
-// kRepMovsBSize ==  0 : Only RepMovsb is used.
-// else CopyAligned is used up to kRepMovsBSize and then RepMovsb.
-constexpr size_t kRepMovsBSize =
+// The size from which the ERMS variants use `rep movsb`, which has a startup
+// cost of a few dozen cycles but then moves a cache line per cycle. The
+// production size distributions (see benchmarks/MemorySizeDistributions.cpp)
+// show that all but 0.3% of the calls are for less than 512 bytes, and none
+// for more than 1 KiB, so this threshold only matters for bulk copies. It
+// scales with the vector size since wider loops catch up later with
+// `rep movsb`.
 #ifdef LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE
-    LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE;
+template <size_t kVectorSize>
+constexpr size_t kRepMovsbThreshold = LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE;
 #else
-    -1;
+template <size_t kVectorSize>
+constexpr size_t kRepMovsbThreshold = 128 * kVectorSize;
 #endif // LLVM_LIBC_MEMCPY_X86_USE_REPMOVSB_FROM_SIZE
 
-// Whether target supports AVX instructions.
-constexpr bool kHasAvx = LLVM_LIBC_IS_DEFINED(__AVX__);
-
-// The chunk size used for the loop copy strategy.
-constexpr size_t kLoopCopyBlockSize = kHasAvx ? 64 : 32;
-
 static void CopyRepMovsb(char *__restrict dst, const char *__restrict src,
                          size_t count) {
   // FIXME: Add MSVC support with
@@ -49,7 +49,10 @@ static void CopyRepMovsb(char *__restrict dst, const char *__restrict src,
 // This makes it important to favor small sizes.
 //
 // The tests for `count` are in ascending order so the cost of branching is
-// proportional to the cost of copying.
+// proportional to the cost of copying. 95% of the calls are for less than 128
+// bytes and are served by two possibly overlapping copies. Wider vectors push
+// this limit further: 99% of the calls are for less than 256 bytes, which two
+// 128 bytes copies cover with AVX2.
 //
 // The function is written in C++ for several reasons:
 // - The compiler can __see__ the code, this is useful when performing Profile
@@ -59,8 +62,16 @@ static void CopyRepMovsb(char *__restrict dst, const char *__restrict src,
 //   implementation parameters.
 // - As compilers and processors get better, the generated code is improved
 //   with little change on the code side.
-static void memcpy_x86(char *__restrict dst, const char *__restrict src,
-                       size_t count) {
+//
+// `kVectorSize` is the size of the widest vector register of the variant, the
+// variant itself is compiled for the corresponding target.
+template <size_t kVectorSize, bool kUseRepMovsb>
+static inline void memcpy_x86(char *__restrict dst, const char *__restrict src,
+                              size_t count) {
+  // The chunk size and alignment used for the loop copy strategy.
+  constexpr size_t kLoopCopyBlockSize = 2 * kVectorSize;
+  constexpr size_t kLoopCopyAlignment = kVectorSize < 32 ? 32 : kVectorSize;
+
   if (kUseOnlyRepMovsb)
     return CopyRepMovsb(dst, src, count);
 
@@ -84,19 +95,51 @@ static void memcpy_x86(char *__restrict dst, const char *__restrict src,
     return CopyBlockOverlap<32>(dst, src, count);
   if (count < 128)
     return CopyBlockOverlap<64>(dst, src, count);
-  if (kHasAvx && count < 256)
+  if (kVectorSize >= 32 && count < 256)
     return CopyBlockOverlap<128>(dst, src, count);
-  if (count <= kRepMovsBSize)
-    return CopyDstAlignedBlocks<kLoopCopyBlockSize, 32>(dst, src, count);
-  return CopyRepMovsb(dst, src, count);
+  if (kVectorSize >= 64 && count < 512)
+    return CopyBlockOverlap<256>(dst, src, count);
+  if (kUseRepMovsb && count >= kRepMovsbThreshold<kVectorSize>)
+    return CopyRepMovsb(dst, src, count);
+  return CopyDstAlignedBlocks<kLoopCopyBlockSize, kLoopCopyAlignment>(dst, src,
+                                                                      count);
+}
+
+namespace x86 {
+
+#define LLVM_LIBC_MEMCPY_VARIANT(NAME, TARGET, VECTOR_SIZE, USE_REP_MOVSB)     \
+  TARGET static void *NAME(void *__restrict dst, const void *__restrict src,   \
+                           size_t size) {                                      \
+    memcpy_x86<VECTOR_SIZE, USE_REP_MOVSB>(reinterpret_cast<char *>(dst),      \
+                                           reinterpret_cast<const char *>(src),\
+                                           size);                              \
+    return dst;                                                                \
+  }
+
+LLVM_LIBC_MEMCPY_VARIANT(memcpy_sse2, LLVM_LIBC_X86_TARGET_SSE2, 16, false)
+LLVM_LIBC_MEMCPY_VARIANT(memcpy_sse2_erms, LLVM_LIBC_X86_TARGET_SSE2, 16, true)
+LLVM_LIBC_MEMCPY_VARIANT(memcpy_avx2, LLVM_LIBC_X86_TARGET_AVX2, 32, false)
+LLVM_LIBC_MEMCPY_VARIANT(memcpy_avx2_erms, LLVM_LIBC_X86_TARGET_AVX2, 32, true)
+LLVM_LIBC_MEMCPY_VARIANT(memcpy_avx512, LLVM_LIBC_X86_TARGET_AVX512, 64, false)
+LLVM_LIBC_MEMCPY_VARIANT(memcpy_avx512_erms, LLVM_LIBC_X86_TARGET_AVX512, 64,
+                         true)
+
+#undef LLVM_LIBC_MEMCPY_VARIANT
+
+MemcpyFunction get_memcpy_variant(MemoryVariant Variant) {
+  static constexpr MemcpyFunction kVariants[kMemoryVariantCount] = {
+      memcpy_sse2, memcpy_sse2_erms,  memcpy_avx2,
+      memcpy_avx2_erms, memcpy_avx512, memcpy_avx512_erms};
+  return kVariants[static_cast<unsigned>(Variant)];
 }
 
+} // namespace x86
+
 LLVM_LIBC_FUNCTION(void *, memcpy,
                    (void *__restrict dst, const void *__restrict src,
                     size_t size)) {
-  memcpy_x86(reinterpret_cast<char *>(dst), reinterpret_cast<const char *>(src),
-             size);
-  return dst;
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(MemcpyFunction, get_memcpy_variant, dst, src, size);
 }
 
 } // namespace __llvm_libc
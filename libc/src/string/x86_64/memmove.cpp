@@ -0,0 +1,148 @@
+//===-- Implementation of memmove -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/memmove.h"
+
+#include "src/__support/common.h"
+#include "src/__support/integer_operations.h"
+#include "src/string/memcpy.h"
+#include "src/string/x86_64/memory_variants.h"
+#include <stddef.h> // size_t, ptrdiff_t
+
+namespace __llvm_libc {
+
+// Loads and stores `kBlockSize` bytes as a whole, so that the compiler keeps
+// them in registers.
+template <size_t kBlockSize> struct Block {
+  char Bytes[kBlockSize];
+};
+
+template <size_t kBlockSize>
+static inline Block<kBlockSize> LoadBlock(const char *src) {
+  Block<kBlockSize> block;
+  __builtin_memcpy(&block, src, kBlockSize);
+  return block;
+}
+
+template <size_t kBlockSize>
+static inline void StoreBlock(char *dst, const Block<kBlockSize> &block) {
+  __builtin_memcpy(dst, &block, kBlockSize);
+}
+
+// Moves the first and the last `kBlockSize` bytes, which overlap. Both are
+// loaded before anything is stored, which makes it correct whatever the
+// overlap between `src` and `dst`.
+//
+// Precondition: `count >= kBlockSize && count <= 2 * kBlockSize`.
+template <size_t kBlockSize>
+static inline void MoveBlockOverlap(char *dst, const char *src, size_t count) {
+  const size_t offset = count - kBlockSize;
+  const Block<kBlockSize> head = LoadBlock<kBlockSize>(src);
+  const Block<kBlockSize> tail = LoadBlock<kBlockSize>(src + offset);
+  StoreBlock<kBlockSize>(dst, head);
+  StoreBlock<kBlockSize>(dst + offset, tail);
+}
+
+// Moves `count` bytes by blocks of `kBlockSize` bytes, from the start when
+// `dst` precedes `src` so that stores only clobber bytes already loaded. The
+// last block, which the loop may overwrite, is loaded first.
+//
+// Precondition: `dst < src && count >= kBlockSize`.
+template <size_t kBlockSize>
+static inline void MoveBlocksForward(char *dst, const char *src, size_t count) {
+  const size_t last = count - kBlockSize;
+  const Block<kBlockSize> tail = LoadBlock<kBlockSize>(src + last);
+  for (size_t offset = 0; offset < last; offset += kBlockSize)
+    StoreBlock<kBlockSize>(dst + offset, LoadBlock<kBlockSize>(src + offset));
+  StoreBlock<kBlockSize>(dst + last, tail);
+}
+
+// Same as `MoveBlocksForward`, from the end when `dst` follows `src`.
+//
+// Precondition: `dst > src && count >= kBlockSize`.
+template <size_t kBlockSize>
+static inline void MoveBlocksBackward(char *dst, const char *src,
+                                      size_t count) {
+  const Block<kBlockSize> head = LoadBlock<kBlockSize>(src);
+  for (size_t offset = count - kBlockSize; offset > 0;
+       offset = offset > kBlockSize ? offset - kBlockSize : 0)
+    StoreBlock<kBlockSize>(dst + offset, LoadBlock<kBlockSize>(src + offset));
+  StoreBlock<kBlockSize>(dst, head);
+}
+
+// Sizes up to twice the widest move are served by two overlapping moves,
+// whatever the overlap between the buffers. Larger buffers that do not
+// overlap are handed over to memcpy, the others are moved by vector blocks in
+// the direction that does not clobber the source.
+//
+// `kVectorSize` is the size of the widest vector register of the variant, the
+// variant itself is compiled for the corresponding target.
+template <size_t kVectorSize>
+static inline void memmove_x86(char *dst, const char *src, size_t count) {
+  if (count == 0 || dst == src)
+    return;
+  if (count == 1)
+    return StoreBlock<1>(dst, LoadBlock<1>(src));
+  if (count <= 4)
+    return MoveBlockOverlap<2>(dst, src, count);
+  if (count <= 8)
+    return MoveBlockOverlap<4>(dst, src, count);
+  if (count <= 16)
+    return MoveBlockOverlap<8>(dst, src, count);
+  if (count <= 32)
+    return MoveBlockOverlap<16>(dst, src, count);
+  if (count <= 64)
+    return MoveBlockOverlap<32>(dst, src, count);
+  if (count <= 128)
+    return MoveBlockOverlap<64>(dst, src, count);
+  if (kVectorSize >= 32 && count <= 256)
+    return MoveBlockOverlap<128>(dst, src, count);
+
+  // If the distance between src and dst is equal to or greater than count
+  // (integerAbs(src - dst) >= count), they do not overlap.
+  if (__llvm_libc::integerAbs(src - dst) >= static_cast<ptrdiff_t>(count)) {
+    __llvm_libc::memcpy(dst, src, count);
+    return;
+  }
+  if (dst < src)
+    return MoveBlocksForward<kVectorSize>(dst, src, count);
+  return MoveBlocksBackward<kVectorSize>(dst, src, count);
+}
+
+namespace x86 {
+
+#define LLVM_LIBC_MEMMOVE_VARIANT(NAME, TARGET, VECTOR_SIZE)                   \
+  TARGET static void *NAME(void *dst, const void *src, size_t count) {         \
+    memmove_x86<VECTOR_SIZE>(reinterpret_cast<char *>(dst),                    \
+                             reinterpret_cast<const char *>(src), count);      \
+    return dst;                                                                \
+  }
+
+LLVM_LIBC_MEMMOVE_VARIANT(memmove_sse2, LLVM_LIBC_X86_TARGET_SSE2, 16)
+LLVM_LIBC_MEMMOVE_VARIANT(memmove_avx2, LLVM_LIBC_X86_TARGET_AVX2, 32)
+LLVM_LIBC_MEMMOVE_VARIANT(memmove_avx512, LLVM_LIBC_X86_TARGET_AVX512, 64)
+
+#undef LLVM_LIBC_MEMMOVE_VARIANT
+
+MemmoveFunction get_memmove_variant(MemoryVariant Variant) {
+  // Overlapping moves do not use `rep movsb`, which is slow backward.
+  static constexpr MemmoveFunction kVariants[kMemoryVariantCount] = {
+      memmove_sse2, memmove_sse2,   memmove_avx2,
+      memmove_avx2, memmove_avx512, memmove_avx512};
+  return kVariants[static_cast<unsigned>(Variant)];
+}
+
+} // namespace x86
+
+LLVM_LIBC_FUNCTION(void *, memmove,
+                   (void *dst, const void *src, size_t count)) {
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(MemmoveFunction, get_memmove_variant, dst, src, count);
+}
+
+} // namespace __llvm_libc
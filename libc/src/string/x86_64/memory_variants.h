@@ -0,0 +1,143 @@
+//===-- Runtime dispatched x86 memory functions -----------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A single build of the x86 memory functions carries one implementation per
+// instruction set extension and selects among them on the first call, based
+// on the features of the running processor. This is what an IFUNC resolver
+// would do at load time, but IRELATIVE relocations are not processed in
+// static executables, so the selection is done by the function itself.
+//
+// The variants are exposed so that tests and benchmarks can exercise each of
+// them regardless of the processor's preference.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_X86_64_MEMORY_VARIANTS_H
+#define LLVM_LIBC_SRC_STRING_X86_64_MEMORY_VARIANTS_H
+
+#include "src/__support/x86_cpu_features.h"
+
+#include <stddef.h> // size_t
+
+// Functions using AVX2 or AVX-512 instructions. `flatten` makes sure the
+// shared, target independent, templates get inlined in and compiled for the
+// target of the variant.
+#define LLVM_LIBC_X86_TARGET_AVX2 __attribute__((target("avx2"), flatten))
+#define LLVM_LIBC_X86_TARGET_AVX512                                            \
+  __attribute__((target("avx2,avx512f,avx512bw"), flatten))
+#define LLVM_LIBC_X86_TARGET_SSE2 __attribute__((flatten))
+
+namespace __llvm_libc {
+namespace x86 {
+
+// The implementations of a memory function, in order of preference. The
+// `_ERMS` variants use `rep movsb` / `rep stosb` for large sizes, other
+// functions than memcpy and memset treat them as their vector counterpart.
+// The string search functions (strlen, strchr and memchr) stop at AVX2 and
+// use it for the AVX-512 variants as well.
+enum class MemoryVariant : unsigned {
+  SSE2,
+  SSE2_ERMS,
+  AVX2,
+  AVX2_ERMS,
+  AVX512,
+  AVX512_ERMS,
+};
+
+constexpr size_t kMemoryVariantCount = 6;
+
+// Returns whether the processor can run `Variant`. `rep movsb` works on every
+// x86 processor, ERMS only tells whether it is fast.
+static inline bool is_supported(MemoryVariant Variant,
+                                const CpuFeatures &Features) {
+  switch (Variant) {
+  case MemoryVariant::SSE2:
+  case MemoryVariant::SSE2_ERMS:
+    return Features.SSE2;
+  case MemoryVariant::AVX2:
+  case MemoryVariant::AVX2_ERMS:
+    return Features.AVX2;
+  case MemoryVariant::AVX512:
+  case MemoryVariant::AVX512_ERMS:
+    return Features.AVX512F && Features.AVX512BW;
+  }
+  return false;
+}
+
+// Returns the variant to use on a processor with `Features`, which can be
+// forced at build time by defining `LLVM_LIBC_X86_MEMORY_VARIANT` to one of the
+// `MemoryVariant` enumerators.
+static inline MemoryVariant select_variant(const CpuFeatures &Features) {
+#ifdef LLVM_LIBC_X86_MEMORY_VARIANT
+  (void)Features;
+  return MemoryVariant::LLVM_LIBC_X86_MEMORY_VARIANT;
+#else
+  if (is_supported(MemoryVariant::AVX512, Features))
+    return Features.ERMS ? MemoryVariant::AVX512_ERMS : MemoryVariant::AVX512;
+  if (is_supported(MemoryVariant::AVX2, Features))
+    return Features.ERMS ? MemoryVariant::AVX2_ERMS : MemoryVariant::AVX2;
+  return Features.ERMS ? MemoryVariant::SSE2_ERMS : MemoryVariant::SSE2;
+#endif
+}
+
+static inline const char *get_variant_name(MemoryVariant Variant) {
+  switch (Variant) {
+  case MemoryVariant::SSE2:
+    return "sse2";
+  case MemoryVariant::SSE2_ERMS:
+    return "sse2_erms";
+  case MemoryVariant::AVX2:
+    return "avx2";
+  case MemoryVariant::AVX2_ERMS:
+    return "avx2_erms";
+  case MemoryVariant::AVX512:
+    return "avx512";
+  case MemoryVariant::AVX512_ERMS:
+    return "avx512_erms";
+  }
+  return "";
+}
+
+using MemcpyFunction = void *(*)(void *__restrict, const void *__restrict,
+                                 size_t);
+using MemmoveFunction = void *(*)(void *, const void *, size_t);
+using MemsetFunction = void *(*)(void *, int, size_t);
+using BzeroFunction = void (*)(void *, size_t);
+using MemcmpFunction = int (*)(const void *, const void *, size_t);
+using StrlenFunction = size_t (*)(const char *);
+using StrchrFunction = char *(*)(const char *, int);
+using MemchrFunction = void *(*)(const void *, int, size_t);
+
+// The variants of each function, indexed by `MemoryVariant`.
+MemcpyFunction get_memcpy_variant(MemoryVariant Variant);
+MemmoveFunction get_memmove_variant(MemoryVariant Variant);
+MemsetFunction get_memset_variant(MemoryVariant Variant);
+BzeroFunction get_bzero_variant(MemoryVariant Variant);
+MemcmpFunction get_memcmp_variant(MemoryVariant Variant);
+StrlenFunction get_strlen_variant(MemoryVariant Variant);
+StrchrFunction get_strchr_variant(MemoryVariant Variant);
+MemchrFunction get_memchr_variant(MemoryVariant Variant);
+
+// Calls through a pointer to the selected variant, which points to a resolver
+// until the first call replaces it. Concurrent first calls all select the same
+// variant, so the race between their stores is benign.
+#define LLVM_LIBC_X86_DISPATCH(FunctionType, GetVariant, ...)                  \
+  do {                                                                         \
+    static FunctionType Selected = nullptr;                                    \
+    FunctionType Function = __atomic_load_n(&Selected, __ATOMIC_RELAXED);      \
+    if (unlikely(Function == nullptr)) {                                       \
+      Function = GetVariant(select_variant(get_cpu_features()));               \
+      __atomic_store_n(&Selected, Function, __ATOMIC_RELAXED);                 \
+    }                                                                          \
+    return Function(__VA_ARGS__);                                              \
+  } while (0)
+
+} // namespace x86
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STRING_X86_64_MEMORY_VARIANTS_H
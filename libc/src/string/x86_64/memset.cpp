@@ -0,0 +1,49 @@
+//===-- Implementation of memset ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/memset.h"
+#include "src/__support/common.h"
+#include "src/string/x86_64/memory_variants.h"
+#include "src/string/x86_64/memset_implementations.h"
+
+namespace __llvm_libc {
+namespace x86 {
+
+#define LLVM_LIBC_MEMSET_VARIANT(NAME, TARGET, VECTOR_SIZE, USE_REP_STOSB)     \
+  TARGET static void *NAME(void *dst, int value, size_t count) {               \
+    memset_x86<VECTOR_SIZE, USE_REP_STOSB>(reinterpret_cast<char *>(dst),      \
+                                           static_cast<unsigned char>(value),  \
+                                           count);                             \
+    return dst;                                                                \
+  }
+
+LLVM_LIBC_MEMSET_VARIANT(memset_sse2, LLVM_LIBC_X86_TARGET_SSE2, 16, false)
+LLVM_LIBC_MEMSET_VARIANT(memset_sse2_erms, LLVM_LIBC_X86_TARGET_SSE2, 16, true)
+LLVM_LIBC_MEMSET_VARIANT(memset_avx2, LLVM_LIBC_X86_TARGET_AVX2, 32, false)
+LLVM_LIBC_MEMSET_VARIANT(memset_avx2_erms, LLVM_LIBC_X86_TARGET_AVX2, 32, true)
+LLVM_LIBC_MEMSET_VARIANT(memset_avx512, LLVM_LIBC_X86_TARGET_AVX512, 64, false)
+LLVM_LIBC_MEMSET_VARIANT(memset_avx512_erms, LLVM_LIBC_X86_TARGET_AVX512, 64,
+                         true)
+
+#undef LLVM_LIBC_MEMSET_VARIANT
+
+MemsetFunction get_memset_variant(MemoryVariant Variant) {
+  static constexpr MemsetFunction kVariants[kMemoryVariantCount] = {
+      memset_sse2,      memset_sse2_erms, memset_avx2,
+      memset_avx2_erms, memset_avx512,    memset_avx512_erms};
+  return kVariants[static_cast<unsigned>(Variant)];
+}
+
+} // namespace x86
+
+LLVM_LIBC_FUNCTION(void *, memset, (void *dst, int value, size_t count)) {
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(MemsetFunction, get_memset_variant, dst, value, count);
+}
+
+} // namespace __llvm_libc
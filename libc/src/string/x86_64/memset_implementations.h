@@ -0,0 +1,72 @@
+//===-- Implementation of memset for x86 ------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_X86_64_MEMSET_IMPLEMENTATIONS_H
+#define LLVM_LIBC_SRC_STRING_X86_64_MEMSET_IMPLEMENTATIONS_H
+
+#include "src/string/memory_utils/memset_utils.h"
+
+#include <stddef.h> // size_t
+
+namespace __llvm_libc {
+
+// The size from which the ERMS variants use `rep stosb`. None of the
+// production size distributions (see benchmarks/MemorySizeDistributions.cpp)
+// has calls for more than 1 KiB, so like for memcpy this threshold only
+// matters for bulk initialization.
+template <size_t kVectorSize>
+constexpr size_t kRepStosbThreshold = 64 * kVectorSize;
+
+static void SetRepStosb(char *dst, unsigned char value, size_t count) {
+  asm volatile("rep stosb" : "+D"(dst), "+c"(count) : "a"(value) : "memory");
+}
+
+// Same as `GeneralPurposeMemset` for sizes up to 128 bytes, where 86% to 98%
+// of the calls fall for three of the four production distributions. The
+// remaining one has half of its calls between 128 and 256 bytes, and several
+// have 10% of their calls between 256 and 512 bytes: wider vectors cover these
+// with two overlapping sets.
+//
+// `kVectorSize` is the size of the widest vector register of the variant, the
+// variant itself is compiled for the corresponding target.
+template <size_t kVectorSize, bool kUseRepStosb>
+static inline void memset_x86(char *dst, unsigned char value, size_t count) {
+  constexpr size_t kLoopSetBlockSize = kVectorSize < 32 ? 32 : kVectorSize;
+
+  if (count == 0)
+    return;
+  if (count == 1)
+    return SetBlock<1>(dst, value);
+  if (count == 2)
+    return SetBlock<2>(dst, value);
+  if (count == 3)
+    return SetBlock<3>(dst, value);
+  if (count == 4)
+    return SetBlock<4>(dst, value);
+  if (count <= 8)
+    return SetBlockOverlap<4>(dst, value, count);
+  if (count <= 16)
+    return SetBlockOverlap<8>(dst, value, count);
+  if (count <= 32)
+    return SetBlockOverlap<16>(dst, value, count);
+  if (count <= 64)
+    return SetBlockOverlap<32>(dst, value, count);
+  if (count <= 128)
+    return SetBlockOverlap<64>(dst, value, count);
+  if (kVectorSize >= 32 && count <= 256)
+    return SetBlockOverlap<128>(dst, value, count);
+  if (kVectorSize >= 64 && count <= 512)
+    return SetBlockOverlap<256>(dst, value, count);
+  if (kUseRepStosb && count >= kRepStosbThreshold<kVectorSize>)
+    return SetRepStosb(dst, value, count);
+  return SetAlignedBlocks<kLoopSetBlockSize>(dst, value, count);
+}
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STRING_X86_64_MEMSET_IMPLEMENTATIONS_H
@@ -0,0 +1,41 @@
+//===-- Implementation of strchr ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/strchr.h"
+#include "src/__support/common.h"
+#include "src/string/x86_64/memory_variants.h"
+#include "src/string/x86_64/string_search_implementations.h"
+
+namespace __llvm_libc {
+namespace x86 {
+
+LLVM_LIBC_X86_TARGET_SSE2 LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static char *
+strchr_sse2(const char *src, int c) {
+  return strchr_x86<Sse2Searcher>(src, static_cast<unsigned char>(c));
+}
+
+LLVM_LIBC_X86_TARGET_AVX2 LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static char *
+strchr_avx2(const char *src, int c) {
+  return strchr_x86<Avx2Searcher>(src, static_cast<unsigned char>(c));
+}
+
+StrchrFunction get_strchr_variant(MemoryVariant Variant) {
+  static constexpr StrchrFunction kVariants[kMemoryVariantCount] = {
+      strchr_sse2, strchr_sse2, strchr_avx2,
+      strchr_avx2, strchr_avx2, strchr_avx2};
+  return kVariants[static_cast<unsigned>(Variant)];
+}
+
+} // namespace x86
+
+LLVM_LIBC_FUNCTION(char *, strchr, (const char *src, int c)) {
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(StrchrFunction, get_strchr_variant, src, c);
+}
+
+} // namespace __llvm_libc
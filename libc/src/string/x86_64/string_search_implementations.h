@@ -0,0 +1,211 @@
+//===-- Vector implementations of the x86 string search functions ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// strlen, strchr and memchr compare whole vectors against the searched bytes
+// and locate the first match from the movemask of the comparison.
+//
+// Vectors are only loaded from addresses aligned to their size, so a load
+// never reaches into the page following the end of the data. The first vector
+// is loaded from below `src` and the matches before it are shifted out of the
+// mask.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_STRING_X86_64_STRING_SEARCH_IMPLEMENTATIONS_H
+#define LLVM_LIBC_SRC_STRING_X86_64_STRING_SEARCH_IMPLEMENTATIONS_H
+
+#include "src/__support/common.h"
+#include "src/__support/sanitizer.h"
+#include "src/string/memory_utils/utils.h"
+
+#include <immintrin.h>
+#include <stddef.h> // size_t
+#include <stdint.h> // uint32_t
+
+namespace __llvm_libc {
+namespace x86 {
+
+// A searcher compares vectors of `kSize` bytes, loaded from aligned `block`
+// addresses, with the searched byte. `mask<kOrNull>` returns a bit for every
+// byte equal to it, or to the terminator if `kOrNull` is set, and
+// `any<kOrNull>` tells whether four consecutive vectors hold such a byte.
+// Vectors never leave these functions, which are compiled for the target of
+// the searcher.
+
+struct Sse2Searcher {
+  static constexpr size_t kSize = 16;
+  const __m128i pattern;
+
+  explicit Sse2Searcher(unsigned char ch)
+      : pattern(_mm_set1_epi8(static_cast<char>(ch))) {}
+
+  template <bool kOrNull>
+  LLVM_LIBC_NO_SANITIZE_OOB_ACCESS __m128i matches(const char *block) const {
+    const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i *>(block));
+    if (!kOrNull)
+      return _mm_cmpeq_epi8(v, pattern);
+    // `v ^ pattern` is zero where `v` holds the searched byte, and its
+    // unsigned minimum with `v` is also zero at the terminator.
+    return _mm_cmpeq_epi8(_mm_min_epu8(_mm_xor_si128(v, pattern), v),
+                          _mm_setzero_si128());
+  }
+  template <bool kOrNull>
+  LLVM_LIBC_NO_SANITIZE_OOB_ACCESS uint32_t mask(const char *block) const {
+    return _mm_movemask_epi8(matches<kOrNull>(block));
+  }
+  template <bool kOrNull>
+  LLVM_LIBC_NO_SANITIZE_OOB_ACCESS bool any(const char *block) const {
+    const __m128i a = _mm_or_si128(matches<kOrNull>(block),
+                                   matches<kOrNull>(block + kSize));
+    const __m128i b = _mm_or_si128(matches<kOrNull>(block + 2 * kSize),
+                                   matches<kOrNull>(block + 3 * kSize));
+    return _mm_movemask_epi8(_mm_or_si128(a, b)) != 0;
+  }
+};
+
+struct Avx2Searcher {
+  static constexpr size_t kSize = 32;
+  const __m256i pattern;
+
+  __attribute__((target("avx2"))) explicit Avx2Searcher(unsigned char ch)
+      : pattern(_mm256_set1_epi8(static_cast<char>(ch))) {}
+
+  template <bool kOrNull>
+  __attribute__((target("avx2"))) LLVM_LIBC_NO_SANITIZE_OOB_ACCESS __m256i
+  matches(const char *block) const {
+    const __m256i v =
+        _mm256_load_si256(reinterpret_cast<const __m256i *>(block));
+    if (!kOrNull)
+      return _mm256_cmpeq_epi8(v, pattern);
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(_mm256_xor_si256(v, pattern), v),
+                             _mm256_setzero_si256());
+  }
+  template <bool kOrNull>
+  __attribute__((target("avx2"))) LLVM_LIBC_NO_SANITIZE_OOB_ACCESS uint32_t
+  mask(const char *block) const {
+    return _mm256_movemask_epi8(matches<kOrNull>(block));
+  }
+  template <bool kOrNull>
+  __attribute__((target("avx2"))) LLVM_LIBC_NO_SANITIZE_OOB_ACCESS bool
+  any(const char *block) const {
+    const __m256i a = _mm256_or_si256(matches<kOrNull>(block),
+                                      matches<kOrNull>(block + kSize));
+    const __m256i b = _mm256_or_si256(matches<kOrNull>(block + 2 * kSize),
+                                      matches<kOrNull>(block + 3 * kSize));
+    return _mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0;
+  }
+};
+
+static inline size_t first_set_bit(uint32_t mask) {
+  return __builtin_ctz(mask);
+}
+
+// Returns the first byte of four vectors from `block` that holds a match,
+// knowing that there is one.
+template <bool kOrNull, typename Searcher>
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline const char *
+find_in_four(const Searcher &searcher, const char *block) {
+  for (;; block += Searcher::kSize)
+    if (const uint32_t mask = searcher.template mask<kOrNull>(block))
+      return block + first_set_bit(mask);
+}
+
+// Returns the first occurrence of `ch` in the null terminated `src`, or of its
+// terminator if `kOrNull` is set. Otherwise `ch` must occur in the string, as
+// the terminator does for strlen.
+//
+// Past the first vector, four vectors are tested per iteration. Their loads
+// are aligned to four times the vector size, so that they all stay in the
+// page of the first one.
+template <bool kOrNull, typename Searcher>
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline const char *
+find_in_string(const char *src, unsigned char ch) {
+  const Searcher searcher(ch);
+  const size_t offset = offset_from_last_aligned<Searcher::kSize>(src);
+  const char *block = src - offset;
+  uint32_t mask = searcher.template mask<kOrNull>(block) >> offset;
+  if (mask != 0)
+    return src + first_set_bit(mask);
+
+  for (block += Searcher::kSize;
+       offset_from_last_aligned<4 * Searcher::kSize>(block) != 0;
+       block += Searcher::kSize) {
+    mask = searcher.template mask<kOrNull>(block);
+    if (mask != 0)
+      return block + first_set_bit(mask);
+  }
+
+  for (;; block += 4 * Searcher::kSize)
+    if (searcher.template any<kOrNull>(block))
+      return find_in_four<kOrNull>(searcher, block);
+}
+
+template <typename Searcher>
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline size_t
+strlen_x86(const char *src) {
+  return find_in_string</*kOrNull=*/false, Searcher>(src, '\0') - src;
+}
+
+template <typename Searcher>
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline char *
+strchr_x86(const char *src, unsigned char ch) {
+  const char *found = find_in_string</*kOrNull=*/true, Searcher>(src, ch);
+  return static_cast<unsigned char>(*found) == ch ? const_cast<char *>(found)
+                                                  : nullptr;
+}
+
+// Like the string functions, the vector loads may extend past `count` bytes,
+// but not past the page holding the first match. The data may thus be shorter
+// than `count` if it holds `ch`, as for strnlen.
+template <typename Searcher>
+LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static inline void *
+memchr_x86(const char *src, unsigned char ch, size_t count) {
+  constexpr bool kOrNull = false;
+  constexpr size_t kSize = Searcher::kSize;
+  if (count == 0)
+    return nullptr;
+  const Searcher searcher(ch);
+  const size_t offset = offset_from_last_aligned<kSize>(src);
+  const char *block = src - offset;
+  uint32_t mask = searcher.template mask<kOrNull>(block) >> offset;
+  if (mask != 0) {
+    const size_t index = first_set_bit(mask);
+    return index < count ? const_cast<char *>(src + index) : nullptr;
+  }
+  if (count <= kSize - offset)
+    return nullptr;
+  // From now on `count` is the number of bytes left from `block`.
+  count -= kSize - offset;
+  block += kSize;
+
+  for (; count > kSize && offset_from_last_aligned<4 * kSize>(block) != 0;
+       count -= kSize, block += kSize) {
+    mask = searcher.template mask<kOrNull>(block);
+    if (mask != 0)
+      return const_cast<char *>(block + first_set_bit(mask));
+  }
+
+  for (; count > 4 * kSize; count -= 4 * kSize, block += 4 * kSize)
+    if (searcher.template any<kOrNull>(block))
+      return const_cast<char *>(find_in_four<kOrNull>(searcher, block));
+
+  for (;; count -= kSize, block += kSize) {
+    mask = searcher.template mask<kOrNull>(block);
+    if (mask != 0) {
+      const size_t index = first_set_bit(mask);
+      return index < count ? const_cast<char *>(block + index) : nullptr;
+    }
+    if (count <= kSize)
+      return nullptr;
+  }
+}
+
+} // namespace x86
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_STRING_X86_64_STRING_SEARCH_IMPLEMENTATIONS_H
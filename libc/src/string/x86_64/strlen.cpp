@@ -0,0 +1,41 @@
+//===-- Implementation of strlen ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/string/strlen.h"
+#include "src/__support/common.h"
+#include "src/string/x86_64/memory_variants.h"
+#include "src/string/x86_64/string_search_implementations.h"
+
+namespace __llvm_libc {
+namespace x86 {
+
+LLVM_LIBC_X86_TARGET_SSE2 LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static size_t
+strlen_sse2(const char *src) {
+  return strlen_x86<Sse2Searcher>(src);
+}
+
+LLVM_LIBC_X86_TARGET_AVX2 LLVM_LIBC_NO_SANITIZE_OOB_ACCESS static size_t
+strlen_avx2(const char *src) {
+  return strlen_x86<Avx2Searcher>(src);
+}
+
+StrlenFunction get_strlen_variant(MemoryVariant Variant) {
+  static constexpr StrlenFunction kVariants[kMemoryVariantCount] = {
+      strlen_sse2, strlen_sse2, strlen_avx2,
+      strlen_avx2, strlen_avx2, strlen_avx2};
+  return kVariants[static_cast<unsigned>(Variant)];
+}
+
+} // namespace x86
+
+LLVM_LIBC_FUNCTION(size_t, strlen, (const char *src)) {
+  using namespace x86;
+  LLVM_LIBC_X86_DISPATCH(StrlenFunction, get_strlen_variant, src);
+}
+
+} // namespace __llvm_libc
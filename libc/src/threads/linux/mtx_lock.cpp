@@ -21,11 +21,15 @@ namespace __llvm_libc {
 // The implementation currently handles only plain mutexes.
 LLVM_LIBC_FUNCTION(int, mtx_lock, (mtx_t * mutex)) {
   FutexData *futex_data = reinterpret_cast<FutexData *>(mutex->__internal_data);
+  // Once this thread has waited, other threads may be waiting too. So, it has
+  // to take the mutex as `MS_Waiting` for `mtx_unlock` to wake them up.
+  uint32_t acquired_status = MS_Locked;
   while (true) {
     uint32_t mutex_status = MS_Free;
     uint32_t locked_status = MS_Locked;
 
-    if (atomic_compare_exchange_strong(futex_data, &mutex_status, MS_Locked))
+    if (atomic_compare_exchange_strong(futex_data, &mutex_status,
+                                       acquired_status))
       return thrd_success;
 
     switch (mutex_status) {
@@ -36,6 +40,7 @@ LLVM_LIBC_FUNCTION(int, mtx_lock, (mtx_t * mutex)) {
       __llvm_libc::syscall(SYS_futex, futex_data, FUTEX_WAIT_PRIVATE,
                            MS_Waiting, 0, 0, 0);
       // Once woken up/unblocked, try everything all over.
+      acquired_status = MS_Waiting;
       continue;
     case MS_Locked:
       // Mutex has been locked by another thread so set the status to
@@ -47,6 +52,7 @@ LLVM_LIBC_FUNCTION(int, mtx_lock, (mtx_t * mutex)) {
         // syscall will block only if the futex data is still `MS_Waiting`.
         __llvm_libc::syscall(SYS_futex, futex_data, FUTEX_WAIT_PRIVATE,
                              MS_Waiting, 0, 0, 0);
+        acquired_status = MS_Waiting;
       }
       continue;
     case MS_Free:
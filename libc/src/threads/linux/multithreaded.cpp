@@ -0,0 +1,17 @@
+//===-- Implementation of the multithreaded process flag ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/threads/multithreaded.h"
+
+namespace __llvm_libc {
+namespace internal {
+
+bool process_is_multithreaded = false;
+
+} // namespace internal
+} // namespace __llvm_libc
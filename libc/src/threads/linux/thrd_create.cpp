@@ -17,6 +17,7 @@
 #include "src/sys/mman/mmap.h"
 #include "src/sys/mman/munmap.h"
 #include "src/threads/linux/thread_utils.h"
+#include "src/threads/multithreaded.h"
 
 #include <linux/futex.h> // For futex operations.
 #include <linux/sched.h> // For CLONE_* flags.
@@ -58,6 +59,10 @@ LLVM_LIBC_FUNCTION(int, thrd_create,
   if (stack == MAP_FAILED)
     return llvmlibc_errno == ENOMEM ? thrd_nomem : thrd_error;
 
+  // Objects shared between threads are locked from now on, which has to be
+  // in effect before the new thread can use them.
+  set_multithreaded();
+
   thread->__stack = stack;
   thread->__stack_size = ThreadParams::DefaultStackSize;
   thread->__retval = -1;
@@ -0,0 +1,37 @@
+//===-- Tracking whether the process has created threads --------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIBC_SRC_THREADS_MULTITHREADED_H
+#define LLVM_LIBC_SRC_THREADS_MULTITHREADED_H
+
+namespace __llvm_libc {
+
+namespace internal {
+extern bool process_is_multithreaded;
+} // namespace internal
+
+// Returns whether the process ever created a thread. Until it does, the only
+// thread can skip locking objects which are otherwise shared between threads.
+// A thread checking this cannot race with the creation of the first thread,
+// since that would be done by the very same thread.
+//
+// Only threads created with thrd_create are seen, a process creating threads
+// by other means must not share objects relying on this between them.
+static inline bool is_multithreaded() {
+  return __atomic_load_n(&internal::process_is_multithreaded, __ATOMIC_RELAXED);
+}
+
+// Called before creating a thread. The process is then considered
+// multithreaded for the rest of its life.
+static inline void set_multithreaded() {
+  __atomic_store_n(&internal::process_is_multithreaded, true, __ATOMIC_RELAXED);
+}
+
+} // namespace __llvm_libc
+
+#endif // LLVM_LIBC_SRC_THREADS_MULTITHREADED_H
@@ -0,0 +1,156 @@
+//===-- Unittests for fopen, fread, fwrite, fflush and fclose -------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "include/errno.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdio/fclose.h"
+#include "src/stdio/fflush.h"
+#include "src/stdio/fopen.h"
+#include "src/stdio/fread.h"
+#include "src/stdio/fwrite.h"
+#include "utils/UnitTest/Test.h"
+
+#include <stdint.h> // SIZE_MAX
+
+static constexpr const char *kFileName = "fopen_test.tmp";
+
+TEST(LlvmLibcFOpenTest, WriteThenRead) {
+  __llvm_libc::FILE *file = __llvm_libc::fopen(kFileName, "w");
+  ASSERT_NE(file, static_cast<__llvm_libc::FILE *>(nullptr));
+  // Many small writes, which stay in the buffer, and a write larger than the
+  // buffer, which goes straight to the file.
+  static char large[20000];
+  for (size_t i = 0; i < sizeof(large); ++i)
+    large[i] = static_cast<char>('a' + i % 26);
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(__llvm_libc::fwrite("0123456789", 1, 10, file), size_t(10));
+  ASSERT_EQ(__llvm_libc::fwrite(large, 1, sizeof(large), file),
+            sizeof(large));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+
+  file = __llvm_libc::fopen(kFileName, "r");
+  ASSERT_NE(file, static_cast<__llvm_libc::FILE *>(nullptr));
+  char data[10];
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(__llvm_libc::fread(data, 1, 10, file), size_t(10));
+    ASSERT_EQ(data[0], '0');
+    ASSERT_EQ(data[9], '9');
+  }
+  static char read_back[sizeof(large)];
+  ASSERT_EQ(__llvm_libc::fread(read_back, 1, sizeof(read_back), file),
+            sizeof(read_back));
+  for (size_t i = 0; i < sizeof(large); ++i)
+    ASSERT_EQ(read_back[i], large[i]);
+  // Reading past the end is short.
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 10, file), size_t(0));
+  ASSERT_TRUE(file->eof);
+  ASSERT_FALSE(file->error);
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+}
+
+TEST(LlvmLibcFOpenTest, FlushMakesDataVisible) {
+  __llvm_libc::FILE *writer = __llvm_libc::fopen(kFileName, "w");
+  ASSERT_NE(writer, static_cast<__llvm_libc::FILE *>(nullptr));
+  __llvm_libc::FILE *reader = __llvm_libc::fopen(kFileName, "r");
+  ASSERT_NE(reader, static_cast<__llvm_libc::FILE *>(nullptr));
+
+  char data[6] = {0};
+  ASSERT_EQ(__llvm_libc::fwrite("hello", 1, 5, writer), size_t(5));
+  // The data is still buffered.
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 5, reader), size_t(0));
+  ASSERT_EQ(__llvm_libc::fflush(writer), 0);
+  reader->eof = false;
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 5, reader), size_t(5));
+  ASSERT_STREQ(data, "hello");
+
+  ASSERT_EQ(__llvm_libc::fwrite(" world", 1, 6, writer), size_t(6));
+  // Flushing all the streams includes `writer`.
+  ASSERT_EQ(__llvm_libc::fflush(nullptr), 0);
+  char more[7] = {0};
+  ASSERT_EQ(__llvm_libc::fread(more, 1, 6, reader), size_t(6));
+  ASSERT_STREQ(more, " world");
+
+  ASSERT_EQ(__llvm_libc::fclose(reader), 0);
+  ASSERT_EQ(__llvm_libc::fclose(writer), 0);
+}
+
+TEST(LlvmLibcFOpenTest, Append) {
+  __llvm_libc::FILE *file = __llvm_libc::fopen(kFileName, "w");
+  ASSERT_EQ(__llvm_libc::fwrite("abc", 1, 3, file), size_t(3));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+  file = __llvm_libc::fopen(kFileName, "a");
+  ASSERT_EQ(__llvm_libc::fwrite("def", 1, 3, file), size_t(3));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+
+  file = __llvm_libc::fopen(kFileName, "rb");
+  char data[7] = {0};
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 6, file), size_t(6));
+  ASSERT_STREQ(data, "abcdef");
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+}
+
+TEST(LlvmLibcFOpenTest, ReadThenWrite) {
+  __llvm_libc::FILE *file = __llvm_libc::fopen(kFileName, "w");
+  ASSERT_EQ(__llvm_libc::fwrite("abcdefghij", 1, 10, file), size_t(10));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+
+  // The first read fills the buffer with the whole file, the write must still
+  // land right after the bytes read.
+  file = __llvm_libc::fopen(kFileName, "r+");
+  ASSERT_NE(file, static_cast<__llvm_libc::FILE *>(nullptr));
+  char data[11] = {0};
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 3, file), size_t(3));
+  ASSERT_EQ(__llvm_libc::fflush(file), 0);
+  ASSERT_EQ(__llvm_libc::fwrite("XY", 1, 2, file), size_t(2));
+  ASSERT_EQ(__llvm_libc::fflush(file), 0);
+  // So must a read after flushing the write.
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 2, file), size_t(2));
+  ASSERT_EQ(data[0], 'f');
+  ASSERT_EQ(data[1], 'g');
+  // And a write directly following a read.
+  ASSERT_EQ(__llvm_libc::fwrite("Z", 1, 1, file), size_t(1));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+
+  file = __llvm_libc::fopen(kFileName, "r");
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 10, file), size_t(10));
+  ASSERT_STREQ(data, "abcXYfgZij");
+  ASSERT_EQ(__llvm_libc::fread(data, 1, 1, file), size_t(0));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+}
+
+TEST(LlvmLibcFOpenTest, Errors) {
+  llvmlibc_errno = 0;
+  ASSERT_EQ(__llvm_libc::fopen("fopen_test.tmp.missing/file", "r"),
+            static_cast<__llvm_libc::FILE *>(nullptr));
+  ASSERT_EQ(llvmlibc_errno, ENOENT);
+
+  llvmlibc_errno = 0;
+  ASSERT_EQ(__llvm_libc::fopen(kFileName, "q"),
+            static_cast<__llvm_libc::FILE *>(nullptr));
+  ASSERT_EQ(llvmlibc_errno, EINVAL);
+
+  __llvm_libc::FILE *file = __llvm_libc::fopen(kFileName, "w");
+  ASSERT_NE(file, static_cast<__llvm_libc::FILE *>(nullptr));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+  llvmlibc_errno = 0;
+  ASSERT_EQ(__llvm_libc::fopen(kFileName, "wx"),
+            static_cast<__llvm_libc::FILE *>(nullptr));
+  ASSERT_EQ(llvmlibc_errno, EEXIST);
+
+  // The byte count size * nmemb does not fit in a size_t.
+  file = __llvm_libc::fopen(kFileName, "r+");
+  ASSERT_NE(file, static_cast<__llvm_libc::FILE *>(nullptr));
+  char data[2];
+  llvmlibc_errno = 0;
+  ASSERT_EQ(__llvm_libc::fread(data, 2, SIZE_MAX, file), size_t(0));
+  ASSERT_EQ(llvmlibc_errno, EOVERFLOW);
+  llvmlibc_errno = 0;
+  ASSERT_EQ(__llvm_libc::fwrite(data, SIZE_MAX, 2, file), size_t(0));
+  ASSERT_EQ(llvmlibc_errno, EOVERFLOW);
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+}
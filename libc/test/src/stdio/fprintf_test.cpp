@@ -0,0 +1,62 @@
+//===-- Unittests for fprintf and printf ----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/fclose.h"
+#include "src/stdio/fflush.h"
+#include "src/stdio/fopen.h"
+#include "src/stdio/fprintf.h"
+#include "src/stdio/fread.h"
+#include "src/stdio/printf.h"
+#include "utils/UnitTest/Test.h"
+
+static constexpr const char *kFileName = "fprintf_test.tmp";
+
+TEST(LlvmLibcFPrintfTest, WriteToFile) {
+  __llvm_libc::FILE *file = __llvm_libc::fopen(kFileName, "w");
+  ASSERT_NE(file, static_cast<__llvm_libc::FILE *>(nullptr));
+  for (int i = 0; i < 1000; ++i)
+    ASSERT_EQ(__llvm_libc::fprintf(file, "line %04d: %s %6.2f\n", i, "value",
+                                   i / 4.0),
+              24);
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+
+  file = __llvm_libc::fopen(kFileName, "r");
+  ASSERT_NE(file, static_cast<__llvm_libc::FILE *>(nullptr));
+  char line[25] = {0};
+  ASSERT_EQ(__llvm_libc::fread(line, 1, 24, file), size_t(24));
+  ASSERT_STREQ(line, "line 0000: value   0.00\n");
+  for (int i = 1; i < 1000; ++i)
+    ASSERT_EQ(__llvm_libc::fread(line, 1, 24, file), size_t(24));
+  ASSERT_STREQ(line, "line 0999: value 249.75\n");
+  ASSERT_EQ(__llvm_libc::fread(line, 1, 24, file), size_t(0));
+  ASSERT_EQ(__llvm_libc::fclose(file), 0);
+}
+
+TEST(LlvmLibcFPrintfTest, CustomStream) {
+  // A stream without a buffer passes the output straight to its write
+  // function.
+  struct StringFile : __llvm_libc::FILE {
+    char data[64];
+    size_t len;
+  } file;
+  file.len = 0;
+  file.write = +[](__llvm_libc::FILE *f, const char *ptr, size_t size) {
+    StringFile *string_file = static_cast<StringFile *>(f);
+    for (size_t i = 0; i < size; ++i)
+      string_file->data[string_file->len++] = ptr[i];
+    return size;
+  };
+  ASSERT_EQ(__llvm_libc::fprintf(&file, "%s-%x", "id", 0xbeef), 7);
+  file.data[file.len] = '\0';
+  ASSERT_STREQ(file.data, "id-beef");
+}
+
+TEST(LlvmLibcFPrintfTest, Printf) {
+  ASSERT_EQ(__llvm_libc::printf("printf test %d\n", 1), 14);
+  ASSERT_EQ(__llvm_libc::fflush(nullptr), 0);
+}
@@ -0,0 +1,258 @@
+//===-- Unittests for snprintf --------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdio/snprintf.h"
+#include "src/stdio/sprintf.h"
+#include "utils/UnitTest/Test.h"
+
+#include <stdint.h>
+
+// Formats in a buffer large enough for the tests and checks the returned
+// length against the output.
+#define EXPECT_FORMAT(expected, ...)                                           \
+  do {                                                                         \
+    char buffer[512];                                                          \
+    const int ret =                                                            \
+        __llvm_libc::snprintf(buffer, sizeof(buffer), __VA_ARGS__);            \
+    EXPECT_STREQ(buffer, expected);                                            \
+    EXPECT_EQ(ret, static_cast<int>(sizeof(expected) - 1));                    \
+  } while (0)
+
+TEST(LlvmLibcSNPrintfTest, Raw) {
+  EXPECT_FORMAT("", "");
+  EXPECT_FORMAT("hello world", "hello world");
+  EXPECT_FORMAT("100% sure", "100%% sure");
+  EXPECT_FORMAT("%", "%%");
+  EXPECT_FORMAT("%%", "%%%%");
+}
+
+TEST(LlvmLibcSNPrintfTest, Truncation) {
+  char buffer[8];
+  EXPECT_EQ(__llvm_libc::snprintf(buffer, sizeof(buffer), "%s", "truncated"),
+            9);
+  EXPECT_STREQ(buffer, "truncat");
+  buffer[0] = 'x';
+  EXPECT_EQ(__llvm_libc::snprintf(buffer, 0, "%d", 12345), 5);
+  EXPECT_EQ(buffer[0], 'x');
+  EXPECT_EQ(__llvm_libc::snprintf(nullptr, 0, "%d", 12345), 5);
+  EXPECT_EQ(__llvm_libc::snprintf(buffer, 1, "%d", 12345), 5);
+  EXPECT_STREQ(buffer, "");
+}
+
+TEST(LlvmLibcSNPrintfTest, Sprintf) {
+  char buffer[32];
+  EXPECT_EQ(__llvm_libc::sprintf(buffer, "%s=%d", "answer", 42), 9);
+  EXPECT_STREQ(buffer, "answer=42");
+}
+
+TEST(LlvmLibcSNPrintfTest, Chars) {
+  EXPECT_FORMAT("a", "%c", 'a');
+  EXPECT_FORMAT("    a", "%5c", 'a');
+  EXPECT_FORMAT("a    |", "%-5c|", 'a');
+}
+
+TEST(LlvmLibcSNPrintfTest, Strings) {
+  EXPECT_FORMAT("abc", "%s", "abc");
+  EXPECT_FORMAT("  abc", "%5s", "abc");
+  EXPECT_FORMAT("abc  |", "%-5s|", "abc");
+  EXPECT_FORMAT("ab", "%.2s", "abc");
+  EXPECT_FORMAT("   ab", "%*.*s", 5, 2, "abc");
+  EXPECT_FORMAT("ab   |", "%*.*s|", -5, 2, "abc");
+  EXPECT_FORMAT("abc", "%.*s", -1, "abc");
+  EXPECT_FORMAT("(null)", "%s", static_cast<char *>(nullptr));
+  // With a precision the string need not be null terminated.
+  const char unterminated[3] = {'x', 'y', 'z'};
+  EXPECT_FORMAT("xyz", "%.3s", unterminated);
+}
+
+TEST(LlvmLibcSNPrintfTest, Integers) {
+  EXPECT_FORMAT("0", "%d", 0);
+  EXPECT_FORMAT("123", "%d", 123);
+  EXPECT_FORMAT("-123", "%i", -123);
+  EXPECT_FORMAT("-2147483648", "%d", INT32_MIN);
+  EXPECT_FORMAT("4294967295", "%u", UINT32_MAX);
+  EXPECT_FORMAT("-9223372036854775808", "%lld", INT64_MIN);
+  EXPECT_FORMAT("18446744073709551615", "%llu", UINT64_MAX);
+  EXPECT_FORMAT("9223372036854775807", "%jd", INTMAX_MAX);
+  EXPECT_FORMAT("1234567", "%zu", size_t(1234567));
+  EXPECT_FORMAT("-5", "%td", ptrdiff_t(-5));
+  EXPECT_FORMAT("-1", "%hhd", 255);
+  EXPECT_FORMAT("255", "%hhu", -1);
+  EXPECT_FORMAT("-1", "%hd", 65535);
+  EXPECT_FORMAT("65535", "%hu", -1);
+  EXPECT_FORMAT("-3", "%ld", -3L);
+
+  EXPECT_FORMAT("+5", "%+d", 5);
+  EXPECT_FORMAT(" 5", "% d", 5);
+  EXPECT_FORMAT("-5", "% d", -5);
+  EXPECT_FORMAT("+5", "%+ d", 5);
+  EXPECT_FORMAT("   42", "%5d", 42);
+  EXPECT_FORMAT("42   |", "%-5d|", 42);
+  EXPECT_FORMAT("00042", "%05d", 42);
+  EXPECT_FORMAT("-0042", "%05d", -42);
+  EXPECT_FORMAT("42   |", "%-05d|", 42);
+  EXPECT_FORMAT("00042", "%.5d", 42);
+  EXPECT_FORMAT("  00042", "%7.5d", 42);
+  EXPECT_FORMAT("  042", "%05.3d", 42);
+  EXPECT_FORMAT("", "%.0d", 0);
+  EXPECT_FORMAT("   ", "%3.0d", 0);
+  EXPECT_FORMAT("   42", "%*d", 5, 42);
+}
+
+TEST(LlvmLibcSNPrintfTest, OctalAndHex) {
+  EXPECT_FORMAT("17", "%o", 15);
+  EXPECT_FORMAT("017", "%#o", 15);
+  EXPECT_FORMAT("0", "%#o", 0);
+  EXPECT_FORMAT("0", "%#.0o", 0);
+  EXPECT_FORMAT("00017", "%#.5o", 15);
+  EXPECT_FORMAT("ff", "%x", 255);
+  EXPECT_FORMAT("FF", "%X", 255);
+  EXPECT_FORMAT("0xff", "%#x", 255);
+  EXPECT_FORMAT("0XFF", "%#X", 255);
+  EXPECT_FORMAT("0", "%#x", 0);
+  EXPECT_FORMAT("0x00ff", "%#06x", 255);
+  EXPECT_FORMAT("ffffffffffffffff", "%llx", UINT64_MAX);
+  EXPECT_FORMAT("1777777777777777777777", "%llo", UINT64_MAX);
+}
+
+TEST(LlvmLibcSNPrintfTest, Pointers) {
+  EXPECT_FORMAT("0x1234", "%p", reinterpret_cast<void *>(0x1234));
+  EXPECT_FORMAT("(nil)", "%p", static_cast<void *>(nullptr));
+  EXPECT_FORMAT("  0xab", "%6p", reinterpret_cast<void *>(0xab));
+}
+
+TEST(LlvmLibcSNPrintfTest, WriteCount) {
+  char buffer[32];
+  int count = 0;
+  signed char small_count = 0;
+  long long long_count = 0;
+  __llvm_libc::snprintf(buffer, sizeof(buffer), "abc%nde%hhnf%lln", &count,
+                        &small_count, &long_count);
+  EXPECT_EQ(count, 3);
+  EXPECT_EQ(int(small_count), 5);
+  EXPECT_EQ(long_count, 6LL);
+}
+
+TEST(LlvmLibcSNPrintfTest, Fixed) {
+  EXPECT_FORMAT("0.000000", "%f", 0.0);
+  EXPECT_FORMAT("-0.000000", "%f", -0.0);
+  EXPECT_FORMAT("1.000000", "%f", 1.0);
+  EXPECT_FORMAT("3.141593", "%f", 3.14159265358979);
+  EXPECT_FORMAT("-2.50", "%.2f", -2.5);
+  EXPECT_FORMAT("3", "%.0f", 3.4);
+  EXPECT_FORMAT("3.", "%#.0f", 3.4);
+  EXPECT_FORMAT("123456789.000", "%.3f", 123456789.0);
+  EXPECT_FORMAT("0.100000000000000005551115123125783",
+                "%.33f", 0.1);
+  EXPECT_FORMAT("10000000000000000725314363815292351261583744096465219555182101"
+                "554790400",
+                "%.0f", 1e70);
+  EXPECT_FORMAT("179769313486231570814527423731704356798070567525844996598917"
+                "476803157260780028538760589558632766878171540458953514382464"
+                "234321326889464182768467546703537516986049910576551282076245"
+                "490090389328944075868508455133942304583236903222948165808559"
+                "332123348274797826204144723168738177180919299881250404026184"
+                "124858368.000000",
+                "%f", 1.7976931348623157e308);
+  EXPECT_FORMAT("0.000000", "%f", 4.9406564584124654e-324);
+  EXPECT_FORMAT("  1.50", "%6.2f", 1.5);
+  EXPECT_FORMAT("1.50  |", "%-6.2f|", 1.5);
+  EXPECT_FORMAT("001.50", "%06.2f", 1.5);
+  EXPECT_FORMAT("-01.50", "%06.2f", -1.5);
+  EXPECT_FORMAT("+1.50", "%+.2f", 1.5);
+  EXPECT_FORMAT(" 1.50", "% .2f", 1.5);
+}
+
+TEST(LlvmLibcSNPrintfTest, FixedRounding) {
+  // Ties round to even, other values to nearest.
+  EXPECT_FORMAT("0", "%.0f", 0.5);
+  EXPECT_FORMAT("2", "%.0f", 1.5);
+  EXPECT_FORMAT("2", "%.0f", 2.5);
+  EXPECT_FORMAT("4", "%.0f", 3.5);
+  EXPECT_FORMAT("0.12", "%.2f", 0.125);
+  EXPECT_FORMAT("0.38", "%.2f", 0.375);
+  // 2.675 is below its decimal value in binary.
+  EXPECT_FORMAT("2.67", "%.2f", 2.675);
+  EXPECT_FORMAT("1.0", "%.1f", 0.96);
+  EXPECT_FORMAT("10.00", "%.2f", 9.999);
+  EXPECT_FORMAT("0.001", "%.3f", 0.0005000001);
+  EXPECT_FORMAT("0.000", "%.3f", 0.0004999);
+  EXPECT_FORMAT("1", "%.0f", 0.5000001);
+}
+
+TEST(LlvmLibcSNPrintfTest, Exponential) {
+  EXPECT_FORMAT("0.000000e+00", "%e", 0.0);
+  EXPECT_FORMAT("1.000000e+00", "%e", 1.0);
+  EXPECT_FORMAT("1.234568e+05", "%e", 123456.789);
+  EXPECT_FORMAT("1.234568E-05", "%E", 0.0000123456789);
+  EXPECT_FORMAT("1e+100", "%.0e", 1e100);
+  EXPECT_FORMAT("1.e+100", "%#.0e", 1e100);
+  EXPECT_FORMAT("1.797693e+308", "%e", 1.7976931348623157e308);
+  EXPECT_FORMAT("4.940656e-324", "%e", 4.9406564584124654e-324);
+  EXPECT_FORMAT("1.00e+01", "%.2e", 9.999);
+  EXPECT_FORMAT("-2.5e+00", "%.1e", -2.5);
+  EXPECT_FORMAT("2e+00", "%.0e", 2.5);
+  EXPECT_FORMAT("  1.0e+00", "%9.1e", 1.0);
+  EXPECT_FORMAT("001.0e+00", "%09.1e", 1.0);
+}
+
+TEST(LlvmLibcSNPrintfTest, General) {
+  EXPECT_FORMAT("0", "%g", 0.0);
+  EXPECT_FORMAT("1", "%g", 1.0);
+  EXPECT_FORMAT("0.1", "%g", 0.1);
+  EXPECT_FORMAT("123457", "%g", 123456.789);
+  EXPECT_FORMAT("1.23457e+06", "%g", 1234567.0);
+  EXPECT_FORMAT("0.0001", "%g", 0.0001);
+  EXPECT_FORMAT("1e-05", "%g", 0.00001);
+  EXPECT_FORMAT("1E-05", "%G", 0.00001);
+  EXPECT_FORMAT("100000", "%g", 99999.96);
+  EXPECT_FORMAT("1e+06", "%g", 999999.5);
+  EXPECT_FORMAT("3.14", "%.3g", 3.14159);
+  EXPECT_FORMAT("3", "%.0g", 3.14159);
+  EXPECT_FORMAT("1.00000", "%#g", 1.0);
+  EXPECT_FORMAT("1.500", "%#.4g", 1.5);
+  EXPECT_FORMAT("1.5", "%.10g", 1.5);
+  EXPECT_FORMAT("0.30000000000000004", "%.17g", 0.1 + 0.2);
+}
+
+TEST(LlvmLibcSNPrintfTest, Hex) {
+  EXPECT_FORMAT("0x0p+0", "%a", 0.0);
+  EXPECT_FORMAT("0x1p+0", "%a", 1.0);
+  EXPECT_FORMAT("-0x1.8p+1", "%a", -3.0);
+  EXPECT_FORMAT("0x1.999999999999ap-4", "%a", 0.1);
+  EXPECT_FORMAT("0X1.999999999999AP-4", "%A", 0.1);
+  EXPECT_FORMAT("0x1.9ap-4", "%.2a", 0.1);
+  EXPECT_FORMAT("0x2p+0", "%.0a", 1.9);
+  EXPECT_FORMAT("0x1.000p+0", "%.3a", 1.0);
+  EXPECT_FORMAT("0x1p-1074", "%a", 4.9406564584124654e-324);
+  EXPECT_FORMAT("0x001.8p+1", "%010a", 3.0);
+}
+
+TEST(LlvmLibcSNPrintfTest, InfAndNaN) {
+  EXPECT_FORMAT("inf", "%f", __builtin_inf());
+  EXPECT_FORMAT("-inf", "%e", -__builtin_inf());
+  EXPECT_FORMAT("INF", "%G", __builtin_inf());
+  EXPECT_FORMAT("nan", "%g", __builtin_nan(""));
+  EXPECT_FORMAT("NAN", "%A", __builtin_nan(""));
+  EXPECT_FORMAT("  +inf", "%+06f", __builtin_inf());
+}
+
+TEST(LlvmLibcSNPrintfTest, LongDouble) {
+  EXPECT_FORMAT("1.500000", "%Lf", 1.5L);
+  EXPECT_FORMAT("-2.50e+10", "%.2Le", -2.5e10L);
+  EXPECT_FORMAT("0.1", "%Lg", 0.1L);
+  EXPECT_FORMAT("inf", "%Lf", __builtin_infl());
+}
+
+TEST(LlvmLibcSNPrintfTest, Mixed) {
+  EXPECT_FORMAT("[INFO] 12:05:09 worker-3 processed 1024 items in 3.250 ms",
+                "[%s] %02d:%02d:%02d worker-%u processed %zu items in %.3f ms",
+                "INFO", 12, 5, 9, 3u, size_t(1024), 3.25);
+  // Unknown conversions are written as is.
+  EXPECT_FORMAT("%y 1", "%y %d", 1);
+}
@@ -0,0 +1,55 @@
+//===-- Unittests for aligned_alloc ---------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "include/errno.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdlib/aligned_alloc.h"
+#include "src/stdlib/free.h"
+#include "src/stdlib/realloc.h"
+#include "utils/UnitTest/Test.h"
+
+#include <initializer_list>
+#include <stdint.h>
+
+static bool is_aligned(const void *ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(LlvmLibcAlignedAllocTest, Alignments) {
+  for (size_t alignment = 1; alignment <= (size_t(1) << 21); alignment *= 2) {
+    for (size_t size : {size_t(1), size_t(100), size_t(5000), size_t(70000)}) {
+      void *ptr = __llvm_libc::aligned_alloc(alignment, size);
+      ASSERT_NE(ptr, static_cast<void *>(nullptr));
+      ASSERT_TRUE(is_aligned(ptr, alignment));
+      for (size_t i = 0; i < size; ++i)
+        static_cast<char *>(ptr)[i] = static_cast<char>(i);
+      __llvm_libc::free(ptr);
+    }
+  }
+}
+
+TEST(LlvmLibcAlignedAllocTest, Realloc) {
+  char *ptr = static_cast<char *>(__llvm_libc::aligned_alloc(4096, 64));
+  ASSERT_NE(ptr, static_cast<char *>(nullptr));
+  for (size_t i = 0; i < 64; ++i)
+    ptr[i] = static_cast<char>(i);
+  ptr = static_cast<char *>(__llvm_libc::realloc(ptr, 1000));
+  ASSERT_NE(ptr, static_cast<char *>(nullptr));
+  for (size_t i = 0; i < 64; ++i)
+    ASSERT_EQ(ptr[i], static_cast<char>(i));
+  __llvm_libc::free(ptr);
+}
+
+TEST(LlvmLibcAlignedAllocTest, InvalidAlignment) {
+  llvmlibc_errno = 0;
+  EXPECT_EQ(__llvm_libc::aligned_alloc(0, 16), static_cast<void *>(nullptr));
+  EXPECT_EQ(llvmlibc_errno, EINVAL);
+  llvmlibc_errno = 0;
+  EXPECT_EQ(__llvm_libc::aligned_alloc(24, 48), static_cast<void *>(nullptr));
+  EXPECT_EQ(llvmlibc_errno, EINVAL);
+}
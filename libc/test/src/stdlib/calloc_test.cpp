@@ -0,0 +1,55 @@
+//===-- Unittests for calloc ----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "include/errno.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdlib/calloc.h"
+#include "src/stdlib/free.h"
+#include "src/stdlib/malloc.h"
+#include "utils/UnitTest/Test.h"
+
+#include <stdint.h>
+
+static bool is_zero(const void *ptr, size_t size) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(ptr);
+  for (size_t i = 0; i < size; ++i)
+    if (bytes[i] != 0)
+      return false;
+  return true;
+}
+
+TEST(LlvmLibcCallocTest, ZeroFilled) {
+  for (size_t size = 1; size <= (size_t(1) << 18); size *= 3) {
+    // Dirty a block of the same size first, so that calloc has a chance of
+    // getting it back.
+    void *dirty = __llvm_libc::malloc(size);
+    ASSERT_NE(dirty, static_cast<void *>(nullptr));
+    for (size_t i = 0; i < size; ++i)
+      static_cast<unsigned char *>(dirty)[i] = 0xAB;
+    __llvm_libc::free(dirty);
+
+    void *ptr = __llvm_libc::calloc(size, 1);
+    ASSERT_NE(ptr, static_cast<void *>(nullptr));
+    ASSERT_TRUE(is_zero(ptr, size));
+    __llvm_libc::free(ptr);
+  }
+}
+
+TEST(LlvmLibcCallocTest, Array) {
+  int *array = static_cast<int *>(__llvm_libc::calloc(100, sizeof(int)));
+  ASSERT_NE(array, static_cast<int *>(nullptr));
+  ASSERT_TRUE(is_zero(array, 100 * sizeof(int)));
+  __llvm_libc::free(array);
+}
+
+TEST(LlvmLibcCallocTest, Overflow) {
+  llvmlibc_errno = 0;
+  void *ptr = __llvm_libc::calloc(SIZE_MAX / 2, 3);
+  EXPECT_EQ(ptr, static_cast<void *>(nullptr));
+  EXPECT_EQ(llvmlibc_errno, ENOMEM);
+}
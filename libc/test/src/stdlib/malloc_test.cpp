@@ -0,0 +1,177 @@
+//===-- Unittests for malloc and free -------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "include/errno.h"
+#include "include/threads.h"
+#include "src/errno/llvmlibc_errno.h"
+#include "src/stdlib/free.h"
+#include "src/stdlib/malloc.h"
+#include "src/threads/thrd_create.h"
+#include "src/threads/thrd_join.h"
+#include "utils/UnitTest/Test.h"
+
+#include <stdint.h>
+
+static bool is_aligned(const void *ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+// Fills `size` bytes at `ptr` with a pattern depending on `seed`.
+static void fill(void *ptr, size_t size, unsigned seed) {
+  unsigned char *bytes = static_cast<unsigned char *>(ptr);
+  for (size_t i = 0; i < size; ++i)
+    bytes[i] = static_cast<unsigned char>(i * 7 + seed);
+}
+
+static bool check(const void *ptr, size_t size, unsigned seed) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(ptr);
+  for (size_t i = 0; i < size; ++i)
+    if (bytes[i] != static_cast<unsigned char>(i * 7 + seed))
+      return false;
+  return true;
+}
+
+TEST(LlvmLibcMallocTest, FreeNull) { __llvm_libc::free(nullptr); }
+
+TEST(LlvmLibcMallocTest, ZeroSize) {
+  void *ptr = __llvm_libc::malloc(0);
+  ASSERT_NE(ptr, static_cast<void *>(nullptr));
+  __llvm_libc::free(ptr);
+}
+
+TEST(LlvmLibcMallocTest, AllSizes) {
+  // Covers every small size class boundary as well as large allocations.
+  for (size_t size = 1; size <= (size_t(1) << 20); size += size / 8 + 1) {
+    void *ptr = __llvm_libc::malloc(size);
+    ASSERT_NE(ptr, static_cast<void *>(nullptr));
+    ASSERT_TRUE(is_aligned(ptr, 16));
+    fill(ptr, size, size);
+    ASSERT_TRUE(check(ptr, size, size));
+    __llvm_libc::free(ptr);
+  }
+}
+
+TEST(LlvmLibcMallocTest, DistinctBlocks) {
+  constexpr size_t COUNT = 4096;
+  static void *blocks[COUNT];
+  for (size_t i = 0; i < COUNT; ++i) {
+    const size_t size = 1 + (i * 37) % 600;
+    blocks[i] = __llvm_libc::malloc(size);
+    ASSERT_NE(blocks[i], static_cast<void *>(nullptr));
+    fill(blocks[i], size, i);
+  }
+  // Free every other block and reallocate them, which must not clobber the
+  // blocks still in use.
+  for (size_t i = 0; i < COUNT; i += 2)
+    __llvm_libc::free(blocks[i]);
+  for (size_t i = 0; i < COUNT; i += 2) {
+    const size_t size = 1 + (i * 37) % 600;
+    blocks[i] = __llvm_libc::malloc(size);
+    ASSERT_NE(blocks[i], static_cast<void *>(nullptr));
+    fill(blocks[i], size, i);
+  }
+  for (size_t i = 0; i < COUNT; ++i) {
+    ASSERT_TRUE(check(blocks[i], 1 + (i * 37) % 600, i));
+    __llvm_libc::free(blocks[i]);
+  }
+}
+
+TEST(LlvmLibcMallocTest, ReusesMemory) {
+  // Many more bytes than a slab holds go through the allocator, which only
+  // works out if freed blocks are reused.
+  for (size_t i = 0; i < 100000; ++i) {
+    void *ptr = __llvm_libc::malloc(1024);
+    ASSERT_NE(ptr, static_cast<void *>(nullptr));
+    __llvm_libc::free(ptr);
+  }
+}
+
+TEST(LlvmLibcMallocTest, LargeBlocksReused) {
+  for (size_t i = 0; i < 1000; ++i) {
+    const size_t size = (size_t(1) << 20) + i * 4096;
+    void *ptr = __llvm_libc::malloc(size);
+    ASSERT_NE(ptr, static_cast<void *>(nullptr));
+    fill(ptr, size, i);
+    ASSERT_TRUE(check(ptr, size, i));
+    __llvm_libc::free(ptr);
+  }
+}
+
+constexpr int THREAD_COUNT = 8;
+constexpr size_t BLOCKS_PER_THREAD = 512;
+static void *shared_blocks[THREAD_COUNT][BLOCKS_PER_THREAD];
+
+// Allocates blocks of various sizes, checks them and frees most of them,
+// leaving the others to be freed by another thread.
+static int allocate_and_free(void *arg) {
+  const int id = *static_cast<int *>(arg);
+  for (unsigned round = 0; round < 20; ++round) {
+    void *blocks[BLOCKS_PER_THREAD];
+    for (size_t i = 0; i < BLOCKS_PER_THREAD; ++i) {
+      const size_t size = 1 + (i * 37 + id) % 2000;
+      blocks[i] = __llvm_libc::malloc(size);
+      if (blocks[i] == nullptr)
+        return 1;
+      fill(blocks[i], size, id + i);
+    }
+    for (size_t i = 0; i < BLOCKS_PER_THREAD; ++i) {
+      if (!check(blocks[i], 1 + (i * 37 + id) % 2000, id + i))
+        return 1;
+      __llvm_libc::free(blocks[i]);
+    }
+  }
+  for (size_t i = 0; i < BLOCKS_PER_THREAD; ++i) {
+    shared_blocks[id][i] = __llvm_libc::malloc(1 + i * 3);
+    if (shared_blocks[id][i] == nullptr)
+      return 1;
+    fill(shared_blocks[id][i], 1 + i * 3, id);
+  }
+  return 0;
+}
+
+static int free_other(void *arg) {
+  const int id = (*static_cast<int *>(arg) + 1) % THREAD_COUNT;
+  for (size_t i = 0; i < BLOCKS_PER_THREAD; ++i) {
+    if (!check(shared_blocks[id][i], 1 + i * 3, id))
+      return 1;
+    __llvm_libc::free(shared_blocks[id][i]);
+  }
+  return 0;
+}
+
+TEST(LlvmLibcMallocTest, Threads) {
+  thrd_t threads[THREAD_COUNT];
+  int ids[THREAD_COUNT];
+  for (int i = 0; i < THREAD_COUNT; ++i) {
+    ids[i] = i;
+    ASSERT_EQ(__llvm_libc::thrd_create(&threads[i], allocate_and_free, &ids[i]),
+              (int)thrd_success);
+  }
+  for (int i = 0; i < THREAD_COUNT; ++i) {
+    int retval = -1;
+    ASSERT_EQ(__llvm_libc::thrd_join(&threads[i], &retval), (int)thrd_success);
+    ASSERT_EQ(retval, 0);
+  }
+
+  // Each thread frees the blocks left by another one.
+  for (int i = 0; i < THREAD_COUNT; ++i)
+    ASSERT_EQ(__llvm_libc::thrd_create(&threads[i], free_other, &ids[i]),
+              (int)thrd_success);
+  for (int i = 0; i < THREAD_COUNT; ++i) {
+    int retval = -1;
+    ASSERT_EQ(__llvm_libc::thrd_join(&threads[i], &retval), (int)thrd_success);
+    ASSERT_EQ(retval, 0);
+  }
+}
+
+TEST(LlvmLibcMallocTest, OutOfMemory) {
+  llvmlibc_errno = 0;
+  void *ptr = __llvm_libc::malloc(SIZE_MAX - 4096);
+  EXPECT_EQ(ptr, static_cast<void *>(nullptr));
+  EXPECT_EQ(llvmlibc_errno, ENOMEM);
+}
@@ -0,0 +1,75 @@
+//===-- Unittests for realloc ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "src/stdlib/free.h"
+#include "src/stdlib/malloc.h"
+#include "src/stdlib/realloc.h"
+#include "utils/UnitTest/Test.h"
+
+static void fill(void *ptr, size_t size) {
+  unsigned char *bytes = static_cast<unsigned char *>(ptr);
+  for (size_t i = 0; i < size; ++i)
+    bytes[i] = static_cast<unsigned char>(i * 13 + 5);
+}
+
+static bool check(const void *ptr, size_t size) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(ptr);
+  for (size_t i = 0; i < size; ++i)
+    if (bytes[i] != static_cast<unsigned char>(i * 13 + 5))
+      return false;
+  return true;
+}
+
+TEST(LlvmLibcReallocTest, Null) {
+  void *ptr = __llvm_libc::realloc(nullptr, 32);
+  ASSERT_NE(ptr, static_cast<void *>(nullptr));
+  __llvm_libc::free(ptr);
+}
+
+TEST(LlvmLibcReallocTest, Grow) {
+  size_t size = 1;
+  void *ptr = __llvm_libc::malloc(size);
+  fill(ptr, size);
+  while (size < (size_t(1) << 20)) {
+    const size_t new_size = size * 2 + 3;
+    ptr = __llvm_libc::realloc(ptr, new_size);
+    ASSERT_NE(ptr, static_cast<void *>(nullptr));
+    ASSERT_TRUE(check(ptr, size));
+    size = new_size;
+    fill(ptr, size);
+  }
+  __llvm_libc::free(ptr);
+}
+
+TEST(LlvmLibcReallocTest, Shrink) {
+  size_t size = size_t(1) << 20;
+  void *ptr = __llvm_libc::malloc(size);
+  fill(ptr, size);
+  while (size > 1) {
+    size /= 3;
+    ptr = __llvm_libc::realloc(ptr, size);
+    ASSERT_NE(ptr, static_cast<void *>(nullptr));
+    ASSERT_TRUE(check(ptr, size));
+  }
+  __llvm_libc::free(ptr);
+}
+
+TEST(LlvmLibcReallocTest, InPlace) {
+  void *ptr = __llvm_libc::malloc(100);
+  ASSERT_NE(ptr, static_cast<void *>(nullptr));
+  // Sizes of the same class keep the block where it is.
+  EXPECT_EQ(__llvm_libc::realloc(ptr, 112), ptr);
+  EXPECT_EQ(__llvm_libc::realloc(ptr, 97), ptr);
+  __llvm_libc::free(ptr);
+}
+
+TEST(LlvmLibcReallocTest, ZeroSize) {
+  void *ptr = __llvm_libc::malloc(100);
+  ASSERT_NE(ptr, static_cast<void *>(nullptr));
+  EXPECT_EQ(__llvm_libc::realloc(ptr, 0), static_cast<void *>(nullptr));
+}
@@ -120,3 +120,21 @@ TEST(LlvmLibcMemChrTest, SignedCharacterFound) {
   // Should find the first character 'c'.
   ASSERT_EQ(actual[0], c);
 }
+
+TEST(LlvmLibcMemChrTest, AllAlignmentsSizesAndPositions) {
+  char buffer[512];
+  for (size_t i = 0; i < sizeof(buffer); ++i)
+    buffer[i] = 'a';
+  for (size_t offset = 0; offset < 64; ++offset) {
+    for (size_t size = 0; size < 300; ++size) {
+      ASSERT_STREQ(call_memchr(buffer + offset, 'b', size), nullptr);
+      for (size_t position = 0; position < size + 2; ++position) {
+        buffer[offset + position] = 'b';
+        const char *expected =
+            position < size ? buffer + offset + position : nullptr;
+        ASSERT_EQ(call_memchr(buffer + offset, 'b', size), expected);
+        buffer[offset + position] = 'a';
+      }
+    }
+  }
+}
@@ -32,3 +32,24 @@ TEST(LlvmLibcMemcmpTest, LhsAfterRhsLexically) {
   const char *rhs = "ab";
   EXPECT_EQ(__llvm_libc::memcmp(lhs, rhs, 2), 1);
 }
+
+TEST(LlvmLibcMemcmpTest, Thorough) {
+  unsigned char lhs[1024];
+  unsigned char rhs[1024];
+  for (size_t i = 0; i < sizeof(lhs); ++i)
+    lhs[i] = rhs[i] = static_cast<unsigned char>(i * 7);
+  for (size_t count = 1; count < sizeof(lhs); ++count) {
+    ASSERT_EQ(__llvm_libc::memcmp(lhs, rhs, count), 0);
+    // A mismatch at the start, in the middle or at the end of the range is
+    // reported as the difference of the mismatching bytes.
+    const size_t positions[] = {0, count / 2, count - 1};
+    for (size_t pos : positions) {
+      const unsigned char saved = rhs[pos];
+      rhs[pos] = static_cast<unsigned char>(saved + 0x81);
+      const int expected = lhs[pos] - rhs[pos];
+      ASSERT_EQ(__llvm_libc::memcmp(lhs, rhs, count), expected);
+      ASSERT_EQ(__llvm_libc::memcmp(rhs, lhs, count), -expected);
+      rhs[pos] = saved;
+    }
+  }
+}
@@ -68,3 +68,29 @@ TEST_F(LlvmLibcMemmoveTest, DestFollowSrc) {
   const unsigned char expected[] = {'z', 'a', 'a', 'z'};
   check_memmove(&str[2], &str[1], 1, str, expected);
 }
+
+TEST_F(LlvmLibcMemmoveTest, Thorough) {
+  constexpr size_t kSize = 1024;
+  unsigned char groundtruth[kSize];
+  for (size_t i = 0; i < kSize; ++i)
+    groundtruth[i] = static_cast<unsigned char>(i * 7);
+  const ptrdiff_t distances[] = {-65, -33, -17, -1, 1, 5, 16, 31, 64, 257};
+  for (size_t count = 0; count < 512; ++count) {
+    for (ptrdiff_t distance : distances) {
+      unsigned char buffer[kSize];
+      unsigned char expected[kSize];
+      for (size_t i = 0; i < kSize; ++i)
+        buffer[i] = expected[i] = groundtruth[i];
+      const size_t src = 256;
+      const size_t dst = src + distance;
+      // Bytes are moved as if through an intermediate buffer.
+      unsigned char tmp[kSize];
+      for (size_t i = 0; i < count; ++i)
+        tmp[i] = expected[src + i];
+      for (size_t i = 0; i < count; ++i)
+        expected[dst + i] = tmp[i];
+      check_memmove(&buffer[dst], &buffer[src], count, buffer,
+                    expected);
+    }
+  }
+}
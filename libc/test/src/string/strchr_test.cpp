@@ -8,6 +8,7 @@
 
 #include "src/string/strchr.h"
 #include "utils/UnitTest/Test.h"
+#include <stddef.h>
 
 TEST(LlvmLibcStrChrTest, FindsFirstCharacter) {
   const char *src = "abcde";
@@ -80,3 +81,29 @@ TEST(LlvmLibcStrChrTest, EmptyStringShouldOnlyMatchNullTerminator) {
   ASSERT_STREQ(__llvm_libc::strchr("", '3'), nullptr);
   ASSERT_STREQ(__llvm_libc::strchr("", '*'), nullptr);
 }
+
+TEST(LlvmLibcStrChrTest, AllAlignmentsAndPositions) {
+  char buffer[512];
+  for (size_t offset = 0; offset < 64; ++offset) {
+    for (size_t position = 0; position < 300; ++position) {
+      for (size_t i = 0; i < sizeof(buffer); ++i)
+        buffer[i] = 'a';
+      buffer[offset + position] = 'b';
+      buffer[offset + 300] = '\0';
+      ASSERT_EQ(__llvm_libc::strchr(buffer + offset, 'b'),
+                buffer + offset + position);
+      // The terminator stops the search before the character.
+      buffer[offset + position] = '\0';
+      buffer[offset + position + 1] = 'b';
+      ASSERT_STREQ(__llvm_libc::strchr(buffer + offset, 'b'), nullptr);
+      ASSERT_EQ(__llvm_libc::strchr(buffer + offset, '\0'),
+                buffer + offset + position);
+    }
+  }
+}
+
+TEST(LlvmLibcStrChrTest, HighBitCharacter) {
+  const char src[] = "abc\xe9xyz";
+  ASSERT_STREQ(__llvm_libc::strchr(src, 0xe9), "\xe9xyz");
+  ASSERT_STREQ(__llvm_libc::strchr(src, -23), "\xe9xyz");
+}
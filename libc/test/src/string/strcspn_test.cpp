@@ -48,3 +48,10 @@ TEST(LlvmLibcStrCSpnTest, DuplicatedCharactersNotPartOfComplementarySpan) {
   EXPECT_EQ(__llvm_libc::strcspn("aaaa", "aa"), size_t{0});
   EXPECT_EQ(__llvm_libc::strcspn("aaaa", "baa"), size_t{0});
 }
+
+TEST(LlvmLibcStrCSpnTest, HighBitCharacters) {
+  EXPECT_EQ(__llvm_libc::strcspn("abc\xe9x", "\xe8\xe9"), size_t{3});
+  EXPECT_EQ(__llvm_libc::strcspn("abc\xe9x", "\xe9"), size_t{3});
+  // 0xe9 and 0x69 share their lower bits.
+  EXPECT_EQ(__llvm_libc::strcspn("iii", "\xe9\xe8"), size_t{3});
+}
@@ -22,3 +22,22 @@ TEST(LlvmLibcStrLenTest, AnyString) {
   size_t result = __llvm_libc::strlen(any);
   ASSERT_EQ((size_t)12, result);
 }
+
+TEST(LlvmLibcStrLenTest, AllAlignmentsAndLengths) {
+  // Covers the bytes before the first aligned block, every position of the
+  // terminator in a vector and the unrolled loop.
+  char buffer[512];
+  for (size_t offset = 0; offset < 64; ++offset) {
+    for (size_t length = 0; length < 300; ++length) {
+      for (size_t i = 0; i < sizeof(buffer); ++i)
+        buffer[i] = 'a' + i % 26;
+      buffer[offset + length] = '\0';
+      ASSERT_EQ(__llvm_libc::strlen(buffer + offset), length);
+    }
+  }
+}
+
+TEST(LlvmLibcStrLenTest, HighBitCharacters) {
+  const char any[] = {'\x80', '\xff', '\x01', '\x7f', '\0'};
+  ASSERT_EQ(__llvm_libc::strlen(any), size_t{4});
+}
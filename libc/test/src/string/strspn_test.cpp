@@ -83,3 +83,10 @@ TEST(LlvmLibcStrSpnTest, DuplicatedCharactersToBeSearchedForShouldStillMatch) {
   EXPECT_EQ(__llvm_libc::strspn("aaa", "aa"), size_t{3});
   EXPECT_EQ(__llvm_libc::strspn("aaaa", "aa"), size_t{4});
 }
+
+TEST(LlvmLibcStrSpnTest, HighBitCharacters) {
+  EXPECT_EQ(__llvm_libc::strspn("\xe9\xe8\xe9x", "\xe8\xe9"), size_t{3});
+  EXPECT_EQ(__llvm_libc::strspn("\xe9\xe8", "\xe9"), size_t{1});
+  // 0xe9 and 0x69 share their lower bits.
+  EXPECT_EQ(__llvm_libc::strspn("iii", "\xe9\xe8"), size_t{0});
+}
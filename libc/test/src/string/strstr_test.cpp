@@ -8,6 +8,7 @@
 
 #include "src/string/strstr.h"
 #include "utils/UnitTest/Test.h"
+#include <stddef.h>
 
 TEST(LlvmLibcStrStrTest, NeedleNotInHaystack) {
   const char *haystack = "12345";
@@ -112,3 +113,49 @@ TEST(LlvmLibcStrStrTest, MorphedNeedle) {
   ASSERT_STREQ(__llvm_libc::strstr(haystack, "tire"), nullptr);
   ASSERT_STREQ(__llvm_libc::strstr(haystack, "timo"), nullptr);
 }
+
+TEST(LlvmLibcStrStrTest, PeriodicNeedle) {
+  // The needle repeats "ab", the partial matches overlap.
+  const char *haystack = "abababababacabababababababababc";
+  ASSERT_STREQ(__llvm_libc::strstr(haystack, "ababababababc"),
+               "ababababababc");
+  ASSERT_STREQ(__llvm_libc::strstr(haystack, "abababababababababababc"),
+               nullptr);
+  ASSERT_STREQ(__llvm_libc::strstr("aaaaaaaaaaaaab", "aaab"), "aaab");
+  ASSERT_STREQ(__llvm_libc::strstr("aaaaaaaaaaaaaa", "aaab"), nullptr);
+}
+
+TEST(LlvmLibcStrStrTest, NeedleEndingWithRareCharacter) {
+  const char *haystack = "the quick brown fox jumps over the lazy dog";
+  ASSERT_STREQ(__llvm_libc::strstr(haystack, "the lazy"), "the lazy dog");
+  ASSERT_STREQ(__llvm_libc::strstr(haystack, "the lazz"), nullptr);
+  ASSERT_STREQ(__llvm_libc::strstr(haystack, "over"), "over the lazy dog");
+}
+
+TEST(LlvmLibcStrStrTest, LongHaystackAndNeedle) {
+  // The haystack is longer than the part whose end is looked up at once.
+  char haystack[1024];
+  char needle[200];
+  for (size_t i = 0; i < sizeof(haystack) - 1; ++i)
+    haystack[i] = "ab"[(i / 7) % 2];
+  haystack[sizeof(haystack) - 1] = '\0';
+  for (size_t start = 0; start + sizeof(needle) < sizeof(haystack);
+       start += 97) {
+    for (size_t i = 0; i < sizeof(needle) - 1; ++i)
+      needle[i] = haystack[start + i];
+    needle[sizeof(needle) - 1] = '\0';
+    // Periodic haystack: the first match is within the first period.
+    const char *match = __llvm_libc::strstr(haystack, needle);
+    ASSERT_TRUE(match != nullptr);
+    ASSERT_EQ(static_cast<size_t>(match - haystack), start % 14);
+    needle[sizeof(needle) - 2] = 'c';
+    ASSERT_STREQ(__llvm_libc::strstr(haystack, needle), nullptr);
+  }
+}
+
+TEST(LlvmLibcStrStrTest, HighBitCharacters) {
+  const char *haystack = "caf\xc3\xa9 cr\xc3\xa8me";
+  ASSERT_STREQ(__llvm_libc::strstr(haystack, "\xc3\xa8"), "\xc3\xa8me");
+  ASSERT_STREQ(__llvm_libc::strstr(haystack, "\xc3\xa9 "),
+               "\xc3\xa9 cr\xc3\xa8me");
+}
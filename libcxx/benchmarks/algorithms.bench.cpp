@@ -1,7 +1,9 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <execution>
 #include <map>
+#include <numeric>
 #include <random>
 #include <string>
 #include <utility>
@@ -309,6 +311,210 @@ struct PopHeap {
   };
 };
 
+#if defined(_LIBCPP_HAS_PARALLEL_ALGORITHMS)
+// The parallel algorithms run on a thread pool, so compare the wall-clock
+// "Time" column rather than "CPU", which only covers the calling thread.
+
+enum class Policy { Seq, Par, ParUnseq };
+struct AllPolicies : EnumValuesAsTuple<AllPolicies, Policy, 3> {
+  static constexpr const char* Names[] = {"Seq", "Par", "ParUnseq"};
+};
+
+template <class P, class F>
+void withPolicy(F Body) {
+  if constexpr (P() == Policy::Seq)
+    Body(std::execution::seq);
+  else if constexpr (P() == Policy::Par)
+    Body(std::execution::par);
+  else
+    Body(std::execution::par_unseq);
+}
+
+enum class NumericType { Uint32, Uint64, Double };
+struct AllNumericTypes : EnumValuesAsTuple<AllNumericTypes, NumericType, 3> {
+  static constexpr const char* Names[] = {"uint32", "uint64", "double"};
+};
+
+template <class V>
+using Numeric = std::conditional_t<
+    V() == NumericType::Uint32, uint32_t,
+    std::conditional_t<V() == NumericType::Uint64, uint64_t, double> >;
+
+template <class T>
+std::vector<T> makeNumericValues(size_t N) {
+  std::vector<T> V(N);
+  std::mt19937 M(N);
+  for (auto& X : V)
+    X = static_cast<T>(M() % 1024);
+  return V;
+}
+
+template <class NumericType, class Policy>
+struct ParallelForEach {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    auto V = makeNumericValues<Numeric<NumericType> >(Quantity);
+    while (state.KeepRunningBatch(Quantity)) {
+      withPolicy<Policy>([&](const auto& Exec) {
+        std::for_each(Exec, V.begin(), V.end(), [](auto& X) { X = X * 3 + 1; });
+      });
+      benchmark::DoNotOptimize(V.data());
+    }
+  }
+
+  std::string name() const {
+    return "BM_ParallelForEach" + NumericType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+
+template <class NumericType, class Policy>
+struct ParallelTransform {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    auto In = makeNumericValues<Numeric<NumericType> >(Quantity);
+    auto Out = In;
+    while (state.KeepRunningBatch(Quantity)) {
+      withPolicy<Policy>([&](const auto& Exec) {
+        std::transform(Exec, In.begin(), In.end(), Out.begin(),
+                       [](auto X) { return X * X + 7; });
+      });
+      benchmark::DoNotOptimize(Out.data());
+    }
+  }
+
+  std::string name() const {
+    return "BM_ParallelTransform" + NumericType::name() + Policy::name() +
+           "_" + std::to_string(Quantity);
+  };
+};
+
+template <class NumericType, class Policy>
+struct ParallelReduce {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    auto V = makeNumericValues<Numeric<NumericType> >(Quantity);
+    while (state.KeepRunningBatch(Quantity)) {
+      withPolicy<Policy>([&](const auto& Exec) {
+        benchmark::DoNotOptimize(std::reduce(Exec, V.begin(), V.end()));
+      });
+    }
+  }
+
+  std::string name() const {
+    return "BM_ParallelReduce" + NumericType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+
+template <class NumericType, class Policy>
+struct ParallelTransformReduce {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    auto A = makeNumericValues<Numeric<NumericType> >(Quantity);
+    auto B = makeNumericValues<Numeric<NumericType> >(Quantity + 1);
+    while (state.KeepRunningBatch(Quantity)) {
+      withPolicy<Policy>([&](const auto& Exec) {
+        benchmark::DoNotOptimize(std::transform_reduce(
+            Exec, A.begin(), A.end(), B.begin(), Numeric<NumericType>()));
+      });
+    }
+  }
+
+  std::string name() const {
+    return "BM_ParallelTransformReduce" + NumericType::name() +
+           Policy::name() + "_" + std::to_string(Quantity);
+  };
+};
+
+template <class NumericType, class Policy>
+struct ParallelInclusiveScan {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    auto In = makeNumericValues<Numeric<NumericType> >(Quantity);
+    auto Out = In;
+    while (state.KeepRunningBatch(Quantity)) {
+      withPolicy<Policy>([&](const auto& Exec) {
+        std::inclusive_scan(Exec, In.begin(), In.end(), Out.begin());
+      });
+      benchmark::DoNotOptimize(Out.data());
+    }
+  }
+
+  std::string name() const {
+    return "BM_ParallelInclusiveScan" + NumericType::name() + Policy::name() +
+           "_" + std::to_string(Quantity);
+  };
+};
+
+template <class NumericType, class Policy>
+struct ParallelCopyIf {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    auto In = makeNumericValues<Numeric<NumericType> >(Quantity);
+    auto Out = In;
+    while (state.KeepRunningBatch(Quantity)) {
+      withPolicy<Policy>([&](const auto& Exec) {
+        benchmark::DoNotOptimize(
+            std::copy_if(Exec, In.begin(), In.end(), Out.begin(),
+                         [](auto X) { return X < 512; }));
+      });
+    }
+  }
+
+  std::string name() const {
+    return "BM_ParallelCopyIf" + NumericType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+
+template <class ValueType, class Policy>
+struct ParallelSort {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(
+        state, Quantity, Order::Random, BatchSize::CountElements,
+        [](auto& Copy) {
+          withPolicy<Policy>([&](const auto& Exec) {
+            std::sort(Exec, Copy.begin(), Copy.end());
+          });
+        });
+  }
+
+  std::string name() const {
+    return "BM_ParallelSort" + ValueType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+
+template <class ValueType, class Policy>
+struct ParallelStableSort {
+  size_t Quantity;
+
+  void run(benchmark::State& state) const {
+    runOpOnCopies<ValueType>(
+        state, Quantity, Order::Random, BatchSize::CountElements,
+        [](auto& Copy) {
+          withPolicy<Policy>([&](const auto& Exec) {
+            std::stable_sort(Exec, Copy.begin(), Copy.end());
+          });
+        });
+  }
+
+  std::string name() const {
+    return "BM_ParallelStableSort" + ValueType::name() + Policy::name() + "_" +
+           std::to_string(Quantity);
+  };
+};
+#endif // _LIBCPP_HAS_PARALLEL_ALGORITHMS
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -333,5 +539,31 @@ int main(int argc, char** argv) {
       Quantities);
   makeCartesianProductBenchmark<PushHeap, AllValueTypes, AllOrders>(Quantities);
   makeCartesianProductBenchmark<PopHeap, AllValueTypes>(Quantities);
+
+#if defined(_LIBCPP_HAS_PARALLEL_ALGORITHMS)
+  // Below a few thousand elements the parallel overloads run serially, so
+  // only sizes where the thread pool takes part show how they scale.
+  const std::vector<size_t> ParallelQuantities = {1 << 10, 1 << 14, 1 << 18,
+#if !TEST_HAS_FEATURE(memory_sanitizer)
+                                                  1 << 20
+#endif
+  };
+  makeCartesianProductBenchmark<ParallelForEach, AllNumericTypes, AllPolicies>(
+      ParallelQuantities);
+  makeCartesianProductBenchmark<ParallelTransform, AllNumericTypes,
+                                AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<ParallelReduce, AllNumericTypes, AllPolicies>(
+      ParallelQuantities);
+  makeCartesianProductBenchmark<ParallelTransformReduce, AllNumericTypes,
+                                AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<ParallelInclusiveScan, AllNumericTypes,
+                                AllPolicies>(ParallelQuantities);
+  makeCartesianProductBenchmark<ParallelCopyIf, AllNumericTypes, AllPolicies>(
+      ParallelQuantities);
+  makeCartesianProductBenchmark<ParallelSort, AllValueTypes, AllPolicies>(
+      ParallelQuantities);
+  makeCartesianProductBenchmark<ParallelStableSort, AllValueTypes,
+                                AllPolicies>(ParallelQuantities);
+#endif
   benchmark::RunSpecifiedBenchmarks();
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 
 #include "benchmark/benchmark.h"
 
+#include <memory_resource>
 #include <new>
 #include <vector>
 #include <cassert>
@@ -60,6 +61,26 @@ struct BuiltinSizedNewWrapper {
   }
 };
 
+template <class Resource>
+struct MemoryResourceWrapper {
+  static Resource& Get() {
+    static Resource R;
+    return R;
+  }
+  __attribute__((always_inline))
+  static void* Allocate(size_t N) {
+    return Get().allocate(N);
+  }
+  __attribute__((always_inline))
+  static void Deallocate(void* P, size_t N) {
+    Get().deallocate(P, N);
+  }
+};
+
+using UnsynchronizedPoolWrapper = MemoryResourceWrapper<std::pmr::unsynchronized_pool_resource>;
+using SynchronizedPoolWrapper = MemoryResourceWrapper<std::pmr::synchronized_pool_resource>;
+using MonotonicBufferWrapper = MemoryResourceWrapper<std::pmr::monotonic_buffer_resource>;
+
 
 template <class AllocWrapper>
 static void BM_AllocateAndDeallocate(benchmark::State& st) {
@@ -124,6 +145,11 @@ static int RegisterAllocBenchmarks() {
       {"BM_BuiltinSizedNewDelete", BM_AllocateAndDeallocate<BuiltinSizedNewWrapper>},
       {"BM_BuiltinNewAllocateOnly", BM_AllocateOnly<BuiltinSizedNewWrapper>},
       {"BM_BuiltinNewSizedDeallocateOnly", BM_DeallocateOnly<BuiltinSizedNewWrapper>},
+      {"BM_UnsynchronizedPool", BM_AllocateAndDeallocate<UnsynchronizedPoolWrapper>},
+      {"BM_UnsynchronizedPoolAllocateOnly", BM_AllocateOnly<UnsynchronizedPoolWrapper>},
+      {"BM_SynchronizedPool", BM_AllocateAndDeallocate<SynchronizedPoolWrapper>},
+      {"BM_SynchronizedPoolAllocateOnly", BM_AllocateOnly<SynchronizedPoolWrapper>},
+      {"BM_MonotonicBufferAllocateOnly", BM_AllocateOnly<MonotonicBufferWrapper>},
 
   };
   for (auto TC : TestCases) {
@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "test_macros.h"
+
+static const std::array<int, 1000> integer_input = [] {
+  std::mt19937 generator;
+  std::uniform_int_distribution<int> distribution(-1'000'000, 1'000'000);
+  std::array<int, 1000> result;
+  std::generate_n(result.begin(), result.size(), [&] { return distribution(generator); });
+  return result;
+}();
+
+static const std::array<double, 1000> floating_point_input = [] {
+  std::mt19937 generator;
+  std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+  std::array<double, 1000> result;
+  std::generate_n(result.begin(), result.size(), [&] { return distribution(generator); });
+  return result;
+}();
+
+// A typical log line: a mix of literal text, integers, a floating-point value
+// and a string.
+static void BM_format_mixed_snprintf(benchmark::State& state) {
+  char buffer[256];
+  while (state.KeepRunningBatch(integer_input.size()))
+    for (size_t i = 0; i != integer_input.size(); ++i)
+      benchmark::DoNotOptimize(std::snprintf(buffer, sizeof(buffer), "request %d took %.3f ms [%s] %8x", integer_input[i],
+                                             floating_point_input[i], "ok", integer_input[i]));
+}
+BENCHMARK(BM_format_mixed_snprintf);
+
+static void BM_format_mixed_ostringstream(benchmark::State& state) {
+  while (state.KeepRunningBatch(integer_input.size()))
+    for (size_t i = 0; i != integer_input.size(); ++i) {
+      std::ostringstream stream;
+      stream.precision(3);
+      stream << "request " << integer_input[i] << " took " << std::fixed << floating_point_input[i] << " ms ["
+             << "ok"
+             << "] " << std::hex;
+      stream.width(8);
+      stream << integer_input[i];
+      benchmark::DoNotOptimize(stream.str());
+    }
+}
+BENCHMARK(BM_format_mixed_ostringstream);
+
+static void BM_format_mixed_format(benchmark::State& state) {
+  while (state.KeepRunningBatch(integer_input.size()))
+    for (size_t i = 0; i != integer_input.size(); ++i)
+      benchmark::DoNotOptimize(std::format("request {} took {:.3f} ms [{}] {:8x}", integer_input[i],
+                                           floating_point_input[i], "ok", integer_input[i]));
+}
+BENCHMARK(BM_format_mixed_format);
+
+static void BM_format_mixed_vformat(benchmark::State& state) {
+  std::string_view fmt = "request {} took {:.3f} ms [{}] {:8x}";
+  while (state.KeepRunningBatch(integer_input.size()))
+    for (size_t i = 0; i != integer_input.size(); ++i)
+      benchmark::DoNotOptimize(
+          std::vformat(fmt, std::make_format_args(integer_input[i], floating_point_input[i], "ok", integer_input[i])));
+}
+BENCHMARK(BM_format_mixed_vformat);
+
+static void BM_format_to_mixed(benchmark::State& state) {
+  char buffer[256];
+  while (state.KeepRunningBatch(integer_input.size()))
+    for (size_t i = 0; i != integer_input.size(); ++i)
+      benchmark::DoNotOptimize(std::format_to(buffer, "request {} took {:.3f} ms [{}] {:8x}", integer_input[i],
+                                              floating_point_input[i], "ok", integer_input[i]));
+}
+BENCHMARK(BM_format_to_mixed);
+
+static void BM_format_to_back_inserter(benchmark::State& state) {
+  std::string str;
+  while (state.KeepRunningBatch(integer_input.size()))
+    for (size_t i = 0; i != integer_input.size(); ++i) {
+      str.clear();
+      std::format_to(std::back_inserter(str), "request {} took {:.3f} ms [{}] {:8x}", integer_input[i],
+                     floating_point_input[i], "ok", integer_input[i]);
+      benchmark::DoNotOptimize(str);
+    }
+}
+BENCHMARK(BM_format_to_back_inserter);
+
+static void BM_format_integer(benchmark::State& state) {
+  while (state.KeepRunningBatch(integer_input.size()))
+    for (auto value : integer_input)
+      benchmark::DoNotOptimize(std::format("{}", value));
+}
+BENCHMARK(BM_format_integer);
+
+static void BM_format_floating_point(benchmark::State& state) {
+  while (state.KeepRunningBatch(floating_point_input.size()))
+    for (auto value : floating_point_input)
+      benchmark::DoNotOptimize(std::format("{}", value));
+}
+BENCHMARK(BM_format_floating_point);
+
+static void BM_format_string_padded(benchmark::State& state) {
+  std::string value(state.range(0), 'x');
+  while (state.KeepRunning())
+    benchmark::DoNotOptimize(std::format("{:>{}}", value, 2 * state.range(0)));
+}
+BENCHMARK(BM_format_string_padded)->RangeMultiplier(8)->Range(8, 4096);
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -7,6 +7,9 @@
 
 #include <array>
 #include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <random>
 
 #include "benchmark/benchmark.h"
@@ -49,6 +52,53 @@ static void BM_to_chars_bad(benchmark::State& state) {
 }
 BENCHMARK(BM_to_chars_bad)->DenseRange(2, 36, 1);
 
+// Random finite doubles, uniformly distributed over the bit patterns so that
+// all exponents are represented.
+static const std::array<double, 1000> floating_point_input = [] {
+  std::mt19937_64 generator;
+  std::array<double, 1000> result;
+  std::generate_n(result.begin(), result.size(), [&] {
+    for (;;) {
+      uint64_t bits = generator();
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if (std::isfinite(value))
+        return value;
+    }
+  });
+  return result;
+}();
+
+static void BM_to_chars_double_shortest(benchmark::State& state) {
+  char buffer[128];
+  while (state.KeepRunningBatch(floating_point_input.size()))
+    for (auto value : floating_point_input)
+      benchmark::DoNotOptimize(std::to_chars(buffer, &buffer[128], value));
+}
+BENCHMARK(BM_to_chars_double_shortest);
+
+static void BM_to_chars_double_scientific_precision(benchmark::State& state) {
+  char buffer[128];
+  int precision = state.range(0);
+  while (state.KeepRunningBatch(floating_point_input.size()))
+    for (auto value : floating_point_input)
+      benchmark::DoNotOptimize(std::to_chars(buffer, &buffer[128], value, std::chars_format::scientific, precision));
+}
+BENCHMARK(BM_to_chars_double_scientific_precision)->Arg(6)->Arg(17)->Arg(50);
+
+static void BM_from_chars_double(benchmark::State& state) {
+  std::array<std::array<char, 32>, 1000> strings;
+  std::array<std::size_t, 1000> sizes;
+  for (std::size_t i = 0; i != strings.size(); ++i)
+    sizes[i] = std::to_chars(strings[i].data(), strings[i].data() + strings[i].size(), floating_point_input[i]).ptr -
+               strings[i].data();
+  double value;
+  while (state.KeepRunningBatch(strings.size()))
+    for (std::size_t i = 0; i != strings.size(); ++i)
+      benchmark::DoNotOptimize(std::from_chars(strings[i].data(), strings[i].data() + sizes[i], value));
+}
+BENCHMARK(BM_from_chars_double);
+
 int main(int argc, char** argv) {
   benchmark::Initialize(&argc, argv);
   if (benchmark::ReportUnrecognizedArguments(argc, argv))
@@ -1,4 +1,5 @@
 #include <unordered_set>
+#include <ext/flat_hash_set>
 #include <vector>
 #include <functional>
 #include <cstdint>
@@ -65,6 +66,12 @@ struct UInt64Hash {
   }
 };
 
+// UInt64Hash declaring that its results are uniform over all bits, which lets
+// unordered_set keep a power of two buckets and flat_hash_set skip mixing.
+struct UInt64AvalanchingHash : UInt64Hash {
+  typedef void is_avalanching;
+};
+
 struct UInt128Hash {
   UInt128Hash() = default;
   inline TEST_ALWAYS_INLINE
@@ -266,6 +273,69 @@ BENCHMARK_CAPTURE(BM_FindRehash,
     std::unordered_set<std::string>{},
     getRandomStringInputs)->Arg(TestNumInputs);
 
+//----------------------------------------------------------------------------//
+//                 Power of two buckets and flat_hash_set
+// ---------------------------------------------------------------------------//
+
+// Random //
+BENCHMARK_CAPTURE(BM_InsertValue,
+    unordered_set_pow2_random_uint64,
+    std::unordered_set<uint64_t, UInt64AvalanchingHash>{},
+    getRandomIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+BENCHMARK_CAPTURE(BM_InsertValue,
+    flat_hash_set_random_uint64,
+    __gnu_cxx::flat_hash_set<uint64_t>{},
+    getRandomIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+BENCHMARK_CAPTURE(BM_Find,
+    unordered_set_pow2_random_uint64,
+    std::unordered_set<uint64_t, UInt64AvalanchingHash>{},
+    getRandomIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+BENCHMARK_CAPTURE(BM_Find,
+    flat_hash_set_random_uint64,
+    __gnu_cxx::flat_hash_set<uint64_t>{},
+    getRandomIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+BENCHMARK_CAPTURE(BM_FindRehash,
+    flat_hash_set_random_uint64,
+    __gnu_cxx::flat_hash_set<uint64_t, UInt64AvalanchingHash>{},
+    getRandomIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+// Sorted //
+BENCHMARK_CAPTURE(BM_Find,
+    unordered_set_pow2_sorted_uint64,
+    std::unordered_set<uint64_t, UInt64AvalanchingHash>{},
+    getSortedIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+BENCHMARK_CAPTURE(BM_Find,
+    flat_hash_set_sorted_uint64,
+    __gnu_cxx::flat_hash_set<uint64_t>{},
+    getSortedIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+// Top Bits //
+BENCHMARK_CAPTURE(BM_Find,
+    unordered_set_pow2_top_bits_uint64,
+    std::unordered_set<uint64_t, UInt64AvalanchingHash>{},
+    getSortedTopBitsIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+BENCHMARK_CAPTURE(BM_Find,
+    flat_hash_set_top_bits_uint64,
+    __gnu_cxx::flat_hash_set<uint64_t>{},
+    getSortedTopBitsIntegerInputs<uint64_t>)->Arg(TestNumInputs);
+
+// String //
+BENCHMARK_CAPTURE(BM_InsertValue,
+    flat_hash_set_string,
+    __gnu_cxx::flat_hash_set<std::string>{},
+    getRandomStringInputs)->Arg(TestNumInputs);
+
+BENCHMARK_CAPTURE(BM_Find,
+    flat_hash_set_string,
+    __gnu_cxx::flat_hash_set<std::string>{},
+    getRandomStringInputs)->Arg(TestNumInputs);
+
 ///////////////////////////////////////////////////////////////////////////////
 BENCHMARK_CAPTURE(BM_InsertDuplicate,
     unordered_set_int,
@@ -0,0 +1,307 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_BUFFER_H
+#define _LIBCPP___FORMAT_BUFFER_H
+
+#include <__config>
+#include <__iterator/concepts.h>
+#include <__iterator/readable_traits.h>
+#include <__memory/pointer_traits.h>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+namespace __format {
+
+// The size of the arrays that collect output before it is handed to an
+// output iterator. Large enough for most formatted strings, small enough to
+// live on the stack.
+inline constexpr size_t __buffer_size = 256;
+
+// The buffer all formatting functions write to.
+//
+// The output is written to [__ptr_, __ptr_ + __capacity_); when that is full
+// __flush_ passes it on to its final destination and the buffer is reused.
+// The iterator of the standard format contexts is a back_insert_iterator of
+// this buffer. The formatters of the library recognize that iterator and
+// write whole runs of characters through __copy and __fill, so the common
+// path does not go through push_back for every character.
+//
+// There is always room for at least one character, since the buffer is
+// flushed as soon as it becomes full.
+template <class _CharT>
+class _LIBCPP_TEMPLATE_VIS __output_buffer {
+public:
+  using value_type = _CharT;
+  using __flush_fn = void (*)(const _CharT*, size_t, void*);
+
+  _LIBCPP_HIDE_FROM_ABI explicit __output_buffer(_CharT* __ptr, size_t __capacity,
+                                                 __flush_fn __flush, void* __obj) noexcept
+      : __ptr_(__ptr), __capacity_(__capacity), __flush_(__flush), __obj_(__obj) {}
+
+  __output_buffer(const __output_buffer&) = delete;
+  __output_buffer& operator=(const __output_buffer&) = delete;
+
+  _LIBCPP_HIDE_FROM_ABI void push_back(_CharT __c) {
+    __ptr_[__size_++] = __c;
+    if (__size_ == __capacity_)
+      __flush();
+  }
+
+  // Appends [__first, __first + __n), converting char to _CharT when needed.
+  template <class _InCharT>
+  _LIBCPP_HIDE_FROM_ABI void __copy(const _InCharT* __first, size_t __n) {
+    while (__n) {
+      size_t __chunk = _VSTD::min(__n, __capacity_ - __size_);
+      _VSTD::copy_n(__first, __chunk, __ptr_ + __size_);
+      __size_ += __chunk;
+      __first += __chunk;
+      __n -= __chunk;
+      if (__size_ == __capacity_)
+        __flush();
+    }
+  }
+
+  // Like __copy, but applies __op to every character.
+  template <class _InCharT, class _UnaryOperation>
+  _LIBCPP_HIDE_FROM_ABI void __transform(const _InCharT* __first, size_t __n, _UnaryOperation __op) {
+    while (__n) {
+      size_t __chunk = _VSTD::min(__n, __capacity_ - __size_);
+      _VSTD::transform(__first, __first + __chunk, __ptr_ + __size_, __op);
+      __size_ += __chunk;
+      __first += __chunk;
+      __n -= __chunk;
+      if (__size_ == __capacity_)
+        __flush();
+    }
+  }
+
+  _LIBCPP_HIDE_FROM_ABI void __fill(size_t __n, _CharT __c) {
+    while (__n) {
+      size_t __chunk = _VSTD::min(__n, __capacity_ - __size_);
+      _VSTD::fill_n(__ptr_ + __size_, __chunk, __c);
+      __size_ += __chunk;
+      __n -= __chunk;
+      if (__size_ == __capacity_)
+        __flush();
+    }
+  }
+
+  _LIBCPP_HIDE_FROM_ABI void __flush() {
+    __flush_(__ptr_, __size_, __obj_);
+    __size_ = 0;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI size_t __size() const noexcept { return __size_; }
+
+private:
+  _CharT* __ptr_;
+  size_t __capacity_;
+  size_t __size_ = 0;
+  __flush_fn __flush_;
+  void* __obj_;
+};
+
+template <class _CharT>
+using __output_iterator = back_insert_iterator<__output_buffer<_CharT>>;
+
+template <class _Container, class _CharT>
+concept __insertable =
+    same_as<typename _Container::value_type, _CharT> &&
+    requires(_Container& __t, const _CharT* __first, const _CharT* __last) {
+      __t.insert(__t.end(), __first, __last);
+    };
+
+template <class _OutIt, class _CharT>
+struct __is_back_insert_iterator_of_insertable : false_type {};
+
+template <class _Container, class _CharT>
+  requires __insertable<_Container, _CharT>
+struct __is_back_insert_iterator_of_insertable<back_insert_iterator<_Container>, _CharT> : true_type {};
+
+// Copies [__first, __first + __n) to __out_it, as one operation when the
+// destination allows it.
+template <class _CharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __copy_to(const _CharT* __first, size_t __n, _OutIt __out_it) {
+  if constexpr (is_same_v<_OutIt, __output_iterator<_CharT>>) {
+    __out_it.__get_container()->__copy(__first, __n);
+    return __out_it;
+  } else if constexpr (__is_back_insert_iterator_of_insertable<_OutIt, _CharT>::value) {
+    auto* __c = __out_it.__get_container();
+    __c->insert(__c->end(), __first, __first + __n);
+    return __out_it;
+  } else
+    return _VSTD::copy_n(__first, __n, _VSTD::move(__out_it));
+}
+
+// Output that can be written to directly: a contiguous range of _CharT.
+template <class _OutIt, class _CharT>
+concept __contiguous_output =
+    contiguous_iterator<_OutIt> && same_as<iter_value_t<_OutIt>, _CharT>;
+
+// Writes straight to the caller's contiguous output. Since the output is
+// unbounded the buffer never fills up.
+template <class _CharT>
+class _LIBCPP_TEMPLATE_VIS __direct_storage {
+public:
+  _LIBCPP_HIDE_FROM_ABI explicit __direct_storage(_CharT* __out) noexcept
+      : __output_(__out, numeric_limits<size_t>::max(), __flush, nullptr) {}
+
+  _LIBCPP_HIDE_FROM_ABI __output_buffer<_CharT>& __buffer() noexcept { return __output_; }
+  _LIBCPP_HIDE_FROM_ABI size_t __size() const noexcept { return __output_.__size(); }
+
+private:
+  _LIBCPP_HIDE_FROM_ABI static void __flush(const _CharT*, size_t, void*) noexcept {}
+
+  __output_buffer<_CharT> __output_;
+};
+
+// Collects the output in a local array and passes it on to an output
+// iterator every time the array is full.
+template <class _OutIt, class _CharT>
+class _LIBCPP_TEMPLATE_VIS __iterator_storage {
+public:
+  _LIBCPP_HIDE_FROM_ABI explicit __iterator_storage(_OutIt __out_it)
+      : __output_(__array_, __buffer_size, __flush, this), __out_it_(_VSTD::move(__out_it)) {}
+
+  _LIBCPP_HIDE_FROM_ABI __output_buffer<_CharT>& __buffer() noexcept { return __output_; }
+
+  _LIBCPP_HIDE_FROM_ABI _OutIt __out_it() && {
+    __output_.__flush();
+    return _VSTD::move(__out_it_);
+  }
+
+private:
+  _LIBCPP_HIDE_FROM_ABI static void __flush(const _CharT* __ptr, size_t __n, void* __obj) {
+    auto* __self = static_cast<__iterator_storage*>(__obj);
+    __self->__out_it_ = __format::__copy_to(__ptr, __n, _VSTD::move(__self->__out_it_));
+  }
+
+  _CharT __array_[__buffer_size];
+  __output_buffer<_CharT> __output_;
+  _OutIt __out_it_;
+};
+
+// Collects the output of format and vformat. Output that fits in the local
+// array is copied into the result string with a single allocation.
+template <class _CharT>
+class _LIBCPP_TEMPLATE_VIS __string_storage {
+public:
+  _LIBCPP_HIDE_FROM_ABI __string_storage() noexcept
+      : __output_(__array_, __buffer_size, __flush, this) {}
+
+  _LIBCPP_HIDE_FROM_ABI __output_buffer<_CharT>& __buffer() noexcept { return __output_; }
+
+  _LIBCPP_HIDE_FROM_ABI basic_string<_CharT> __result() && {
+    if (__str_.empty())
+      return basic_string<_CharT>(__array_, __output_.__size());
+    __str_.append(__array_, __output_.__size());
+    return _VSTD::move(__str_);
+  }
+
+private:
+  _LIBCPP_HIDE_FROM_ABI static void __flush(const _CharT* __ptr, size_t __n, void* __obj) {
+    static_cast<__string_storage*>(__obj)->__str_.append(__ptr, __n);
+  }
+
+  _CharT __array_[__buffer_size];
+  __output_buffer<_CharT> __output_;
+  basic_string<_CharT> __str_;
+};
+
+// Counts the output of formatted_size.
+template <class _CharT>
+class _LIBCPP_TEMPLATE_VIS __counting_storage {
+public:
+  _LIBCPP_HIDE_FROM_ABI __counting_storage() noexcept
+      : __output_(__array_, __buffer_size, __flush, this) {}
+
+  _LIBCPP_HIDE_FROM_ABI __output_buffer<_CharT>& __buffer() noexcept { return __output_; }
+
+  _LIBCPP_HIDE_FROM_ABI size_t __result() && {
+    __output_.__flush();
+    return __size_;
+  }
+
+private:
+  _LIBCPP_HIDE_FROM_ABI static void __flush(const _CharT*, size_t __n, void* __obj) noexcept {
+    static_cast<__counting_storage*>(__obj)->__size_ += __n;
+  }
+
+  _CharT __array_[__buffer_size];
+  __output_buffer<_CharT> __output_;
+  size_t __size_ = 0;
+};
+
+// Passes at most __n characters of the output of format_to_n on to an output
+// iterator and counts the rest.
+template <class _OutIt, class _CharT>
+class _LIBCPP_TEMPLATE_VIS __format_to_n_storage {
+public:
+  _LIBCPP_HIDE_FROM_ABI explicit __format_to_n_storage(_OutIt __out_it, size_t __n)
+      : __output_(__array_, __buffer_size, __flush, this), __out_it_(_VSTD::move(__out_it)), __max_size_(__n) {}
+
+  _LIBCPP_HIDE_FROM_ABI __output_buffer<_CharT>& __buffer() noexcept { return __output_; }
+
+  _LIBCPP_HIDE_FROM_ABI _OutIt __out_it() && {
+    __output_.__flush();
+    return _VSTD::move(__out_it_);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI size_t __size() const noexcept { return __size_; }
+
+private:
+  _LIBCPP_HIDE_FROM_ABI static void __flush(const _CharT* __ptr, size_t __n, void* __obj) {
+    auto* __self = static_cast<__format_to_n_storage*>(__obj);
+    if (__self->__size_ < __self->__max_size_) {
+      size_t __m = _VSTD::min(__n, __self->__max_size_ - __self->__size_);
+      __self->__out_it_ = __format::__copy_to(__ptr, __m, _VSTD::move(__self->__out_it_));
+    }
+    __self->__size_ += __n;
+  }
+
+  _CharT __array_[__buffer_size];
+  __output_buffer<_CharT> __output_;
+  _OutIt __out_it_;
+  size_t __max_size_;
+  size_t __size_ = 0;
+};
+
+} // namespace __format
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_BUFFER_H
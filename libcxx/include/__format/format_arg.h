@@ -0,0 +1,352 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_FORMAT_ARG_H
+#define _LIBCPP___FORMAT_FORMAT_ARG_H
+
+#include <__config>
+#include <__format/format_error.h>
+#include <__format/format_fwd.h>
+#include <__format/format_parse_context.h>
+#include <__functional_base>
+#include <__memory/addressof.h>
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+namespace __format {
+/// The type stored in a basic_format_arg.
+///
+/// The 128-bit types are unconditionally in the list, so that the values of
+/// the enumerators do not depend on the platform.
+enum class _LIBCPP_ENUM_VIS __arg_t : uint8_t {
+  __none,
+  __boolean,
+  __char_type,
+  __int,
+  __long_long,
+  __i128,
+  __unsigned,
+  __unsigned_long_long,
+  __u128,
+  __float,
+  __double,
+  __long_double,
+  __const_char_type_ptr,
+  __string_view,
+  __ptr,
+  __handle
+};
+
+template <class _Tp, class _CharT>
+struct __is_basic_string_of : false_type {};
+template <class _CharT, class _Traits>
+struct __is_basic_string_of<basic_string_view<_CharT, _Traits>, _CharT> : true_type {};
+template <class _CharT, class _Traits, class _Allocator>
+struct __is_basic_string_of<basic_string<_CharT, _Traits, _Allocator>, _CharT> : true_type {};
+
+/// Determines how a value of type _Tp is stored in a basic_format_arg<_Context>,
+/// see [format.arg]/5 and /6.
+template <class _Context, class _Tp>
+_LIBCPP_HIDE_FROM_ABI consteval __arg_t __determine_arg_t() {
+  using _Dp = remove_cvref_t<_Tp>;
+  using _CharT = typename _Context::char_type;
+  if constexpr (same_as<_Dp, bool>)
+    return __arg_t::__boolean;
+  else if constexpr (same_as<_Dp, _CharT>)
+    return __arg_t::__char_type;
+  else if constexpr (same_as<_Dp, char> && same_as<_CharT, wchar_t>)
+    return __arg_t::__char_type;
+  else if constexpr (__libcpp_is_signed_integer<_Dp>::value) {
+    if constexpr (sizeof(_Dp) <= sizeof(int))
+      return __arg_t::__int;
+    else if constexpr (sizeof(_Dp) <= sizeof(long long))
+      return __arg_t::__long_long;
+    else
+      return __arg_t::__i128;
+  } else if constexpr (__libcpp_is_unsigned_integer<_Dp>::value) {
+    if constexpr (sizeof(_Dp) <= sizeof(unsigned))
+      return __arg_t::__unsigned;
+    else if constexpr (sizeof(_Dp) <= sizeof(unsigned long long))
+      return __arg_t::__unsigned_long_long;
+    else
+      return __arg_t::__u128;
+  } else if constexpr (same_as<_Dp, float>)
+    return __arg_t::__float;
+  else if constexpr (same_as<_Dp, double>)
+    return __arg_t::__double;
+  else if constexpr (same_as<_Dp, long double>)
+    return __arg_t::__long_double;
+  else if constexpr (same_as<_Dp, _CharT*> || same_as<_Dp, const _CharT*>)
+    return __arg_t::__const_char_type_ptr;
+  else if constexpr (is_array_v<_Dp> && same_as<remove_extent_t<_Dp>, _CharT>)
+    return __arg_t::__const_char_type_ptr;
+  else if constexpr (__is_basic_string_of<_Dp, _CharT>::value)
+    return __arg_t::__string_view;
+  else if constexpr (same_as<_Dp, nullptr_t> || same_as<_Dp, void*> || same_as<_Dp, const void*>)
+    return __arg_t::__ptr;
+  else
+    return __arg_t::__handle;
+}
+
+/// Whether the arguments of type __arg are formatted by the formatters of the
+/// library. Only those are handled by the precompiled format strings.
+_LIBCPP_HIDE_FROM_ABI constexpr bool __is_builtin(__arg_t __arg) noexcept {
+  return __arg != __arg_t::__none && __arg != __arg_t::__handle;
+}
+
+_LIBCPP_HIDE_FROM_ABI constexpr bool __is_integral(__arg_t __arg) noexcept {
+  switch (__arg) {
+  case __arg_t::__int:
+  case __arg_t::__long_long:
+  case __arg_t::__i128:
+  case __arg_t::__unsigned:
+  case __arg_t::__unsigned_long_long:
+  case __arg_t::__u128:
+    return true;
+  default:
+    return false;
+  }
+}
+
+template <class _Context>
+class __basic_format_arg_value {
+  using _CharT = typename _Context::char_type;
+
+public:
+  /// Contains the implementation of basic_format_arg::handle.
+  struct __handle {
+    template <class _Tp>
+    _LIBCPP_HIDE_FROM_ABI explicit __handle(const _Tp& __v) noexcept
+        : __ptr_(_VSTD::addressof(__v)),
+          __format_([](basic_format_parse_context<_CharT>& __parse_ctx, _Context& __ctx, const void* __ptr) {
+            typename _Context::template formatter_type<_Tp> __f;
+            __parse_ctx.advance_to(__f.parse(__parse_ctx));
+            __ctx.advance_to(__f.format(*static_cast<const _Tp*>(__ptr), __ctx));
+          }) {}
+
+    const void* __ptr_;
+    void (*__format_)(basic_format_parse_context<_CharT>&, _Context&, const void*);
+  };
+
+  union {
+    monostate __monostate_;
+    bool __boolean_;
+    _CharT __char_type_;
+    int __int_;
+    unsigned __unsigned_;
+    long long __long_long_;
+    unsigned long long __unsigned_long_long_;
+#ifndef _LIBCPP_HAS_NO_INT128
+    __int128_t __i128_;
+    __uint128_t __u128_;
+#endif
+    float __float_;
+    double __double_;
+    long double __long_double_;
+    const _CharT* __const_char_type_ptr_;
+    basic_string_view<_CharT> __string_view_;
+    const void* __ptr_;
+    __handle __handle_;
+  };
+
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value() noexcept : __monostate_() {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(bool __value) noexcept : __boolean_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(_CharT __value) noexcept : __char_type_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(int __value) noexcept : __int_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(unsigned __value) noexcept : __unsigned_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(long long __value) noexcept : __long_long_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(unsigned long long __value) noexcept
+      : __unsigned_long_long_(__value) {}
+#ifndef _LIBCPP_HAS_NO_INT128
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(__int128_t __value) noexcept : __i128_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(__uint128_t __value) noexcept : __u128_(__value) {}
+#endif
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(float __value) noexcept : __float_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(double __value) noexcept : __double_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(long double __value) noexcept : __long_double_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(const _CharT* __value) noexcept
+      : __const_char_type_ptr_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(basic_string_view<_CharT> __value) noexcept
+      : __string_view_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(const void* __value) noexcept : __ptr_(__value) {}
+  _LIBCPP_HIDE_FROM_ABI __basic_format_arg_value(__handle __value) noexcept : __handle_(__value) {}
+};
+
+} // namespace __format
+
+template <class _Context>
+class _LIBCPP_TEMPLATE_VIS basic_format_arg {
+public:
+  class _LIBCPP_TEMPLATE_VIS handle;
+
+  _LIBCPP_HIDE_FROM_ABI basic_format_arg() noexcept : __type_{__format::__arg_t::__none} {}
+
+  _LIBCPP_HIDE_FROM_ABI explicit operator bool() const noexcept {
+    return __type_ != __format::__arg_t::__none;
+  }
+
+  _LIBCPP_HIDE_FROM_ABI explicit basic_format_arg(__format::__arg_t __type,
+                                                  __format::__basic_format_arg_value<_Context> __value) noexcept
+      : __value_(__value), __type_(__type) {}
+
+  // These members are implementation details; they are public so that the
+  // formatting functions can dispatch on the stored type directly.
+  __format::__basic_format_arg_value<_Context> __value_;
+  __format::__arg_t __type_;
+};
+
+template <class _Context>
+class _LIBCPP_TEMPLATE_VIS basic_format_arg<_Context>::handle {
+public:
+  _LIBCPP_HIDE_FROM_ABI void format(basic_format_parse_context<typename _Context::char_type>& __parse_ctx,
+                                    _Context& __ctx) const {
+    __handle_.__format_(__parse_ctx, __ctx, __handle_.__ptr_);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI explicit handle(typename __format::__basic_format_arg_value<_Context>::__handle __handle) noexcept
+      : __handle_(__handle) {}
+
+private:
+  typename __format::__basic_format_arg_value<_Context>::__handle __handle_;
+};
+
+template <class _Visitor, class _Context>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_AVAILABILITY_FORMAT decltype(auto)
+visit_format_arg(_Visitor&& __vis, basic_format_arg<_Context> __arg) {
+  switch (__arg.__type_) {
+  case __format::__arg_t::__none:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), monostate{});
+  case __format::__arg_t::__boolean:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__boolean_);
+  case __format::__arg_t::__char_type:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__char_type_);
+  case __format::__arg_t::__int:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__int_);
+  case __format::__arg_t::__long_long:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__long_long_);
+#ifndef _LIBCPP_HAS_NO_INT128
+  // The 128-bit integers are not in the list of [format.arg]/1, so they are
+  // passed to the visitor as a handle.
+  case __format::__arg_t::__i128: {
+    typename __format::__basic_format_arg_value<_Context>::__handle __h{__arg.__value_.__i128_};
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), typename basic_format_arg<_Context>::handle{__h});
+  }
+  case __format::__arg_t::__u128: {
+    typename __format::__basic_format_arg_value<_Context>::__handle __h{__arg.__value_.__u128_};
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), typename basic_format_arg<_Context>::handle{__h});
+  }
+#endif
+  case __format::__arg_t::__unsigned:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__unsigned_);
+  case __format::__arg_t::__unsigned_long_long:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__unsigned_long_long_);
+  case __format::__arg_t::__float:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__float_);
+  case __format::__arg_t::__double:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__double_);
+  case __format::__arg_t::__long_double:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__long_double_);
+  case __format::__arg_t::__const_char_type_ptr:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__const_char_type_ptr_);
+  case __format::__arg_t::__string_view:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__string_view_);
+  case __format::__arg_t::__ptr:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__ptr_);
+  case __format::__arg_t::__handle:
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis),
+                         typename basic_format_arg<_Context>::handle{__arg.__value_.__handle_});
+  default:
+    break;
+  }
+  _LIBCPP_UNREACHABLE();
+}
+
+namespace __format {
+
+/// Like visit_format_arg, but passes the 128-bit integers by value. Used by
+/// the formatters of the library, which handle them natively.
+template <class _Visitor, class _Context>
+_LIBCPP_HIDE_FROM_ABI decltype(auto) __visit_format_arg(_Visitor&& __vis, basic_format_arg<_Context> __arg) {
+#ifndef _LIBCPP_HAS_NO_INT128
+  if (__arg.__type_ == __arg_t::__i128)
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__i128_);
+  if (__arg.__type_ == __arg_t::__u128)
+    return _VSTD::invoke(_VSTD::forward<_Visitor>(__vis), __arg.__value_.__u128_);
+#endif
+  return _VSTD::visit_format_arg(_VSTD::forward<_Visitor>(__vis), __arg);
+}
+
+template <class _Tp, class _CharT>
+concept __formattable = semiregular<formatter<remove_cvref_t<_Tp>, _CharT>>;
+
+/// Creates the basic_format_arg that stores __value, see [format.arg]/5.
+template <class _Context, class _Tp>
+_LIBCPP_HIDE_FROM_ABI basic_format_arg<_Context> __create_format_arg(_Tp& __value) noexcept {
+  constexpr __arg_t __arg = __determine_arg_t<_Context, _Tp>();
+  using _Dp = remove_cvref_t<_Tp>;
+  using _CharT = typename _Context::char_type;
+  static_assert(__arg != __arg_t::__handle || __formattable<_Dp, _CharT>,
+                "The argument type has no enabled formatter");
+
+  if constexpr (__arg == __arg_t::__char_type)
+    return basic_format_arg<_Context>{__arg, static_cast<_CharT>(__value)};
+  else if constexpr (__arg == __arg_t::__int)
+    return basic_format_arg<_Context>{__arg, static_cast<int>(__value)};
+  else if constexpr (__arg == __arg_t::__long_long)
+    return basic_format_arg<_Context>{__arg, static_cast<long long>(__value)};
+  else if constexpr (__arg == __arg_t::__unsigned)
+    return basic_format_arg<_Context>{__arg, static_cast<unsigned>(__value)};
+  else if constexpr (__arg == __arg_t::__unsigned_long_long)
+    return basic_format_arg<_Context>{__arg, static_cast<unsigned long long>(__value)};
+  else if constexpr (__arg == __arg_t::__const_char_type_ptr)
+    return basic_format_arg<_Context>{__arg, static_cast<const _CharT*>(__value)};
+  else if constexpr (__arg == __arg_t::__string_view)
+    return basic_format_arg<_Context>{__arg, basic_string_view<_CharT>{__value.data(), __value.size()}};
+  else if constexpr (__arg == __arg_t::__ptr)
+    return basic_format_arg<_Context>{__arg, static_cast<const void*>(__value)};
+  else if constexpr (__arg == __arg_t::__handle)
+    return basic_format_arg<_Context>{
+        __arg, typename __basic_format_arg_value<_Context>::__handle{static_cast<const _Dp&>(__value)}};
+  else
+    return basic_format_arg<_Context>{__arg, __value};
+}
+
+} // namespace __format
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_FORMAT_ARG_H
@@ -0,0 +1,418 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_FORMAT_STRING_H
+#define _LIBCPP___FORMAT_FORMAT_STRING_H
+
+#include <__availability>
+#include <__config>
+#include <__format/format_arg.h>
+#include <__format/format_context.h>
+#include <__format/format_error.h>
+#include <__format/format_fwd.h>
+#include <__format/format_parse_context.h>
+#include <__format/formatter.h>
+#include <__format/formatter_floating_point.h>
+#include <__format/formatter_integral.h>
+#include <__format/formatter_string.h>
+#include <__format/parser_std_format_spec.h>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+namespace __format {
+
+/// A replacement field of a format string checked at compile time, together
+/// with the literal text before it.
+///
+/// The literal text is stored as offsets in the format string.
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS __field {
+  uint32_t __literal_begin_ = 0;
+  uint32_t __literal_end_ = 0;
+  /// Whether the literal text contains the escape sequences {{ or }}.
+  bool __literal_escaped_ = false;
+  uint32_t __arg_id_ = 0;
+  __format_spec::__parsed_specifications<_CharT> __spec_;
+};
+
+/// The result of parsing a format string at compile time.
+///
+/// When all replacement fields format arguments of the types handled by the
+/// library, the fields store their parsed std-format-spec and formatting
+/// them at run time involves no parsing at all. Otherwise the format string
+/// has only been validated and is parsed again at run time.
+template <class _CharT, size_t _Np>
+struct _LIBCPP_TEMPLATE_VIS __compiled_format {
+  /// The value of __size_ when the format string is parsed at run time.
+  static constexpr uint32_t __runtime = UINT32_MAX;
+
+  /// A field per argument suffices for most format strings; when there are
+  /// more, the format string is parsed at run time.
+  __field<_CharT> __fields_[_Np ? _Np : 1] = {};
+  uint32_t __size_ = 0;
+  /// The literal text after the last field ends at the end of the string.
+  uint32_t __tail_begin_ = 0;
+  bool __tail_escaped_ = false;
+
+  _LIBCPP_HIDE_FROM_ABI constexpr bool __is_runtime() const noexcept { return __size_ == __runtime; }
+};
+
+/// The context used to determine the types of the arguments at compile time.
+///
+/// [format.arg]/6 only depends on the character type of the context.
+template <class _CharT>
+using __compile_time_context = basic_format_context<__output_iterator<_CharT>, _CharT>;
+
+/// Validates the std-format-spec of a replacement field for an argument of a
+/// type without a formatter of the library, by using its formatter.
+template <class _CharT, class _Tp>
+_LIBCPP_HIDE_FROM_ABI constexpr typename basic_format_parse_context<_CharT>::iterator
+__compile_time_parse(basic_format_parse_context<_CharT>& __ctx) {
+  if constexpr (__format::__is_builtin(__determine_arg_t<__compile_time_context<_CharT>, _Tp>()))
+    // Not used; the library parses these itself.
+    return __ctx.begin();
+  else {
+    formatter<remove_cvref_t<_Tp>, _CharT> __f;
+    return __f.parse(__ctx);
+  }
+}
+
+/// Parses the format string __fmt for the arguments _Args.
+///
+/// Errors in the format string are reported by throwing format_error, which
+/// makes the evaluation of the consteval constructor of basic_format_string
+/// ill-formed.
+template <class _CharT, class... _Args>
+_LIBCPP_HIDE_FROM_ABI consteval __compiled_format<_CharT, sizeof...(_Args)>
+__compile(basic_string_view<_CharT> __fmt) {
+  using _Context = __compile_time_context<_CharT>;
+  using _Iterator = typename basic_format_parse_context<_CharT>::iterator;
+  constexpr size_t __num_args = sizeof...(_Args);
+  constexpr __arg_t __types[__num_args ? __num_args : 1] = {__determine_arg_t<_Context, _Args>()...};
+  using __parse_fn = _Iterator (*)(basic_format_parse_context<_CharT>&);
+  constexpr __parse_fn __parsers[__num_args ? __num_args : 1] = {__compile_time_parse<_CharT, _Args>...};
+
+  __compiled_format<_CharT, __num_args> __result;
+  bool __runtime = false;
+  basic_format_parse_context<_CharT> __ctx(__fmt, __num_args);
+  const _Iterator __first = __fmt.begin();
+  const _Iterator __last = __fmt.end();
+  _Iterator __begin = __first;
+  uint32_t __literal_begin = 0;
+  bool __escaped = false;
+  while (__begin != __last) {
+    if (*__begin == _CharT('}')) {
+      ++__begin;
+      if (__begin == __last || *__begin != _CharT('}'))
+        __throw_format_error("The format string contains an invalid escape sequence");
+      ++__begin;
+      __escaped = true;
+      continue;
+    }
+    if (*__begin != _CharT('{')) {
+      ++__begin;
+      continue;
+    }
+
+    uint32_t __literal_end = static_cast<uint32_t>(__begin - __first);
+    ++__begin;
+    if (__begin == __last)
+      __throw_format_error("The format string terminates at a '{'");
+    if (*__begin == _CharT('{')) {
+      ++__begin;
+      __escaped = true;
+      continue;
+    }
+
+    __field<_CharT> __f;
+    __begin = __format::__parse_arg_id(__begin, __last, __ctx, __f.__arg_id_);
+    if (__begin == __last)
+      __throw_format_error("The replacement field misses a terminating '}'");
+    if (*__begin == _CharT(':'))
+      ++__begin;
+    else if (*__begin != _CharT('}'))
+      __throw_format_error("The replacement field arg-id should terminate at a ':' or '}'");
+
+    // Automatic numbering is not checked by the parse context.
+    auto __check_arg_id = [](uint32_t __id) {
+      if (__id >= __num_args)
+        __throw_format_error("Argument index out of bounds");
+    };
+    __check_arg_id(__f.__arg_id_);
+    __ctx.advance_to(__begin);
+    const __arg_t __type = __types[__f.__arg_id_];
+    if (__format::__is_builtin(__type)) {
+      __begin = __format_spec::__parse(__ctx, __format_spec::__category_of(__type), __f.__spec_);
+      // [format.string.std]/7 and /9: a nested replacement field refers to
+      // an argument of an integral type.
+      if (__f.__spec_.__width_as_arg_) {
+        __check_arg_id(__f.__spec_.__width_);
+        if (!__format::__is_integral(__types[__f.__spec_.__width_]))
+          __throw_format_error("A format-spec width field replacement should have an integral type");
+      }
+      if (__f.__spec_.__precision_as_arg_) {
+        __check_arg_id(static_cast<uint32_t>(__f.__spec_.__precision_));
+        if (!__format::__is_integral(__types[__f.__spec_.__precision_]))
+          __throw_format_error("A format-spec precision field replacement should have an integral type");
+      }
+    } else {
+      __begin = __parsers[__f.__arg_id_](__ctx);
+      __runtime = true;
+    }
+    if (__begin == __last || *__begin != _CharT('}'))
+      __throw_format_error("The replacement field misses a terminating '}'");
+    ++__begin;
+
+    if (__result.__size_ == __num_args)
+      __runtime = true;
+    else if (!__runtime) {
+      __f.__literal_begin_ = __literal_begin;
+      __f.__literal_end_ = __literal_end;
+      __f.__literal_escaped_ = __escaped;
+      __result.__fields_[__result.__size_++] = __f;
+    }
+    __literal_begin = static_cast<uint32_t>(__begin - __first);
+    __escaped = false;
+  }
+
+  if (__runtime)
+    __result.__size_ = __result.__runtime;
+  __result.__tail_begin_ = __literal_begin;
+  __result.__tail_escaped_ = __escaped;
+  return __result;
+}
+
+/// Writes the literal text [__first, __last), which contains no replacement
+/// fields, replacing the escape sequences {{ and }} when __escaped.
+template <class _CharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __write_literal(const _CharT* __first, const _CharT* __last, bool __escaped,
+                                             _OutIt __out_it) {
+  if (!__escaped)
+    return __formatter::__copy<_CharT>(__first, static_cast<size_t>(__last - __first), _VSTD::move(__out_it));
+
+  while (__first != __last) {
+    const _CharT* __p = __first;
+    while (__p != __last && *__p != _CharT('{') && *__p != _CharT('}'))
+      ++__p;
+    if (__p != __last)
+      ++__p; // Keeps the first character of the escape sequence.
+    __out_it = __formatter::__copy<_CharT>(__first, static_cast<size_t>(__p - __first), _VSTD::move(__out_it));
+    __first = __p == __last ? __p : __p + 1;
+  }
+  return __out_it;
+}
+
+/// Formats __arg, whose type is handled by the library, using __spec, whose
+/// arg-ids are substituted.
+///
+/// This function and the __vformat_to overloads are only _LIBCPP_HIDDEN:
+/// _LIBCPP_HIDE_FROM_ABI implies always_inline on compilers without
+/// exclude_from_explicit_instantiation, which would inline every formatter
+/// into every call of format. These templates are never instantiated in the
+/// dylib, so they need no protection from explicit instantiations.
+template <class _Context>
+_LIBCPP_HIDDEN typename _Context::iterator
+__format_builtin(basic_format_arg<_Context> __arg, _Context& __ctx,
+                 const __format_spec::__parsed_specifications<typename _Context::char_type>& __spec) {
+  using _CharT = typename _Context::char_type;
+  switch (__arg.__type_) {
+  case __arg_t::__boolean:
+    return __formatter::__format_bool(__arg.__value_.__boolean_, __ctx, __spec);
+  case __arg_t::__char_type:
+    if (__spec.__type_ == __format_spec::__type::__default || __spec.__type_ == __format_spec::__type::__char)
+      return __formatter::__format_char(__arg.__value_.__char_type_, __ctx, __spec);
+    return __formatter::__format_integer(static_cast<make_unsigned_t<_CharT>>(__arg.__value_.__char_type_), __ctx,
+                                         __spec);
+  case __arg_t::__int:
+    return __formatter::__format_integer(__arg.__value_.__int_, __ctx, __spec);
+  case __arg_t::__long_long:
+    return __formatter::__format_integer(__arg.__value_.__long_long_, __ctx, __spec);
+  case __arg_t::__unsigned:
+    return __formatter::__format_integer(__arg.__value_.__unsigned_, __ctx, __spec);
+  case __arg_t::__unsigned_long_long:
+    return __formatter::__format_integer(__arg.__value_.__unsigned_long_long_, __ctx, __spec);
+#ifndef _LIBCPP_HAS_NO_INT128
+  case __arg_t::__i128:
+    return __formatter::__format_integer(__arg.__value_.__i128_, __ctx, __spec);
+  case __arg_t::__u128:
+    return __formatter::__format_integer(__arg.__value_.__u128_, __ctx, __spec);
+#endif
+  case __arg_t::__float:
+    return __formatter::__format_floating_point(__arg.__value_.__float_, __ctx, __spec);
+  case __arg_t::__double:
+    return __formatter::__format_floating_point(__arg.__value_.__double_, __ctx, __spec);
+  case __arg_t::__long_double:
+    return __formatter::__format_floating_point(__arg.__value_.__long_double_, __ctx, __spec);
+  case __arg_t::__const_char_type_ptr: {
+    const _CharT* __str = __arg.__value_.__const_char_type_ptr_;
+    return __formatter::__write_string(__str, __str + char_traits<_CharT>::length(__str), __ctx.out(), __spec);
+  }
+  case __arg_t::__string_view: {
+    basic_string_view<_CharT> __str = __arg.__value_.__string_view_;
+    return __formatter::__write_string(__str.data(), __str.data() + __str.size(), __ctx.out(), __spec);
+  }
+  case __arg_t::__ptr:
+    return __formatter::__format_pointer(__arg.__value_.__ptr_, __ctx, __spec);
+  default:
+    break;
+  }
+  _LIBCPP_UNREACHABLE();
+}
+
+/// Formats the arguments of __ctx as described by the format string of
+/// __parse_ctx, parsing it at run time.
+template <class _CharT, class _Context>
+_LIBCPP_HIDDEN typename _Context::iterator __vformat_to(basic_format_parse_context<_CharT>&& __parse_ctx,
+                                                        _Context& __ctx) {
+  auto __begin = __parse_ctx.begin();
+  auto __end = __parse_ctx.end();
+  while (__begin != __end) {
+    auto __p = __begin;
+    while (__p != __end && *__p != _CharT('{') && *__p != _CharT('}'))
+      ++__p;
+    __ctx.advance_to(__formatter::__copy<_CharT>(_VSTD::to_address(__begin), static_cast<size_t>(__p - __begin),
+                                                 __ctx.out()));
+    if (__p == __end)
+      break;
+
+    if (*__p == _CharT('}')) {
+      ++__p;
+      if (__p == __end || *__p != _CharT('}'))
+        __throw_format_error("The format string contains an invalid escape sequence");
+      __ctx.advance_to(__formatter::__copy<_CharT>(_VSTD::to_address(__p), 1, __ctx.out()));
+      __begin = __p + 1;
+      continue;
+    }
+
+    ++__p;
+    if (__p == __end)
+      __throw_format_error("The format string terminates at a '{'");
+    if (*__p == _CharT('{')) {
+      __ctx.advance_to(__formatter::__copy<_CharT>(_VSTD::to_address(__p), 1, __ctx.out()));
+      __begin = __p + 1;
+      continue;
+    }
+
+    uint32_t __id;
+    __p = __format::__parse_arg_id(__p, __end, __parse_ctx, __id);
+    if (__p == __end)
+      __throw_format_error("The replacement field misses a terminating '}'");
+    if (*__p == _CharT(':'))
+      ++__p;
+    else if (*__p != _CharT('}'))
+      __throw_format_error("The replacement field arg-id should terminate at a ':' or '}'");
+    __parse_ctx.advance_to(__p);
+
+    basic_format_arg<_Context> __arg = __ctx.arg(__id);
+    if (__arg.__type_ == __arg_t::__none)
+      __throw_format_error("Argument index out of bounds");
+    if (__arg.__type_ == __arg_t::__handle)
+      typename basic_format_arg<_Context>::handle{__arg.__value_.__handle_}.format(__parse_ctx, __ctx);
+    else {
+      __format_spec::__parsed_specifications<_CharT> __spec;
+      __parse_ctx.advance_to(
+          __format_spec::__parse(__parse_ctx, __format_spec::__category_of(__arg.__type_), __spec));
+      __format_spec::__substitute_arg_ids(__spec, __ctx);
+      __ctx.advance_to(__format::__format_builtin(__arg, __ctx, __spec));
+    }
+
+    __p = __parse_ctx.begin();
+    if (__p == __end || *__p != _CharT('}'))
+      __throw_format_error("The replacement field misses a terminating '}'");
+    __begin = __p + 1;
+  }
+  return __ctx.out();
+}
+
+/// Formats the arguments of __ctx as described by the format string __fmt,
+/// which was compiled to __compiled.
+template <class _CharT, size_t _Np, class _Context>
+_LIBCPP_HIDDEN typename _Context::iterator
+__vformat_to(const __compiled_format<_CharT, _Np>& __compiled, basic_string_view<_CharT> __fmt, _Context& __ctx) {
+  if (__compiled.__is_runtime())
+    return __format::__vformat_to(basic_format_parse_context{__fmt, __ctx.__num_args()}, __ctx);
+
+  const _CharT* __str = __fmt.data();
+  for (uint32_t __i = 0; __i != __compiled.__size_; ++__i) {
+    const __field<_CharT>& __f = __compiled.__fields_[__i];
+    __ctx.advance_to(__format::__write_literal(__str + __f.__literal_begin_, __str + __f.__literal_end_,
+                                               __f.__literal_escaped_, __ctx.out()));
+    if (!__f.__spec_.__has_arg_ids())
+      __ctx.advance_to(__format::__format_builtin(__ctx.arg(__f.__arg_id_), __ctx, __f.__spec_));
+    else {
+      __format_spec::__parsed_specifications<_CharT> __spec = __f.__spec_;
+      __format_spec::__substitute_arg_ids(__spec, __ctx);
+      __ctx.advance_to(__format::__format_builtin(__ctx.arg(__f.__arg_id_), __ctx, __spec));
+    }
+  }
+  return __format::__write_literal(__str + __compiled.__tail_begin_, __str + __fmt.size(), __compiled.__tail_escaped_,
+                                   __ctx.out());
+}
+
+} // namespace __format
+
+/// A format string that is checked, and where possible parsed, at compile
+/// time.
+///
+/// [format.fmt.string]/3: the constructor is ill-formed unless __str is a
+/// format string for the arguments _Args.
+template <class _CharT, class... _Args>
+struct _LIBCPP_TEMPLATE_VIS basic_format_string {
+  template <class _Tp>
+    requires convertible_to<const _Tp&, basic_string_view<_CharT>>
+  consteval basic_format_string(const _Tp& __str)
+      : __str_{__str}, __compiled_{__format::__compile<_CharT, _Args...>(__str_)} {}
+
+  _LIBCPP_HIDE_FROM_ABI constexpr basic_string_view<_CharT> get() const noexcept { return __str_; }
+
+  _LIBCPP_HIDE_FROM_ABI constexpr const __format::__compiled_format<_CharT, sizeof...(_Args)>&
+  __compiled() const noexcept {
+    return __compiled_;
+  }
+
+private:
+  basic_string_view<_CharT> __str_;
+  __format::__compiled_format<_CharT, sizeof...(_Args)> __compiled_;
+};
+
+template <class... _Args>
+using format_string = basic_format_string<char, type_identity_t<_Args>...>;
+template <class... _Args>
+using wformat_string = basic_format_string<wchar_t, type_identity_t<_Args>...>;
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_FORMAT_STRING_H
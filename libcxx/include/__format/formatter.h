@@ -0,0 +1,273 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_FORMATTER_H
+#define _LIBCPP___FORMAT_FORMATTER_H
+
+#include <__availability>
+#include <__config>
+#include <__format/buffer.h>
+#include <__format/format_fwd.h>
+#include <__format/parser_std_format_spec.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+/// The default formatter template.
+///
+/// [format.formatter.spec]/5
+/// If F is a disabled specialization of formatter, these values are false:
+/// - is_default_constructible_v<F>,
+/// - is_copy_constructible_v<F>,
+/// - is_move_constructible_v<F>,
+/// - is_copy_assignable<F>, and
+/// - is_move_assignable<F>.
+template <class _Tp, class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter {
+  formatter() = delete;
+  formatter(const formatter&) = delete;
+  formatter& operator=(const formatter&) = delete;
+};
+
+namespace __formatter {
+
+/// Writes [__first, __first + __n) to __out_it.
+///
+/// Output to the buffer of a standard format context is copied in bulk.
+template <class _CharT, class _InCharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __copy(const _InCharT* __first, size_t __n, _OutIt __out_it) {
+  if constexpr (is_same_v<_OutIt, __format::__output_iterator<_CharT>>) {
+    __out_it.__get_container()->__copy(__first, __n);
+    return __out_it;
+  } else
+    return _VSTD::copy_n(__first, __n, _VSTD::move(__out_it));
+}
+
+/// Writes __n fill characters of __spec to __out_it.
+template <class _CharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __fill(_OutIt __out_it, size_t __n,
+                                    const __format_spec::__parsed_specifications<_CharT>& __spec) {
+  if (__spec.__fill_size_ == 1) {
+    if constexpr (is_same_v<_OutIt, __format::__output_iterator<_CharT>>) {
+      __out_it.__get_container()->__fill(__n, __spec.__fill_[0]);
+      return __out_it;
+    } else
+      return _VSTD::fill_n(_VSTD::move(__out_it), __n, __spec.__fill_[0]);
+  }
+  for (; __n; --__n)
+    __out_it = __formatter::__copy<_CharT>(__spec.__fill_, __spec.__fill_size_, _VSTD::move(__out_it));
+  return __out_it;
+}
+
+struct _LIBCPP_TYPE_VIS __padding_size_result {
+  size_t __before_;
+  size_t __after_;
+};
+
+/// Returns the padding needed before and after output of estimated width
+/// __size in a field of width __width.
+_LIBCPP_HIDE_FROM_ABI constexpr __padding_size_result
+__padding_size(size_t __size, size_t __width, __format_spec::__alignment __align) {
+  if (__size >= __width)
+    return {0, 0};
+  size_t __fill = __width - __size;
+  switch (__align) {
+  case __format_spec::__alignment::__left:
+    return {0, __fill};
+  case __format_spec::__alignment::__center: {
+    // The extra fill character, when __fill is odd, goes after the output.
+    size_t __before = __fill / 2;
+    return {__before, __fill - __before};
+  }
+  default:
+    return {__fill, 0};
+  }
+}
+
+/// Writes [__first, __first + __n), with estimated width __size, aligned in
+/// the field width of __spec.
+template <class _CharT, class _InCharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __write(const _InCharT* __first, size_t __n, _OutIt __out_it,
+                                     const __format_spec::__parsed_specifications<_CharT>& __spec,
+                                     __format_spec::__alignment __default_alignment, size_t __size) {
+  if (__size >= __spec.__width_)
+    return __formatter::__copy<_CharT>(__first, __n, _VSTD::move(__out_it));
+
+  __format_spec::__alignment __align = __spec.__alignment_;
+  if (__align == __format_spec::__alignment::__default)
+    __align = __default_alignment;
+  __padding_size_result __padding = __formatter::__padding_size(__size, __spec.__width_, __align);
+  __out_it = __formatter::__fill(_VSTD::move(__out_it), __padding.__before_, __spec);
+  __out_it = __formatter::__copy<_CharT>(__first, __n, _VSTD::move(__out_it));
+  return __formatter::__fill(_VSTD::move(__out_it), __padding.__after_, __spec);
+}
+
+/// Like __write, for output that consists of one code unit per column.
+template <class _CharT, class _InCharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __write(const _InCharT* __first, size_t __n, _OutIt __out_it,
+                                     const __format_spec::__parsed_specifications<_CharT>& __spec,
+                                     __format_spec::__alignment __default_alignment) {
+  return __formatter::__write(__first, __n, _VSTD::move(__out_it), __spec, __default_alignment, __n);
+}
+
+/// Writes a number [__first, __last) whose sign and base prefix end at
+/// __digits, padded as requested by __spec.
+///
+/// With zero-padding the zeros go between the prefix and the digits.
+template <class _CharT, class _InCharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __write_number(const _InCharT* __first, const _InCharT* __digits, const _InCharT* __last,
+                                            _OutIt __out_it,
+                                            const __format_spec::__parsed_specifications<_CharT>& __spec) {
+  size_t __size = static_cast<size_t>(__last - __first);
+  if (__spec.__alignment_ != __format_spec::__alignment::__zero_padding || __size >= __spec.__width_)
+    return __formatter::__write(__first, __size, _VSTD::move(__out_it), __spec, __format_spec::__alignment::__right);
+
+  __out_it = __formatter::__copy<_CharT>(__first, static_cast<size_t>(__digits - __first), _VSTD::move(__out_it));
+  if constexpr (is_same_v<_OutIt, __format::__output_iterator<_CharT>>)
+    __out_it.__get_container()->__fill(__spec.__width_ - __size, _CharT('0'));
+  else
+    __out_it = _VSTD::fill_n(_VSTD::move(__out_it), __spec.__width_ - __size, _CharT('0'));
+  return __formatter::__copy<_CharT>(__digits, static_cast<size_t>(__last - __digits), _VSTD::move(__out_it));
+}
+
+/// Returns the estimated width of code point __c in columns.
+///
+/// [format.string.std]/11: the code points in these ranges have a width of 2,
+/// all others a width of 1.
+_LIBCPP_HIDE_FROM_ABI constexpr size_t __column_width(char32_t __c) noexcept {
+  if (__c < 0x1100)
+    return 1;
+  return ((__c >= 0x1100 && __c <= 0x115F) || (__c >= 0x2329 && __c <= 0x232A) ||
+          (__c >= 0x2E80 && __c <= 0x303E) || (__c >= 0x3040 && __c <= 0xA4CF) ||
+          (__c >= 0xAC00 && __c <= 0xD7A3) || (__c >= 0xF900 && __c <= 0xFAFF) ||
+          (__c >= 0xFE10 && __c <= 0xFE19) || (__c >= 0xFE30 && __c <= 0xFE6F) ||
+          (__c >= 0xFF00 && __c <= 0xFF60) || (__c >= 0xFFE0 && __c <= 0xFFE6) ||
+          (__c >= 0x1F300 && __c <= 0x1F64F) || (__c >= 0x1F900 && __c <= 0x1F9FF) ||
+          (__c >= 0x20000 && __c <= 0x2FFFD) || (__c >= 0x30000 && __c <= 0x3FFFD))
+             ? 2
+             : 1;
+}
+
+/// Decodes the code point at __first, and advances __first past it.
+///
+/// A code unit that does not start a valid code point counts as one code
+/// point on its own.
+template <class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr char32_t __decode(const _CharT*& __first, const _CharT* __last) noexcept {
+  if constexpr (sizeof(_CharT) == 1) {
+    unsigned char __c = static_cast<unsigned char>(*__first);
+    int __n = __format_spec::__code_units(*__first);
+    if (__n == 1 || __last - __first < __n) {
+      ++__first;
+      return __c;
+    }
+    char32_t __r = __c & (0x7f >> __n);
+    for (int __i = 1; __i != __n; ++__i) {
+      unsigned char __u = static_cast<unsigned char>(__first[__i]);
+      if ((__u & 0xc0) != 0x80) {
+        ++__first;
+        return __c;
+      }
+      __r = (__r << 6) | (__u & 0x3f);
+    }
+    __first += __n;
+    return __r;
+  } else if constexpr (sizeof(_CharT) == 2) {
+    char32_t __c = static_cast<char16_t>(*__first++);
+    if ((__c & 0xfc00) == 0xd800 && __first != __last && (*__first & 0xfc00) == 0xdc00)
+      __c = 0x10000 + ((__c - 0xd800) << 10) + (static_cast<char16_t>(*__first++) - 0xdc00);
+    return __c;
+  } else
+    return static_cast<char32_t>(*__first++);
+}
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS __column_width_result {
+  /// The estimated width of [__first, __last_).
+  size_t __width_;
+  const _CharT* __last_;
+};
+
+/// Estimates the width of the longest prefix of [__first, __last) that is at
+/// most __maximum columns wide.
+///
+/// Since this is the common case, runs of ASCII characters are measured
+/// without decoding.
+template <class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr __column_width_result<_CharT>
+__estimate_column_width(const _CharT* __first, const _CharT* __last, size_t __maximum) noexcept {
+  size_t __width = 0;
+  while (__first != __last && __width < __maximum) {
+    if (static_cast<make_unsigned_t<_CharT>>(*__first) < 0x80) {
+      ++__first;
+      ++__width;
+      continue;
+    }
+    const _CharT* __next = __first;
+    size_t __w = __formatter::__column_width(__formatter::__decode(__next, __last));
+    if (__width + __w > __maximum)
+      break;
+    __width += __w;
+    __first = __next;
+  }
+  return {__width, __first};
+}
+
+/// Writes the string [__first, __last) as requested by __spec, which has its
+/// arg-ids substituted.
+template <class _CharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __write_string(const _CharT* __first, const _CharT* __last, _OutIt __out_it,
+                                            const __format_spec::__parsed_specifications<_CharT>& __spec) {
+  if (!__spec.__has_precision() && __spec.__width_ == 0)
+    return __formatter::__copy<_CharT>(__first, static_cast<size_t>(__last - __first), _VSTD::move(__out_it));
+
+  size_t __size;
+  if (__spec.__has_precision()) {
+    __column_width_result<_CharT> __r =
+        __formatter::__estimate_column_width(__first, __last, static_cast<size_t>(__spec.__precision_));
+    __last = __r.__last_;
+    __size = __r.__width_;
+  } else
+    // Only whether the string fills the field matters, so the estimate may
+    // stop just past the field width.
+    __size = __formatter::__estimate_column_width(__first, __last, size_t(__spec.__width_) + 1).__width_;
+
+  return __formatter::__write(__first, static_cast<size_t>(__last - __first), _VSTD::move(__out_it), __spec,
+                              __format_spec::__alignment::__left, __size);
+}
+
+} // namespace __formatter
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_FORMATTER_H
@@ -0,0 +1,296 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_FORMATTER_FLOATING_POINT_H
+#define _LIBCPP___FORMAT_FORMATTER_FLOATING_POINT_H
+
+#include <__availability>
+#include <__config>
+#include <__format/format_error.h>
+#include <__format/format_fwd.h>
+#include <__format/formatter.h>
+#include <__format/formatter_integral.h>
+#include <__format/parser_std_format_spec.h>
+#include <__memory/allocator.h>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstring>
+#include <limits>
+
+#ifndef _LIBCPP_HAS_NO_LOCALIZATION
+#include <locale>
+#endif
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+namespace __formatter {
+
+/// The buffer a floating-point value is converted in.
+///
+/// The size needed depends on the precision, which can be large. A buffer on
+/// the stack is used when it suffices, else one is allocated.
+template <floating_point _Tp>
+class _LIBCPP_TEMPLATE_VIS __float_buffer {
+public:
+  _LIBCPP_HIDE_FROM_ABI explicit __float_buffer(chars_format __fmt, int __precision) {
+    // Room for the sign, the decimal point that the alternate form may add,
+    // and the exponent, on top of the digits.
+    size_t __size = 32;
+    if (__precision < 0)
+      // The shortest representations are at most a few dozen characters.
+      __size += 128;
+    else {
+      __size += static_cast<size_t>(__precision);
+      if (__fmt == chars_format::fixed)
+        __size += numeric_limits<_Tp>::max_exponent10 + 1;
+    }
+
+    if (__size > sizeof(__small_)) {
+      __begin_ = allocator<char>{}.allocate(__size);
+      __size_ = __size;
+    } else
+      __begin_ = __small_;
+  }
+
+  __float_buffer(const __float_buffer&) = delete;
+  __float_buffer& operator=(const __float_buffer&) = delete;
+
+  _LIBCPP_HIDE_FROM_ABI ~__float_buffer() {
+    if (__size_)
+      allocator<char>{}.deallocate(__begin_, __size_);
+  }
+
+  _LIBCPP_HIDE_FROM_ABI char* begin() const noexcept { return __begin_; }
+  _LIBCPP_HIDE_FROM_ABI char* end() const noexcept { return __begin_ + (__size_ ? __size_ : sizeof(__small_)); }
+
+private:
+  char* __begin_;
+  size_t __size_ = 0;
+  char __small_[256];
+};
+
+template <class _FormatContext>
+_LIBCPP_HIDE_FROM_ABI typename _FormatContext::iterator
+__format_non_finite(bool __negative, bool __isnan, _FormatContext& __ctx,
+                    __format_spec::__parsed_specifications<typename _FormatContext::char_type> __spec) {
+  char __buffer[4];
+  char* __last = __formatter::__insert_sign(__buffer, __negative, __spec.__sign_);
+  bool __upper = __spec.__type_ == __format_spec::__type::__hexfloat_upper_case ||
+                 __spec.__type_ == __format_spec::__type::__scientific_upper_case ||
+                 __spec.__type_ == __format_spec::__type::__fixed_upper_case ||
+                 __spec.__type_ == __format_spec::__type::__general_upper_case;
+  _VSTD::memcpy(__last, __isnan ? (__upper ? "NAN" : "nan") : (__upper ? "INF" : "inf"), 3);
+  __last += 3;
+
+  // [format.string.std]/8: infinity and NaN are not zero-padded; they are
+  // padded with spaces instead.
+  if (__spec.__alignment_ == __format_spec::__alignment::__zero_padding) {
+    __spec.__alignment_ = __format_spec::__alignment::__right;
+    __spec.__fill_[0] = ' ';
+    __spec.__fill_size_ = 1;
+  }
+  return __formatter::__write(__buffer, static_cast<size_t>(__last - __buffer), __ctx.out(), __spec,
+                              __format_spec::__alignment::__right);
+}
+
+/// Appends zeros to the significand in [__first, __last) until it has
+/// __precision significant digits, and returns the new end.
+///
+/// This undoes the removal of trailing zeros by the general format, as the
+/// alternate form requires. [__last, __end) is free space in the buffer.
+_LIBCPP_HIDE_FROM_ABI inline char* __add_trailing_zeros(char* __first, char* __last, char* __exponent,
+                                                        int __precision) {
+  // Count the significant digits; when all digits are zero, they all are.
+  int __digits = 0;
+  int __zeros = 0;
+  bool __leading = true;
+  for (char* __p = __first; __p != __exponent; ++__p) {
+    if (*__p == '.')
+      continue;
+    if (__leading && *__p == '0') {
+      ++__zeros;
+      continue;
+    }
+    __leading = false;
+    ++__digits;
+  }
+  if (__leading)
+    __digits = __zeros;
+
+  int __precision_digits = __precision == 0 ? 1 : __precision;
+  if (__digits >= __precision_digits)
+    return __last;
+  size_t __n = static_cast<size_t>(__precision_digits - __digits);
+  _VSTD::memmove(__exponent + __n, __exponent, static_cast<size_t>(__last - __exponent));
+  _VSTD::memset(__exponent, '0', __n);
+  return __last + __n;
+}
+
+template <floating_point _Tp, class _FormatContext>
+_LIBCPP_HIDE_FROM_ABI typename _FormatContext::iterator
+__format_floating_point(_Tp __value, _FormatContext& __ctx,
+                        const __format_spec::__parsed_specifications<typename _FormatContext::char_type>& __spec) {
+  bool __negative = _VSTD::signbit(__value);
+  if (!_VSTD::isfinite(__value)) [[unlikely]]
+    return __formatter::__format_non_finite(__negative, _VSTD::isnan(__value), __ctx, __spec);
+  if (__negative)
+    __value = -__value;
+
+  // [format.string.std]/20: the default type is the shortest round trip
+  // format, or general with a precision.
+  chars_format __fmt = chars_format::general;
+  int __precision = __spec.__precision_;
+  bool __upper = false;
+  bool __general = true;
+  switch (__spec.__type_) {
+  case __format_spec::__type::__default:
+    if (__precision == -1)
+      __general = false;
+    break;
+  case __format_spec::__type::__hexfloat_upper_case:
+    __upper = true;
+    [[fallthrough]];
+  case __format_spec::__type::__hexfloat_lower_case:
+    __fmt = chars_format::hex;
+    __general = false;
+    break;
+  case __format_spec::__type::__scientific_upper_case:
+    __upper = true;
+    [[fallthrough]];
+  case __format_spec::__type::__scientific_lower_case:
+    __fmt = chars_format::scientific;
+    __general = false;
+    if (__precision == -1)
+      __precision = 6;
+    break;
+  case __format_spec::__type::__fixed_upper_case:
+    __upper = true;
+    [[fallthrough]];
+  case __format_spec::__type::__fixed_lower_case:
+    __fmt = chars_format::fixed;
+    __general = false;
+    if (__precision == -1)
+      __precision = 6;
+    break;
+  case __format_spec::__type::__general_upper_case:
+    __upper = true;
+    [[fallthrough]];
+  default:
+    if (__precision == -1)
+      __precision = 6;
+    break;
+  }
+
+  __float_buffer<_Tp> __buffer(__fmt, __precision);
+  char* __first = __formatter::__insert_sign(__buffer.begin(), __negative, __spec.__sign_);
+  to_chars_result __r;
+  if (__precision != -1)
+    __r = _VSTD::to_chars(__first, __buffer.end(), __value, __fmt, __precision);
+  else if (__fmt == chars_format::hex)
+    __r = _VSTD::to_chars(__first, __buffer.end(), __value, __fmt);
+  else
+    __r = _VSTD::to_chars(__first, __buffer.end(), __value);
+  char* __last = __r.ptr;
+
+  const char __exponent_char = __fmt == chars_format::hex ? 'p' : 'e';
+  char* __exponent = _VSTD::find(__first, __last, __exponent_char);
+  char* __radix_point = _VSTD::find(__first, __exponent, '.');
+
+  if (__spec.__alternate_form_) {
+    // [format.string.std]/6: the alternate form always has a decimal point,
+    // and for the general format keeps the trailing zeros.
+    if (__radix_point == __exponent) {
+      _VSTD::memmove(__exponent + 1, __exponent, static_cast<size_t>(__last - __exponent));
+      *__exponent++ = '.';
+      ++__last;
+    }
+    if (__general) {
+      char* __new_last = __formatter::__add_trailing_zeros(__first, __last, __exponent, __precision);
+      __exponent += __new_last - __last;
+      __last = __new_last;
+    }
+  }
+
+  if (__upper)
+    __formatter::__to_upper(__first, __last);
+
+#ifndef _LIBCPP_HAS_NO_LOCALIZATION
+  if (__spec.__locale_specific_form_) {
+    using _CharT = typename _FormatContext::char_type;
+    const auto& __np = use_facet<numpunct<_CharT>>(__ctx.locale());
+    string __grouping = __np.grouping();
+    // The integral digits end at the radix point or the exponent; for the
+    // hexadecimal format only the digits before the radix point count.
+    char* __integral_last = _VSTD::find(__first, __exponent, '.');
+    return __formatter::__write_using_separators(__buffer.begin(), __first, __integral_last, __last, __ctx.out(),
+                                                 __spec, __grouping, __np.thousands_sep(), __np.decimal_point());
+  }
+#endif
+  return __formatter::__write_number(__buffer.begin(), __first, __last, __ctx.out(), __spec);
+}
+
+} // namespace __formatter
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS __formatter_floating_point {
+public:
+  _LIBCPP_HIDE_FROM_ABI constexpr auto parse(basic_format_parse_context<_CharT>& __parse_ctx)
+      -> decltype(__parse_ctx.begin()) {
+    return __format_spec::__parse(__parse_ctx, __format_spec::__category::__floating_point, __spec_);
+  }
+
+  template <floating_point _Tp, class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(_Tp __value, _FormatContext& __ctx) const -> decltype(__ctx.out()) {
+    __format_spec::__parsed_specifications<_CharT> __spec = __spec_;
+    __format_spec::__substitute_arg_ids(__spec, __ctx);
+    return __formatter::__format_floating_point(__value, __ctx, __spec);
+  }
+
+  __format_spec::__parsed_specifications<_CharT> __spec_;
+};
+
+// [format.formatter.spec]/2.3
+// For each charT, for each cv-unqualified arithmetic type ArithmeticT other
+// than char, wchar_t, char8_t, char16_t, or char32_t, a specialization
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<float, _CharT>
+    : public __formatter_floating_point<_CharT> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<double, _CharT>
+    : public __formatter_floating_point<_CharT> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<long double, _CharT>
+    : public __formatter_floating_point<_CharT> {};
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_FORMATTER_FLOATING_POINT_H
@@ -0,0 +1,318 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_FORMATTER_INTEGRAL_H
+#define _LIBCPP___FORMAT_FORMATTER_INTEGRAL_H
+
+#include <__availability>
+#include <__config>
+#include <__format/format_error.h>
+#include <__format/format_fwd.h>
+#include <__format/formatter.h>
+#include <__format/parser_std_format_spec.h>
+#include <charconv>
+#include <climits>
+#include <concepts>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#ifndef _LIBCPP_HAS_NO_LOCALIZATION
+#include <locale>
+#endif
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+namespace __formatter {
+
+/// Writes the digits of __value in base __base to [__first, __last), which is
+/// large enough, and returns the end of the digits.
+template <unsigned_integral _Tp>
+_LIBCPP_HIDE_FROM_ABI char* __to_buffer(char* __first, char* __last, _Tp __value, int __base) {
+  if constexpr (sizeof(_Tp) <= sizeof(unsigned long long))
+    return _VSTD::to_chars(__first, __last, __value, __base).ptr;
+  else {
+    // to_chars has no 128-bit overloads.
+    if (__value <= numeric_limits<unsigned long long>::max())
+      return _VSTD::to_chars(__first, __last, static_cast<unsigned long long>(__value), __base).ptr;
+    char __buffer[numeric_limits<_Tp>::digits];
+    char* __p = _VSTD::end(__buffer);
+    do {
+      *--__p = "0123456789abcdef"[__value % __base];
+      __value /= __base;
+    } while (__value);
+    return _VSTD::copy(__p, _VSTD::end(__buffer), __first);
+  }
+}
+
+_LIBCPP_HIDE_FROM_ABI inline void __to_upper(char* __first, char* __last) noexcept {
+  for (; __first != __last; ++__first)
+    if (*__first >= 'a' && *__first <= 'z')
+      *__first -= 'a' - 'A';
+}
+
+_LIBCPP_HIDE_FROM_ABI inline char* __insert_sign(char* __buf, bool __negative, __format_spec::__sign __sign) noexcept {
+  if (__negative)
+    *__buf++ = '-';
+  else if (__sign == __format_spec::__sign::__plus)
+    *__buf++ = '+';
+  else if (__sign == __format_spec::__sign::__space)
+    *__buf++ = ' ';
+  return __buf;
+}
+
+#ifndef _LIBCPP_HAS_NO_LOCALIZATION
+/// Writes the number [__first, __last), whose sign and base prefix end at
+/// __digits and whose integral digits end at __integral_last, using the
+/// separators of the locale.
+///
+/// The thousands separators are inserted as described by __grouping, and a
+/// '.' after the integral digits is replaced by __decimal_point.
+template <class _CharT, class _OutIt>
+_LIBCPP_HIDE_FROM_ABI _OutIt __write_using_separators(const char* __first, const char* __digits,
+                                                      const char* __integral_last, const char* __last,
+                                                      _OutIt __out_it,
+                                                      const __format_spec::__parsed_specifications<_CharT>& __spec,
+                                                      const string& __grouping, _CharT __thousands_sep,
+                                                      _CharT __decimal_point) {
+  basic_string<_CharT> __str;
+  __str.reserve(static_cast<size_t>(__last - __first) * 2);
+
+  // The integral digits are grouped from the right, so they are copied in
+  // reverse order first.
+  auto __group = __grouping.begin();
+  int __n = 0;
+  for (const char* __p = __integral_last; __p != __digits;) {
+    if (__group != __grouping.end() && *__group > 0 && *__group != CHAR_MAX && __n == *__group) {
+      __str.push_back(__thousands_sep);
+      __n = 0;
+      if (__group + 1 != __grouping.end())
+        ++__group;
+    }
+    __str.push_back(*--__p);
+    ++__n;
+  }
+  _VSTD::reverse(__str.begin(), __str.end());
+
+  for (const char* __p = __integral_last; __p != __last; ++__p)
+    __str.push_back(__p == __integral_last && *__p == '.' ? __decimal_point : _CharT(*__p));
+
+  size_t __prefix = static_cast<size_t>(__digits - __first);
+  size_t __size = __prefix + __str.size();
+  if (__spec.__alignment_ == __format_spec::__alignment::__zero_padding && __size < __spec.__width_)
+    __str.insert(size_t(0), __spec.__width_ - __size, _CharT('0'));
+  __str.insert(__str.begin(), __first, __digits);
+  return __formatter::__write(__str.data(), __str.size(), _VSTD::move(__out_it), __spec,
+                              __format_spec::__alignment::__right);
+}
+#endif // _LIBCPP_HAS_NO_LOCALIZATION
+
+template <class _CharT, class _FormatContext>
+_LIBCPP_HIDE_FROM_ABI typename _FormatContext::iterator
+__format_char(_CharT __value, _FormatContext& __ctx, const __format_spec::__parsed_specifications<_CharT>& __spec) {
+  return __formatter::__write(_VSTD::addressof(__value), 1, __ctx.out(), __spec, __format_spec::__alignment::__left);
+}
+
+template <integral _Tp, class _FormatContext>
+_LIBCPP_HIDE_FROM_ABI typename _FormatContext::iterator
+__format_integer(_Tp __value, _FormatContext& __ctx,
+                 const __format_spec::__parsed_specifications<typename _FormatContext::char_type>& __spec) {
+  using _CharT = typename _FormatContext::char_type;
+  if (__spec.__type_ == __format_spec::__type::__char) {
+    _CharT __c = static_cast<_CharT>(__value);
+    if (static_cast<_Tp>(__c) != __value || (is_signed_v<_Tp> && __value < 0) != (__c < 0))
+      __throw_format_error("Integral value outside the range of the char type");
+    return __formatter::__format_char(__c, __ctx, __spec);
+  }
+
+  using _Up = make_unsigned_t<_Tp>;
+  const bool __negative = __value < 0;
+  const _Up __u = __negative ? static_cast<_Up>(0u - static_cast<_Up>(__value)) : static_cast<_Up>(__value);
+
+  // Large enough for a binary 128-bit value with its sign and prefix.
+  char __buffer[numeric_limits<_Up>::digits + 3];
+  char* __first = __formatter::__insert_sign(__buffer, __negative, __spec.__sign_);
+
+  int __base = 10;
+  switch (__spec.__type_) {
+  case __format_spec::__type::__binary_lower_case:
+  case __format_spec::__type::__binary_upper_case:
+    __base = 2;
+    if (__spec.__alternate_form_) {
+      *__first++ = '0';
+      *__first++ = __spec.__type_ == __format_spec::__type::__binary_lower_case ? 'b' : 'B';
+    }
+    break;
+  case __format_spec::__type::__octal:
+    __base = 8;
+    // [format.string.std]/6: the octal prefix is 0 when the value is nonzero.
+    if (__spec.__alternate_form_ && __u != 0)
+      *__first++ = '0';
+    break;
+  case __format_spec::__type::__hexadecimal_lower_case:
+  case __format_spec::__type::__hexadecimal_upper_case:
+    __base = 16;
+    if (__spec.__alternate_form_) {
+      *__first++ = '0';
+      *__first++ = __spec.__type_ == __format_spec::__type::__hexadecimal_lower_case ? 'x' : 'X';
+    }
+    break;
+  default:
+    break;
+  }
+
+  char* __digits = __first;
+  char* __last = __formatter::__to_buffer(__digits, _VSTD::end(__buffer), __u, __base);
+  if (__spec.__type_ == __format_spec::__type::__hexadecimal_upper_case)
+    __formatter::__to_upper(__digits, __last);
+
+#ifndef _LIBCPP_HAS_NO_LOCALIZATION
+  if (__spec.__locale_specific_form_) {
+    const auto& __np = use_facet<numpunct<_CharT>>(__ctx.locale());
+    string __grouping = __np.grouping();
+    if (!__grouping.empty())
+      return __formatter::__write_using_separators(__buffer, __digits, __last, __last, __ctx.out(), __spec,
+                                                   __grouping, __np.thousands_sep(), __np.decimal_point());
+  }
+#endif
+  return __formatter::__write_number(__buffer, __digits, __last, __ctx.out(), __spec);
+}
+
+template <class _FormatContext>
+_LIBCPP_HIDE_FROM_ABI typename _FormatContext::iterator
+__format_bool(bool __value, _FormatContext& __ctx,
+              const __format_spec::__parsed_specifications<typename _FormatContext::char_type>& __spec) {
+  using _CharT = typename _FormatContext::char_type;
+  if (__spec.__type_ != __format_spec::__type::__default && __spec.__type_ != __format_spec::__type::__string)
+    return __formatter::__format_integer(static_cast<unsigned char>(__value), __ctx, __spec);
+
+#ifndef _LIBCPP_HAS_NO_LOCALIZATION
+  if (__spec.__locale_specific_form_) {
+    const auto& __np = use_facet<numpunct<_CharT>>(__ctx.locale());
+    basic_string<_CharT> __str = __value ? __np.truename() : __np.falsename();
+    return __formatter::__write_string(__str.data(), __str.data() + __str.size(), __ctx.out(), __spec);
+  }
+#endif
+  static constexpr char __true[] = "true";
+  static constexpr char __false[] = "false";
+  return __value ? __formatter::__write(__true, 4, __ctx.out(), __spec, __format_spec::__alignment::__left)
+                 : __formatter::__write(__false, 5, __ctx.out(), __spec, __format_spec::__alignment::__left);
+}
+
+} // namespace __formatter
+
+/// The base of the formatters of the integral types.
+template <class _CharT, __format_spec::__category _Category>
+struct _LIBCPP_TEMPLATE_VIS __formatter_integral {
+public:
+  _LIBCPP_HIDE_FROM_ABI constexpr auto parse(basic_format_parse_context<_CharT>& __parse_ctx)
+      -> decltype(__parse_ctx.begin()) {
+    return __format_spec::__parse(__parse_ctx, _Category, __spec_);
+  }
+
+  template <class _Tp, class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(_Tp __value, _FormatContext& __ctx) const -> decltype(__ctx.out()) {
+    __format_spec::__parsed_specifications<_CharT> __spec = __spec_;
+    __format_spec::__substitute_arg_ids(__spec, __ctx);
+    if constexpr (same_as<_Tp, bool>)
+      return __formatter::__format_bool(__value, __ctx, __spec);
+    else if constexpr (_Category == __format_spec::__category::__char) {
+      if (__spec.__type_ == __format_spec::__type::__default || __spec.__type_ == __format_spec::__type::__char)
+        return __formatter::__format_char(static_cast<_CharT>(__value), __ctx, __spec);
+      // [format.string.std]/18: as an integer, the value of the code unit.
+      return __formatter::__format_integer(static_cast<make_unsigned_t<_CharT>>(__value), __ctx, __spec);
+    } else
+      return __formatter::__format_integer(__value, __ctx, __spec);
+  }
+
+  __format_spec::__parsed_specifications<_CharT> __spec_;
+};
+
+// [format.formatter.spec]/2.1 The specializations
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<_CharT, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__char> {};
+
+template <>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<char, wchar_t>
+    : public __formatter_integral<wchar_t, __format_spec::__category::__char> {};
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<bool, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__bool> {};
+
+// Signed integral types.
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<signed char, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<short, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<int, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<long, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<long long, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+#ifndef _LIBCPP_HAS_NO_INT128
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<__int128_t, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+#endif
+
+// Unsigned integral types.
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<unsigned char, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<unsigned short, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<unsigned, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<unsigned long, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<unsigned long long, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+#ifndef _LIBCPP_HAS_NO_INT128
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<__uint128_t, _CharT>
+    : public __formatter_integral<_CharT, __format_spec::__category::__integer> {};
+#endif
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_FORMATTER_INTEGRAL_H
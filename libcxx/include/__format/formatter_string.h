@@ -0,0 +1,182 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_FORMATTER_STRING_H
+#define _LIBCPP___FORMAT_FORMATTER_STRING_H
+
+#include <__availability>
+#include <__config>
+#include <__format/format_fwd.h>
+#include <__format/formatter.h>
+#include <__format/formatter_integral.h>
+#include <__format/parser_std_format_spec.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+namespace __formatter {
+
+template <class _FormatContext>
+_LIBCPP_HIDE_FROM_ABI typename _FormatContext::iterator
+__format_pointer(const void* __ptr, _FormatContext& __ctx,
+                 const __format_spec::__parsed_specifications<typename _FormatContext::char_type>& __spec) {
+  // [format.string.std]/23: the pointer is formatted as if by the x type of
+  // an integer with the 0x prefix.
+  char __buffer[2 + numeric_limits<uintptr_t>::digits / 4];
+  __buffer[0] = '0';
+  __buffer[1] = 'x';
+  char* __last = __formatter::__to_buffer(__buffer + 2, _VSTD::end(__buffer), reinterpret_cast<uintptr_t>(__ptr), 16);
+  return __formatter::__write(__buffer, static_cast<size_t>(__last - __buffer), __ctx.out(), __spec,
+                              __format_spec::__alignment::__right);
+}
+
+} // namespace __formatter
+
+/// The base of the formatters of the string types.
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS __formatter_string {
+public:
+  _LIBCPP_HIDE_FROM_ABI constexpr auto parse(basic_format_parse_context<_CharT>& __parse_ctx)
+      -> decltype(__parse_ctx.begin()) {
+    return __format_spec::__parse(__parse_ctx, __format_spec::__category::__string, __spec_);
+  }
+
+  template <class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(basic_string_view<_CharT> __str, _FormatContext& __ctx) const
+      -> decltype(__ctx.out()) {
+    if (!__spec_.__has_arg_ids())
+      return __formatter::__write_string(__str.data(), __str.data() + __str.size(), __ctx.out(), __spec_);
+
+    __format_spec::__parsed_specifications<_CharT> __spec = __spec_;
+    __format_spec::__substitute_arg_ids(__spec, __ctx);
+    return __formatter::__write_string(__str.data(), __str.data() + __str.size(), __ctx.out(), __spec);
+  }
+
+  __format_spec::__parsed_specifications<_CharT> __spec_;
+};
+
+// [format.formatter.spec]/2.2 For each charT, the string type specializations
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<const _CharT*, _CharT>
+    : public __formatter_string<_CharT> {
+  using _Base = __formatter_string<_CharT>;
+
+  template <class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(const _CharT* __str, _FormatContext& __ctx) const -> decltype(__ctx.out()) {
+    _LIBCPP_ASSERT(__str, "The basic_format_arg constructor should have prevented an invalid pointer.");
+    return _Base::format(basic_string_view<_CharT>(__str), __ctx);
+  }
+};
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<_CharT*, _CharT>
+    : public formatter<const _CharT*, _CharT> {
+  using _Base = formatter<const _CharT*, _CharT>;
+
+  template <class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(_CharT* __str, _FormatContext& __ctx) const -> decltype(__ctx.out()) {
+    return _Base::format(__str, __ctx);
+  }
+};
+
+template <class _CharT, size_t _Size>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<const _CharT[_Size], _CharT>
+    : public __formatter_string<_CharT> {
+  using _Base = __formatter_string<_CharT>;
+
+  template <class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(const _CharT __str[_Size], _FormatContext& __ctx) const
+      -> decltype(__ctx.out()) {
+    return _Base::format(basic_string_view<_CharT>(__str, _Size), __ctx);
+  }
+};
+
+template <class _CharT, class _Traits, class _Allocator>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<basic_string<_CharT, _Traits, _Allocator>, _CharT>
+    : public __formatter_string<_CharT> {
+  using _Base = __formatter_string<_CharT>;
+
+  template <class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(const basic_string<_CharT, _Traits, _Allocator>& __str,
+                                    _FormatContext& __ctx) const -> decltype(__ctx.out()) {
+    return _Base::format(basic_string_view<_CharT>(__str.data(), __str.size()), __ctx);
+  }
+};
+
+template <class _CharT, class _Traits>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<basic_string_view<_CharT, _Traits>, _CharT>
+    : public __formatter_string<_CharT> {
+  using _Base = __formatter_string<_CharT>;
+
+  template <class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(basic_string_view<_CharT, _Traits> __str, _FormatContext& __ctx) const
+      -> decltype(__ctx.out()) {
+    return _Base::format(basic_string_view<_CharT>(__str.data(), __str.size()), __ctx);
+  }
+};
+
+/// The base of the formatters of the pointer types.
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS __formatter_pointer {
+public:
+  _LIBCPP_HIDE_FROM_ABI constexpr auto parse(basic_format_parse_context<_CharT>& __parse_ctx)
+      -> decltype(__parse_ctx.begin()) {
+    return __format_spec::__parse(__parse_ctx, __format_spec::__category::__pointer, __spec_);
+  }
+
+  template <class _FormatContext>
+  _LIBCPP_HIDE_FROM_ABI auto format(const void* __ptr, _FormatContext& __ctx) const -> decltype(__ctx.out()) {
+    __format_spec::__parsed_specifications<_CharT> __spec = __spec_;
+    __format_spec::__substitute_arg_ids(__spec, __ctx);
+    return __formatter::__format_pointer(__ptr, __ctx, __spec);
+  }
+
+  __format_spec::__parsed_specifications<_CharT> __spec_;
+};
+
+// [format.formatter.spec]/2.4 For each charT, the pointer type specializations
+
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<nullptr_t, _CharT>
+    : public __formatter_pointer<_CharT> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<void*, _CharT>
+    : public __formatter_pointer<_CharT> {};
+template <class _CharT>
+struct _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_FORMAT formatter<const void*, _CharT>
+    : public __formatter_pointer<_CharT> {};
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_FORMATTER_STRING_H
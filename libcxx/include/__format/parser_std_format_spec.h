@@ -0,0 +1,512 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___FORMAT_PARSER_STD_FORMAT_SPEC_H
+#define _LIBCPP___FORMAT_PARSER_STD_FORMAT_SPEC_H
+
+#include <__config>
+#include <__format/format_arg.h>
+#include <__format/format_error.h>
+#include <__format/format_parse_context.h>
+#include <cstdint>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 17
+
+// TODO FMT Remove this once we require compilers with proper C++20 support.
+// If the compiler has no concepts support, the format header will be disabled.
+// Without concepts support enable_if needs to be used and that too much effort
+// to support compilers with partial C++20 support.
+#if !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+namespace __format {
+
+/// The maximum value of a numeric argument.
+///
+/// This is used for:
+/// * arg-id
+/// * width as value or arg-id.
+/// * precision as value or arg-id.
+///
+/// The value is compatible with the maximum formatting width and precision
+/// using the `%*` syntax on a 32-bit system.
+inline constexpr uint32_t __number_max = INT32_MAX;
+
+template <class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr bool __is_digit(_CharT __c) noexcept {
+  return __c >= _CharT('0') && __c <= _CharT('9');
+}
+
+/// Parses a non-negative number starting at __begin, which must be a digit.
+template <class _Iterator>
+_LIBCPP_HIDE_FROM_ABI constexpr _Iterator __parse_number(_Iterator __begin, _Iterator __end, uint32_t& __value) {
+  uint64_t __v = 0;
+  for (; __begin != __end && __format::__is_digit(*__begin); ++__begin) {
+    __v = __v * 10 + static_cast<uint32_t>(*__begin - '0');
+    if (__v > __number_max)
+      __throw_format_error("The numeric value of the format-spec is too large");
+  }
+  __value = static_cast<uint32_t>(__v);
+  return __begin;
+}
+
+/// Parses an arg-id, or nothing for automatic numbering, and registers it
+/// with __ctx.
+///
+/// The parsing starts at __begin, which must not be __end, and ends at the
+/// first character after the arg-id.
+template <class _Iterator, class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr _Iterator
+__parse_arg_id(_Iterator __begin, _Iterator __end, basic_format_parse_context<_CharT>& __ctx, uint32_t& __id) {
+  if (*__begin == _CharT('}') || *__begin == _CharT(':')) {
+    __id = static_cast<uint32_t>(__ctx.next_arg_id());
+    return __begin;
+  }
+  if (*__begin == _CharT('0')) {
+    __id = 0;
+    ++__begin;
+  } else if (__format::__is_digit(*__begin))
+    __begin = __format::__parse_number(__begin, __end, __id);
+  else
+    __throw_format_error("The arg-id of the format-spec starts with an invalid character");
+
+  __ctx.check_arg_id(__id);
+  return __begin;
+}
+
+} // namespace __format
+
+namespace __format_spec {
+
+enum class _LIBCPP_ENUM_VIS __alignment : uint8_t {
+  /// No alignment is set in the format string; the default depends on the
+  /// argument type.
+  __default,
+  __left,
+  __center,
+  __right,
+  /// The 0 option is used without an explicit alignment: the sign and base
+  /// prefix are followed by as many zeros as needed.
+  __zero_padding
+};
+
+enum class _LIBCPP_ENUM_VIS __sign : uint8_t { __default, __minus, __plus, __space };
+
+enum class _LIBCPP_ENUM_VIS __type : uint8_t {
+  __default,
+  __string,
+  __binary_lower_case,
+  __binary_upper_case,
+  __octal,
+  __decimal,
+  __hexadecimal_lower_case,
+  __hexadecimal_upper_case,
+  __pointer,
+  __char,
+  __hexfloat_lower_case,
+  __hexfloat_upper_case,
+  __scientific_lower_case,
+  __scientific_upper_case,
+  __fixed_lower_case,
+  __fixed_upper_case,
+  __general_lower_case,
+  __general_upper_case
+};
+
+/// The kinds of arguments of the formatters of the library. The kind decides
+/// which options of a std-format-spec are valid.
+enum class _LIBCPP_ENUM_VIS __category : uint8_t { __bool, __char, __integer, __floating_point, __string, __pointer };
+
+_LIBCPP_HIDE_FROM_ABI constexpr __category __category_of(__format::__arg_t __arg) noexcept {
+  switch (__arg) {
+  case __format::__arg_t::__boolean:
+    return __category::__bool;
+  case __format::__arg_t::__char_type:
+    return __category::__char;
+  case __format::__arg_t::__float:
+  case __format::__arg_t::__double:
+  case __format::__arg_t::__long_double:
+    return __category::__floating_point;
+  case __format::__arg_t::__const_char_type_ptr:
+  case __format::__arg_t::__string_view:
+    return __category::__string;
+  case __format::__arg_t::__ptr:
+    return __category::__pointer;
+  default:
+    return __category::__integer;
+  }
+}
+
+/// A parsed std-format-spec.
+///
+/// This is all the formatters of the library need to format a value, so that
+/// a format string checked at compile time can store it for every
+/// replacement field and skip the parsing at run time.
+template <class _CharT>
+struct __parsed_specifications {
+  /// A fill character is one code point, which takes up to 4 code units in
+  /// UTF-8 and 2 in UTF-16.
+  static constexpr size_t __fill_capacity = 4 / sizeof(_CharT) ? 4 / sizeof(_CharT) : 1;
+
+  _CharT __fill_[__fill_capacity] = {_CharT(' ')};
+  uint8_t __fill_size_ = 1;
+  __alignment __alignment_ = __alignment::__default;
+  __sign __sign_ = __sign::__default;
+  bool __alternate_form_ = false;
+  bool __locale_specific_form_ = false;
+  /// When set, __width_ is the arg-id of the argument holding the width.
+  bool __width_as_arg_ = false;
+  /// When set, __precision_ is the arg-id of the argument holding the precision.
+  bool __precision_as_arg_ = false;
+  __type __type_ = __type::__default;
+  /// The minimum field width; 0 when there is none.
+  uint32_t __width_ = 0;
+  /// The precision; -1 when there is none.
+  int32_t __precision_ = -1;
+
+  _LIBCPP_HIDE_FROM_ABI constexpr bool __has_precision() const noexcept { return __precision_ != -1; }
+
+  /// Whether the options need the argument values of arg-ids.
+  _LIBCPP_HIDE_FROM_ABI constexpr bool __has_arg_ids() const noexcept {
+    return __width_as_arg_ || __precision_as_arg_;
+  }
+};
+
+/// Returns the number of code units of the code point that starts with __c,
+/// or 1 when __c cannot start a multi-unit code point.
+template <class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr int __code_units(_CharT __c) noexcept {
+  if constexpr (sizeof(_CharT) == 1) {
+    unsigned char __u = static_cast<unsigned char>(__c);
+    if ((__u & 0xe0) == 0xc0)
+      return 2;
+    if ((__u & 0xf0) == 0xe0)
+      return 3;
+    if ((__u & 0xf8) == 0xf0)
+      return 4;
+    return 1;
+  } else if constexpr (sizeof(_CharT) == 2) {
+    return (__c & 0xfc00) == 0xd800 ? 2 : 1;
+  } else
+    return 1;
+}
+
+template <class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr bool __parse_alignment(_CharT __c, __parsed_specifications<_CharT>& __spec) noexcept {
+  switch (__c) {
+  case _CharT('<'):
+    __spec.__alignment_ = __alignment::__left;
+    return true;
+  case _CharT('^'):
+    __spec.__alignment_ = __alignment::__center;
+    return true;
+  case _CharT('>'):
+    __spec.__alignment_ = __alignment::__right;
+    return true;
+  }
+  return false;
+}
+
+template <class _Iterator, class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr _Iterator
+__parse_fill_align(_Iterator __begin, _Iterator __end, __parsed_specifications<_CharT>& __spec) {
+  int __n = __format_spec::__code_units(*__begin);
+  if (__end - __begin > __n && __format_spec::__parse_alignment(__begin[__n], __spec)) {
+    if (*__begin == _CharT('{') || *__begin == _CharT('}'))
+      __throw_format_error("The format-spec fill field contains an invalid character");
+    for (int __i = 0; __i != __n; ++__i)
+      __spec.__fill_[__i] = __begin[__i];
+    __spec.__fill_size_ = static_cast<uint8_t>(__n);
+    return __begin + __n + 1;
+  }
+  if (__format_spec::__parse_alignment(*__begin, __spec))
+    ++__begin;
+  return __begin;
+}
+
+/// Parses the arg-id of a nested replacement field; __begin is past its '{'.
+template <class _Iterator, class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr _Iterator
+__parse_nested_arg_id(_Iterator __begin, _Iterator __end, basic_format_parse_context<_CharT>& __ctx, uint32_t& __id) {
+  if (__begin == __end)
+    __throw_format_error("End of input while parsing format-spec arg-id");
+  if (*__begin == _CharT(':'))
+    __throw_format_error("The format-spec arg-id is invalid");
+  __begin = __format::__parse_arg_id(__begin, __end, __ctx, __id);
+  if (__begin == __end || *__begin != _CharT('}'))
+    __throw_format_error("Invalid arg-id");
+  return __begin + 1;
+}
+
+_LIBCPP_HIDE_FROM_ABI constexpr __type __parse_type(char __c) noexcept {
+  switch (__c) {
+  case 'b':
+    return __type::__binary_lower_case;
+  case 'B':
+    return __type::__binary_upper_case;
+  case 'c':
+    return __type::__char;
+  case 'd':
+    return __type::__decimal;
+  case 'o':
+    return __type::__octal;
+  case 'x':
+    return __type::__hexadecimal_lower_case;
+  case 'X':
+    return __type::__hexadecimal_upper_case;
+  case 'a':
+    return __type::__hexfloat_lower_case;
+  case 'A':
+    return __type::__hexfloat_upper_case;
+  case 'e':
+    return __type::__scientific_lower_case;
+  case 'E':
+    return __type::__scientific_upper_case;
+  case 'f':
+    return __type::__fixed_lower_case;
+  case 'F':
+    return __type::__fixed_upper_case;
+  case 'g':
+    return __type::__general_lower_case;
+  case 'G':
+    return __type::__general_upper_case;
+  case 'p':
+    return __type::__pointer;
+  case 's':
+    return __type::__string;
+  }
+  return __type::__default;
+}
+
+_LIBCPP_HIDE_FROM_ABI constexpr bool __is_integer_type(__type __t) noexcept {
+  switch (__t) {
+  case __type::__binary_lower_case:
+  case __type::__binary_upper_case:
+  case __type::__octal:
+  case __type::__decimal:
+  case __type::__hexadecimal_lower_case:
+  case __type::__hexadecimal_upper_case:
+    return true;
+  default:
+    return false;
+  }
+}
+
+_LIBCPP_HIDE_FROM_ABI constexpr bool __is_floating_point_type(__type __t) noexcept {
+  return __t >= __type::__hexfloat_lower_case && __t <= __type::__general_upper_case;
+}
+
+/// Validates the options of __spec for an argument of category __cat.
+template <class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr void
+__validate(__category __cat, const __parsed_specifications<_CharT>& __spec, bool __zero_padding) {
+  const __type __t = __spec.__type_;
+  // Whether the value is written as text rather than as a number.
+  bool __textual;
+  switch (__cat) {
+  case __category::__bool:
+    if (__t != __type::__default && __t != __type::__string && __t != __type::__char && !__is_integer_type(__t))
+      __throw_format_error("The format-spec type has a type not supported for a bool argument");
+    __textual = __t == __type::__default || __t == __type::__string || __t == __type::__char;
+    break;
+  case __category::__char:
+    if (__t != __type::__default && __t != __type::__char && !__is_integer_type(__t))
+      __throw_format_error("The format-spec type has a type not supported for a char argument");
+    __textual = __t == __type::__default || __t == __type::__char;
+    break;
+  case __category::__integer:
+    if (__t != __type::__default && __t != __type::__char && !__is_integer_type(__t))
+      __throw_format_error("The format-spec type has a type not supported for an integer argument");
+    __textual = __t == __type::__char;
+    break;
+  case __category::__floating_point:
+    if (__t != __type::__default && !__is_floating_point_type(__t))
+      __throw_format_error("The format-spec type has a type not supported for a floating-point argument");
+    __textual = false;
+    break;
+  case __category::__string:
+    if (__t != __type::__default && __t != __type::__string)
+      __throw_format_error("The format-spec type has a type not supported for a string argument");
+    __textual = true;
+    break;
+  case __category::__pointer:
+    if (__t != __type::__default && __t != __type::__pointer)
+      __throw_format_error("The format-spec type has a type not supported for a pointer argument");
+    __textual = true;
+    break;
+  }
+
+  if (__textual) {
+    if (__spec.__sign_ != __sign::__default)
+      __throw_format_error("A sign field isn't allowed in this format-spec");
+    if (__spec.__alternate_form_)
+      __throw_format_error("An alternate form field isn't allowed in this format-spec");
+    if (__zero_padding)
+      __throw_format_error("A zero-padding field isn't allowed in this format-spec");
+  }
+  if (__spec.__has_precision() && __cat != __category::__floating_point && __cat != __category::__string)
+    __throw_format_error("A precision field isn't allowed in this format-spec");
+  if (__spec.__locale_specific_form_ && (__cat == __category::__string || __cat == __category::__pointer))
+    __throw_format_error("A locale-specific form field isn't allowed in this format-spec");
+}
+
+/// Parses a std-format-spec for an argument of category __cat.
+///
+/// [format.string.std]:
+///   std-format-spec ::= [[fill] align] [sign] ['#'] ['0'] [width] ['.' precision] ['L'] [type]
+template <class _CharT>
+_LIBCPP_HIDE_FROM_ABI constexpr typename basic_format_parse_context<_CharT>::iterator
+__parse(basic_format_parse_context<_CharT>& __ctx, __category __cat, __parsed_specifications<_CharT>& __spec) {
+  auto __begin = __ctx.begin();
+  auto __end = __ctx.end();
+  if (__begin == __end || *__begin == _CharT('}'))
+    return __begin;
+
+  __begin = __format_spec::__parse_fill_align(__begin, __end, __spec);
+
+  if (__begin != __end) {
+    switch (*__begin) {
+    case _CharT('-'):
+      __spec.__sign_ = __sign::__minus;
+      ++__begin;
+      break;
+    case _CharT('+'):
+      __spec.__sign_ = __sign::__plus;
+      ++__begin;
+      break;
+    case _CharT(' '):
+      __spec.__sign_ = __sign::__space;
+      ++__begin;
+      break;
+    }
+  }
+
+  if (__begin != __end && *__begin == _CharT('#')) {
+    __spec.__alternate_form_ = true;
+    ++__begin;
+  }
+
+  bool __zero_padding = false;
+  if (__begin != __end && *__begin == _CharT('0')) {
+    __zero_padding = true;
+    // [format.string.std]/7: if the 0 character and an align option both
+    // appear, the 0 character is ignored.
+    if (__spec.__alignment_ == __alignment::__default)
+      __spec.__alignment_ = __alignment::__zero_padding;
+    ++__begin;
+  }
+
+  if (__begin != __end) {
+    if (*__begin == _CharT('{')) {
+      __begin = __format_spec::__parse_nested_arg_id(__begin + 1, __end, __ctx, __spec.__width_);
+      __spec.__width_as_arg_ = true;
+    } else if (*__begin == _CharT('0'))
+      __throw_format_error("A format-spec width field shouldn't have a leading zero");
+    else if (__format::__is_digit(*__begin))
+      __begin = __format::__parse_number(__begin, __end, __spec.__width_);
+  }
+
+  if (__begin != __end && *__begin == _CharT('.')) {
+    ++__begin;
+    if (__begin == __end)
+      __throw_format_error("End of input while parsing format-spec precision");
+    uint32_t __precision = 0;
+    if (*__begin == _CharT('{')) {
+      __begin = __format_spec::__parse_nested_arg_id(__begin + 1, __end, __ctx, __precision);
+      __spec.__precision_as_arg_ = true;
+    } else if (__format::__is_digit(*__begin))
+      __begin = __format::__parse_number(__begin, __end, __precision);
+    else
+      __throw_format_error("The format-spec precision field doesn't contain a value or arg-id");
+    __spec.__precision_ = static_cast<int32_t>(__precision);
+  }
+
+  if (__begin != __end && *__begin == _CharT('L')) {
+    __spec.__locale_specific_form_ = true;
+    ++__begin;
+  }
+
+  if (__begin != __end && *__begin != _CharT('}') && static_cast<char>(*__begin) == *__begin) {
+    __spec.__type_ = __format_spec::__parse_type(static_cast<char>(*__begin));
+    if (__spec.__type_ != __type::__default)
+      ++__begin;
+  }
+
+  if (__begin != __end && *__begin != _CharT('}'))
+    __throw_format_error("The format-spec should consume the input or end with a '}'");
+
+  __format_spec::__validate(__cat, __spec, __zero_padding);
+  return __begin;
+}
+
+/// Returns the value of the argument an arg-id in a std-format-spec refers to.
+template <class _Context>
+_LIBCPP_HIDE_FROM_ABI uint32_t __substitute_arg_id(basic_format_arg<_Context> __arg) {
+  auto __check = [](auto __value) -> uint32_t {
+    if constexpr (is_signed_v<decltype(__value)>)
+      if (__value < 0)
+        __throw_format_error("A format-spec arg-id replacement shouldn't have a negative value");
+    if (static_cast<make_unsigned_t<decltype(__value)>>(__value) > __format::__number_max)
+      __throw_format_error("A format-spec arg-id replacement exceeds the maximum supported value");
+    return static_cast<uint32_t>(__value);
+  };
+  switch (__arg.__type_) {
+  case __format::__arg_t::__int:
+    return __check(__arg.__value_.__int_);
+  case __format::__arg_t::__long_long:
+    return __check(__arg.__value_.__long_long_);
+  case __format::__arg_t::__unsigned:
+    return __check(__arg.__value_.__unsigned_);
+  case __format::__arg_t::__unsigned_long_long:
+    return __check(__arg.__value_.__unsigned_long_long_);
+#ifndef _LIBCPP_HAS_NO_INT128
+  case __format::__arg_t::__i128:
+    return __check(__arg.__value_.__i128_);
+  case __format::__arg_t::__u128:
+    return __check(__arg.__value_.__u128_);
+#endif
+  case __format::__arg_t::__none:
+    __throw_format_error("Argument index out of bounds");
+  default:
+    __throw_format_error("A format-spec arg-id replacement argument isn't an integral type");
+  }
+}
+
+/// Replaces the arg-ids in __spec by the values of their arguments.
+template <class _CharT, class _Context>
+_LIBCPP_HIDE_FROM_ABI void __substitute_arg_ids(__parsed_specifications<_CharT>& __spec, const _Context& __ctx) {
+  if (__spec.__width_as_arg_) {
+    __spec.__width_ = __format_spec::__substitute_arg_id(__ctx.arg(__spec.__width_));
+    __spec.__width_as_arg_ = false;
+  }
+  if (__spec.__precision_as_arg_) {
+    __spec.__precision_ = static_cast<int32_t>(__format_spec::__substitute_arg_id(__ctx.arg(__spec.__precision_)));
+    __spec.__precision_as_arg_ = false;
+  }
+}
+
+} // namespace __format_spec
+
+#endif // !defined(_LIBCPP_HAS_NO_CONCEPTS)
+
+#endif //_LIBCPP_STD_VER > 17
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___FORMAT_PARSER_STD_FORMAT_SPEC_H
@@ -0,0 +1,246 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___MEMORY_RESOURCE_POLYMORPHIC_ALLOCATOR_H
+#define _LIBCPP___MEMORY_RESOURCE_POLYMORPHIC_ALLOCATOR_H
+
+#include <__availability>
+#include <__config>
+#include <__debug>
+#include <__functional_base>
+#include <__memory_resource/memory_resource.h>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 14
+
+namespace pmr
+{
+
+// [mem.poly.allocator.class]
+
+template <class _ValueType
+#if _LIBCPP_STD_VER > 17
+          = byte
+#endif
+          >
+class _LIBCPP_TEMPLATE_VIS _LIBCPP_AVAILABILITY_PMR polymorphic_allocator
+{
+public:
+  typedef _ValueType value_type;
+
+  // [mem.poly.allocator.ctor]
+
+  _LIBCPP_INLINE_VISIBILITY
+  polymorphic_allocator() noexcept : __res_(_VSTD::pmr::get_default_resource()) {}
+
+  _LIBCPP_INLINE_VISIBILITY
+  polymorphic_allocator(memory_resource* __r) noexcept : __res_(__r)
+  { _LIBCPP_ASSERT(__r != nullptr, "polymorphic_allocator requires a non-null memory resource"); }
+
+  polymorphic_allocator(const polymorphic_allocator&) = default;
+
+  template <class _Tp>
+  _LIBCPP_INLINE_VISIBILITY
+  polymorphic_allocator(const polymorphic_allocator<_Tp>& __other) noexcept : __res_(__other.resource()) {}
+
+  polymorphic_allocator& operator=(const polymorphic_allocator&) = delete;
+
+  // [mem.poly.allocator.mem]
+
+  _LIBCPP_NODISCARD_AFTER_CXX17 _LIBCPP_INLINE_VISIBILITY
+  _ValueType* allocate(size_t __n)
+  {
+    if (__n > __max_size())
+      __throw_bad_array_new_length();
+    return static_cast<_ValueType*>(__res_->allocate(__n * sizeof(_ValueType), alignof(_ValueType)));
+  }
+
+  _LIBCPP_INLINE_VISIBILITY
+  void deallocate(_ValueType* __p, size_t __n) noexcept
+  {
+    _LIBCPP_ASSERT(__n <= __max_size(), "deallocate called for size which exceeds max_size()");
+    __res_->deallocate(__p, __n * sizeof(_ValueType), alignof(_ValueType));
+  }
+
+#if _LIBCPP_STD_VER > 17
+  _LIBCPP_NODISCARD_ATTRIBUTE _LIBCPP_INLINE_VISIBILITY
+  void* allocate_bytes(size_t __nbytes, size_t __alignment = alignof(max_align_t))
+  { return __res_->allocate(__nbytes, __alignment); }
+
+  _LIBCPP_INLINE_VISIBILITY
+  void deallocate_bytes(void* __p, size_t __nbytes, size_t __alignment = alignof(max_align_t))
+  { __res_->deallocate(__p, __nbytes, __alignment); }
+
+  template <class _Tp>
+  _LIBCPP_NODISCARD_ATTRIBUTE _LIBCPP_INLINE_VISIBILITY
+  _Tp* allocate_object(size_t __n = 1)
+  {
+    if (numeric_limits<size_t>::max() / sizeof(_Tp) < __n)
+      __throw_bad_array_new_length();
+    return static_cast<_Tp*>(allocate_bytes(__n * sizeof(_Tp), alignof(_Tp)));
+  }
+
+  template <class _Tp>
+  _LIBCPP_INLINE_VISIBILITY
+  void deallocate_object(_Tp* __p, size_t __n = 1)
+  { deallocate_bytes(__p, __n * sizeof(_Tp), alignof(_Tp)); }
+
+  template <class _Tp, class... _CtorArgs>
+  _LIBCPP_NODISCARD_ATTRIBUTE _LIBCPP_INLINE_VISIBILITY
+  _Tp* new_object(_CtorArgs&&... __ctor_args)
+  {
+    _Tp* __p = allocate_object<_Tp>();
+#ifndef _LIBCPP_NO_EXCEPTIONS
+    try {
+#endif
+      construct(__p, _VSTD::forward<_CtorArgs>(__ctor_args)...);
+#ifndef _LIBCPP_NO_EXCEPTIONS
+    } catch (...) {
+      deallocate_object(__p);
+      throw;
+    }
+#endif
+    return __p;
+  }
+
+  template <class _Tp>
+  _LIBCPP_INLINE_VISIBILITY
+  void delete_object(_Tp* __p)
+  {
+    destroy(__p);
+    deallocate_object(__p);
+  }
+#endif // _LIBCPP_STD_VER > 17
+
+  template <class _Tp, class... _Args>
+  _LIBCPP_INLINE_VISIBILITY
+  void construct(_Tp* __p, _Args&&... __args)
+  {
+    _VSTD::__user_alloc_construct_impl(__uses_alloc_ctor<_Tp, polymorphic_allocator&, _Args...>(), __p, *this,
+                                       _VSTD::forward<_Args>(__args)...);
+  }
+
+  template <class _T1, class _T2, class... _Args1, class... _Args2>
+  _LIBCPP_INLINE_VISIBILITY
+  void construct(pair<_T1, _T2>* __p, piecewise_construct_t, tuple<_Args1...> __x, tuple<_Args2...> __y)
+  {
+    ::new ((void*)__p) pair<_T1, _T2>(
+        piecewise_construct,
+        __transform_tuple(typename __uses_alloc_ctor<_T1, polymorphic_allocator&, _Args1...>::type(),
+                          _VSTD::move(__x), typename __make_tuple_indices<sizeof...(_Args1)>::type{}),
+        __transform_tuple(typename __uses_alloc_ctor<_T2, polymorphic_allocator&, _Args2...>::type(),
+                          _VSTD::move(__y), typename __make_tuple_indices<sizeof...(_Args2)>::type{}));
+  }
+
+  template <class _T1, class _T2>
+  _LIBCPP_INLINE_VISIBILITY
+  void construct(pair<_T1, _T2>* __p)
+  { construct(__p, piecewise_construct, tuple<>(), tuple<>()); }
+
+  template <class _T1, class _T2, class _Up, class _Vp>
+  _LIBCPP_INLINE_VISIBILITY
+  void construct(pair<_T1, _T2>* __p, _Up&& __u, _Vp&& __v)
+  {
+    construct(__p, piecewise_construct, _VSTD::forward_as_tuple(_VSTD::forward<_Up>(__u)),
+              _VSTD::forward_as_tuple(_VSTD::forward<_Vp>(__v)));
+  }
+
+  template <class _T1, class _T2, class _U1, class _U2>
+  _LIBCPP_INLINE_VISIBILITY
+  void construct(pair<_T1, _T2>* __p, const pair<_U1, _U2>& __pr)
+  {
+    construct(__p, piecewise_construct, _VSTD::forward_as_tuple(__pr.first), _VSTD::forward_as_tuple(__pr.second));
+  }
+
+  template <class _T1, class _T2, class _U1, class _U2>
+  _LIBCPP_INLINE_VISIBILITY
+  void construct(pair<_T1, _T2>* __p, pair<_U1, _U2>&& __pr)
+  {
+    construct(__p, piecewise_construct, _VSTD::forward_as_tuple(_VSTD::forward<_U1>(__pr.first)),
+              _VSTD::forward_as_tuple(_VSTD::forward<_U2>(__pr.second)));
+  }
+
+  template <class _Tp>
+  _LIBCPP_INLINE_VISIBILITY
+  void destroy(_Tp* __p)
+  { __p->~_Tp(); }
+
+  _LIBCPP_INLINE_VISIBILITY
+  polymorphic_allocator select_on_container_copy_construction() const noexcept
+  { return polymorphic_allocator(); }
+
+  _LIBCPP_INLINE_VISIBILITY
+  memory_resource* resource() const noexcept
+  { return __res_; }
+
+private:
+  template <class... _Args, size_t... _Is>
+  _LIBCPP_INLINE_VISIBILITY
+  tuple<_Args&&...> __transform_tuple(integral_constant<int, 0>, tuple<_Args...>&& __t, __tuple_indices<_Is...>)
+  { return _VSTD::forward_as_tuple(_VSTD::get<_Is>(_VSTD::move(__t))...); }
+
+  template <class... _Args, size_t... _Is>
+  _LIBCPP_INLINE_VISIBILITY
+  tuple<allocator_arg_t const&, polymorphic_allocator&, _Args&&...>
+  __transform_tuple(integral_constant<int, 1>, tuple<_Args...>&& __t, __tuple_indices<_Is...>)
+  {
+    using _Tup = tuple<allocator_arg_t const&, polymorphic_allocator&, _Args&&...>;
+    return _Tup(allocator_arg, *this, _VSTD::get<_Is>(_VSTD::move(__t))...);
+  }
+
+  template <class... _Args, size_t... _Is>
+  _LIBCPP_INLINE_VISIBILITY
+  tuple<_Args&&..., polymorphic_allocator&>
+  __transform_tuple(integral_constant<int, 2>, tuple<_Args...>&& __t, __tuple_indices<_Is...>)
+  {
+    using _Tup = tuple<_Args&&..., polymorphic_allocator&>;
+    return _Tup(_VSTD::get<_Is>(_VSTD::move(__t))..., *this);
+  }
+
+  _LIBCPP_INLINE_VISIBILITY
+  static constexpr size_t __max_size() noexcept
+  { return numeric_limits<size_t>::max() / sizeof(_ValueType); }
+
+  memory_resource* __res_;
+};
+
+// [mem.poly.allocator.eq]
+
+template <class _Tp, class _Up>
+inline _LIBCPP_INLINE_VISIBILITY
+bool operator==(const polymorphic_allocator<_Tp>& __lhs, const polymorphic_allocator<_Up>& __rhs) noexcept
+{ return *__lhs.resource() == *__rhs.resource(); }
+
+template <class _Tp, class _Up>
+inline _LIBCPP_INLINE_VISIBILITY
+bool operator!=(const polymorphic_allocator<_Tp>& __lhs, const polymorphic_allocator<_Up>& __rhs) noexcept
+{ return !(__lhs == __rhs); }
+
+} // namespace pmr
+
+#endif // _LIBCPP_STD_VER > 14
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___MEMORY_RESOURCE_POLYMORPHIC_ALLOCATOR_H
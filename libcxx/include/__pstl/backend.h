@@ -0,0 +1,245 @@
+// -*- C++ -*-
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP___PSTL_BACKEND_H
+#define _LIBCPP___PSTL_BACKEND_H
+
+#include <__availability>
+#include <__config>
+#include <__iterator/iterator_traits.h>
+#include <__pstl_execution>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
+#pragma GCC system_header
+#endif
+
+_LIBCPP_PUSH_MACROS
+#include <__undef_macros>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+#if _LIBCPP_STD_VER > 14
+
+namespace __pstl
+{
+
+// Interface to the thread pool in the library (see src/parallel_algorithms.cpp).
+
+// Calls __fn(__ctx, __first, __last) on disjoint subranges covering
+// [0, __chunks) and returns once every index has been processed. The calling
+// thread takes part; idle pool threads steal indices from busy ones. If the
+// pool is already running a job, for instance because of a nested call, the
+// whole range is processed on the calling thread.
+_LIBCPP_FUNC_VIS _LIBCPP_AVAILABILITY_PARALLEL_ALGORITHMS
+void __parallel_for_chunks(size_t __chunks, void (*__fn)(void*, size_t, size_t), void* __ctx);
+
+// Returns the number of threads that take part in a parallel algorithm,
+// including the calling thread.
+_LIBCPP_FUNC_VIS _LIBCPP_AVAILABILITY_PARALLEL_ALGORITHMS
+unsigned __thread_count() noexcept;
+
+// Whether a call with the given policy and iterators runs on the thread pool.
+// Other calls run the serial algorithm on the calling thread.
+template <class _ExecutionPolicy, class... _Iterators>
+inline constexpr bool __run_in_parallel =
+    __is_parallel_execution_policy<__uncvref_t<_ExecutionPolicy> >::value &&
+    (__is_cpp17_random_access_iterator<_Iterators>::value && ...);
+
+// Below this many elements per chunk, the synchronization costs more than
+// running in parallel saves for cheap element access functions.
+inline constexpr size_t __default_grain_size = 1024;
+
+// Splitting the work into several chunks per thread lets stealing even out
+// chunks that take longer than others.
+inline constexpr size_t __default_chunks_per_thread = 8;
+
+// [0, __n_) split into __k_ nearly equal, non-empty chunks.
+struct __chunk_partition
+{
+  size_t __n_;
+  size_t __k_;
+
+  _LIBCPP_INLINE_VISIBILITY
+  size_t __begin(size_t __i) const noexcept
+  {
+    const size_t __base = __n_ / __k_;
+    const size_t __rem = __n_ % __k_;
+    return __i * __base + (__i < __rem ? __i : __rem);
+  }
+
+  _LIBCPP_INLINE_VISIBILITY
+  size_t __end(size_t __i) const noexcept { return __begin(__i + 1); }
+};
+
+_LIBCPP_INLINE_VISIBILITY _LIBCPP_AVAILABILITY_PARALLEL_ALGORITHMS
+inline __chunk_partition __partition(size_t __n, size_t __grain = __default_grain_size,
+                                     size_t __chunks_per_thread = __default_chunks_per_thread)
+{
+  size_t __k = 1;
+  if (__n >= 2 * __grain) {
+    const size_t __threads = __pstl::__thread_count();
+    if (__threads > 1) {
+      __k = __n / __grain;
+      if (__k > __threads * __chunks_per_thread)
+        __k = __threads * __chunks_per_thread;
+    }
+  }
+  return __chunk_partition{__n, __k};
+}
+
+// Calls __f(__i) for every __i in [0, __k). Element access functions that
+// throw terminate the program, as [algorithms.parallel.exceptions] requires.
+template <class _Func>
+_LIBCPP_INLINE_VISIBILITY _LIBCPP_AVAILABILITY_PARALLEL_ALGORITHMS
+void __for_each_chunk(size_t __k, _Func& __f)
+{
+  if (__k == 1) {
+    [&]() noexcept { __f(0); }();
+    return;
+  }
+  __pstl::__parallel_for_chunks(
+      __k,
+      [](void* __ctx, size_t __first, size_t __last) noexcept {
+        _Func& __fn = *static_cast<_Func*>(__ctx);
+        for (; __first != __last; ++__first)
+          __fn(__first);
+      },
+      _VSTD::addressof(__f));
+}
+
+// Uninitialized storage for one value per chunk. Every element must have been
+// constructed before the array is destroyed.
+template <class _Tp>
+class __chunk_results
+{
+  allocator<_Tp> __alloc_;
+  _Tp* __data_;
+  size_t __size_;
+
+public:
+  _LIBCPP_INLINE_VISIBILITY
+  explicit __chunk_results(size_t __size) : __data_(__alloc_.allocate(__size)), __size_(__size) {}
+
+  __chunk_results(const __chunk_results&) = delete;
+  __chunk_results& operator=(const __chunk_results&) = delete;
+
+  _LIBCPP_INLINE_VISIBILITY
+  ~__chunk_results()
+  {
+    for (size_t __i = 0; __i != __size_; ++__i)
+      __data_[__i].~_Tp();
+    __alloc_.deallocate(__data_, __size_);
+  }
+
+  template <class... _Args>
+  _LIBCPP_INLINE_VISIBILITY
+  void __construct(size_t __i, _Args&&... __args)
+  { ::new ((void*)(__data_ + __i)) _Tp(_VSTD::forward<_Args>(__args)...); }
+
+  _LIBCPP_INLINE_VISIBILITY
+  _Tp& operator[](size_t __i) noexcept { return __data_[__i]; }
+};
+
+// Calls __f(__b, __e) on subranges covering [__first, __last).
+template <class _RandomAccessIterator, class _Func>
+_LIBCPP_INLINE_VISIBILITY _LIBCPP_AVAILABILITY_PARALLEL_ALGORITHMS
+void __parallel_for(_RandomAccessIterator __first, _RandomAccessIterator __last, _Func __f)
+{
+  const __chunk_partition __p = __pstl::__partition(__last - __first);
+  auto __body = [&](size_t __i) { __f(__first + __p.__begin(__i), __first + __p.__end(__i)); };
+  __pstl::__for_each_chunk(__p.__k_, __body);
+}
+
+// Returns __init combined with __fold(__b, __e) over subranges covering
+// [0, __n). __fold is only called on non-empty subranges.
+template <class _Tp, class _Reduce, class _Fold>
+_LIBCPP_INLINE_VISIBILITY _LIBCPP_AVAILABILITY_PARALLEL_ALGORITHMS
+_Tp __parallel_reduce(size_t __n, _Tp __init, _Reduce __reduce, _Fold __fold)
+{
+  if (__n == 0)
+    return __init;
+  const __chunk_partition __p = __pstl::__partition(__n);
+  __chunk_results<_Tp> __partials(__p.__k_);
+  auto __body = [&](size_t __i) { __partials.__construct(__i, __fold(__p.__begin(__i), __p.__end(__i))); };
+  __pstl::__for_each_chunk(__p.__k_, __body);
+  for (size_t __i = 0; __i != __p.__k_; ++__i)
+    __init = __reduce(_VSTD::move(__init), _VSTD::move(__partials[__i]));
+  return __init;
+}
+
+// Inclusive scan of [__first, __last) into __result in two parallel passes:
+// the first reduces each chunk, the second rescans each chunk starting from
+// the combined value of the chunks before it. The ranges may be equal.
+template <class _Tp, class _RandomAccessIterator1, class _RandomAccessIterator2, class _BinaryOp>
+_LIBCPP_INLINE_VISIBILITY _LIBCPP_AVAILABILITY_PARALLEL_ALGORITHMS
+_RandomAccessIterator2 __parallel_inclusive_scan(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+                                                 _RandomAccessIterator2 __result, _BinaryOp __op,
+                                                 const _Tp* __init)
+{
+  const size_t __n = __last - __first;
+  if (__n == 0)
+    return __result;
+  const __chunk_partition __p = __pstl::__partition(__n);
+
+  __chunk_results<_Tp> __carries(__p.__k_);
+  auto __reduce_chunk = [&](size_t __i) {
+    size_t __b = __p.__begin(__i);
+    const size_t __e = __p.__end(__i);
+    _Tp __acc = __first[__b];
+    for (++__b; __b != __e; ++__b)
+      __acc = __op(_VSTD::move(__acc), __first[__b]);
+    __carries.__construct(__i, _VSTD::move(__acc));
+  };
+  if (__p.__k_ > 1)
+    __pstl::__for_each_chunk(__p.__k_, __reduce_chunk);
+
+  // Turn the chunk totals into the value carried into each chunk. Without an
+  // initial value, the first chunk carries nothing in.
+  if (__p.__k_ > 1) {
+    _Tp __carry = __init != nullptr ? __op(*__init, _VSTD::move(__carries[0])) : _VSTD::move(__carries[0]);
+    if (__init != nullptr)
+      __carries[0] = *__init;
+    for (size_t __i = 1; __i != __p.__k_; ++__i) {
+      _Tp __total = _VSTD::move(__carries[__i]);
+      __carries[__i] = __carry;
+      __carry = __op(_VSTD::move(__carry), _VSTD::move(__total));
+    }
+  } else if (__init != nullptr) {
+    __carries.__construct(0, *__init);
+  } else {
+    __carries.__construct(0, __first[0]);
+  }
+
+  auto __scan_chunk = [&](size_t __i) {
+    size_t __b = __p.__begin(__i);
+    const size_t __e = __p.__end(__i);
+    _Tp __acc = (__i == 0 && __init == nullptr) ? _Tp(__first[__b]) : __op(__carries[__i], __first[__b]);
+    __result[__b] = __acc;
+    for (++__b; __b != __e; ++__b) {
+      __acc = __op(_VSTD::move(__acc), __first[__b]);
+      __result[__b] = __acc;
+    }
+  };
+  __pstl::__for_each_chunk(__p.__k_, __scan_chunk);
+  return __result + __n;
+}
+
+} // namespace __pstl
+
+#endif // _LIBCPP_STD_VER > 14
+
+_LIBCPP_END_NAMESPACE_STD
+
+_LIBCPP_POP_MACROS
+
+#endif // _LIBCPP___PSTL_BACKEND_H
@@ -7,8 +7,17 @@
 //===----------------------------------------------------------------------===//
 
 #include "charconv"
+#include <cfloat>
 #include <string.h>
 
+#include "include/from_chars_floating_point.h"
+#include "include/to_chars_floating_point.h"
+
+#if defined(_LIBCPP_CHARCONV_LONG_DOUBLE_EXTENDED) && !defined(_LIBCPP_HAS_NO_LOCALIZATION)
+#  include "locale"
+#  include "memory"
+#endif
+
 _LIBCPP_BEGIN_NAMESPACE_STD
 
 namespace __itoa
@@ -157,4 +166,124 @@ __u64toa(uint64_t value, char* buffer) noexcept
 
 }  // namespace __itoa
 
+// The floating-point overloads. A negative precision is ignored, as it is by
+// printf.
+
+to_chars_result to_chars(char* __first, char* __last, float __value) {
+  return __charconv::__floating_to_chars(__first, __last, __value, chars_format{}, -1);
+}
+
+to_chars_result to_chars(char* __first, char* __last, double __value) {
+  return __charconv::__floating_to_chars(__first, __last, __value, chars_format{}, -1);
+}
+
+to_chars_result to_chars(char* __first, char* __last, float __value, chars_format __fmt) {
+  return __charconv::__floating_to_chars(__first, __last, __value, __fmt, -1);
+}
+
+to_chars_result to_chars(char* __first, char* __last, double __value, chars_format __fmt) {
+  return __charconv::__floating_to_chars(__first, __last, __value, __fmt, -1);
+}
+
+to_chars_result to_chars(char* __first, char* __last, float __value, chars_format __fmt, int __precision) {
+  if (__precision < 0)
+    __precision = __fmt == chars_format::hex ? -1 : 6;
+  return __charconv::__floating_to_chars(__first, __last, __value, __fmt, __precision);
+}
+
+to_chars_result to_chars(char* __first, char* __last, double __value, chars_format __fmt, int __precision) {
+  if (__precision < 0)
+    __precision = __fmt == chars_format::hex ? -1 : 6;
+  return __charconv::__floating_to_chars(__first, __last, __value, __fmt, __precision);
+}
+
+// long double is handled natively when it is the x87 extended format or
+// binary128. Any other format is either the same as double or one the
+// implementation does not know (such as IBM double-double), which is
+// converted through double.
+#if defined(_LIBCPP_CHARCONV_LONG_DOUBLE_EXTENDED)
+using __to_chars_long_double = long double;
+#else
+using __to_chars_long_double = double;
+#endif
+
+to_chars_result to_chars(char* __first, char* __last, long double __value) {
+  return __charconv::__floating_to_chars(__first, __last, static_cast<__to_chars_long_double>(__value),
+                                         chars_format{}, -1);
+}
+
+to_chars_result to_chars(char* __first, char* __last, long double __value, chars_format __fmt) {
+  return __charconv::__floating_to_chars(__first, __last, static_cast<__to_chars_long_double>(__value), __fmt, -1);
+}
+
+to_chars_result to_chars(char* __first, char* __last, long double __value, chars_format __fmt, int __precision) {
+  if (__precision < 0)
+    __precision = __fmt == chars_format::hex ? -1 : 6;
+  return __charconv::__floating_to_chars(__first, __last, static_cast<__to_chars_long_double>(__value), __fmt,
+                                         __precision);
+}
+
+from_chars_result from_chars(const char* __first, const char* __last, float& __value, chars_format __fmt) {
+  return __charconv::__floating_from_chars(__first, __last, __value, __fmt);
+}
+
+from_chars_result from_chars(const char* __first, const char* __last, double& __value, chars_format __fmt) {
+  return __charconv::__floating_from_chars(__first, __last, __value, __fmt);
+}
+
+from_chars_result from_chars(const char* __first, const char* __last, long double& __value, chars_format __fmt) {
+  // The double parser determines the extent of the match, which does not
+  // depend on the type.
+  double __d;
+  from_chars_result __r = __charconv::__floating_from_chars(__first, __last, __d, __fmt);
+#if defined(_LIBCPP_CHARCONV_LONG_DOUBLE_EXTENDED) && !defined(_LIBCPP_HAS_NO_LOCALIZATION)
+  if (__r.ec == errc::invalid_argument)
+    return __r;
+  // strtold needs a null-terminated copy of the match, with the "0x" prefix
+  // for hexadecimal input other than infinities and NaNs.
+  const bool __negative = *__first == '-';
+  const char* __digits = __first + __negative;
+  const bool __special = *__digits == 'i' || *__digits == 'I' || *__digits == 'n' || *__digits == 'N';
+  const bool __hex = __fmt == chars_format::hex;
+  const size_t __size = static_cast<size_t>(__r.ptr - __first) + 3;
+  char __small[128];
+  unique_ptr<char[]> __large;
+  char* __buffer = __small;
+  if (__size > sizeof(__small)) {
+    __large.reset(new char[__size]);
+    __buffer = __large.get();
+  }
+  char* __p = __buffer;
+  if (__negative)
+    *__p++ = '-';
+  if (__hex && !__special) {
+    *__p++ = '0';
+    *__p++ = 'x';
+  }
+  _VSTD::memcpy(__p, __digits, static_cast<size_t>(__r.ptr - __digits));
+  __p[__r.ptr - __digits] = '\0';
+  const long double __ld = _VSTD::__do_strtod<long double>(__buffer, &__p);
+
+  // A finite input that rounds to zero or infinity is out of range. 'e' is a
+  // digit in hexadecimal input, whose exponent starts with 'p'.
+  bool __nonzero = false;
+  for (const char* __i = __digits; !__special && __i != __r.ptr; ++__i) {
+    const char __c = *__i;
+    if (__hex ? __c == 'p' || __c == 'P' : __c == 'e' || __c == 'E')
+      break;
+    __nonzero |= __c != '0' && __c != '.';
+  }
+  if (!__special && (__ld == numeric_limits<long double>::infinity() || __ld == -numeric_limits<long double>::infinity() ||
+                     (__nonzero && __ld == 0)))
+    return {__r.ptr, errc::result_out_of_range};
+  __value = __ld;
+  return {__r.ptr, errc{}};
+#else
+  // long double is double, or a format whose parsing is left to double.
+  if (__r.ec == errc{})
+    __value = __d;
+  return __r;
+#endif
+}
+
 _LIBCPP_END_NAMESPACE_STD
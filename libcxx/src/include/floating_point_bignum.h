@@ -0,0 +1,256 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP_SRC_INCLUDE_FLOATING_POINT_BIGNUM_H
+#define _LIBCPP_SRC_INCLUDE_FLOATING_POINT_BIGNUM_H
+
+// A minimal fixed-capacity unsigned big integer used by the exact (slow) paths
+// of the floating-point <charconv> functions: conversions with an explicit
+// precision, long double shortest conversions, and the from_chars fallback when
+// the Eisel-Lemire approximation cannot decide the rounding.
+//
+// The capacity is a template parameter chosen by the caller from the exponent
+// range of the floating-point type, so no operation ever allocates. Exceeding
+// the capacity is a logic error in the caller.
+
+#include "__config"
+#include "__debug"
+#include <cstddef>
+#include <cstdint>
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __charconv {
+
+template <size_t _Bits>
+class __big_uint {
+public:
+  static constexpr size_t __capacity = (_Bits + 31) / 32;
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint() : __size_(0) {}
+
+  _LIBCPP_INLINE_VISIBILITY explicit __big_uint(uint64_t __v) { __assign(__v); }
+
+  // Only the limbs in use are copied; the capacity can be several kilobytes.
+  _LIBCPP_INLINE_VISIBILITY __big_uint(const __big_uint& __other) : __size_(__other.__size_) {
+    for (size_t __i = 0; __i < __size_; ++__i)
+      __limbs_[__i] = __other.__limbs_[__i];
+  }
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint& operator=(const __big_uint& __other) {
+    __size_ = __other.__size_;
+    for (size_t __i = 0; __i < __size_; ++__i)
+      __limbs_[__i] = __other.__limbs_[__i];
+    return *this;
+  }
+
+  _LIBCPP_INLINE_VISIBILITY void __assign(uint64_t __v) {
+    __limbs_[0] = static_cast<uint32_t>(__v);
+    __limbs_[1] = static_cast<uint32_t>(__v >> 32);
+    __size_ = __limbs_[1] != 0 ? 2 : (__limbs_[0] != 0 ? 1 : 0);
+  }
+
+#ifndef _LIBCPP_HAS_NO_INT128
+  _LIBCPP_INLINE_VISIBILITY void __assign(__uint128_t __v) {
+    __size_ = 0;
+    for (; __v != 0; __v >>= 32)
+      __limbs_[__size_++] = static_cast<uint32_t>(__v);
+  }
+#endif
+
+  _LIBCPP_INLINE_VISIBILITY bool __is_zero() const { return __size_ == 0; }
+
+  _LIBCPP_INLINE_VISIBILITY size_t __bit_length() const {
+    if (__size_ == 0)
+      return 0;
+    return 32 * __size_ - static_cast<size_t>(__builtin_clz(__limbs_[__size_ - 1]));
+  }
+
+  // Returns the 64 bits starting at bit __pos (bits beyond the value are zero).
+  _LIBCPP_INLINE_VISIBILITY uint64_t __bits_at(size_t __pos) const {
+    uint64_t __r = 0;
+    for (size_t __i = 0; __i < 3; ++__i) {
+      size_t __limb = __pos / 32 + __i;
+      if (__limb >= __size_)
+        break;
+      unsigned __shift = __pos % 32;
+      uint64_t __v = __limbs_[__limb];
+      if (__i == 0)
+        __r |= __v >> __shift;
+      else if (32 * __i - __shift < 64)
+        __r |= __v << (32 * __i - __shift);
+    }
+    return __r;
+  }
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __mul_small(uint32_t __m) {
+    uint32_t __carry = 0;
+    for (size_t __i = 0; __i < __size_; ++__i) {
+      uint64_t __p = static_cast<uint64_t>(__limbs_[__i]) * __m + __carry;
+      __limbs_[__i] = static_cast<uint32_t>(__p);
+      __carry = static_cast<uint32_t>(__p >> 32);
+    }
+    if (__carry != 0)
+      __push_back(__carry);
+    return *this;
+  }
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __add_small(uint32_t __a) {
+    for (size_t __i = 0; __a != 0; ++__i) {
+      if (__i == __size_) {
+        __push_back(__a);
+        break;
+      }
+      uint64_t __s = static_cast<uint64_t>(__limbs_[__i]) + __a;
+      __limbs_[__i] = static_cast<uint32_t>(__s);
+      __a = static_cast<uint32_t>(__s >> 32);
+    }
+    return *this;
+  }
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __mul_pow5(unsigned __n) {
+    // 5^13 is the largest power of 5 that fits in 32 bits.
+    for (; __n >= 13; __n -= 13)
+      __mul_small(1220703125u);
+    static constexpr uint32_t __small_pow5[] = {1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125,
+                                                9765625, 48828125, 244140625};
+    if (__n != 0)
+      __mul_small(__small_pow5[__n]);
+    return *this;
+  }
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __mul_pow10(unsigned __n) { return __mul_pow5(__n).__shift_left(__n); }
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __shift_left(size_t __n) {
+    if (__size_ == 0 || __n == 0)
+      return *this;
+    const size_t __limbs = __n / 32;
+    const unsigned __bits = __n % 32;
+    _LIBCPP_ASSERT(__size_ + __limbs + 1 <= __capacity, "__big_uint overflow");
+    __limbs_[__size_ + __limbs] = 0;
+    if (__bits == 0) {
+      for (size_t __i = __size_; __i-- > 0;)
+        __limbs_[__i + __limbs] = __limbs_[__i];
+    } else {
+      for (size_t __i = __size_; __i-- > 0;) {
+        __limbs_[__i + __limbs + 1] |= __limbs_[__i] >> (32 - __bits);
+        __limbs_[__i + __limbs] = __limbs_[__i] << __bits;
+      }
+    }
+    for (size_t __i = 0; __i < __limbs; ++__i)
+      __limbs_[__i] = 0;
+    __size_ += __limbs + 1;
+    __trim();
+    return *this;
+  }
+
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __add(const __big_uint& __b) {
+    uint32_t __carry = 0;
+    size_t __n = __size_ > __b.__size_ ? __size_ : __b.__size_;
+    for (size_t __i = 0; __i < __n; ++__i) {
+      uint64_t __s = static_cast<uint64_t>(__i < __size_ ? __limbs_[__i] : 0) +
+                     (__i < __b.__size_ ? __b.__limbs_[__i] : 0) + __carry;
+      __limbs_[__i] = static_cast<uint32_t>(__s);
+      __carry = static_cast<uint32_t>(__s >> 32);
+    }
+    __size_ = __n;
+    if (__carry != 0)
+      __push_back(__carry);
+    return *this;
+  }
+
+  // Requires *this >= __b.
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __sub(const __big_uint& __b) {
+    _LIBCPP_ASSERT(__compare(*this, __b) >= 0, "__big_uint underflow");
+    uint32_t __borrow = 0;
+    for (size_t __i = 0; __i < __size_; ++__i) {
+      uint64_t __d = static_cast<uint64_t>(__limbs_[__i]) - (__i < __b.__size_ ? __b.__limbs_[__i] : 0) - __borrow;
+      __limbs_[__i] = static_cast<uint32_t>(__d);
+      __borrow = static_cast<uint32_t>(__d >> 63);
+      if (__i >= __b.__size_ && __borrow == 0)
+        break;
+    }
+    __trim();
+    return *this;
+  }
+
+  // Computes *this -= __d * __m; requires the result to be non-negative.
+  _LIBCPP_INLINE_VISIBILITY __big_uint& __sub_mul_small(const __big_uint& __d, uint32_t __m) {
+    uint64_t __carry = 0;
+    uint32_t __borrow = 0;
+    for (size_t __i = 0; __i < __size_; ++__i) {
+      uint64_t __p = (__i < __d.__size_ ? static_cast<uint64_t>(__d.__limbs_[__i]) * __m : 0) + __carry;
+      __carry = __p >> 32;
+      uint64_t __t = static_cast<uint64_t>(__limbs_[__i]) - static_cast<uint32_t>(__p) - __borrow;
+      __limbs_[__i] = static_cast<uint32_t>(__t);
+      __borrow = static_cast<uint32_t>(__t >> 63);
+    }
+    _LIBCPP_ASSERT(__carry == 0 && __borrow == 0, "__big_uint underflow");
+    __trim();
+    return *this;
+  }
+
+  // Divides *this by __d, requiring the quotient to be below 16, and leaves
+  // the remainder in *this.
+  _LIBCPP_INLINE_VISIBILITY uint32_t __divide_small_quotient(const __big_uint& __d) {
+    if (__compare(*this, __d) < 0)
+      return 0;
+    // Estimate the quotient from the leading bits of both operands. The
+    // estimate never exceeds the true quotient and is off by at most one.
+    const size_t __len = __d.__bit_length();
+    const size_t __shift = __len > 59 ? __len - 59 : 0;
+    const uint64_t __num = __bits_at(__shift);
+    const uint64_t __den = __d.__bits_at(__shift) + 1;
+    uint32_t __q = static_cast<uint32_t>(__num / __den);
+    if (__q != 0)
+      __sub_mul_small(__d, __q);
+    while (__compare(*this, __d) >= 0) {
+      __sub(__d);
+      ++__q;
+    }
+    return __q;
+  }
+
+  // Returns <0, 0 or >0 if __a is less than, equal to or greater than __b.
+  static _LIBCPP_INLINE_VISIBILITY int __compare(const __big_uint& __a, const __big_uint& __b) {
+    if (__a.__size_ != __b.__size_)
+      return __a.__size_ < __b.__size_ ? -1 : 1;
+    for (size_t __i = __a.__size_; __i-- > 0;)
+      if (__a.__limbs_[__i] != __b.__limbs_[__i])
+        return __a.__limbs_[__i] < __b.__limbs_[__i] ? -1 : 1;
+    return 0;
+  }
+
+  // Compares __a + __b with __c.
+  static _LIBCPP_INLINE_VISIBILITY int __compare_sum(const __big_uint& __a, const __big_uint& __b,
+                                                     const __big_uint& __c) {
+    __big_uint __s = __a;
+    __s.__add(__b);
+    return __compare(__s, __c);
+  }
+
+private:
+  _LIBCPP_INLINE_VISIBILITY void __push_back(uint32_t __v) {
+    _LIBCPP_ASSERT(__size_ < __capacity, "__big_uint overflow");
+    __limbs_[__size_++] = __v;
+  }
+
+  _LIBCPP_INLINE_VISIBILITY void __trim() {
+    while (__size_ != 0 && __limbs_[__size_ - 1] == 0)
+      --__size_;
+  }
+
+  uint32_t __limbs_[__capacity];
+  size_t __size_;
+};
+
+} // namespace __charconv
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_SRC_INCLUDE_FLOATING_POINT_BIGNUM_H
@@ -0,0 +1,618 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP_SRC_INCLUDE_FROM_CHARS_FLOATING_POINT_H
+#define _LIBCPP_SRC_INCLUDE_FROM_CHARS_FLOATING_POINT_H
+
+// Implementation of the float and double overloads of std::from_chars.
+//
+// A decimal input is first scanned into at most 19 significant digits w and a
+// power of ten q. Most inputs are then converted by Clinger's fast path (w and
+// 10^q exactly representable) or by the Eisel-Lemire algorithm, a 128-bit
+// approximation of w * 10^q that detects when it cannot decide the rounding.
+// The remaining inputs -- those close to a halfway point, including all inputs
+// with more than 19 significant digits whose rounding depends on the digits
+// that were dropped -- are converted exactly with big integers.
+
+#include "__config"
+#include "charconv"
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "eisel_lemire_table.h"
+#include "floating_point_bignum.h"
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __charconv {
+
+template <class _Fp>
+struct __from_chars_traits;
+
+template <>
+struct __from_chars_traits<float> {
+  using __bits_type = uint32_t;
+  static constexpr int __fraction_bits = FLT_MANT_DIG - 1;
+  static constexpr int __exponent_bias = 127;
+  static constexpr int __max_biased_exponent = 0xff;
+  // Clinger's fast path: 10^q is exact for q <= 10.
+  static constexpr int __max_exact_power = 10;
+  // Eisel-Lemire bounds, see fast_float.
+  static constexpr int __min_exponent_round_to_even = -17;
+  static constexpr int __max_exponent_round_to_even = 10;
+  static constexpr int __smallest_power_of_ten = -65;
+  static constexpr int __largest_power_of_ten = 38;
+};
+
+template <>
+struct __from_chars_traits<double> {
+  using __bits_type = uint64_t;
+  static constexpr int __fraction_bits = DBL_MANT_DIG - 1;
+  static constexpr int __exponent_bias = 1023;
+  static constexpr int __max_biased_exponent = 0x7ff;
+  static constexpr int __max_exact_power = 22;
+  static constexpr int __min_exponent_round_to_even = -4;
+  static constexpr int __max_exponent_round_to_even = 23;
+  static constexpr int __smallest_power_of_ten = -342;
+  static constexpr int __largest_power_of_ten = 308;
+};
+
+// A binary floating-point value: the raw fraction field and biased exponent
+// field. __biased_exponent is negative if the approximation failed.
+struct __adjusted_mantissa {
+  uint64_t __mantissa;
+  int __biased_exponent;
+};
+
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY _Fp __compose(bool __negative, __adjusted_mantissa __am) {
+  using _Traits = __from_chars_traits<_Fp>;
+  using _Bits = typename _Traits::__bits_type;
+  _Bits __bits = static_cast<_Bits>(__am.__mantissa) |
+                 (static_cast<_Bits>(__am.__biased_exponent) << _Traits::__fraction_bits) |
+                 (static_cast<_Bits>(__negative) << (sizeof(_Bits) * 8 - 1));
+  _Fp __value;
+  _VSTD::memcpy(&__value, &__bits, sizeof(__value));
+  return __value;
+}
+
+// The result of scanning the significand and exponent of a decimal number.
+// The value is __w * 10^__q if !__truncated, and otherwise lies strictly
+// between __w * 10^__q and (__w + 1) * 10^__q.
+struct __decimal_scan {
+  uint64_t __w;
+  int64_t __q;
+  bool __truncated;
+  // The digits, as they appear in the input, with the decimal point (if any)
+  // just before __fraction_begin.
+  const char* __integer_begin;
+  const char* __integer_end;
+  const char* __fraction_begin;
+  const char* __fraction_end;
+  int64_t __exponent; // The explicit exponent.
+};
+
+inline _LIBCPP_INLINE_VISIBILITY bool __is_digit(char __c) { return static_cast<unsigned char>(__c - '0') < 10; }
+
+inline _LIBCPP_INLINE_VISIBILITY int __hex_digit_value(char __c) {
+  if (__is_digit(__c))
+    return __c - '0';
+  if (__c >= 'a' && __c <= 'f')
+    return __c - 'a' + 10;
+  if (__c >= 'A' && __c <= 'F')
+    return __c - 'A' + 10;
+  return -1;
+}
+
+inline _LIBCPP_INLINE_VISIBILITY char __to_lower(char __c) { return __c >= 'A' && __c <= 'Z' ? __c - 'A' + 'a' : __c; }
+
+// Returns true if [__first, __last) starts with __s, ignoring case.
+inline _LIBCPP_INLINE_VISIBILITY bool __starts_with_nocase(const char* __first, const char* __last, const char* __s,
+                                                           size_t __n) {
+  if (static_cast<size_t>(__last - __first) < __n)
+    return false;
+  for (size_t __i = 0; __i < __n; ++__i)
+    if (__to_lower(__first[__i]) != __s[__i])
+      return false;
+  return true;
+}
+
+// Parses an optionally signed exponent at __first. The value saturates well
+// beyond the range of any floating-point type. Returns __first if there are no
+// digits, in which case the exponent is not part of the match.
+inline _LIBCPP_INLINE_VISIBILITY const char* __parse_exponent(const char* __first, const char* __last,
+                                                              int64_t& __exponent) {
+  const char* __p = __first;
+  bool __negative = false;
+  if (__p != __last && (*__p == '+' || *__p == '-'))
+    __negative = *__p++ == '-';
+  if (__p == __last || !__is_digit(*__p))
+    return __first;
+  int64_t __e = 0;
+  for (; __p != __last && __is_digit(*__p); ++__p)
+    if (__e < (int64_t(1) << 40))
+      __e = __e * 10 + (*__p - '0');
+  __exponent = __negative ? -__e : __e;
+  return __p;
+}
+
+// Scans a decimal number in the from_chars grammar for __fmt. Returns nullptr
+// if there is no match.
+inline _LIBCPP_INLINE_VISIBILITY const char* __scan_decimal(const char* __first, const char* __last,
+                                                            chars_format __fmt, __decimal_scan& __s) {
+  const char* __p = __first;
+  __s.__integer_begin = __p;
+  while (__p != __last && __is_digit(*__p))
+    ++__p;
+  __s.__integer_end = __p;
+  __s.__fraction_begin = __p;
+  if (__p != __last && *__p == '.') {
+    __s.__fraction_begin = ++__p;
+    while (__p != __last && __is_digit(*__p))
+      ++__p;
+  }
+  __s.__fraction_end = __p;
+  if (__s.__integer_begin == __s.__integer_end && __s.__fraction_begin == __s.__fraction_end)
+    return nullptr;
+
+  __s.__exponent = 0;
+  const bool __scientific = (__fmt & chars_format::scientific) == chars_format::scientific;
+  const bool __fixed = (__fmt & chars_format::fixed) == chars_format::fixed;
+  if (__scientific && __p != __last && (*__p == 'e' || *__p == 'E')) {
+    const char* __e = __parse_exponent(__p + 1, __last, __s.__exponent);
+    if (__e != __p + 1)
+      __p = __e;
+    else if (!__fixed)
+      return nullptr;
+  } else if (__scientific && !__fixed) {
+    // The exponent is mandatory for chars_format::scientific.
+    return nullptr;
+  }
+
+  // Collect up to 19 significant digits, which always fit in 64 bits.
+  uint64_t __w = 0;
+  int __digits = 0;
+  int64_t __dropped = 0;
+  bool __truncated = false;
+  auto __scan = [&](const char* __b, const char* __e) {
+    for (; __b != __e; ++__b) {
+      const unsigned __d = static_cast<unsigned>(*__b - '0');
+      if (__digits < 19) {
+        if (__w != 0 || __d != 0) {
+          __w = __w * 10 + __d;
+          ++__digits;
+        }
+      } else {
+        ++__dropped;
+        __truncated |= __d != 0;
+      }
+    }
+  };
+  __scan(__s.__integer_begin, __s.__integer_end);
+  __scan(__s.__fraction_begin, __s.__fraction_end);
+  __s.__w = __w;
+  __s.__q = __s.__exponent - (__s.__fraction_end - __s.__fraction_begin) + __dropped;
+  __s.__truncated = __truncated;
+  return __p;
+}
+
+inline _LIBCPP_INLINE_VISIBILITY void __full_multiplication(uint64_t __a, uint64_t __b, uint64_t& __high,
+                                                            uint64_t& __low) {
+#ifndef _LIBCPP_HAS_NO_INT128
+  const __uint128_t __p = static_cast<__uint128_t>(__a) * __b;
+  __high = static_cast<uint64_t>(__p >> 64);
+  __low = static_cast<uint64_t>(__p);
+#else
+  const uint64_t __a_lo = static_cast<uint32_t>(__a), __a_hi = __a >> 32;
+  const uint64_t __b_lo = static_cast<uint32_t>(__b), __b_hi = __b >> 32;
+  const uint64_t __ll = __a_lo * __b_lo;
+  const uint64_t __lh = __a_lo * __b_hi;
+  const uint64_t __hl = __a_hi * __b_lo;
+  const uint64_t __hh = __a_hi * __b_hi;
+  const uint64_t __mid = (__ll >> 32) + static_cast<uint32_t>(__lh) + static_cast<uint32_t>(__hl);
+  __low = (__mid << 32) | static_cast<uint32_t>(__ll);
+  __high = __hh + (__lh >> 32) + (__hl >> 32) + (__mid >> 32);
+#endif
+}
+
+// The Eisel-Lemire algorithm, computing __w * 10^__q rounded to nearest with
+// ties to even. Returns a negative biased exponent if it cannot decide the
+// rounding. Requires __w != 0.
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY __adjusted_mantissa __eisel_lemire(int64_t __q, uint64_t __w) {
+  using _Traits = __from_chars_traits<_Fp>;
+  constexpr int __mantissa_bits = _Traits::__fraction_bits;
+  constexpr int __minimum_exponent = -_Traits::__exponent_bias;
+  if (__q < _Traits::__smallest_power_of_ten)
+    return {0, 0};
+  if (__q > _Traits::__largest_power_of_ten)
+    return {0, _Traits::__max_biased_exponent};
+
+  const int __lz = __builtin_clzll(__w);
+  __w <<= __lz;
+
+  // The 128 leading bits of __w * 5^__q. Only __mantissa_bits + 3 of them are
+  // needed; the low word of the power is used only when the bits below those
+  // are all ones in the first product and a carry could reach them.
+  const int __index = static_cast<int>(__q) - __eisel_lemire_smallest_power;
+  uint64_t __high, __low;
+  __full_multiplication(__w, __eisel_lemire_pow5[__index][0], __high, __low);
+  constexpr uint64_t __precision_mask = ~uint64_t(0) >> (__mantissa_bits + 3);
+  if ((__high & __precision_mask) == __precision_mask) {
+    uint64_t __high2, __low2;
+    __full_multiplication(__w, __eisel_lemire_pow5[__index][1], __high2, __low2);
+    __low += __high2;
+    if (__high2 > __low)
+      ++__high;
+  }
+  // The product may be one unit too small in its last place, which only
+  // matters if it could carry into the kept bits, and 5^__q is exact for
+  // 0 <= __q <= 55.
+  if (__low == ~uint64_t(0) && (__q < -27 || __q > 55))
+    return {0, -1};
+
+  const int __upper_bit = static_cast<int>(__high >> 63);
+  uint64_t __mantissa = __high >> (__upper_bit + 64 - __mantissa_bits - 3);
+  // floor(log2(10^__q)) + 63, with 217706 / 2^16 approximating log2(10).
+  const int __power2 =
+      static_cast<int>(((217706 * __q) >> 16) + 63) + __upper_bit - __lz - __minimum_exponent;
+  if (__power2 <= 0) {
+    // Subnormal or zero.
+    if (-__power2 + 1 >= 64)
+      return {0, 0};
+    __mantissa >>= -__power2 + 1;
+    __mantissa += __mantissa & 1;
+    __mantissa >>= 1;
+    // Rounding may produce the smallest normal number.
+    return {__mantissa & ((uint64_t(1) << __mantissa_bits) - 1),
+            __mantissa < (uint64_t(1) << __mantissa_bits) ? 0 : 1};
+  }
+
+  // Exact halfway cases are only possible when 5^__q fits in the product, and
+  // then the truncated bits tell whether the value is exactly between two
+  // floating-point numbers.
+  if (__low <= 1 && __q >= _Traits::__min_exponent_round_to_even &&
+      __q <= _Traits::__max_exponent_round_to_even && (__mantissa & 3) == 1) {
+    if ((__mantissa << (__upper_bit + 64 - __mantissa_bits - 3)) == __high)
+      __mantissa &= ~uint64_t(1); // Round down to even.
+  }
+  __mantissa += __mantissa & 1;
+  __mantissa >>= 1;
+  int __biased = __power2;
+  if (__mantissa >= (uint64_t(2) << __mantissa_bits)) {
+    __mantissa = uint64_t(1) << __mantissa_bits;
+    ++__biased;
+  }
+  __mantissa &= ~(uint64_t(1) << __mantissa_bits);
+  if (__biased >= _Traits::__max_biased_exponent)
+    return {0, _Traits::__max_biased_exponent};
+  return {__mantissa, __biased};
+}
+
+// Enough decimal digits to decide the rounding of any input: a value halfway
+// between two doubles has at most 767 significant digits. Digits beyond these
+// only matter through whether any of them is nonzero.
+inline constexpr int __max_exact_digits = 800;
+
+template <class _Fp>
+constexpr size_t __from_chars_bignum_bits =
+    (__max_exact_digits + numeric_limits<_Fp>::digits10 - numeric_limits<_Fp>::min_exponent10 + 8) * 3322 / 1000 +
+    128;
+
+// Converts the digits of __s exactly, by long division of the decimal value by
+// a power of two chosen so that the quotient has as many bits as the mantissa.
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY __adjusted_mantissa __exact_decimal_to_binary(const __decimal_scan& __s) {
+  using _Traits = __from_chars_traits<_Fp>;
+  using _Big = __big_uint<__from_chars_bignum_bits<_Fp>>;
+  constexpr int __mantissa_bits = _Traits::__fraction_bits + 1;
+  constexpr int __min_exponent = 2 - _Traits::__exponent_bias - __mantissa_bits;
+
+  // The significant digits, in chunks of 9.
+  _Big __num;
+  int __digits = 0;
+  int64_t __dropped = 0;
+  bool __sticky = false;
+  uint32_t __chunk = 0;
+  int __chunk_digits = 0;
+  auto __append = [&](const char* __b, const char* __e) {
+    for (; __b != __e; ++__b) {
+      const uint32_t __d = static_cast<uint32_t>(*__b - '0');
+      if (__digits == 0 && __d == 0)
+        continue;
+      if (__digits == __max_exact_digits) {
+        ++__dropped;
+        __sticky |= __d != 0;
+        continue;
+      }
+      ++__digits;
+      __chunk = __chunk * 10 + __d;
+      if (++__chunk_digits == 9) {
+        __num.__mul_small(1000000000u).__add_small(__chunk);
+        __chunk = 0;
+        __chunk_digits = 0;
+      }
+    }
+  };
+  __append(__s.__integer_begin, __s.__integer_end);
+  __append(__s.__fraction_begin, __s.__fraction_end);
+  static constexpr uint32_t __pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+  __num.__mul_small(__pow10[__chunk_digits]).__add_small(__chunk);
+  int64_t __exponent10 = __s.__exponent - (__s.__fraction_end - __s.__fraction_begin) + __dropped;
+  if (__sticky) {
+    // Any digit between 1 and 9 has the same effect on the rounding.
+    __num.__mul_small(10).__add_small(1);
+    ++__digits;
+    --__exponent10;
+  }
+
+  // The decimal exponent of the leading digit decides overflow and underflow
+  // long before the big integers would.
+  const int64_t __sci_exponent = __exponent10 + __digits - 1;
+  if (__sci_exponent > numeric_limits<_Fp>::max_exponent10)
+    return {0, _Traits::__max_biased_exponent};
+  if (__sci_exponent < numeric_limits<_Fp>::min_exponent10 - numeric_limits<_Fp>::digits10 - 4)
+    return {0, 0};
+
+  // The value is __num / __den * 2^__exponent2.
+  _Big __den(1);
+  int __exponent2 = 0;
+  if (__exponent10 >= 0)
+    __num.__mul_pow10(static_cast<unsigned>(__exponent10));
+  else
+    __den.__mul_pow10(static_cast<unsigned>(-__exponent10));
+  const int __num_bits = static_cast<int>(__num.__bit_length());
+  const int __den_bits = static_cast<int>(__den.__bit_length());
+  if (__num_bits > __den_bits)
+    __den.__shift_left(static_cast<size_t>(__num_bits - __den_bits));
+  else
+    __num.__shift_left(static_cast<size_t>(__den_bits - __num_bits));
+  __exponent2 = __num_bits - __den_bits;
+  if (_Big::__compare(__num, __den) < 0) {
+    __num.__shift_left(1);
+    --__exponent2;
+  }
+  // Now __den <= __num < 2 * __den: the leading bit has exponent __exponent2.
+  int __lsb_exponent = __exponent2 - (__mantissa_bits - 1);
+  int __bits = __mantissa_bits;
+  if (__lsb_exponent < __min_exponent) {
+    __bits -= __min_exponent - __lsb_exponent;
+    __lsb_exponent = __min_exponent;
+  }
+  if (__bits < 0)
+    return {0, 0}; // Below half the smallest subnormal.
+
+  uint64_t __mantissa = 0;
+  for (int __i = 0; __i < __bits; ++__i) {
+    __mantissa <<= 1;
+    if (_Big::__compare(__num, __den) >= 0) {
+      __num.__sub(__den);
+      __mantissa |= 1;
+    }
+    __num.__shift_left(1);
+  }
+  const int __round = _Big::__compare(__num, __den);
+  if (__round > 0 || (__round == 0 && (__mantissa & 1) != 0))
+    ++__mantissa;
+  if (__mantissa == (uint64_t(1) << __mantissa_bits)) {
+    __mantissa >>= 1;
+    ++__lsb_exponent;
+  }
+
+  if (__mantissa < (uint64_t(1) << (__mantissa_bits - 1)))
+    return {__mantissa, 0};
+  const int __biased = __lsb_exponent - __min_exponent + 1;
+  if (__biased >= _Traits::__max_biased_exponent)
+    return {0, _Traits::__max_biased_exponent};
+  return {__mantissa & ((uint64_t(1) << (__mantissa_bits - 1)) - 1), __biased};
+}
+
+// Parses a hexadecimal significand without the "0x" prefix and a binary
+// exponent, and rounds it to nearest with ties to even.
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY const char* __scan_hex(const char* __first, const char* __last,
+                                                        __adjusted_mantissa& __am) {
+  using _Traits = __from_chars_traits<_Fp>;
+  constexpr int __mantissa_bits = _Traits::__fraction_bits + 1;
+  constexpr int __min_exponent = 2 - _Traits::__exponent_bias - __mantissa_bits;
+
+  // Up to 15 significant hexits (60 bits) are kept, which leaves room for the
+  // mantissa, a rounding bit and at least one sticky bit.
+  uint64_t __w = 0;
+  int __hexits = 0;
+  int64_t __exponent2 = 0;
+  bool __sticky = false;
+  bool __any = false;
+  const char* __p = __first;
+  auto __scan = [&](bool __fraction) {
+    for (int __v; __p != __last && (__v = __hex_digit_value(*__p)) >= 0; ++__p) {
+      __any = true;
+      if (__fraction)
+        __exponent2 -= 4;
+      if (__w == 0 && __v == 0)
+        continue;
+      if (__hexits < 15) {
+        __w = (__w << 4) | static_cast<unsigned>(__v);
+        ++__hexits;
+      } else {
+        __exponent2 += 4;
+        __sticky |= __v != 0;
+      }
+    }
+  };
+  __scan(false);
+  if (__p != __last && *__p == '.') {
+    ++__p;
+    __scan(true);
+  }
+  if (!__any)
+    return nullptr;
+  if (__p != __last && (*__p == 'p' || *__p == 'P')) {
+    int64_t __e = 0;
+    const char* __end = __parse_exponent(__p + 1, __last, __e);
+    if (__end != __p + 1) {
+      __p = __end;
+      __exponent2 += __e;
+    }
+  }
+
+  if (__w == 0) {
+    __am = {0, 0};
+    return __p;
+  }
+  // Normalize so that the leading bit is bit 62, keeping the sticky bit 0.
+  const int __shift = __builtin_clzll(__w) - 1;
+  __w <<= __shift;
+  __exponent2 -= __shift;
+  __w |= static_cast<uint64_t>(__sticky);
+  // The value is __w * 2^__exponent2; find the exponent of its last kept bit.
+  int64_t __lsb_exponent = __exponent2 + 62 - (__mantissa_bits - 1);
+  if (__lsb_exponent > _Traits::__max_biased_exponent + __min_exponent) {
+    __am = {0, _Traits::__max_biased_exponent};
+    return __p;
+  }
+  int64_t __drop = 62 - (__mantissa_bits - 1);
+  if (__lsb_exponent < __min_exponent) {
+    __drop += __min_exponent - __lsb_exponent;
+    __lsb_exponent = __min_exponent;
+  }
+  uint64_t __mantissa = 0;
+  if (__drop <= 63) {
+    const uint64_t __half = uint64_t(1) << (__drop - 1);
+    const uint64_t __rest = __w & ((__half << 1) - 1);
+    __mantissa = __drop == 63 ? 0 : __w >> __drop;
+    if (__rest > __half || (__rest == __half && (__mantissa & 1) != 0))
+      ++__mantissa;
+  }
+  if (__mantissa == (uint64_t(1) << __mantissa_bits)) {
+    __mantissa >>= 1;
+    ++__lsb_exponent;
+  }
+  if (__mantissa < (uint64_t(1) << (__mantissa_bits - 1))) {
+    __am = {__mantissa, 0};
+    return __p;
+  }
+  const int64_t __biased = __lsb_exponent - __min_exponent + 1;
+  if (__biased >= _Traits::__max_biased_exponent)
+    __am = {0, _Traits::__max_biased_exponent};
+  else
+    __am = {__mantissa & ((uint64_t(1) << (__mantissa_bits - 1)) - 1), static_cast<int>(__biased)};
+  return __p;
+}
+
+// Scans "inf", "infinity" or "nan" optionally followed by a parenthesized
+// n-char-sequence. Returns nullptr if there is no match.
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY const char* __scan_special(const char* __first, const char* __last, bool __negative,
+                                                            _Fp& __value) {
+  if (__starts_with_nocase(__first, __last, "inf", 3)) {
+    __value = __negative ? -numeric_limits<_Fp>::infinity() : numeric_limits<_Fp>::infinity();
+    return __starts_with_nocase(__first + 3, __last, "inity", 5) ? __first + 8 : __first + 3;
+  }
+  if (__starts_with_nocase(__first, __last, "nan", 3)) {
+    __value = __negative ? -numeric_limits<_Fp>::quiet_NaN() : numeric_limits<_Fp>::quiet_NaN();
+    const char* __p = __first + 3;
+    if (__p != __last && *__p == '(') {
+      const char* __q = __p + 1;
+      while (__q != __last && (__is_digit(*__q) || (__to_lower(*__q) >= 'a' && __to_lower(*__q) <= 'z') || *__q == '_'))
+        ++__q;
+      if (__q != __last && *__q == ')')
+        __p = __q + 1;
+    }
+    return __p;
+  }
+  return nullptr;
+}
+
+// Finishes a conversion: a finite input whose value rounds to zero or
+// infinity is out of range and leaves __value unmodified.
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY from_chars_result __store(const char* __ptr, bool __negative, bool __nonzero,
+                                                          __adjusted_mantissa __am, _Fp& __value) {
+  if (__am.__biased_exponent == __from_chars_traits<_Fp>::__max_biased_exponent ||
+      (__nonzero && __am.__biased_exponent == 0 && __am.__mantissa == 0))
+    return {__ptr, errc::result_out_of_range};
+  __value = __compose<_Fp>(__negative, __am);
+  return {__ptr, errc{}};
+}
+
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY from_chars_result __floating_from_chars(const char* __first, const char* __last,
+                                                                        _Fp& __value, chars_format __fmt) {
+  using _Traits = __from_chars_traits<_Fp>;
+  _LIBCPP_ASSERT(__fmt == chars_format::scientific || __fmt == chars_format::fixed || __fmt == chars_format::general ||
+                     __fmt == chars_format::hex,
+                 "invalid chars_format");
+  const char* __p = __first;
+  const bool __negative = __p != __last && *__p == '-';
+  if (__negative)
+    ++__p;
+
+  if (const char* __end = __scan_special(__p, __last, __negative, __value))
+    return {__end, errc{}};
+
+  if (__fmt == chars_format::hex) {
+    __adjusted_mantissa __am;
+    const char* __end = __scan_hex<_Fp>(__p, __last, __am);
+    if (__end == nullptr)
+      return {__first, errc::invalid_argument};
+    // A zero mantissa is only produced by underflow when a hexit is nonzero.
+    bool __nonzero = false;
+    for (const char* __i = __p; __i != __end && *__i != 'p' && *__i != 'P'; ++__i)
+      __nonzero |= *__i != '0' && *__i != '.';
+    return __store(__end, __negative, __nonzero, __am, __value);
+  }
+
+  __decimal_scan __s;
+  const char* __end = __scan_decimal(__p, __last, __fmt, __s);
+  if (__end == nullptr)
+    return {__first, errc::invalid_argument};
+
+  if (__s.__w == 0) {
+    __value = __negative ? -_Fp(0) : _Fp(0);
+    return {__end, errc{}};
+  }
+
+#if FLT_EVAL_METHOD == 0
+  // Clinger's fast path: both operands are exact, so is the correctly rounded
+  // product or quotient.
+  if (!__s.__truncated && -_Traits::__max_exact_power <= __s.__q && __s.__q <= _Traits::__max_exact_power &&
+      __s.__w <= (uint64_t(1) << (_Traits::__fraction_bits + 1))) {
+    static constexpr _Fp __exact_pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    _Fp __v = static_cast<_Fp>(__s.__w);
+    if (__s.__q < 0)
+      __v /= __exact_pow10[-__s.__q];
+    else
+      __v *= __exact_pow10[__s.__q];
+    __value = __negative ? -__v : __v;
+    return {__end, errc{}};
+  }
+#endif
+
+  __adjusted_mantissa __am = __eisel_lemire<_Fp>(__s.__q, __s.__w);
+  if (__am.__biased_exponent >= 0 && __s.__truncated) {
+    // The value lies between __w and __w + 1 units; if both round the same,
+    // so does the value.
+    const __adjusted_mantissa __up = __eisel_lemire<_Fp>(__s.__q, __s.__w + 1);
+    if (__up.__biased_exponent != __am.__biased_exponent || __up.__mantissa != __am.__mantissa)
+      __am.__biased_exponent = -1;
+  }
+  if (__am.__biased_exponent < 0)
+    __am = __exact_decimal_to_binary<_Fp>(__s);
+  return __store(__end, __negative, true, __am, __value);
+}
+
+} // namespace __charconv
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_SRC_INCLUDE_FROM_CHARS_FLOATING_POINT_H
@@ -0,0 +1,304 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Copyright 2018 Ulf Adams
+//
+// The contents of this file may be used under the terms of the Apache License,
+// Version 2.0.
+//
+//    (See accompanying file LICENSE-Apache or copy at
+//     http://www.apache.org/licenses/LICENSE-2.0)
+//
+// Alternatively, the contents of this file may be used under the terms of
+// the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE-Boost or copy at
+//     https://www.boost.org/LICENSE_1_0.txt)
+//
+// Unless required by applicable law or agreed to in writing, this software
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.
+
+#ifndef _LIBCPP_SRC_INCLUDE_RYU_RYU_H
+#define _LIBCPP_SRC_INCLUDE_RYU_RYU_H
+
+// Shortest round-trip binary to decimal conversion for IEEE-754 binary32 and
+// binary64 values. This is the "general case" Ryu algorithm from the reference
+// implementation, parameterized on the format so that float and double share
+// the binary64 tables: a 24-bit significand needs far less than the 125 bits
+// of precision the tables provide.
+
+#include "__config"
+#include <cstdint>
+
+#include "d2s_full_table.h"
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __ryu {
+
+// The result of a shortest conversion: the value is __mantissa * 10^__exponent,
+// and __mantissa has no more digits than needed to round-trip.
+struct __floating_decimal {
+  uint64_t __mantissa;
+  int32_t __exponent;
+};
+
+// Returns e == 0 ? 1 : ceil(log_2(5^e)); requires 0 <= e <= 3528.
+inline _LIBCPP_INLINE_VISIBILITY int32_t __pow5bits(const int32_t __e) {
+  return static_cast<int32_t>(((static_cast<uint32_t>(__e) * 1217359) >> 19) + 1);
+}
+
+// Returns floor(log_10(2^e)); requires 0 <= e <= 1650.
+inline _LIBCPP_INLINE_VISIBILITY uint32_t __log10Pow2(const int32_t __e) {
+  return (static_cast<uint32_t>(__e) * 78913) >> 18;
+}
+
+// Returns floor(log_10(5^e)); requires 0 <= e <= 2620.
+inline _LIBCPP_INLINE_VISIBILITY uint32_t __log10Pow5(const int32_t __e) {
+  return (static_cast<uint32_t>(__e) * 732923) >> 20;
+}
+
+inline _LIBCPP_INLINE_VISIBILITY uint32_t __pow5Factor(uint64_t __value) {
+  uint32_t __count = 0;
+  for (;;) {
+    const uint64_t __q = __value / 5;
+    const uint32_t __r = static_cast<uint32_t>(__value - 5 * __q);
+    if (__r != 0)
+      break;
+    __value = __q;
+    ++__count;
+  }
+  return __count;
+}
+
+// Returns true if __value is divisible by 5^__p.
+inline _LIBCPP_INLINE_VISIBILITY bool __multipleOfPowerOf5(const uint64_t __value, const uint32_t __p) {
+  return __pow5Factor(__value) >= __p;
+}
+
+// Returns true if __value is divisible by 2^__p; requires __p < 64.
+inline _LIBCPP_INLINE_VISIBILITY bool __multipleOfPowerOf2(const uint64_t __value, const uint32_t __p) {
+  return (__value & ((uint64_t(1) << __p) - 1)) == 0;
+}
+
+// Computes (__m * __mul) >> __j, where __mul is the 128-bit table entry
+// { low, high } and 64 < __j < 128. __m has at most 55 significant bits.
+inline _LIBCPP_INLINE_VISIBILITY uint64_t __mulShift64(const uint64_t __m, const uint64_t* const __mul,
+                                                       const int32_t __j) {
+#ifndef _LIBCPP_HAS_NO_INT128
+  const __uint128_t __b0 = static_cast<__uint128_t>(__m) * __mul[0];
+  const __uint128_t __b2 = static_cast<__uint128_t>(__m) * __mul[1];
+  return static_cast<uint64_t>(((__b0 >> 64) + __b2) >> (__j - 64));
+#else
+  const auto __umul128 = [](const uint64_t __a, const uint64_t __b, uint64_t* const __hi) {
+    const uint64_t __a_lo = static_cast<uint32_t>(__a);
+    const uint64_t __a_hi = __a >> 32;
+    const uint64_t __b_lo = static_cast<uint32_t>(__b);
+    const uint64_t __b_hi = __b >> 32;
+    const uint64_t __b00 = __a_lo * __b_lo;
+    const uint64_t __b01 = __a_lo * __b_hi;
+    const uint64_t __b10 = __a_hi * __b_lo;
+    const uint64_t __b11 = __a_hi * __b_hi;
+    const uint64_t __mid1 = __b10 + (__b00 >> 32);
+    const uint64_t __mid2 = __b01 + static_cast<uint32_t>(__mid1);
+    *__hi = __b11 + (__mid1 >> 32) + (__mid2 >> 32);
+    return (__mid2 << 32) | static_cast<uint32_t>(__b00);
+  };
+  uint64_t __high1;
+  uint64_t __high2;
+  (void)__umul128(__m, __mul[0], &__high1);
+  const uint64_t __low2 = __umul128(__m, __mul[1], &__high2);
+  const uint64_t __sum = __high1 + __low2;
+  if (__sum < __high1)
+    ++__high2;
+  const int32_t __dist = __j - 64;
+  return __dist == 0 ? __sum : (__high2 << (64 - __dist)) | (__sum >> __dist);
+#endif
+}
+
+// Converts the IEEE-754 value with the given raw significand field and biased
+// exponent field to its shortest decimal representation. The value must be
+// finite and non-zero.
+template <int _MantissaBits, int _ExponentBias>
+inline _LIBCPP_INLINE_VISIBILITY __floating_decimal __shortest(const uint64_t __ieeeMantissa,
+                                                               const uint32_t __ieeeExponent) {
+  int32_t __e2;
+  uint64_t __m2;
+  if (__ieeeExponent == 0) {
+    // We subtract 2 so that the bounds computation has 2 additional bits.
+    __e2 = 1 - _ExponentBias - _MantissaBits - 2;
+    __m2 = __ieeeMantissa;
+  } else {
+    __e2 = static_cast<int32_t>(__ieeeExponent) - _ExponentBias - _MantissaBits - 2;
+    __m2 = (uint64_t(1) << _MantissaBits) | __ieeeMantissa;
+  }
+  const bool __even = (__m2 & 1) == 0;
+  const bool __acceptBounds = __even;
+
+  // Step 2: Determine the interval of valid decimal representations.
+  const uint64_t __mv = 4 * __m2;
+  // Implicit bool -> int conversion. True is 1, false is 0.
+  const uint32_t __mmShift = __ieeeMantissa != 0 || __ieeeExponent <= 1;
+  // We would compute __mp and __mm like this:
+  //   uint64_t __mp = 4 * __m2 + 2;
+  //   uint64_t __mm = __mv - 1 - __mmShift;
+
+  // Step 3: Convert to a decimal power base using 128-bit arithmetic.
+  uint64_t __vr, __vp, __vm;
+  int32_t __e10;
+  bool __vmIsTrailingZeros = false;
+  bool __vrIsTrailingZeros = false;
+  if (__e2 >= 0) {
+    // This expression is slightly faster than max(0, __log10Pow2(__e2) - 1).
+    const uint32_t __q = __log10Pow2(__e2) - (__e2 > 3);
+    __e10 = static_cast<int32_t>(__q);
+    const int32_t __k = 125 + __pow5bits(static_cast<int32_t>(__q)) - 1;
+    const int32_t __i = -__e2 + static_cast<int32_t>(__q) + __k;
+    __vr = __mulShift64(__mv, __DOUBLE_POW5_INV_SPLIT[__q], __i);
+    __vp = __mulShift64(__mv + 2, __DOUBLE_POW5_INV_SPLIT[__q], __i);
+    __vm = __mulShift64(__mv - 1 - __mmShift, __DOUBLE_POW5_INV_SPLIT[__q], __i);
+    if (__q <= 21) {
+      // This should use __q <= 22, but I think 21 is also safe. Smaller values
+      // may still be safe, but it's more difficult to reason about them.
+      // Only one of __mp, __mv, and __mm can be a multiple of 5, if any.
+      const uint32_t __mvMod5 = static_cast<uint32_t>(__mv - 5 * (__mv / 5));
+      if (__mvMod5 == 0) {
+        __vrIsTrailingZeros = __multipleOfPowerOf5(__mv, __q);
+      } else if (__acceptBounds) {
+        // Same as min(__e2 + (~__mm & 1), __pow5Factor(__mm)) >= __q
+        // <=> __e2 + (~__mm & 1) >= __q && __pow5Factor(__mm) >= __q
+        // <=> true && __pow5Factor(__mm) >= __q, since __e2 >= __q.
+        __vmIsTrailingZeros = __multipleOfPowerOf5(__mv - 1 - __mmShift, __q);
+      } else {
+        // Same as min(__e2 + 1, __pow5Factor(__mp)) >= __q.
+        __vp -= __multipleOfPowerOf5(__mv + 2, __q);
+      }
+    }
+  } else {
+    // This expression is slightly faster than max(0, __log10Pow5(-__e2) - 1).
+    const uint32_t __q = __log10Pow5(-__e2) - (-__e2 > 1);
+    __e10 = static_cast<int32_t>(__q) + __e2;
+    const int32_t __i = -__e2 - static_cast<int32_t>(__q);
+    const int32_t __k = __pow5bits(__i) - 125;
+    const int32_t __j = static_cast<int32_t>(__q) - __k;
+    __vr = __mulShift64(__mv, __DOUBLE_POW5_SPLIT[__i], __j);
+    __vp = __mulShift64(__mv + 2, __DOUBLE_POW5_SPLIT[__i], __j);
+    __vm = __mulShift64(__mv - 1 - __mmShift, __DOUBLE_POW5_SPLIT[__i], __j);
+    if (__q <= 1) {
+      // {__vr,__vp,__vm} is trailing zeros if {__mv,__mp,__mm} has at least __q
+      // trailing 0 bits. __mv = 4 * __m2, so it always has at least two
+      // trailing 0 bits.
+      __vrIsTrailingZeros = true;
+      if (__acceptBounds) {
+        // __mm = __mv - 1 - __mmShift, so it has 1 trailing 0 bit iff __mmShift == 1.
+        __vmIsTrailingZeros = __mmShift == 1;
+      } else {
+        // __mp = __mv + 2, so it always has at least one trailing 0 bit.
+        --__vp;
+      }
+    } else if (__q < 63) {
+      // We want to know if the full product has at least __q trailing zeros.
+      // We need to compute min(p2(__mv), p5(__mv) - __e2) >= __q
+      // <=> p2(__mv) >= __q (because -__e2 >= __q).
+      __vrIsTrailingZeros = __multipleOfPowerOf2(__mv, __q);
+    }
+  }
+
+  // Step 4: Find the shortest decimal representation in the interval of valid
+  // representations.
+  int32_t __removed = 0;
+  uint8_t __lastRemovedDigit = 0;
+  uint64_t __output;
+  if (__vmIsTrailingZeros || __vrIsTrailingZeros) {
+    // General case, which happens rarely (~0.7%).
+    for (;;) {
+      const uint64_t __vpDiv10 = __vp / 10;
+      const uint64_t __vmDiv10 = __vm / 10;
+      if (__vpDiv10 <= __vmDiv10)
+        break;
+      const uint32_t __vmMod10 = static_cast<uint32_t>(__vm - 10 * __vmDiv10);
+      const uint64_t __vrDiv10 = __vr / 10;
+      const uint32_t __vrMod10 = static_cast<uint32_t>(__vr - 10 * __vrDiv10);
+      __vmIsTrailingZeros &= __vmMod10 == 0;
+      __vrIsTrailingZeros &= __lastRemovedDigit == 0;
+      __lastRemovedDigit = static_cast<uint8_t>(__vrMod10);
+      __vr = __vrDiv10;
+      __vp = __vpDiv10;
+      __vm = __vmDiv10;
+      ++__removed;
+    }
+    if (__vmIsTrailingZeros) {
+      for (;;) {
+        const uint64_t __vmDiv10 = __vm / 10;
+        const uint32_t __vmMod10 = static_cast<uint32_t>(__vm - 10 * __vmDiv10);
+        if (__vmMod10 != 0)
+          break;
+        const uint64_t __vpDiv10 = __vp / 10;
+        const uint64_t __vrDiv10 = __vr / 10;
+        const uint32_t __vrMod10 = static_cast<uint32_t>(__vr - 10 * __vrDiv10);
+        __vrIsTrailingZeros &= __lastRemovedDigit == 0;
+        __lastRemovedDigit = static_cast<uint8_t>(__vrMod10);
+        __vr = __vrDiv10;
+        __vp = __vpDiv10;
+        __vm = __vmDiv10;
+        ++__removed;
+      }
+    }
+    if (__vrIsTrailingZeros && __lastRemovedDigit == 5 && __vr % 2 == 0) {
+      // Round even if the exact number is .....50..0.
+      __lastRemovedDigit = 4;
+    }
+    // We need to take __vr + 1 if __vr is outside bounds or we need to round up.
+    __output = __vr + ((__vr == __vm && (!__acceptBounds || !__vmIsTrailingZeros)) || __lastRemovedDigit >= 5);
+  } else {
+    // Specialized for the common case (~99.3%). Percentages below are relative
+    // to this.
+    bool __roundUp = false;
+    const uint64_t __vpDiv100 = __vp / 100;
+    const uint64_t __vmDiv100 = __vm / 100;
+    if (__vpDiv100 > __vmDiv100) { // Optimization: remove two digits at a time (~86.2%).
+      const uint64_t __vrDiv100 = __vr / 100;
+      const uint32_t __vrMod100 = static_cast<uint32_t>(__vr - 100 * __vrDiv100);
+      __roundUp = __vrMod100 >= 50;
+      __vr = __vrDiv100;
+      __vp = __vpDiv100;
+      __vm = __vmDiv100;
+      __removed += 2;
+    }
+    // Loop iterations below (approximately), without optimization above:
+    // 0: 0.03%, 1: 13.8%, 2: 70.6%, 3: 14.0%, 4: 1.40%, 5: 0.14%, 6+: 0.02%
+    // Loop iterations below (approximately), with optimization above:
+    // 0: 70.6%, 1: 27.8%, 2: 1.40%, 3: 0.14%, 4+: 0.02%
+    for (;;) {
+      const uint64_t __vpDiv10 = __vp / 10;
+      const uint64_t __vmDiv10 = __vm / 10;
+      if (__vpDiv10 <= __vmDiv10)
+        break;
+      const uint64_t __vrDiv10 = __vr / 10;
+      const uint32_t __vrMod10 = static_cast<uint32_t>(__vr - 10 * __vrDiv10);
+      __roundUp = __vrMod10 >= 5;
+      __vr = __vrDiv10;
+      __vp = __vpDiv10;
+      __vm = __vmDiv10;
+      ++__removed;
+    }
+    // We need to take __vr + 1 if __vr is outside bounds or we need to round up.
+    __output = __vr + (__vr == __vm || __roundUp);
+  }
+
+  __floating_decimal __fd;
+  __fd.__exponent = __e10 + __removed;
+  __fd.__mantissa = __output;
+  return __fd;
+}
+
+} // namespace __ryu
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_SRC_INCLUDE_RYU_RYU_H
@@ -0,0 +1,745 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef _LIBCPP_SRC_INCLUDE_TO_CHARS_FLOATING_POINT_H
+#define _LIBCPP_SRC_INCLUDE_TO_CHARS_FLOATING_POINT_H
+
+// Implementation of the floating-point overloads of std::to_chars.
+//
+// Shortest round-trip conversions of float and double use Ryu (ryu/ryu.h).
+// Everything that needs exact decimal digits of the binary value -- an explicit
+// precision, and the shortest conversion of a long double wider than double --
+// uses a digit generator on fixed-capacity big integers
+// (floating_point_bignum.h). The output of both is a string of significant
+// digits plus a decimal exponent, which is then laid out in place in the
+// caller's buffer for the requested chars_format.
+
+#include "__config"
+#include "charconv"
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "floating_point_bignum.h"
+#include "ryu/ryu.h"
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __charconv {
+
+enum class __float_kind { __zero, __finite, __infinity, __nan };
+
+// A floating-point value split into its components. Finite values are exactly
+// __mantissa * 2^__exponent, where __mantissa includes the implicit bit.
+template <class _Mantissa>
+struct __decomposed_float {
+  _Mantissa __mantissa;
+  int __exponent;
+  __float_kind __kind;
+  bool __negative;
+  bool __subnormal;
+};
+
+template <class _Fp>
+struct __float_traits;
+
+template <>
+struct __float_traits<float> {
+  using __bits_type = uint32_t;
+  using __mantissa_type = uint64_t;
+  static constexpr int __mantissa_bits = FLT_MANT_DIG; // Including the implicit bit.
+  static constexpr int __exponent_bits = 8;
+  static constexpr int __exponent_bias = 127;
+};
+
+template <>
+struct __float_traits<double> {
+  using __bits_type = uint64_t;
+  using __mantissa_type = uint64_t;
+  static constexpr int __mantissa_bits = DBL_MANT_DIG;
+  static constexpr int __exponent_bits = 11;
+  static constexpr int __exponent_bias = 1023;
+};
+
+#if LDBL_MANT_DIG == 64 && (defined(__x86_64__) || defined(__i386__))
+#  define _LIBCPP_CHARCONV_LONG_DOUBLE_EXTENDED
+// The x87 80-bit extended format has an explicit integer bit.
+template <>
+struct __float_traits<long double> {
+  using __mantissa_type = uint64_t;
+  static constexpr int __mantissa_bits = 64;
+  static constexpr int __exponent_bits = 15;
+  static constexpr int __exponent_bias = 16383;
+};
+#elif LDBL_MANT_DIG == 113 && !defined(_LIBCPP_HAS_NO_INT128)
+#  define _LIBCPP_CHARCONV_LONG_DOUBLE_EXTENDED
+template <>
+struct __float_traits<long double> {
+  using __bits_type = __uint128_t;
+  using __mantissa_type = __uint128_t;
+  static constexpr int __mantissa_bits = 113;
+  static constexpr int __exponent_bits = 15;
+  static constexpr int __exponent_bias = 16383;
+};
+#endif
+
+// The exponent of the least significant mantissa bit of subnormals.
+template <class _Fp>
+constexpr int __min_exponent = 2 - __float_traits<_Fp>::__exponent_bias - __float_traits<_Fp>::__mantissa_bits;
+
+// The largest exponent of the least significant mantissa bit.
+template <class _Fp>
+constexpr int __max_exponent = __float_traits<_Fp>::__exponent_bias + 1 - __float_traits<_Fp>::__mantissa_bits;
+
+// Enough bits for the scaled numerators and denominators of the digit
+// generators below, including the extra factors of 2 and 10 they introduce.
+template <class _Fp>
+constexpr size_t __bignum_bits =
+    (__max_exponent<_Fp> > -__min_exponent<_Fp> ? __max_exponent<_Fp> : -__min_exponent<_Fp>) +
+    2 * __float_traits<_Fp>::__mantissa_bits + 64;
+
+// Decomposes an IEEE-754 interchange format value with an implicit leading bit.
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY __decomposed_float<typename __float_traits<_Fp>::__mantissa_type>
+__decompose_ieee(_Fp __value) {
+  using _Traits = __float_traits<_Fp>;
+  using _Bits = typename _Traits::__bits_type;
+  using _Mantissa = typename _Traits::__mantissa_type;
+  static_assert(sizeof(_Bits) == sizeof(_Fp), "");
+  _Bits __bits;
+  _VSTD::memcpy(&__bits, &__value, sizeof(__bits));
+
+  constexpr int __fraction_bits = _Traits::__mantissa_bits - 1;
+  constexpr _Bits __fraction_mask = (_Bits(1) << __fraction_bits) - 1;
+  constexpr _Bits __exponent_mask = (_Bits(1) << _Traits::__exponent_bits) - 1;
+  const _Bits __fraction = __bits & __fraction_mask;
+  const int __biased = static_cast<int>((__bits >> __fraction_bits) & __exponent_mask);
+
+  __decomposed_float<_Mantissa> __r;
+  __r.__negative = (__bits >> (sizeof(_Bits) * 8 - 1)) != 0;
+  __r.__subnormal = __biased == 0;
+  if (__biased == static_cast<int>(__exponent_mask)) {
+    __r.__kind = __fraction == 0 ? __float_kind::__infinity : __float_kind::__nan;
+    __r.__mantissa = 0;
+    __r.__exponent = 0;
+  } else if (__biased == 0) {
+    __r.__kind = __fraction == 0 ? __float_kind::__zero : __float_kind::__finite;
+    __r.__mantissa = static_cast<_Mantissa>(__fraction);
+    __r.__exponent = __min_exponent<_Fp>;
+  } else {
+    __r.__kind = __float_kind::__finite;
+    __r.__mantissa = static_cast<_Mantissa>(__fraction) | (_Mantissa(1) << __fraction_bits);
+    __r.__exponent = __biased + __min_exponent<_Fp> - 1;
+  }
+  return __r;
+}
+
+inline _LIBCPP_INLINE_VISIBILITY __decomposed_float<uint64_t> __decompose(float __value) {
+  return __decompose_ieee(__value);
+}
+
+inline _LIBCPP_INLINE_VISIBILITY __decomposed_float<uint64_t> __decompose(double __value) {
+  return __decompose_ieee(__value);
+}
+
+#if LDBL_MANT_DIG == 64 && defined(_LIBCPP_CHARCONV_LONG_DOUBLE_EXTENDED)
+inline _LIBCPP_INLINE_VISIBILITY __decomposed_float<uint64_t> __decompose(long double __value) {
+  // Little-endian: 64-bit significand, then 1 sign bit and 15 exponent bits.
+  uint64_t __significand;
+  uint16_t __sign_exponent;
+  _VSTD::memcpy(&__significand, &__value, sizeof(__significand));
+  _VSTD::memcpy(&__sign_exponent, reinterpret_cast<const char*>(&__value) + sizeof(__significand),
+                sizeof(__sign_exponent));
+  const int __biased = __sign_exponent & 0x7fff;
+
+  __decomposed_float<uint64_t> __r;
+  __r.__negative = (__sign_exponent >> 15) != 0;
+  __r.__subnormal = __biased == 0;
+  __r.__mantissa = __significand;
+  __r.__exponent = (__biased == 0 ? 1 : __biased) - 16383 - 63;
+  if (__biased == 0x7fff)
+    __r.__kind = (__significand << 1) == 0 ? __float_kind::__infinity : __float_kind::__nan;
+  else if (__significand == 0)
+    __r.__kind = __float_kind::__zero;
+  else
+    __r.__kind = __float_kind::__finite;
+  return __r;
+}
+#elif LDBL_MANT_DIG == 113 && defined(_LIBCPP_CHARCONV_LONG_DOUBLE_EXTENDED)
+inline _LIBCPP_INLINE_VISIBILITY __decomposed_float<__uint128_t> __decompose(long double __value) {
+  return __decompose_ieee(__value);
+}
+#endif
+
+// Returns floor(log10(2^__e)) for |__e| < 2^16, possibly off by one in either
+// direction; the digit generators correct the estimate.
+inline _LIBCPP_INLINE_VISIBILITY int __estimate_log10_pow2(int __e) {
+  return static_cast<int>((static_cast<int64_t>(__e) * 78913) >> 18);
+}
+
+template <class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY int __bit_width(_Mantissa __m) {
+  int __n = 0;
+  for (; __m != 0; __m >>= 1)
+    ++__n;
+  return __n;
+}
+
+// Produces the exact decimal digits of __mantissa * 2^__exponent one at a time.
+// After construction __r_ / __s_ is the value divided by 10^__exponent_, which
+// lies in [1, 10).
+template <size_t _Bits>
+class __exact_digit_generator {
+public:
+  template <class _Mantissa>
+  _LIBCPP_INLINE_VISIBILITY __exact_digit_generator(_Mantissa __mantissa, int __exponent) {
+    __r_.__assign(__mantissa);
+    __s_.__assign(uint64_t(1));
+    if (__exponent >= 0)
+      __r_.__shift_left(static_cast<size_t>(__exponent));
+    else
+      __s_.__shift_left(static_cast<size_t>(-__exponent));
+
+    __exponent_ = __estimate_log10_pow2(__bit_width(__mantissa) - 1 + __exponent);
+    if (__exponent_ >= 0)
+      __s_.__mul_pow10(static_cast<unsigned>(__exponent_));
+    else
+      __r_.__mul_pow10(static_cast<unsigned>(-__exponent_));
+    for (;;) {
+      __big_uint<_Bits> __s10 = __s_;
+      __s10.__mul_small(10);
+      if (__big_uint<_Bits>::__compare(__r_, __s10) < 0)
+        break;
+      __s_ = __s10;
+      ++__exponent_;
+    }
+    while (__big_uint<_Bits>::__compare(__r_, __s_) < 0) {
+      __r_.__mul_small(10);
+      --__exponent_;
+    }
+  }
+
+  // The decimal exponent of the first digit.
+  _LIBCPP_INLINE_VISIBILITY int __exponent() const { return __exponent_; }
+
+  // Returns true if all the remaining digits are zero.
+  _LIBCPP_INLINE_VISIBILITY bool __done() const { return __r_.__is_zero(); }
+
+  _LIBCPP_INLINE_VISIBILITY char __next() {
+    uint32_t __d = __r_.__divide_small_quotient(__s_);
+    __r_.__mul_small(10);
+    return static_cast<char>('0' + __d);
+  }
+
+  // Compares the part of the value not yet produced with half a unit in the
+  // position of the last digit produced (or of the digit before the first one
+  // if none were produced yet).
+  _LIBCPP_INLINE_VISIBILITY int __compare_half() const {
+    __big_uint<_Bits> __half = __s_;
+    __half.__mul_small(5);
+    return __big_uint<_Bits>::__compare(__r_, __half);
+  }
+
+private:
+  __big_uint<_Bits> __r_;
+  __big_uint<_Bits> __s_;
+  int __exponent_;
+};
+
+// Burger & Dybvig's free-format algorithm: writes the shortest digit string
+// that rounds back to __mantissa * 2^__exponent and returns its length;
+// __sci_exponent receives the decimal exponent of the first digit. Used for
+// the formats Ryu does not cover.
+template <size_t _Bits, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY int
+__exact_shortest(_Mantissa __mantissa, int __exponent, bool __unequal_gaps, char* __digits, int& __sci_exponent) {
+  using _Big = __big_uint<_Bits>;
+  const bool __even = (__mantissa & 1) == 0;
+  _Big __r, __s, __mp, __mm;
+  __r.__assign(__mantissa);
+  __s.__assign(uint64_t(1));
+  __mp.__assign(uint64_t(1));
+  __mm.__assign(uint64_t(1));
+  // The gap above the value is twice the gap below it at powers of two.
+  const size_t __shift = __unequal_gaps ? 2 : 1;
+  if (__exponent >= 0) {
+    __r.__shift_left(static_cast<size_t>(__exponent) + __shift);
+    __s.__shift_left(__shift);
+    __mp.__shift_left(static_cast<size_t>(__exponent) + __shift - 1);
+    __mm.__shift_left(static_cast<size_t>(__exponent));
+  } else {
+    __r.__shift_left(__shift);
+    __s.__shift_left(static_cast<size_t>(-__exponent) + __shift);
+    __mp.__shift_left(__shift - 1);
+  }
+
+  int __k = __estimate_log10_pow2(__bit_width(__mantissa) + __exponent);
+  if (__k >= 0) {
+    __s.__mul_pow10(static_cast<unsigned>(__k));
+  } else {
+    __r.__mul_pow10(static_cast<unsigned>(-__k));
+    __mp.__mul_pow10(static_cast<unsigned>(-__k));
+    __mm.__mul_pow10(static_cast<unsigned>(-__k));
+  }
+  // Find the __k for which 10^(__k - 1) <= high < 10^__k, where high is the
+  // upper bound of the rounding interval (excluded when the mantissa is odd).
+  for (;;) {
+    int __c = _Big::__compare_sum(__r, __mp, __s);
+    if (__even ? __c < 0 : __c <= 0)
+      break;
+    __s.__mul_small(10);
+    ++__k;
+  }
+  for (;;) {
+    _Big __high = __r;
+    __high.__add(__mp).__mul_small(10);
+    int __c = _Big::__compare(__high, __s);
+    if (__even ? __c >= 0 : __c > 0)
+      break;
+    __r.__mul_small(10);
+    __mp.__mul_small(10);
+    __mm.__mul_small(10);
+    --__k;
+  }
+  __sci_exponent = __k - 1;
+
+  int __n = 0;
+  for (;;) {
+    __r.__mul_small(10);
+    __mp.__mul_small(10);
+    __mm.__mul_small(10);
+    uint32_t __d = __r.__divide_small_quotient(__s);
+    int __low_c = _Big::__compare(__r, __mm);
+    int __high_c = _Big::__compare_sum(__r, __mp, __s);
+    bool __low = __even ? __low_c <= 0 : __low_c < 0;
+    bool __high = __even ? __high_c >= 0 : __high_c > 0;
+    if (!__low && !__high) {
+      __digits[__n++] = static_cast<char>('0' + __d);
+      continue;
+    }
+    if (__low && __high) {
+      // Both candidates round-trip; pick the closer one, ties to even.
+      _Big __twice = __r;
+      __twice.__shift_left(1);
+      int __c = _Big::__compare(__twice, __s);
+      __high = __c > 0 || (__c == 0 && (__d & 1) != 0);
+    }
+    __digits[__n++] = static_cast<char>('0' + __d + (__high ? 1 : 0));
+    return __n;
+  }
+}
+
+// Writes the significand digits of a decimal value of the form
+// d1.d2...dn * 10^__sci_exponent, which are at [__first, __first + __n), as
+// "ddd.ddd" with exactly __precision digits after the decimal point (omitted
+// when __precision is zero). The digits must fit within the requested
+// precision, missing digits are zeros.
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__layout_fixed(char* __first, char* __last, int __n, int __sci_exponent, int __precision) {
+  const int __integer_digits = __sci_exponent >= 0 ? __sci_exponent + 1 : 1;
+  const ptrdiff_t __size = static_cast<ptrdiff_t>(__integer_digits) + (__precision > 0 ? 1 + __precision : 0);
+  if (__last - __first < __size)
+    return {__last, errc::value_too_large};
+
+  char* __end = __first + __size;
+  if (__sci_exponent >= 0) {
+    const int __in_integer = __n < __integer_digits ? __n : __integer_digits;
+    const int __in_fraction = __n - __in_integer;
+    if (__in_fraction > 0)
+      _VSTD::memmove(__first + __integer_digits + 1, __first + __in_integer, static_cast<size_t>(__in_fraction));
+    _VSTD::memset(__first + __in_integer, '0', static_cast<size_t>(__integer_digits - __in_integer));
+    if (__precision > 0) {
+      __first[__integer_digits] = '.';
+      char* __pad = __first + __integer_digits + 1 + __in_fraction;
+      _VSTD::memset(__pad, '0', static_cast<size_t>(__end - __pad));
+    }
+  } else {
+    // 0.000ddd
+    const int __leading_zeros = -__sci_exponent - 1;
+    if (__n > 0)
+      _VSTD::memmove(__first + 2 + __leading_zeros, __first, static_cast<size_t>(__n));
+    __first[0] = '0';
+    if (__precision > 0) {
+      __first[1] = '.';
+      _VSTD::memset(__first + 2, '0', static_cast<size_t>(__leading_zeros));
+      char* __pad = __first + 2 + __leading_zeros + __n;
+      _VSTD::memset(__pad, '0', static_cast<size_t>(__end - __pad));
+    }
+  }
+  return {__end, errc{}};
+}
+
+// Writes the significand digits at [__first, __first + __n) as
+// "d.ddde+XX" with exactly __precision digits after the decimal point
+// (omitted when __precision is zero).
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__layout_scientific(char* __first, char* __last, int __n, int __sci_exponent, int __precision) {
+  const unsigned __abs_exponent = __sci_exponent < 0 ? static_cast<unsigned>(-__sci_exponent) : __sci_exponent;
+  const int __exponent_digits = __abs_exponent >= 1000 ? 4 : (__abs_exponent >= 100 ? 3 : 2);
+  const ptrdiff_t __size = 1 + (__precision > 0 ? 1 + static_cast<ptrdiff_t>(__precision) : 0) + 2 + __exponent_digits;
+  if (__last - __first < __size)
+    return {__last, errc::value_too_large};
+
+  if (__n == 0)
+    __first[0] = '0';
+  char* __p = __first + 1;
+  if (__precision > 0) {
+    if (__n > 1)
+      _VSTD::memmove(__first + 2, __first + 1, static_cast<size_t>(__n - 1));
+    __first[1] = '.';
+    const int __in_fraction = __n > 1 ? __n - 1 : 0;
+    _VSTD::memset(__first + 2 + __in_fraction, '0', static_cast<size_t>(__precision - __in_fraction));
+    __p = __first + 2 + __precision;
+  }
+  *__p++ = 'e';
+  *__p++ = __sci_exponent < 0 ? '-' : '+';
+  char* __end = __p + __exponent_digits;
+  unsigned __e = __abs_exponent;
+  for (char* __q = __end; __q != __p; __e /= 10)
+    *--__q = static_cast<char>('0' + __e % 10);
+  return {__end, errc{}};
+}
+
+// Rounds the digit string [__first, __first + __n) up by one unit in the last
+// place. Returns true if the carry propagated out of the first digit, in
+// which case the string reads "100...0".
+inline _LIBCPP_INLINE_VISIBILITY bool __round_up(char* __first, int __n) {
+  for (int __i = __n; __i-- > 0;) {
+    if (__first[__i] != '9') {
+      ++__first[__i];
+      return false;
+    }
+    __first[__i] = '0';
+  }
+  if (__n > 0)
+    __first[0] = '1';
+  return true;
+}
+
+// Generates exactly __count correctly rounded significant digits into
+// [__first, __first + __count), or fewer if the remaining ones are zero.
+// Returns the number of digits written; __sci_exponent is adjusted when the
+// rounding carries into a new leading digit. __count may be zero, in which
+// case the value either rounds down to nothing or up to a single "1".
+template <size_t _Bits>
+inline _LIBCPP_INLINE_VISIBILITY int
+__generate_rounded(__exact_digit_generator<_Bits>& __gen, char* __first, int __count, int& __sci_exponent) {
+  int __n = 0;
+  while (__n < __count && !__gen.__done())
+    __first[__n++] = __gen.__next();
+  if (__n < __count || __gen.__done())
+    return __n;
+  const int __c = __gen.__compare_half();
+  if (__c > 0 || (__c == 0 && __n > 0 && ((__first[__n - 1] - '0') & 1) != 0)) {
+    if (__round_up(__first, __n)) {
+      ++__sci_exponent;
+      if (__n == 0)
+        __first[__n++] = '1';
+    }
+  }
+  return __n;
+}
+
+template <class _Fp, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__fixed_precision_to_chars(char* __first, char* __last, const __decomposed_float<_Mantissa>& __d, int __precision) {
+  if (__d.__kind == __float_kind::__zero)
+    return __layout_fixed(__first, __last, 0, 0, __precision);
+
+  __exact_digit_generator<__bignum_bits<_Fp>> __gen(__d.__mantissa, __d.__exponent);
+  int __sci_exponent = __gen.__exponent();
+  // The number of digits down to the 10^-__precision position.
+  const int64_t __count = static_cast<int64_t>(__sci_exponent) + 1 + __precision;
+  if (__count < 0)
+    return __layout_fixed(__first, __last, 0, 0, __precision);
+  // All the digits are part of the output, so they must fit. Rounding may
+  // still produce a single digit when none are requested.
+  if (__count > __last - __first || __first == __last)
+    return {__last, errc::value_too_large};
+  const int __n = __generate_rounded(__gen, __first, static_cast<int>(__count), __sci_exponent);
+  if (__n == 0)
+    return __layout_fixed(__first, __last, 0, 0, __precision);
+  return __layout_fixed(__first, __last, __n, __sci_exponent, __precision);
+}
+
+template <class _Fp, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__scientific_precision_to_chars(char* __first, char* __last, const __decomposed_float<_Mantissa>& __d,
+                                int __precision) {
+  if (__d.__kind == __float_kind::__zero)
+    return __layout_scientific(__first, __last, 0, 0, __precision);
+
+  if (static_cast<int64_t>(__precision) + 1 > __last - __first)
+    return {__last, errc::value_too_large};
+  __exact_digit_generator<__bignum_bits<_Fp>> __gen(__d.__mantissa, __d.__exponent);
+  int __sci_exponent = __gen.__exponent();
+  const int __n = __generate_rounded(__gen, __first, __precision + 1, __sci_exponent);
+  return __layout_scientific(__first, __last, __n, __sci_exponent, __precision);
+}
+
+// %g: the precision is the number of significant digits, the style depends on
+// the exponent after rounding, and trailing zeros are removed.
+template <class _Fp, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__general_precision_to_chars(char* __first, char* __last, const __decomposed_float<_Mantissa>& __d,
+                             int __precision) {
+  if (__precision == 0)
+    __precision = 1;
+  if (__d.__kind == __float_kind::__zero)
+    return __layout_fixed(__first, __last, 0, 0, 0);
+
+  __exact_digit_generator<__bignum_bits<_Fp>> __gen(__d.__mantissa, __d.__exponent);
+  int __sci_exponent = __gen.__exponent();
+  const ptrdiff_t __capacity = __last - __first;
+  int __n = 0;
+  if (__precision <= __capacity) {
+    __n = __generate_rounded(__gen, __first, __precision, __sci_exponent);
+  } else {
+    // The requested digits do not fit, but the result still might once the
+    // trailing zeros are removed. That is the case if all the digits beyond
+    // the buffer are zeros that get rounded down, or nines that get rounded
+    // up into the buffer.
+    int __beyond = 0;
+    bool __all_zeros = true;
+    bool __all_nines = true;
+    char __last_digit = '0';
+    while (__n + __beyond < __precision && !__gen.__done()) {
+      char __c = __gen.__next();
+      if (__n < __capacity) {
+        __first[__n++] = __c;
+      } else {
+        ++__beyond;
+        __all_zeros &= __c == '0';
+        __all_nines &= __c == '9';
+      }
+      __last_digit = __c;
+    }
+    if (__beyond != 0) {
+      bool __up = false;
+      if (__n + __beyond == __precision && !__gen.__done()) {
+        const int __c = __gen.__compare_half();
+        __up = __c > 0 || (__c == 0 && ((__last_digit - '0') & 1) != 0);
+      }
+      if (__up ? !__all_nines : !__all_zeros)
+        return {__last, errc::value_too_large};
+      if (__up && __round_up(__first, __n))
+        ++__sci_exponent;
+    }
+  }
+
+  while (__n > 0 && __first[__n - 1] == '0')
+    --__n;
+  if (-4 <= __sci_exponent && __sci_exponent < __precision) {
+    const int __fraction_digits = __n - 1 - __sci_exponent;
+    return __layout_fixed(__first, __last, __n, __sci_exponent, __fraction_digits > 0 ? __fraction_digits : 0);
+  }
+  return __layout_scientific(__first, __last, __n, __sci_exponent, __n - 1);
+}
+
+// Prints an integral value exactly: the fixed notation of a value whose
+// shortest representation would need zeros before the decimal point.
+template <class _Fp, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__integer_to_chars(char* __first, char* __last, const __decomposed_float<_Mantissa>& __d) {
+  // The value is an integer, so any bits shifted out are zeros.
+  const _Mantissa __m = __d.__exponent < 0 ? __d.__mantissa >> -__d.__exponent : __d.__mantissa;
+  const int __e = __d.__exponent < 0 ? 0 : __d.__exponent;
+  if (__bit_width(__m) + __e <= 64)
+    return _VSTD::to_chars(__first, __last, static_cast<uint64_t>(__m) << __e);
+  return __fixed_precision_to_chars<_Fp>(__first, __last, __d, 0);
+}
+
+// Lays out a shortest round-trip digit string. __fmt is chars_format{} for the
+// overload without a format.
+template <class _Fp, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__layout_shortest(char* __first, char* __last, const __decomposed_float<_Mantissa>& __d, const char* __digits,
+                  int __n, int __sci_exponent, chars_format __fmt) {
+  // The exponent of the last digit.
+  const int __exponent = __sci_exponent - __n + 1;
+  if (__fmt == chars_format{}) {
+    // Pick the shorter of fixed and scientific, preferring fixed on ties.
+    //   Value   | Fixed       | Scientific
+    //   1e-3    | "0.001"     | "1e-03"
+    //   1e4     | "10000"     | "1e+04"
+    //   1234e-7 | "0.0001234" | "1.234e-04"
+    //   1234e5  | "123400000" | "1.234e+08"
+    const int __lower = __n == 1 ? -3 : -(__n + 3);
+    const int __upper = __n == 1 ? 4 : 5;
+    __fmt = __lower <= __exponent && __exponent <= __upper ? chars_format::fixed : chars_format::scientific;
+  } else if (__fmt == chars_format::general) {
+    // As %g with the precision P being 6: fixed if P > X >= -4.
+    __fmt = -4 <= __sci_exponent && __sci_exponent < 6 ? chars_format::fixed : chars_format::scientific;
+  }
+
+  if (__fmt == chars_format::fixed && __exponent > 0) {
+    // The shortest digits would be followed by zeros, but the exact value of
+    // the integer has the same length and is closer.
+    return __integer_to_chars<_Fp>(__first, __last, __d);
+  }
+
+  if (__n > __last - __first)
+    return {__last, errc::value_too_large};
+  _VSTD::memcpy(__first, __digits, static_cast<size_t>(__n));
+  if (__fmt == chars_format::fixed)
+    return __layout_fixed(__first, __last, __n, __sci_exponent, __exponent < 0 ? -__exponent : 0);
+  return __layout_scientific(__first, __last, __n, __sci_exponent, __n - 1);
+}
+
+// Writes the shortest round-trip significand digits of a finite non-zero value
+// and returns their number; __sci_exponent receives the decimal exponent of
+// the first digit.
+template <class _Fp, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY int
+__shortest_digits(const __decomposed_float<_Mantissa>& __d, char* __digits, int& __sci_exponent) {
+  using _Traits = __float_traits<_Fp>;
+  constexpr int __fraction_bits = _Traits::__mantissa_bits - 1;
+  if constexpr (is_same<_Fp, float>::value || is_same<_Fp, double>::value) {
+    const uint64_t __fraction = __d.__mantissa & ((uint64_t(1) << __fraction_bits) - 1);
+    const uint32_t __biased =
+        __d.__subnormal ? 0 : static_cast<uint32_t>(__d.__exponent - __min_exponent<_Fp> + 1);
+    const __ryu::__floating_decimal __fd =
+        __ryu::__shortest<__fraction_bits, _Traits::__exponent_bias>(__fraction, __biased);
+    const int __n = static_cast<int>(__itoa::__u64toa(__fd.__mantissa, __digits) - __digits);
+    __sci_exponent = __fd.__exponent + __n - 1;
+    return __n;
+  } else {
+    const bool __unequal_gaps = !__d.__subnormal && __d.__mantissa == (_Mantissa(1) << __fraction_bits) &&
+                                __d.__exponent > __min_exponent<_Fp>;
+    return __exact_shortest<__bignum_bits<_Fp>>(__d.__mantissa, __d.__exponent, __unequal_gaps, __digits,
+                                                __sci_exponent);
+  }
+}
+
+// %a without the "0x" prefix. __precision is negative for the shortest form.
+template <class _Fp, class _Mantissa>
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__hex_to_chars(char* __first, char* __last, const __decomposed_float<_Mantissa>& __d, int __precision) {
+  constexpr int __fraction_bits = __float_traits<_Fp>::__mantissa_bits - 1;
+  constexpr int __fraction_hexits = (__fraction_bits + 3) / 4;
+  _Mantissa __fraction = 0;
+  unsigned __leading = 0;
+  int __exponent = 0;
+  if (__d.__kind != __float_kind::__zero) {
+    __fraction = (__d.__mantissa & ((_Mantissa(1) << __fraction_bits) - 1)) << (4 * __fraction_hexits - __fraction_bits);
+    __leading = static_cast<unsigned>(__d.__mantissa >> __fraction_bits);
+    __exponent = __d.__subnormal ? __min_exponent<_Fp> + __fraction_bits : __d.__exponent + __fraction_bits;
+  }
+
+  int __hexits = __fraction_hexits;
+  if (__precision < 0) {
+    if (__fraction == 0)
+      __hexits = 0;
+    else
+      for (; (__fraction & 0xf) == 0; __fraction >>= 4)
+        --__hexits;
+    __precision = __hexits;
+  } else if (__precision < __hexits) {
+    // Round to nearest, ties to even.
+    const int __dropped_bits = 4 * (__hexits - __precision);
+    const _Mantissa __dropped = __fraction & ((_Mantissa(1) << (__dropped_bits - 1) << 1) - 1);
+    const _Mantissa __half = _Mantissa(1) << (__dropped_bits - 1);
+    __fraction = __precision == 0 ? 0 : __fraction >> __dropped_bits;
+    const bool __odd = __precision == 0 ? (__leading & 1) != 0 : (__fraction & 1) != 0;
+    if (__dropped > __half || (__dropped == __half && __odd)) {
+      if (__precision == 0 || ++__fraction == _Mantissa(1) << (4 * __precision)) {
+        __fraction = 0;
+        ++__leading;
+      }
+    }
+    __hexits = __precision;
+  }
+
+  const unsigned __abs_exponent = __exponent < 0 ? static_cast<unsigned>(-__exponent) : __exponent;
+  const int __exponent_digits = __abs_exponent >= 10000 ? 5 : __abs_exponent >= 1000 ? 4 : __abs_exponent >= 100 ? 3
+                                : __abs_exponent >= 10 ? 2 : 1;
+  const ptrdiff_t __size = 1 + (__precision > 0 ? 1 + static_cast<ptrdiff_t>(__precision) : 0) + 2 + __exponent_digits;
+  if (__last - __first < __size)
+    return {__last, errc::value_too_large};
+
+  char* __p = __first;
+  *__p++ = static_cast<char>('0' + __leading);
+  if (__precision > 0) {
+    *__p++ = '.';
+    for (int __i = __hexits; __i-- > 0;)
+      *__p++ = "0123456789abcdef"[static_cast<unsigned>(__fraction >> (4 * __i)) & 0xf];
+    _VSTD::memset(__p, '0', static_cast<size_t>(__precision - __hexits));
+    __p += __precision - __hexits;
+  }
+  *__p++ = 'p';
+  *__p++ = __exponent < 0 ? '-' : '+';
+  char* __end = __p + __exponent_digits;
+  unsigned __e = __abs_exponent;
+  for (char* __q = __end; __q != __p; __e /= 10)
+    *--__q = static_cast<char>('0' + __e % 10);
+  return {__end, errc{}};
+}
+
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result __copy_literal(char* __first, char* __last, const char* __s,
+                                                                size_t __n) {
+  if (static_cast<size_t>(__last - __first) < __n)
+    return {__last, errc::value_too_large};
+  _VSTD::memcpy(__first, __s, __n);
+  return {__first + __n, errc{}};
+}
+
+// __precision is negative for the shortest round-trip conversions, and __fmt
+// is chars_format{} for the overload without a format.
+template <class _Fp>
+inline _LIBCPP_INLINE_VISIBILITY to_chars_result
+__floating_to_chars(char* __first, char* __last, _Fp __value, chars_format __fmt, int __precision) {
+  _LIBCPP_ASSERT(__fmt == chars_format{} || __fmt == chars_format::scientific || __fmt == chars_format::fixed ||
+                     __fmt == chars_format::general || __fmt == chars_format::hex,
+                 "invalid chars_format");
+  const auto __d = __decompose(__value);
+  if (__d.__negative) {
+    if (__first == __last)
+      return {__last, errc::value_too_large};
+    *__first++ = '-';
+  }
+
+  switch (__d.__kind) {
+  case __float_kind::__infinity:
+    return __copy_literal(__first, __last, "inf", 3);
+  case __float_kind::__nan:
+    return __copy_literal(__first, __last, "nan", 3);
+  case __float_kind::__zero:
+  case __float_kind::__finite:
+    break;
+  }
+
+  if (__fmt == chars_format::hex)
+    return __hex_to_chars<_Fp>(__first, __last, __d, __precision);
+
+  if (__precision >= 0) {
+    if (__fmt == chars_format::fixed)
+      return __fixed_precision_to_chars<_Fp>(__first, __last, __d, __precision);
+    if (__fmt == chars_format::scientific)
+      return __scientific_precision_to_chars<_Fp>(__first, __last, __d, __precision);
+    return __general_precision_to_chars<_Fp>(__first, __last, __d, __precision);
+  }
+
+  if (__d.__kind == __float_kind::__zero) {
+    if (__fmt == chars_format::scientific)
+      return __copy_literal(__first, __last, "0e+00", 5);
+    return __copy_literal(__first, __last, "0", 1);
+  }
+
+  // Enough for the shortest representation of any supported format.
+  char __digits[40];
+  int __sci_exponent;
+  const int __n = __shortest_digits<_Fp>(__d, __digits, __sci_exponent);
+  return __layout_shortest<_Fp>(__first, __last, __d, __digits, __n, __sci_exponent, __fmt);
+}
+
+} // namespace __charconv
+
+_LIBCPP_END_NAMESPACE_STD
+
+#endif // _LIBCPP_SRC_INCLUDE_TO_CHARS_FLOATING_POINT_H
@@ -0,0 +1,617 @@
+//===------------------------ memory_resource.cpp -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "memory"
+#include "memory_resource"
+#include "new"
+#ifndef _LIBCPP_HAS_NO_THREADS
+#include "mutex"
+#include "thread"
+#if defined(__ELF__) && defined(_LIBCPP_LINK_PTHREAD_LIB)
+#pragma comment(lib, "pthread")
+#endif
+#endif
+#include "include/atomic_support.h"
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace pmr
+{
+
+// memory_resource
+
+memory_resource::~memory_resource() = default;
+
+// new_delete_resource()
+
+namespace
+{
+
+class _LIBCPP_HIDDEN __new_delete_memory_resource_imp : public memory_resource
+{
+  void* do_allocate(size_t __bytes, size_t __align) override
+  { return _VSTD::__libcpp_allocate(__bytes, __align); }
+
+  void do_deallocate(void* __p, size_t __bytes, size_t __align) override
+  { _VSTD::__libcpp_deallocate(__p, __bytes, __align); }
+
+  bool do_is_equal(const memory_resource& __other) const noexcept override
+  { return &__other == this; }
+
+public:
+  constexpr __new_delete_memory_resource_imp() = default;
+};
+
+// null_memory_resource()
+
+class _LIBCPP_HIDDEN __null_memory_resource_imp : public memory_resource
+{
+  void* do_allocate(size_t, size_t) override { __throw_bad_alloc(); }
+  void do_deallocate(void*, size_t, size_t) override {}
+  bool do_is_equal(const memory_resource& __other) const noexcept override
+  { return &__other == this; }
+
+public:
+  constexpr __null_memory_resource_imp() = default;
+};
+
+_LIBCPP_SAFE_STATIC _LIBCPP_NO_DESTROY __new_delete_memory_resource_imp __new_delete_res;
+_LIBCPP_SAFE_STATIC _LIBCPP_NO_DESTROY __null_memory_resource_imp __null_res;
+_LIBCPP_SAFE_STATIC memory_resource* __default_res = &__new_delete_res;
+
+} // namespace
+
+memory_resource* new_delete_resource() noexcept
+{
+  return &__new_delete_res;
+}
+
+memory_resource* null_memory_resource() noexcept
+{
+  return &__null_res;
+}
+
+// default_memory_resource()
+
+memory_resource* get_default_resource() noexcept
+{
+  return __libcpp_atomic_load(&__default_res, _AO_Acquire);
+}
+
+memory_resource* set_default_resource(memory_resource* __new_res) noexcept
+{
+  if (__new_res == nullptr)
+    __new_res = &__new_delete_res;
+  return __libcpp_atomic_exchange(&__default_res, __new_res, _AO_Acq_Rel);
+}
+
+// 23.12.5, mem.res.pool
+
+namespace
+{
+
+const size_t __default_max_blocks_per_chunk = size_t(1) << 20;
+const size_t __min_blocks_per_chunk = 16;
+const size_t __default_largest_block_size = size_t(1) << 20;
+const size_t __max_largest_block_size = size_t(1) << 30;
+// The first chunk of a pool holds at least this many bytes of blocks, so
+// pools of small blocks do not go upstream for every handful of requests.
+const size_t __min_bytes_per_first_chunk = 1024;
+
+inline size_t __roundup(size_t __count, size_t __alignment)
+{
+  const size_t __mask = __alignment - 1;
+  const size_t __result = (__count + __mask) & ~__mask;
+  if (__result < __count)
+    __throw_bad_alloc();
+  return __result;
+}
+
+inline size_t __pool_block_size(int __i)
+{
+  return unsynchronized_pool_resource::__smallest_block_size << __i;
+}
+
+} // namespace
+
+// An adhoc chunk is the user's memory followed by its footer.
+
+struct unsynchronized_pool_resource::__adhoc_pool::__chunk_footer
+{
+  __chunk_footer* __prev_;
+  __chunk_footer* __next_;
+  char* __start_;
+  size_t __align_;
+
+  size_t __allocation_size() const
+  { return static_cast<size_t>(reinterpret_cast<const char*>(this) - __start_) + sizeof(*this); }
+};
+
+void* unsynchronized_pool_resource::__adhoc_pool::__allocate(
+    memory_resource* __upstream, size_t __bytes, size_t __align)
+{
+  const size_t __footer_size = sizeof(__chunk_footer);
+  const size_t __footer_align = alignof(__chunk_footer);
+  const size_t __aligned_capacity = __roundup(__bytes, __footer_align);
+  if (__aligned_capacity + __footer_size < __aligned_capacity)
+    __throw_bad_alloc();
+  if (__align < __footer_align)
+    __align = __footer_align;
+
+  char* __result = static_cast<char*>(__upstream->allocate(__aligned_capacity + __footer_size, __align));
+  __chunk_footer* __h = reinterpret_cast<__chunk_footer*>(__result + __aligned_capacity);
+  __h->__prev_ = nullptr;
+  __h->__next_ = __first_;
+  __h->__start_ = __result;
+  __h->__align_ = __align;
+  if (__first_ != nullptr)
+    __first_->__prev_ = __h;
+  __first_ = __h;
+  return __result;
+}
+
+void unsynchronized_pool_resource::__adhoc_pool::__deallocate(
+    memory_resource* __upstream, void* __p, size_t __bytes, size_t)
+{
+  // The footer sits right after the user's bytes, so finding it needs no
+  // search and unlinking it is constant time.
+  __chunk_footer* __h = reinterpret_cast<__chunk_footer*>(
+      static_cast<char*>(__p) + __roundup(__bytes, alignof(__chunk_footer)));
+  _LIBCPP_ASSERT(__h->__start_ == __p, "deallocating a block that was not allocated with this allocator");
+  if (__h->__prev_ != nullptr)
+    __h->__prev_->__next_ = __h->__next_;
+  else
+    __first_ = __h->__next_;
+  if (__h->__next_ != nullptr)
+    __h->__next_->__prev_ = __h->__prev_;
+  __upstream->deallocate(__p, __h->__allocation_size(), __h->__align_);
+}
+
+void unsynchronized_pool_resource::__adhoc_pool::__release(memory_resource* __upstream)
+{
+  while (__first_ != nullptr) {
+    __chunk_footer* __next = __first_->__next_;
+    __upstream->deallocate(__first_->__start_, __first_->__allocation_size(), __first_->__align_);
+    __first_ = __next;
+  }
+}
+
+// A fixed pool hands out blocks of a single size. Freed blocks are kept on an
+// intrusive free list; fresh blocks are carved from the newest chunk only when
+// the free list is empty, so a new chunk costs nothing until it is used.
+
+class unsynchronized_pool_resource::__fixed_pool
+{
+  struct __chunk_footer
+  {
+    __chunk_footer* __next_;
+    char* __start_;
+    size_t __align_;
+
+    size_t __allocation_size() const
+    { return static_cast<size_t>(reinterpret_cast<const char*>(this) - __start_) + sizeof(*this); }
+  };
+
+  struct __vacancy_header
+  {
+    __vacancy_header* __next_vacancy_;
+  };
+
+  __chunk_footer* __first_chunk_ = nullptr;
+  __vacancy_header* __first_vacancy_ = nullptr;
+  char* __bump_cur_ = nullptr;
+  char* __bump_end_ = nullptr;
+  size_t __next_chunk_blocks_ = 0;
+
+public:
+  void* __allocate(memory_resource* __upstream, size_t __block_size, size_t __max_blocks_per_chunk)
+  {
+    if (__first_vacancy_ != nullptr) {
+      void* __result = __first_vacancy_;
+      __first_vacancy_ = __first_vacancy_->__next_vacancy_;
+      return __result;
+    }
+    if (__bump_cur_ == __bump_end_)
+      __allocate_chunk(__upstream, __block_size, __max_blocks_per_chunk);
+    void* __result = __bump_cur_;
+    __bump_cur_ += __block_size;
+    return __result;
+  }
+
+  void __deallocate(void* __p)
+  {
+    __vacancy_header* __v = static_cast<__vacancy_header*>(__p);
+    __v->__next_vacancy_ = __first_vacancy_;
+    __first_vacancy_ = __v;
+  }
+
+  void __release(memory_resource* __upstream)
+  {
+    while (__first_chunk_ != nullptr) {
+      __chunk_footer* __next = __first_chunk_->__next_;
+      __upstream->deallocate(__first_chunk_->__start_, __first_chunk_->__allocation_size(),
+                             __first_chunk_->__align_);
+      __first_chunk_ = __next;
+    }
+    __first_vacancy_ = nullptr;
+    __bump_cur_ = __bump_end_ = nullptr;
+    __next_chunk_blocks_ = 0;
+  }
+
+private:
+  void __allocate_chunk(memory_resource* __upstream, size_t __block_size, size_t __max_blocks_per_chunk)
+  {
+    size_t __blocks = __next_chunk_blocks_;
+    if (__blocks == 0) {
+      __blocks = __min_bytes_per_first_chunk / __block_size;
+      if (__blocks == 0)
+        __blocks = 1;
+    }
+    if (__blocks > __max_blocks_per_chunk)
+      __blocks = __max_blocks_per_chunk;
+
+    // Block sizes are powers of two no smaller than the requested alignment,
+    // so aligning the chunk to max_align_t aligns every block in it.
+    const size_t __align = alignof(max_align_t);
+    size_t __bytes;
+    if (__builtin_mul_overflow(__blocks, __block_size, &__bytes) ||
+        __bytes + sizeof(__chunk_footer) < __bytes)
+      __throw_bad_alloc();
+
+    char* __start = static_cast<char*>(__upstream->allocate(__bytes + sizeof(__chunk_footer), __align));
+    __chunk_footer* __h = reinterpret_cast<__chunk_footer*>(__start + __bytes);
+    __h->__next_ = __first_chunk_;
+    __h->__start_ = __start;
+    __h->__align_ = __align;
+    __first_chunk_ = __h;
+
+    __bump_cur_ = __start;
+    __bump_end_ = __start + __bytes;
+    __next_chunk_blocks_ = __blocks <= __max_blocks_per_chunk / 2 ? __blocks * 2 : __max_blocks_per_chunk;
+  }
+};
+
+pool_options unsynchronized_pool_resource::__normalize_options(const pool_options& __opts, int& __num_fixed_pools)
+{
+  pool_options __result;
+
+  __result.max_blocks_per_chunk = __opts.max_blocks_per_chunk;
+  if (__result.max_blocks_per_chunk == 0 || __result.max_blocks_per_chunk > __default_max_blocks_per_chunk)
+    __result.max_blocks_per_chunk = __default_max_blocks_per_chunk;
+  else if (__result.max_blocks_per_chunk < __min_blocks_per_chunk)
+    __result.max_blocks_per_chunk = __min_blocks_per_chunk;
+
+  size_t __largest = __opts.largest_required_pool_block;
+  if (__largest == 0)
+    __largest = __default_largest_block_size;
+  else if (__largest > __max_largest_block_size)
+    __largest = __max_largest_block_size;
+  else if (__largest < __smallest_block_size)
+    __largest = __smallest_block_size;
+
+  __num_fixed_pools = 1;
+  while (__pool_block_size(__num_fixed_pools - 1) < __largest)
+    ++__num_fixed_pools;
+  __result.largest_required_pool_block = __pool_block_size(__num_fixed_pools - 1);
+  return __result;
+}
+
+unsynchronized_pool_resource::unsynchronized_pool_resource(const pool_options& __opts, memory_resource* __upstream)
+    : __res_(__upstream), __fixed_pools_(nullptr)
+{
+  __options_max_blocks_per_chunk_ = __normalize_options(__opts, __num_fixed_pools_).max_blocks_per_chunk;
+}
+
+pool_options unsynchronized_pool_resource::options() const
+{
+  pool_options __p;
+  __p.max_blocks_per_chunk = __options_max_blocks_per_chunk_;
+  __p.largest_required_pool_block = __pool_block_size(__num_fixed_pools_ - 1);
+  return __p;
+}
+
+void unsynchronized_pool_resource::release()
+{
+  __adhoc_pool_.__release(__res_);
+  if (__fixed_pools_ != nullptr) {
+    const int __n = __num_fixed_pools_;
+    for (int __i = 0; __i < __n; ++__i)
+      __fixed_pools_[__i].__release(__res_);
+    __res_->deallocate(__fixed_pools_, __n * sizeof(__fixed_pool), alignof(__fixed_pool));
+    __fixed_pools_ = nullptr;
+  }
+}
+
+void* unsynchronized_pool_resource::do_allocate(size_t __bytes, size_t __align)
+{
+  // A pointer to allocated storage (6.6.4.4.1) with a size of at least bytes.
+  // The size and alignment of the allocated memory shall meet the requirements
+  // for a class derived from memory_resource (23.12).
+  // If the pool selected for a block of size bytes is unable to satisfy the
+  // memory request from its own internal data structures, it will call
+  // upstream_resource()->allocate() to obtain more memory.
+  //
+  // If bytes is larger than that which the largest pool can handle, then
+  // memory will be allocated using upstream_resource()->allocate().
+
+  int __i = __pool_index(__bytes, __align, __num_fixed_pools_);
+  if (__i == __num_fixed_pools_)
+    return __adhoc_pool_.__allocate(__res_, __bytes, __align);
+
+  if (__fixed_pools_ == nullptr) {
+    __fixed_pools_ = static_cast<__fixed_pool*>(
+        __res_->allocate(__num_fixed_pools_ * sizeof(__fixed_pool), alignof(__fixed_pool)));
+    for (int __j = 0; __j < __num_fixed_pools_; ++__j)
+      ::new ((void*)(__fixed_pools_ + __j)) __fixed_pool();
+  }
+  return __fixed_pools_[__i].__allocate(__res_, __pool_block_size(__i), __options_max_blocks_per_chunk_);
+}
+
+void unsynchronized_pool_resource::do_deallocate(void* __p, size_t __bytes, size_t __align)
+{
+  // Returns the memory at p to the pool. It is unspecified if, or under what
+  // circumstances, this operation will result in a call to
+  // upstream_resource()->deallocate().
+
+  int __i = __pool_index(__bytes, __align, __num_fixed_pools_);
+  if (__i == __num_fixed_pools_)
+    return __adhoc_pool_.__deallocate(__res_, __p, __bytes, __align);
+
+  _LIBCPP_ASSERT(__fixed_pools_ != nullptr, "deallocating a block that was not allocated with this allocator");
+  __fixed_pools_[__i].__deallocate(__p);
+}
+
+// synchronized_pool_resource
+
+namespace
+{
+
+const size_t __cache_line_size = 64;
+const size_t __max_shards = 64;
+
+} // namespace
+
+struct alignas(__cache_line_size) synchronized_pool_resource::__shard
+{
+#ifndef _LIBCPP_HAS_NO_THREADS
+  mutex __mut_;
+#endif
+  unsynchronized_pool_resource::__fixed_pool* __pools_;
+};
+
+synchronized_pool_resource::synchronized_pool_resource(const pool_options& __opts, memory_resource* __upstream)
+    : __res_(__upstream), __shards_(nullptr), __shard_mask_(0)
+{
+  __options_ = unsynchronized_pool_resource::__normalize_options(__opts, __num_fixed_pools_);
+}
+
+synchronized_pool_resource::~synchronized_pool_resource()
+{
+  release();
+}
+
+pool_options synchronized_pool_resource::options() const
+{
+  return __options_;
+}
+
+namespace
+{
+
+// Each shard's pools start on their own cache line so that threads working on
+// neighbouring shards do not contend for the same lines.
+inline size_t __pools_stride(int __num_fixed_pools)
+{
+  return __roundup(__num_fixed_pools * sizeof(unsynchronized_pool_resource::__fixed_pool), __cache_line_size);
+}
+
+inline size_t __shard_count()
+{
+#ifndef _LIBCPP_HAS_NO_THREADS
+  size_t __hc = thread::hardware_concurrency();
+  size_t __n = 1;
+  while (__n < __hc && __n < __max_shards)
+    __n *= 2;
+  return __n;
+#else
+  return 1;
+#endif
+}
+
+} // namespace
+
+synchronized_pool_resource::__shard* synchronized_pool_resource::__shard_for_current_thread() const noexcept
+{
+  __shard* __shards = __libcpp_atomic_load(&__shards_, _AO_Acquire);
+  if (__shards == nullptr)
+    return nullptr;
+#ifndef _LIBCPP_HAS_NO_THREADS
+  size_t __h = hash<__thread_id>()(this_thread::get_id());
+  // Thread handles are usually aligned pointers; mix the high bits down so
+  // that the mask below spreads threads across every shard.
+  __h ^= __h >> 17;
+  __h *= static_cast<size_t>(0x9E3779B97F4A7C15ULL);
+  __h ^= __h >> 29;
+  return __shards + (__h & __shard_mask_);
+#else
+  return __shards;
+#endif
+}
+
+void synchronized_pool_resource::release()
+{
+  {
+#ifndef _LIBCPP_HAS_NO_THREADS
+    unique_lock<mutex> __lk(__adhoc_mut_);
+#endif
+    __adhoc_pool_.__release(__res_);
+  }
+  __shard* __shards = __libcpp_atomic_exchange(&__shards_, static_cast<__shard*>(nullptr), _AO_Acq_Rel);
+  if (__shards == nullptr)
+    return;
+
+  const size_t __n = __shard_mask_ + 1;
+  for (size_t __s = 0; __s < __n; ++__s) {
+    for (int __i = 0; __i < __num_fixed_pools_; ++__i)
+      __shards[__s].__pools_[__i].__release(__res_);
+    __shards[__s].~__shard();
+  }
+  const size_t __bytes = __n * sizeof(__shard) + __n * __pools_stride(__num_fixed_pools_);
+  __res_->deallocate(__shards, __bytes, alignof(__shard));
+}
+
+void* synchronized_pool_resource::do_allocate(size_t __bytes, size_t __align)
+{
+  int __i = unsynchronized_pool_resource::__pool_index(__bytes, __align, __num_fixed_pools_);
+  if (__i == __num_fixed_pools_) {
+#ifndef _LIBCPP_HAS_NO_THREADS
+    unique_lock<mutex> __lk(__adhoc_mut_);
+#endif
+    return __adhoc_pool_.__allocate(__res_, __bytes, __align);
+  }
+
+  __shard* __sh = __shard_for_current_thread();
+  if (__sh == nullptr) {
+    // First pooled allocation: lay out every shard and its pools in a single
+    // upstream allocation.
+#ifndef _LIBCPP_HAS_NO_THREADS
+    unique_lock<mutex> __lk(__adhoc_mut_);
+#endif
+    if (__libcpp_atomic_load(&__shards_, _AO_Relaxed) == nullptr) {
+      const size_t __n = __shard_count();
+      const size_t __stride = __pools_stride(__num_fixed_pools_);
+      char* __mem = static_cast<char*>(__res_->allocate(__n * sizeof(__shard) + __n * __stride, alignof(__shard)));
+      __shard* __shards = reinterpret_cast<__shard*>(__mem);
+      char* __pools = __mem + __n * sizeof(__shard);
+      for (size_t __s = 0; __s < __n; ++__s) {
+        __shard* __p = ::new ((void*)(__shards + __s)) __shard();
+        __p->__pools_ = reinterpret_cast<unsynchronized_pool_resource::__fixed_pool*>(__pools + __s * __stride);
+        for (int __j = 0; __j < __num_fixed_pools_; ++__j)
+          ::new ((void*)(__p->__pools_ + __j)) unsynchronized_pool_resource::__fixed_pool();
+      }
+      __shard_mask_ = __n - 1;
+      __libcpp_atomic_store(&__shards_, __shards, _AO_Release);
+    }
+#ifndef _LIBCPP_HAS_NO_THREADS
+    __lk.unlock();
+#endif
+    __sh = __shard_for_current_thread();
+  }
+
+#ifndef _LIBCPP_HAS_NO_THREADS
+  unique_lock<mutex> __lk(__sh->__mut_);
+#endif
+  return __sh->__pools_[__i].__allocate(__res_, __pool_block_size(__i), __options_.max_blocks_per_chunk);
+}
+
+void synchronized_pool_resource::do_deallocate(void* __p, size_t __bytes, size_t __align)
+{
+  int __i = unsynchronized_pool_resource::__pool_index(__bytes, __align, __num_fixed_pools_);
+  if (__i == __num_fixed_pools_) {
+#ifndef _LIBCPP_HAS_NO_THREADS
+    unique_lock<mutex> __lk(__adhoc_mut_);
+#endif
+    return __adhoc_pool_.__deallocate(__res_, __p, __bytes, __align);
+  }
+
+  // The block goes to the current thread's shard even if another shard carved
+  // it: chunks are only returned upstream all together, so this is safe, and
+  // it keeps the block hot in the cache of the thread likely to reuse it.
+  __shard* __sh = __shard_for_current_thread();
+  _LIBCPP_ASSERT(__sh != nullptr, "deallocating a block that was not allocated with this allocator");
+#ifndef _LIBCPP_HAS_NO_THREADS
+  unique_lock<mutex> __lk(__sh->__mut_);
+#endif
+  __sh->__pools_[__i].__deallocate(__p);
+}
+
+// 23.12.6, mem.res.monotonic.buffer
+
+static void* __align_down(size_t __align, size_t __size, void*& __ptr, size_t& __space)
+{
+  if (__size > __space)
+    return nullptr;
+
+  char* __p1 = static_cast<char*>(__ptr);
+  char* __new_ptr = reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(__p1 - __size) & ~(__align - 1));
+
+  if (__new_ptr < (__p1 - __space))
+    return nullptr;
+
+  __ptr = __new_ptr;
+  __space -= __p1 - __new_ptr;
+
+  return __ptr;
+}
+
+void* monotonic_buffer_resource::do_allocate(size_t __bytes, size_t __align)
+{
+  const size_t __footer_size = sizeof(__chunk_footer);
+  const size_t __footer_align = alignof(__chunk_footer);
+
+  auto __previous_allocation_size = [&]() {
+    if (__chunks_ != nullptr)
+      return __chunks_->__allocation_size();
+
+    size_t __newsize = (__initial_.__start_ != nullptr) ? (__initial_.__end_ - __initial_.__start_) : __initial_.__size_;
+
+    return __roundup(__newsize, __footer_align) + __footer_size;
+  };
+
+  if (__initial_.__cur_ != nullptr) {
+    char* __start = __initial_.__start_;
+    char* __end = __initial_.__cur_;
+    void* __new_ptr = static_cast<void*>(__end);
+    size_t __new_capacity = __end - __start;
+    void* __aligned_ptr = __align_down(__align, __bytes, __new_ptr, __new_capacity);
+
+    if (__aligned_ptr != nullptr) {
+      __initial_.__cur_ = static_cast<char*>(__new_ptr);
+      return __aligned_ptr;
+    }
+  }
+
+  if (__chunks_ != nullptr) {
+    void* __new_ptr = static_cast<void*>(__chunks_->__cur_);
+    size_t __new_capacity = __chunks_->__cur_ - __chunks_->__start_;
+    void* __aligned_ptr = __align_down(__align, __bytes, __new_ptr, __new_capacity);
+
+    if (__aligned_ptr != nullptr) {
+      __chunks_->__cur_ = static_cast<char*>(__new_ptr);
+      return __aligned_ptr;
+    }
+  }
+
+  // Grow geometrically, but always leave room for the request itself.
+  size_t __prev_size = __previous_allocation_size();
+  size_t __new_size = (__prev_size > __bytes) ? __prev_size * 2 : __bytes + __footer_size;
+  if (__new_size < __prev_size || __bytes + __footer_size < __bytes)
+    __throw_bad_alloc();
+  __new_size = __roundup(__new_size, __footer_align);
+  if (__new_size - __footer_size < __bytes)
+    __new_size = __roundup(__bytes, __footer_align) + __footer_size;
+
+  size_t __new_align = (__align > __footer_align) ? __align : __footer_align;
+  char* __start = static_cast<char*>(__res_->allocate(__new_size, __new_align));
+  __chunk_footer* __footer = reinterpret_cast<__chunk_footer*>(__start + __new_size - __footer_size);
+  __footer->__next_ = __chunks_;
+  __footer->__start_ = __start;
+  __footer->__cur_ = __start + (__new_size - __footer_size);
+  __footer->__align_ = __new_align;
+  __chunks_ = __footer;
+
+  void* __new_ptr = static_cast<void*>(__footer->__cur_);
+  size_t __new_capacity = __footer->__cur_ - __footer->__start_;
+  void* __aligned_ptr = __align_down(__align, __bytes, __new_ptr, __new_capacity);
+  __footer->__cur_ = static_cast<char*>(__new_ptr);
+  return __aligned_ptr;
+}
+
+} // namespace pmr
+
+_LIBCPP_END_NAMESPACE_STD
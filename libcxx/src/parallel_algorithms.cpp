@@ -0,0 +1,249 @@
+//===------------------------ parallel_algorithms.cpp ---------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "__config"
+#include "__pstl/backend.h"
+#include "cstdint"
+#ifndef _LIBCPP_HAS_NO_THREADS
+#include "atomic"
+#include "condition_variable"
+#include "memory"
+#include "mutex"
+#include "thread"
+#include "vector"
+#if defined(__ELF__) && defined(_LIBCPP_LINK_PTHREAD_LIB)
+#pragma comment(lib, "pthread")
+#endif
+#endif
+
+_LIBCPP_BEGIN_NAMESPACE_STD
+
+namespace __pstl
+{
+
+#ifndef _LIBCPP_HAS_NO_THREADS
+
+namespace
+{
+
+// A range of chunk indices [begin, end) packed into one word. Its owner pops
+// indices from the front while other threads steal half of what is left from
+// the back, both with a single compare-and-swap. Each range sits on its own
+// cache line so that the owner's pops do not slow down other threads.
+class alignas(64) __work_range
+{
+  atomic<uint64_t> __range_{0};
+
+  static uint64_t __pack(uint32_t __b, uint32_t __e) { return (static_cast<uint64_t>(__b) << 32) | __e; }
+
+public:
+  // Only called on an empty range by its owner, or before the job starts.
+  void __assign(uint32_t __b, uint32_t __e) { __range_.store(__pack(__b, __e), memory_order_release); }
+
+  bool __pop_front(uint32_t& __i)
+  {
+    uint64_t __r = __range_.load(memory_order_acquire);
+    for (;;) {
+      const uint32_t __b = static_cast<uint32_t>(__r >> 32);
+      const uint32_t __e = static_cast<uint32_t>(__r);
+      if (__b >= __e)
+        return false;
+      if (__range_.compare_exchange_weak(__r, __pack(__b + 1, __e), memory_order_acq_rel, memory_order_acquire)) {
+        __i = __b;
+        return true;
+      }
+    }
+  }
+
+  bool __steal_back(uint32_t& __first, uint32_t& __last)
+  {
+    uint64_t __r = __range_.load(memory_order_acquire);
+    for (;;) {
+      const uint32_t __b = static_cast<uint32_t>(__r >> 32);
+      const uint32_t __e = static_cast<uint32_t>(__r);
+      if (__b >= __e)
+        return false;
+      const uint32_t __take = (__e - __b + 1) / 2;
+      if (__range_.compare_exchange_weak(__r, __pack(__b, __e - __take), memory_order_acq_rel,
+                                         memory_order_acquire)) {
+        __first = __e - __take;
+        __last = __e;
+        return true;
+      }
+    }
+  }
+};
+
+struct __job
+{
+  void (*__fn_)(void*, size_t, size_t);
+  void* __ctx_;
+  __work_range* __ranges_;
+  unsigned __num_ranges_;
+
+  // Processes indices until no range has any left. Indices that were stolen
+  // but not run yet are not visible to the other threads, but the thief runs
+  // them before it returns, so every index is processed once all
+  // participants have returned.
+  void __participate(unsigned __self)
+  {
+    for (;;) {
+      uint32_t __i;
+      while (__ranges_[__self].__pop_front(__i))
+        __fn_(__ctx_, __i, __i + 1);
+
+      bool __stole = false;
+      for (unsigned __k = 1; __k < __num_ranges_ && !__stole; ++__k) {
+        uint32_t __b, __e;
+        if (__ranges_[(__self + __k) % __num_ranges_].__steal_back(__b, __e)) {
+          // Publish the rest of the loot before running the first index, so
+          // that other idle threads can steal it in turn.
+          __ranges_[__self].__assign(__b + 1, __e);
+          __fn_(__ctx_, __b, __b + 1);
+          __stole = true;
+        }
+      }
+      if (!__stole)
+        return;
+    }
+  }
+};
+
+class __thread_pool
+{
+public:
+  __thread_pool();
+
+  unsigned __size() const noexcept { return static_cast<unsigned>(__workers_.size()) + 1; }
+
+  void __run(size_t __chunks, void (*__fn)(void*, size_t, size_t), void* __ctx);
+
+private:
+  void __worker(unsigned __index);
+
+  mutex __mut_;
+  condition_variable __work_cv_;
+  condition_variable __done_cv_;
+  __job* __job_ = nullptr;
+  unsigned long long __generation_ = 0;
+  unsigned __active_ = 0;
+  atomic<bool> __busy_{false};
+  unique_ptr<__work_range[]> __ranges_;
+  vector<thread> __workers_;
+};
+
+__thread_pool::__thread_pool()
+{
+  // The calling thread takes part in every job, so one thread fewer than the
+  // hardware supports keeps every core busy.
+  unsigned __hc = thread::hardware_concurrency();
+  const unsigned __num_workers = __hc > 1 ? __hc - 1 : 0;
+  __ranges_.reset(new __work_range[__num_workers + 1]);
+  __workers_.reserve(__num_workers);
+  for (unsigned __i = 0; __i != __num_workers; ++__i) {
+#ifndef _LIBCPP_NO_EXCEPTIONS
+    try {
+#endif
+      __workers_.emplace_back(&__thread_pool::__worker, this, __i);
+#ifndef _LIBCPP_NO_EXCEPTIONS
+    } catch (...) {
+      // Make do with the threads that could be started.
+      break;
+    }
+#endif
+  }
+}
+
+void __thread_pool::__worker(unsigned __index)
+{
+  unsigned long long __seen = 0;
+  unique_lock<mutex> __lk(__mut_);
+  for (;;) {
+    __work_cv_.wait(__lk, [&] { return __job_ != nullptr && __generation_ != __seen; });
+    __seen = __generation_;
+    __job* __j = __job_;
+    ++__active_;
+    __lk.unlock();
+    __j->__participate(__index + 1);
+    __lk.lock();
+    if (--__active_ == 0)
+      __done_cv_.notify_one();
+  }
+}
+
+void __thread_pool::__run(size_t __chunks, void (*__fn)(void*, size_t, size_t), void* __ctx)
+{
+  // Nested calls, calls from several threads at once and ranges too large to
+  // pack run on the calling thread.
+  if (__workers_.empty() || __chunks > UINT32_MAX || __busy_.exchange(true, memory_order_acquire)) {
+    __fn(__ctx, 0, __chunks);
+    return;
+  }
+
+  const unsigned __n = __size();
+  for (unsigned __i = 0; __i != __n; ++__i)
+    __ranges_[__i].__assign(static_cast<uint32_t>(__chunks * __i / __n),
+                            static_cast<uint32_t>(__chunks * (__i + 1) / __n));
+  __job __j{__fn, __ctx, __ranges_.get(), __n};
+  {
+    lock_guard<mutex> __lk(__mut_);
+    __job_ = &__j;
+    ++__generation_;
+  }
+  __work_cv_.notify_all();
+
+  __j.__participate(0);
+
+  // Workers that have not picked up the job yet will not see it anymore; wait
+  // for the others to finish the indices they took.
+  {
+    unique_lock<mutex> __lk(__mut_);
+    __job_ = nullptr;
+    __done_cv_.wait(__lk, [&] { return __active_ == 0; });
+  }
+  __busy_.store(false, memory_order_release);
+}
+
+__thread_pool& __get_thread_pool()
+{
+  // The pool is never destroyed: parallel algorithms may still run from the
+  // destructors of other static objects, and joining idle workers at exit
+  // would only delay it.
+  static __thread_pool* __pool = new __thread_pool();
+  return *__pool;
+}
+
+} // namespace
+
+void __parallel_for_chunks(size_t __chunks, void (*__fn)(void*, size_t, size_t), void* __ctx)
+{
+  __get_thread_pool().__run(__chunks, __fn, __ctx);
+}
+
+unsigned __thread_count() noexcept
+{
+  return __get_thread_pool().__size();
+}
+
+#else // _LIBCPP_HAS_NO_THREADS
+
+void __parallel_for_chunks(size_t __chunks, void (*__fn)(void*, size_t, size_t), void* __ctx)
+{
+  __fn(__ctx, 0, __chunks);
+}
+
+unsigned __thread_count() noexcept
+{
+  return 1;
+}
+
+#endif // _LIBCPP_HAS_NO_THREADS
+
+} // namespace __pstl
+
+_LIBCPP_END_NAMESPACE_STD
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <ext/flat_hash_map>
+
+#include <ext/flat_hash_map>
+#include <cassert>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "test_macros.h"
+#include "count_new.h"
+#include "min_allocator.h"
+
+void test_default_does_not_allocate() {
+  DisableAllocationGuard g;
+  ((void)g);
+  __gnu_cxx::flat_hash_map<int, int> m;
+  assert(m.empty());
+  assert(m.capacity() == 0);
+  assert(m.find(1) == m.end());
+}
+
+template <class Map>
+void test_against_std_map(int n) {
+  Map m;
+  std::map<int, int> ref;
+  unsigned x = 777;
+  for (int i = 0; i < n; ++i) {
+    x = x * 1103515245u + 12345u;
+    const int k = static_cast<int>((x >> 8) % static_cast<unsigned>(n / 2 + 1));
+    switch ((x >> 4) % 4) {
+    case 0:
+      assert(m.erase(k) == ref.erase(k));
+      break;
+    case 1:
+      m[k] += i;
+      ref[k] += i;
+      break;
+    case 2:
+      assert(m.insert(std::make_pair(k, i)).second == ref.insert(std::make_pair(k, i)).second);
+      break;
+    case 3:
+      assert(m.insert_or_assign(k, i).second == (ref.count(k) == 0));
+      ref[k] = i;
+      break;
+    }
+    assert(m.size() == ref.size());
+  }
+  for (std::map<int, int>::const_iterator it = ref.begin(); it != ref.end(); ++it)
+    assert(m.at(it->first) == it->second);
+  std::size_t seen = 0;
+  for (typename Map::iterator it = m.begin(); it != m.end(); ++it) {
+    assert(ref.at(it->first) == it->second);
+    ++seen;
+  }
+  assert(seen == ref.size());
+}
+
+void test_strings() {
+  __gnu_cxx::flat_hash_map<std::string, std::string> m;
+  for (int i = 0; i < 500; ++i)
+    m.emplace(std::to_string(i), std::string(i % 50, 'x'));
+  for (int i = 0; i < 500; ++i) {
+    assert(m.count(std::to_string(i)) == 1);
+    assert(m[std::to_string(i)].size() == static_cast<std::size_t>(i % 50));
+  }
+  assert(!m.try_emplace("7", "changed").second);
+  assert(m["7"] == std::string(7, 'x'));
+
+  __gnu_cxx::flat_hash_map<std::string, std::string> c(m);
+  assert(c == m);
+  c["7"] = "changed";
+  assert(c != m);
+  c = std::move(m);
+  assert(m.empty());
+  assert(c.size() == 500);
+}
+
+void test_move_only_mapped() {
+  __gnu_cxx::flat_hash_map<int, std::unique_ptr<int> > m;
+  for (int i = 0; i < 300; ++i)
+    m.try_emplace(i, new int(i));
+  for (int i = 0; i < 300; ++i)
+    assert(*m.at(i) == i);
+  m.erase(m.find(0));
+  assert(m.size() == 299);
+}
+
+struct CountedKey {
+  static int copies;
+  int value;
+  explicit CountedKey(int v) : value(v) {}
+  CountedKey(const CountedKey& k) : value(k.value) { ++copies; }
+  CountedKey(CountedKey&& k) noexcept : value(k.value) { k.value = -1; }
+  bool operator==(const CountedKey& k) const { return value == k.value; }
+};
+int CountedKey::copies = 0;
+
+struct CountedKeyHash {
+  std::size_t operator()(const CountedKey& k) const noexcept { return std::hash<int>()(k.value); }
+};
+
+void test_keys_are_moved() {
+  __gnu_cxx::flat_hash_map<CountedKey, int, CountedKeyHash> m;
+  for (int i = 0; i < 300; ++i)
+    m.emplace(CountedKey(i), i);
+  assert(CountedKey::copies == 0);
+  for (int i = 0; i < 300; ++i)
+    assert(m.at(CountedKey(i)) == i);
+
+  __gnu_cxx::flat_hash_map<std::unique_ptr<int>, int> u;
+  for (int i = 0; i < 300; ++i)
+    u.emplace(std::unique_ptr<int>(new int(i)), i);
+  assert(u.size() == 300);
+  for (__gnu_cxx::flat_hash_map<std::unique_ptr<int>, int>::iterator it = u.begin(); it != u.end(); ++it)
+    assert(*it->first == it->second);
+}
+
+void test_at_throws() {
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  __gnu_cxx::flat_hash_map<int, int> m;
+  m[1] = 2;
+  try {
+    (void)m.at(2);
+    assert(false);
+  } catch (const std::out_of_range&) {
+  }
+  const __gnu_cxx::flat_hash_map<int, int>& cm = m;
+  assert(cm.at(1) == 2);
+#endif
+}
+
+int main(int, char**) {
+  test_default_does_not_allocate();
+  test_against_std_map<__gnu_cxx::flat_hash_map<int, int> >(10000);
+  test_against_std_map<__gnu_cxx::flat_hash_map<int, int, std::hash<int>, std::equal_to<int>,
+                                                min_allocator<std::pair<const int, int> > > >(2000);
+  test_strings();
+  test_move_only_mapped();
+  test_keys_are_moved();
+  test_at_throws();
+  return 0;
+}
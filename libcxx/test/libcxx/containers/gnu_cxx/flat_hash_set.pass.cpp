@@ -0,0 +1,163 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <ext/flat_hash_set>
+
+#include <ext/flat_hash_set>
+#include <cassert>
+#include <cstddef>
+#include <set>
+#include <string>
+
+#include "test_macros.h"
+#include "count_new.h"
+#include "min_allocator.h"
+#include "MoveOnly.h"
+
+// Sends every key to the same probe sequence and control byte.
+struct CollidingHash {
+  std::size_t operator()(int) const { return 0; }
+};
+
+void test_default_does_not_allocate() {
+  DisableAllocationGuard g;
+  ((void)g);
+  __gnu_cxx::flat_hash_set<int> s;
+  assert(s.empty());
+  assert(s.capacity() == 0);
+  assert(s.begin() == s.end());
+  assert(s.find(42) == s.end());
+  assert(s.count(42) == 0);
+  assert(s.erase(42) == 0);
+}
+
+template <class Set>
+void test_against_std_set(int n) {
+  Set s;
+  std::set<int> ref;
+  // A fixed pseudo-random sequence of inserts and erases, so that erased
+  // slots are reused and the table rehashes with tombstones in it.
+  unsigned x = 12345;
+  for (int i = 0; i < n; ++i) {
+    x = x * 1103515245u + 12345u;
+    const int k = static_cast<int>((x >> 8) % static_cast<unsigned>(n / 2 + 1));
+    if ((x >> 4) % 3 == 0) {
+      assert(s.erase(k) == ref.erase(k));
+    } else {
+      const bool inserted = s.insert(k).second;
+      assert(inserted == ref.insert(k).second);
+      assert(*s.find(k) == k);
+    }
+    assert(s.size() == ref.size());
+  }
+  std::size_t seen = 0;
+  for (typename Set::const_iterator it = s.begin(); it != s.end(); ++it) {
+    assert(ref.count(*it) == 1);
+    ++seen;
+  }
+  assert(seen == ref.size());
+  for (int k = 0; k <= n / 2; ++k)
+    assert(s.contains(k) == (ref.count(k) == 1));
+  assert(s.load_factor() <= s.max_load_factor());
+  // Capacities are a power of two minus one.
+  assert((s.capacity() & (s.capacity() + 1)) == 0);
+}
+
+void test_erase_while_iterating() {
+  __gnu_cxx::flat_hash_set<int> s;
+  for (int i = 0; i < 1000; ++i)
+    s.insert(i);
+  for (__gnu_cxx::flat_hash_set<int>::iterator it = s.begin(); it != s.end();) {
+    if (*it % 2 == 0)
+      it = s.erase(it);
+    else
+      ++it;
+  }
+  assert(s.size() == 500);
+  for (int i = 0; i < 1000; ++i)
+    assert(s.contains(i) == (i % 2 == 1));
+  s.erase(s.begin(), s.end());
+  assert(s.empty());
+  assert(s.begin() == s.end());
+}
+
+void test_reserve_and_rehash() {
+  __gnu_cxx::flat_hash_set<int> s;
+  s.reserve(1000);
+  const std::size_t cap = s.capacity();
+  assert(cap >= 1000);
+  for (int i = 0; i < 1000; ++i)
+    s.insert(i);
+  assert(s.capacity() == cap);
+
+  s.clear();
+  assert(s.capacity() == cap);
+  s.insert(1);
+  s.rehash(0);
+  assert(s.capacity() < cap);
+  assert(s.contains(1));
+  s.erase(1);
+  s.rehash(0);
+  assert(s.capacity() == 0);
+  assert(s.begin() == s.end());
+}
+
+void test_copy_move_compare() {
+  __gnu_cxx::flat_hash_set<std::string> s = {"one", "two", "three"};
+  __gnu_cxx::flat_hash_set<std::string> c(s);
+  assert(c == s);
+  c.erase("two");
+  assert(c != s);
+  c = s;
+  assert(c == s);
+  __gnu_cxx::flat_hash_set<std::string> m(std::move(c));
+  assert(m == s);
+  assert(c.empty());
+  c = std::move(m);
+  assert(c == s);
+  swap(c, m);
+  assert(c.empty());
+  assert(m == s);
+  assert(*m.emplace("four").first == "four");
+  assert(!m.emplace("four").second);
+  assert(m.size() == 4);
+}
+
+void test_move_only() {
+  __gnu_cxx::flat_hash_set<MoveOnly, std::hash<MoveOnly> > s;
+  for (int i = 0; i < 100; ++i)
+    assert(s.insert(MoveOnly(i)).second);
+  for (int i = 0; i < 100; ++i)
+    assert(s.find(MoveOnly(i)) != s.end());
+}
+
+void test_colliding_hash() {
+  __gnu_cxx::flat_hash_set<int, CollidingHash> s;
+  for (int i = 0; i < 200; ++i)
+    s.insert(i);
+  for (int i = 0; i < 200; i += 2)
+    s.erase(i);
+  for (int i = 0; i < 200; ++i)
+    assert(s.contains(i) == (i % 2 == 1));
+  assert(s.size() == 100);
+}
+
+int main(int, char**) {
+  test_default_does_not_allocate();
+  test_against_std_set<__gnu_cxx::flat_hash_set<int> >(10000);
+  test_against_std_set<__gnu_cxx::flat_hash_set<int, std::hash<int>, std::equal_to<int>, min_allocator<int> > >(
+      2000);
+  test_erase_while_iterating();
+  test_reserve_and_rehash();
+  test_copy_move_compare();
+  test_move_only();
+  test_colliding_hash();
+  return 0;
+}
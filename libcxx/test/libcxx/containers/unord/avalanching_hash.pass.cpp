@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// Not a portable test
+
+// Unordered containers whose hash function declares a nested is_avalanching
+// type keep a power of two buckets.
+
+#include <unordered_map>
+#include <unordered_set>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "test_macros.h"
+
+struct AvalanchingHash {
+  typedef void is_avalanching;
+  std::size_t operator()(std::uint64_t x) const {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    return static_cast<std::size_t>(x);
+  }
+};
+
+bool is_power_of_two(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+template <class C>
+void test() {
+  C c;
+  for (std::uint64_t i = 0; i < 1000; ++i) {
+    c.emplace(i, i);
+    assert(is_power_of_two(c.bucket_count()));
+  }
+  for (std::uint64_t i = 0; i < 1000; ++i)
+    assert(c.count(i) == 1);
+  c.rehash(1000);
+  assert(c.bucket_count() == 1024);
+  c.reserve(3000);
+  assert(is_power_of_two(c.bucket_count()));
+  c.clear();
+  c.rehash(0);
+  assert(c.bucket_count() == 0);
+  c.emplace(1, 1);
+  assert(is_power_of_two(c.bucket_count()));
+
+  C d(100);
+  assert(d.bucket_count() == 128);
+}
+
+template <class C>
+void test_set() {
+  C c;
+  for (std::uint64_t i = 0; i < 1000; ++i) {
+    c.insert(i);
+    assert(is_power_of_two(c.bucket_count()));
+  }
+  C d(100);
+  assert(d.bucket_count() == 128);
+}
+
+int main(int, char**) {
+  static_assert(std::__is_avalanching_hash<AvalanchingHash>::value, "");
+  static_assert(!std::__is_avalanching_hash<std::hash<int> >::value, "");
+
+  test<std::unordered_map<std::uint64_t, std::uint64_t, AvalanchingHash> >();
+  test<std::unordered_multimap<std::uint64_t, std::uint64_t, AvalanchingHash> >();
+  test_set<std::unordered_set<std::uint64_t, AvalanchingHash> >();
+  test_set<std::unordered_multiset<std::uint64_t, AvalanchingHash> >();
+
+  // Without the opt-in, bucket counts stay prime.
+  std::unordered_set<std::uint64_t> p(100);
+  assert(p.bucket_count() == 101);
+  return 0;
+}
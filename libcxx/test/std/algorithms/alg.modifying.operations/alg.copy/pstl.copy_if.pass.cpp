@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+//          class Predicate>
+//   ForwardIterator2 copy_if(ExecutionPolicy&& exec,
+//                            ForwardIterator1 first, ForwardIterator1 last,
+//                            ForwardIterator2 result, Predicate pred);
+
+#include <algorithm>
+#include <cassert>
+#include <execution>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+template <class InIter, class OutIter, class Policy, class Pred>
+void test(Policy&& policy, int n, Pred pred)
+{
+    std::vector<int> in(n), out(n, -1), expected;
+    for (int i = 0; i < n; ++i) {
+        in[i] = (i * 7919) % 1000;
+        if (pred(in[i]))
+            expected.push_back(in[i]);
+    }
+    OutIter r = std::copy_if(policy, InIter(in.data()), InIter(in.data() + n), OutIter(out.data()), pred);
+    assert(base(r) == out.data() + expected.size());
+    assert(std::equal(expected.begin(), expected.end(), out.data()));
+    assert(std::all_of(out.begin() + expected.size(), out.end(), [](int x) { return x == -1; }));
+}
+
+template <class InIter, class OutIter>
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 100000};
+    for (int n : sizes) {
+        auto odd = [](int x) { return x % 2 != 0; };
+        auto none = [](int) { return false; };
+        auto all = [](int) { return true; };
+        auto rare = [](int x) { return x == 17; };
+        test<InIter, OutIter>(std::execution::seq, n, odd);
+        test<InIter, OutIter>(std::execution::par, n, odd);
+        test<InIter, OutIter>(std::execution::par, n, none);
+        test<InIter, OutIter>(std::execution::par, n, all);
+        test<InIter, OutIter>(std::execution::par_unseq, n, rare);
+    }
+}
+
+int main(int, char**)
+{
+    test<forward_iterator<const int*>, forward_iterator<int*> >();
+    test<random_access_iterator<const int*>, random_access_iterator<int*> >();
+    test<const int*, int*>();
+
+    return 0;
+}
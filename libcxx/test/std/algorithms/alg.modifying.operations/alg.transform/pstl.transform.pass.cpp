@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+//          class UnaryOperation>
+//   ForwardIterator2 transform(ExecutionPolicy&& exec,
+//                              ForwardIterator1 first1, ForwardIterator1 last1,
+//                              ForwardIterator2 result, UnaryOperation op);
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+//          class ForwardIterator, class BinaryOperation>
+//   ForwardIterator transform(ExecutionPolicy&& exec,
+//                             ForwardIterator1 first1, ForwardIterator1 last1,
+//                             ForwardIterator2 first2, ForwardIterator result,
+//                             BinaryOperation binary_op);
+
+#include <algorithm>
+#include <cassert>
+#include <execution>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+template <class InIter, class OutIter, class Policy>
+void test(Policy&& policy, int n)
+{
+    std::vector<int> a(n), b(n), out(n, -1);
+    for (int i = 0; i < n; ++i) {
+        a[i] = i;
+        b[i] = 3 * i;
+    }
+
+    OutIter r = std::transform(policy, InIter(a.data()), InIter(a.data() + n), OutIter(out.data()),
+                               [](int x) { return x + 1; });
+    assert(base(r) == out.data() + n);
+    for (int i = 0; i < n; ++i)
+        assert(out[i] == i + 1);
+
+    r = std::transform(policy, InIter(a.data()), InIter(a.data() + n), InIter(b.data()), OutIter(out.data()),
+                       [](int x, int y) { return y - x; });
+    assert(base(r) == out.data() + n);
+    for (int i = 0; i < n; ++i)
+        assert(out[i] == 2 * i);
+
+    // In place.
+    r = std::transform(policy, InIter(a.data()), InIter(a.data() + n), OutIter(a.data()),
+                       [](int x) { return -x; });
+    assert(base(r) == a.data() + n);
+    for (int i = 0; i < n; ++i)
+        assert(a[i] == -i);
+}
+
+template <class InIter, class OutIter>
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 100000};
+    for (int n : sizes) {
+        test<InIter, OutIter>(std::execution::seq, n);
+        test<InIter, OutIter>(std::execution::par, n);
+        test<InIter, OutIter>(std::execution::par_unseq, n);
+    }
+}
+
+int main(int, char**)
+{
+    test<forward_iterator<int*>, forward_iterator<int*> >();
+    test<random_access_iterator<int*>, forward_iterator<int*> >();
+    test<random_access_iterator<int*>, random_access_iterator<int*> >();
+    test<int*, int*>();
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class ForwardIterator, class Function>
+//   void for_each(ExecutionPolicy&& exec,
+//                 ForwardIterator first, ForwardIterator last, Function f);
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <execution>
+#include <functional>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+template <class Iter, class Policy>
+void test(Policy&& policy, int n)
+{
+    std::vector<int> v(n);
+    for (int i = 0; i < n; ++i)
+        v[i] = i;
+    std::atomic<long long> sum(0);
+    static_assert(std::is_same_v<void, decltype(std::for_each(policy, Iter(v.data()), Iter(v.data() + n),
+                                                              std::negate<>()))>, "");
+    std::for_each(policy, Iter(v.data()), Iter(v.data() + n), [&](int& x) {
+        sum += x;
+        x *= 2;
+    });
+    assert(sum == static_cast<long long>(n) * (n - 1) / 2);
+    for (int i = 0; i < n; ++i)
+        assert(v[i] == 2 * i);
+}
+
+template <class Iter>
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 100000};
+    for (int n : sizes) {
+        test<Iter>(std::execution::seq, n);
+        test<Iter>(std::execution::par, n);
+        test<Iter>(std::execution::par_unseq, n);
+#if TEST_STD_VER > 17
+        test<Iter>(std::execution::unseq, n);
+#endif
+    }
+}
+
+int main(int, char**)
+{
+    test<forward_iterator<int*> >();
+    test<random_access_iterator<int*> >();
+    test<int*>();
+
+    // A parallel call nested in another one runs on the calling thread.
+    {
+    std::vector<std::vector<int> > vv(64, std::vector<int>(4096, 1));
+    std::for_each(std::execution::par, vv.begin(), vv.end(), [](std::vector<int>& v) {
+        std::for_each(std::execution::par, v.begin(), v.end(), [](int& x) { x += 1; });
+    });
+    for (const auto& v : vv)
+        assert(std::all_of(v.begin(), v.end(), [](int x) { return x == 2; }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class RandomAccessIterator>
+//   void sort(ExecutionPolicy&& exec,
+//             RandomAccessIterator first, RandomAccessIterator last);
+// template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+//   void sort(ExecutionPolicy&& exec,
+//             RandomAccessIterator first, RandomAccessIterator last, Compare comp);
+
+#include <algorithm>
+#include <cassert>
+#include <execution>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+template <class Iter, class Policy>
+void test(Policy&& policy, int n)
+{
+    std::mt19937 gen(n);
+    std::vector<int> v(n);
+    for (int& x : v)
+        x = static_cast<int>(gen() % 1000);
+    std::vector<int> expected = v;
+    std::sort(expected.begin(), expected.end());
+
+    std::sort(policy, Iter(v.data()), Iter(v.data() + n));
+    assert(v == expected);
+
+    std::sort(policy, Iter(v.data()), Iter(v.data() + n), std::greater<int>());
+    assert(std::equal(v.begin(), v.end(), expected.rbegin()));
+
+    // Already sorted input.
+    std::sort(policy, Iter(v.data()), Iter(v.data() + n), std::greater<int>());
+    assert(std::equal(v.begin(), v.end(), expected.rbegin()));
+}
+
+template <class Iter>
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 5000, 100000};
+    for (int n : sizes) {
+        test<Iter>(std::execution::seq, n);
+        test<Iter>(std::execution::par, n);
+        test<Iter>(std::execution::par_unseq, n);
+    }
+}
+
+int main(int, char**)
+{
+    test<random_access_iterator<int*> >();
+    test<int*>();
+
+    // Move-only elements.
+    {
+    const int n = 10000;
+    std::vector<std::unique_ptr<int> > v;
+    for (int i = 0; i < n; ++i)
+        v.push_back(std::make_unique<int>((i * 7919) % n));
+    std::sort(std::execution::par, v.begin(), v.end(),
+              [](const std::unique_ptr<int>& x, const std::unique_ptr<int>& y) { return *x < *y; });
+    for (int i = 0; i < n; ++i)
+        assert(*v[i] == i);
+    }
+
+    return 0;
+}
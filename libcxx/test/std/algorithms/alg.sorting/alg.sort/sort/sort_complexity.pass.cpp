@@ -0,0 +1,151 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// <algorithm>
+
+// template<RandomAccessIterator Iter, StrictWeakOrder<auto, Iter::value_type> Compare>
+//   requires ShuffleIterator<Iter> && CopyConstructible<Compare>
+//   void
+//   sort(Iter first, Iter last, Compare comp);
+
+// Complexity: O(N log N) comparisons, also for inputs built to defeat the
+// pivot selection.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "test_macros.h"
+
+struct counting_less
+{
+    long long* count_;
+    explicit counting_less(long long* count) : count_(count) {}
+    bool operator()(int x, int y) const { ++*count_; return x < y; }
+};
+
+// M. D. McIlroy, "A Killer Adversary for Quicksort". The comparison decides
+// the order of the elements only as the sort looks at them, in a way that
+// makes every pivot a bad one.
+struct adversary_state
+{
+    std::vector<int> values;
+    int gas;
+    int num_solid;
+    int candidate;
+    long long count;
+};
+
+struct adversary_less
+{
+    adversary_state* s_;
+    explicit adversary_less(adversary_state* s) : s_(s) {}
+    bool operator()(int x, int y) const
+    {
+        ++s_->count;
+        std::vector<int>& v = s_->values;
+        if (v[x] == s_->gas && v[y] == s_->gas) {
+            if (x == s_->candidate)
+                v[x] = s_->num_solid++;
+            else
+                v[y] = s_->num_solid++;
+        }
+        if (v[x] == s_->gas)
+            s_->candidate = x;
+        else if (v[y] == s_->gas)
+            s_->candidate = y;
+        return v[x] < v[y];
+    }
+};
+
+long long comparison_bound(std::size_t n)
+{
+    long long log2 = 1;
+    while ((std::size_t(1) << log2) < n)
+        ++log2;
+    return 4 * static_cast<long long>(n) * log2 + 100;
+}
+
+void test_adversary(int n)
+{
+    adversary_state s;
+    s.values.assign(n, n);
+    s.gas = n;
+    s.num_solid = 0;
+    s.candidate = 0;
+    s.count = 0;
+    std::vector<int> ptr(n);
+    for (int i = 0; i < n; ++i)
+        ptr[i] = i;
+    std::sort(ptr.begin(), ptr.end(), adversary_less(&s));
+    assert(s.count <= comparison_bound(n));
+    for (int i = 1; i < n; ++i)
+        assert(s.values[ptr[i - 1]] <= s.values[ptr[i]]);
+}
+
+template <class Gen>
+void test_pattern(int n, Gen gen)
+{
+    std::vector<int> v(n);
+    for (int i = 0; i < n; ++i)
+        v[i] = gen(i, n);
+    std::vector<int> expected = v;
+    std::stable_sort(expected.begin(), expected.end());
+
+    std::vector<int> w = v;
+    long long count = 0;
+    std::sort(w.begin(), w.end(), counting_less(&count));
+    assert(w == expected);
+    assert(count <= comparison_bound(n));
+
+    // The default comparison takes a different partitioning code path.
+    w = v;
+    std::sort(w.begin(), w.end());
+    assert(w == expected);
+    w = v;
+    std::sort(w.begin(), w.end(), std::greater<int>());
+    assert(std::equal(w.begin(), w.end(), expected.rbegin()));
+}
+
+int ascending(int i, int) { return i; }
+int descending(int i, int n) { return n - i; }
+int all_equal(int, int) { return 42; }
+int organ_pipe(int i, int n) { return i < n / 2 ? i : n - i; }
+int sawtooth(int i, int) { return i % 64; }
+int few_values(int i, int) { return (i * 7919) % 5; }
+int push_front(int i, int n) { return i == n - 1 ? 0 : i + 1; }
+
+int random_values(int i, int)
+{
+    static std::mt19937 gen;
+    (void)i;
+    return static_cast<int>(gen() % 100000);
+}
+
+int main(int, char**)
+{
+    const int sizes[] = {0, 1, 2, 3, 7, 31, 129, 1000, 4096, 100000};
+    for (int n : sizes) {
+        test_adversary(n);
+        test_pattern(n, ascending);
+        test_pattern(n, descending);
+        test_pattern(n, all_equal);
+        test_pattern(n, organ_pipe);
+        test_pattern(n, sawtooth);
+        test_pattern(n, few_values);
+        test_pattern(n, push_front);
+        test_pattern(n, random_values);
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <algorithm>
+
+// template<class ExecutionPolicy, class RandomAccessIterator>
+//   void stable_sort(ExecutionPolicy&& exec,
+//                    RandomAccessIterator first, RandomAccessIterator last);
+// template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+//   void stable_sort(ExecutionPolicy&& exec,
+//                    RandomAccessIterator first, RandomAccessIterator last, Compare comp);
+
+#include <algorithm>
+#include <cassert>
+#include <execution>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "test_macros.h"
+
+typedef std::pair<int, int> P;
+
+struct first_less
+{
+    bool operator()(const P& x, const P& y) const { return x.first < y.first; }
+};
+
+template <class Policy>
+void test(Policy&& policy, int n)
+{
+    std::mt19937 gen(n);
+    std::vector<P> v(n);
+    for (int i = 0; i < n; ++i)
+        v[i] = P(static_cast<int>(gen() % 64), i);
+
+    std::vector<P> expected = v;
+    std::stable_sort(expected.begin(), expected.end(), first_less());
+    std::stable_sort(policy, v.data(), v.data() + n, first_less());
+    assert(v == expected);
+
+    std::vector<int> w(n);
+    for (int i = 0; i < n; ++i)
+        w[i] = n - i;
+    std::stable_sort(policy, w.data(), w.data() + n);
+    for (int i = 0; i < n; ++i)
+        assert(w[i] == i + 1);
+}
+
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 5000, 100000};
+    for (int n : sizes) {
+        test(std::execution::seq, n);
+        test(std::execution::par, n);
+        test(std::execution::par_unseq, n);
+    }
+}
+
+int main(int, char**)
+{
+    test();
+
+    return 0;
+}
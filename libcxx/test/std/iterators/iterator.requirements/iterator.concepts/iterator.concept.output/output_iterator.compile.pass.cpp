@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+// UNSUPPORTED: gcc-10
+
+// template<class I, class T>
+// concept output_iterator;
+
+#include <iterator>
+
+#include <string>
+#include <vector>
+
+#include "test_iterators.h"
+
+static_assert(std::output_iterator<int*, int>);
+static_assert(std::output_iterator<int*, const int&>);
+static_assert(std::output_iterator<int*, short>);
+static_assert(!std::output_iterator<int const*, int>);
+static_assert(!std::output_iterator<void*, int>);
+static_assert(!std::output_iterator<int, int>);
+
+static_assert(std::output_iterator<output_iterator<int*>, int>);
+static_assert(std::output_iterator<cpp17_input_iterator<int*>, int>);
+static_assert(!std::output_iterator<cpp17_input_iterator<int const*>, int>);
+
+static_assert(std::output_iterator<std::back_insert_iterator<std::vector<int> >, int>);
+static_assert(std::output_iterator<std::back_insert_iterator<std::string>, const char&>);
+static_assert(std::output_iterator<std::ostream_iterator<int>, int>);
+static_assert(!std::output_iterator<std::istream_iterator<int>, int>);
+
+// *i++ = t must be valid.
+struct no_postincrement {
+  using difference_type = std::ptrdiff_t;
+
+  int& operator*() const;
+  no_postincrement& operator++();
+  void operator++(int);
+};
+static_assert(std::input_or_output_iterator<no_postincrement>);
+static_assert(std::indirectly_writable<no_postincrement, int>);
+static_assert(!std::output_iterator<no_postincrement, int>);
@@ -1792,16 +1792,16 @@
 #   endif
 # endif
 
-# if !defined(_LIBCPP_VERSION)
+# if !defined(_LIBCPP_AVAILABILITY_DISABLE_FTM___cpp_lib_memory_resource)
 #   ifndef __cpp_lib_memory_resource
 #     error "__cpp_lib_memory_resource should be defined in c++17"
 #   endif
 #   if __cpp_lib_memory_resource != 201603L
 #     error "__cpp_lib_memory_resource should have the value 201603L in c++17"
 #   endif
-# else // _LIBCPP_VERSION
+# else
 #   ifdef __cpp_lib_memory_resource
-#     error "__cpp_lib_memory_resource should not be defined because it is unimplemented in libc++!"
+#     error "__cpp_lib_memory_resource should not be defined when !defined(_LIBCPP_AVAILABILITY_DISABLE_FTM___cpp_lib_memory_resource) is not defined!"
 #   endif
 # endif
 
@@ -2886,16 +2886,16 @@
 #   endif
 # endif
 
-# if !defined(_LIBCPP_VERSION)
+# if !defined(_LIBCPP_AVAILABILITY_DISABLE_FTM___cpp_lib_memory_resource)
 #   ifndef __cpp_lib_memory_resource
 #     error "__cpp_lib_memory_resource should be defined in c++20"
 #   endif
 #   if __cpp_lib_memory_resource != 201603L
 #     error "__cpp_lib_memory_resource should have the value 201603L in c++20"
 #   endif
-# else // _LIBCPP_VERSION
+# else
 #   ifdef __cpp_lib_memory_resource
-#     error "__cpp_lib_memory_resource should not be defined because it is unimplemented in libc++!"
+#     error "__cpp_lib_memory_resource should not be defined when !defined(_LIBCPP_AVAILABILITY_DISABLE_FTM___cpp_lib_memory_resource) is not defined!"
 #   endif
 # endif
 
@@ -4070,16 +4070,16 @@
 #   endif
 # endif
 
-# if !defined(_LIBCPP_VERSION)
+# if !defined(_LIBCPP_AVAILABILITY_DISABLE_FTM___cpp_lib_memory_resource)
 #   ifndef __cpp_lib_memory_resource
 #     error "__cpp_lib_memory_resource should be defined in c++2b"
 #   endif
 #   if __cpp_lib_memory_resource != 201603L
 #     error "__cpp_lib_memory_resource should have the value 201603L in c++2b"
 #   endif
-# else // _LIBCPP_VERSION
+# else
 #   ifdef __cpp_lib_memory_resource
-#     error "__cpp_lib_memory_resource should not be defined because it is unimplemented in libc++!"
+#     error "__cpp_lib_memory_resource should not be defined when !defined(_LIBCPP_AVAILABILITY_DISABLE_FTM___cpp_lib_memory_resource) is not defined!"
 #   endif
 # endif
 
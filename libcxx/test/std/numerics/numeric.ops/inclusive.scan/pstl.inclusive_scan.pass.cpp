@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <numeric>
+
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2>
+//   ForwardIterator2 inclusive_scan(ExecutionPolicy&& exec,
+//                                   ForwardIterator1 first, ForwardIterator1 last,
+//                                   ForwardIterator2 result);
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+//          class BinaryOperation>
+//   ForwardIterator2 inclusive_scan(ExecutionPolicy&& exec,
+//                                   ForwardIterator1 first, ForwardIterator1 last,
+//                                   ForwardIterator2 result, BinaryOperation binary_op);
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2,
+//          class BinaryOperation, class T>
+//   ForwardIterator2 inclusive_scan(ExecutionPolicy&& exec,
+//                                   ForwardIterator1 first, ForwardIterator1 last,
+//                                   ForwardIterator2 result, BinaryOperation binary_op, T init);
+
+#include <numeric>
+#include <cassert>
+#include <execution>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+template <class InIter, class OutIter, class Policy>
+void test(Policy&& policy, int n)
+{
+    std::vector<long long> in(n), out(n, -1);
+    for (int i = 0; i < n; ++i)
+        in[i] = i % 13;
+    std::vector<long long> expected(n);
+    std::partial_sum(in.begin(), in.end(), expected.begin());
+
+    OutIter r = std::inclusive_scan(policy, InIter(in.data()), InIter(in.data() + n), OutIter(out.data()));
+    assert(base(r) == out.data() + n);
+    assert(out == expected);
+
+    r = std::inclusive_scan(policy, InIter(in.data()), InIter(in.data() + n), OutIter(out.data()), std::plus<>());
+    assert(base(r) == out.data() + n);
+    assert(out == expected);
+
+    r = std::inclusive_scan(policy, InIter(in.data()), InIter(in.data() + n), OutIter(out.data()), std::plus<>(), 10LL);
+    assert(base(r) == out.data() + n);
+    for (int i = 0; i < n; ++i)
+        assert(out[i] == expected[i] + 10);
+
+    // In place.
+    r = std::inclusive_scan(policy, InIter(in.data()), InIter(in.data() + n), OutIter(in.data()));
+    assert(base(r) == in.data() + n);
+    assert(in == expected);
+}
+
+template <class InIter, class OutIter>
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 100000};
+    for (int n : sizes) {
+        test<InIter, OutIter>(std::execution::seq, n);
+        test<InIter, OutIter>(std::execution::par, n);
+        test<InIter, OutIter>(std::execution::par_unseq, n);
+    }
+}
+
+int main(int, char**)
+{
+    test<forward_iterator<long long*>, forward_iterator<long long*> >();
+    test<random_access_iterator<long long*>, random_access_iterator<long long*> >();
+    test<long long*, long long*>();
+
+    // The operation is only required to be associative.
+    {
+    std::vector<std::string> in(5000, "a"), out(5000);
+    std::inclusive_scan(std::execution::par, in.begin(), in.end(), out.begin(), std::plus<>(), std::string("x"));
+    for (int i = 0; i < 5000; ++i)
+        assert(out[i] == "x" + std::string(i + 1, 'a'));
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <numeric>
+
+// template<class ExecutionPolicy, class ForwardIterator>
+//   typename iterator_traits<ForwardIterator>::value_type
+//     reduce(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last);
+// template<class ExecutionPolicy, class ForwardIterator, class T>
+//   T reduce(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last, T init);
+// template<class ExecutionPolicy, class ForwardIterator, class T, class BinaryOperation>
+//   T reduce(ExecutionPolicy&& exec, ForwardIterator first, ForwardIterator last, T init,
+//            BinaryOperation binary_op);
+
+#include <numeric>
+#include <algorithm>
+#include <cassert>
+#include <execution>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+template <class Iter, class Policy>
+void test(Policy&& policy, int n)
+{
+    std::vector<int> v(n);
+    for (int i = 0; i < n; ++i)
+        v[i] = i % 100;
+    long long expected = 0;
+    for (int x : v)
+        expected += x;
+
+    static_assert(std::is_same_v<int, decltype(std::reduce(policy, Iter(v.data()), Iter(v.data())))>, "");
+    assert(std::reduce(policy, Iter(v.data()), Iter(v.data() + n)) == expected);
+
+    static_assert(std::is_same_v<long long, decltype(std::reduce(policy, Iter(v.data()), Iter(v.data()), 0LL))>, "");
+    assert(std::reduce(policy, Iter(v.data()), Iter(v.data() + n), 5LL) == expected + 5);
+
+    int m = std::reduce(policy, Iter(v.data()), Iter(v.data() + n), -1,
+                        [](int x, int y) { return std::max(x, y); });
+    assert(m == (n == 0 ? -1 : std::min(n - 1, 99)));
+}
+
+template <class Iter>
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 100000};
+    for (int n : sizes) {
+        test<Iter>(std::execution::seq, n);
+        test<Iter>(std::execution::par, n);
+        test<Iter>(std::execution::par_unseq, n);
+    }
+}
+
+int main(int, char**)
+{
+    test<forward_iterator<const int*> >();
+    test<random_access_iterator<const int*> >();
+    test<const int*>();
+
+    // A non-trivial result type.
+    {
+    std::vector<std::string> v(5000, "ab");
+    std::string s = std::reduce(std::execution::par, v.begin(), v.end(), std::string("x"));
+    assert(s.size() == 10001);
+    assert(std::count(s.begin(), s.end(), 'a') == 5000);
+    }
+
+    return 0;
+}
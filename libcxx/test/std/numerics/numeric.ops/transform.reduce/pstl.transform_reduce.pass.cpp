@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <numeric>
+
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T>
+//   T transform_reduce(ExecutionPolicy&& exec,
+//                      ForwardIterator1 first1, ForwardIterator1 last1,
+//                      ForwardIterator2 first2, T init);
+// template<class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T,
+//          class BinaryOperation1, class BinaryOperation2>
+//   T transform_reduce(ExecutionPolicy&& exec,
+//                      ForwardIterator1 first1, ForwardIterator1 last1,
+//                      ForwardIterator2 first2, T init,
+//                      BinaryOperation1 binary_op1, BinaryOperation2 binary_op2);
+// template<class ExecutionPolicy, class ForwardIterator, class T,
+//          class BinaryOperation, class UnaryOperation>
+//   T transform_reduce(ExecutionPolicy&& exec,
+//                      ForwardIterator first, ForwardIterator last, T init,
+//                      BinaryOperation binary_op, UnaryOperation unary_op);
+
+#include <numeric>
+#include <cassert>
+#include <execution>
+#include <functional>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+
+template <class Iter1, class Iter2, class Policy>
+void test(Policy&& policy, int n)
+{
+    std::vector<int> a(n), b(n);
+    long long dot = 0, squares = 0;
+    for (int i = 0; i < n; ++i) {
+        a[i] = i % 10;
+        b[i] = i % 7;
+        dot += a[i] * b[i];
+        squares += a[i] * a[i];
+    }
+
+    assert(std::transform_reduce(policy, Iter1(a.data()), Iter1(a.data() + n), Iter2(b.data()), 0LL) == dot);
+    assert(std::transform_reduce(policy, Iter1(a.data()), Iter1(a.data() + n), Iter2(b.data()), 3LL,
+                                 std::plus<>(), std::multiplies<>()) == dot + 3);
+    assert(std::transform_reduce(policy, Iter1(a.data()), Iter1(a.data() + n), 0LL,
+                                 std::plus<>(), [](int x) { return x * x; }) == squares);
+}
+
+template <class Iter1, class Iter2>
+void test()
+{
+    const int sizes[] = {0, 1, 2, 1023, 2048, 100000};
+    for (int n : sizes) {
+        test<Iter1, Iter2>(std::execution::seq, n);
+        test<Iter1, Iter2>(std::execution::par, n);
+        test<Iter1, Iter2>(std::execution::par_unseq, n);
+    }
+}
+
+int main(int, char**)
+{
+    test<forward_iterator<const int*>, forward_iterator<const int*> >();
+    test<random_access_iterator<const int*>, forward_iterator<const int*> >();
+    test<random_access_iterator<const int*>, random_access_iterator<const int*> >();
+    test<const int*, const int*>();
+
+    return 0;
+}
@@ -0,0 +1,215 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides the floating-point overloads yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <charconv>
+
+// from_chars_result from_chars(const char* first, const char* last, float& value,
+//                              chars_format fmt = chars_format::general);
+// from_chars_result from_chars(const char* first, const char* last, double& value,
+//                              chars_format fmt = chars_format::general);
+// from_chars_result from_chars(const char* first, const char* last, long double& value,
+//                              chars_format fmt = chars_format::general);
+
+#include <charconv>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "test_macros.h"
+
+template <class T>
+void check(const char* s, std::chars_format fmt, size_t consumed, T expected)
+{
+    T value = T(42);
+    std::from_chars_result r = std::from_chars(s, s + std::strlen(s), value, fmt);
+    assert(r.ec == std::errc{});
+    assert(r.ptr == s + consumed);
+    if (std::isnan(expected))
+        assert(std::isnan(value) && std::signbit(value) == std::signbit(expected));
+    else
+        assert(value == expected && std::signbit(value) == std::signbit(expected));
+}
+
+template <class T>
+void check(const char* s, T expected)
+{
+    check(s, std::chars_format::general, std::strlen(s), expected);
+}
+
+template <class T>
+void check_error(const char* s, std::chars_format fmt, std::errc ec, size_t consumed)
+{
+    T value = T(42);
+    std::from_chars_result r = std::from_chars(s, s + std::strlen(s), value, fmt);
+    assert(r.ec == ec);
+    assert(r.ptr == s + consumed);
+    assert(value == T(42));
+}
+
+template <class T>
+void test_common()
+{
+    const std::chars_format general = std::chars_format::general;
+    const std::chars_format fixed = std::chars_format::fixed;
+    const std::chars_format scientific = std::chars_format::scientific;
+    const std::chars_format hex = std::chars_format::hex;
+
+    check("0", T(0));
+    check("-0", -T(0));
+    check("1", T(1));
+    check("-1.5", T(-1.5));
+    check(".5", T(0.5));
+    check("5.", T(5));
+    check("0.25e1", T(2.5));
+    check("25E-1", T(2.5));
+    check("000000000000000000000000000000000000000001", T(1));
+    check("1.000000000000000000000000000000000000000000", T(1));
+
+    // Only the longest valid prefix is consumed.
+    check("1.5x", general, 3, T(1.5));
+    check("1e", general, 1, T(1));
+    check("1e+", general, 1, T(1));
+    check("1e5", fixed, 1, T(1));
+    check("1.5e1", scientific, 5, T(15));
+    check("1.5p1", general, 3, T(1.5));
+
+    check("inf", std::numeric_limits<T>::infinity());
+    check("-INFINITY", -std::numeric_limits<T>::infinity());
+    check("infinit", general, 3, std::numeric_limits<T>::infinity());
+    check("nan", std::numeric_limits<T>::quiet_NaN());
+    check("-nan(0x1f_Z)", -std::numeric_limits<T>::quiet_NaN());
+    check("nan(", general, 3, std::numeric_limits<T>::quiet_NaN());
+    check("NaN", fixed, 3, std::numeric_limits<T>::quiet_NaN());
+
+    check("1.8", hex, 3, T(1.5));
+    check("-a.8p-2", hex, 7, T(-2.625));
+    check("0x1p3", hex, 1, T(0));
+    check("1p", hex, 1, T(1));
+    check("0.0p-100000", hex, 11, T(0));
+    check("inf", hex, 3, std::numeric_limits<T>::infinity());
+    check("-Infinity", hex, 9, -std::numeric_limits<T>::infinity());
+    check("nan", hex, 3, std::numeric_limits<T>::quiet_NaN());
+    check("-NAN(1)", hex, 7, -std::numeric_limits<T>::quiet_NaN());
+
+    check_error<T>("", general, std::errc::invalid_argument, 0);
+    check_error<T>("-", general, std::errc::invalid_argument, 0);
+    check_error<T>(".", general, std::errc::invalid_argument, 0);
+    check_error<T>("+1", general, std::errc::invalid_argument, 0);
+    check_error<T>(" 1", general, std::errc::invalid_argument, 0);
+    check_error<T>("e5", general, std::errc::invalid_argument, 0);
+    check_error<T>("-.e", general, std::errc::invalid_argument, 0);
+    check_error<T>("1.5", scientific, std::errc::invalid_argument, 0);
+    check_error<T>("1e", scientific, std::errc::invalid_argument, 0);
+    check_error<T>("g", hex, std::errc::invalid_argument, 0);
+    check_error<T>("in", general, std::errc::invalid_argument, 0);
+
+    // Out of range values leave the output unmodified.
+    check_error<T>("1e100000", general, std::errc::result_out_of_range, 8);
+    check_error<T>("-1e-100000", general, std::errc::result_out_of_range, 10);
+    check_error<T>("1p100000", hex, std::errc::result_out_of_range, 8);
+    check_error<T>("e1p-100000", hex, std::errc::result_out_of_range, 10);
+    check_error<T>("-0.0e1p-100000", hex, std::errc::result_out_of_range, 14);
+}
+
+void test_float()
+{
+    test_common<float>();
+    check("0.1", 0.1f);
+    check("3.4028235e38", FLT_MAX);
+    check("1.17549435e-38", FLT_MIN);
+    check("1e-45", FLT_TRUE_MIN);
+    // Exactly half of FLT_TRUE_MIN rounds to even, anything above it rounds up.
+    check_error<float>("7.00649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625e-46",
+                       std::chars_format::general, std::errc::result_out_of_range, 110);
+    check("7.006492321624085354618647916449580656401309709382578858785341419448955413429303007433190941810607910156250001e-46",
+          FLT_TRUE_MIN);
+    check_error<float>("3.4028236e38", std::chars_format::general, std::errc::result_out_of_range, 12);
+    check("16777217", 16777216.0f);
+    check("16777219", 16777220.0f);
+    check("1.ffffff", std::chars_format::hex, 8, 2.0f);
+    check("1.fffffep127", std::chars_format::hex, 12, FLT_MAX);
+}
+
+void test_double()
+{
+    test_common<double>();
+    check("0.1", 0.1);
+    check("1e23", 1e23);
+    check("8.98846567431158e307", 8.98846567431158e307);
+    check("1.7976931348623157e308", DBL_MAX);
+    check("2.2250738585072014e-308", DBL_MIN);
+    check("4.9406564584124654e-324", DBL_TRUE_MIN);
+    check("2.4703282292062328e-324", DBL_TRUE_MIN);
+    check("9007199254740993", 9007199254740992.0);
+    check("9007199254740993.000000000000000000000000000001", 9007199254740994.0);
+    check("9007199254740995", 9007199254740996.0);
+    check("1.0000000000000002220446049250313080847263336181640625", 1.0000000000000002);
+    check("1.00000000000000011102230246251565404236316680908203125", 1.0);
+    check("1.00000000000000011102230246251565404236316680908203126", 1.0000000000000002);
+    check("179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330"
+          "286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069"
+          "855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497791",
+          DBL_MAX);
+    check_error<double>("1.7976931348623159e308", std::chars_format::general, std::errc::result_out_of_range, 22);
+    check_error<double>("2.4703282292062327e-324", std::chars_format::general, std::errc::result_out_of_range, 23);
+    check("1.fffffffffffffp1023", std::chars_format::hex, 20, DBL_MAX);
+    check("0.0000000000001p-1022", std::chars_format::hex, 21, DBL_TRUE_MIN);
+    check("1.00000000000008", std::chars_format::hex, 16, 1.0);
+    check("1.000000000000080000000001", std::chars_format::hex, 26, 1.0000000000000002);
+
+    // A value halfway between two doubles needs all its digits.
+    std::string halfway = "1." + std::string(1000, '0') + "1";
+    check(halfway.c_str(), 1.0);
+    halfway = "4.9406564584124654e-324";
+    check(halfway.c_str(), DBL_TRUE_MIN);
+}
+
+void test_long_double()
+{
+    test_common<long double>();
+    check("0.5", 0.5L);
+    check("1e10", 1e10L);
+    check("1.0000000000000002220446049250313080847263336181640625",
+          static_cast<long double>(1.0000000000000002));
+}
+
+void test_round_trip()
+{
+    const double values[] = {0.1, 1.0 / 3, 1e23, 5e-324, 2.2250738585072009e-308, 1.7976931348623157e308,
+                             123456.789, 9.5367431640625e-07};
+    for (double v : values) {
+        const std::chars_format formats[] = {std::chars_format::scientific, std::chars_format::fixed,
+                                             std::chars_format::general, std::chars_format::hex};
+        for (std::chars_format fmt : formats) {
+            char buf[1100];
+            std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), v, fmt);
+            assert(r.ec == std::errc{});
+            double parsed;
+            std::from_chars_result r2 = std::from_chars(buf, r.ptr, parsed, fmt);
+            assert(r2.ec == std::errc{} && r2.ptr == r.ptr && parsed == v);
+        }
+    }
+}
+
+int main(int, char**)
+{
+    test_float();
+    test_double();
+    test_long_double();
+    test_round_trip();
+
+    return 0;
+}
@@ -0,0 +1,249 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides the floating-point overloads yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <charconv>
+
+// to_chars_result to_chars(char* first, char* last, float value);
+// to_chars_result to_chars(char* first, char* last, double value);
+// to_chars_result to_chars(char* first, char* last, long double value);
+// to_chars_result to_chars(char* first, char* last, float value, chars_format fmt);
+// to_chars_result to_chars(char* first, char* last, double value, chars_format fmt);
+// to_chars_result to_chars(char* first, char* last, long double value, chars_format fmt);
+// to_chars_result to_chars(char* first, char* last, float value, chars_format fmt, int precision);
+// to_chars_result to_chars(char* first, char* last, double value, chars_format fmt, int precision);
+// to_chars_result to_chars(char* first, char* last, long double value, chars_format fmt, int precision);
+
+#include <charconv>
+#include <cassert>
+#include <cfloat>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#include "test_macros.h"
+
+template <class T>
+void check(T value, const char* expected)
+{
+    char buf[1100];
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), value);
+    assert(r.ec == std::errc{});
+    assert(std::string_view(buf, r.ptr - buf) == expected);
+
+    // The output must fit exactly.
+    const size_t len = std::strlen(expected);
+    r = std::to_chars(buf, buf + len, value);
+    assert(r.ec == std::errc{} && r.ptr == buf + len);
+    r = std::to_chars(buf, buf + len - 1, value);
+    assert(r.ec == std::errc::value_too_large && r.ptr == buf + len - 1);
+}
+
+template <class T>
+void check(T value, std::chars_format fmt, const char* expected)
+{
+    char buf[1100];
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), value, fmt);
+    assert(r.ec == std::errc{});
+    assert(std::string_view(buf, r.ptr - buf) == expected);
+
+    const size_t len = std::strlen(expected);
+    r = std::to_chars(buf, buf + len - 1, value, fmt);
+    assert(r.ec == std::errc::value_too_large && r.ptr == buf + len - 1);
+}
+
+template <class T>
+void check(T value, std::chars_format fmt, int precision, const char* expected)
+{
+    char buf[1100];
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), value, fmt, precision);
+    assert(r.ec == std::errc{});
+    assert(std::string_view(buf, r.ptr - buf) == expected);
+
+    const size_t len = std::strlen(expected);
+    r = std::to_chars(buf, buf + len, value, fmt, precision);
+    assert(r.ec == std::errc{} && r.ptr == buf + len);
+    r = std::to_chars(buf, buf + len - 1, value, fmt, precision);
+    assert(r.ec == std::errc::value_too_large && r.ptr == buf + len - 1);
+}
+
+template <class T>
+void test_special()
+{
+    check(T(0), "0");
+    check(-T(0), "-0");
+    check(std::numeric_limits<T>::infinity(), "inf");
+    check(-std::numeric_limits<T>::infinity(), "-inf");
+    check(std::numeric_limits<T>::quiet_NaN(), "nan");
+    check(-std::numeric_limits<T>::quiet_NaN(), "-nan");
+    check(T(0), std::chars_format::scientific, "0e+00");
+    check(T(0), std::chars_format::fixed, "0");
+    check(T(0), std::chars_format::general, "0");
+    check(T(0), std::chars_format::hex, "0p+0");
+    check(T(0), std::chars_format::fixed, 3, "0.000");
+    check(T(0), std::chars_format::scientific, 2, "0.00e+00");
+    check(T(0), std::chars_format::general, 3, "0");
+    check(T(0), std::chars_format::hex, 2, "0.00p+0");
+    check(std::numeric_limits<T>::infinity(), std::chars_format::fixed, 5, "inf");
+}
+
+void test_float()
+{
+    test_special<float>();
+    // The shortest representation that round-trips.
+    check(1.0f, "1");
+    check(0.1f, "0.1");
+    check(0.3f, "0.3");
+    check(1.5f, "1.5");
+    check(123456.0f, "123456");
+    check(16777216.0f, "16777216");
+    check(1e10f, "1e+10");
+    check(3e10f, "3e+10");
+    check(1.17549435e-38f, "1.1754944e-38");
+    check(FLT_MAX, "3.4028235e+38");
+    check(FLT_TRUE_MIN, "1e-45");
+    check(-0.001f, "-0.001");
+    check(0.0001234f, "0.0001234");
+    check(1234e-7f, "0.0001234");
+
+    check(3e10f, std::chars_format::fixed, "30000001024");
+    check(1e10f, std::chars_format::scientific, "1e+10");
+    check(100000.0f, std::chars_format::general, "100000");
+    check(1000000.0f, std::chars_format::general, "1e+06");
+    check(0.0001f, std::chars_format::general, "0.0001");
+    check(0.00001f, std::chars_format::general, "1e-05");
+    check(1.0f, std::chars_format::hex, "1p+0");
+    check(0.1f, std::chars_format::hex, "1.99999ap-4");
+    check(FLT_TRUE_MIN, std::chars_format::hex, "0.000002p-126");
+
+    check(0.1f, std::chars_format::fixed, 12, "0.100000001490");
+    check(0.1f, std::chars_format::scientific, 12, "1.000000014901e-01");
+    check(0.1f, std::chars_format::general, 12, "0.10000000149");
+    check(0.1f, std::chars_format::hex, 2, "1.9ap-4");
+}
+
+void test_double()
+{
+    test_special<double>();
+    check(1.0, "1");
+    check(0.1, "0.1");
+    check(0.3, "0.3");
+    check(1.0 / 3, "0.3333333333333333");
+    check(2.0 / 3, "0.6666666666666666");
+    check(1e23, "1e+23");
+    check(9007199254740993.0, "9007199254740992");
+    check(123456789.0, "123456789");
+    check(1e21, "1e+21");
+    check(DBL_MAX, "1.7976931348623157e+308");
+    check(DBL_MIN, "2.2250738585072014e-308");
+    check(DBL_TRUE_MIN, "5e-324");
+    check(-1.5e-10, "-1.5e-10");
+
+    // Chooses the shorter of fixed and scientific, preferring fixed.
+    check(1e-3, "0.001");
+    check(1e-4, "1e-04");
+    check(1e4, "10000");
+    check(1e5, "1e+05");
+    check(1234e-7, "0.0001234");
+    check(1234e5, "123400000");
+    check(1234e6, "1.234e+09");
+
+    // The exact value of an integer is at least as short as its shortest
+    // round-trip digits followed by zeros.
+    check(1e23, std::chars_format::fixed, "99999999999999991611392");
+    check(5e-324, std::chars_format::fixed,
+          "0.00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+          "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+          "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+          "0000000000000000000005");
+    check(1e23, std::chars_format::scientific, "1e+23");
+    check(123.456, std::chars_format::scientific, "1.23456e+02");
+    check(123.456, std::chars_format::general, "123.456");
+    check(1e-5, std::chars_format::general, "1e-05");
+    check(1.0, std::chars_format::hex, "1p+0");
+    check(-0.1, std::chars_format::hex, "-1.999999999999ap-4");
+    check(DBL_MAX, std::chars_format::hex, "1.fffffffffffffp+1023");
+    check(DBL_TRUE_MIN, std::chars_format::hex, "0.0000000000001p-1022");
+
+    // Precision: exact digits, correctly rounded with ties to even.
+    check(0.1, std::chars_format::fixed, 20, "0.10000000000000000555");
+    check(0.125, std::chars_format::fixed, 2, "0.12");
+    check(0.375, std::chars_format::fixed, 2, "0.38");
+    check(2.5, std::chars_format::fixed, 0, "2");
+    check(3.5, std::chars_format::fixed, 0, "4");
+    check(0.5, std::chars_format::fixed, 0, "0");
+    check(0.51, std::chars_format::fixed, 0, "1");
+    check(9.9999, std::chars_format::fixed, 3, "10.000");
+    check(0.0004, std::chars_format::fixed, 3, "0.000");
+    check(0.0006, std::chars_format::fixed, 3, "0.001");
+    check(1e23, std::chars_format::fixed, 2, "99999999999999991611392.00");
+    check(1e23, std::chars_format::scientific, 25, "9.9999999999999991611392000e+22");
+    check(9.96, std::chars_format::scientific, 1, "1.0e+01");
+    check(1.0, std::chars_format::scientific, 0, "1e+00");
+    check(1e-300, std::chars_format::scientific, 3, "1.000e-300");
+    check(DBL_MAX, std::chars_format::scientific, 2, "1.80e+308");
+
+    check(100.0, std::chars_format::general, 2, "1e+02");
+    check(123456.0, std::chars_format::general, 6, "123456");
+    check(1234567.0, std::chars_format::general, 6, "1.23457e+06");
+    check(0.0001, std::chars_format::general, 6, "0.0001");
+    check(0.00001, std::chars_format::general, 6, "1e-05");
+    check(999999.5, std::chars_format::general, 6, "1e+06");
+    check(0.5, std::chars_format::general, 0, "0.5");
+    check(0.1, std::chars_format::general, 30, "0.100000000000000005551115123126");
+    check(1.0, std::chars_format::general, 1000, "1");
+
+    check(1.0, std::chars_format::hex, 0, "1p+0");
+    check(1.5, std::chars_format::hex, 0, "2p+0");
+    check(2.5, std::chars_format::hex, 0, "1p+1");
+    check(1.03125, std::chars_format::hex, 1, "1.0p+0");
+    check(1.09375, std::chars_format::hex, 1, "1.2p+0");
+    check(1.0, std::chars_format::hex, 3, "1.000p+0");
+    check(1.999999, std::chars_format::hex, 4, "2.0000p+0");
+
+    // A negative precision is the default precision of printf.
+    check(0.1, std::chars_format::fixed, -1, "0.100000");
+    check(0.1, std::chars_format::scientific, -5, "1.000000e-01");
+    check(0.1, std::chars_format::general, -1, "0.1");
+    check(0.1, std::chars_format::hex, -1, "1.999999999999ap-4");
+}
+
+void test_long_double()
+{
+    test_special<long double>();
+    check(1.0L, "1");
+    check(1.5L, "1.5");
+    check(123456789.0L, "123456789");
+    check(0.5L, std::chars_format::fixed, 3, "0.500");
+    check(1e10L, std::chars_format::scientific, 2, "1.00e+10");
+    check(static_cast<long double>(0.1), std::chars_format::fixed, 20, "0.10000000000000000555");
+#if LDBL_MANT_DIG == DBL_MANT_DIG
+    check(0.1L, "0.1");
+    check(LDBL_MAX, "1.7976931348623157e+308");
+#elif LDBL_MANT_DIG == 64
+    check(0.1L, "0.1");
+    check(LDBL_MAX, "1.189731495357231765e+4932");
+    check(LDBL_TRUE_MIN, "4e-4951");
+#elif LDBL_MANT_DIG == 113
+    check(0.1L, "0.1");
+    check(LDBL_MAX, "1.189731495357231765085759326628007e+4932");
+#endif
+}
+
+int main(int, char**)
+{
+    test_float();
+    test_double();
+    test_long_double();
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+// UNSUPPORTED: libcpp-has-no-parallel-algorithms
+
+// <execution>
+
+// class sequenced_policy;
+// class parallel_policy;
+// class parallel_unsequenced_policy;
+// class unsequenced_policy; // C++20
+//
+// inline constexpr sequenced_policy seq;
+// inline constexpr parallel_policy par;
+// inline constexpr parallel_unsequenced_policy par_unseq;
+// inline constexpr unsequenced_policy unseq; // C++20
+//
+// template<class T> struct is_execution_policy;
+// template<class T> inline constexpr bool is_execution_policy_v;
+
+#include <execution>
+#include <type_traits>
+
+#include "test_macros.h"
+
+template <class Policy, class Obj>
+void test(const Obj&)
+{
+    static_assert(std::is_same_v<Policy, Obj>, "");
+    static_assert(!std::is_default_constructible_v<Policy>, "");
+    static_assert(!std::is_copy_constructible_v<Policy>, "");
+    static_assert(!std::is_copy_assignable_v<Policy>, "");
+    static_assert(std::is_execution_policy<Policy>::value, "");
+    static_assert(std::is_execution_policy_v<Policy>, "");
+    static_assert(std::is_base_of_v<std::true_type, std::is_execution_policy<Policy> >, "");
+}
+
+int main(int, char**)
+{
+    test<std::execution::sequenced_policy>(std::execution::seq);
+    test<std::execution::parallel_policy>(std::execution::par);
+    test<std::execution::parallel_unsequenced_policy>(std::execution::par_unseq);
+#if TEST_STD_VER > 17
+    test<std::execution::unsequenced_policy>(std::execution::unseq);
+#endif
+
+    static_assert(!std::is_execution_policy_v<int>, "");
+    static_assert(!std::is_execution_policy_v<const std::execution::parallel_policy&>, "");
+    static_assert(!std::is_execution_policy<void>::value, "");
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+//===----------------------------------------------------------------------===//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+// UNSUPPORTED: libcpp-has-no-localization
+
+// <format>
+
+// template<class... Args>
+//   string format(format_string<Args...> fmt, const Args&... args);
+// template<class... Args>
+//   wstring format(wformat_string<Args...> fmt, const Args&... args);
+// template<class... Args>
+//   string format(const locale& loc, format_string<Args...> fmt, const Args&... args);
+// template<class... Args>
+//   wstring format(const locale& loc, wformat_string<Args...> fmt, const Args&... args);
+
+#include <format>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <locale>
+#include <string>
+#include <string_view>
+
+#include "test_macros.h"
+#include "make_string.h"
+
+#define STR(S) MAKE_STRING(CharT, S)
+#define CSTR(S) MAKE_CSTRING(CharT, S)
+
+template <class CharT>
+struct numpunct;
+
+template <>
+struct numpunct<char> : std::numpunct<char> {
+  string_type do_truename() const override { return "yes"; }
+  string_type do_falsename() const override { return "no"; }
+  std::string do_grouping() const override { return "\1\2\3"; }
+  char do_thousands_sep() const override { return '_'; }
+  char do_decimal_point() const override { return '#'; }
+};
+
+template <>
+struct numpunct<wchar_t> : std::numpunct<wchar_t> {
+  string_type do_truename() const override { return L"yes"; }
+  string_type do_falsename() const override { return L"no"; }
+  std::string do_grouping() const override { return "\1\2\3"; }
+  wchar_t do_thousands_sep() const override { return L'_'; }
+  wchar_t do_decimal_point() const override { return L'#'; }
+};
+
+// A type with a user-defined formatter; format strings with such arguments
+// are validated at compile time and parsed again at run time.
+struct point {
+  int x;
+  int y;
+};
+
+template <class CharT>
+struct std::formatter<point, CharT> : std::formatter<int, CharT> {
+  template <class FormatContext>
+  auto format(point p, FormatContext& ctx) const {
+    auto out = std::formatter<int, CharT>::format(p.x, ctx);
+    *out++ = CharT(',');
+    ctx.advance_to(out);
+    return std::formatter<int, CharT>::format(p.y, ctx);
+  }
+};
+
+template <class CharT>
+void test_literal() {
+  assert(std::format(CSTR("")) == STR(""));
+  assert(std::format(CSTR("hello")) == STR("hello"));
+  assert(std::format(CSTR("{{}}")) == STR("{}"));
+  assert(std::format(CSTR("{{{}}}"), 42) == STR("{42}"));
+  assert(std::format(CSTR("a{}b{}c"), 1, 2) == STR("a1b2c"));
+  assert(std::format(CSTR("{1}{0}{1}"), 1, 2) == STR("212"));
+  // More replacement fields than arguments.
+  assert(std::format(CSTR("{0}{0}{0}{0}"), 7) == STR("7777"));
+
+  // Output larger than the internal buffer.
+  std::basic_string<CharT> large(1000, CharT('x'));
+  assert(std::format(CSTR("{}{}"), large, large) == large + large);
+  assert(std::format(CSTR("{:y>1000}"), CSTR("")) == std::basic_string<CharT>(1000, CharT('y')));
+}
+
+template <class CharT>
+void test_bool_and_char() {
+  assert(std::format(CSTR("{}"), true) == STR("true"));
+  assert(std::format(CSTR("{:>6}"), false) == STR(" false"));
+  assert(std::format(CSTR("{:d}"), true) == STR("1"));
+  assert(std::format(CSTR("{:#x}"), true) == STR("0x1"));
+
+  assert(std::format(CSTR("{}"), CharT('a')) == STR("a"));
+  assert(std::format(CSTR("{:*^5}"), CharT('a')) == STR("**a**"));
+  assert(std::format(CSTR("{:d}"), CharT('a')) == STR("97"));
+  assert(std::format(CSTR("{:#x}"), CharT('a')) == STR("0x61"));
+  assert(std::format(CSTR("{:c}"), 65) == STR("A"));
+  if constexpr (std::same_as<CharT, wchar_t>)
+    assert(std::format(L"{}", 'c') == L"c");
+}
+
+template <class CharT>
+void test_integer() {
+  assert(std::format(CSTR("{}"), 0) == STR("0"));
+  assert(std::format(CSTR("{}"), -42) == STR("-42"));
+  assert(std::format(CSTR("{}"), INT_MIN) == STR("-2147483648"));
+  assert(std::format(CSTR("{}"), LLONG_MIN) == STR("-9223372036854775808"));
+  assert(std::format(CSTR("{}"), ULLONG_MAX) == STR("18446744073709551615"));
+  assert(std::format(CSTR("{}"), static_cast<signed char>(-1)) == STR("-1"));
+  assert(std::format(CSTR("{}"), static_cast<unsigned short>(65535)) == STR("65535"));
+
+  assert(std::format(CSTR("{:+}"), 1) == STR("+1"));
+  assert(std::format(CSTR("{: }"), 1) == STR(" 1"));
+  assert(std::format(CSTR("{:-}"), -1) == STR("-1"));
+
+  assert(std::format(CSTR("{:b}"), 5) == STR("101"));
+  assert(std::format(CSTR("{:#B}"), 5) == STR("0B101"));
+  assert(std::format(CSTR("{:o}"), 8) == STR("10"));
+  assert(std::format(CSTR("{:#o}"), 8) == STR("010"));
+  assert(std::format(CSTR("{:#o}"), 0) == STR("0"));
+  assert(std::format(CSTR("{:x}"), 255) == STR("ff"));
+  assert(std::format(CSTR("{:#X}"), 255) == STR("0XFF"));
+  assert(std::format(CSTR("{:#x}"), -255) == STR("-0xff"));
+
+  assert(std::format(CSTR("{:5}"), 42) == STR("   42"));
+  assert(std::format(CSTR("{:<5}"), 42) == STR("42   "));
+  assert(std::format(CSTR("{:^5}"), 42) == STR(" 42  "));
+  assert(std::format(CSTR("{:05}"), -42) == STR("-0042"));
+  assert(std::format(CSTR("{:#06x}"), 42) == STR("0x002a"));
+  assert(std::format(CSTR("{:<05}"), 42) == STR("42   "));
+  assert(std::format(CSTR("{:{}}"), 42, 5) == STR("   42"));
+  assert(std::format(CSTR("{0:{1}}"), 42, 4) == STR("  42"));
+
+#ifndef TEST_HAS_NO_INT128
+  assert(std::format(CSTR("{}"), static_cast<__int128_t>(-5)) == STR("-5"));
+  assert(std::format(CSTR("{:x}"), ~static_cast<__uint128_t>(0)) == STR("ffffffffffffffffffffffffffffffff"));
+  assert(std::format(CSTR("{}"), static_cast<__uint128_t>(1) << 64) == STR("18446744073709551616"));
+#endif
+}
+
+template <class CharT>
+void test_floating_point() {
+  assert(std::format(CSTR("{}"), 0.0) == STR("0"));
+  assert(std::format(CSTR("{}"), -0.0) == STR("-0"));
+  assert(std::format(CSTR("{}"), 1.5) == STR("1.5"));
+  assert(std::format(CSTR("{}"), 0.1f) == STR("0.1"));
+  assert(std::format(CSTR("{}"), 1e100) == STR("1e+100"));
+  assert(std::format(CSTR("{}"), 1.0L) == STR("1"));
+
+  assert(std::format(CSTR("{:f}"), 3.14159) == STR("3.141590"));
+  assert(std::format(CSTR("{:.2f}"), 3.14159) == STR("3.14"));
+  assert(std::format(CSTR("{:e}"), 1234.5) == STR("1.234500e+03"));
+  assert(std::format(CSTR("{:.1E}"), 1234.5) == STR("1.2E+03"));
+  assert(std::format(CSTR("{:g}"), 0.0001) == STR("0.0001"));
+  assert(std::format(CSTR("{:g}"), 1e-5) == STR("1e-05"));
+  assert(std::format(CSTR("{:G}"), 1e-5) == STR("1E-05"));
+  assert(std::format(CSTR("{:.3}"), 3.14159) == STR("3.14"));
+  assert(std::format(CSTR("{:a}"), 1.5) == STR("1.8p+0"));
+  assert(std::format(CSTR("{:.2A}"), 1.0) == STR("1.00P+0"));
+
+  // The alternate form.
+  assert(std::format(CSTR("{:#}"), 5.0) == STR("5."));
+  assert(std::format(CSTR("{:#.0f}"), 5.0) == STR("5."));
+  assert(std::format(CSTR("{:#.0e}"), 5.0) == STR("5.e+00"));
+  assert(std::format(CSTR("{:#g}"), 1.0) == STR("1.00000"));
+  assert(std::format(CSTR("{:#.3g}"), 0.0) == STR("0.00"));
+  assert(std::format(CSTR("{:#g}"), 1e20) == STR("1.00000e+20"));
+
+  assert(std::format(CSTR("{:+}"), 1.5) == STR("+1.5"));
+  assert(std::format(CSTR("{:08.2f}"), -1.5) == STR("-0001.50"));
+  assert(std::format(CSTR("{:^9.2f}"), 1.5) == STR("  1.50   "));
+  assert(std::format(CSTR("{:.{}f}"), 1.0, 3) == STR("1.000"));
+
+  assert(std::format(CSTR("{}"), INFINITY) == STR("inf"));
+  assert(std::format(CSTR("{}"), -INFINITY) == STR("-inf"));
+  assert(std::format(CSTR("{:F}"), NAN) == STR("NAN"));
+  assert(std::format(CSTR("{:+}"), NAN) == STR("+nan"));
+  assert(std::format(CSTR("{:06}"), -INFINITY) == STR("  -inf"));
+
+  // A precision that does not fit the internal buffer.
+  std::basic_string<CharT> s = std::format(CSTR("{:.500f}"), 1.0);
+  assert(s.size() == 502);
+  assert(s.substr(0, 4) == STR("1.00"));
+  assert(std::format(CSTR("{:f}"), 1e300).size() == 308);
+}
+
+template <class CharT>
+void test_string_and_pointer() {
+  const CharT* cstr = CSTR("abc");
+  std::basic_string<CharT> str = STR("abc");
+  std::basic_string_view<CharT> sv = str;
+  assert(std::format(CSTR("{}"), cstr) == STR("abc"));
+  assert(std::format(CSTR("{}"), str) == STR("abc"));
+  assert(std::format(CSTR("{}"), sv) == STR("abc"));
+  assert(std::format(CSTR("{:s}"), CSTR("abc")) == STR("abc"));
+  assert(std::format(CSTR("{:5}"), cstr) == STR("abc  "));
+  assert(std::format(CSTR("{:>5}"), str) == STR("  abc"));
+  assert(std::format(CSTR("{:.2}"), sv) == STR("ab"));
+  assert(std::format(CSTR("{:*^6.1}"), sv) == STR("**a***"));
+  assert(std::format(CSTR("{:.{}}"), sv, 1) == STR("a"));
+  assert(std::format(CSTR("{:{}.{}}"), sv, 4, 2) == STR("ab  "));
+
+  assert(std::format(CSTR("{}"), nullptr) == STR("0x0"));
+  assert(std::format(CSTR("{:p}"), reinterpret_cast<void*>(0x1234)) == STR("0x1234"));
+  assert(std::format(CSTR("{:>8}"), reinterpret_cast<const void*>(0xab)) == STR("    0xab"));
+}
+
+template <class CharT>
+void test_user_defined() {
+  assert(std::format(CSTR("{}"), point{1, 2}) == STR("1,2"));
+  assert(std::format(CSTR("[{:>3}]"), point{1, 2}) == STR("[  1,  2]"));
+  assert(std::format(CSTR("{} {:x}"), point{1, 2}, 255) == STR("1,2 ff"));
+  assert(std::format(CSTR("{1} {0:{1}}"), point{1, 2}, 2) == STR("2  1, 2"));
+}
+
+template <class CharT>
+void test_locale() {
+  std::locale loc(std::locale(), new numpunct<CharT>());
+
+  // Without the L option the locale is not used.
+  assert(std::format(loc, CSTR("{}"), 1234567) == STR("1234567"));
+  assert(std::format(loc, CSTR("{}"), true) == STR("true"));
+
+  assert(std::format(loc, CSTR("{:L}"), true) == STR("yes"));
+  assert(std::format(loc, CSTR("{:L}"), false) == STR("no"));
+  assert(std::format(loc, CSTR("{:L}"), 1234567) == STR("1_234_56_7"));
+  assert(std::format(loc, CSTR("{:L}"), -1234567) == STR("-1_234_56_7"));
+  assert(std::format(loc, CSTR("{:#Lx}"), 0x123456) == STR("0x123_45_6"));
+  assert(std::format(loc, CSTR("{:012L}"), 1234567) == STR("001_234_56_7"));
+  assert(std::format(loc, CSTR("{:L}"), 1234.5) == STR("1_23_4#5"));
+  assert(std::format(loc, CSTR("{:.2Lf}"), 1234.5) == STR("1_23_4#50"));
+  assert(std::format(loc, CSTR("{:Le}"), 1234.5) == STR("1#234500e+03"));
+
+  // The global locale is used when none is passed.
+  std::locale old = std::locale::global(loc);
+  assert(std::format(CSTR("{:L}"), 1234567) == STR("1_234_56_7"));
+  std::locale::global(old);
+  assert(std::format(CSTR("{:L}"), 1234567) == STR("1234567"));
+}
+
+template <class CharT>
+void test() {
+  test_literal<CharT>();
+  test_bool_and_char<CharT>();
+  test_integer<CharT>();
+  test_floating_point<CharT>();
+  test_string_and_pointer<CharT>();
+  test_user_defined<CharT>();
+  test_locale<CharT>();
+}
+
+int main(int, char**) {
+  test<char>();
+  test<wchar_t>();
+
+  // The estimated width of a code point in UTF-8 depends on its value.
+  assert(std::format("{:*^6}", "世界") == "*世界*");
+  assert(std::format("{:.3}", "世界") == "世");
+  assert(std::format("{:*<3}", "é") == "é**");
+  assert(std::format("{:é^5}", 1) == "éé1éé");
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+
+// <format>
+
+// template<class Out, class... Args>
+//   Out format_to(Out out, format_string<Args...> fmt, const Args&... args);
+// template<class Out, class... Args>
+//   format_to_n_result<Out> format_to_n(Out out, iter_difference_t<Out> n,
+//                                       format_string<Args...> fmt, const Args&... args);
+// template<class... Args>
+//   size_t formatted_size(format_string<Args...> fmt, const Args&... args);
+//
+// And the wformat_string overloads.
+
+#include <format>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "test_macros.h"
+#include "test_iterators.h"
+#include "make_string.h"
+
+#define STR(S) MAKE_STRING(CharT, S)
+#define CSTR(S) MAKE_CSTRING(CharT, S)
+
+template <class CharT>
+void test_format_to() {
+  const std::basic_string<CharT> expected = STR("answer = 42, pi = 3.14");
+  {
+    // Contiguous output.
+    CharT buffer[64];
+    CharT* out = std::format_to(buffer, CSTR("answer = {}, pi = {:.2f}"), 42, 3.14159);
+    assert(std::basic_string<CharT>(buffer, out) == expected);
+  }
+  {
+    std::basic_string<CharT> str(expected.size(), CharT(' '));
+    auto out = std::format_to(str.begin(), CSTR("answer = {}, pi = {:.2f}"), 42, 3.14159);
+    assert(out == str.end());
+    assert(str == expected);
+  }
+  {
+    std::basic_string<CharT> str;
+    std::format_to(std::back_inserter(str), CSTR("answer = {}, pi = {:.2f}"), 42, 3.14159);
+    assert(str == expected);
+  }
+  {
+    std::vector<CharT> vec;
+    std::format_to(std::back_inserter(vec), CSTR("answer = {}, pi = {:.2f}"), 42, 3.14159);
+    assert(std::basic_string<CharT>(vec.begin(), vec.end()) == expected);
+  }
+  {
+    std::list<CharT> list;
+    std::format_to(std::back_inserter(list), CSTR("answer = {}, pi = {:.2f}"), 42, 3.14159);
+    assert(std::basic_string<CharT>(list.begin(), list.end()) == expected);
+  }
+  {
+    CharT buffer[64];
+    auto out = std::format_to(output_iterator<CharT*>(buffer), CSTR("answer = {}, pi = {:.2f}"), 42, 3.14159);
+    assert(std::basic_string<CharT>(buffer, out.base()) == expected);
+  }
+  {
+    // Output larger than the internal buffer, to an output iterator that
+    // receives it in chunks.
+    std::list<CharT> list;
+    std::format_to(std::back_inserter(list), CSTR("{:->1000}{}"), 1, 2);
+    assert(list.size() == 1001);
+    assert(std::count(list.begin(), list.end(), CharT('-')) == 999);
+    assert(list.back() == CharT('2'));
+  }
+}
+
+template <class CharT>
+void test_format_to_n() {
+  {
+    CharT buffer[8];
+    auto result = std::format_to_n(buffer, 5, CSTR("{}"), 1234567);
+    assert(result.size == 7);
+    assert(result.out == buffer + 5);
+    assert(std::basic_string<CharT>(buffer, result.out) == STR("12345"));
+  }
+  {
+    CharT buffer[8];
+    auto result = std::format_to_n(buffer, 8, CSTR("{}"), 123);
+    assert(result.size == 3);
+    assert(result.out == buffer + 3);
+    assert(std::basic_string<CharT>(buffer, result.out) == STR("123"));
+  }
+  {
+    CharT buffer[1];
+    auto result = std::format_to_n(buffer, 0, CSTR("{}"), 123);
+    assert(result.size == 3);
+    assert(result.out == buffer);
+    result = std::format_to_n(buffer, -1, CSTR("{}"), 123);
+    assert(result.size == 3);
+    assert(result.out == buffer);
+  }
+  {
+    std::basic_string<CharT> str;
+    auto result = std::format_to_n(std::back_inserter(str), 600, CSTR("{:*>1000}"), CSTR(""));
+    assert(result.size == 1000);
+    assert(str == std::basic_string<CharT>(600, CharT('*')));
+  }
+}
+
+template <class CharT>
+void test_formatted_size() {
+  assert(std::formatted_size(CSTR("")) == 0);
+  assert(std::formatted_size(CSTR("{}"), 1234567) == 7);
+  assert(std::formatted_size(CSTR("{:>1000}"), 1) == 1000);
+  assert(std::formatted_size(CSTR("{} {}"), CSTR("abc"), 1.5) == 7);
+}
+
+template <class CharT>
+void test() {
+  test_format_to<CharT>();
+  test_format_to_n<CharT>();
+  test_formatted_size<CharT>();
+}
+
+int main(int, char**) {
+  test<char>();
+  test<wchar_t>();
+
+  return 0;
+}
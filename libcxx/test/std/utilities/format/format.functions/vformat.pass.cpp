@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14, c++17
+// UNSUPPORTED: libcpp-no-concepts
+
+// <format>
+
+// string vformat(string_view fmt, format_args args);
+// wstring vformat(wstring_view fmt, wformat_args args);
+// template<class Out>
+//   Out vformat_to(Out out, string_view fmt, format_args args);
+// template<class Out>
+//   Out vformat_to(Out out, wstring_view fmt, wformat_args args);
+
+#include <format>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "test_macros.h"
+#include "make_string.h"
+
+#define STR(S) MAKE_STRING(CharT, S)
+#define CSTR(S) MAKE_CSTRING(CharT, S)
+
+template <class CharT, class... Args>
+std::basic_string<CharT> vformat(std::basic_string_view<CharT> fmt, const Args&... args) {
+  using context = std::conditional_t<std::same_as<CharT, char>, std::format_context, std::wformat_context>;
+  std::basic_string<CharT> result = std::vformat(fmt, std::make_format_args<context>(args...));
+  std::basic_string<CharT> str;
+  std::vformat_to(std::back_inserter(str), fmt, std::make_format_args<context>(args...));
+  assert(str == result);
+  return result;
+}
+
+template <class CharT, class... Args>
+void check_exception(std::basic_string_view<CharT> fmt, const Args&... args) {
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  try {
+    vformat(fmt, args...);
+    assert(false);
+  } catch (const std::format_error&) {
+    return;
+  }
+  assert(false);
+#else
+  (void)fmt;
+  ((void)args, ...);
+#endif
+}
+
+template <class CharT>
+void test() {
+  using SV = std::basic_string_view<CharT>;
+
+  assert(vformat(SV(CSTR("hello"))) == STR("hello"));
+  assert(vformat(SV(CSTR("{{{}}}")), 1) == STR("{1}"));
+  assert(vformat(SV(CSTR("{} {:x} {:.2f} {}")), 42, 255, 1.0, CSTR("abc")) == STR("42 ff 1.00 abc"));
+  assert(vformat(SV(CSTR("{1}{0}")), 1, 2) == STR("21"));
+  assert(vformat(SV(CSTR("{:{}}")), 1, 3) == STR("  1"));
+  assert(vformat(SV(CSTR("{:*^{}.{}}")), CSTR("abcdef"), 5, 3) == STR("*abc*"));
+
+  // Errors in the format string are reported at run time.
+  check_exception(SV(CSTR("{")));
+  check_exception(SV(CSTR("}")));
+  check_exception(SV(CSTR("{:}")));
+  check_exception(SV(CSTR("{} {}")), 1);
+  check_exception(SV(CSTR("{0} {}")), 1, 2);
+  check_exception(SV(CSTR("{} {0}")), 1, 2);
+  check_exception(SV(CSTR("{:d}")), CSTR("abc"));
+  check_exception(SV(CSTR("{:.2}")), 1);
+  check_exception(SV(CSTR("{:#}")), CSTR("abc"));
+  check_exception(SV(CSTR("{:s}")), 1.0);
+  check_exception(SV(CSTR("{:{}}")), 1, 1.0);
+  check_exception(SV(CSTR("{:{}}")), 1, -1);
+  check_exception(SV(CSTR("{:c}")), 0x1'0000'0000LL);
+  check_exception(SV(CSTR("{0")), 1);
+  check_exception(SV(CSTR("{0:d")), 1);
+}
+
+int main(int, char**) {
+  test<char>();
+  test<wchar_t>();
+
+  return 0;
+}
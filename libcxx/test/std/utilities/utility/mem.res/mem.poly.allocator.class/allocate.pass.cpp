@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides <memory_resource> yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <memory_resource>
+
+// template <class T> class polymorphic_allocator;
+
+// T* allocate(size_t n);
+// void deallocate(T* p, size_t n);
+// template <class T, class... Args> void construct(T* p, Args&&... args);
+
+#include <memory_resource>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "test_macros.h"
+
+// Forwards to new_delete_resource() and records how it is used.
+struct CountingResource : std::pmr::memory_resource {
+  int allocations = 0;
+  int deallocations = 0;
+  std::size_t outstanding_bytes = 0;
+
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++allocations;
+    outstanding_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    ++deallocations;
+    outstanding_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+};
+
+// A type that takes a trailing allocator argument.
+struct UsesAlloc {
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
+  int value;
+  std::pmr::memory_resource* resource;
+  UsesAlloc(int v, const allocator_type& a) : value(v), resource(a.resource()) {}
+};
+
+int main(int, char**) {
+  CountingResource r;
+  {
+    std::pmr::polymorphic_allocator<int> a(&r);
+    assert(a.resource() == &r);
+
+    int* p = a.allocate(10);
+    assert(r.allocations == 1);
+    assert(r.outstanding_bytes == 10 * sizeof(int));
+    a.deallocate(p, 10);
+    assert(r.deallocations == 1);
+    assert(r.outstanding_bytes == 0);
+
+    std::pmr::polymorphic_allocator<double> b(a);
+    assert(a == b);
+    assert(!(a != b));
+    assert(std::pmr::polymorphic_allocator<int>() != a);
+  }
+#ifndef TEST_HAS_NO_EXCEPTIONS
+  {
+    std::pmr::polymorphic_allocator<int> a(&r);
+    try {
+      (void)a.allocate(std::numeric_limits<std::size_t>::max() / sizeof(int) + 1);
+      assert(false);
+    } catch (const std::bad_array_new_length&) {
+    }
+    assert(r.allocations == 1);
+  }
+#endif
+  {
+    // The allocator is propagated to types that use it.
+    std::pmr::polymorphic_allocator<UsesAlloc> a(&r);
+    UsesAlloc* p = a.allocate(1);
+    a.construct(p, 42);
+    assert(p->value == 42);
+    assert(p->resource == &r);
+    a.destroy(p);
+    a.deallocate(p, 1);
+  }
+  {
+    using P = std::pair<UsesAlloc, int>;
+    std::pmr::polymorphic_allocator<P> a(&r);
+    P* p = a.allocate(1);
+    a.construct(p, std::piecewise_construct, std::forward_as_tuple(7), std::forward_as_tuple(8));
+    assert(p->first.value == 7);
+    assert(p->first.resource == &r);
+    assert(p->second == 8);
+    a.destroy(p);
+    a.deallocate(p, 1);
+  }
+#if TEST_STD_VER > 17
+  {
+    std::pmr::polymorphic_allocator<> a(&r);
+    std::pmr::string* s = a.new_object<std::pmr::string>("a string long enough to need an allocation");
+    assert(s->get_allocator().resource() == &r);
+    a.delete_object(s);
+    assert(r.outstanding_bytes == 0);
+
+    void* p = a.allocate_bytes(13, 8);
+    a.deallocate_bytes(p, 13, 8);
+    assert(r.outstanding_bytes == 0);
+  }
+#endif
+  assert(r.outstanding_bytes == 0);
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides <memory_resource> yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <deque> <forward_list> <list> <map> <regex> <set> <string> <unordered_map>
+// <unordered_set> <vector>
+
+// namespace std::pmr { template <class T> using vector = ...; ... }
+
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <regex>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <cassert>
+
+#include "test_macros.h"
+
+template <class T>
+using PA = std::pmr::polymorphic_allocator<T>;
+
+static_assert(std::is_same_v<std::pmr::vector<int>, std::vector<int, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::deque<int>, std::deque<int, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::list<int>, std::list<int, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::forward_list<int>, std::forward_list<int, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::map<int, long>,
+                             std::map<int, long, std::less<int>, PA<std::pair<const int, long>>>>);
+static_assert(std::is_same_v<std::pmr::multimap<int, long>,
+                             std::multimap<int, long, std::less<int>, PA<std::pair<const int, long>>>>);
+static_assert(std::is_same_v<std::pmr::set<int>, std::set<int, std::less<int>, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::multiset<int>, std::multiset<int, std::less<int>, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::unordered_map<int, long>,
+                             std::unordered_map<int, long, std::hash<int>, std::equal_to<int>,
+                                                PA<std::pair<const int, long>>>>);
+static_assert(std::is_same_v<std::pmr::unordered_multimap<int, long>,
+                             std::unordered_multimap<int, long, std::hash<int>, std::equal_to<int>,
+                                                     PA<std::pair<const int, long>>>>);
+static_assert(std::is_same_v<std::pmr::unordered_set<int>,
+                             std::unordered_set<int, std::hash<int>, std::equal_to<int>, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::unordered_multiset<int>,
+                             std::unordered_multiset<int, std::hash<int>, std::equal_to<int>, PA<int>>>);
+static_assert(std::is_same_v<std::pmr::string, std::basic_string<char, std::char_traits<char>, PA<char>>>);
+static_assert(std::is_same_v<std::pmr::wstring, std::basic_string<wchar_t, std::char_traits<wchar_t>, PA<wchar_t>>>);
+static_assert(std::is_same_v<std::pmr::u16string, std::basic_string<char16_t, std::char_traits<char16_t>, PA<char16_t>>>);
+static_assert(std::is_same_v<std::pmr::u32string, std::basic_string<char32_t, std::char_traits<char32_t>, PA<char32_t>>>);
+static_assert(std::is_same_v<std::pmr::cmatch, std::match_results<const char*, PA<std::csub_match>>>);
+static_assert(std::is_same_v<std::pmr::smatch, std::match_results<std::string::const_iterator, PA<std::ssub_match>>>);
+
+int main(int, char**) {
+  // Nested containers pass their resource down to their elements.
+  std::pmr::unsynchronized_pool_resource pool;
+  std::pmr::vector<std::pmr::string> v(&pool);
+  v.emplace_back("a string that is too long for the small buffer");
+  assert(v.get_allocator().resource() == &pool);
+  assert(v[0].get_allocator().resource() == &pool);
+
+  std::pmr::map<std::pmr::string, std::pmr::vector<int>> m(&pool);
+  m["key"].push_back(1);
+  assert(m.begin()->second.get_allocator().resource() == &pool);
+
+  return 0;
+}
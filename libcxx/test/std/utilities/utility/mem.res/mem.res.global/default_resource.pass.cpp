@@ -0,0 +1,47 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides <memory_resource> yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <memory_resource>
+
+// memory_resource* get_default_resource() noexcept;
+// memory_resource* set_default_resource(memory_resource* r) noexcept;
+
+#include <memory_resource>
+#include <cassert>
+
+#include "test_macros.h"
+
+struct DummyResource : std::pmr::memory_resource {
+  void* do_allocate(std::size_t, std::size_t) override { return nullptr; }
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+};
+
+int main(int, char**) {
+  static_assert(noexcept(std::pmr::get_default_resource()));
+  static_assert(noexcept(std::pmr::set_default_resource(nullptr)));
+
+  std::pmr::memory_resource* p = std::pmr::get_default_resource();
+  assert(p != nullptr);
+  assert(p == std::pmr::new_delete_resource());
+
+  DummyResource r;
+  assert(std::pmr::set_default_resource(&r) == std::pmr::new_delete_resource());
+  assert(std::pmr::get_default_resource() == &r);
+
+  // Resetting to null restores new_delete_resource().
+  assert(std::pmr::set_default_resource(nullptr) == &r);
+  assert(std::pmr::get_default_resource() == std::pmr::new_delete_resource());
+
+  return 0;
+}
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides <memory_resource> yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <memory_resource>
+
+// memory_resource* new_delete_resource() noexcept;
+// memory_resource* null_memory_resource() noexcept;
+
+#include <memory_resource>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#include "test_macros.h"
+
+int main(int, char**) {
+  static_assert(noexcept(std::pmr::new_delete_resource()));
+  static_assert(noexcept(std::pmr::null_memory_resource()));
+
+  {
+    std::pmr::memory_resource* r = std::pmr::new_delete_resource();
+    assert(r == std::pmr::new_delete_resource());
+    assert(*r == *std::pmr::new_delete_resource());
+    assert(*r != *std::pmr::null_memory_resource());
+
+    void* p = r->allocate(100);
+    assert(p != nullptr);
+    r->deallocate(p, 100);
+
+    void* q = r->allocate(64, 256);
+    assert(reinterpret_cast<std::uintptr_t>(q) % 256 == 0);
+    r->deallocate(q, 64, 256);
+  }
+  {
+    std::pmr::memory_resource* r = std::pmr::null_memory_resource();
+    assert(r == std::pmr::null_memory_resource());
+    assert(*r == *std::pmr::null_memory_resource());
+#ifndef TEST_HAS_NO_EXCEPTIONS
+    try {
+      (void)r->allocate(1);
+      assert(false);
+    } catch (const std::bad_alloc&) {
+    }
+#endif
+    r->deallocate(nullptr, 0);
+  }
+
+  return 0;
+}
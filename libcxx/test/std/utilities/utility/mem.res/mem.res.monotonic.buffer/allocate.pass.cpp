@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides <memory_resource> yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <memory_resource>
+
+// class monotonic_buffer_resource;
+
+#include <memory_resource>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "test_macros.h"
+
+// Forwards to new_delete_resource() and records how it is used.
+struct CountingResource : std::pmr::memory_resource {
+  int allocations = 0;
+  std::size_t last_size = 0;
+  std::size_t outstanding_bytes = 0;
+
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++allocations;
+    last_size = bytes;
+    outstanding_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    outstanding_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+};
+
+static bool is_aligned(void* p, std::size_t align) {
+  return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+int main(int, char**) {
+  {
+    // Requests that fit in the initial buffer never go upstream.
+    alignas(16) char buffer[256];
+    std::pmr::monotonic_buffer_resource r(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    void* p1 = r.allocate(10, 1);
+    void* p2 = r.allocate(16, 16);
+    void* p3 = r.allocate(8, 8);
+    for (void* p : {p1, p2, p3}) {
+      assert(static_cast<char*>(p) >= buffer);
+      assert(static_cast<char*>(p) < buffer + sizeof(buffer));
+    }
+    assert(p1 != p2 && p2 != p3 && p1 != p3);
+    assert(is_aligned(p2, 16));
+    assert(is_aligned(p3, 8));
+    r.deallocate(p1, 10, 1);
+
+    // release() makes the whole buffer available again.
+    r.release();
+    void* big = r.allocate(256, 1);
+    assert(big == buffer);
+#ifndef TEST_HAS_NO_EXCEPTIONS
+    try {
+      (void)r.allocate(1, 1);
+      assert(false);
+    } catch (const std::bad_alloc&) {
+    }
+#endif
+  }
+  {
+    CountingResource upstream;
+    {
+      std::pmr::monotonic_buffer_resource r(100, &upstream);
+      assert(r.upstream_resource() == &upstream);
+      assert(upstream.allocations == 0);
+
+      // Chunks grow geometrically.
+      std::size_t previous = 0;
+      for (int i = 0; i < 2000; ++i) {
+        int before = upstream.allocations;
+        void* p = r.allocate(24, 8);
+        assert(is_aligned(p, 8));
+        if (upstream.allocations != before) {
+          assert(upstream.last_size > previous);
+          previous = upstream.last_size;
+        }
+      }
+      assert(upstream.allocations < 15);
+
+      // Over-aligned and oversized requests are satisfied too.
+      void* p = r.allocate(5000, 256);
+      assert(is_aligned(p, 256));
+
+      r.release();
+      assert(upstream.outstanding_bytes == 0);
+      (void)r.allocate(1);
+    }
+    assert(upstream.outstanding_bytes == 0);
+  }
+
+  return 0;
+}
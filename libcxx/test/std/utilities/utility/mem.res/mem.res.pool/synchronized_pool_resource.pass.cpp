@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides <memory_resource> yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// UNSUPPORTED: libcpp-has-no-threads
+
+// <memory_resource>
+
+// class synchronized_pool_resource;
+
+#include <memory_resource>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "test_macros.h"
+
+// Forwards to new_delete_resource() and records how many bytes are in use.
+struct CountingResource : std::pmr::memory_resource {
+  std::atomic<std::size_t> outstanding_bytes{0};
+
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    outstanding_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    outstanding_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+};
+
+int main(int, char**) {
+  {
+    std::pmr::pool_options opts;
+    opts.largest_required_pool_block = 4096;
+    std::pmr::synchronized_pool_resource r(opts, std::pmr::new_delete_resource());
+    assert(r.options().largest_required_pool_block >= 4096);
+    assert(r.upstream_resource() == std::pmr::new_delete_resource());
+    assert(r == r);
+  }
+  {
+    CountingResource upstream;
+    {
+      std::pmr::synchronized_pool_resource r(&upstream);
+      std::vector<void*> shared(4000);
+
+      // Each thread allocates, writes, and frees its own blocks, then frees a
+      // slice of blocks that another thread allocated.
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&r, &shared, t] {
+          std::vector<char*> mine;
+          for (int round = 0; round < 10; ++round) {
+            for (std::size_t i = 1; i < 300; ++i) {
+              char* p = static_cast<char*>(r.allocate(i, 8));
+              assert(reinterpret_cast<std::uintptr_t>(p) % 8 == 0);
+              p[0] = p[i - 1] = static_cast<char>(t);
+              mine.push_back(p);
+            }
+            for (std::size_t i = 1; i < 300; ++i) {
+              assert(mine[i - 1][0] == static_cast<char>(t));
+              r.deallocate(mine[i - 1], i, 8);
+            }
+            mine.clear();
+          }
+          for (int i = t * 1000; i < (t + 1) * 1000; ++i)
+            shared[i] = r.allocate(48);
+        });
+      }
+      for (std::thread& th : threads)
+        th.join();
+      threads.clear();
+      for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&r, &shared, t] {
+          int other = (t + 1) % 4;
+          for (int i = other * 1000; i < (other + 1) * 1000; ++i)
+            r.deallocate(shared[i], 48);
+        });
+      }
+      for (std::thread& th : threads)
+        th.join();
+
+      void* big = r.allocate(r.options().largest_required_pool_block + 1);
+      r.deallocate(big, r.options().largest_required_pool_block + 1);
+
+      r.release();
+      assert(upstream.outstanding_bytes == 0);
+      (void)r.allocate(16);
+    }
+    assert(upstream.outstanding_bytes == 0);
+  }
+
+  return 0;
+}
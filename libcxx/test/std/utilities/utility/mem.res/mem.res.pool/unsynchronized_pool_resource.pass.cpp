@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03, c++11, c++14
+
+// No shipped dylib provides <memory_resource> yet.
+// UNSUPPORTED: use_system_cxx_lib
+
+// <memory_resource>
+
+// class unsynchronized_pool_resource;
+
+#include <memory_resource>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "test_macros.h"
+
+// Forwards to new_delete_resource() and records how it is used.
+struct CountingResource : std::pmr::memory_resource {
+  int allocations = 0;
+  int deallocations = 0;
+  std::size_t outstanding_bytes = 0;
+
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++allocations;
+    outstanding_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    ++deallocations;
+    outstanding_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return &other == this; }
+};
+
+static bool is_aligned(void* p, std::size_t align) {
+  return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+int main(int, char**) {
+  {
+    // Options are rounded to the values the pools actually use.
+    std::pmr::pool_options opts;
+    opts.max_blocks_per_chunk = 1;
+    opts.largest_required_pool_block = 100;
+    std::pmr::unsynchronized_pool_resource r(opts, std::pmr::new_delete_resource());
+    std::pmr::pool_options got = r.options();
+    assert(got.max_blocks_per_chunk >= 1);
+    assert(got.largest_required_pool_block >= 100);
+    assert(r.upstream_resource() == std::pmr::new_delete_resource());
+  }
+  {
+    CountingResource upstream;
+    std::pmr::unsynchronized_pool_resource r(&upstream);
+    assert(r == r);
+    assert(r != *std::pmr::new_delete_resource());
+
+    // Small blocks come from the pools; once freed, they are reused without
+    // going back upstream.
+    std::vector<void*> blocks;
+    for (int i = 0; i < 1000; ++i) {
+      void* p = r.allocate(24, 8);
+      assert(is_aligned(p, 8));
+      blocks.push_back(p);
+    }
+    int after_first_round = upstream.allocations;
+    assert(after_first_round > 0);
+    assert(after_first_round < 100);
+    for (void* p : blocks)
+      r.deallocate(p, 24, 8);
+    for (int i = 0; i < 1000; ++i)
+      blocks[i] = r.allocate(24, 8);
+    assert(upstream.allocations == after_first_round);
+    assert(upstream.deallocations == 0);
+
+    // Every size and alignment combination gets suitably aligned memory.
+    for (std::size_t align = 1; align <= 64; align *= 2) {
+      for (std::size_t size = 1; size < 5000; size = size * 3 + 1) {
+        char* p = static_cast<char*>(r.allocate(size, align));
+        assert(is_aligned(p, align));
+        for (std::size_t i = 0; i < size; ++i)
+          p[i] = static_cast<char>(i);
+        r.deallocate(p, size, align);
+      }
+    }
+
+    // Large requests go directly upstream and are returned immediately.
+    std::size_t large = r.options().largest_required_pool_block * 2;
+    int before = upstream.deallocations;
+    void* p = r.allocate(large);
+    r.deallocate(p, large);
+    assert(upstream.deallocations == before + 1);
+
+    r.release();
+    assert(upstream.outstanding_bytes == 0);
+
+    // The resource remains usable after release().
+    p = r.allocate(24, 8);
+    r.deallocate(p, 24, 8);
+  }
+  {
+    CountingResource upstream;
+    {
+      std::pmr::unsynchronized_pool_resource r(&upstream);
+      (void)r.allocate(10);
+      (void)r.allocate(10000000);
+    }
+    // The destructor releases everything.
+    assert(upstream.outstanding_bytes == 0);
+  }
+  {
+    std::pmr::unsynchronized_pool_resource r(std::pmr::null_memory_resource());
+    assert(r.upstream_resource() == std::pmr::null_memory_resource());
+#ifndef TEST_HAS_NO_EXCEPTIONS
+    try {
+      (void)r.allocate(8);
+      assert(false);
+    } catch (const std::bad_alloc&) {
+    }
+#endif
+  }
+
+  return 0;
+}
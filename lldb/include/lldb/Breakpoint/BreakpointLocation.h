@@ -13,6 +13,7 @@
 #include <mutex>
 
 #include "lldb/Breakpoint/BreakpointOptions.h"
+#include "lldb/Breakpoint/CompiledBreakpointCondition.h"
 #include "lldb/Breakpoint/StoppointHitCounter.h"
 #include "lldb/Core/Address.h"
 #include "lldb/Utility/UserID.h"
@@ -348,6 +349,12 @@ private:
                                        ///shared by more than one location.)
   lldb::UserExpressionSP m_user_expression_sp; ///< The compiled expression to
                                                ///use in testing our condition.
+  llvm::Optional<CompiledBreakpointCondition>
+      m_compiled_condition; ///< The condition compiled for evaluating it
+                            /// without the expression parser, if it is simple
+                            /// enough.
+  size_t m_compiled_condition_hash =
+      0; ///< The hash of the condition m_compiled_condition was compiled from.
   std::mutex m_condition_mutex; ///< Guards parsing and evaluation of the
                                 ///condition, which could be evaluated by
                                 /// multiple processes.
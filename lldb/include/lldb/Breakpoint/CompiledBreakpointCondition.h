@@ -0,0 +1,141 @@
+//===-- CompiledBreakpointCondition.h ---------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_BREAKPOINT_COMPILEDBREAKPOINTCONDITION_H
+#define LLDB_BREAKPOINT_COMPILEDBREAKPOINTCONDITION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lldb/Utility/Scalar.h"
+#include "lldb/lldb-forward.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace lldb_private {
+
+/// \class CompiledBreakpointCondition CompiledBreakpointCondition.h
+/// "lldb/Breakpoint/CompiledBreakpointCondition.h" A breakpoint condition
+/// compiled into a small stack machine program.
+///
+/// Evaluating a condition with the expression parser materializes its
+/// variables and either interprets its IR or runs it in the inferior, which
+/// makes conditions on frequently hit breakpoints very slow. Most conditions
+/// only compare variables and registers with constants though, so those are
+/// compiled once into a program that reads the operands straight from the
+/// frame each time the breakpoint is hit. The program is kept by the
+/// breakpoint location and runs in the debugger: the process still stops at
+/// every hit, only the cost of the expression parser is saved.
+///
+/// The conditions that can be compiled use the C operators, except the
+/// assignments, increments and the conditional operator, on integer and
+/// character constants, "true", "false", "nullptr", registers such as "$rax",
+/// and variable expression paths such as "a->b.c[2]", as understood by
+/// "frame variable". Any other condition is rejected by Compile() and has to
+/// be evaluated by the expression parser.
+///
+/// Operands are read as plain numbers, which only gives pointers their C
+/// meaning when they are compared or tested. Pointer arithmetic, which
+/// depends on the pointee type, is left to the expression parser.
+class CompiledBreakpointCondition {
+public:
+  /// The value of an operand, and whether the operand is a pointer, in which
+  /// case \a value is the address it holds.
+  struct OperandValue {
+    OperandValue(Scalar value, bool is_pointer = false)
+        : value(std::move(value)), is_pointer(is_pointer) {}
+
+    Scalar value;
+    bool is_pointer;
+  };
+
+  /// Reads the value of an operand of the condition, either a variable
+  /// expression path, or a register name starting with '$'.
+  ///
+  /// \return
+  ///     The value of the operand, or llvm::None if it could not be read.
+  typedef llvm::function_ref<llvm::Optional<OperandValue>(
+      llvm::StringRef operand)>
+      OperandReader;
+
+  /// Compile \a condition.
+  ///
+  /// \return
+  ///     The compiled condition, or llvm::None if \a condition is not in the
+  ///     subset of the language that can be compiled.
+  static llvm::Optional<CompiledBreakpointCondition>
+  Compile(llvm::StringRef condition);
+
+  /// Evaluate the condition, reading its operands with \a reader.
+  ///
+  /// \return
+  ///     Whether the condition is true, or llvm::None if an operand could not
+  ///     be read, a pointer operand is used in arithmetic, or the result is
+  ///     undefined, like when dividing by zero. The condition should then be
+  ///     evaluated with the expression parser.
+  llvm::Optional<bool> Evaluate(OperandReader reader) const;
+
+  /// Evaluate the condition in the selected frame of \a exe_ctx.
+  llvm::Optional<bool> Evaluate(ExecutionContext &exe_ctx) const;
+
+  /// The variable expression paths and registers the condition reads.
+  const std::vector<std::string> &GetOperands() const { return m_operands; }
+
+  enum Opcode : uint8_t {
+    ePushConstant, ///< Push m_constants[arg].
+    ePushOperand,  ///< Push the value of m_operands[arg].
+    eNegate,
+    eBitNot,
+    eLogicalNot,
+    eMul,
+    eDiv,
+    eRem,
+    eAdd,
+    eSub,
+    eShl,
+    eShr,
+    eLT,
+    eLE,
+    eGT,
+    eGE,
+    eEQ,
+    eNE,
+    eBitAnd,
+    eBitXor,
+    eBitOr,
+    /// Pop a value. If it is false, push 0 and jump to arg.
+    eAndThen,
+    /// Pop a value. If it is true, push 1 and jump to arg.
+    eOrElse,
+    /// Replace the top of the stack by 1 if it is true and 0 otherwise.
+    eToBool,
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    uint32_t arg;
+  };
+
+private:
+  friend class CompiledBreakpointConditionParser;
+
+  CompiledBreakpointCondition() = default;
+
+  std::vector<Instruction> m_code;
+  std::vector<Scalar> m_constants;
+  std::vector<std::string> m_operands;
+  /// Whether each operand is used as a number, by an arithmetic or bitwise
+  /// operator, rather than only compared or tested.
+  std::vector<bool> m_arithmetic_operands;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_BREAKPOINT_COMPILEDBREAKPOINTCONDITION_H
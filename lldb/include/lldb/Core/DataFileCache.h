@@ -0,0 +1,133 @@
+//===-- DataFileCache.h -----------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_CORE_DATAFILECACHE_H
+#define LLDB_CORE_DATAFILECACHE_H
+
+#include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/Status.h"
+#include "lldb/Utility/UUID.h"
+#include "lldb/lldb-forward.h"
+#include "lldb/lldb-types.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace lldb_private {
+
+/// \class DataFileCache DataFileCache.h "lldb/Core/DataFileCache.h"
+/// A directory of files that cache data which is expensive to compute, such
+/// as the name indexes of the symbol tables and of the DWARF.
+///
+/// Each cache entry is a file whose name is derived from a key. The files are
+/// written atomically, so that concurrent debug sessions can share a cache
+/// directory, and are read with mmap when they are large enough. The
+/// directory is pruned with an LLVM cache pruning policy, which limits its
+/// size and removes the entries that were not used for a while.
+class DataFileCache {
+public:
+  /// Create a cache in the directory \a path, which is created if needed and
+  /// then pruned with \a policy.
+  DataFileCache(llvm::StringRef path,
+                llvm::CachePruningPolicy policy = GetLLDBIndexCachePolicy());
+
+  /// Get the pruning policy from the "symbols.lldb-index-cache-*" settings.
+  static llvm::CachePruningPolicy GetLLDBIndexCachePolicy();
+
+  /// Get the cached data for \a key.
+  ///
+  /// \return
+  ///     The contents of the cache file, or nullptr if there is no entry for
+  ///     \a key.
+  std::unique_ptr<llvm::MemoryBuffer> GetCachedData(llvm::StringRef key);
+
+  /// Set the cached data for \a key, replacing any previous entry.
+  ///
+  /// \return
+  ///     True if the entry was written.
+  bool SetCachedData(llvm::StringRef key, llvm::ArrayRef<uint8_t> data);
+
+  /// Remove the cache file for \a key, if any.
+  Status RemoveCacheFile(llvm::StringRef key);
+
+private:
+  FileSpec GetCacheFilePath(llvm::StringRef key);
+
+  FileSpec m_cache_dir;
+};
+
+/// The signature of the object file a cache entry was created from. An entry
+/// is only used if the object file still has the same signature: the same
+/// UUID and modification times.
+struct CacheSignature {
+  UUID m_uuid;
+  llvm::Optional<std::time_t> m_mod_time;
+  llvm::Optional<std::time_t> m_obj_mod_time;
+
+  CacheSignature() = default;
+
+  CacheSignature(ObjectFile *objfile);
+
+  /// Return true if there is enough information to tell when the object file
+  /// changed.
+  bool IsValid() const { return m_uuid.IsValid() || m_mod_time; }
+
+  bool operator==(const CacheSignature &rhs) const {
+    return m_uuid == rhs.m_uuid && m_mod_time == rhs.m_mod_time &&
+           m_obj_mod_time == rhs.m_obj_mod_time;
+  }
+
+  bool operator!=(const CacheSignature &rhs) const { return !(*this == rhs); }
+
+  void Encode(Stream &strm) const;
+
+  bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr);
+};
+
+/// Collects the strings of a cache entry so that each one is encoded once.
+/// The data of the entry then refers to the strings by their index.
+class ConstStringTable {
+public:
+  /// Add \a s to the table if it is not in there yet.
+  ///
+  /// \return
+  ///     The index of \a s in the table.
+  uint32_t Add(ConstString s);
+
+  void Encode(Stream &strm) const;
+
+private:
+  std::vector<ConstString> m_strings;
+  llvm::DenseMap<ConstString, uint32_t> m_string_to_index;
+};
+
+/// Reads the strings encoded by a ConstStringTable. The ConstString for an
+/// index is only created the first time it is needed.
+class StringTableReader {
+public:
+  bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr);
+
+  /// Get the string at \a index, or an empty string if \a index is out of
+  /// range.
+  ConstString Get(uint64_t index);
+
+private:
+  std::vector<llvm::StringRef> m_strs;
+  std::vector<ConstString> m_strings;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_CORE_DATAFILECACHE_H
@@ -48,6 +48,7 @@
 
 namespace llvm {
 class raw_ostream;
+class ThreadPool;
 }
 
 namespace lldb_private {
@@ -135,6 +136,12 @@ public:
 
   static void SettingsTerminate();
 
+  /// Returns the thread pool shared by all debuggers for work that is done
+  /// in parallel, like loading the modules of a process. Only valid between
+  /// Initialize() and Terminate(). Users wait for the futures of their own
+  /// tasks: ThreadPool::wait() would also wait for the tasks of the others.
+  static llvm::ThreadPool &GetThreadPool();
+
   static void Destroy(lldb::DebuggerSP &debugger_sp);
 
   static lldb::DebuggerSP FindDebuggerWithID(lldb::user_id_t id);
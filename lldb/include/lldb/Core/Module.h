@@ -41,6 +41,7 @@
 
 namespace lldb_private {
 class CompilerDeclContext;
+class DataFileCache;
 class Function;
 class Log;
 class ObjectFile;
@@ -511,6 +512,19 @@ public:
   /// \param sysroot will be added to the path remapping dictionary.
   void RegisterXcodeSDK(llvm::StringRef sdk, llvm::StringRef sysroot);
 
+  /// Get the cache where the indexes of the modules are saved between debug
+  /// sessions.
+  ///
+  /// \return
+  ///     The cache, or nullptr if the "symbols.enable-lldb-index-cache"
+  ///     setting is off. A new cache is returned once the
+  ///     "symbols.lldb-index-cache-path" setting changes.
+  static std::shared_ptr<DataFileCache> GetIndexCache();
+
+  /// Get the key of the data named \a kind for \a objfile, which is one of
+  /// the object files of this module, in the index cache.
+  std::string GetCacheKey(ObjectFile *objfile, llvm::StringRef kind);
+
   /// Tells whether this module is capable of being the main executable for a
   /// process.
   ///
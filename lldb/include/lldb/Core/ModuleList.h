@@ -59,6 +59,13 @@ public:
   bool SetClangModulesCachePath(const FileSpec &path);
   bool GetEnableExternalLookup() const;
   bool SetEnableExternalLookup(bool new_value);
+  bool GetEnableLLDBIndexCache() const;
+  bool SetEnableLLDBIndexCache(bool new_value);
+  FileSpec GetLLDBIndexCachePath() const;
+  bool SetLLDBIndexCachePath(const FileSpec &path);
+  uint64_t GetLLDBIndexCacheMaxByteSize() const;
+  uint64_t GetLLDBIndexCacheMaxPercent() const;
+  uint64_t GetLLDBIndexCacheExpirationDays() const;
 
   PathMappingList GetSymlinkMappings() const;
 };
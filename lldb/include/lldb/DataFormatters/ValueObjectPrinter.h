@@ -109,6 +109,12 @@ protected:
 
   uint32_t GetMaxNumChildrenToPrint(bool &print_dotdotdot);
 
+  /// Read the memory that the pointers among \a children point to with a
+  /// single request, if they are going to be expanded.
+  void
+  PrefetchPointees(llvm::ArrayRef<lldb::ValueObjectSP> children,
+                   const DumpValueObjectOptions::PointerDepth &curr_ptr_depth);
+
   void
   PrintChildren(bool value_printed, bool summary_printed,
                 const DumpValueObjectOptions::PointerDepth &curr_ptr_depth);
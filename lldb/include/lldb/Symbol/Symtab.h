@@ -126,13 +126,10 @@ public:
 
   static void DumpSymbolHeader(Stream *s);
 
-  void Finalize() {
-    // Shrink to fit the symbols so we don't waste memory
-    if (m_symbols.capacity() > m_symbols.size()) {
-      collection new_symbols(m_symbols.begin(), m_symbols.end());
-      m_symbols.swap(new_symbols);
-    }
-  }
+  /// Called once all the symbols have been added. The name indexes refer to
+  /// the symbols by index, so they are only loaded from or saved to the index
+  /// cache from then on.
+  void Finalize();
 
   void AppendSymbolNamesToMap(const IndexCollection &indexes,
                               bool add_demangled, bool add_mangled,
@@ -171,6 +168,16 @@ protected:
   void InitNameIndexes();
   void InitAddressIndexes();
 
+  /// Load the name indexes from the index cache.
+  ///
+  /// \return
+  ///     True if the cache had an entry for the symbols of the object file
+  ///     that is still valid.
+  bool LoadFromCache();
+
+  /// Save the name indexes to the index cache.
+  void SaveToCache();
+
   ObjectFile *m_objfile;
   collection m_symbols;
   FileRangeToIndexMap m_file_addr_to_index;
@@ -180,7 +187,8 @@ protected:
       m_name_to_symbol_indices;
   mutable std::recursive_mutex
       m_mutex; // Provide thread safety for this symbol table
-  bool m_file_addr_to_index_computed : 1, m_name_indexes_computed : 1;
+  bool m_file_addr_to_index_computed : 1, m_name_indexes_computed : 1,
+      m_finalized : 1;
 
 private:
   UniqueCStringMap<uint32_t> &
@@ -11,6 +11,7 @@
 
 #include "lldb/Utility/RangeMap.h"
 #include "lldb/lldb-private.h"
+#include "llvm/ADT/ArrayRef.h"
 #include <map>
 #include <mutex>
 #include <vector>
@@ -20,6 +21,8 @@ namespace lldb_private {
 // runs.
 class MemoryCache {
 public:
+  typedef Range<lldb::addr_t, lldb::addr_t> AddrRange;
+
   // Constructors and Destructors
   MemoryCache(Process &process);
 
@@ -31,6 +34,10 @@ public:
 
   size_t Read(lldb::addr_t addr, void *dst, size_t dst_len, Status &error);
 
+  // Read the cache lines covering \a ranges that are not cached yet with a
+  // single request to the process, and add them to the L2 cache.
+  void Prefetch(llvm::ArrayRef<AddrRange> ranges);
+
   uint32_t GetMemoryCacheLineSize() const { return m_L2_cache_line_byte_size; }
 
   void AddInvalidRange(lldb::addr_t base_addr, lldb::addr_t byte_size);
@@ -46,7 +53,6 @@ public:
 protected:
   typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
   typedef RangeVector<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
-  typedef Range<lldb::addr_t, lldb::addr_t> AddrRange;
   // Classes that inherit from MemoryCache can see and modify these
   std::recursive_mutex m_mutex;
   BlockMap m_L1_cache; // A first level memory cache whose chunk sizes vary that
@@ -1467,6 +1467,27 @@ public:
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Status &error);
 
+  /// Read several ranges of memory from the inferior at once, bypassing
+  /// caching.
+  ///
+  /// \param[in] ranges
+  ///     The ranges to read.
+  ///
+  /// \param[out] buffer
+  ///     A buffer that receives the bytes of each range back to back. It must
+  ///     be at least as large as the sum of the sizes of \a ranges.
+  ///
+  /// \return
+  ///     The number of bytes that were actually read from each range.
+  std::vector<size_t>
+  ReadMemoryRangesFromInferior(llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+                               llvm::MutableArrayRef<uint8_t> buffer);
+
+  /// Read the memory \a ranges into the memory cache, if the process can
+  /// read them all with a single request, so that reading them later does
+  /// not need a round trip to the inferior each.
+  void PrefetchMemory(llvm::ArrayRef<MemoryCache::AddrRange> ranges);
+
   /// Read a NULL terminated string from memory
   ///
   /// This function will read a cache page at a time until a NULL string
@@ -2624,6 +2645,19 @@ protected:
   virtual size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
                               Status &error) = 0;
 
+  /// Whether DoReadMemoryRanges() reads several ranges with fewer requests
+  /// than calling DoReadMemory() for each of them.
+  virtual bool SupportsReadMemoryRanges() { return false; }
+
+  /// Actually do the reading of several ranges of memory from a process.
+  ///
+  /// The default implementation reads each range with DoReadMemory().
+  ///
+  /// \see ReadMemoryRangesFromInferior()
+  virtual std::vector<size_t>
+  DoReadMemoryRanges(llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+                     llvm::MutableArrayRef<uint8_t> buffer);
+
   void SetState(lldb::EventSP &event_sp);
 
   lldb::StateType GetPrivateState();
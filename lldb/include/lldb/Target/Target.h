@@ -94,6 +94,10 @@ public:
 
   void SetPreloadSymbols(bool b);
 
+  bool GetParallelModuleLoad() const;
+
+  void SetParallelModuleLoad(bool b);
+
   bool GetDisableASLR() const;
 
   void SetDisableASLR(bool b);
@@ -173,6 +177,8 @@ public:
 
   bool GetBreakpointsConsultPlatformAvoidList();
 
+  bool GetBreakpointsCompileConditions() const;
+
   lldb::LanguageType GetLanguage() const;
 
   llvm::StringRef GetExpressionPrefixContents();
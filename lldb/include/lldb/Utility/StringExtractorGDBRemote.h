@@ -148,6 +148,7 @@ public:
     eServerPacketType_k,
     eServerPacketType_m,
     eServerPacketType_M,
+    eServerPacketType_MultiMemRead,
     eServerPacketType_p,
     eServerPacketType_P,
     eServerPacketType_s,
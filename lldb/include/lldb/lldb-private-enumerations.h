@@ -213,7 +213,8 @@ enum StatisticKind {
   ExpressionFailure = 1,
   FrameVarSuccess = 2,
   FrameVarFailure = 3,
-  StatisticMax = 4
+  CoreFilePagesTouched = 4,
+  StatisticMax = 5
 };
 
 
@@ -227,6 +228,8 @@ inline std::string GetStatDescription(lldb_private::StatisticKind K) {
      return "Number of frame var successes";
    case StatisticKind::FrameVarFailure:
      return "Number of frame var failures";
+   case StatisticKind::CoreFilePagesTouched:
+     return "Number of core file pages read";
    case StatisticKind::StatisticMax:
      return "";
    }
@@ -18,6 +18,7 @@
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/TypeSystem.h"
+#include "lldb/Target/Language.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
@@ -243,22 +244,53 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
 
   if (!condition_text) {
     m_user_expression_sp.reset();
+    m_compiled_condition.reset();
     return false;
   }
 
   error.Clear();
 
+  LanguageType language = eLanguageTypeUnknown;
+  // See if we can figure out the language from the frame, otherwise use the
+  // default language:
+  CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
+  if (comp_unit)
+    language = comp_unit->GetLanguage();
+
+  // Simple conditions are compiled once and then evaluated by reading their
+  // operands from the frame, which is much faster than running them through
+  // the expression parser on every hit. They have the semantics of C, so they
+  // are only used for the C family of languages.
+  if (GetTarget().GetBreakpointsCompileConditions() &&
+      (language == eLanguageTypeUnknown ||
+       Language::LanguageIsCFamily(language))) {
+    if (condition_hash != m_compiled_condition_hash) {
+      m_compiled_condition =
+          CompiledBreakpointCondition::Compile(condition_text);
+      m_compiled_condition_hash = condition_hash;
+      if (!m_compiled_condition)
+        LLDB_LOGF(log, "Condition is not simple enough to be compiled: %s.",
+                  condition_text);
+    }
+    if (m_compiled_condition) {
+      if (llvm::Optional<bool> result =
+              m_compiled_condition->Evaluate(exe_ctx)) {
+        LLDB_LOGF(log, "Compiled condition evaluated, result is %s.",
+                  *result ? "true" : "false");
+        return *result;
+      }
+      // Something the condition reads is not a plain number in this frame, so
+      // leave this condition to the expression parser from now on.
+      LLDB_LOGF(log, "Couldn't evaluate the compiled condition, falling back "
+                     "to the expression parser.");
+      m_compiled_condition.reset();
+    }
+  }
+
   DiagnosticManager diagnostics;
 
   if (condition_hash != m_condition_hash || !m_user_expression_sp ||
       !m_user_expression_sp->MatchesContext(exe_ctx)) {
-    LanguageType language = eLanguageTypeUnknown;
-    // See if we can figure out the language from the frame, otherwise use the
-    // default language:
-    CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
-    if (comp_unit)
-      language = comp_unit->GetLanguage();
-
     m_user_expression_sp.reset(GetTarget().GetUserExpressionForLanguage(
         condition_text, llvm::StringRef(), language, Expression::eResultTypeAny,
         EvaluateExpressionOptions(), nullptr, error));
@@ -665,4 +697,6 @@ void BreakpointLocation::SwapLocation(BreakpointLocationSP swap_from) {
   m_is_reexported = swap_from->m_is_reexported;
   m_is_indirect = swap_from->m_is_indirect;
   m_user_expression_sp.reset();
+  m_compiled_condition.reset();
+  m_compiled_condition_hash = 0;
 }
@@ -0,0 +1,574 @@
+//===-- CompiledBreakpointCondition.cpp -----------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Breakpoint/CompiledBreakpointCondition.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Utility/RegisterValue.h"
+#include "lldb/Utility/Status.h"
+#include "llvm/ADT/APSInt.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringSwitch.h"
+
+#include <cassert>
+#include <cctype>
+#include <cstdint>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace lldb_private {
+
+/// Compiles a condition with a recursive descent parser, which emits the code
+/// of each operator after the code of its operands.
+class CompiledBreakpointConditionParser {
+public:
+  CompiledBreakpointConditionParser(llvm::StringRef text,
+                                    CompiledBreakpointCondition &condition)
+      : m_text(text), m_condition(condition) {}
+
+  bool Parse() {
+    if (!ParseBinary(0))
+      return false;
+    SkipSpaces();
+    return m_text.empty();
+  }
+
+private:
+  typedef CompiledBreakpointCondition::Opcode Opcode;
+
+  struct BinaryOperator {
+    llvm::StringRef spelling;
+    Opcode opcode;
+    int precedence;
+  };
+
+  void SkipSpaces() { m_text = m_text.ltrim(); }
+
+  bool Consume(llvm::StringRef token) {
+    SkipSpaces();
+    return m_text.consume_front(token);
+  }
+
+  size_t Emit(Opcode opcode, uint32_t arg = 0) {
+    m_condition.m_code.push_back({opcode, arg});
+    return m_condition.m_code.size() - 1;
+  }
+
+  void EmitConstant(Scalar value) {
+    Emit(CompiledBreakpointCondition::ePushConstant,
+         m_condition.m_constants.size());
+    m_condition.m_constants.push_back(std::move(value));
+  }
+
+  void EmitOperand(std::string operand) {
+    auto &operands = m_condition.m_operands;
+    auto pos = llvm::find(operands, operand);
+    Emit(CompiledBreakpointCondition::ePushOperand, pos - operands.begin());
+    if (pos == operands.end())
+      operands.push_back(std::move(operand));
+  }
+
+  /// Return the binary operator at the start of the text, if any. The longer
+  /// operators come first so that "<<" is not taken for "<".
+  llvm::Optional<BinaryOperator> PeekBinaryOperator() {
+    static const BinaryOperator g_operators[] = {
+        {"||", CompiledBreakpointCondition::eOrElse, 1},
+        {"&&", CompiledBreakpointCondition::eAndThen, 2},
+        {"==", CompiledBreakpointCondition::eEQ, 6},
+        {"!=", CompiledBreakpointCondition::eNE, 6},
+        {"<=", CompiledBreakpointCondition::eLE, 7},
+        {">=", CompiledBreakpointCondition::eGE, 7},
+        {"<<", CompiledBreakpointCondition::eShl, 8},
+        {">>", CompiledBreakpointCondition::eShr, 8},
+        {"|", CompiledBreakpointCondition::eBitOr, 3},
+        {"^", CompiledBreakpointCondition::eBitXor, 4},
+        {"&", CompiledBreakpointCondition::eBitAnd, 5},
+        {"<", CompiledBreakpointCondition::eLT, 7},
+        {">", CompiledBreakpointCondition::eGT, 7},
+        {"+", CompiledBreakpointCondition::eAdd, 9},
+        {"-", CompiledBreakpointCondition::eSub, 9},
+        {"*", CompiledBreakpointCondition::eMul, 10},
+        {"/", CompiledBreakpointCondition::eDiv, 10},
+        {"%", CompiledBreakpointCondition::eRem, 10},
+    };
+    SkipSpaces();
+    for (const BinaryOperator &op : g_operators) {
+      if (!m_text.startswith(op.spelling))
+        continue;
+      // Reject the assignment operators, such as "<<=" or "+=", but not the
+      // comparisons that end with '='.
+      llvm::StringRef rest = m_text.drop_front(op.spelling.size());
+      if (rest.startswith("=") && !op.spelling.endswith("="))
+        return llvm::None;
+      return op;
+    }
+    return llvm::None;
+  }
+
+  bool ParseBinary(int min_precedence) {
+    if (!ParseUnary())
+      return false;
+    while (llvm::Optional<BinaryOperator> op = PeekBinaryOperator()) {
+      if (op->precedence < min_precedence)
+        break;
+      m_text = m_text.drop_front(op->spelling.size());
+      if (op->opcode == CompiledBreakpointCondition::eAndThen ||
+          op->opcode == CompiledBreakpointCondition::eOrElse) {
+        const size_t jump = Emit(op->opcode);
+        if (!ParseBinary(op->precedence + 1))
+          return false;
+        Emit(CompiledBreakpointCondition::eToBool);
+        m_condition.m_code[jump].arg = m_condition.m_code.size();
+      } else {
+        if (!ParseBinary(op->precedence + 1))
+          return false;
+        Emit(op->opcode);
+      }
+    }
+    return true;
+  }
+
+  bool ParseUnary() {
+    SkipSpaces();
+    // "++", "--", and the dereference and address-of operators are not
+    // supported.
+    if (m_text.startswith("++") || m_text.startswith("--"))
+      return false;
+    if (Consume("!"))
+      return ParseUnaryOperand(CompiledBreakpointCondition::eLogicalNot);
+    if (Consume("~"))
+      return ParseUnaryOperand(CompiledBreakpointCondition::eBitNot);
+    if (Consume("-"))
+      return ParseUnaryOperand(CompiledBreakpointCondition::eNegate);
+    if (Consume("+"))
+      return ParseUnary();
+    return ParsePrimary();
+  }
+
+  bool ParseUnaryOperand(Opcode opcode) {
+    if (!ParseUnary())
+      return false;
+    Emit(opcode);
+    return true;
+  }
+
+  bool ParsePrimary() {
+    SkipSpaces();
+    if (m_text.empty())
+      return false;
+    if (Consume("("))
+      return ParseBinary(0) && Consume(")");
+    const char c = m_text.front();
+    if (isdigit(c))
+      return ParseNumber();
+    if (c == '\'')
+      return ParseCharacter();
+    if (c == '$') {
+      m_text = m_text.drop_front();
+      llvm::StringRef name = ParseIdentifier();
+      if (name.empty())
+        return false;
+      EmitOperand(("$" + name).str());
+      return true;
+    }
+    return ParseVariablePath();
+  }
+
+  llvm::StringRef ParseIdentifier() {
+    SkipSpaces();
+    size_t length = 0;
+    if (!m_text.empty() && (isalpha(m_text[0]) || m_text[0] == '_'))
+      length = m_text.find_if_not(
+          [](char c) { return isalnum(c) || c == '_'; });
+    llvm::StringRef identifier = m_text.take_front(length);
+    m_text = m_text.drop_front(identifier.size());
+    return identifier;
+  }
+
+  bool ParseVariablePath() {
+    llvm::StringRef name = ParseIdentifier();
+    if (name.empty())
+      return false;
+    // Keywords that could start a cast, a call or a type are not variables.
+    const bool is_keyword = llvm::StringSwitch<bool>(name)
+                                .Cases("sizeof", "alignof", "new", "delete",
+                                       true)
+                                .Cases("static_cast", "dynamic_cast",
+                                       "reinterpret_cast", "const_cast", true)
+                                .Cases("const", "volatile", "struct", "class",
+                                       "union", "enum", true)
+                                .Default(false);
+    if (is_keyword)
+      return false;
+    if (name == "true" || name == "false" || name == "nullptr") {
+      EmitConstant(Scalar(name == "true" ? 1 : 0));
+      return true;
+    }
+
+    std::string path = name.str();
+    while (true) {
+      SkipSpaces();
+      if (m_text.startswith("->") || m_text.startswith(".")) {
+        llvm::StringRef separator = m_text.startswith("->") ? "->" : ".";
+        m_text = m_text.drop_front(separator.size());
+        llvm::StringRef member = ParseIdentifier();
+        if (member.empty())
+          return false;
+        path += separator.str() + member.str();
+      } else if (Consume("[")) {
+        SkipSpaces();
+        size_t length = m_text.find_if_not([](char c) { return isdigit(c); });
+        if (length == 0 || length == llvm::StringRef::npos)
+          return false;
+        path += "[" + m_text.take_front(length).str() + "]";
+        m_text = m_text.drop_front(length);
+        if (!Consume("]"))
+          return false;
+      } else {
+        break;
+      }
+    }
+    // Function calls and scoped names are left to the expression parser.
+    SkipSpaces();
+    if (m_text.startswith("(") || m_text.startswith("::"))
+      return false;
+    EmitOperand(std::move(path));
+    return true;
+  }
+
+  /// Parse an integer literal, and give it the type it has in C.
+  bool ParseNumber() {
+    size_t length = m_text.find_if_not([](char c) { return isalnum(c); });
+    llvm::StringRef literal = m_text.take_front(length);
+    m_text = m_text.drop_front(literal.size());
+
+    bool is_unsigned = false;
+    bool is_long = false;
+    while (!literal.empty() &&
+           llvm::StringRef("uUlL").contains(literal.back())) {
+      if (tolower(literal.back()) == 'u')
+        is_unsigned = true;
+      else
+        is_long = true;
+      literal = literal.drop_back();
+    }
+    // Floating point constants are not supported.
+    if (m_text.startswith("."))
+      return false;
+    uint64_t value;
+    if (literal.getAsInteger(0, value))
+      return false;
+    const bool is_decimal = literal.size() == 1 || literal[0] != '0';
+
+    // Octal and hexadecimal constants can have an unsigned type even without
+    // a suffix, decimal ones can not.
+    for (unsigned bits : {32u, 64u}) {
+      if (bits == 32 && is_long)
+        continue;
+      if (!is_unsigned &&
+          value <= uint64_t(bits == 32 ? INT32_MAX : INT64_MAX)) {
+        EmitConstant(Scalar(llvm::APSInt(llvm::APInt(bits, value), false)));
+        return true;
+      }
+      if ((is_unsigned || !is_decimal || bits == 64) &&
+          (bits == 64 || value <= UINT32_MAX)) {
+        EmitConstant(Scalar(llvm::APSInt(llvm::APInt(bits, value), true)));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ParseCharacter() {
+    m_text = m_text.drop_front();
+    if (m_text.size() < 2)
+      return false;
+    char value = m_text[0];
+    m_text = m_text.drop_front();
+    if (value == '\\') {
+      switch (m_text[0]) {
+      case 'n':
+        value = '\n';
+        break;
+      case 't':
+        value = '\t';
+        break;
+      case 'r':
+        value = '\r';
+        break;
+      case '0':
+        value = '\0';
+        break;
+      case '\\':
+      case '\'':
+      case '"':
+        value = m_text[0];
+        break;
+      default:
+        return false;
+      }
+      m_text = m_text.drop_front();
+    }
+    if (!m_text.consume_front("'"))
+      return false;
+    EmitConstant(Scalar(int(value)));
+    return true;
+  }
+
+  llvm::StringRef m_text;
+  CompiledBreakpointCondition &m_condition;
+};
+
+} // namespace lldb_private
+
+/// Find the operands whose value is used by an arithmetic or bitwise operator,
+/// by following the operand each value on the stack comes from, if any.
+static std::vector<bool> FindArithmeticOperands(
+    llvm::ArrayRef<CompiledBreakpointCondition::Instruction> code,
+    size_t num_operands) {
+  std::vector<bool> arithmetic(num_operands, false);
+  llvm::SmallVector<llvm::Optional<uint32_t>, 8> stack;
+  auto pop = [&](bool is_arithmetic) {
+    llvm::Optional<uint32_t> operand = stack.pop_back_val();
+    if (is_arithmetic && operand)
+      arithmetic[*operand] = true;
+  };
+
+  for (const CompiledBreakpointCondition::Instruction &inst : code) {
+    switch (inst.opcode) {
+    case CompiledBreakpointCondition::ePushConstant:
+      stack.push_back(llvm::None);
+      break;
+    case CompiledBreakpointCondition::ePushOperand:
+      stack.push_back(inst.arg);
+      break;
+    case CompiledBreakpointCondition::eAndThen:
+    case CompiledBreakpointCondition::eOrElse:
+      // Either the right side or the constant pushed by the jump replaces
+      // the tested value.
+      pop(false);
+      break;
+    case CompiledBreakpointCondition::eLogicalNot:
+    case CompiledBreakpointCondition::eToBool:
+      pop(false);
+      stack.push_back(llvm::None);
+      break;
+    case CompiledBreakpointCondition::eNegate:
+    case CompiledBreakpointCondition::eBitNot:
+      pop(true);
+      stack.push_back(llvm::None);
+      break;
+    case CompiledBreakpointCondition::eLT:
+    case CompiledBreakpointCondition::eLE:
+    case CompiledBreakpointCondition::eGT:
+    case CompiledBreakpointCondition::eGE:
+    case CompiledBreakpointCondition::eEQ:
+    case CompiledBreakpointCondition::eNE:
+      pop(false);
+      pop(false);
+      stack.push_back(llvm::None);
+      break;
+    default:
+      pop(true);
+      pop(true);
+      stack.push_back(llvm::None);
+      break;
+    }
+  }
+  return arithmetic;
+}
+
+llvm::Optional<CompiledBreakpointCondition>
+CompiledBreakpointCondition::Compile(llvm::StringRef condition) {
+  CompiledBreakpointCondition compiled;
+  CompiledBreakpointConditionParser parser(condition, compiled);
+  if (!parser.Parse())
+    return llvm::None;
+  compiled.m_arithmetic_operands =
+      FindArithmeticOperands(compiled.m_code, compiled.m_operands.size());
+  return compiled;
+}
+
+/// Apply the integral promotions of C to \a value, so that arithmetic on
+/// small integer types does not wrap around.
+static void PromoteToInt(Scalar &value) {
+  if (value.GetType() == Scalar::e_int && value.GetByteSize() < 4)
+    value.IntegralPromote(32, true);
+}
+
+llvm::Optional<bool>
+CompiledBreakpointCondition::Evaluate(OperandReader reader) const {
+  // Operands are read at most once per evaluation.
+  llvm::SmallVector<llvm::Optional<OperandValue>, 4> operands(
+      m_operands.size());
+  llvm::SmallVector<Scalar, 8> stack;
+
+  for (size_t pc = 0; pc < m_code.size();) {
+    const Instruction &inst = m_code[pc++];
+    switch (inst.opcode) {
+    case ePushConstant:
+      stack.push_back(m_constants[inst.arg]);
+      continue;
+    case ePushOperand: {
+      llvm::Optional<OperandValue> &value = operands[inst.arg];
+      if (!value) {
+        value = reader(m_operands[inst.arg]);
+        if (!value || !value->value.IsValid())
+          return llvm::None;
+        // Pointer arithmetic is scaled by the size of the pointee, which is
+        // not known here.
+        if (value->is_pointer && m_arithmetic_operands[inst.arg])
+          return llvm::None;
+        PromoteToInt(value->value);
+      }
+      stack.push_back(value->value);
+      continue;
+    }
+    case eNegate:
+      if (!stack.back().UnaryNegate())
+        return llvm::None;
+      continue;
+    case eBitNot:
+      if (!stack.back().OnesComplement())
+        return llvm::None;
+      continue;
+    case eLogicalNot:
+      stack.back() = Scalar(stack.back().IsZero() ? 1 : 0);
+      continue;
+    case eToBool:
+      stack.back() = Scalar(stack.back().IsZero() ? 0 : 1);
+      continue;
+    case eAndThen:
+    case eOrElse: {
+      const bool value = !stack.pop_back_val().IsZero();
+      if (value == (inst.opcode == eOrElse)) {
+        stack.push_back(Scalar(value ? 1 : 0));
+        pc = inst.arg;
+      }
+      continue;
+    }
+    default:
+      break;
+    }
+
+    // Everything else is a binary operator.
+    const Scalar rhs = stack.pop_back_val();
+    Scalar &lhs = stack.back();
+    switch (inst.opcode) {
+    case eMul:
+      lhs = lhs * rhs;
+      break;
+    case eDiv:
+      lhs = lhs / rhs;
+      break;
+    case eRem:
+      lhs = lhs % rhs;
+      break;
+    case eAdd:
+      lhs = lhs + rhs;
+      break;
+    case eSub:
+      lhs = lhs - rhs;
+      break;
+    case eShl:
+    case eShr:
+      // Shifting by a negative amount or by the width of the type is
+      // undefined.
+      if (rhs.GetType() != Scalar::e_int || rhs < Scalar(0) ||
+          rhs >= Scalar(uint64_t(lhs.GetByteSize() * 8)))
+        return llvm::None;
+      if (inst.opcode == eShl)
+        lhs <<= rhs;
+      else
+        lhs >>= rhs;
+      break;
+    case eLT:
+      lhs = Scalar(lhs < rhs ? 1 : 0);
+      break;
+    case eLE:
+      lhs = Scalar(lhs <= rhs ? 1 : 0);
+      break;
+    case eGT:
+      lhs = Scalar(lhs > rhs ? 1 : 0);
+      break;
+    case eGE:
+      lhs = Scalar(lhs >= rhs ? 1 : 0);
+      break;
+    case eEQ:
+      lhs = Scalar(lhs == rhs ? 1 : 0);
+      break;
+    case eNE:
+      lhs = Scalar(lhs != rhs ? 1 : 0);
+      break;
+    case eBitAnd:
+      lhs = lhs & rhs;
+      break;
+    case eBitXor:
+      lhs = lhs ^ rhs;
+      break;
+    case eBitOr:
+      lhs = lhs | rhs;
+      break;
+    default:
+      llvm_unreachable("unhandled opcode");
+    }
+    if (!lhs.IsValid())
+      return llvm::None;
+  }
+
+  assert(stack.size() == 1 && "unbalanced condition code");
+  return !stack.back().IsZero();
+}
+
+llvm::Optional<bool>
+CompiledBreakpointCondition::Evaluate(ExecutionContext &exe_ctx) const {
+  StackFrame *frame = exe_ctx.GetFramePtr();
+  if (!frame)
+    return llvm::None;
+
+  return Evaluate([frame](
+                      llvm::StringRef operand) -> llvm::Optional<OperandValue> {
+    Scalar value;
+    if (operand.consume_front("$")) {
+      RegisterContextSP reg_ctx_sp = frame->GetRegisterContext();
+      if (!reg_ctx_sp)
+        return llvm::None;
+      const RegisterInfo *reg_info = reg_ctx_sp->GetRegisterInfoByName(operand);
+      RegisterValue reg_value;
+      if (!reg_info || !reg_ctx_sp->ReadRegister(reg_info, reg_value) ||
+          !reg_value.GetScalarValue(value))
+        return llvm::None;
+      return OperandValue(value);
+    }
+
+    VariableSP var_sp;
+    Status error;
+    const uint32_t options =
+        StackFrame::eExpressionPathOptionCheckPtrVsMember |
+        StackFrame::eExpressionPathOptionsNoSyntheticChildren |
+        StackFrame::eExpressionPathOptionsNoSyntheticArrayRange;
+    ValueObjectSP valobj_sp = frame->GetValueForVariableExpressionPath(
+        operand, eNoDynamicValues, options, var_sp, error);
+    if (!valobj_sp || error.Fail())
+      return llvm::None;
+    // Only the types whose value is a number compare like in C. The value of
+    // a reference, for example, is the address it refers to.
+    const uint32_t type_info = valobj_sp->GetCompilerType().GetTypeInfo();
+    if (!(type_info & (eTypeIsScalar | eTypeIsPointer | eTypeIsEnumeration)) ||
+        (type_info & (eTypeIsReference | eTypeIsComplex | eTypeIsVector)))
+      return llvm::None;
+    if (!valobj_sp->ResolveValue(value))
+      return llvm::None;
+    return OperandValue(value, type_info & eTypeIsPointer);
+  });
+}
@@ -0,0 +1,231 @@
+//===-- DataFileCache.cpp -------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/DataFileCache.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+#include "lldb/Utility/Stream.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+DataFileCache::DataFileCache(llvm::StringRef path,
+                             llvm::CachePruningPolicy policy) {
+  m_cache_dir.SetPath(path);
+  if (std::error_code ec = llvm::sys::fs::create_directories(path)) {
+    LLDB_LOG(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES),
+             "failed to create the cache directory {0}: {1}", path,
+             ec.message());
+    m_cache_dir.Clear();
+    return;
+  }
+  llvm::pruneCache(path, policy);
+}
+
+llvm::CachePruningPolicy DataFileCache::GetLLDBIndexCachePolicy() {
+  ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  llvm::CachePruningPolicy policy;
+  policy.MaxSizeBytes = properties.GetLLDBIndexCacheMaxByteSize();
+  policy.MaxSizePercentageOfAvailableSpace =
+      properties.GetLLDBIndexCacheMaxPercent();
+  policy.Expiration =
+      std::chrono::hours(properties.GetLLDBIndexCacheExpirationDays() * 24);
+  return policy;
+}
+
+FileSpec DataFileCache::GetCacheFilePath(llvm::StringRef key) {
+  if (!m_cache_dir)
+    return FileSpec();
+  // The LLVM cache pruning only considers the files with this prefix.
+  FileSpec cache_file(m_cache_dir);
+  cache_file.AppendPathComponent(("llvmcache-" + key).str());
+  return cache_file;
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+DataFileCache::GetCachedData(llvm::StringRef key) {
+  FileSpec cache_file = GetCacheFilePath(key);
+  if (!cache_file)
+    return nullptr;
+  const std::string path = cache_file.GetPath();
+  int fd;
+  if (llvm::sys::fs::openFileForRead(path, fd))
+    return nullptr;
+  // Mark the entry as used so that it does not expire, even on file systems
+  // that do not update the access times.
+  llvm::sys::fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now());
+  // Without a null terminator, the file is mapped whenever it is larger than
+  // a page, and only the parts that are decoded are read from the disk.
+  llvm::sys::fs::file_t file = llvm::sys::fs::convertFDToNativeFile(fd);
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer_or_error =
+      llvm::MemoryBuffer::getOpenFile(file, path, /*FileSize=*/-1,
+                                      /*RequiresNullTerminator=*/false);
+  llvm::sys::fs::closeFile(file);
+  if (!buffer_or_error)
+    return nullptr;
+  return std::move(*buffer_or_error);
+}
+
+bool DataFileCache::SetCachedData(llvm::StringRef key,
+                                  llvm::ArrayRef<uint8_t> data) {
+  FileSpec cache_file = GetCacheFilePath(key);
+  if (!cache_file)
+    return false;
+  Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES);
+  const std::string path = cache_file.GetPath();
+  // Write a temporary file and rename it over the entry, so that the other
+  // debug sessions sharing the cache never see a partial entry.
+  llvm::Expected<llvm::sys::fs::TempFile> temp =
+      llvm::sys::fs::TempFile::create(path + "-%%%%%%.tmp");
+  if (!temp) {
+    LLDB_LOG_ERROR(log, temp.takeError(),
+                   "failed to create a temporary file for {1}: {0}", path);
+    return false;
+  }
+  llvm::raw_fd_ostream os(temp->FD, /*shouldClose=*/false);
+  os.write(reinterpret_cast<const char *>(data.data()), data.size());
+  os.flush();
+  if (os.has_error()) {
+    os.clear_error();
+    llvm::consumeError(temp->discard());
+    return false;
+  }
+  if (llvm::Error error = temp->keep(path)) {
+    LLDB_LOG_ERROR(log, std::move(error), "failed to write {1}: {0}", path);
+    llvm::consumeError(temp->discard());
+    return false;
+  }
+  return true;
+}
+
+Status DataFileCache::RemoveCacheFile(llvm::StringRef key) {
+  FileSpec cache_file = GetCacheFilePath(key);
+  if (!cache_file)
+    return Status("no cache directory");
+  return Status(llvm::sys::fs::remove(cache_file.GetPath()));
+}
+
+CacheSignature::CacheSignature(ObjectFile *objfile) {
+  m_uuid = objfile->GetUUID();
+  llvm::sys::TimePoint<> mod_time =
+      FileSystem::Instance().GetModificationTime(objfile->GetFileSpec());
+  if (mod_time != llvm::sys::TimePoint<>())
+    m_mod_time = llvm::sys::toTimeT(mod_time);
+  // Objects in archives also have their own modification time.
+  ModuleSP module_sp = objfile->GetModule();
+  if (module_sp && module_sp->GetObjectName()) {
+    mod_time = module_sp->GetObjectModificationTime();
+    if (mod_time != llvm::sys::TimePoint<>())
+      m_obj_mod_time = llvm::sys::toTimeT(mod_time);
+  }
+}
+
+enum SignatureEncoding : uint8_t {
+  eSignatureUUID = 1u,
+  eSignatureModTime = 2u,
+  eSignatureObjectModTime = 3u,
+  eSignatureEnd = 255u,
+};
+
+void CacheSignature::Encode(Stream &strm) const {
+  if (m_uuid.IsValid()) {
+    llvm::ArrayRef<uint8_t> uuid_bytes = m_uuid.GetBytes();
+    strm.PutHex8(eSignatureUUID);
+    strm.PutHex8(uuid_bytes.size());
+    strm.Write(uuid_bytes.data(), uuid_bytes.size());
+  }
+  if (m_mod_time) {
+    strm.PutHex8(eSignatureModTime);
+    strm.PutHex64(*m_mod_time);
+  }
+  if (m_obj_mod_time) {
+    strm.PutHex8(eSignatureObjectModTime);
+    strm.PutHex64(*m_obj_mod_time);
+  }
+  strm.PutHex8(eSignatureEnd);
+}
+
+bool CacheSignature::Decode(const DataExtractor &data,
+                            lldb::offset_t *offset_ptr) {
+  *this = CacheSignature();
+  while (data.ValidOffset(*offset_ptr)) {
+    switch (data.GetU8(offset_ptr)) {
+    case eSignatureUUID: {
+      const uint8_t length = data.GetU8(offset_ptr);
+      const void *bytes = data.GetData(offset_ptr, length);
+      if (!bytes)
+        return false;
+      m_uuid = UUID::fromData(bytes, length);
+      break;
+    }
+    case eSignatureModTime:
+      m_mod_time = data.GetU64(offset_ptr);
+      break;
+    case eSignatureObjectModTime:
+      m_obj_mod_time = data.GetU64(offset_ptr);
+      break;
+    case eSignatureEnd:
+      return true;
+    default:
+      return false;
+    }
+  }
+  return false;
+}
+
+uint32_t ConstStringTable::Add(ConstString s) {
+  auto insertion = m_string_to_index.try_emplace(s, m_strings.size());
+  if (insertion.second)
+    m_strings.push_back(s);
+  return insertion.first->second;
+}
+
+void ConstStringTable::Encode(Stream &strm) const {
+  strm.PutULEB128(m_strings.size());
+  for (ConstString s : m_strings)
+    strm.PutCString(s.GetStringRef());
+}
+
+bool StringTableReader::Decode(const DataExtractor &data,
+                               lldb::offset_t *offset_ptr) {
+  m_strs.clear();
+  m_strings.clear();
+  const uint64_t count = data.GetULEB128(offset_ptr);
+  // Each string takes at least its terminator.
+  if (count > data.BytesLeft(*offset_ptr))
+    return false;
+  m_strs.reserve(count);
+  for (uint64_t i = 0; i < count; ++i) {
+    const char *cstr = data.GetCStr(offset_ptr);
+    if (!cstr)
+      return false;
+    m_strs.push_back(cstr);
+  }
+  m_strings.resize(count);
+  return true;
+}
+
+ConstString StringTableReader::Get(uint64_t index) {
+  if (index >= m_strs.size())
+    return ConstString();
+  ConstString &s = m_strings[index];
+  if (!s)
+    s.SetString(m_strs[index]);
+  return s;
+}
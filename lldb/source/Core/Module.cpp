@@ -10,6 +10,7 @@
 
 #include "lldb/Core/AddressRange.h"
 #include "lldb/Core/AddressResolverFileLine.h"
+#include "lldb/Core/DataFileCache.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Mangled.h"
@@ -54,10 +55,13 @@
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 
 #include <cassert>
 #include <cinttypes>
@@ -1620,6 +1624,46 @@ void Module::RegisterXcodeSDK(llvm::StringRef sdk_name, llvm::StringRef sysroot)
     m_source_mappings.Append(sysroot_cs, sdk_path, false);
 }
 
+std::shared_ptr<DataFileCache> Module::GetIndexCache() {
+  ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  if (!properties.GetEnableLLDBIndexCache())
+    return nullptr;
+  // Leaked on purpose, other threads may still use the cache when the global
+  // destructors run.
+  static std::mutex *g_index_cache_mutex = new std::mutex();
+  static std::shared_ptr<DataFileCache> *g_index_cache =
+      new std::shared_ptr<DataFileCache>();
+  static std::string *g_index_cache_path = new std::string();
+
+  std::string path = properties.GetLLDBIndexCachePath().GetPath();
+  std::lock_guard<std::mutex> guard(*g_index_cache_mutex);
+  // The previous cache stays valid for the threads still using it.
+  if (!*g_index_cache || path != *g_index_cache_path) {
+    *g_index_cache = std::make_shared<DataFileCache>(path);
+    *g_index_cache_path = std::move(path);
+  }
+  return *g_index_cache;
+}
+
+std::string Module::GetCacheKey(ObjectFile *objfile, llvm::StringRef kind) {
+  // The basename makes the cache directory easier to inspect, the hash tells
+  // apart the files with the same name, the architectures of universal
+  // binaries and the objects of archives.
+  std::string id = objfile->GetFileSpec().GetPath();
+  id += m_object_name.GetStringRef();
+  id += llvm::utostr(m_object_offset);
+  id += m_arch.GetTriple().str();
+  std::string key;
+  llvm::raw_string_ostream strm(key);
+  strm << objfile->GetFileSpec().GetFilename().GetStringRef();
+  if (m_object_name)
+    strm << "(" << m_object_name.GetStringRef() << ")";
+  strm << "-" << llvm::format_hex_no_prefix(llvm::xxHash64(id), 16) << "-"
+       << kind;
+  return strm.str();
+}
+
 bool Module::MergeArchitecture(const ArchSpec &arch_spec) {
   if (!arch_spec.IsValid())
     return false;
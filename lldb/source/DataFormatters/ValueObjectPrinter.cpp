@@ -12,6 +12,7 @@
 #include "lldb/DataFormatters/DataVisualization.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Target/Language.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/Stream.h"
 
@@ -606,6 +607,46 @@ uint32_t ValueObjectPrinter::GetMaxNumChildrenToPrint(bool &print_dotdotdot) {
   return num_children;
 }
 
+void ValueObjectPrinter::PrefetchPointees(
+    llvm::ArrayRef<ValueObjectSP> children,
+    const DumpValueObjectOptions::PointerDepth &curr_ptr_depth) {
+  // Mirror the checks PrintChild() and ShouldPrintChildren() do for the
+  // children, so that only the pointers that are going to be expanded are
+  // read.
+  const uint32_t consumed_depth = (!m_options.m_pointer_as_array) ? 1 : 0;
+  const bool does_consume_ptr_depth =
+      ((IsPtr() && !m_options.m_pointer_as_array) || IsRef());
+  if (m_curr_depth + consumed_depth >= m_options.m_max_depth)
+    return;
+  if (!(does_consume_ptr_depth ? --curr_ptr_depth : curr_ptr_depth)
+           .CanAllowExpansion())
+    return;
+
+  ProcessSP process_sp = m_valobj->GetProcessSP();
+  if (!process_sp)
+    return;
+
+  std::vector<MemoryCache::AddrRange> ranges;
+  for (const ValueObjectSP &child_sp : children) {
+    CompilerType child_type = child_sp->GetCompilerType();
+    if (!child_type.IsPointerType())
+      continue;
+    AddressType address_type = eAddressTypeInvalid;
+    const addr_t pointee_addr = child_sp->GetPointerValue(&address_type);
+    if (address_type != eAddressTypeLoad || pointee_addr == 0 ||
+        pointee_addr == LLDB_INVALID_ADDRESS)
+      continue;
+    llvm::Optional<uint64_t> pointee_size =
+        child_type.GetPointeeType().GetByteSize(process_sp.get());
+    if (!pointee_size || *pointee_size == 0)
+      continue;
+    ranges.emplace_back(pointee_addr, *pointee_size);
+  }
+  // A single range is read just as fast when it is printed.
+  if (ranges.size() > 1)
+    process_sp->PrefetchMemory(ranges);
+}
+
 void ValueObjectPrinter::PrintChildrenPostamble(bool print_dotdotdot) {
   if (!m_options.m_flat_output) {
     if (print_dotdotdot) {
@@ -671,14 +712,20 @@ void ValueObjectPrinter::PrintChildren(
   if (num_children) {
     bool any_children_printed = false;
 
+    std::vector<ValueObjectSP> children;
+    children.reserve(num_children);
     for (size_t idx = 0; idx < num_children; ++idx) {
-      if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx)) {
-        if (!any_children_printed) {
-          PrintChildrenPreamble();
-          any_children_printed = true;
-        }
-        PrintChild(child_sp, curr_ptr_depth);
+      if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx))
+        children.push_back(child_sp);
+    }
+    PrefetchPointees(children, curr_ptr_depth);
+
+    for (const ValueObjectSP &child_sp : children) {
+      if (!any_children_printed) {
+        PrintChildrenPreamble();
+        any_children_printed = true;
       }
+      PrintChild(child_sp, curr_ptr_depth);
     }
 
     if (any_children_printed)
@@ -10,6 +10,7 @@
 #include "DynamicLoaderPOSIXDYLD.h"
 
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
@@ -23,7 +24,10 @@
 #include "lldb/Target/ThreadPlanRunToAddress.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/ProcessInfo.h"
+#include "lldb/Utility/Timer.h"
+#include "llvm/Support/ThreadPool.h"
 
+#include <future>
 #include <memory>
 
 using namespace lldb;
@@ -435,6 +439,7 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
       E = m_rendezvous.end();
       m_initial_modules_added = true;
     }
+    std::vector<ModuleSP> preloaded_modules = PreloadModules(I, E);
     for (; I != E; ++I) {
       ModuleSP module_sp =
           LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
@@ -603,6 +608,8 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
+  std::vector<ModuleSP> preloaded_modules =
+      PreloadModules(m_rendezvous.begin(), m_rendezvous.end());
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
         LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
@@ -622,6 +629,48 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->GetTarget().ModulesDidLoad(module_list);
 }
 
+std::vector<ModuleSP>
+DynamicLoaderPOSIXDYLD::PreloadModules(DYLDRendezvous::iterator begin,
+                                       DYLDRendezvous::iterator end) {
+  Target &target = m_process->GetTarget();
+  PlatformSP platform_sp = target.GetPlatform();
+  const size_t num_modules = std::distance(begin, end);
+  // Remote platforms may have to download the files, which they do not do
+  // concurrently.
+  if (num_modules < 2 || !target.GetParallelModuleLoad() || !platform_sp ||
+      !platform_sp->IsHost())
+    return {};
+
+  LLDB_SCOPED_TIMER();
+  const ModuleList &images = target.GetImages();
+  const FileSpecList search_paths = target.GetExecutableSearchPaths();
+  const bool preload_symbols = target.GetPreloadSymbols();
+  std::vector<ModuleSP> modules(num_modules);
+  auto preload_fn = [&](size_t idx) {
+    ModuleSpec module_spec(std::next(begin, idx)->file_spec,
+                           target.GetArchitecture());
+    if (images.FindFirstModule(module_spec))
+      return;
+    ModuleSP module_sp;
+    platform_sp->GetSharedModule(module_spec, m_process, module_sp,
+                                 &search_paths, nullptr, nullptr);
+    if (module_sp && preload_symbols)
+      module_sp->PreloadSymbols();
+    modules[idx] = std::move(module_sp);
+  };
+
+  // The pool is shared with the other debuggers, so only wait for the tasks
+  // started here.
+  llvm::ThreadPool &pool = Debugger::GetThreadPool();
+  std::vector<std::shared_future<void>> futures;
+  futures.reserve(num_modules);
+  for (size_t idx = 0; idx < num_modules; ++idx)
+    futures.push_back(pool.async(preload_fn, idx));
+  for (const std::shared_future<void> &future : futures)
+    future.wait();
+  return modules;
+}
+
 addr_t DynamicLoaderPOSIXDYLD::ComputeLoadOffset() {
   addr_t virt_entry;
 
@@ -11,6 +11,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "DYLDRendezvous.h"
 #include "Plugins/Process/Utility/AuxVector.h"
@@ -140,6 +141,17 @@ protected:
   /// of all dependent modules.
   virtual void LoadAllCurrentModules();
 
+  /// Find the modules of the shared objects in [\a begin, \a end) and load
+  /// their symbols in parallel, so that loading the shared objects one by one
+  /// afterwards only has to find the modules in the shared module list, in
+  /// the same order as before.
+  ///
+  /// \return
+  ///     The modules found, which must be kept until the shared objects are
+  ///     loaded. Empty when the modules cannot be found in parallel.
+  std::vector<lldb::ModuleSP> PreloadModules(DYLDRendezvous::iterator begin,
+                                             DYLDRendezvous::iterator end);
+
   void LoadVDSO();
 
   // Loading an interpreter module (if present) assuming m_interpreter_base
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
 #include "clang/AST/Decl.h"
@@ -778,6 +779,68 @@ void ClangASTImporter::BuildNamespaceMap(const clang::NamespaceDecl *decl) {
   context_md->m_namespace_maps[decl] = new_map;
 }
 
+/// Returns the name that identifies the type declared by \a decl in all the
+/// modules, or an empty string if there is none.
+static std::string GetCompleteDefinitionKey(const clang::TagDecl *decl) {
+  // Types that are unnamed, in anonymous namespaces or local to functions can
+  // share their names with unrelated types from other compile units.
+  if (decl->getDeclName().isEmpty() || decl->isInAnonymousNamespace() ||
+      decl->getParentFunctionOrMethod())
+    return std::string();
+  clang::ASTContext &ast = decl->getASTContext();
+  clang::PrintingPolicy policy(ast.getPrintingPolicy());
+  policy.SuppressTagKeyword = true;
+  // Include the template arguments of the specializations.
+  return ast.getTagDeclType(decl).getAsString(policy);
+}
+
+/// Returns the AST that \a decl, or the declaration it was imported from,
+/// belongs to.
+static const clang::ASTContext *
+GetCompleteDefinitionSource(ClangASTImporter &importer,
+                            const clang::TagDecl *decl) {
+  ClangASTImporter::DeclOrigin origin = importer.GetDeclOrigin(decl);
+  if (origin.Valid())
+    return origin.ctx;
+  return &decl->getASTContext();
+}
+
+clang::TagDecl *
+ClangASTImporter::GetCompleteDefinition(const clang::TagDecl *decl,
+                                        const ModuleList &images) {
+  std::string key = GetCompleteDefinitionKey(decl);
+  if (key.empty())
+    return nullptr;
+  auto source_pos =
+      m_complete_definitions.find(GetCompleteDefinitionSource(*this, decl));
+  if (source_pos == m_complete_definitions.end())
+    return nullptr;
+  llvm::StringMap<CompleteDefinition> &definitions = source_pos->second;
+  auto pos = definitions.find(key);
+  if (pos == definitions.end())
+    return nullptr;
+  // The definition is gone with its module, or will be once the module is
+  // no longer used.
+  lldb::ModuleSP module_sp = pos->second.module_wp.lock();
+  if (!module_sp || !images.FindModule(module_sp.get())) {
+    definitions.erase(pos);
+    return nullptr;
+  }
+  return pos->second.decl;
+}
+
+void ClangASTImporter::SetCompleteDefinition(const clang::TagDecl *decl,
+                                             clang::TagDecl *definition,
+                                             const lldb::ModuleSP &module_sp) {
+  if (!module_sp)
+    return;
+  std::string key = GetCompleteDefinitionKey(decl);
+  if (key.empty())
+    return;
+  m_complete_definitions[GetCompleteDefinitionSource(*this, decl)][key] = {
+      module_sp, definition};
+}
+
 void ClangASTImporter::ForgetDestination(clang::ASTContext *dst_ast) {
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
 
@@ -29,6 +29,7 @@
 #include "Plugins/ExpressionParser/Clang/CxxModuleHandler.h"
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 
 namespace lldb_private {
 
@@ -184,6 +185,26 @@ public:
 
   void BuildNamespaceMap(const clang::NamespaceDecl *decl);
 
+  //
+  // Complete definitions
+  //
+
+  /// Returns the complete definition that was found earlier for the type
+  /// declared by \a decl, or nullptr if there is none or if the module that
+  /// contains it is no longer in \a images.
+  clang::TagDecl *GetCompleteDefinition(const clang::TagDecl *decl,
+                                        const ModuleList &images);
+
+  /// Remembers that \a definition, from the AST of \a module_sp, completes
+  /// the type declared by \a decl. The forward declarations are imported
+  /// again by every expression, and this avoids searching all the modules
+  /// for the same definitions each time. Forward declarations from different
+  /// ASTs, like the ones of two modules, are remembered separately, as the
+  /// types they name may differ.
+  void SetCompleteDefinition(const clang::TagDecl *decl,
+                             clang::TagDecl *definition,
+                             const lldb::ModuleSP &module_sp);
+
   //
   // Completers for maps
   //
@@ -454,6 +475,16 @@ public:
       RecordDeclToLayoutMap;
 
   RecordDeclToLayoutMap m_record_decl_to_layout_map;
+
+  struct CompleteDefinition {
+    lldb::ModuleWP module_wp;
+    clang::TagDecl *decl = nullptr;
+  };
+
+  /// The complete definitions found for the forward declared types, by the
+  /// AST the forward declarations originate from and their qualified names.
+  llvm::DenseMap<const clang::ASTContext *, llvm::StringMap<CompleteDefinition>>
+      m_complete_definitions;
 };
 
 } // namespace lldb_private
@@ -185,6 +185,13 @@ bool ClangASTSource::FindExternalVisibleDeclsByName(
 TagDecl *ClangASTSource::FindCompleteType(const TagDecl *decl) {
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
 
+  if (TagDecl *definition = m_ast_importer_sp->GetCompleteDefinition(
+          decl, m_target->GetImages())) {
+    LLDB_LOG(log, "      CTD Using the definition found earlier for {0}",
+             decl->getName());
+    return definition;
+  }
+
   if (const NamespaceDecl *namespace_context =
           dyn_cast<NamespaceDecl>(decl->getDeclContext())) {
     ClangASTImporter::NamespaceMapSP namespace_map =
@@ -227,8 +234,11 @@ TagDecl *ClangASTSource::FindCompleteType(const TagDecl *decl) {
             const_cast<TagDecl *>(tag_type->getDecl());
 
         if (TypeSystemClang::GetCompleteDecl(
-                &candidate_tag_decl->getASTContext(), candidate_tag_decl))
+                &candidate_tag_decl->getASTContext(), candidate_tag_decl)) {
+          m_ast_importer_sp->SetCompleteDefinition(decl, candidate_tag_decl,
+                                                   type->GetModule());
           return candidate_tag_decl;
+        }
       }
     }
   } else {
@@ -270,8 +280,11 @@ TagDecl *ClangASTSource::FindCompleteType(const TagDecl *decl) {
         continue;
 
       if (TypeSystemClang::GetCompleteDecl(&candidate_tag_decl->getASTContext(),
-                                           candidate_tag_decl))
+                                           candidate_tag_decl)) {
+        m_ast_importer_sp->SetCompleteDefinition(decl, candidate_tag_decl,
+                                                 type->GetModule());
         return candidate_tag_decl;
+      }
     }
   }
   return nullptr;
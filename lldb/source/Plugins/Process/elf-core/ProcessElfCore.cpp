@@ -15,6 +15,7 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Interpreter/OptionValueProperties.h"
 #include "lldb/Target/DynamicLoader.h"
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Target/Target.h"
@@ -24,6 +25,7 @@
 #include "lldb/Utility/State.h"
 
 #include "llvm/BinaryFormat/ELF.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
 
 #include "Plugins/DynamicLoader/POSIX-DYLD/DynamicLoaderPOSIXDYLD.h"
@@ -37,6 +39,45 @@ namespace ELF = llvm::ELF;
 
 LLDB_PLUGIN_DEFINE(ProcessElfCore)
 
+namespace {
+
+#define LLDB_PROPERTIES_processelfcore
+#include "ProcessElfCoreProperties.inc"
+
+enum {
+#define LLDB_PROPERTIES_processelfcore
+#include "ProcessElfCorePropertiesEnum.inc"
+};
+
+class PluginProperties : public Properties {
+public:
+  static ConstString GetSettingName() {
+    return ProcessElfCore::GetPluginNameStatic();
+  }
+
+  PluginProperties() : Properties() {
+    m_collection_sp = std::make_shared<OptionValueProperties>(GetSettingName());
+    m_collection_sp->Initialize(g_processelfcore_properties);
+  }
+
+  bool GetLazyLoad() const {
+    const uint32_t idx = ePropertyLazyLoad;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, idx, g_processelfcore_properties[idx].default_uint_value != 0);
+  }
+};
+
+typedef std::shared_ptr<PluginProperties> ProcessElfCorePropertiesSP;
+
+static const ProcessElfCorePropertiesSP &GetGlobalPluginProperties() {
+  static ProcessElfCorePropertiesSP g_settings_sp;
+  if (!g_settings_sp)
+    g_settings_sp = std::make_shared<PluginProperties>();
+  return g_settings_sp;
+}
+
+} // namespace
+
 ConstString ProcessElfCore::GetPluginNameStatic() {
   static ConstString g_name("elf-core");
   return g_name;
@@ -148,6 +189,48 @@ lldb::addr_t ProcessElfCore::AddAddressRangeFromLoadSegment(
   return addr;
 }
 
+void ProcessElfCore::ParseLoadSegments(
+    llvm::ArrayRef<elf::ELFProgramHeader> segments) {
+  bool ranges_are_sorted = true;
+  lldb::addr_t vm_addr = 0;
+  for (const elf::ELFProgramHeader &H : segments) {
+    // PT_LOAD segments contains address map
+    if (H.p_type == llvm::ELF::PT_LOAD) {
+      lldb::addr_t last_addr = AddAddressRangeFromLoadSegment(H);
+      if (vm_addr > last_addr)
+        ranges_are_sorted = false;
+      vm_addr = last_addr;
+    }
+  }
+
+  if (!ranges_are_sorted) {
+    m_core_aranges.Sort();
+    m_core_range_infos.Sort();
+  }
+}
+
+void ProcessElfCore::EnsureAddressRanges() {
+  llvm::call_once(m_core_aranges_once, [this]() {
+    ObjectFileELF *core = (ObjectFileELF *)(m_core_module_sp->GetObjectFile());
+    if (core)
+      ParseLoadSegments(core->ProgramHeaders());
+  });
+}
+
+void ProcessElfCore::RecordTouchedPages(lldb::offset_t offset, size_t size) {
+  Target &target = GetTarget();
+  if (size == 0 || !target.GetCollectingStats())
+    return;
+
+  static const uint64_t page_size = llvm::sys::Process::getPageSizeEstimate();
+  std::lock_guard<std::mutex> guard(m_touched_pages_mutex);
+  for (uint64_t page = offset / page_size,
+                last_page = (offset + size - 1) / page_size;
+       page <= last_page; ++page)
+    if (m_touched_pages.insert(page).second)
+      target.IncrementStats(StatisticKind::CoreFilePagesTouched);
+}
+
 // Process Control
 Status ProcessElfCore::DoLoadCore() {
   Status error;
@@ -172,32 +255,23 @@ Status ProcessElfCore::DoLoadCore() {
 
   m_thread_data_valid = true;
 
-  bool ranges_are_sorted = true;
-  lldb::addr_t vm_addr = 0;
   /// Walk through segments and Thread and Address Map information.
   /// PT_NOTE - Contains Thread and Register information
-  /// PT_LOAD - Contains a contiguous range of Process Address Space
+  /// PT_LOAD - Contains a contiguous range of Process Address Space, which is
+  ///           only parsed on first use when the "lazy-load" setting is on
   for (const elf::ELFProgramHeader &H : segments) {
-    DataExtractor data = core->GetSegmentData(H);
-
     // Parse thread contexts and auxv structure
     if (H.p_type == llvm::ELF::PT_NOTE) {
+      DataExtractor data = core->GetSegmentData(H);
       if (llvm::Error error = ParseThreadContextsFromNoteSegment(H, data))
         return Status(std::move(error));
     }
-    // PT_LOAD segments contains address map
-    if (H.p_type == llvm::ELF::PT_LOAD) {
-      lldb::addr_t last_addr = AddAddressRangeFromLoadSegment(H);
-      if (vm_addr > last_addr)
-        ranges_are_sorted = false;
-      vm_addr = last_addr;
-    }
   }
 
-  if (!ranges_are_sorted) {
-    m_core_aranges.Sort();
-    m_core_range_infos.Sort();
-  }
+  // The object file maps the core file through the FileSystem, so only the
+  // pages holding the notes have been read so far.
+  if (!GetGlobalPluginProperties()->GetLazyLoad())
+    EnsureAddressRanges();
 
   // Even if the architecture is set in the target, we need to override it to
   // match the core file which is always single arch.
@@ -293,6 +367,7 @@ size_t ProcessElfCore::ReadMemory(lldb::addr_t addr, void *buf, size_t size,
 
 Status ProcessElfCore::GetMemoryRegionInfo(lldb::addr_t load_addr,
                                            MemoryRegionInfo &region_info) {
+  EnsureAddressRanges();
   region_info.Clear();
   const VMRangeToPermissions::Entry *permission_entry =
       m_core_range_infos.FindEntryThatContainsOrFollows(load_addr);
@@ -338,6 +413,8 @@ size_t ProcessElfCore::DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
   if (core_objfile == nullptr)
     return 0;
 
+  EnsureAddressRanges();
+
   // Get the address range
   const VMRangeToFileOffset::Entry *address_range =
       m_core_aranges.FindEntryThatContains(addr);
@@ -370,9 +447,11 @@ size_t ProcessElfCore::DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
     bytes_to_read = bytes_left;
 
   // If there is data available on the core file read it
-  if (bytes_to_read)
+  if (bytes_to_read) {
     bytes_copied =
         core_objfile->CopyData(offset + file_start, bytes_to_read, buf);
+    RecordTouchedPages(offset + file_start, bytes_copied);
+  }
 
   return bytes_copied;
 }
@@ -388,10 +467,22 @@ void ProcessElfCore::Initialize() {
 
   llvm::call_once(g_once_flag, []() {
     PluginManager::RegisterPlugin(GetPluginNameStatic(),
-                                  GetPluginDescriptionStatic(), CreateInstance);
+                                  GetPluginDescriptionStatic(), CreateInstance,
+                                  DebuggerInitialize);
   });
 }
 
+void ProcessElfCore::DebuggerInitialize(Debugger &debugger) {
+  if (!PluginManager::GetSettingForProcessPlugin(
+          debugger, PluginProperties::GetSettingName())) {
+    const bool is_global_setting = true;
+    PluginManager::CreateSettingForProcessPlugin(
+        debugger, GetGlobalPluginProperties()->GetValueProperties(),
+        ConstString("Properties for the elf-core process plug-in."),
+        is_global_setting);
+  }
+}
+
 lldb::addr_t ProcessElfCore::GetImageInfoAddress() {
   ObjectFile *obj_file = GetTarget().GetExecutableModule()->GetObjectFile();
   Address addr = obj_file->GetImageInfoAddress(&GetTarget());
@@ -17,11 +17,14 @@
 #define LLDB_SOURCE_PLUGINS_PROCESS_ELF_CORE_PROCESSELFCORE_H
 
 #include <list>
+#include <mutex>
 #include <vector>
 
 #include "lldb/Target/PostMortemProcess.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/Status.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/Threading.h"
 
 #include "Plugins/ObjectFile/ELF/ELFHeader.h"
 #include "Plugins/Process/elf-core/RegisterUtilities.h"
@@ -38,6 +41,8 @@ public:
 
   static void Initialize();
 
+  static void DebuggerInitialize(lldb_private::Debugger &debugger);
+
   static void Terminate();
 
   static lldb_private::ConstString GetPluginNameStatic();
@@ -145,6 +150,15 @@ private:
   // NT_FILE entries found from the NOTE segment
   std::vector<NT_FILE_Entry> m_nt_file_entries;
 
+  // Built from the PT_LOAD segments on first use when the "lazy-load" setting
+  // is on, and when the core is loaded otherwise.
+  llvm::once_flag m_core_aranges_once;
+
+  // Pages of the core file read through DoReadMemory while the target
+  // collects statistics.
+  std::mutex m_touched_pages_mutex;
+  llvm::DenseSet<uint64_t> m_touched_pages;
+
   // Parse thread(s) data structures(prstatus, prpsinfo) from given NOTE segment
   llvm::Error ParseThreadContextsFromNoteSegment(
       const elf::ELFProgramHeader &segment_header,
@@ -157,6 +171,16 @@ private:
   lldb::addr_t
   AddAddressRangeFromLoadSegment(const elf::ELFProgramHeader &header);
 
+  // Fill m_core_aranges and m_core_range_infos from all the LOAD segments
+  void ParseLoadSegments(llvm::ArrayRef<elf::ELFProgramHeader> segments);
+
+  // Make sure the address maps are built
+  void EnsureAddressRanges();
+
+  // Count the pages of the core file in [offset, offset+size) which were not
+  // read before in the target's statistics
+  void RecordTouchedPages(lldb::offset_t offset, size_t size);
+
   llvm::Expected<std::vector<lldb_private::CoreNote>>
   parseSegment(const lldb_private::DataExtractor &segment);
   llvm::Error parseFreeBSDNotes(llvm::ArrayRef<lldb_private::CoreNote> notes);
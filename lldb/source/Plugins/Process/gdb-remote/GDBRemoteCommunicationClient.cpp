@@ -120,6 +120,13 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetMultiMemReadSupported() {
+  if (m_supports_multi_mem_read == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_multi_mem_read == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -256,6 +263,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_attach_or_wait_reply = eLazyBoolCalculate;
     m_avoid_g_packets = eLazyBoolCalculate;
     m_supports_multiprocess = eLazyBoolCalculate;
+    m_supports_multi_mem_read = eLazyBoolCalculate;
     m_supports_qXfer_auxv_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_read = eLazyBoolCalculate;
     m_supports_qXfer_libraries_svr4_read = eLazyBoolCalculate;
@@ -309,6 +317,7 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
   m_supports_multiprocess = eLazyBoolNo;
   m_supports_qEcho = eLazyBoolNo;
   m_supports_QPassSignals = eLazyBoolNo;
+  m_supports_multi_mem_read = eLazyBoolNo;
 
   m_max_packet_size = UINT64_MAX; // It's supposed to always be there, but if
                                   // not, we assume no limit
@@ -352,6 +361,8 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
         m_supports_qEcho = eLazyBoolYes;
       else if (x == "QPassSignals+")
         m_supports_QPassSignals = eLazyBoolYes;
+      else if (x == "MultiMemRead+")
+        m_supports_multi_mem_read = eLazyBoolYes;
       else if (x == "multiprocess+")
         m_supports_multiprocess = eLazyBoolYes;
       // Look for a list of compressions in the features list e.g.
@@ -4007,6 +4018,66 @@ Status GDBRemoteCommunicationClient::SendSignalsToIgnore(
   }
 }
 
+llvm::Expected<std::vector<size_t>>
+GDBRemoteCommunicationClient::ReadMemoryRanges(
+    llvm::ArrayRef<std::pair<lldb::addr_t, size_t>> ranges,
+    llvm::MutableArrayRef<uint8_t> buffer) {
+  // Format packet:
+  // MultiMemRead:ranges:<addr1>,<len1>,<addr2>,<len2>...;
+  StreamString packet;
+  packet.PutCString("MultiMemRead:ranges:");
+  size_t total_size = 0;
+  for (const auto &range : ranges) {
+    if (&range != ranges.begin())
+      packet.PutChar(',');
+    packet.Printf("%" PRIx64 ",%" PRIx64, range.first,
+                  static_cast<uint64_t>(range.second));
+    total_size += range.second;
+  }
+  packet.PutChar(';');
+  if (total_size > buffer.size())
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "buffer too small for the ranges");
+
+  StringExtractorGDBRemote response;
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) !=
+      PacketResult::Success)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "failed to send MultiMemRead packet");
+  if (response.IsErrorResponse())
+    return response.GetStatus().ToError();
+
+  // The response is "<read1>,<read2>...;<data>", where data holds the bytes
+  // read from each range, back to back.
+  llvm::StringRef sizes, data;
+  std::tie(sizes, data) = response.GetStringRef().split(';');
+  llvm::SmallVector<llvm::StringRef, 16> fields;
+  sizes.split(fields, ',');
+  if (fields.size() != ranges.size() ||
+      response.GetStringRef().size() == sizes.size())
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "invalid MultiMemRead response");
+
+  std::vector<size_t> bytes_read;
+  bytes_read.reserve(ranges.size());
+  size_t data_offset = 0, buffer_offset = 0;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    uint64_t size;
+    if (fields[i].getAsInteger(16, size) || size > ranges[i].second ||
+        size > data.size() - data_offset)
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "invalid MultiMemRead response");
+    memcpy(buffer.data() + buffer_offset, data.data() + data_offset, size);
+    bytes_read.push_back(size);
+    data_offset += size;
+    buffer_offset += ranges[i].second;
+  }
+  if (data_offset != data.size())
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "invalid MultiMemRead response");
+  return bytes_read;
+}
+
 Status GDBRemoteCommunicationClient::ConfigureRemoteStructuredData(
     ConstString type_name, const StructuredData::ObjectSP &config_sp) {
   Status error;
@@ -354,6 +354,8 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  bool GetMultiMemReadSupported();
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
   bool GetQXferFeaturesReadSupported();
@@ -472,6 +474,17 @@ public:
   // Sends QPassSignals packet to the server with given signals to ignore.
   Status SendSignalsToIgnore(llvm::ArrayRef<int32_t> signals);
 
+  /// Read the memory \a ranges, given as address and size pairs, with a
+  /// single MultiMemRead packet. The bytes of each range are stored back to
+  /// back in \a buffer, which must be large enough for all of them.
+  ///
+  /// \return
+  ///     The number of bytes read from each range, which is less than its
+  ///     size if only part of it could be read.
+  llvm::Expected<std::vector<size_t>>
+  ReadMemoryRanges(llvm::ArrayRef<std::pair<lldb::addr_t, size_t>> ranges,
+                   llvm::MutableArrayRef<uint8_t> buffer);
+
   /// Return the feature set supported by the gdb-remote server.
   ///
   /// This method returns the remote side's response to the qSupported
@@ -556,6 +569,7 @@ protected:
   LazyBool m_supports_jLoadedDynamicLibrariesInfos = eLazyBoolCalculate;
   LazyBool m_supports_jGetSharedCacheInfo = eLazyBoolCalculate;
   LazyBool m_supports_QPassSignals = eLazyBoolCalculate;
+  LazyBool m_supports_multi_mem_read = eLazyBoolCalculate;
   LazyBool m_supports_error_string_reply = eLazyBoolCalculate;
   LazyBool m_supports_multiprocess = eLazyBoolCalculate;
 
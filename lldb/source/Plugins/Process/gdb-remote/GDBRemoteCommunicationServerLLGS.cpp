@@ -94,6 +94,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
       &GDBRemoteCommunicationServerLLGS::Handle_memory_read);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType_M,
                                 &GDBRemoteCommunicationServerLLGS::Handle_M);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_MultiMemRead,
+      &GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__M,
                                 &GDBRemoteCommunicationServerLLGS::Handle__M);
   RegisterMemberFunctionHandler(StringExtractorGDBRemote::eServerPacketType__m,
@@ -2304,6 +2307,67 @@ GDBRemoteCommunicationServerLLGS::Handle_memory_read(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_MultiMemRead(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  if (!m_current_process ||
+      (m_current_process->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    LLDB_LOGF(
+        log,
+        "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+        __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // The packet is "MultiMemRead:ranges:<addr>,<length>[,<addr>,<length>]*;",
+  // with the numbers in hex.
+  llvm::StringRef ranges = packet.GetStringRef();
+  if (!ranges.consume_front("MultiMemRead:ranges:") ||
+      !ranges.consume_back(";"))
+    return SendIllFormedResponse(packet, "Invalid MultiMemRead packet");
+
+  llvm::SmallVector<llvm::StringRef, 16> fields;
+  ranges.split(fields, ',');
+  if (fields.size() % 2 != 0)
+    return SendIllFormedResponse(packet, "Unpaired MultiMemRead range");
+
+  // The reply is the number of bytes read from each range, then a ';' and the
+  // bytes that were read, back to back.
+  StreamGDBRemote response;
+  std::string data;
+  for (size_t i = 0; i < fields.size(); i += 2) {
+    lldb::addr_t read_addr;
+    uint64_t byte_count;
+    if (fields[i].getAsInteger(16, read_addr) ||
+        fields[i + 1].getAsInteger(16, byte_count))
+      return SendIllFormedResponse(packet, "Invalid MultiMemRead range");
+
+    const size_t offset = data.size();
+    data.resize(offset + byte_count);
+    size_t bytes_read = 0;
+    Status error;
+    if (byte_count > 0)
+      error = m_current_process->ReadMemoryWithoutTrap(
+          read_addr, &data[offset], byte_count, bytes_read);
+    if (error.Fail())
+      LLDB_LOGF(log,
+                "GDBRemoteCommunicationServerLLGS::%s pid %" PRIu64
+                " mem 0x%" PRIx64 ": failed to read. Error: %s",
+                __FUNCTION__, m_current_process->GetID(), read_addr,
+                error.AsCString());
+    data.resize(offset + bytes_read);
+
+    if (i > 0)
+      response.PutChar(',');
+    response.Printf("%" PRIx64, static_cast<uint64_t>(bytes_read));
+  }
+  response.PutChar(';');
+  response.PutEscapedBytes(data.data(), data.size());
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle__M(StringExtractorGDBRemote &packet) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
@@ -3597,6 +3661,7 @@ std::vector<std::string> GDBRemoteCommunicationServerLLGS::HandleFeatures(
                             "QThreadSuffixSupported+",
                             "QListThreadsInStopReply+",
                             "qXfer:features:read+",
+                            "MultiMemRead+",
                         });
 
   // report server-only features
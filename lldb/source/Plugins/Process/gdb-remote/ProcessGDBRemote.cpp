@@ -2768,6 +2768,65 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   return 0;
 }
 
+bool ProcessGDBRemote::SupportsReadMemoryRanges() {
+  return m_gdb_comm.GetMultiMemReadSupported();
+}
+
+std::vector<size_t> ProcessGDBRemote::DoReadMemoryRanges(
+    llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+    llvm::MutableArrayRef<uint8_t> buffer) {
+  if (!m_gdb_comm.GetMultiMemReadSupported())
+    return Process::DoReadMemoryRanges(ranges, buffer);
+
+  Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_MEMORY));
+  GetMaxMemorySize();
+  std::vector<size_t> bytes_read;
+  bytes_read.reserve(ranges.size());
+  size_t offset = 0;
+  size_t range_idx = 0;
+  while (range_idx < ranges.size()) {
+    // Send as many ranges per packet as fit in the largest memory read the
+    // remote accepts. A range that doesn't fit on its own is read in pieces.
+    if (ranges[range_idx].GetByteSize() > m_max_memory_size) {
+      std::vector<size_t> range_bytes_read = Process::DoReadMemoryRanges(
+          ranges.slice(range_idx, 1), buffer.drop_front(offset));
+      bytes_read.push_back(range_bytes_read[0]);
+      offset += ranges[range_idx].GetByteSize();
+      ++range_idx;
+      continue;
+    }
+
+    std::vector<std::pair<addr_t, size_t>> batch;
+    size_t batch_size = 0;
+    while (range_idx + batch.size() < ranges.size()) {
+      const MemoryCache::AddrRange &range = ranges[range_idx + batch.size()];
+      if (batch_size + range.GetByteSize() > m_max_memory_size)
+        break;
+      batch.emplace_back(range.GetRangeBase(), range.GetByteSize());
+      batch_size += range.GetByteSize();
+    }
+
+    llvm::MutableArrayRef<uint8_t> batch_buffer =
+        buffer.slice(offset, batch_size);
+    llvm::Expected<std::vector<size_t>> batch_bytes_read =
+        m_gdb_comm.ReadMemoryRanges(batch, batch_buffer);
+    if (batch_bytes_read) {
+      bytes_read.insert(bytes_read.end(), batch_bytes_read->begin(),
+                        batch_bytes_read->end());
+    } else {
+      LLDB_LOG_ERROR(log, batch_bytes_read.takeError(),
+                     "MultiMemRead failed, reading the ranges one by one: {0}");
+      std::vector<size_t> batch_bytes_read = Process::DoReadMemoryRanges(
+          ranges.slice(range_idx, batch.size()), batch_buffer);
+      bytes_read.insert(bytes_read.end(), batch_bytes_read.begin(),
+                        batch_bytes_read.end());
+    }
+    offset += batch_size;
+    range_idx += batch.size();
+  }
+  return bytes_read;
+}
+
 Status ProcessGDBRemote::WriteObjectFile(
     std::vector<ObjectFile::LoadableData> entries) {
   Status error;
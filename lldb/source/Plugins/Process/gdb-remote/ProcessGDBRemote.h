@@ -136,6 +136,12 @@ public:
   size_t DoReadMemory(lldb::addr_t addr, void *buf, size_t size,
                       Status &error) override;
 
+  bool SupportsReadMemoryRanges() override;
+
+  std::vector<size_t>
+  DoReadMemoryRanges(llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+                     llvm::MutableArrayRef<uint8_t> buffer) override;
+
   Status
   WriteObjectFile(std::vector<ObjectFile::LoadableData> entries) override;
 
@@ -7,6 +7,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "DIERef.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Stream.h"
 #include "llvm/Support/Format.h"
 
 void llvm::format_provider<DIERef>::format(const DIERef &ref, raw_ostream &OS,
@@ -16,3 +18,23 @@ void llvm::format_provider<DIERef>::format(const DIERef &ref, raw_ostream &OS,
   OS << (ref.section() == DIERef::DebugInfo ? "INFO" : "TYPE");
   OS << "/" << format_hex_no_prefix(ref.die_offset(), 8);
 }
+
+void DIERef::Encode(lldb_private::Stream &strm) const {
+  strm.PutULEB128(uint64_t(m_dwo_num) << 2 | m_dwo_num_valid << 1 | m_section);
+  strm.PutULEB128(m_die_offset);
+}
+
+llvm::Optional<DIERef> DIERef::Decode(const lldb_private::DataExtractor &data,
+                                      lldb::offset_t *offset_ptr) {
+  const lldb::offset_t start = *offset_ptr;
+  const uint64_t bits = data.GetULEB128(offset_ptr);
+  const uint64_t die_offset = data.GetULEB128(offset_ptr);
+  // Each of the two values takes at least one byte, unless the data ended.
+  if (*offset_ptr < start + 2 || (bits >> 2) > UINT32_MAX >> 2 ||
+      die_offset > UINT32_MAX)
+    return llvm::None;
+  llvm::Optional<uint32_t> dwo_num;
+  if (bits & 2)
+    dwo_num = bits >> 2;
+  return DIERef(dwo_num, Section(bits & 1), die_offset);
+}
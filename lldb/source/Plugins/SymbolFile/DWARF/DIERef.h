@@ -10,6 +10,8 @@
 #define LLDB_SOURCE_PLUGINS_SYMBOLFILE_DWARF_DIEREF_H
 
 #include "lldb/Core/dwarf.h"
+#include "lldb/lldb-forward.h"
+#include "lldb/lldb-types.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/Support/FormatProviders.h"
 #include <cassert>
@@ -54,6 +56,13 @@ public:
     return m_die_offset < other.m_die_offset;
   }
 
+  /// Encode this object into \a strm for the index cache.
+  void Encode(lldb_private::Stream &strm) const;
+
+  /// Decode a DIERef encoded by Encode() at \a *offset_ptr in \a data.
+  static llvm::Optional<DIERef> Decode(const lldb_private::DataExtractor &data,
+                                       lldb::offset_t *offset_ptr);
+
 private:
   uint32_t m_dwo_num : 30;
   uint32_t m_dwo_num_valid : 1;
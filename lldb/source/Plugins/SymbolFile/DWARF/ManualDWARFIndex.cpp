@@ -12,9 +12,13 @@
 #include "Plugins/SymbolFile/DWARF/DWARFDeclContext.h"
 #include "Plugins/SymbolFile/DWARF/LogChannelDWARF.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
+#include "lldb/Core/DataFileCache.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Progress.h"
+#include "lldb/Core/StreamBuffer.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Endian.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
 #include "llvm/Support/FormatVariadic.h"
@@ -32,6 +36,9 @@ void ManualDWARFIndex::Index() {
 
   LLDB_SCOPED_TIMERF("%p", static_cast<void *>(&main_dwarf));
 
+  if (LoadFromCache(main_dwarf))
+    return;
+
   DWARFDebugInfo &main_info = main_dwarf.DebugInfo();
   SymbolFileDWARFDwo *dwp_dwarf = main_dwarf.GetDwpSymbolFile().get();
   DWARFDebugInfo *dwp_info = dwp_dwarf ? &dwp_dwarf->DebugInfo() : nullptr;
@@ -124,6 +131,135 @@ void ManualDWARFIndex::Index() {
   pool.async(finalize_fn, &IndexSet::types);
   pool.async(finalize_fn, &IndexSet::namespaces);
   pool.wait();
+
+  SaveToCache(main_dwarf);
+}
+
+// Identifies the cache entries of the index and the version of their
+// encoding, which must change whenever the encoding does.
+static constexpr llvm::StringLiteral kCacheIdentifier("DIDX");
+static constexpr uint32_t kCacheVersion = 2;
+
+std::vector<CacheSignature>
+ManualDWARFIndex::GetCacheSignatures(SymbolFileDWARF &main_dwarf) {
+  std::vector<CacheSignature> signatures;
+  ObjectFile *objfile = main_dwarf.GetObjectFile();
+  if (!objfile)
+    return signatures;
+  CacheSignature signature(objfile);
+  if (!signature.IsValid())
+    return signatures;
+  signatures.push_back(signature);
+
+  SymbolFileDWARFDwo *dwp_dwarf = main_dwarf.GetDwpSymbolFile().get();
+  if (dwp_dwarf)
+    signatures.emplace_back(dwp_dwarf->GetObjectFile());
+  DWARFDebugInfo &main_info = main_dwarf.DebugInfo();
+  for (size_t U = 0; U < main_info.GetNumUnits(); ++U) {
+    DWARFUnit *unit = main_info.GetUnitAtIndex(U);
+    if (!unit || unit->GetDWOId() == 0)
+      continue;
+    // A .dwo file which cannot be found has an invalid signature, which no
+    // longer matches once the file is there.
+    SymbolFileDWARFDwo *dwo_dwarf = unit->GetDwoSymbolFile();
+    if (!dwo_dwarf)
+      signatures.emplace_back();
+    else if (dwo_dwarf != dwp_dwarf)
+      signatures.emplace_back(dwo_dwarf->GetObjectFile());
+  }
+  return signatures;
+}
+
+bool ManualDWARFIndex::LoadFromCache(SymbolFileDWARF &main_dwarf) {
+  std::shared_ptr<DataFileCache> cache = Module::GetIndexCache();
+  if (!cache)
+    return false;
+  std::vector<CacheSignature> signatures = GetCacheSignatures(main_dwarf);
+  if (signatures.empty())
+    return false;
+  ObjectFile *objfile = main_dwarf.GetObjectFile();
+  std::unique_ptr<llvm::MemoryBuffer> buffer =
+      cache->GetCachedData(m_module.GetCacheKey(objfile, "manual-dwarf-index"));
+  if (!buffer)
+    return false;
+  DataExtractor data(buffer->getBufferStart(), buffer->getBufferSize(),
+                     endian::InlHostByteOrder(),
+                     objfile->GetAddressByteSize());
+  lldb::offset_t offset = 0;
+  IndexSet set;
+  // A stale entry is replaced once the index is built.
+  if (!Decode(data, &offset, signatures, set))
+    return false;
+  m_set = std::move(set);
+  return true;
+}
+
+bool ManualDWARFIndex::Decode(const DataExtractor &data,
+                              lldb::offset_t *offset_ptr,
+                              llvm::ArrayRef<CacheSignature> signatures,
+                              IndexSet &set) {
+  const void *identifier = data.GetData(offset_ptr, kCacheIdentifier.size());
+  if (!identifier ||
+      llvm::StringRef(static_cast<const char *>(identifier),
+                      kCacheIdentifier.size()) != kCacheIdentifier ||
+      data.GetU32(offset_ptr) != kCacheVersion)
+    return false;
+  if (data.GetULEB128(offset_ptr) != signatures.size())
+    return false;
+  for (const CacheSignature &signature : signatures) {
+    CacheSignature cached_signature;
+    if (!cached_signature.Decode(data, offset_ptr) ||
+        cached_signature != signature)
+      return false;
+  }
+  StringTableReader strtab;
+  if (!strtab.Decode(data, offset_ptr))
+    return false;
+  for (NameToDIE *index :
+       {&set.function_basenames, &set.function_fullnames,
+        &set.function_methods, &set.function_selectors,
+        &set.objc_class_selectors, &set.globals, &set.types,
+        &set.namespaces}) {
+    if (!index->Decode(data, offset_ptr, strtab))
+      return false;
+  }
+  return true;
+}
+
+void ManualDWARFIndex::SaveToCache(SymbolFileDWARF &main_dwarf) {
+  std::shared_ptr<DataFileCache> cache = Module::GetIndexCache();
+  if (!cache)
+    return;
+  std::vector<CacheSignature> signatures = GetCacheSignatures(main_dwarf);
+  if (signatures.empty())
+    return;
+  ObjectFile *objfile = main_dwarf.GetObjectFile();
+
+  // The string table comes first in the entry but is only complete once the
+  // indexes are encoded.
+  StreamBuffer<1024> body(Stream::eBinary, objfile->GetAddressByteSize(),
+                          endian::InlHostByteOrder());
+  ConstStringTable strtab;
+  for (const NameToDIE *index :
+       {&m_set.function_basenames, &m_set.function_fullnames,
+        &m_set.function_methods, &m_set.function_selectors,
+        &m_set.objc_class_selectors, &m_set.globals, &m_set.types,
+        &m_set.namespaces})
+    index->Encode(body, strtab);
+
+  StreamBuffer<1024> strm(Stream::eBinary, objfile->GetAddressByteSize(),
+                          endian::InlHostByteOrder());
+  strm.Write(kCacheIdentifier.data(), kCacheIdentifier.size());
+  strm.PutHex32(kCacheVersion);
+  strm.PutULEB128(signatures.size());
+  for (const CacheSignature &signature : signatures)
+    signature.Encode(strm);
+  strtab.Encode(strm);
+  strm.Write(body.GetData(), body.GetSize());
+  cache->SetCachedData(
+      m_module.GetCacheKey(objfile, "manual-dwarf-index"),
+      llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(strm.GetData()),
+                              strm.GetSize()));
 }
 
 void ManualDWARFIndex::IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp,
@@ -17,6 +17,8 @@ class DWARFDebugInfo;
 class SymbolFileDWARFDwo;
 
 namespace lldb_private {
+struct CacheSignature;
+
 class ManualDWARFIndex : public DWARFIndex {
 public:
   ManualDWARFIndex(Module &module, SymbolFileDWARF &dwarf,
@@ -67,6 +69,30 @@ private:
     NameToDIE namespaces;
   };
   void Index();
+
+  /// Load the index from the index cache.
+  ///
+  /// \return
+  ///     True if the cache had an entry for \a main_dwarf that is still valid.
+  bool LoadFromCache(SymbolFileDWARF &main_dwarf);
+
+  /// Save the index to the index cache.
+  void SaveToCache(SymbolFileDWARF &main_dwarf);
+
+  /// Get the signatures of all the files the index is built from: the object
+  /// file of \a main_dwarf, then its .dwp file and the .dwo files of its
+  /// units. The split DWARF files can be rebuilt without the main object file
+  /// changing.
+  ///
+  /// \return
+  ///     The signatures, or an empty vector if the object file of
+  ///     \a main_dwarf has no valid signature.
+  static std::vector<CacheSignature>
+  GetCacheSignatures(SymbolFileDWARF &main_dwarf);
+
+  static bool Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                     llvm::ArrayRef<CacheSignature> signatures, IndexSet &set);
+
   void IndexUnit(DWARFUnit &unit, SymbolFileDWARFDwo *dwp, IndexSet &set);
 
   static void IndexUnitImpl(DWARFUnit &unit,
@@ -8,8 +8,10 @@
 
 #include "NameToDIE.h"
 #include "DWARFUnit.h"
+#include "lldb/Core/DataFileCache.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/StreamString.h"
@@ -86,3 +88,33 @@ void NameToDIE::Append(const NameToDIE &other) {
                  other.m_map.GetValueAtIndexUnchecked(i));
   }
 }
+
+void NameToDIE::Encode(Stream &strm, ConstStringTable &strtab) const {
+  const uint32_t size = m_map.GetSize();
+  strm.PutULEB128(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    strm.PutULEB128(strtab.Add(m_map.GetCStringAtIndexUnchecked(i)));
+    m_map.GetValueRefAtIndexUnchecked(i).Encode(strm);
+  }
+}
+
+bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
+                       StringTableReader &strtab) {
+  m_map.Clear();
+  const uint64_t size = data.GetULEB128(offset_ptr);
+  // Each entry takes at least three bytes.
+  if (size > data.BytesLeft(*offset_ptr) / 3)
+    return false;
+  m_map.Reserve(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    ConstString name = strtab.Get(data.GetULEB128(offset_ptr));
+    llvm::Optional<DIERef> die_ref = DIERef::Decode(data, offset_ptr);
+    if (!name || !die_ref)
+      return false;
+    m_map.Append(name, *die_ref);
+  }
+  // The map is sorted by the addresses of the strings, which are different in
+  // every process.
+  Finalize();
+  return true;
+}
@@ -18,6 +18,11 @@
 
 class DWARFUnit;
 
+namespace lldb_private {
+class ConstStringTable;
+class StringTableReader;
+} // namespace lldb_private
+
 class NameToDIE {
 public:
   NameToDIE() : m_map() {}
@@ -47,6 +52,19 @@ public:
                              const DIERef &die_ref)> const
               &callback) const;
 
+  /// Encode this object into \a strm for the index cache, with its names
+  /// added to \a strtab.
+  void Encode(lldb_private::Stream &strm,
+              lldb_private::ConstStringTable &strtab) const;
+
+  /// Decode the object encoded by Encode() at \a *offset_ptr in \a data.
+  ///
+  /// \return
+  ///     True if the data was valid.
+  bool Decode(const lldb_private::DataExtractor &data,
+              lldb::offset_t *offset_ptr,
+              lldb_private::StringTableReader &strtab);
+
 protected:
   lldb_private::UniqueCStringMap<DIERef> m_map;
 };
@@ -199,8 +199,10 @@ Symtab *SymbolFile::GetSymtab() {
   m_symtab = GetMainObjectFile()->GetSymtab();
 
   // Then add our symbols to it.
-  if (m_symtab)
+  if (m_symtab) {
     AddSymbols(*m_symtab);
+    m_symtab->Finalize();
+  }
 
   return m_symtab;
 }
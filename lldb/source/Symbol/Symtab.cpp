@@ -11,13 +11,17 @@
 
 #include "Plugins/Language/ObjC/ObjCLanguage.h"
 
+#include "lldb/Core/DataFileCache.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/RichManglingContext.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Core/StreamBuffer.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/Symtab.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Endian.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/Timer.h"
@@ -30,7 +34,8 @@ using namespace lldb_private;
 Symtab::Symtab(ObjectFile *objfile)
     : m_objfile(objfile), m_symbols(), m_file_addr_to_index(*this),
       m_name_to_symbol_indices(), m_mutex(),
-      m_file_addr_to_index_computed(false), m_name_indexes_computed(false) {
+      m_file_addr_to_index_computed(false), m_name_indexes_computed(false),
+      m_finalized(false) {
   m_name_to_symbol_indices.emplace(std::make_pair(
       lldb::eFunctionNameTypeNone, UniqueCStringMap<uint32_t>()));
   m_name_to_symbol_indices.emplace(std::make_pair(
@@ -53,6 +58,7 @@ Symbol *Symtab::Resize(size_t count) {
   // Clients should grab the mutex from this symbol table and lock it manually
   // when calling this function to avoid performance issues.
   m_symbols.resize(count);
+  m_finalized = false;
   return m_symbols.empty() ? nullptr : &m_symbols[0];
 }
 
@@ -66,6 +72,7 @@ uint32_t Symtab::AddSymbol(const Symbol &symbol) {
   m_symbols.push_back(symbol);
   m_file_addr_to_index_computed = false;
   m_name_indexes_computed = false;
+  m_finalized = false;
   return symbol_idx;
 }
 
@@ -264,6 +271,9 @@ void Symtab::InitNameIndexes() {
     m_name_indexes_computed = true;
     LLDB_SCOPED_TIMER();
 
+    if (m_finalized && LoadFromCache())
+      return;
+
     auto &name_to_index = GetNameToSymbolIndexMap(lldb::eFunctionNameTypeNone);
     auto &basename_to_index =
         GetNameToSymbolIndexMap(lldb::eFunctionNameTypeBase);
@@ -353,7 +363,139 @@ void Symtab::InitNameIndexes() {
     basename_to_index.SizeToFit();
     method_to_index.Sort();
     method_to_index.SizeToFit();
+
+    if (m_finalized)
+      SaveToCache();
+  }
+}
+
+void Symtab::Finalize() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  // Shrink to fit the symbols so we don't waste memory
+  if (m_symbols.capacity() > m_symbols.size()) {
+    collection new_symbols(m_symbols.begin(), m_symbols.end());
+    m_symbols.swap(new_symbols);
+  }
+  if (m_finalized)
+    return;
+  m_finalized = true;
+  // Name indexes computed while the symbols were added are complete now.
+  if (m_name_indexes_computed)
+    SaveToCache();
+}
+
+// Identifies the cache entries of the name indexes and the version of their
+// encoding, which must change whenever the encoding does.
+static constexpr llvm::StringLiteral kCacheIdentifier("SYMN");
+static constexpr uint32_t kCacheVersion = 1;
+
+bool Symtab::LoadFromCache() {
+  std::shared_ptr<DataFileCache> cache = Module::GetIndexCache();
+  ModuleSP module_sp = m_objfile ? m_objfile->GetModule() : nullptr;
+  if (!cache || !module_sp)
+    return false;
+  CacheSignature signature(m_objfile);
+  if (!signature.IsValid())
+    return false;
+  std::unique_ptr<llvm::MemoryBuffer> buffer =
+      cache->GetCachedData(module_sp->GetCacheKey(m_objfile, "symtab-names"));
+  if (!buffer)
+    return false;
+  DataExtractor data(buffer->getBufferStart(), buffer->getBufferSize(),
+                     endian::InlHostByteOrder(),
+                     m_objfile->GetAddressByteSize());
+  lldb::offset_t offset = 0;
+
+  const void *identifier = data.GetData(&offset, kCacheIdentifier.size());
+  if (!identifier ||
+      llvm::StringRef(static_cast<const char *>(identifier),
+                      kCacheIdentifier.size()) != kCacheIdentifier ||
+      data.GetU32(&offset) != kCacheVersion)
+    return false;
+  CacheSignature cached_signature;
+  if (!cached_signature.Decode(data, &offset) || cached_signature != signature)
+    return false;
+  // The indexes refer to the symbols by index, symbols added since the entry
+  // was saved make it stale.
+  const uint32_t num_symbols = m_symbols.size();
+  if (data.GetU32(&offset) != num_symbols)
+    return false;
+  StringTableReader strtab;
+  if (!strtab.Decode(data, &offset))
+    return false;
+
+  bool success = true;
+  for (auto &pair : m_name_to_symbol_indices) {
+    NameToIndexMap &name_to_index = pair.second;
+    name_to_index.Clear();
+    if (!success)
+      continue;
+    const uint64_t size = data.GetULEB128(&offset);
+    // Each entry takes at least two bytes.
+    if (size > data.BytesLeft(offset) / 2) {
+      success = false;
+      continue;
+    }
+    name_to_index.Reserve(size);
+    for (uint64_t i = 0; i < size; ++i) {
+      ConstString name = strtab.Get(data.GetULEB128(&offset));
+      const uint64_t value = data.GetULEB128(&offset);
+      if (!name || value >= num_symbols) {
+        success = false;
+        break;
+      }
+      name_to_index.Append(name, value);
+    }
+    // The maps are sorted by the addresses of the strings, which are
+    // different in every process.
+    name_to_index.Sort();
+    name_to_index.SizeToFit();
+  }
+  if (!success) {
+    // Start over from empty maps, as if the cache had no entry.
+    for (auto &pair : m_name_to_symbol_indices)
+      pair.second.Clear();
   }
+  return success;
+}
+
+void Symtab::SaveToCache() {
+  std::shared_ptr<DataFileCache> cache = Module::GetIndexCache();
+  ModuleSP module_sp = m_objfile ? m_objfile->GetModule() : nullptr;
+  if (!cache || !module_sp)
+    return;
+  CacheSignature signature(m_objfile);
+  if (!signature.IsValid())
+    return;
+
+  // The string table comes first in the entry but is only complete once the
+  // maps are encoded.
+  StreamBuffer<1024> body(Stream::eBinary, m_objfile->GetAddressByteSize(),
+                          endian::InlHostByteOrder());
+  ConstStringTable strtab;
+  for (const auto &pair : m_name_to_symbol_indices) {
+    const NameToIndexMap &name_to_index = pair.second;
+    const size_t size = name_to_index.GetSize();
+    body.PutULEB128(size);
+    for (size_t i = 0; i < size; ++i) {
+      body.PutULEB128(
+          strtab.Add(name_to_index.GetCStringAtIndexUnchecked(i)));
+      body.PutULEB128(name_to_index.GetValueAtIndexUnchecked(i));
+    }
+  }
+
+  StreamBuffer<1024> strm(Stream::eBinary, m_objfile->GetAddressByteSize(),
+                          endian::InlHostByteOrder());
+  strm.Write(kCacheIdentifier.data(), kCacheIdentifier.size());
+  strm.PutHex32(kCacheVersion);
+  signature.Encode(strm);
+  strm.PutHex32(m_symbols.size());
+  strtab.Encode(strm);
+  strm.Write(body.GetData(), body.GetSize());
+  cache->SetCachedData(
+      module_sp->GetCacheKey(m_objfile, "symtab-names"),
+      llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(strm.GetData()),
+                              strm.GetSize()));
 }
 
 void Symtab::RegisterMangledNameEntry(
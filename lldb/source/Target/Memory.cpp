@@ -15,6 +15,7 @@
 
 #include <cinttypes>
 #include <memory>
+#include <set>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -249,6 +250,65 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len,
   return dst_len - bytes_left;
 }
 
+void MemoryCache::Prefetch(llvm::ArrayRef<AddrRange> ranges) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  const uint32_t cache_line_byte_size = m_L2_cache_line_byte_size;
+
+  // Find the cache lines that would have to be read from the process, merging
+  // adjacent ones so that they are read as one range.
+  std::vector<AddrRange> line_ranges;
+  std::set<addr_t> line_addrs;
+  for (const AddrRange &range : ranges) {
+    if (range.GetByteSize() == 0)
+      continue;
+    const addr_t end_addr = range.GetRangeEnd() - 1;
+    if (end_addr < range.GetRangeBase())
+      continue;
+    for (addr_t curr_addr = range.GetRangeBase() -
+                            (range.GetRangeBase() % cache_line_byte_size);
+         curr_addr <= end_addr; curr_addr += cache_line_byte_size) {
+      if (m_invalid_ranges.FindEntryThatContains(curr_addr))
+        break;
+      if (m_L2_cache.count(curr_addr) == 0)
+        line_addrs.insert(curr_addr);
+      if (curr_addr + cache_line_byte_size < curr_addr)
+        break;
+    }
+  }
+  for (addr_t line_addr : line_addrs) {
+    if (!line_ranges.empty() && line_ranges.back().GetRangeEnd() == line_addr)
+      line_ranges.back().SetByteSize(line_ranges.back().GetByteSize() +
+                                     cache_line_byte_size);
+    else
+      line_ranges.emplace_back(line_addr, cache_line_byte_size);
+  }
+  if (line_ranges.empty())
+    return;
+
+  std::vector<uint8_t> buffer(line_addrs.size() * cache_line_byte_size);
+  std::vector<size_t> bytes_read =
+      m_process.ReadMemoryRangesFromInferior(line_ranges, buffer);
+
+  // Add the lines that were read to the L2 cache. Like in Read(), a line that
+  // could only be partially read is added with its smaller size, and the
+  // lines after it are dropped.
+  const uint8_t *line_data = buffer.data();
+  for (size_t i = 0; i < line_ranges.size(); ++i) {
+    const uint8_t *range_data = line_data;
+    size_t bytes_left = bytes_read[i];
+    for (addr_t curr_addr = line_ranges[i].GetRangeBase(); bytes_left > 0;
+         curr_addr += cache_line_byte_size) {
+      const size_t line_size =
+          std::min<size_t>(bytes_left, cache_line_byte_size);
+      m_L2_cache[curr_addr] =
+          std::make_shared<DataBufferHeap>(range_data, line_size);
+      range_data += line_size;
+      bytes_left -= line_size;
+    }
+    line_data += line_ranges[i].GetByteSize();
+  }
+}
+
 AllocatedBlock::AllocatedBlock(lldb::addr_t addr, uint32_t byte_size,
                                uint32_t permissions, uint32_t chunk_size)
     : m_range(addr, byte_size), m_permissions(permissions),
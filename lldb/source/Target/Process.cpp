@@ -2066,6 +2066,56 @@ size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
   return bytes_read;
 }
 
+std::vector<size_t> Process::ReadMemoryRangesFromInferior(
+    llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+    llvm::MutableArrayRef<uint8_t> buffer) {
+  std::vector<size_t> bytes_read = DoReadMemoryRanges(ranges, buffer);
+  assert(bytes_read.size() == ranges.size());
+
+  // Replace any software breakpoint opcodes that fall into the ranges back
+  // into the buffer before we return
+  size_t offset = 0;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (bytes_read[i] > 0)
+      RemoveBreakpointOpcodesFromBuffer(ranges[i].GetRangeBase(),
+                                        bytes_read[i], buffer.data() + offset);
+    offset += ranges[i].GetByteSize();
+  }
+  return bytes_read;
+}
+
+std::vector<size_t>
+Process::DoReadMemoryRanges(llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+                            llvm::MutableArrayRef<uint8_t> buffer) {
+  std::vector<size_t> bytes_read;
+  bytes_read.reserve(ranges.size());
+  size_t offset = 0;
+  for (const MemoryCache::AddrRange &range : ranges) {
+    size_t range_bytes_read = 0;
+    Status error;
+    while (range_bytes_read < range.GetByteSize()) {
+      const size_t curr_size = range.GetByteSize() - range_bytes_read;
+      const size_t curr_bytes_read = DoReadMemory(
+          range.GetRangeBase() + range_bytes_read,
+          buffer.data() + offset + range_bytes_read, curr_size, error);
+      range_bytes_read += curr_bytes_read;
+      if (curr_bytes_read == curr_size || curr_bytes_read == 0)
+        break;
+    }
+    bytes_read.push_back(range_bytes_read);
+    offset += range.GetByteSize();
+  }
+  return bytes_read;
+}
+
+void Process::PrefetchMemory(llvm::ArrayRef<MemoryCache::AddrRange> ranges) {
+  // Reading the ranges one at a time is what reading them later would do, so
+  // there is nothing to gain unless they can be read at once.
+  if (ranges.empty() || GetDisableMemoryCache() || !SupportsReadMemoryRanges())
+    return;
+  m_memory_cache.Prefetch(ranges);
+}
+
 uint64_t Process::ReadUnsignedIntegerFromMemory(lldb::addr_t vm_addr,
                                                 size_t integer_byte_size,
                                                 uint64_t fail_value,
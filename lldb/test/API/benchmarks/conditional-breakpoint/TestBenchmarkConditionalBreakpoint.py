@@ -0,0 +1,59 @@
+"""
+Benchmark how fast lldb evaluates the condition of a breakpoint that is hit
+many times but only stops once. The process stops at every hit either way,
+only the evaluation of the condition by lldb differs.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkConditionalBreakpoint(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.hits = 20000
+
+    @benchmarks_test
+    def test_compiled_condition(self):
+        """Benchmark a condition evaluated without the expression parser."""
+        self.build()
+        self.run_condition(True)
+
+    @benchmarks_test
+    def test_expression_condition(self):
+        """Benchmark a condition evaluated by the expression parser."""
+        self.build()
+        self.run_condition(False)
+
+    def run_condition(self, compile_conditions):
+        self.runCmd("settings set target.breakpoints-compile-conditions %s" %
+                    ("true" if compile_conditions else "false"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.breakpoints-compile-conditions"))
+
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        bkpt = target.BreakpointCreateBySourceRegex(
+            "break here", lldb.SBFileSpec("main.cpp"))
+        bkpt.SetCondition("i == %d" % (self.hits - 1))
+
+        stopwatch = Stopwatch()
+        with stopwatch:
+            process = target.LaunchSimple(
+                None, None, self.get_process_working_directory())
+        self.assertEqual(process.GetState(), lldb.eStateStopped)
+        self.assertEqual(bkpt.GetHitCount(), self.hits)
+        frame = process.GetSelectedThread().GetFrameAtIndex(0)
+        self.assertEqual(
+            frame.FindVariable("i").GetValueAsSigned(), self.hits - 1)
+
+        print("lldb conditional breakpoint benchmark (%s) - %d hits in %f "
+              "seconds, %f hits per second" %
+              ("compiled" if compile_conditions else "expression",
+               self.hits, stopwatch.avg(), self.hits / stopwatch.avg()))
@@ -0,0 +1,14 @@
+#include <cstdio>
+
+int g_sum = 0;
+
+__attribute__((noinline)) void hot(int i) {
+  g_sum += i; // break here
+}
+
+int main(int argc, char const *argv[]) {
+  for (int i = 0; i < 20000; ++i)
+    hot(i);
+  std::printf("%d\n", g_sum);
+  return 0;
+}
@@ -4,6 +4,9 @@ Test signal reporting when debugging with linux core files.
 
 
 
+import mmap
+import os
+
 import lldb
 from lldbsuite.test.decorators import *
 from lldbsuite.test.lldbtest import *
@@ -30,6 +33,43 @@ class GCoreTestCase(TestBase):
         """Test that lldb can read the process information from an x86_64 linux core file."""
         self.do_test("linux-x86_64", self._x86_64_pid)
 
+    @skipIf(oslist=['windows'])
+    @skipIf(triple='^mips')
+    def test_lazy_load(self):
+        """Test that a mapped core file reads the same memory as an eagerly loaded one."""
+        self.runCmd("settings set plugin.process.elf-core.lazy-load false")
+        eager = self.read_stack("linux-x86_64")
+        self.runCmd("settings set plugin.process.elf-core.lazy-load true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear plugin.process.elf-core.lazy-load"))
+        lazy = self.read_stack("linux-x86_64")
+        self.assertEqual(eager, lazy)
+
+    def read_stack(self, filename):
+        target = self.dbg.CreateTarget("")
+        target.SetCollectingStats(True)
+        process = target.LoadCore(filename + ".core")
+        self.assertTrue(process, PROCESS_IS_VALID)
+        sp = process.GetThreadAtIndex(0).GetFrameAtIndex(0).GetSP()
+        region = lldb.SBMemoryRegionInfo()
+        self.assertTrue(process.GetMemoryRegionInfo(sp, region).Success())
+        self.assertTrue(region.IsReadable())
+        error = lldb.SBError()
+        data = process.ReadMemory(sp, 256, error)
+        self.assertTrue(error.Success(), error.GetCString())
+
+        # The reads touched some, but not more than all, of the core file.
+        stats = target.GetStatistics()
+        pages = stats.GetValueForKey(
+            "Number of core file pages read").GetIntegerValue()
+        core_pages = (os.path.getsize(filename + ".core") + mmap.PAGESIZE -
+                      1) // mmap.PAGESIZE
+        self.assertGreater(pages, 0)
+        self.assertLessEqual(pages, core_pages)
+
+        self.dbg.DeleteTarget(target)
+        return (region.GetRegionBase(), region.GetRegionEnd(), data)
+
     def do_test(self, filename, pid):
         target = self.dbg.CreateTarget("")
         process = target.LoadCore(filename + ".core")
@@ -631,6 +631,57 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase, DwarfOpcod
         read_contents = seven.unhexlify(context.get("read_contents"))
         self.assertEqual(read_contents, MEMORY_CONTENTS)
 
+    @skipIfWindows # No pty support to test any inferior output
+    @skipIfDarwin # debugserver doesn't implement $MultiMemRead
+    def test_MultiMemRead_packet_reads_memory(self):
+        self.build()
+        self.set_inferior_startup_launch()
+        MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz"
+
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "set-message:%s" %
+                MEMORY_CONTENTS,
+                "get-data-address-hex:g_message",
+                "sleep:5"])
+
+        # Run the process
+        self.test_sequence.add_log_lines(
+            [
+                # Start running after initial stop.
+                "read packet: $c#63",
+                # Match output line that prints the memory address of the message buffer within the inferior.
+                {"type": "output_match", "regex": self.maybe_strict_output_regex(r"data address: 0x([0-9a-fA-F]+)\r\n"),
+                 "capture": {1: "message_address"}},
+                # Now stop the inferior.
+                "read packet: {}".format(chr(3)),
+                # And wait for the stop notification.
+                {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+
+        # Run the packet stream.
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("message_address"))
+        message_address = int(context.get("message_address"), 16)
+
+        # Read two pieces of the message, an empty range and an unmapped
+        # range with one packet.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $MultiMemRead:ranges:{0:x},a,{1:x},5,{0:x},0,0,4;#00".format(
+                message_address, message_address + 14),
+             {"direction": "send", "regex": r"^\$([0-9a-f,]+);(.*)#[0-9a-fA-F]{2}$",
+              "capture": {1: "sizes", 2: "read_contents"}}],
+            True)
+
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEqual(context.get("sizes"), "a,5,0,0")
+        self.assertEqual(context.get("read_contents"),
+                         MEMORY_CONTENTS[:10] + MEMORY_CONTENTS[14:19])
+
     def test_qMemoryRegionInfo_is_supported(self):
         self.build()
         self.set_inferior_startup_launch()
@@ -993,6 +1044,11 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase, DwarfOpcod
         supported_dict = self.get_qSupported_dict()
         self.assertEqual(supported_dict.get('QPassSignals', '-'), expected)
 
+    @skipIfDarwin # debugserver doesn't implement $MultiMemRead
+    def test_qSupported_MultiMemRead(self):
+        supported_dict = self.get_qSupported_dict()
+        self.assertEqual(supported_dict.get('MultiMemRead', '-'), '+')
+
     @add_test_categories(["fork"])
     def test_qSupported_fork_events(self):
         supported_dict = (
@@ -0,0 +1,158 @@
+//===-- CompiledBreakpointConditionTest.cpp -------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Breakpoint/CompiledBreakpointCondition.h"
+#include "llvm/ADT/StringMap.h"
+#include "gtest/gtest.h"
+
+using namespace lldb_private;
+
+namespace {
+/// Evaluates conditions with a fixed set of operand values.
+class ConditionEvaluator {
+public:
+  ConditionEvaluator() {
+    m_values["i"] = Scalar(-5);
+    m_values["u"] = Scalar(7u);
+    m_values["c"] = Scalar(llvm::APSInt(llvm::APInt(8, 'x'), false));
+    m_values["p->count"] = Scalar(3ul);
+    m_values["array[2]"] = Scalar(42);
+    m_values["$rax"] = Scalar(0x1000ul);
+    m_values["zero"] = Scalar(0);
+    m_pointers["p"] = Scalar(0x1000ul);
+    m_pointers["q"] = Scalar(0x1004ul);
+  }
+
+  llvm::Optional<bool> Evaluate(llvm::StringRef text) {
+    llvm::Optional<CompiledBreakpointCondition> condition =
+        CompiledBreakpointCondition::Compile(text);
+    if (!condition) {
+      ADD_FAILURE() << "couldn't compile " << text.str();
+      return llvm::None;
+    }
+    m_reads.clear();
+    return condition->Evaluate(
+        [this](llvm::StringRef operand)
+            -> llvm::Optional<CompiledBreakpointCondition::OperandValue> {
+          m_reads.push_back(operand.str());
+          auto pos = m_values.find(operand);
+          if (pos != m_values.end())
+            return CompiledBreakpointCondition::OperandValue(pos->second);
+          pos = m_pointers.find(operand);
+          if (pos != m_pointers.end())
+            return CompiledBreakpointCondition::OperandValue(pos->second,
+                                                             true);
+          return llvm::None;
+        });
+  }
+
+  llvm::StringMap<Scalar> m_values;
+  llvm::StringMap<Scalar> m_pointers;
+  std::vector<std::string> m_reads;
+};
+} // namespace
+
+TEST(CompiledBreakpointConditionTest, Compile) {
+  EXPECT_TRUE(CompiledBreakpointCondition::Compile("i == 5"));
+  EXPECT_TRUE(CompiledBreakpointCondition::Compile("p->count > 2 && !zero"));
+  EXPECT_TRUE(CompiledBreakpointCondition::Compile("a.b->c[3] != 'x'"));
+  EXPECT_TRUE(CompiledBreakpointCondition::Compile("($rax & 0xff) == 0x10"));
+
+  // Side effects, calls, casts and anything that needs types are left to the
+  // expression parser.
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile(""));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("i = 5"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("i += 5"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("i++ < 5"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("strcmp(s, \"a\") == 0"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("(int)c == 1"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("sizeof(i) == 4"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("*p == 1"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("f < 1.5"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("a[i] == 1"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("ns::g == 1"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("i ? 1 : 2"));
+  EXPECT_FALSE(CompiledBreakpointCondition::Compile("(i == 1"));
+
+  llvm::Optional<CompiledBreakpointCondition> condition =
+      CompiledBreakpointCondition::Compile("x == y || x == z || x == 1");
+  ASSERT_TRUE(condition);
+  EXPECT_EQ(condition->GetOperands(),
+            (std::vector<std::string>{"x", "y", "z"}));
+}
+
+TEST(CompiledBreakpointConditionTest, Evaluate) {
+  ConditionEvaluator evaluator;
+  EXPECT_EQ(evaluator.Evaluate("i == -5"), true);
+  EXPECT_EQ(evaluator.Evaluate("i != -5"), false);
+  EXPECT_EQ(evaluator.Evaluate("i < 0 && u > 6"), true);
+  EXPECT_EQ(evaluator.Evaluate("c == 'x'"), true);
+  EXPECT_EQ(evaluator.Evaluate("c + 1 == 'y'"), true);
+  EXPECT_EQ(evaluator.Evaluate("p->count * 2 + 1 == 7"), true);
+  EXPECT_EQ(evaluator.Evaluate("array[2] % 10 == 2"), true);
+  EXPECT_EQ(evaluator.Evaluate("$rax >> 12 == 1"), true);
+  EXPECT_EQ(evaluator.Evaluate("($rax | 1) == 0x1001"), true);
+  EXPECT_EQ(evaluator.Evaluate("~zero == -1"), true);
+  EXPECT_EQ(evaluator.Evaluate("!zero"), true);
+  EXPECT_EQ(evaluator.Evaluate("zero"), false);
+  EXPECT_EQ(evaluator.Evaluate("u"), true);
+  EXPECT_EQ(evaluator.Evaluate("1 + 2 * 3 == 7"), true);
+  EXPECT_EQ(evaluator.Evaluate("(1 + 2) * 3 == 9"), true);
+  EXPECT_EQ(evaluator.Evaluate("10 - 4 - 3 == 3"), true);
+  EXPECT_EQ(evaluator.Evaluate("1 < 2 == 1"), true);
+  EXPECT_EQ(evaluator.Evaluate("true && !false"), true);
+  EXPECT_EQ(evaluator.Evaluate("0x7fffffffffffffff + 0 > 0"), true);
+  EXPECT_EQ(evaluator.Evaluate("0xffffffffffffffff == -1"), true);
+}
+
+TEST(CompiledBreakpointConditionTest, ShortCircuit) {
+  ConditionEvaluator evaluator;
+  // The right side of "&&" and "||" is not evaluated when the left side
+  // decides the result, so it is fine if it can not be read.
+  EXPECT_EQ(evaluator.Evaluate("zero && missing"), false);
+  EXPECT_EQ(evaluator.m_reads, (std::vector<std::string>{"zero"}));
+  EXPECT_EQ(evaluator.Evaluate("u || missing"), true);
+  EXPECT_EQ(evaluator.Evaluate("zero || u == 7 && i < 0"), true);
+  EXPECT_EQ(evaluator.Evaluate("zero && u || i"), true);
+
+  // Operands are read once per evaluation.
+  EXPECT_EQ(evaluator.Evaluate("i == 1 || i == 2 || i == -5"), true);
+  EXPECT_EQ(evaluator.m_reads, (std::vector<std::string>{"i"}));
+}
+
+TEST(CompiledBreakpointConditionTest, EvaluateFailure) {
+  ConditionEvaluator evaluator;
+  EXPECT_EQ(evaluator.Evaluate("u && missing"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("u / zero"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("u % zero"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("u << 64"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("u >> i"), llvm::None);
+}
+
+TEST(CompiledBreakpointConditionTest, Pointers) {
+  ConditionEvaluator evaluator;
+  // Comparing and testing pointers compares and tests their addresses.
+  EXPECT_EQ(evaluator.Evaluate("p == q"), false);
+  EXPECT_EQ(evaluator.Evaluate("p != q && p < q"), true);
+  EXPECT_EQ(evaluator.Evaluate("p == $rax"), true);
+  EXPECT_EQ(evaluator.Evaluate("p != nullptr && !zero"), true);
+  EXPECT_EQ(evaluator.Evaluate("!p || q"), true);
+  EXPECT_EQ(evaluator.Evaluate("(p == q) + 1 == 1"), true);
+
+  // Pointer arithmetic depends on the pointee type, so it is left to the
+  // expression parser.
+  EXPECT_EQ(evaluator.Evaluate("p + 1 == q"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("q - p == 1"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("p == q - u"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("(p & 3) == 0"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("-p"), llvm::None);
+  EXPECT_EQ(evaluator.Evaluate("zero || (p + 1)"), llvm::None);
+  // The same conditions on integers are evaluated.
+  EXPECT_EQ(evaluator.Evaluate("$rax + 4 == 0x1004"), true);
+  EXPECT_EQ(evaluator.Evaluate("u - i == 12"), true);
+}
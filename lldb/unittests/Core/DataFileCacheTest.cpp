@@ -0,0 +1,165 @@
+//===-- DataFileCacheTest.cpp ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/DataFileCache.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/StreamBuffer.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Endian.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+class DataFileCacheTest : public ::testing::Test {
+public:
+  void SetUp() override {
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("DataFileCache", m_dir));
+  }
+
+  void TearDown() override { llvm::sys::fs::remove_directories(m_dir); }
+
+  size_t CountCacheFiles() {
+    size_t count = 0;
+    std::error_code ec;
+    for (llvm::sys::fs::directory_iterator it(m_dir, ec), end;
+         it != end && !ec; it.increment(ec))
+      if (llvm::sys::path::filename(it->path()).startswith("llvmcache-"))
+        ++count;
+    return count;
+  }
+
+  llvm::SmallString<128> m_dir;
+};
+} // namespace
+
+static llvm::ArrayRef<uint8_t> AsBytes(llvm::StringRef s) {
+  return llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t *>(s.data()),
+                                 s.size());
+}
+
+TEST_F(DataFileCacheTest, SetGetRemove) {
+  DataFileCache cache(m_dir, llvm::CachePruningPolicy());
+  EXPECT_EQ(cache.GetCachedData("a"), nullptr);
+
+  EXPECT_TRUE(cache.SetCachedData("a", AsBytes("first")));
+  std::unique_ptr<llvm::MemoryBuffer> buffer = cache.GetCachedData("a");
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(buffer->getBuffer(), "first");
+
+  // Entries are replaced, and large ones are read just as well.
+  std::string large(3 * 4096, 'x');
+  EXPECT_TRUE(cache.SetCachedData("a", AsBytes(large)));
+  buffer = cache.GetCachedData("a");
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(buffer->getBuffer(), large);
+  EXPECT_EQ(CountCacheFiles(), 1u);
+
+  EXPECT_TRUE(cache.RemoveCacheFile("a").Success());
+  EXPECT_EQ(cache.GetCachedData("a"), nullptr);
+  EXPECT_EQ(CountCacheFiles(), 0u);
+}
+
+TEST_F(DataFileCacheTest, Prune) {
+  {
+    DataFileCache cache(m_dir, llvm::CachePruningPolicy());
+    EXPECT_TRUE(cache.SetCachedData("a", AsBytes("a")));
+    EXPECT_TRUE(cache.SetCachedData("b", AsBytes("b")));
+    EXPECT_TRUE(cache.SetCachedData("c", AsBytes("c")));
+  }
+  EXPECT_EQ(CountCacheFiles(), 3u);
+
+  llvm::CachePruningPolicy policy;
+  policy.Interval = std::chrono::seconds(0);
+  policy.MaxSizeFiles = 1;
+  DataFileCache cache(m_dir, policy);
+  EXPECT_EQ(CountCacheFiles(), 1u);
+}
+
+TEST_F(DataFileCacheTest, IndexCachePathSetting) {
+  // Test that the index cache follows the changes of its path setting.
+  ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  const bool enabled = properties.GetEnableLLDBIndexCache();
+  const FileSpec path = properties.GetLLDBIndexCachePath();
+  properties.SetEnableLLDBIndexCache(true);
+
+  llvm::SmallString<128> first_dir(m_dir), second_dir(m_dir);
+  llvm::sys::path::append(first_dir, "first");
+  llvm::sys::path::append(second_dir, "second");
+  properties.SetLLDBIndexCachePath(FileSpec(first_dir));
+  std::shared_ptr<DataFileCache> first = Module::GetIndexCache();
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first, Module::GetIndexCache());
+  EXPECT_TRUE(first->SetCachedData("a", AsBytes("a")));
+
+  properties.SetLLDBIndexCachePath(FileSpec(second_dir));
+  std::shared_ptr<DataFileCache> second = Module::GetIndexCache();
+  ASSERT_NE(second, nullptr);
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(llvm::sys::fs::is_directory(second_dir));
+  EXPECT_EQ(second->GetCachedData("a"), nullptr);
+
+  properties.SetEnableLLDBIndexCache(false);
+  EXPECT_EQ(Module::GetIndexCache(), nullptr);
+
+  properties.SetLLDBIndexCachePath(path);
+  properties.SetEnableLLDBIndexCache(enabled);
+}
+
+TEST(CacheSignatureTest, EncodeDecode) {
+  CacheSignature signature;
+  EXPECT_FALSE(signature.IsValid());
+  signature.m_uuid = UUID::fromData("0123456789abcdef", 16);
+  signature.m_mod_time = 1234;
+  EXPECT_TRUE(signature.IsValid());
+
+  StreamBuffer<64> strm(Stream::eBinary, 8, endian::InlHostByteOrder());
+  signature.Encode(strm);
+  DataExtractor data(strm.GetData(), strm.GetSize(),
+                     endian::InlHostByteOrder(), 8);
+  lldb::offset_t offset = 0;
+  CacheSignature decoded;
+  ASSERT_TRUE(decoded.Decode(data, &offset));
+  EXPECT_EQ(offset, strm.GetSize());
+  EXPECT_EQ(decoded, signature);
+
+  decoded.m_obj_mod_time = 5678;
+  EXPECT_NE(decoded, signature);
+
+  // A truncated signature is rejected.
+  DataExtractor truncated(strm.GetData(), strm.GetSize() - 1,
+                          endian::InlHostByteOrder(), 8);
+  offset = 0;
+  EXPECT_FALSE(decoded.Decode(truncated, &offset));
+}
+
+TEST(ConstStringTableTest, EncodeDecode) {
+  ConstString foo("foo"), bar("bar");
+  ConstStringTable strtab;
+  EXPECT_EQ(strtab.Add(foo), 0u);
+  EXPECT_EQ(strtab.Add(bar), 1u);
+  EXPECT_EQ(strtab.Add(foo), 0u);
+
+  StreamBuffer<64> strm(Stream::eBinary, 8, endian::InlHostByteOrder());
+  strtab.Encode(strm);
+  DataExtractor data(strm.GetData(), strm.GetSize(),
+                     endian::InlHostByteOrder(), 8);
+  lldb::offset_t offset = 0;
+  StringTableReader reader;
+  ASSERT_TRUE(reader.Decode(data, &offset));
+  EXPECT_EQ(offset, strm.GetSize());
+  EXPECT_EQ(reader.Get(0), foo);
+  EXPECT_EQ(reader.Get(1), bar);
+  EXPECT_EQ(reader.Get(2), ConstString());
+}
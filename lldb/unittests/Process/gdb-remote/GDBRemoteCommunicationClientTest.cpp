@@ -320,6 +320,42 @@ TEST_F(GDBRemoteCommunicationClientTest, SendSignalsToIgnore) {
   EXPECT_TRUE(result.get().Success());
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, ReadMemoryRanges) {
+  std::vector<std::pair<addr_t, size_t>> ranges = {
+      {0x1000, 4}, {0x2000, 2}, {0x3000, 3}};
+  std::vector<uint8_t> buffer(9, 0);
+  const auto &ReadMemoryRanges = [&](llvm::StringRef response) {
+    std::fill(buffer.begin(), buffer.end(), 0);
+    std::future<Expected<std::vector<size_t>>> result = std::async(
+        std::launch::async,
+        [&] { return client.ReadMemoryRanges(ranges, buffer); });
+
+    HandlePacket(server, "MultiMemRead:ranges:1000,4,2000,2,3000,3;",
+                 response);
+    return result.get();
+  };
+
+  // The data of the ranges that were read, or partially read, is put at the
+  // offset of each range.
+  Expected<std::vector<size_t>> bytes_read =
+      ReadMemoryRanges("4,0,2;ABCDXY");
+  ASSERT_THAT_EXPECTED(bytes_read, llvm::Succeeded());
+  EXPECT_EQ((std::vector<size_t>{4, 0, 2}), *bytes_read);
+  EXPECT_EQ((std::vector<uint8_t>{'A', 'B', 'C', 'D', 0, 0, 'X', 'Y', 0}),
+            buffer);
+
+  bytes_read = ReadMemoryRanges("4,2,3;ABCDEFGHI");
+  ASSERT_THAT_EXPECTED(bytes_read, llvm::Succeeded());
+  EXPECT_EQ((std::vector<size_t>{4, 2, 3}), *bytes_read);
+
+  EXPECT_THAT_EXPECTED(ReadMemoryRanges("E01"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(ReadMemoryRanges("4,2;ABCDEF"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(ReadMemoryRanges("4,2,3"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(ReadMemoryRanges("5,2,2;ABCDEFGHI"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(ReadMemoryRanges("4,2,3;ABCDEF"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(ReadMemoryRanges("4,2,2;ABCDEFGHI"), llvm::Failed());
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfo) {
   const lldb::addr_t addr = 0xa000;
   MemoryRegionInfo region_info;
@@ -15,6 +15,9 @@
 #include "TestingSupport/SubsystemRAII.h"
 #include "TestingSupport/Symbol/ClangTestUtils.h"
 #include "lldb/Core/Declaration.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/HostInfo.h"
 #include "clang/AST/DeclCXX.h"
@@ -256,3 +259,105 @@ TEST_F(TestClangASTImporter, RecordLayout) {
   EXPECT_EQ(0U, base_offsets.size());
   EXPECT_EQ(0U, vbase_offsets.size());
 }
+
+TEST_F(TestClangASTImporter, CompleteDefinition) {
+  // Test that the definitions found for forward declarations are remembered
+  // until their module goes away.
+  clang_utils::SourceASTWithRecord source_with_definition;
+  std::unique_ptr<TypeSystemClang> fwd_decl_source = clang_utils::createAST();
+  CompilerType fwd_decl_type = clang_utils::createRecord(
+      *fwd_decl_source, source_with_definition.record_decl->getName());
+  clang::TagDecl *fwd_decl = ClangUtil::GetAsTagDecl(fwd_decl_type);
+  clang::TagDecl *other_decl = ClangUtil::GetAsTagDecl(
+      clang_utils::createRecord(*fwd_decl_source, "OtherRecord"));
+
+  ClangASTImporter importer;
+  ModuleList images;
+  EXPECT_EQ(nullptr, importer.GetCompleteDefinition(fwd_decl, images));
+
+  ModuleSP module_sp = std::make_shared<Module>(ModuleSpec());
+  images.Append(module_sp);
+  importer.SetCompleteDefinition(fwd_decl, source_with_definition.record_decl,
+                                 module_sp);
+  EXPECT_EQ(source_with_definition.record_decl,
+            importer.GetCompleteDefinition(fwd_decl, images));
+  EXPECT_EQ(nullptr, importer.GetCompleteDefinition(other_decl, images));
+
+  // The forward declaration imported into another AST, like the one of the
+  // next expression, finds the definition too.
+  std::unique_ptr<TypeSystemClang> target_ast = clang_utils::createAST();
+  CompilerType imported = importer.CopyType(*target_ast, fwd_decl_type);
+  EXPECT_EQ(source_with_definition.record_decl,
+            importer.GetCompleteDefinition(ClangUtil::GetAsTagDecl(imported),
+                                           images));
+
+  module_sp.reset();
+  images.Clear();
+  EXPECT_EQ(nullptr, importer.GetCompleteDefinition(fwd_decl, images));
+}
+
+TEST_F(TestClangASTImporter, CompleteDefinitionModuleUnloaded) {
+  // Test that a definition is forgotten once its module is no longer one of
+  // the target's images, even while the module is still alive.
+  clang_utils::SourceASTWithRecord source_with_definition;
+  std::unique_ptr<TypeSystemClang> fwd_decl_source = clang_utils::createAST();
+  clang::TagDecl *fwd_decl =
+      ClangUtil::GetAsTagDecl(clang_utils::createRecord(
+          *fwd_decl_source, source_with_definition.record_decl->getName()));
+
+  ClangASTImporter importer;
+  ModuleList images;
+  ModuleSP module_sp = std::make_shared<Module>(ModuleSpec());
+  images.Append(module_sp);
+  importer.SetCompleteDefinition(fwd_decl, source_with_definition.record_decl,
+                                 module_sp);
+  EXPECT_EQ(source_with_definition.record_decl,
+            importer.GetCompleteDefinition(fwd_decl, images));
+
+  images.Remove(module_sp);
+  EXPECT_EQ(nullptr, importer.GetCompleteDefinition(fwd_decl, images));
+  // Loading the module again requires searching for the definition again.
+  images.Append(module_sp);
+  EXPECT_EQ(nullptr, importer.GetCompleteDefinition(fwd_decl, images));
+}
+
+TEST_F(TestClangASTImporter, CompleteDefinitionSameName) {
+  // Test that forward declarations with the same name from different ASTs
+  // keep the definitions found for each of them.
+  clang_utils::SourceASTWithRecord first_definition;
+  clang_utils::SourceASTWithRecord second_definition;
+  llvm::StringRef name = first_definition.record_decl->getName();
+  ASSERT_EQ(name, second_definition.record_decl->getName());
+
+  std::unique_ptr<TypeSystemClang> first_source = clang_utils::createAST();
+  std::unique_ptr<TypeSystemClang> second_source = clang_utils::createAST();
+  clang::TagDecl *first_fwd_decl = ClangUtil::GetAsTagDecl(
+      clang_utils::createRecord(*first_source, name));
+  clang::TagDecl *second_fwd_decl = ClangUtil::GetAsTagDecl(
+      clang_utils::createRecord(*second_source, name));
+
+  ClangASTImporter importer;
+  ModuleList images;
+  ModuleSP first_module_sp = std::make_shared<Module>(ModuleSpec());
+  ModuleSP second_module_sp = std::make_shared<Module>(ModuleSpec());
+  images.Append(first_module_sp);
+  images.Append(second_module_sp);
+
+  importer.SetCompleteDefinition(first_fwd_decl, first_definition.record_decl,
+                                 first_module_sp);
+  EXPECT_EQ(nullptr, importer.GetCompleteDefinition(second_fwd_decl, images));
+
+  importer.SetCompleteDefinition(second_fwd_decl,
+                                 second_definition.record_decl,
+                                 second_module_sp);
+  EXPECT_EQ(first_definition.record_decl,
+            importer.GetCompleteDefinition(first_fwd_decl, images));
+  EXPECT_EQ(second_definition.record_decl,
+            importer.GetCompleteDefinition(second_fwd_decl, images));
+
+  // Unloading one of the modules leaves the other definition alone.
+  images.Remove(first_module_sp);
+  EXPECT_EQ(nullptr, importer.GetCompleteDefinition(first_fwd_decl, images));
+  EXPECT_EQ(second_definition.record_decl,
+            importer.GetCompleteDefinition(second_fwd_decl, images));
+}
@@ -0,0 +1,90 @@
+//===-- DWARFIndexCachingTest.cpp -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "Plugins/SymbolFile/DWARF/DIERef.h"
+#include "Plugins/SymbolFile/DWARF/NameToDIE.h"
+#include "lldb/Core/DataFileCache.h"
+#include "lldb/Core/StreamBuffer.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Endian.h"
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static void EncodeDecode(const DIERef &object) {
+  StreamBuffer<32> strm(Stream::eBinary, 8, endian::InlHostByteOrder());
+  object.Encode(strm);
+  DataExtractor data(strm.GetData(), strm.GetSize(),
+                     endian::InlHostByteOrder(), 8);
+  lldb::offset_t offset = 0;
+  llvm::Optional<DIERef> decoded = DIERef::Decode(data, &offset);
+  ASSERT_TRUE(decoded.hasValue());
+  EXPECT_EQ(offset, strm.GetSize());
+  EXPECT_EQ(decoded->dwo_num(), object.dwo_num());
+  EXPECT_EQ(decoded->section(), object.section());
+  EXPECT_EQ(decoded->die_offset(), object.die_offset());
+}
+
+TEST(DWARFIndexCachingTest, DIERefEncodeDecode) {
+  EncodeDecode(DIERef(llvm::None, DIERef::DebugInfo, 0x11223344));
+  EncodeDecode(DIERef(llvm::None, DIERef::DebugTypes, 0));
+  EncodeDecode(DIERef(100, DIERef::DebugInfo, 0x11223344));
+  EncodeDecode(DIERef(0x3fffffff, DIERef::DebugTypes, 0xffffffff));
+
+  // A DIERef without its offset is rejected.
+  StreamBuffer<32> strm(Stream::eBinary, 8, endian::InlHostByteOrder());
+  DIERef(1, DIERef::DebugInfo, 0x10).Encode(strm);
+  DataExtractor data(strm.GetData(), strm.GetSize() - 1,
+                     endian::InlHostByteOrder(), 8);
+  lldb::offset_t offset = 0;
+  EXPECT_FALSE(DIERef::Decode(data, &offset).hasValue());
+}
+
+TEST(DWARFIndexCachingTest, NameToDIEEncodeDecode) {
+  NameToDIE map;
+  ConstString foo("foo"), bar("bar");
+  map.Insert(foo, DIERef(llvm::None, DIERef::DebugInfo, 0x10));
+  map.Insert(bar, DIERef(llvm::None, DIERef::DebugInfo, 0x20));
+  map.Insert(foo, DIERef(2, DIERef::DebugTypes, 0x30));
+  map.Finalize();
+
+  StreamBuffer<64> strm(Stream::eBinary, 8, endian::InlHostByteOrder());
+  ConstStringTable strtab;
+  map.Encode(strm, strtab);
+  StreamBuffer<64> strtab_strm(Stream::eBinary, 8, endian::InlHostByteOrder());
+  strtab.Encode(strtab_strm);
+
+  DataExtractor strtab_data(strtab_strm.GetData(), strtab_strm.GetSize(),
+                            endian::InlHostByteOrder(), 8);
+  lldb::offset_t offset = 0;
+  StringTableReader reader;
+  ASSERT_TRUE(reader.Decode(strtab_data, &offset));
+
+  DataExtractor data(strm.GetData(), strm.GetSize(),
+                     endian::InlHostByteOrder(), 8);
+  offset = 0;
+  NameToDIE decoded;
+  ASSERT_TRUE(decoded.Decode(data, &offset, reader));
+  EXPECT_EQ(offset, strm.GetSize());
+
+  std::vector<dw_offset_t> foo_offsets;
+  decoded.Find(foo, [&](DIERef ref) {
+    foo_offsets.push_back(ref.die_offset());
+    return true;
+  });
+  llvm::sort(foo_offsets);
+  EXPECT_EQ(foo_offsets, (std::vector<dw_offset_t>{0x10, 0x30}));
+
+  std::vector<dw_offset_t> bar_offsets;
+  decoded.Find(bar, [&](DIERef ref) {
+    bar_offsets.push_back(ref.die_offset());
+    return true;
+  });
+  EXPECT_EQ(bar_offsets, (std::vector<dw_offset_t>{0x20}));
+}
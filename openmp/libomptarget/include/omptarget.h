@@ -153,6 +153,16 @@ class AsyncInfoTy {
   __tgt_async_info AsyncInfo;
   DeviceTy &Device;
 
+  /// A host to device copy that has not been issued yet because the next one
+  /// may continue it, see DeviceTy::submitData.
+  struct {
+    void *TgtPtrBegin = nullptr;
+    void *HstPtrBegin = nullptr;
+    int64_t Size = 0;
+  } PendingSubmit;
+
+  friend struct DeviceTy;
+
 public:
   AsyncInfoTy(DeviceTy &Device) : Device(Device) {}
   ~AsyncInfoTy() { synchronize(); }
@@ -166,6 +176,12 @@ public:
   /// \returns OFFLOAD_FAIL or OFFLOAD_SUCCESS appropriately.
   int synchronize();
 
+  /// Issue the host to device copy held back by DeviceTy::submitData, if any.
+  /// Every other operation on this queue issues it first.
+  ///
+  /// \returns OFFLOAD_FAIL or OFFLOAD_SUCCESS appropriately.
+  int flushSubmit();
+
   /// Return a void* reference with a lifetime that is at least as long as this
   /// AsyncInfoTy object. The location can be used as intermediate buffer.
   void *&getVoidPtrLocation();
@@ -168,11 +168,17 @@ EXTERN int omp_target_memcpy(void *dst, const void *src, size_t length,
     DeviceTy &DstDev = PM->Devices[dst_device];
     AsyncInfoTy AsyncInfo(DstDev);
     rc = DstDev.submitData(dstAddr, srcAddr, length, AsyncInfo);
+    // The copy may only be issued when the queue is synchronized, so that is
+    // where it fails.
+    if (rc == OFFLOAD_SUCCESS)
+      rc = AsyncInfo.synchronize();
   } else if (dst_device == omp_get_initial_device()) {
     DP("copy from device to host\n");
     DeviceTy &SrcDev = PM->Devices[src_device];
     AsyncInfoTy AsyncInfo(SrcDev);
     rc = SrcDev.retrieveData(dstAddr, srcAddr, length, AsyncInfo);
+    if (rc == OFFLOAD_SUCCESS)
+      rc = AsyncInfo.synchronize();
   } else {
     DP("copy from device to device\n");
     DeviceTy &SrcDev = PM->Devices[src_device];
@@ -182,6 +188,8 @@ EXTERN int omp_target_memcpy(void *dst, const void *src, size_t length,
     if (SrcDev.isDataExchangable(DstDev)) {
       AsyncInfoTy AsyncInfo(SrcDev);
       rc = SrcDev.dataExchange(srcAddr, DstDev, dstAddr, length, AsyncInfo);
+      if (rc == OFFLOAD_SUCCESS)
+        rc = AsyncInfo.synchronize();
       if (rc == OFFLOAD_SUCCESS)
         return OFFLOAD_SUCCESS;
     }
@@ -190,10 +198,14 @@ EXTERN int omp_target_memcpy(void *dst, const void *src, size_t length,
     {
       AsyncInfoTy AsyncInfo(SrcDev);
       rc = SrcDev.retrieveData(buffer, srcAddr, length, AsyncInfo);
+      if (rc == OFFLOAD_SUCCESS)
+        rc = AsyncInfo.synchronize();
     }
     if (rc == OFFLOAD_SUCCESS) {
       AsyncInfoTy AsyncInfo(SrcDev);
       rc = DstDev.submitData(dstAddr, buffer, length, AsyncInfo);
+      if (rc == OFFLOAD_SUCCESS)
+        rc = AsyncInfo.synchronize();
     }
     free(buffer);
   }
@@ -121,7 +121,7 @@ uint64_t DeviceTy::getMapEntryRefCnt(void *HstPtrBegin) {
   uintptr_t hp = (uintptr_t)HstPtrBegin;
   uint64_t RefCnt = 0;
 
-  DataMapMtx.lock();
+  DataMapMtx.lock_shared();
   if (!HostDataToTargetMap.empty()) {
     auto upper = HostDataToTargetMap.upper_bound(hp);
     if (upper != HostDataToTargetMap.begin()) {
@@ -132,7 +132,7 @@ uint64_t DeviceTy::getMapEntryRefCnt(void *HstPtrBegin) {
       }
     }
   }
-  DataMapMtx.unlock();
+  DataMapMtx.unlock_shared();
 
   if (RefCnt == 0) {
     DP("DeviceTy::getMapEntry: requested entry not found\n");
@@ -201,8 +201,28 @@ void *DeviceTy::getOrAllocTgtPtr(void *HstPtrBegin, void *HstPtrBase,
   void *rc = NULL;
   IsHostPtr = false;
   IsNew = false;
-  DataMapMtx.lock();
+  // Whether the lookup result leads to the creation of a new entry below
+  auto CreatesEntry = [&](const LookupResult &lr) {
+    return !lr.Flags.IsContained && !lr.Flags.ExtendsBefore &&
+           !lr.Flags.ExtendsAfter &&
+           !(PM->RTLs.RequiresFlags & OMP_REQ_UNIFIED_SHARED_MEMORY &&
+             !HasCloseModifier) &&
+           !HasPresentModifier && Size;
+  };
+
+  // Mapping an existing entry only updates its reference count, which is
+  // atomic, so the lookup holds the lock shared. Creating an entry needs it
+  // exclusively, and the lookup is repeated then as another thread may have
+  // created the entry in between.
+  bool IsExclusive = false;
+  DataMapMtx.lock_shared();
   LookupResult lr = lookupMapping(HstPtrBegin, Size);
+  if (CreatesEntry(lr)) {
+    DataMapMtx.unlock_shared();
+    DataMapMtx.lock();
+    IsExclusive = true;
+    lr = lookupMapping(HstPtrBegin, Size);
+  }
 
   // Check if the pointer is contained.
   // If a variable is mapped to the device manually by the user - which would
@@ -262,6 +282,7 @@ void *DeviceTy::getOrAllocTgtPtr(void *HstPtrBegin, void *HstPtrBase,
             DPxPTR(HstPtrBegin), Size);
   } else if (Size) {
     // If it is not contained and Size > 0, we should create a new entry for it.
+    assert(IsExclusive && "new entry created under a shared lock");
     IsNew = true;
     uintptr_t tp = (uintptr_t)allocData(Size, HstPtrBegin);
     INFO(OMP_INFOTYPE_MAPPING_CHANGED, DeviceID,
@@ -275,7 +296,10 @@ void *DeviceTy::getOrAllocTgtPtr(void *HstPtrBegin, void *HstPtrBase,
     rc = (void *)tp;
   }
 
-  DataMapMtx.unlock();
+  if (IsExclusive)
+    DataMapMtx.unlock();
+  else
+    DataMapMtx.unlock_shared();
   return rc;
 }
 
@@ -288,16 +312,18 @@ void *DeviceTy::getTgtPtrBegin(void *HstPtrBegin, int64_t Size, bool &IsLast,
   void *rc = NULL;
   IsHostPtr = false;
   IsLast = false;
-  DataMapMtx.lock();
+  DataMapMtx.lock_shared();
   LookupResult lr = lookupMapping(HstPtrBegin, Size);
 
   if (lr.Flags.IsContained ||
       (!MustContain && (lr.Flags.ExtendsBefore || lr.Flags.ExtendsAfter))) {
     auto &HT = *lr.Entry;
-    IsLast = HT.getRefCount() == 1;
-
-    if (!IsLast && UpdateRefCount)
-      HT.decRefCount();
+    // The last reference is released by deallocTgtPtr, which removes the
+    // entry
+    if (UpdateRefCount)
+      IsLast = HT.decRefCountUnlessLast();
+    else
+      IsLast = HT.getRefCount() == 1;
 
     uintptr_t tp = HT.TgtPtrBegin + ((uintptr_t)HstPtrBegin - HT.HstPtrBegin);
     DP("Mapping exists with HstPtrBegin=" DPxMOD ", TgtPtrBegin=" DPxMOD ", "
@@ -317,7 +343,7 @@ void *DeviceTy::getTgtPtrBegin(void *HstPtrBegin, int64_t Size, bool &IsLast,
     rc = HstPtrBegin;
   }
 
-  DataMapMtx.unlock();
+  DataMapMtx.unlock_shared();
   return rc;
 }
 
@@ -432,6 +458,34 @@ int32_t DeviceTy::submitData(void *TgtPtrBegin, void *HstPtrBegin, int64_t Size,
                                 : "unknown");
   }
 
+  // Copies through the queue of another device cannot be held back, as the
+  // queue issues what it holds on its own device.
+  if (&AsyncInfo.Device != this)
+    return issueSubmit(TgtPtrBegin, HstPtrBegin, Size, AsyncInfo);
+
+  auto &Pending = AsyncInfo.PendingSubmit;
+  if (Pending.Size &&
+      (char *)TgtPtrBegin == (char *)Pending.TgtPtrBegin + Pending.Size &&
+      (char *)HstPtrBegin == (char *)Pending.HstPtrBegin + Pending.Size) {
+    DP("Coalescing copy of %" PRId64 " bytes to device with the previous one "
+       "of %" PRId64 " bytes at TgtPtr=" DPxMOD "\n",
+       Size, Pending.Size, DPxPTR(Pending.TgtPtrBegin));
+    Pending.Size += Size;
+    return OFFLOAD_SUCCESS;
+  }
+
+  int32_t Ret = AsyncInfo.flushSubmit();
+  if (Ret != OFFLOAD_SUCCESS)
+    return Ret;
+  Pending.TgtPtrBegin = TgtPtrBegin;
+  Pending.HstPtrBegin = HstPtrBegin;
+  Pending.Size = Size;
+  return OFFLOAD_SUCCESS;
+}
+
+int32_t DeviceTy::issueSubmit(void *TgtPtrBegin, void *HstPtrBegin,
+                              int64_t Size, AsyncInfoTy &AsyncInfo) {
+  TIMESCOPE();
   if (!AsyncInfo || !RTL->data_submit_async || !RTL->synchronize)
     return RTL->data_submit(RTLDeviceID, TgtPtrBegin, HstPtrBegin, Size);
   else
@@ -453,6 +507,11 @@ int32_t DeviceTy::retrieveData(void *HstPtrBegin, void *TgtPtrBegin,
                                 : "unknown");
   }
 
+  int32_t Ret = AsyncInfo.flushSubmit();
+  if (Ret != OFFLOAD_SUCCESS)
+    return Ret;
+
+  TIMESCOPE();
   if (!RTL->data_retrieve_async || !RTL->synchronize)
     return RTL->data_retrieve(RTLDeviceID, HstPtrBegin, TgtPtrBegin, Size);
   else
@@ -463,6 +522,10 @@ int32_t DeviceTy::retrieveData(void *HstPtrBegin, void *TgtPtrBegin,
 // Copy data from current device to destination device directly
 int32_t DeviceTy::dataExchange(void *SrcPtr, DeviceTy &DstDev, void *DstPtr,
                                int64_t Size, AsyncInfoTy &AsyncInfo) {
+  int32_t Ret = AsyncInfo.flushSubmit();
+  if (Ret != OFFLOAD_SUCCESS)
+    return Ret;
+
   if (!AsyncInfo || !RTL->data_exchange_async || !RTL->synchronize) {
     assert(RTL->data_exchange && "RTL->data_exchange is nullptr");
     return RTL->data_exchange(RTLDeviceID, SrcPtr, DstDev.RTLDeviceID, DstPtr,
@@ -476,6 +539,10 @@ int32_t DeviceTy::dataExchange(void *SrcPtr, DeviceTy &DstDev, void *DstPtr,
 int32_t DeviceTy::runRegion(void *TgtEntryPtr, void **TgtVarsPtr,
                             ptrdiff_t *TgtOffsets, int32_t TgtVarsSize,
                             AsyncInfoTy &AsyncInfo) {
+  int32_t Ret = AsyncInfo.flushSubmit();
+  if (Ret != OFFLOAD_SUCCESS)
+    return Ret;
+
   if (!RTL->run_region || !RTL->synchronize)
     return RTL->run_region(RTLDeviceID, TgtEntryPtr, TgtVarsPtr, TgtOffsets,
                            TgtVarsSize);
@@ -490,6 +557,10 @@ int32_t DeviceTy::runTeamRegion(void *TgtEntryPtr, void **TgtVarsPtr,
                                 int32_t NumTeams, int32_t ThreadLimit,
                                 uint64_t LoopTripCount,
                                 AsyncInfoTy &AsyncInfo) {
+  int32_t Ret = AsyncInfo.flushSubmit();
+  if (Ret != OFFLOAD_SUCCESS)
+    return Ret;
+
   if (!RTL->run_team_region_async || !RTL->synchronize)
     return RTL->run_team_region(RTLDeviceID, TgtEntryPtr, TgtVarsPtr,
                                 TgtOffsets, TgtVarsSize, NumTeams, ThreadLimit,
@@ -13,6 +13,7 @@
 #ifndef _OMPTARGET_DEVICE_H
 #define _OMPTARGET_DEVICE_H
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <list>
@@ -20,6 +21,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include "omptarget.h"
@@ -51,7 +53,9 @@ struct HostDataToTargetTy {
 
 private:
   /// use mutable to allow modification via std::set iterator which is const.
-  mutable uint64_t RefCount;
+  /// Atomic, as it is updated by threads sharing DeviceTy::DataMapMtx. An
+  /// infinite count never changes.
+  mutable std::atomic<uint64_t> RefCount;
   static const uint64_t INFRefCount = ~(uint64_t)0;
 
 public:
@@ -60,34 +64,54 @@ public:
       : HstPtrBase(BP), HstPtrBegin(B), HstPtrEnd(E), HstPtrName(Name),
         TgtPtrBegin(TB), RefCount(IsINF ? INFRefCount : 1) {}
 
-  uint64_t getRefCount() const { return RefCount; }
+  HostDataToTargetTy(const HostDataToTargetTy &Other)
+      : HstPtrBase(Other.HstPtrBase), HstPtrBegin(Other.HstPtrBegin),
+        HstPtrEnd(Other.HstPtrEnd), HstPtrName(Other.HstPtrName),
+        TgtPtrBegin(Other.TgtPtrBegin), RefCount(Other.getRefCount()) {}
+
+  uint64_t getRefCount() const { return RefCount.load(); }
 
   uint64_t resetRefCount() const {
-    if (RefCount != INFRefCount)
-      RefCount = 1;
+    if (isRefCountInf())
+      return INFRefCount;
 
-    return RefCount;
+    RefCount = 1;
+    return 1;
   }
 
   uint64_t incRefCount() const {
-    if (RefCount != INFRefCount) {
-      ++RefCount;
-      assert(RefCount < INFRefCount && "refcount overflow");
-    }
+    if (isRefCountInf())
+      return INFRefCount;
 
-    return RefCount;
+    uint64_t NewRefCount = ++RefCount;
+    assert(NewRefCount < INFRefCount && "refcount overflow");
+    return NewRefCount;
   }
 
   uint64_t decRefCount() const {
-    if (RefCount != INFRefCount) {
-      assert(RefCount > 0 && "refcount underflow");
-      --RefCount;
-    }
+    if (isRefCountInf())
+      return INFRefCount;
+
+    uint64_t OldRefCount = RefCount--;
+    (void)OldRefCount;
+    assert(OldRefCount > 0 && "refcount underflow");
+    return OldRefCount - 1;
+  }
 
-    return RefCount;
+  /// Decrement the reference count unless this is the last reference, which
+  /// is left for the removal of the entry. Return true if it is the last one.
+  bool decRefCountUnlessLast() const {
+    uint64_t OldRefCount = RefCount.load();
+    do {
+      if (OldRefCount == 1)
+        return true;
+      if (OldRefCount == INFRefCount)
+        return false;
+    } while (!RefCount.compare_exchange_weak(OldRefCount, OldRefCount - 1));
+    return false;
   }
 
-  bool isRefCountInf() const { return RefCount == INFRefCount; }
+  bool isRefCountInf() const { return RefCount.load() == INFRefCount; }
 };
 
 typedef uintptr_t HstPtrBeginTy;
@@ -146,7 +170,11 @@ struct DeviceTy {
 
   ShadowPtrListTy ShadowPtrMap;
 
-  std::mutex DataMapMtx, PendingGlobalsMtx, ShadowMtx;
+  /// Guards HostDataToTargetMap. Lookups, including those updating reference
+  /// counts, hold it shared so that the threads offloading to the device do
+  /// not serialize; only adding and removing entries holds it exclusively.
+  std::shared_timed_mutex DataMapMtx;
+  std::mutex PendingGlobalsMtx, ShadowMtx;
 
   // NOTE: Once libomp gains full target-task support, this state should be
   // moved into the target task in libomp.
@@ -201,7 +229,10 @@ struct DeviceTy {
 
   // Data transfer. When AsyncInfo is nullptr, the transfer will be
   // synchronous.
-  // Copy data from host to device
+  // Copy data from host to device. A copy that continues the previous one on
+  // both the host and the device is merged with it, so adjacent copies reach
+  // the plugin as one; the source has to stay valid until AsyncInfo is
+  // synchronized, as for any asynchronous copy.
   int32_t submitData(void *TgtPtrBegin, void *HstPtrBegin, int64_t Size,
                      AsyncInfoTy &AsyncInfo);
   // Copy data from device back to host
@@ -225,6 +256,11 @@ struct DeviceTy {
 private:
   // Call to RTL
   void init(); // To be called only via DeviceTy::initOnce()
+
+  /// Issue a host to device copy through the plugin, without coalescing.
+  int32_t issueSubmit(void *TgtPtrBegin, void *HstPtrBegin, int64_t Size,
+                      AsyncInfoTy &AsyncInfo);
+  friend class AsyncInfoTy;
 };
 
 /// Map between Device ID (i.e. openmp device id) and its DeviceTy.
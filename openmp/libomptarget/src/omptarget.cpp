@@ -20,8 +20,9 @@
 #include <vector>
 
 int AsyncInfoTy::synchronize() {
-  int Result = OFFLOAD_SUCCESS;
-  if (AsyncInfo.Queue) {
+  TIMESCOPE();
+  int Result = flushSubmit();
+  if (Result == OFFLOAD_SUCCESS && AsyncInfo.Queue) {
     // If we have a queue we need to synchronize it now.
     Result = Device.synchronize(*this);
     assert(AsyncInfo.Queue == nullptr &&
@@ -31,6 +32,16 @@ int AsyncInfoTy::synchronize() {
   return Result;
 }
 
+int AsyncInfoTy::flushSubmit() {
+  if (!PendingSubmit.Size)
+    return OFFLOAD_SUCCESS;
+  void *TgtPtrBegin = PendingSubmit.TgtPtrBegin;
+  void *HstPtrBegin = PendingSubmit.HstPtrBegin;
+  int64_t Size = PendingSubmit.Size;
+  PendingSubmit.Size = 0;
+  return Device.issueSubmit(TgtPtrBegin, HstPtrBegin, Size, *this);
+}
+
 void *&AsyncInfoTy::getVoidPtrLocation() {
   BufferLocations.push_back(nullptr);
   return BufferLocations.back();
@@ -114,7 +114,7 @@ static inline void dumpTargetPointerMappings(const ident_t *Loc,
        Kernel.getFilename(), Kernel.getLine(), Kernel.getColumn());
   INFO(OMP_INFOTYPE_ALL, Device.DeviceID, "%-18s %-18s %s %s %s\n", "Host Ptr",
        "Target Ptr", "Size (B)", "RefCount", "Declaration");
-  Device.DataMapMtx.lock();
+  Device.DataMapMtx.lock_shared();
   for (const auto &HostTargetMap : Device.HostDataToTargetMap) {
     SourceInfo Info(HostTargetMap.HstPtrName);
     INFO(OMP_INFOTYPE_ALL, Device.DeviceID,
@@ -124,7 +124,7 @@ static inline void dumpTargetPointerMappings(const ident_t *Loc,
          HostTargetMap.getRefCount(), Info.getName(), Info.getFilename(),
          Info.getLine(), Info.getColumn());
   }
-  Device.DataMapMtx.unlock();
+  Device.DataMapMtx.unlock_shared();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,58 @@
+// RUN: %libomptarget-compile-run-and-check-generic
+
+// Copies of adjacent struct members are merged before they reach the plugin.
+// Check that the merged copies, and the ones that cannot be merged, still
+// move the right values.
+
+#include <stdio.h>
+
+#define N 16
+
+struct S {
+  int a[N];
+  int b[N];
+  int *p;
+  int c[N];
+};
+
+int main() {
+  struct S s;
+  int x[N];
+  for (int i = 0; i < N; ++i) {
+    s.a[i] = i;
+    s.b[i] = N + i;
+    s.c[i] = 2 * N + i;
+    x[i] = 3 * N + i;
+  }
+  s.p = x;
+
+  int sum = 0;
+#pragma omp target data map(to : s.a, s.b, s.p, s.p[0 : N], s.c)
+  {
+#pragma omp target map(tofrom : sum)
+    for (int i = 0; i < N; ++i)
+      sum += s.a[i] + s.b[i] + s.p[i] + s.c[i];
+
+    // CHECK: sum 2016
+    printf("sum %d\n", sum);
+
+    for (int i = 0; i < N; ++i) {
+      s.b[i] = 1;
+      s.c[i] = 2;
+    }
+#pragma omp target update to(s.b, s.c)
+
+    sum = 0;
+#pragma omp target map(tofrom : sum)
+    for (int i = 0; i < N; ++i)
+      sum += s.a[i] + s.b[i] + s.p[i] + s.c[i];
+
+    // CHECK: sum 1056
+    printf("sum %d\n", sum);
+  }
+
+  // CHECK: p restored 1
+  printf("p restored %d\n", s.p == x);
+
+  return 0;
+}
@@ -0,0 +1,35 @@
+// RUN: %libomptarget-compile-generic && env LIBOMPTARGET_DEBUG=1 %libomptarget-run-generic 2>&1 | %fcheck-generic -allow-empty -check-prefix=DEBUG
+// REQUIRES: libomptarget-debug
+
+// Copies of adjacent struct members reach the plugin as one copy.
+
+#include <stdio.h>
+
+#define N 16
+
+struct S {
+  int a[N];
+  int b[N];
+  int c[N];
+};
+
+int main() {
+  struct S s;
+  for (int i = 0; i < N; ++i) {
+    s.a[i] = i;
+    s.b[i] = N + i;
+    s.c[i] = 2 * N + i;
+  }
+
+  int sum = 0;
+  // DEBUG: Coalescing copy of 64 bytes to device with the previous one of 64 bytes
+  // DEBUG: Coalescing copy of 64 bytes to device with the previous one of 128 bytes
+#pragma omp target map(to : s.a, s.b, s.c) map(tofrom : sum)
+  for (int i = 0; i < N; ++i)
+    sum += s.a[i] + s.b[i] + s.c[i];
+
+  // DEBUG: sum 1128
+  printf("sum %d\n", sum);
+
+  return 0;
+}
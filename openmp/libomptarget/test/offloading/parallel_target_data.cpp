@@ -0,0 +1,54 @@
+// RUN: %libomptarget-compilexx-run-and-check-generic
+
+// Many threads map the same array, whose reference count they update
+// concurrently, and arrays of their own, whose entries they add to and remove
+// from the mapping table concurrently. The shared array is mapped, and copied
+// to the device, before the threads start: a thread finding an entry another
+// one has just added does not wait for its data to be copied.
+
+#include <cassert>
+#include <iostream>
+#include <omp.h>
+
+int main(int argc, char *argv[]) {
+  constexpr const int num_threads = 16, num_iters = 200, N = 64;
+  int shared[N];
+  int sums[num_threads] = {0};
+
+  for (int j = 0; j < N; ++j)
+    shared[j] = j;
+
+#pragma omp target data map(to : shared)
+#pragma omp parallel for num_threads(num_threads)
+  for (int i = 0; i < num_threads; ++i) {
+    int tmp[N];
+
+    for (int it = 0; it < num_iters; ++it) {
+      for (int j = 0; j < N; ++j)
+        tmp[j] = i;
+
+#pragma omp target data map(to : shared) map(tofrom : tmp)
+      {
+#pragma omp target
+        for (int j = 0; j < N; ++j)
+          tmp[j] += shared[j];
+      }
+
+      for (int j = 0; j < N; ++j)
+        sums[i] += tmp[j];
+    }
+  }
+
+  // Verify
+  for (int i = 0; i < num_threads; ++i) {
+    const int ref = ((0 + N - 1) * N / 2 + i * N) * num_iters;
+    assert(sums[i] == ref);
+  }
+  assert(!omp_target_is_present(shared, omp_get_default_device()));
+
+  std::cout << "PASS\n";
+
+  return 0;
+}
+
+// CHECK: PASS
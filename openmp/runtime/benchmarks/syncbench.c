@@ -0,0 +1,230 @@
+/*
+ * syncbench.c -- synchronization overhead microbenchmark
+ */
+
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+/* Measures the overhead of the synchronizing constructs the way the EPCC
+   OpenMP microbenchmarks do: every thread runs a delay loop `--inner-reps`
+   times with the construct around or after every iteration, and the time of
+   the same delays without it, the reference, is subtracted. The overhead per
+   construct is averaged over `--outer-reps` runs. The report has one line per
+   construct and thread count:
+     construct  threads  overhead(us)  stddev(us)
+   The barrier patterns under test are selected with the
+   KMP_{PLAIN,FORKJOIN,REDUCTION}_BARRIER_PATTERN environment variables. */
+
+#include <math.h>
+#include <omp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int outer_reps = 20;
+static int inner_reps = 1000;
+static double delay_us = 0.1;
+static int delay_length;
+static int thread_counts[64];
+static int num_thread_counts = 0;
+static const char *only_construct = NULL;
+
+// The delay loop of EPCC, which the compiler cannot remove
+static void delay(int length) {
+  volatile float a = 0.0f;
+  for (int i = 0; i < length; ++i)
+    a += (float)i;
+  if (a < 0)
+    printf("%f\n", a);
+}
+
+// Finds the loop length of a delay of delay_us microseconds
+static void calibrate_delay(void) {
+  int length = 1;
+  for (;;) {
+    double start = omp_get_wtime();
+    for (int i = 0; i < 100; ++i)
+      delay(length);
+    double elapsed = (omp_get_wtime() - start) / 100;
+    if (elapsed > delay_us * 1e-6 || length > (1 << 28))
+      break;
+    length *= 2;
+  }
+  delay_length = length;
+}
+
+static void reference(int threads) {
+#pragma omp parallel num_threads(threads)
+  for (int j = 0; j < inner_reps; ++j)
+    delay(delay_length);
+}
+
+static void test_parallel(int threads) {
+  for (int j = 0; j < inner_reps; ++j) {
+#pragma omp parallel num_threads(threads)
+    delay(delay_length);
+  }
+}
+
+static void test_for(int threads) {
+#pragma omp parallel num_threads(threads)
+  for (int j = 0; j < inner_reps; ++j) {
+#pragma omp for
+    for (int i = 0; i < threads; ++i)
+      delay(delay_length);
+  }
+}
+
+static void test_parallel_for(int threads) {
+  for (int j = 0; j < inner_reps; ++j) {
+#pragma omp parallel for num_threads(threads)
+    for (int i = 0; i < threads; ++i)
+      delay(delay_length);
+  }
+}
+
+static void test_barrier(int threads) {
+#pragma omp parallel num_threads(threads)
+  for (int j = 0; j < inner_reps; ++j) {
+    delay(delay_length);
+#pragma omp barrier
+  }
+}
+
+static void test_single(int threads) {
+#pragma omp parallel num_threads(threads)
+  for (int j = 0; j < inner_reps; ++j) {
+#pragma omp single
+    delay(delay_length);
+  }
+}
+
+static void test_reduction(int threads) {
+  int sum = 0;
+  for (int j = 0; j < inner_reps; ++j) {
+#pragma omp parallel num_threads(threads) reduction(+ : sum)
+    {
+      delay(delay_length);
+      sum += 1;
+    }
+  }
+  if (sum != inner_reps * threads)
+    printf("# reduction error: %d\n", sum);
+}
+
+// Every test runs the delay loop inner_reps times on every thread, or on one
+// thread for single, which takes as long as the reference.
+struct construct {
+  const char *name;
+  void (*test)(int threads);
+};
+
+static const struct construct constructs[] = {
+    {"parallel", test_parallel}, {"for", test_for},
+    {"parallel_for", test_parallel_for}, {"barrier", test_barrier},
+    {"single", test_single}, {"reduction", test_reduction},
+};
+
+// Returns the mean time of `test` in seconds over the outer repetitions, and
+// stores their standard deviation in `stddev`.
+static double measure(void (*test)(int), int threads, double *stddev) {
+  double sum = 0, sum2 = 0;
+  test(threads); // warm up
+  for (int k = 0; k < outer_reps; ++k) {
+    double start = omp_get_wtime();
+    test(threads);
+    double t = omp_get_wtime() - start;
+    sum += t;
+    sum2 += t * t;
+  }
+  double mean = sum / outer_reps;
+  double var = sum2 / outer_reps - mean * mean;
+  *stddev = var > 0 ? sqrt(var) : 0;
+  return mean;
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --construct=NAME     only measure parallel, for, parallel_for,\n"
+          "                       barrier, single or reduction\n"
+          "  --outer-reps=N       runs averaged per measurement (20)\n"
+          "  --inner-reps=N       constructs per run (1000)\n"
+          "  --delay=US           work between constructs, in microseconds "
+          "(0.1)\n"
+          "  --threads=N,N,...    thread counts (1, 2, 4, ... up to "
+          "omp_get_max_threads())\n",
+          argv0);
+  exit(EXIT_FAILURE);
+}
+
+static const char *option_value(const char *arg, const char *name) {
+  size_t length = strlen(name);
+  if (strncmp(arg, name, length) == 0 && arg[length] == '=')
+    return arg + length + 1;
+  return NULL;
+}
+
+static void parse_thread_counts(const char *list) {
+  num_thread_counts = 0;
+  while (*list != '\0' && num_thread_counts < 64) {
+    char *end;
+    long count = strtol(list, &end, 10);
+    if (end == list || count < 1)
+      return;
+    thread_counts[num_thread_counts++] = (int)count;
+    list = *end == ',' ? end + 1 : end;
+  }
+}
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; ++i) {
+    const char *value;
+    if ((value = option_value(argv[i], "--construct")))
+      only_construct = value;
+    else if ((value = option_value(argv[i], "--outer-reps")))
+      outer_reps = atoi(value);
+    else if ((value = option_value(argv[i], "--inner-reps")))
+      inner_reps = atoi(value);
+    else if ((value = option_value(argv[i], "--delay")))
+      delay_us = atof(value);
+    else if ((value = option_value(argv[i], "--threads")))
+      parse_thread_counts(value);
+    else
+      usage(argv[0]);
+  }
+  if (outer_reps < 1 || inner_reps < 1 || delay_us < 0)
+    usage(argv[0]);
+  if (num_thread_counts == 0) {
+    int max_threads = omp_get_max_threads();
+    for (int threads = 1; threads < max_threads; threads *= 2)
+      thread_counts[num_thread_counts++] = threads;
+    thread_counts[num_thread_counts++] = max_threads;
+  }
+
+  calibrate_delay();
+  printf("# %d x %d repetitions, delay %g us (%d iterations)\n", outer_reps,
+         inner_reps, delay_us, delay_length);
+  printf("# %-14s %7s %14s %12s\n", "construct", "threads", "overhead(us)",
+         "stddev(us)");
+
+  for (size_t c = 0; c < sizeof(constructs) / sizeof(constructs[0]); ++c) {
+    if (only_construct && strcmp(only_construct, constructs[c].name) != 0)
+      continue;
+    for (int i = 0; i < num_thread_counts; ++i) {
+      int threads = thread_counts[i];
+      double ref_stddev, test_stddev;
+      double ref = measure(reference, threads, &ref_stddev);
+      double test = measure(constructs[c].test, threads, &test_stddev);
+      double overhead = (test - ref) / inner_reps * 1e6;
+      printf("  %-14s %7d %14.3f %12.3f\n", constructs[c].name, threads,
+             overhead, test_stddev / inner_reps * 1e6);
+    }
+  }
+  return EXIT_SUCCESS;
+}
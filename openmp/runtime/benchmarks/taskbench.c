@@ -0,0 +1,253 @@
+/*
+ * taskbench.c -- tasking throughput microbenchmark
+ */
+
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+/* Measures how many tasks per second the runtime schedules with fine grained,
+   recursively created tasks, for a range of thread counts:
+   - fib: the naive Fibonacci recursion, one task per call and a taskwait in
+     every task, so that threads waiting in taskwait steal from each other.
+   - uts: an unbalanced tree search in the style of the UTS benchmark. Every
+     node of a binomial tree is a task; the root has a fixed number of
+     children, and every other node has `--children` of them with probability
+     `--probability`, which keeps the tree size finite but its shape
+     unpredictable. There is no taskwait below the root.
+
+   Every task may also spin for `--work` microseconds, to model tasks that do
+   some work. The report has one line per thread count:
+     threads  tasks  seconds  tasks/s  speedup
+   where seconds is the best of `--trials` runs. */
+
+#include <omp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum workload { WORKLOAD_FIB, WORKLOAD_UTS };
+
+static enum workload workload = WORKLOAD_FIB;
+static int fib_n = 30;
+static int uts_root_children = 2000;
+static int uts_children = 8;
+static double uts_probability = 0.124875; // expected children: 0.999
+static uint64_t uts_seed = 19;
+static double work_us = 0;
+static int trials = 5;
+static int thread_counts[64];
+static int num_thread_counts = 0;
+
+// Per-thread counters of the uts nodes, one cache line apart
+#define COUNTER_STRIDE 16
+static int64_t *node_counts;
+
+static void spin(double us) {
+  if (us <= 0)
+    return;
+  double end = omp_get_wtime() + us * 1e-6;
+  while (omp_get_wtime() < end)
+    ;
+}
+
+static int64_t fib(int n) {
+  int64_t x, y;
+  spin(work_us);
+  if (n < 2)
+    return n;
+#pragma omp task shared(x) firstprivate(n)
+  x = fib(n - 1);
+#pragma omp task shared(y) firstprivate(n)
+  y = fib(n - 2);
+#pragma omp taskwait
+  return x + y;
+}
+
+// The state of a node and the number of its children derive from the state of
+// its parent with a mixing function, as UTS does with SHA-1, so that the tree
+// does not depend on the schedule.
+static uint64_t mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+static int uts_num_children(uint64_t state) {
+  double draw = (double)(state >> 11) / (double)(1ull << 53);
+  return draw < uts_probability ? uts_children : 0;
+}
+
+static void uts_node(uint64_t state) {
+  spin(work_us);
+  node_counts[omp_get_thread_num() * COUNTER_STRIDE]++;
+  int children = uts_num_children(state);
+  for (int i = 0; i < children; ++i) {
+    uint64_t child = mix(state ^ (uint64_t)(i + 1) * 0xd6e8feb86659fd93ull);
+#pragma omp task firstprivate(child)
+    uts_node(child);
+  }
+}
+
+static void uts_root(void) {
+  node_counts[omp_get_thread_num() * COUNTER_STRIDE]++;
+  for (int i = 0; i < uts_root_children; ++i) {
+    uint64_t child = mix(uts_seed ^ (uint64_t)(i + 1) * 0xd6e8feb86659fd93ull);
+#pragma omp task firstprivate(child)
+    uts_node(child);
+  }
+}
+
+// Runs the workload once on `threads` threads, returns the number of tasks
+// and stores the elapsed time in `seconds`.
+static int64_t run(int threads, double *seconds) {
+  int64_t tasks = 0;
+  memset(node_counts, 0, sizeof(int64_t) * COUNTER_STRIDE * threads);
+  double start = omp_get_wtime();
+#pragma omp parallel num_threads(threads)
+#pragma omp single
+  {
+    if (workload == WORKLOAD_FIB)
+      fib(fib_n);
+    else
+      uts_root();
+  }
+  *seconds = omp_get_wtime() - start;
+
+  if (workload == WORKLOAD_FIB) {
+    // fib(n) makes 2 * fib(n + 1) - 1 calls, all tasks but the first
+    int64_t a = 0, b = 1;
+    for (int i = 0; i < fib_n + 1; ++i) {
+      int64_t c = a + b;
+      a = b;
+      b = c;
+    }
+    tasks = 2 * a - 2;
+  } else {
+    for (int i = 0; i < threads; ++i)
+      tasks += node_counts[i * COUNTER_STRIDE];
+    tasks -= 1; // the root runs in the single region
+  }
+  return tasks;
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --workload=fib|uts   task tree to run (fib)\n"
+          "  --n=N                fib: argument of the recursion (30)\n"
+          "  --root-children=N    uts: children of the root (2000)\n"
+          "  --children=N         uts: children of the other nodes (8)\n"
+          "  --probability=P      uts: probability to have children "
+          "(0.124875)\n"
+          "  --seed=N             uts: state of the root (19)\n"
+          "  --work=US            time every task spins, in microseconds (0)\n"
+          "  --threads=N,N,...    thread counts (1, 2, 4, ... up to "
+          "omp_get_max_threads())\n"
+          "  --trials=N           runs per thread count, the best is "
+          "reported (5)\n",
+          argv0);
+  exit(EXIT_FAILURE);
+}
+
+static const char *option_value(const char *arg, const char *name) {
+  size_t length = strlen(name);
+  if (strncmp(arg, name, length) == 0 && arg[length] == '=')
+    return arg + length + 1;
+  return NULL;
+}
+
+static void parse_thread_counts(const char *list) {
+  num_thread_counts = 0;
+  while (*list != '\0' && num_thread_counts < 64) {
+    char *end;
+    long count = strtol(list, &end, 10);
+    if (end == list || count < 1)
+      return;
+    thread_counts[num_thread_counts++] = (int)count;
+    list = *end == ',' ? end + 1 : end;
+  }
+}
+
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; ++i) {
+    const char *value;
+    if ((value = option_value(argv[i], "--workload"))) {
+      if (strcmp(value, "fib") == 0)
+        workload = WORKLOAD_FIB;
+      else if (strcmp(value, "uts") == 0)
+        workload = WORKLOAD_UTS;
+      else
+        usage(argv[0]);
+    } else if ((value = option_value(argv[i], "--n"))) {
+      fib_n = atoi(value);
+    } else if ((value = option_value(argv[i], "--root-children"))) {
+      uts_root_children = atoi(value);
+    } else if ((value = option_value(argv[i], "--children"))) {
+      uts_children = atoi(value);
+    } else if ((value = option_value(argv[i], "--probability"))) {
+      uts_probability = atof(value);
+    } else if ((value = option_value(argv[i], "--seed"))) {
+      uts_seed = strtoull(value, NULL, 10);
+    } else if ((value = option_value(argv[i], "--work"))) {
+      work_us = atof(value);
+    } else if ((value = option_value(argv[i], "--threads"))) {
+      parse_thread_counts(value);
+    } else if ((value = option_value(argv[i], "--trials"))) {
+      trials = atoi(value);
+    } else {
+      usage(argv[0]);
+    }
+  }
+  if (fib_n < 1 || fib_n > 60 || trials < 1 ||
+      uts_children * uts_probability >= 1)
+    usage(argv[0]);
+  if (num_thread_counts == 0) {
+    int max_threads = omp_get_max_threads();
+    for (int threads = 1; threads < max_threads; threads *= 2)
+      thread_counts[num_thread_counts++] = threads;
+    thread_counts[num_thread_counts++] = max_threads;
+  }
+  int max_threads = 0;
+  for (int i = 0; i < num_thread_counts; ++i)
+    if (thread_counts[i] > max_threads)
+      max_threads = thread_counts[i];
+  node_counts = calloc((size_t)max_threads * COUNTER_STRIDE, sizeof(int64_t));
+  if (node_counts == NULL)
+    return EXIT_FAILURE;
+
+  if (workload == WORKLOAD_FIB)
+    printf("# fib(%d), work %g us per task\n", fib_n, work_us);
+  else
+    printf("# uts: %d root children, %d children with probability %g, "
+           "seed %llu, work %g us per task\n",
+           uts_root_children, uts_children, uts_probability,
+           (unsigned long long)uts_seed, work_us);
+  printf("# %7s %12s %12s %14s %8s\n", "threads", "tasks", "seconds",
+         "tasks/s", "speedup");
+
+  double base_rate = 0;
+  for (int i = 0; i < num_thread_counts; ++i) {
+    double best = 0;
+    int64_t tasks = 0;
+    for (int trial = 0; trial < trials; ++trial) {
+      double seconds;
+      tasks = run(thread_counts[i], &seconds);
+      if (trial == 0 || seconds < best)
+        best = seconds;
+    }
+    double rate = tasks / best;
+    if (i == 0)
+      base_rate = rate;
+    printf("  %7d %12lld %12.6f %14.0f %8.2f\n", thread_counts[i],
+           (long long)tasks, best, rate, rate / base_rate);
+  }
+  free(node_counts);
+  return EXIT_SUCCESS;
+}
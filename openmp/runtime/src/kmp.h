@@ -1916,6 +1916,8 @@ typedef enum kmp_bar_pat { /* Barrier communication patterns */
                            bp_hyper_bar = 2, /* Hypercube-embedded tree with min
                                                 branching factor 2^n */
                            bp_hierarchical_bar = 3, /* Machine hierarchy tree */
+                           bp_dist_bar = 4, /* Two-level tree of topology
+                                               sized groups */
                            bp_last_bar /* Placeholder to mark the end */
 } kmp_bar_pat_e;
 
@@ -1975,6 +1977,8 @@ typedef struct KMP_ALIGN_CACHE kmp_bstate {
   kmp_uint8 offset;
   kmp_uint8 wait_flag;
   kmp_uint8 use_oncore_barrier;
+  kmp_uint32 dist_nproc; // Team size dist_group_size was computed for
+  kmp_uint32 dist_group_size; // Threads per group (distributed barrier)
 #if USE_DEBUGGER
   // The following field is intended for the debugger solely. Only the worker
   // thread itself accesses this field: the worker increases it by 1 when it
@@ -2254,6 +2258,7 @@ typedef struct kmp_taskgroup {
 typedef union kmp_depnode kmp_depnode_t;
 typedef struct kmp_depnode_list kmp_depnode_list_t;
 typedef struct kmp_dephash_entry kmp_dephash_entry_t;
+typedef struct kmp_tdg_info kmp_tdg_info_t;
 
 // Compiler sends us this info:
 typedef struct kmp_depend_info {
@@ -2281,6 +2286,8 @@ typedef struct kmp_base_depnode {
   kmp_lock_t *mtx_locks[MAX_MTX_DEPS]; /* lock mutexinoutset dependent tasks */
   kmp_int32 mtx_num_locks; /* number of locks in mtx_locks array */
   kmp_lock_t lock; /* guards shared fields: task, successors */
+  kmp_tdg_info_t *tdg; /* taskgraph recording the task, if any */
+  kmp_int32 tdg_task_id; /* index of the task in tdg->nodes */
 #if KMP_SUPPORT_GRAPH_OUTPUT
   kmp_uint32 id;
 #endif
@@ -2312,6 +2319,38 @@ typedef struct kmp_dephash {
   kmp_uint32 nconflicts;
 } kmp_dephash_t;
 
+// Taskgraphs: the tasks created in a region and the dependences between them
+// are recorded the first time the region runs, and later runs of the region
+// create the tasks and link them from the record instead of executing it.
+typedef enum kmp_tdg_status {
+  KMP_TDG_NONE = 0, // no record yet
+  KMP_TDG_RECORDING = 1, // the region is being recorded
+  KMP_TDG_READY = 2, // the record is complete and can be replayed
+  KMP_TDG_UNSUPPORTED = 3 // the region does something replay cannot reproduce
+} kmp_tdg_status_t;
+
+typedef struct kmp_tdg_node {
+  ident_t *loc; // location of the task directive
+  kmp_int32 flags; // kmp_tasking_flags_t the task was allocated with
+  kmp_routine_entry_t routine;
+  size_t sizeof_kmp_task_t; // including the privates and padding
+  size_t sizeof_shareds;
+  void *data; // copy of the kmp_task_t and the shareds at task creation
+  kmp_int32 *predecessors; // indices of the tasks this task depends on
+  kmp_int32 npredecessors;
+  kmp_int32 predecessors_size;
+} kmp_tdg_node_t;
+
+struct kmp_tdg_info {
+  kmp_int32 tdg_id;
+  std::atomic<kmp_int32> status; // kmp_tdg_status_t
+  kmp_tdg_node_t *nodes; // in creation order
+  kmp_int32 nnodes;
+  kmp_int32 nodes_size;
+  kmp_dephash_t *saved_dephash; // dephash of the recording task
+  kmp_tdg_info_t *next;
+};
+
 typedef struct kmp_task_affinity_info {
   kmp_intptr_t base_addr;
   size_t len;
@@ -2413,6 +2452,7 @@ struct kmp_taskdata { /* aligned during dynamic allocation       */
       *td_dephash; // Dependencies for children tasks are tracked from here
   kmp_depnode_t
       *td_depnode; // Pointer to graph node if this task has dependencies
+  kmp_tdg_info_t *td_tdg; // Taskgraph recording the children of this task
   kmp_task_team_t *td_task_team;
   // The global thread id of the encountering thread. We need it because when a
   // regular task depends on a hidden helper task, and the hidden helper task
@@ -2440,14 +2480,31 @@ struct kmp_taskdata { /* aligned during dynamic allocation       */
 // Make sure padding above worked
 KMP_BUILD_ASSERT(sizeof(kmp_taskdata_t) % sizeof(void *) == 0);
 
+// Array of a work-stealing task deque. When the deque is full, its tasks move
+// to an array twice as large. The old array is kept until the deque is freed,
+// as thieves may still be reading from it.
+typedef struct kmp_task_deque_array {
+  struct kmp_task_deque_array *tda_prev; // Array replaced by this one
+  kmp_int64 tda_size; // Number of slots, a power of two
+  std::atomic<kmp_taskdata_t *> tda_tasks[1]; // Slots, allocated with array
+} kmp_task_deque_array_t;
+
 // Data for task team but per thread
 typedef struct kmp_base_thread_data {
   kmp_info_p *td_thr; // Pointer back to thread info
+  // Work-stealing deque of the tasks pushed by td_thr (Chase-Lev): the owner
+  // pushes and pops at the bottom without locking, thieves advance the top
+  // with a CAS. Indices grow monotonically and wrap in the array.
+  std::atomic<kmp_task_deque_array_t *> td_ws_array;
+  std::atomic<kmp_int64> td_ws_top; // Index of the next task to steal
+  std::atomic<kmp_int64> td_ws_bottom; // Index of the next task to push
+  // The locked deque holds the tasks pushed by other threads (hidden helper
+  // tasks, bottom halves of proxy tasks) and the tasks thieves could not run.
   // Used only in __kmp_execute_tasks_template, maybe not avail until task is
   // queued?
   kmp_bootstrap_lock_t td_deque_lock; // Lock for accessing deque
   kmp_taskdata_t *
-      *td_deque; // Deque of tasks encountered by td_thr, dynamically allocated
+      *td_deque; // Deque of tasks given to td_thr, dynamically allocated
   kmp_int32 td_deque_size; // Size of deck
   kmp_uint32 td_deque_head; // Head of deque (will wrap)
   kmp_uint32 td_deque_tail; // Tail of deque (will wrap)
@@ -2622,6 +2679,8 @@ typedef struct KMP_ALIGN_CACHE kmp_base_info {
 
 #if OMPT_SUPPORT
   ompt_thread_info_t ompt_thread_info;
+  // Not part of ompt_thread_info, which is restored after every task
+  ompt_trace_buffer_t ompt_trace_buffer;
 #endif
 
   /* The following are also read by the primary thread during reinit */
@@ -3508,6 +3567,7 @@ extern void __kmp_aux_display_affinity(int gtid, const char *format);
 
 extern void __kmp_cleanup_hierarchy();
 extern void __kmp_get_hierarchy(kmp_uint32 nproc, kmp_bstate_t *thr_bar);
+extern kmp_uint32 __kmp_get_dist_barrier_group_size(kmp_uint32 nproc);
 
 #if KMP_USE_FUTEX
 
@@ -3827,6 +3887,16 @@ KMP_EXPORT void __kmpc_omp_wait_deps(ident_t *loc_ref, kmp_int32 gtid,
                                      kmp_depend_info_t *noalias_dep_list);
 extern kmp_int32 __kmp_omp_task(kmp_int32 gtid, kmp_task_t *new_task,
                                 bool serialize_immediate);
+KMP_EXPORT kmp_int32 __kmpc_start_record_task(ident_t *loc_ref, kmp_int32 gtid,
+                                              kmp_int32 tdg_id);
+KMP_EXPORT void __kmpc_end_record_task(ident_t *loc_ref, kmp_int32 gtid,
+                                       kmp_int32 tdg_id);
+extern kmp_int32 __kmp_tdg_record_task(kmp_info_t *thread, kmp_task_t *task,
+                                       kmp_int32 ndeps,
+                                       kmp_depend_info_t *dep_list,
+                                       kmp_int32 ndeps_noalias,
+                                       kmp_depend_info_t *noalias_dep_list);
+extern void __kmp_cleanup_tdgs();
 
 KMP_EXPORT kmp_int32 __kmpc_cancel(ident_t *loc_ref, kmp_int32 gtid,
                                    kmp_int32 cncl_kind);
@@ -57,6 +57,45 @@ void __kmp_get_hierarchy(kmp_uint32 nproc, kmp_bstate_t *thr_bar) {
   thr_bar->skip_per_level = machine_hierarchy.skipPerLevel;
 }
 
+// Returns the number of consecutive threads per group of the distributed
+// barrier for a team of nproc threads. Groups of about sqrt(nproc) threads let
+// the group leaders and the primary thread wait for as many threads each. When
+// the team fits on the machine, groups are made of whole cores and, if the team
+// spans several sockets, divide the threads of a socket, so that with close
+// binding a group does not straddle two sockets.
+kmp_uint32 __kmp_get_dist_barrier_group_size(kmp_uint32 nproc) {
+  kmp_uint32 group_size = 1;
+  while (group_size * group_size < nproc)
+    ++group_size;
+
+  if (__kmp_topology && __kmp_topology->get_depth() > 0 &&
+      nproc <= (kmp_uint32)__kmp_topology->get_num_hw_threads()) {
+    int thread_level = __kmp_topology->get_depth() - 1;
+    int core_level = __kmp_topology->get_level(KMP_HW_CORE);
+    int socket_level = __kmp_topology->get_level(KMP_HW_SOCKET);
+    kmp_uint32 per_core = 1, per_socket = 0;
+    if (core_level >= 0 && core_level <= thread_level)
+      per_core = __kmp_topology->calculate_ratio(thread_level, core_level);
+    if (socket_level >= 0 && socket_level <= thread_level)
+      per_socket = __kmp_topology->calculate_ratio(thread_level, socket_level);
+
+    if (per_socket >= group_size && per_socket < nproc) {
+      // Smallest divisor of the socket made of whole cores that is large enough
+      kmp_uint32 size = per_socket;
+      for (kmp_uint32 d = per_core; d < per_socket; d += per_core) {
+        if (d >= group_size && per_socket % d == 0) {
+          size = d;
+          break;
+        }
+      }
+      group_size = size;
+    } else if (per_core > 1) {
+      group_size = (group_size + per_core - 1) / per_core * per_core;
+    }
+  }
+  return KMP_MIN(group_size, nproc);
+}
+
 static int nCoresPerPkg, nPackages;
 static int __kmp_nThreadsPerCore;
 #ifndef KMP_DFLT_NTH_CORES
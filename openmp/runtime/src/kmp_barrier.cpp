@@ -1261,6 +1261,255 @@ static void __kmp_hierarchical_barrier_release(
                 gtid, team->t.t_id, tid, bt));
 }
 
+// Distributed Barrier
+
+/* The team is split into groups of consecutive threads, sized after the machine
+   topology by __kmp_get_dist_barrier_group_size(). The first thread of a group
+   is its leader. In the gather, the leaders wait for the members of their
+   group, and the primary thread then for the other leaders; in the release,
+   the primary thread wakes up the other leaders first, so that all groups are
+   released in parallel. Every thread only writes its own flags and spins on
+   its own b_go, while a leader polls flags that a single thread writes. */
+
+// Returns the group size for a team of nproc threads, cached in thr_bar
+static kmp_uint32 __kmp_dist_barrier_group_size(kmp_bstate_t *thr_bar,
+                                                kmp_uint32 nproc) {
+  if (thr_bar->dist_nproc != nproc) {
+    thr_bar->dist_group_size = __kmp_get_dist_barrier_group_size(nproc);
+    thr_bar->dist_nproc = nproc;
+  }
+  return thr_bar->dist_group_size;
+}
+
+// Waits for the threads first, first + stride, ... below last to arrive
+static void __kmp_dist_barrier_gather_threads(
+    enum barrier_type bt, kmp_info_t *this_thr, int gtid, int tid,
+    kmp_uint32 first, kmp_uint32 last, kmp_uint32 stride, kmp_uint64 new_state,
+    void (*reduce)(void *, void *) USE_ITT_BUILD_ARG(void *itt_sync_obj)) {
+  kmp_team_t *team = this_thr->th.th_team;
+  kmp_info_t **other_threads = team->t.t_threads;
+
+  for (kmp_uint32 child_tid = first; child_tid < last; child_tid += stride) {
+    kmp_info_t *child_thr = other_threads[child_tid];
+    kmp_bstate_t *child_bar = &child_thr->th.th_bar[bt].bb;
+#if KMP_CACHE_MANAGE
+    // Prefetch next thread's arrived count
+    if (child_tid + stride < last)
+      KMP_CACHE_PREFETCH(
+          &other_threads[child_tid + stride]->th.th_bar[bt].bb.b_arrived);
+#endif /* KMP_CACHE_MANAGE */
+    KA_TRACE(20, ("__kmp_dist_barrier_gather: T#%d(%d:%d) wait T#%d(%d:%u) "
+                  "arrived(%p) == %llu\n",
+                  gtid, team->t.t_id, tid, __kmp_gtid_from_tid(child_tid, team),
+                  team->t.t_id, child_tid, &child_bar->b_arrived, new_state));
+    // Wait for child to arrive
+    kmp_flag_64<> flag(&child_bar->b_arrived, new_state);
+    flag.wait(this_thr, FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
+    ANNOTATE_BARRIER_END(child_thr);
+#if USE_ITT_BUILD && USE_ITT_NOTIFY
+    // Barrier imbalance - write min of the thread time and a child time to
+    // the thread.
+    if (__kmp_forkjoin_frames_mode == 2) {
+      this_thr->th.th_bar_min_time = KMP_MIN(this_thr->th.th_bar_min_time,
+                                             child_thr->th.th_bar_min_time);
+    }
+#endif
+    if (reduce) {
+      KA_TRACE(100, ("__kmp_dist_barrier_gather: T#%d(%d:%d) += T#%d(%d:%u)\n",
+                     gtid, team->t.t_id, tid,
+                     __kmp_gtid_from_tid(child_tid, team), team->t.t_id,
+                     child_tid));
+      ANNOTATE_REDUCE_AFTER(reduce);
+      OMPT_REDUCTION_DECL(this_thr, gtid);
+      OMPT_REDUCTION_BEGIN;
+      (*reduce)(this_thr->th.th_local.reduce_data,
+                child_thr->th.th_local.reduce_data);
+      OMPT_REDUCTION_END;
+      ANNOTATE_REDUCE_BEFORE(reduce);
+      ANNOTATE_REDUCE_BEFORE(&team->t.t_bar);
+    }
+  }
+}
+
+// Releases the threads first, first + stride, ... below last
+static void __kmp_dist_barrier_release_threads(
+    enum barrier_type bt, kmp_info_t *this_thr, int gtid, int tid,
+    kmp_team_t *team, kmp_uint32 first, kmp_uint32 last, kmp_uint32 stride,
+    int propagate_icvs) {
+  kmp_info_t **other_threads = team->t.t_threads;
+
+  for (kmp_uint32 child_tid = first; child_tid < last; child_tid += stride) {
+    kmp_info_t *child_thr = other_threads[child_tid];
+    kmp_bstate_t *child_bar = &child_thr->th.th_bar[bt].bb;
+#if KMP_CACHE_MANAGE
+    // Prefetch next thread's go count
+    if (child_tid + stride < last)
+      KMP_CACHE_PREFETCH(
+          &other_threads[child_tid + stride]->th.th_bar[bt].bb.b_go);
+#endif /* KMP_CACHE_MANAGE */
+
+#if KMP_BARRIER_ICV_PUSH
+    {
+      KMP_TIME_DEVELOPER_PARTITIONED_BLOCK(USER_icv_copy);
+      if (propagate_icvs) {
+        __kmp_init_implicit_task(team->t.t_ident, child_thr, team, child_tid,
+                                 FALSE);
+        copy_icvs(&team->t.t_implicit_task_taskdata[child_tid].td_icvs,
+                  &team->t.t_implicit_task_taskdata[0].td_icvs);
+      }
+    }
+#endif // KMP_BARRIER_ICV_PUSH
+    KA_TRACE(20, ("__kmp_dist_barrier_release: T#%d(%d:%d) releasing "
+                  "T#%d(%d:%u) go(%p): %u => %u\n",
+                  gtid, team->t.t_id, tid, __kmp_gtid_from_tid(child_tid, team),
+                  team->t.t_id, child_tid, &child_bar->b_go, child_bar->b_go,
+                  child_bar->b_go + KMP_BARRIER_STATE_BUMP));
+    // Release child from barrier
+    ANNOTATE_BARRIER_BEGIN(child_thr);
+    kmp_flag_64<> flag(&child_bar->b_go, child_thr);
+    flag.release();
+  }
+}
+
+static void __kmp_dist_barrier_gather(
+    enum barrier_type bt, kmp_info_t *this_thr, int gtid, int tid,
+    void (*reduce)(void *, void *) USE_ITT_BUILD_ARG(void *itt_sync_obj)) {
+  KMP_TIME_DEVELOPER_PARTITIONED_BLOCK(KMP_dist_gather);
+  kmp_team_t *team = this_thr->th.th_team;
+  kmp_bstate_t *thr_bar = &this_thr->th.th_bar[bt].bb;
+  kmp_info_t **other_threads = team->t.t_threads;
+  kmp_uint32 nproc = this_thr->th.th_team_nproc;
+  kmp_uint32 group_size = __kmp_dist_barrier_group_size(thr_bar, nproc);
+  kmp_uint32 leader_tid = tid - tid % group_size;
+  kmp_uint64 new_state = team->t.t_bar[bt].b_arrived + KMP_BARRIER_STATE_BUMP;
+
+  KA_TRACE(
+      20, ("__kmp_dist_barrier_gather: T#%d(%d:%d) enter for barrier type %d\n",
+           gtid, team->t.t_id, tid, bt));
+  KMP_DEBUG_ASSERT(this_thr == other_threads[this_thr->th.th_info.ds.ds_tid]);
+
+#if USE_ITT_BUILD && USE_ITT_NOTIFY
+  // Barrier imbalance - save arrive time to the thread
+  if (__kmp_forkjoin_frames_mode == 3 || __kmp_forkjoin_frames_mode == 2) {
+    this_thr->th.th_bar_arrive_time = this_thr->th.th_bar_min_time =
+        __itt_get_timestamp();
+  }
+#endif
+  if ((kmp_uint32)tid == leader_tid) {
+    // Leaders wait for the members of their group
+    __kmp_dist_barrier_gather_threads(
+        bt, this_thr, gtid, tid, tid + 1, KMP_MIN(tid + group_size, nproc), 1,
+        new_state, reduce USE_ITT_BUILD_ARG(itt_sync_obj));
+    // and the primary thread then for the other leaders
+    if (KMP_MASTER_TID(tid))
+      __kmp_dist_barrier_gather_threads(
+          bt, this_thr, gtid, tid, group_size, nproc, group_size, new_state,
+          reduce USE_ITT_BUILD_ARG(itt_sync_obj));
+  }
+
+  if (!KMP_MASTER_TID(tid)) { // Worker threads
+    kmp_int32 parent_tid = (kmp_uint32)tid == leader_tid ? 0 : leader_tid;
+
+    KA_TRACE(20,
+             ("__kmp_dist_barrier_gather: T#%d(%d:%d) releasing T#%d(%d:%d) "
+              "arrived(%p): %llu => %llu\n",
+              gtid, team->t.t_id, tid, __kmp_gtid_from_tid(parent_tid, team),
+              team->t.t_id, parent_tid, &thr_bar->b_arrived, thr_bar->b_arrived,
+              thr_bar->b_arrived + KMP_BARRIER_STATE_BUMP));
+
+    // Mark arrival to parent thread
+    /* After performing this write, a worker thread may not assume that the team
+       is valid any more - it could be deallocated by the primary thread at any
+       time.  */
+    ANNOTATE_BARRIER_BEGIN(this_thr);
+    kmp_flag_64<> flag(&thr_bar->b_arrived, other_threads[parent_tid]);
+    flag.release();
+  } else {
+    // Need to update the team arrived pointer if we are the primary thread
+    team->t.t_bar[bt].b_arrived = new_state;
+    KA_TRACE(20, ("__kmp_dist_barrier_gather: T#%d(%d:%d) set team %d "
+                  "arrived(%p) = %llu\n",
+                  gtid, team->t.t_id, tid, team->t.t_id,
+                  &team->t.t_bar[bt].b_arrived, team->t.t_bar[bt].b_arrived));
+  }
+  KA_TRACE(20,
+           ("__kmp_dist_barrier_gather: T#%d(%d:%d) exit for barrier type %d\n",
+            gtid, team->t.t_id, tid, bt));
+}
+
+static void __kmp_dist_barrier_release(
+    enum barrier_type bt, kmp_info_t *this_thr, int gtid, int tid,
+    int propagate_icvs USE_ITT_BUILD_ARG(void *itt_sync_obj)) {
+  KMP_TIME_DEVELOPER_PARTITIONED_BLOCK(KMP_dist_release);
+  kmp_team_t *team;
+  kmp_bstate_t *thr_bar = &this_thr->th.th_bar[bt].bb;
+  kmp_uint32 nproc;
+  kmp_uint32 group_size;
+
+  if (!KMP_MASTER_TID(
+          tid)) { // Handle fork barrier workers who aren't part of a team yet
+    KA_TRACE(20, ("__kmp_dist_barrier_release: T#%d wait go(%p) == %u\n", gtid,
+                  &thr_bar->b_go, KMP_BARRIER_STATE_BUMP));
+    // Wait for parent thread to release us
+    kmp_flag_64<> flag(&thr_bar->b_go, KMP_BARRIER_STATE_BUMP);
+    flag.wait(this_thr, TRUE USE_ITT_BUILD_ARG(itt_sync_obj));
+    ANNOTATE_BARRIER_END(this_thr);
+#if USE_ITT_BUILD && USE_ITT_NOTIFY
+    if ((__itt_sync_create_ptr && itt_sync_obj == NULL) || KMP_ITT_DEBUG) {
+      // In fork barrier where we could not get the object reliably (or
+      // ITTNOTIFY is disabled)
+      itt_sync_obj = __kmp_itt_barrier_object(gtid, bs_forkjoin_barrier, 0, -1);
+      // Cancel wait on previous parallel region...
+      __kmp_itt_task_starting(itt_sync_obj);
+
+      if (bt == bs_forkjoin_barrier && TCR_4(__kmp_global.g.g_done))
+        return;
+
+      itt_sync_obj = __kmp_itt_barrier_object(gtid, bs_forkjoin_barrier);
+      if (itt_sync_obj != NULL)
+        // Call prepare as early as possible for "new" barrier
+        __kmp_itt_task_finished(itt_sync_obj);
+    } else
+#endif /* USE_ITT_BUILD && USE_ITT_NOTIFY */
+        // Early exit for reaping threads releasing forkjoin barrier
+        if (bt == bs_forkjoin_barrier && TCR_4(__kmp_global.g.g_done))
+      return;
+
+    // The worker thread may now assume that the team is valid.
+    team = __kmp_threads[gtid]->th.th_team;
+    KMP_DEBUG_ASSERT(team != NULL);
+    tid = __kmp_tid_from_gtid(gtid);
+
+    TCW_4(thr_bar->b_go, KMP_INIT_BARRIER_STATE);
+    KA_TRACE(20,
+             ("__kmp_dist_barrier_release: T#%d(%d:%d) set go(%p) = %u\n", gtid,
+              team->t.t_id, tid, &thr_bar->b_go, KMP_INIT_BARRIER_STATE));
+    KMP_MB(); // Flush all pending memory write invalidates.
+  } else {
+    team = __kmp_threads[gtid]->th.th_team;
+    KMP_DEBUG_ASSERT(team != NULL);
+    KA_TRACE(20, ("__kmp_dist_barrier_release: T#%d(%d:%d) primary enter for "
+                  "barrier type %d\n",
+                  gtid, team->t.t_id, tid, bt));
+  }
+  nproc = this_thr->th.th_team_nproc;
+  group_size = __kmp_dist_barrier_group_size(thr_bar, nproc);
+
+  if (tid % group_size == 0) {
+    // The primary thread releases the other leaders before its own group
+    if (KMP_MASTER_TID(tid))
+      __kmp_dist_barrier_release_threads(bt, this_thr, gtid, tid, team,
+                                         group_size, nproc, group_size,
+                                         propagate_icvs);
+    __kmp_dist_barrier_release_threads(bt, this_thr, gtid, tid, team, tid + 1,
+                                       KMP_MIN(tid + group_size, nproc), 1,
+                                       propagate_icvs);
+  }
+  KA_TRACE(
+      20, ("__kmp_dist_barrier_release: T#%d(%d:%d) exit for barrier type %d\n",
+           gtid, team->t.t_id, tid, bt));
+}
+
 // End of Barrier Algorithms
 
 // type traits for cancellable value
@@ -1406,6 +1655,11 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
             bt, this_thr, gtid, tid, reduce USE_ITT_BUILD_ARG(itt_sync_obj));
         break;
       }
+      case bp_dist_bar: {
+        __kmp_dist_barrier_gather(bt, this_thr, gtid, tid,
+                                  reduce USE_ITT_BUILD_ARG(itt_sync_obj));
+        break;
+      }
       case bp_tree_bar: {
         // don't set branch bits to 0; use linear
         KMP_ASSERT(__kmp_barrier_gather_branch_bits[bt]);
@@ -1518,6 +1772,11 @@ static int __kmp_barrier_template(enum barrier_type bt, int gtid, int is_split,
               bt, this_thr, gtid, tid, FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
           break;
         }
+        case bp_dist_bar: {
+          __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
+                                     FALSE USE_ITT_BUILD_ARG(itt_sync_obj));
+          break;
+        }
         case bp_tree_bar: {
           KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
           __kmp_tree_barrier_release(bt, this_thr, gtid, tid,
@@ -1649,6 +1908,11 @@ void __kmp_end_split_barrier(enum barrier_type bt, int gtid) {
                                            FALSE USE_ITT_BUILD_ARG(NULL));
         break;
       }
+      case bp_dist_bar: {
+        __kmp_dist_barrier_release(bt, this_thr, gtid, tid,
+                                   FALSE USE_ITT_BUILD_ARG(NULL));
+        break;
+      }
       case bp_tree_bar: {
         KMP_ASSERT(__kmp_barrier_release_branch_bits[bt]);
         __kmp_tree_barrier_release(bt, this_thr, gtid, tid,
@@ -1797,6 +2061,11 @@ void __kmp_join_barrier(int gtid) {
                                       NULL USE_ITT_BUILD_ARG(itt_sync_obj));
     break;
   }
+  case bp_dist_bar: {
+    __kmp_dist_barrier_gather(bs_forkjoin_barrier, this_thr, gtid, tid,
+                              NULL USE_ITT_BUILD_ARG(itt_sync_obj));
+    break;
+  }
   case bp_tree_bar: {
     KMP_ASSERT(__kmp_barrier_gather_branch_bits[bs_forkjoin_barrier]);
     __kmp_tree_barrier_gather(bs_forkjoin_barrier, this_thr, gtid, tid,
@@ -1990,6 +2259,11 @@ void __kmp_fork_barrier(int gtid, int tid) {
                                        TRUE USE_ITT_BUILD_ARG(itt_sync_obj));
     break;
   }
+  case bp_dist_bar: {
+    __kmp_dist_barrier_release(bs_forkjoin_barrier, this_thr, gtid, tid,
+                               TRUE USE_ITT_BUILD_ARG(itt_sync_obj));
+    break;
+  }
   case bp_tree_bar: {
     KMP_ASSERT(__kmp_barrier_release_branch_bits[bs_forkjoin_barrier]);
     __kmp_tree_barrier_release(bs_forkjoin_barrier, this_thr, gtid, tid,
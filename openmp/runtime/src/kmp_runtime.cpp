@@ -3967,6 +3967,7 @@ static int __kmp_reset_root(int gtid, kmp_root_t *root) {
     ompt_callbacks.ompt_callback(ompt_callback_thread_end)(
         &(root->r.r_uber_thread->th.ompt_thread_info.thread_data));
   }
+  __ompt_end_trace_buffer(root->r.r_uber_thread);
 #endif
 
   TCW_4(__kmp_nth,
@@ -5874,6 +5875,7 @@ void *__kmp_launch_thread(kmp_info_t *this_thr) {
   if (ompt_enabled.ompt_callback_thread_end) {
     ompt_callbacks.ompt_callback(ompt_callback_thread_end)(thread_data);
   }
+  __ompt_end_trace_buffer(this_thr);
 #endif
 
   this_thr->th.th_task_team = NULL;
@@ -7853,6 +7855,7 @@ void __kmp_cleanup(void) {
     __kmp_affinity_uninitialize();
 #endif /* KMP_AFFINITY_SUPPORTED */
     __kmp_cleanup_hierarchy();
+    __kmp_cleanup_tdgs();
     TCW_4(__kmp_init_middle, FALSE);
   }
 
@@ -246,11 +246,15 @@ enum stats_state_e {
 // KMP_tree_release       -- time in __kmp_tree_barrier_release
 // KMP_hyper_gather       -- time in __kmp_hyper_barrier_gather
 // KMP_hyper_release      -- time in __kmp_hyper_barrier_release
+// KMP_dist_gather        -- time in __kmp_dist_barrier_gather
+// KMP_dist_release       -- time in __kmp_dist_barrier_release
 // clang-format off
 #define KMP_FOREACH_DEVELOPER_TIMER(macro, arg)                                \
   macro(KMP_fork_call, 0, arg)                                                 \
   macro(KMP_join_call, 0, arg)                                                 \
   macro(KMP_end_split_barrier, 0, arg)                                         \
+  macro(KMP_dist_gather, 0, arg)                                               \
+  macro(KMP_dist_release, 0, arg)                                              \
   macro(KMP_hier_gather, 0, arg)                                               \
   macro(KMP_hier_release, 0, arg)                                              \
   macro(KMP_hyper_gather, 0, arg)                                              \
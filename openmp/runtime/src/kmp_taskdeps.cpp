@@ -40,6 +40,8 @@ static void __kmp_init_node(kmp_depnode_t *node) {
   for (int i = 0; i < MAX_MTX_DEPS; ++i)
     node->dn.mtx_locks[i] = NULL;
   node->dn.mtx_num_locks = 0;
+  node->dn.tdg = NULL;
+  node->dn.tdg_task_id = -1;
   __kmp_init_lock(&node->dn.lock);
   KMP_ATOMIC_ST_RLX(&node->dn.nrefs, 1); // init creates the first reference
 #ifdef KMP_SUPPORT_GRAPH_OUTPUT
@@ -241,6 +243,35 @@ static inline void __kmp_track_dependence(kmp_int32 gtid, kmp_depnode_t *source,
 #endif /* OMPT_SUPPORT && OMPT_OPTIONAL */
 }
 
+// Adds the dependence of node on pred to the taskgraph recording node. The
+// dependence is kept even if pred has already finished, as it may not have
+// when the graph is replayed.
+static void __kmp_tdg_record_dependence(kmp_depnode_t *pred,
+                                        kmp_depnode_t *node) {
+  kmp_tdg_info_t *tdg = node->dn.tdg;
+  if (pred->dn.tdg != tdg)
+    return; // pred was created before the recording started
+  kmp_tdg_node_t *tdg_node = &tdg->nodes[node->dn.tdg_task_id];
+  kmp_int32 pred_id = pred->dn.tdg_task_id;
+  for (kmp_int32 i = 0; i < tdg_node->npredecessors; ++i)
+    if (tdg_node->predecessors[i] == pred_id)
+      return;
+  if (tdg_node->npredecessors == tdg_node->predecessors_size) {
+    kmp_int32 new_size =
+        tdg_node->predecessors_size ? 2 * tdg_node->predecessors_size : 4;
+    kmp_int32 *predecessors =
+        (kmp_int32 *)__kmp_allocate(new_size * sizeof(kmp_int32));
+    if (tdg_node->predecessors) {
+      KMP_MEMCPY(predecessors, tdg_node->predecessors,
+                 tdg_node->npredecessors * sizeof(kmp_int32));
+      __kmp_free(tdg_node->predecessors);
+    }
+    tdg_node->predecessors = predecessors;
+    tdg_node->predecessors_size = new_size;
+  }
+  tdg_node->predecessors[tdg_node->npredecessors++] = pred_id;
+}
+
 static inline kmp_int32
 __kmp_depnode_link_successor(kmp_int32 gtid, kmp_info_t *thread,
                              kmp_task_t *task, kmp_depnode_t *node,
@@ -251,6 +282,8 @@ __kmp_depnode_link_successor(kmp_int32 gtid, kmp_info_t *thread,
   // link node as successor of list elements
   for (kmp_depnode_list_t *p = plist; p; p = p->next) {
     kmp_depnode_t *dep = p->node;
+    if (UNLIKELY(node->dn.tdg != NULL))
+      __kmp_tdg_record_dependence(dep, node);
     if (dep->dn.task) {
       KMP_ACQUIRE_DEPNODE(gtid, dep);
       if (dep->dn.task) {
@@ -276,6 +309,8 @@ static inline kmp_int32 __kmp_depnode_link_successor(kmp_int32 gtid,
   if (!sink)
     return 0;
   kmp_int32 npredecessors = 0;
+  if (UNLIKELY(source->dn.tdg != NULL))
+    __kmp_tdg_record_dependence(sink, source);
   if (sink->dn.task) {
     // synchronously add source to sink' list of successors
     KMP_ACQUIRE_DEPNODE(gtid, sink);
@@ -592,6 +627,11 @@ kmp_int32 __kmpc_omp_task_with_deps(ident_t *loc_ref, kmp_int32 gtid,
            !(task_team && (task_team->tt.tt_found_proxy_tasks ||
                            task_team->tt.tt_hidden_helper_task_encountered));
 
+  kmp_int32 tdg_task_id = -1;
+  if (UNLIKELY(current_task->td_tdg != NULL))
+    tdg_task_id = __kmp_tdg_record_task(thread, new_task, ndeps, dep_list,
+                                        ndeps_noalias, noalias_dep_list);
+
   if (!serial && (ndeps > 0 || ndeps_noalias > 0)) {
     /* if no dependences have been tracked yet, create the dependence hash */
     if (current_task->td_dephash == NULL)
@@ -606,6 +646,10 @@ kmp_int32 __kmpc_omp_task_with_deps(ident_t *loc_ref, kmp_int32 gtid,
 #endif
 
     __kmp_init_node(node);
+    if (tdg_task_id >= 0) {
+      node->dn.tdg = current_task->td_tdg;
+      node->dn.tdg_task_id = tdg_task_id;
+    }
     new_taskdata->td_depnode = node;
 
     if (__kmp_check_deps(gtid, node, new_task, &current_task->td_dephash,
@@ -679,6 +723,7 @@ void __kmpc_omp_wait_deps(ident_t *loc_ref, kmp_int32 gtid, kmp_int32 ndeps,
   __kmp_assert_valid_gtid(gtid);
   kmp_info_t *thread = __kmp_threads[gtid];
   kmp_taskdata_t *current_task = thread->th.th_current_task;
+  __kmp_tdg_abort_record(current_task);
 
 #if OMPT_SUPPORT
   // this function represents a taskwait construct with depend clause
@@ -798,3 +843,302 @@ void __kmpc_omp_wait_deps(ident_t *loc_ref, kmp_int32 gtid, kmp_int32 ndeps,
   KA_TRACE(10, ("__kmpc_omp_wait_deps(exit): T#%d finished waiting : loc=%p\n",
                 gtid, loc_ref));
 }
+
+// Taskgraphs, by id. They live until the library shuts down.
+static kmp_tdg_info_t *__kmp_tdgs = NULL;
+static kmp_bootstrap_lock_t __kmp_tdgs_lock =
+    KMP_BOOTSTRAP_LOCK_INITIALIZER(__kmp_tdgs_lock);
+
+// __kmp_find_tdg: returns the taskgraph tdg_id, created on first use.
+// Called with __kmp_tdgs_lock held.
+static kmp_tdg_info_t *__kmp_find_tdg(kmp_int32 tdg_id) {
+  kmp_tdg_info_t *tdg;
+  for (tdg = __kmp_tdgs; tdg; tdg = tdg->next)
+    if (tdg->tdg_id == tdg_id)
+      return tdg;
+  tdg = (kmp_tdg_info_t *)__kmp_allocate(sizeof(kmp_tdg_info_t));
+  tdg->tdg_id = tdg_id;
+  KMP_ATOMIC_ST_RLX(&tdg->status, KMP_TDG_NONE);
+  tdg->next = __kmp_tdgs;
+  __kmp_tdgs = tdg;
+  return tdg;
+}
+
+static void __kmp_free_tdg_nodes(kmp_tdg_info_t *tdg) {
+  for (kmp_int32 i = 0; i < tdg->nnodes; ++i) {
+    __kmp_free(tdg->nodes[i].data);
+    if (tdg->nodes[i].predecessors)
+      __kmp_free(tdg->nodes[i].predecessors);
+  }
+  if (tdg->nodes)
+    __kmp_free(tdg->nodes);
+  tdg->nodes = NULL;
+  tdg->nnodes = 0;
+  tdg->nodes_size = 0;
+}
+
+// __kmp_tdg_record_task: adds task, created by the current task of thread
+// while it records a taskgraph, to the graph before the task can run.
+// Returns the index of the task in the graph, or -1 if the graph cannot be
+// replayed.
+kmp_int32 __kmp_tdg_record_task(kmp_info_t *thread, kmp_task_t *task,
+                                kmp_int32 ndeps, kmp_depend_info_t *dep_list,
+                                kmp_int32 ndeps_noalias,
+                                kmp_depend_info_t *noalias_dep_list) {
+  kmp_taskdata_t *current_task = thread->th.th_current_task;
+  kmp_tdg_info_t *tdg = current_task->td_tdg;
+  kmp_taskdata_t *taskdata = KMP_TASK_TO_TASKDATA(task);
+  kmp_tasking_flags_t *td_flags = &taskdata->td_flags;
+
+  if (KMP_ATOMIC_LD_RLX(&tdg->status) != KMP_TDG_RECORDING)
+    return -1;
+  // Undeferred tasks run in the middle of the region, which the replay skips,
+  // and the runtime does not keep a copy of what the other flags refer to.
+  bool unsupported = td_flags->task_serial || td_flags->destructors_thunk ||
+                     td_flags->proxy || td_flags->detachable ||
+                     td_flags->hidden_helper || td_flags->native;
+  // The order of the tasks in a mutexinoutset set is only known at run time
+  for (kmp_int32 i = 0; i < ndeps && !unsupported; ++i)
+    unsupported = dep_list[i].flags.mtx;
+  for (kmp_int32 i = 0; i < ndeps_noalias && !unsupported; ++i)
+    unsupported = noalias_dep_list[i].flags.mtx;
+  if (unsupported) {
+    __kmp_tdg_abort_record(current_task);
+    return -1;
+  }
+
+  if (tdg->nnodes == tdg->nodes_size) {
+    kmp_int32 new_size = tdg->nodes_size ? 2 * tdg->nodes_size : 64;
+    kmp_tdg_node_t *nodes =
+        (kmp_tdg_node_t *)__kmp_allocate(new_size * sizeof(kmp_tdg_node_t));
+    if (tdg->nodes) {
+      KMP_MEMCPY(nodes, tdg->nodes, tdg->nnodes * sizeof(kmp_tdg_node_t));
+      __kmp_free(tdg->nodes);
+    }
+    tdg->nodes = nodes;
+    tdg->nodes_size = new_size;
+  }
+
+  kmp_int32 tdg_task_id = tdg->nnodes++;
+  kmp_tdg_node_t *tdg_node = &tdg->nodes[tdg_task_id];
+  kmp_int32 flags = 0;
+  kmp_tasking_flags_t *input_flags = (kmp_tasking_flags_t *)&flags;
+  input_flags->tiedness = td_flags->tiedness;
+  input_flags->final = td_flags->final;
+  // The priority itself is in data2 of the copy of the task below
+  input_flags->priority_specified = td_flags->priority_specified;
+  tdg_node->loc = taskdata->td_ident;
+  tdg_node->flags = flags;
+  tdg_node->routine = task->routine;
+  // Sizes __kmp_task_alloc gets the same layout from
+  size_t task_size = taskdata->td_size_alloc - sizeof(kmp_taskdata_t);
+  if (task->shareds) {
+    tdg_node->sizeof_kmp_task_t = (char *)task->shareds - (char *)task;
+    tdg_node->sizeof_shareds = task_size - tdg_node->sizeof_kmp_task_t;
+  } else {
+    tdg_node->sizeof_kmp_task_t = task_size;
+    tdg_node->sizeof_shareds = 0;
+  }
+  tdg_node->data = __kmp_allocate(task_size);
+  KMP_MEMCPY(tdg_node->data, task, task_size);
+  tdg_node->predecessors = NULL;
+  tdg_node->npredecessors = 0;
+  tdg_node->predecessors_size = 0;
+
+  KA_TRACE(30, ("__kmp_tdg_record_task: taskgraph %d task %d is %p\n",
+                tdg->tdg_id, tdg_task_id, taskdata));
+  return tdg_task_id;
+}
+
+// __kmp_tdg_replay: creates the tasks of taskgraph tdg as children of the
+// current task, linked to their recorded predecessors, and schedules those
+// without pending predecessors.
+static void __kmp_tdg_replay(kmp_int32 gtid, kmp_tdg_info_t *tdg) {
+  kmp_info_t *thread = __kmp_threads[gtid];
+  kmp_int32 nnodes = tdg->nnodes;
+
+  KA_TRACE(20, ("__kmp_tdg_replay: T#%d replays taskgraph %d, %d tasks\n", gtid,
+                tdg->tdg_id, nnodes));
+  if (nnodes == 0)
+    return;
+  // The depnodes of the graph, each with a reference held until all the tasks
+  // are linked
+  kmp_depnode_t **depnodes = (kmp_depnode_t **)__kmp_thread_malloc(
+      thread, nnodes * sizeof(kmp_depnode_t *));
+
+  for (kmp_int32 i = 0; i < nnodes; ++i) {
+    kmp_tdg_node_t *tdg_node = &tdg->nodes[i];
+    kmp_task_t *task = __kmpc_omp_task_alloc(
+        tdg_node->loc, gtid, tdg_node->flags, tdg_node->sizeof_kmp_task_t,
+        tdg_node->sizeof_shareds, tdg_node->routine);
+    kmp_taskdata_t *taskdata = KMP_TASK_TO_TASKDATA(task);
+    KMP_MEMCPY(task, tdg_node->data,
+               tdg_node->sizeof_kmp_task_t + tdg_node->sizeof_shareds);
+    if (tdg_node->sizeof_shareds > 0)
+      task->shareds = (char *)task + tdg_node->sizeof_kmp_task_t;
+
+#if OMPT_SUPPORT
+    if (ompt_enabled.ompt_callback_task_create) {
+      kmp_taskdata_t *current_task = thread->th.th_current_task;
+      ompt_callbacks.ompt_callback(ompt_callback_task_create)(
+          &(current_task->ompt_task_info.task_data),
+          &(current_task->ompt_task_info.frame),
+          &(taskdata->ompt_task_info.task_data),
+          ompt_task_explicit | TASK_TYPE_DETAILS_FORMAT(taskdata),
+          tdg_node->npredecessors > 0, OMPT_GET_RETURN_ADDRESS(0));
+    }
+#endif
+
+#if USE_FAST_MEMORY
+    kmp_depnode_t *node =
+        (kmp_depnode_t *)__kmp_fast_allocate(thread, sizeof(kmp_depnode_t));
+#else
+    kmp_depnode_t *node =
+        (kmp_depnode_t *)__kmp_thread_malloc(thread, sizeof(kmp_depnode_t));
+#endif
+    __kmp_init_node(node);
+    depnodes[i] = __kmp_node_ref(node);
+    taskdata->td_depnode = node;
+
+    // As in __kmp_check_deps, the initial -1 keeps the finishing predecessors
+    // from scheduling the task before all of them are linked
+    node->dn.npredecessors = -1;
+    kmp_int32 npredecessors = 0;
+    for (kmp_int32 j = 0; j < tdg_node->npredecessors; ++j)
+      npredecessors += __kmp_depnode_link_successor(
+          gtid, thread, task, node, depnodes[tdg_node->predecessors[j]]);
+    node->dn.task = task;
+    KMP_MB();
+    npredecessors++;
+    npredecessors =
+        node->dn.npredecessors.fetch_add(npredecessors) + npredecessors;
+    if (npredecessors == 0)
+      __kmp_omp_task(gtid, task, true);
+  }
+
+  for (kmp_int32 i = 0; i < nnodes; ++i)
+    __kmp_node_deref(thread, depnodes[i]);
+  __kmp_thread_free(thread, depnodes);
+}
+
+/*!
+@ingroup TASKING
+@param loc_ref location of the taskgraph region
+@param gtid Global Thread ID of encountering thread
+@param tdg_id Identifier of the taskgraph, unique in the program
+
+@return Returns 1 if the region must be executed, or 0 if its tasks have been
+created from the record of an earlier execution
+
+Starts a taskgraph region. The first time a task encounters the region, the
+tasks created in the region and the dependences between them are recorded.
+Later executions replay the record: the tasks are created with the private
+data and the shared variables captured by the recording, and linked directly
+to their predecessors, without the lookup of their dependences. The region
+must therefore only create tasks, and its shared variables must outlive all
+of its executions. Dependences on tasks created outside of the region are
+ignored, and __kmpc_end_record_task() waits for the tasks of the region.
+
+A region that cannot be replayed, because it waits for tasks, creates
+undeferred tasks or tasks with mutexinoutset dependences, or starts another
+taskgraph, is executed every time.
+*/
+kmp_int32 __kmpc_start_record_task(ident_t *loc_ref, kmp_int32 gtid,
+                                   kmp_int32 tdg_id) {
+  KA_TRACE(10, ("__kmpc_start_record_task(enter): T#%d loc=%p tdg=%d\n", gtid,
+                loc_ref, tdg_id));
+  __kmp_assert_valid_gtid(gtid);
+  kmp_info_t *thread = __kmp_threads[gtid];
+  kmp_taskdata_t *current_task = thread->th.th_current_task;
+
+  if (current_task->td_tdg) {
+    // Nested taskgraph: the enclosing one cannot be replayed as a whole
+    __kmp_tdg_abort_record(current_task);
+    return 1;
+  }
+  // Dependences are not tracked in serial teams, so the recording would lack
+  // them
+  bool serial = current_task->td_flags.team_serial ||
+                current_task->td_flags.tasking_ser ||
+                current_task->td_flags.final;
+
+  __kmp_acquire_bootstrap_lock(&__kmp_tdgs_lock);
+  kmp_tdg_info_t *tdg = __kmp_find_tdg(tdg_id);
+  kmp_int32 status = KMP_ATOMIC_LD_RLX(&tdg->status);
+  if (status == KMP_TDG_NONE && !serial)
+    KMP_ATOMIC_ST_RLX(&tdg->status, KMP_TDG_RECORDING);
+  __kmp_release_bootstrap_lock(&__kmp_tdgs_lock);
+
+  if (status == KMP_TDG_READY) {
+    __kmp_tdg_replay(gtid, tdg);
+    KA_TRACE(10, ("__kmpc_start_record_task(exit): T#%d replayed tdg=%d\n",
+                  gtid, tdg_id));
+    return 0;
+  }
+  if (status == KMP_TDG_NONE && !serial) {
+    // Track the dependences of the region in a dephash of its own, so that
+    // the recording holds the same dependences as the replays
+    current_task->td_tdg = tdg;
+    tdg->saved_dephash = current_task->td_dephash;
+    current_task->td_dephash = NULL;
+    KA_TRACE(10, ("__kmpc_start_record_task(exit): T#%d records tdg=%d\n", gtid,
+                  tdg_id));
+  }
+  return 1;
+}
+
+/*!
+@ingroup TASKING
+@param loc_ref location of the taskgraph region
+@param gtid Global Thread ID of encountering thread
+@param tdg_id Identifier of the taskgraph, as passed to
+__kmpc_start_record_task()
+
+Ends a taskgraph region, whether it was executed or replayed, and waits for
+the children of the current task.
+*/
+void __kmpc_end_record_task(ident_t *loc_ref, kmp_int32 gtid,
+                            kmp_int32 tdg_id) {
+  KA_TRACE(10, ("__kmpc_end_record_task(enter): T#%d loc=%p tdg=%d\n", gtid,
+                loc_ref, tdg_id));
+  __kmp_assert_valid_gtid(gtid);
+  kmp_info_t *thread = __kmp_threads[gtid];
+  kmp_taskdata_t *current_task = thread->th.th_current_task;
+  kmp_tdg_info_t *tdg = current_task->td_tdg;
+
+  if (tdg && tdg->tdg_id != tdg_id)
+    tdg = NULL; // end of a taskgraph nested in the recorded one
+  if (tdg)
+    current_task->td_tdg = NULL;
+
+  __kmpc_omp_taskwait(loc_ref, gtid);
+
+  if (!tdg)
+    return;
+  if (current_task->td_dephash)
+    __kmp_dephash_free(thread, current_task->td_dephash);
+  current_task->td_dephash = tdg->saved_dephash;
+  tdg->saved_dephash = NULL;
+
+  __kmp_acquire_bootstrap_lock(&__kmp_tdgs_lock);
+  if (KMP_ATOMIC_LD_RLX(&tdg->status) == KMP_TDG_RECORDING) {
+    KMP_ATOMIC_ST_REL(&tdg->status, KMP_TDG_READY);
+  } else {
+    __kmp_free_tdg_nodes(tdg);
+  }
+  __kmp_release_bootstrap_lock(&__kmp_tdgs_lock);
+  KA_TRACE(10, ("__kmpc_end_record_task(exit): T#%d tdg=%d recorded %d tasks, "
+                "status %d\n",
+                gtid, tdg_id, tdg->nnodes, (int)tdg->status));
+}
+
+// __kmp_cleanup_tdgs: frees the taskgraphs at library shutdown
+void __kmp_cleanup_tdgs() {
+  kmp_tdg_info_t *next;
+  for (kmp_tdg_info_t *tdg = __kmp_tdgs; tdg; tdg = next) {
+    next = tdg->next;
+    __kmp_free_tdg_nodes(tdg);
+    __kmp_free(tdg);
+  }
+  __kmp_tdgs = NULL;
+}
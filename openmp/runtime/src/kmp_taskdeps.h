@@ -85,6 +85,18 @@ static inline void __kmp_dephash_free(kmp_info_t *thread, kmp_dephash_t *h) {
 #endif
 }
 
+// Stops the recording of the taskgraph of task, if any, because the region
+// does something a replay would not reproduce (a taskwait, an undeferred task)
+static inline void __kmp_tdg_abort_record(kmp_taskdata_t *task) {
+  kmp_tdg_info_t *tdg = task->td_tdg;
+  if (UNLIKELY(tdg != NULL)) {
+    KA_TRACE(20, ("__kmp_tdg_abort_record: taskgraph %d of task %p cannot be "
+                  "replayed\n",
+                  tdg->tdg_id, task));
+    KMP_ATOMIC_ST_RLX(&tdg->status, KMP_TDG_UNSUPPORTED);
+  }
+}
+
 static inline void __kmp_release_deps(kmp_int32 gtid, kmp_taskdata_t *task) {
   kmp_info_t *thread = __kmp_threads[gtid];
   kmp_depnode_t *node = task->td_depnode;
@@ -321,6 +321,167 @@ static void __kmp_realloc_task_deque(kmp_info_t *thread,
   thread_data->td.td_deque_size = new_size;
 }
 
+// The work-stealing deque of a thread follows Chase and Lev, "Dynamic Circular
+// Work-Stealing Deque", with the memory orders of Le et al., "Correct and
+// Efficient Work-Stealing for Weak Memory Models". Only its owner pushes and
+// pops tasks, at the bottom; thieves take the task at the top by advancing the
+// top with a CAS, which the owner also does to pop the last task.
+
+// __kmp_alloc_ws_deque_array: allocates the array of a work-stealing deque
+static kmp_task_deque_array_t *
+__kmp_alloc_ws_deque_array(kmp_int64 size, kmp_task_deque_array_t *prev) {
+  KMP_DEBUG_ASSERT(size > 0 && (size & (size - 1)) == 0);
+  kmp_task_deque_array_t *array = (kmp_task_deque_array_t *)__kmp_allocate(
+      sizeof(kmp_task_deque_array_t) +
+      (size - 1) * sizeof(std::atomic<kmp_taskdata_t *>));
+  array->tda_prev = prev;
+  array->tda_size = size;
+  return array;
+}
+
+// __kmp_ws_deque_ntasks: number of tasks in the work-stealing deque of a
+// thread, only a hint when read by another thread
+static inline kmp_int64 __kmp_ws_deque_ntasks(kmp_thread_data_t *thread_data) {
+  kmp_int64 ntasks = KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_bottom) -
+                     KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_top);
+  return ntasks > 0 ? ntasks : 0;
+}
+
+// __kmp_has_queued_tasks: whether either deque of a thread holds tasks, only a
+// hint when read by another thread
+static inline bool __kmp_has_queued_tasks(kmp_thread_data_t *thread_data) {
+  return __kmp_ws_deque_ntasks(thread_data) != 0 ||
+         TCR_4(thread_data->td.td_deque_ntasks) != 0;
+}
+
+// __kmp_grow_ws_deque: copies the tasks of the full work-stealing deque of the
+// calling thread to an array twice as large. Thieves keep taking tasks from
+// the old array until they see the new one, so it is not freed.
+static kmp_task_deque_array_t *__kmp_grow_ws_deque(kmp_info_t *thread,
+                                                   kmp_thread_data_t *thread_data,
+                                                   kmp_int64 top,
+                                                   kmp_int64 bottom) {
+  kmp_task_deque_array_t *array =
+      KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_array);
+  kmp_int64 new_size = 2 * array->tda_size;
+
+  KE_TRACE(10, ("__kmp_grow_ws_deque: T#%d growing deque[from %" KMP_INT64_SPEC
+                " to %" KMP_INT64_SPEC "] for thread_data %p\n",
+                __kmp_gtid_from_thread(thread), array->tda_size, new_size,
+                thread_data));
+
+  kmp_task_deque_array_t *new_array =
+      __kmp_alloc_ws_deque_array(new_size, array);
+  for (kmp_int64 i = top; i < bottom; ++i)
+    new_array->tda_tasks[i & (new_size - 1)].store(
+        array->tda_tasks[i & (array->tda_size - 1)].load(
+            std::memory_order_relaxed),
+        std::memory_order_relaxed);
+  KMP_ATOMIC_ST_REL(&thread_data->td.td_ws_array, new_array);
+  return new_array;
+}
+
+// __kmp_push_ws_deque: pushes a task at the bottom of the work-stealing deque
+// of the calling thread
+static void __kmp_push_ws_deque(kmp_info_t *thread,
+                                kmp_thread_data_t *thread_data,
+                                kmp_taskdata_t *taskdata) {
+  kmp_int64 bottom = KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_bottom);
+  kmp_int64 top = KMP_ATOMIC_LD_ACQ(&thread_data->td.td_ws_top);
+  kmp_task_deque_array_t *array =
+      KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_array);
+  if (bottom - top >= array->tda_size)
+    array = __kmp_grow_ws_deque(thread, thread_data, top, bottom);
+  array->tda_tasks[bottom & (array->tda_size - 1)].store(
+      taskdata, std::memory_order_relaxed);
+  // Thieves that see the new bottom must see the task
+  std::atomic_thread_fence(std::memory_order_release);
+  KMP_ATOMIC_ST_RLX(&thread_data->td.td_ws_bottom, bottom + 1);
+}
+
+// __kmp_pop_ws_deque: pops the task at the bottom of the work-stealing deque of
+// the calling thread, or returns NULL if it is empty or a thief took the last
+// task
+static kmp_taskdata_t *__kmp_pop_ws_deque(kmp_thread_data_t *thread_data) {
+  kmp_int64 bottom = KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_bottom) - 1;
+  kmp_task_deque_array_t *array =
+      KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_array);
+  KMP_ATOMIC_ST_RLX(&thread_data->td.td_ws_bottom, bottom);
+  // Reserve the bottom task before looking for thieves
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  kmp_int64 top = KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_top);
+
+  kmp_taskdata_t *taskdata = NULL;
+  if (top <= bottom) {
+    taskdata = array->tda_tasks[bottom & (array->tda_size - 1)].load(
+        std::memory_order_relaxed);
+    if (top < bottom)
+      return taskdata; // No thief can reach the bottom task
+    // Last task: the thieves may also be taking it
+    if (!thread_data->td.td_ws_top.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst,
+            std::memory_order_relaxed))
+      taskdata = NULL;
+  }
+  KMP_ATOMIC_ST_RLX(&thread_data->td.td_ws_bottom, bottom + 1);
+  return taskdata;
+}
+
+// __kmp_steal_ws_deque: takes the task at the top of the work-stealing deque of
+// another thread, or returns NULL if it is empty or another thread took the
+// task first. If the calling thread was finished, it is un-marked before the
+// task leaves the deque, or the primary thread might be released from the
+// barrier while the task runs.
+static kmp_taskdata_t *
+__kmp_steal_ws_deque(kmp_int32 gtid, kmp_thread_data_t *victim_td,
+                     std::atomic<kmp_int32> *unfinished_threads,
+                     int *thread_finished) {
+  kmp_int64 top = KMP_ATOMIC_LD_ACQ(&victim_td->td.td_ws_top);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  kmp_int64 bottom = KMP_ATOMIC_LD_ACQ(&victim_td->td.td_ws_bottom);
+  if (top >= bottom)
+    return NULL;
+
+  kmp_task_deque_array_t *array = KMP_ATOMIC_LD_ACQ(&victim_td->td.td_ws_array);
+  kmp_taskdata_t *taskdata =
+      array->tda_tasks[top & (array->tda_size - 1)].load(
+          std::memory_order_relaxed);
+  if (*thread_finished)
+    KMP_ATOMIC_INC(unfinished_threads);
+  if (!victim_td->td.td_ws_top.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst,
+          std::memory_order_relaxed)) {
+    if (*thread_finished)
+      KMP_ATOMIC_DEC(unfinished_threads);
+    return NULL;
+  }
+  if (*thread_finished) {
+    KA_TRACE(20, ("__kmp_steal_ws_deque: T#%d inc unfinished_threads\n",
+                  gtid));
+    *thread_finished = FALSE;
+  }
+  return taskdata;
+}
+
+// __kmp_requeue_task: puts a task that a thief took from the work-stealing
+// deque of a thread, but may not run, in the locked deque of that thread,
+// where thieves check tasks before taking them
+static void __kmp_requeue_task(kmp_info_t *thread,
+                               kmp_thread_data_t *thread_data,
+                               kmp_taskdata_t *taskdata) {
+  __kmp_acquire_bootstrap_lock(&thread_data->td.td_deque_lock);
+  if (TCR_4(thread_data->td.td_deque_ntasks) >=
+      TASK_DEQUE_SIZE(thread_data->td))
+    __kmp_realloc_task_deque(thread, thread_data);
+  thread_data->td.td_deque[thread_data->td.td_deque_tail] = taskdata;
+  // Wrap index.
+  thread_data->td.td_deque_tail =
+      (thread_data->td.td_deque_tail + 1) & TASK_DEQUE_MASK(thread_data->td);
+  TCW_4(thread_data->td.td_deque_ntasks,
+        TCR_4(thread_data->td.td_deque_ntasks) + 1);
+  __kmp_release_bootstrap_lock(&thread_data->td.td_deque_lock);
+}
+
 //  __kmp_push_task: Add a task to the thread's deque
 static kmp_int32 __kmp_push_task(kmp_int32 gtid, kmp_task_t *task) {
   kmp_info_t *thread = __kmp_threads[gtid];
@@ -377,6 +538,37 @@ static kmp_int32 __kmp_push_task(kmp_int32 gtid, kmp_task_t *task) {
     __kmp_alloc_task_deque(thread, thread_data);
   }
 
+  // A thread pushes its own tasks to its work-stealing deque without locking.
+  // Tasks pushed for another thread, as hidden helper tasks and the successors
+  // of the tasks hidden helper threads complete are, go to its locked deque.
+  if (gtid == __kmp_get_gtid()) {
+    if (__kmp_ws_deque_ntasks(thread_data) >=
+            KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_array)->tda_size &&
+        __kmp_enable_task_throttling &&
+        __kmp_task_is_allowed(gtid, __kmp_task_stealing_constraint, taskdata,
+                              thread->th.th_current_task)) {
+      KA_TRACE(20, ("__kmp_push_task: T#%d deque is full; returning "
+                    "TASK_NOT_PUSHED for task %p\n",
+                    gtid, taskdata));
+      return TASK_NOT_PUSHED;
+    }
+    // Otherwise the deque grows to push the task which is not allowed to
+    // execute
+    __kmp_push_ws_deque(thread, thread_data, taskdata);
+    KMP_FSYNC_RELEASING(thread->th.th_current_task); // releasing self
+    KMP_FSYNC_RELEASING(taskdata); // releasing child
+    KA_TRACE(20, ("__kmp_push_task: T#%d returning TASK_SUCCESSFULLY_PUSHED: "
+                  "task=%p top=%" KMP_INT64_SPEC " bottom=%" KMP_INT64_SPEC
+                  "\n",
+                  gtid, taskdata, KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_top),
+                  KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_bottom)));
+    if (taskdata->td_flags.hidden_helper) {
+      // Wake hidden helper threads up if they're sleeping
+      __kmp_hidden_helper_worker_thread_signal();
+    }
+    return TASK_SUCCESSFULLY_PUSHED;
+  }
+
   int locked = 0;
   // Check if deque is full
   if (TCR_4(thread_data->td.td_deque_ntasks) >=
@@ -418,7 +610,7 @@ static kmp_int32 __kmp_push_task(kmp_int32 gtid, kmp_task_t *task) {
       }
     }
   }
-  // Must have room since no thread can add tasks but calling thread
+  // Must have room since the lock is held
   KMP_DEBUG_ASSERT(TCR_4(thread_data->td.td_deque_ntasks) <
                    TASK_DEQUE_SIZE(thread_data->td));
 
@@ -622,6 +814,7 @@ static void __kmpc_omp_task_begin_if0_template(ident_t *loc_ref, kmp_int32 gtid,
   KA_TRACE(10, ("__kmpc_omp_task_begin_if0(enter): T#%d loc=%p task=%p "
                 "current_task=%p\n",
                 gtid, loc_ref, taskdata, current_task));
+  __kmp_tdg_abort_record(current_task);
 
   if (UNLIKELY(taskdata->td_flags.tiedness == TASK_UNTIED)) {
     // untied task needs to increment counter so that the task structure is not
@@ -1095,6 +1288,7 @@ void __kmp_init_implicit_task(ident_t *loc_ref, kmp_info_t *this_thr,
   task->td_flags.freed = 0;
 
   task->td_depnode = NULL;
+  task->td_tdg = NULL;
   task->td_last_tied = task;
   task->td_allow_completion_event.type = KMP_EVENT_UNINITIALIZED;
 
@@ -1347,6 +1541,7 @@ kmp_task_t *__kmp_task_alloc(ident_t *loc_ref, kmp_int32 gtid,
   taskdata->td_flags.merged_if0 = flags->merged_if0;
   taskdata->td_flags.destructors_thunk = flags->destructors_thunk;
   taskdata->td_flags.proxy = flags->proxy;
+  taskdata->td_flags.priority_specified = flags->priority_specified;
   taskdata->td_flags.detachable = flags->detachable;
   taskdata->td_flags.hidden_helper = flags->hidden_helper;
   taskdata->encountering_gtid = gtid;
@@ -1382,6 +1577,7 @@ kmp_task_t *__kmp_task_alloc(ident_t *loc_ref, kmp_int32 gtid,
       parent_task->td_taskgroup; // task inherits taskgroup from the parent task
   taskdata->td_dephash = NULL;
   taskdata->td_depnode = NULL;
+  taskdata->td_tdg = NULL;
   if (flags->tiedness == TASK_UNTIED)
     taskdata->td_last_tied = NULL; // will be set when the task is scheduled
   else
@@ -1809,6 +2005,11 @@ kmp_int32 __kmpc_omp_task(ident_t *loc_ref, kmp_int32 gtid,
   }
 #endif
 
+  kmp_info_t *thread = __kmp_threads[gtid];
+  if (UNLIKELY(thread->th.th_current_task->td_tdg != NULL) &&
+      !KMP_TASK_TO_TASKDATA(new_task)->td_flags.started)
+    __kmp_tdg_record_task(thread, new_task, 0, NULL, 0, NULL);
+
   res = __kmp_omp_task(gtid, new_task, true);
 
   KA_TRACE(10, ("__kmpc_omp_task(exit): T#%d returning "
@@ -1890,6 +2091,7 @@ static kmp_int32 __kmpc_omp_taskwait_template(ident_t *loc_ref, kmp_int32 gtid,
   if (__kmp_tasking_mode != tskm_immediate_exec) {
     thread = __kmp_threads[gtid];
     taskdata = thread->th.th_current_task;
+    __kmp_tdg_abort_record(taskdata);
 
 #if OMPT_SUPPORT && OMPT_OPTIONAL
     ompt_data_t *my_task_data;
@@ -2499,6 +2701,7 @@ void __kmpc_taskgroup(ident_t *loc, int gtid) {
   __kmp_assert_valid_gtid(gtid);
   kmp_info_t *thread = __kmp_threads[gtid];
   kmp_taskdata_t *taskdata = thread->th.th_current_task;
+  __kmp_tdg_abort_record(taskdata);
   kmp_taskgroup_t *tg_new =
       (kmp_taskgroup_t *)__kmp_thread_malloc(thread, sizeof(kmp_taskgroup_t));
   KA_TRACE(10, ("__kmpc_taskgroup: T#%d loc=%p group=%p\n", gtid, loc, tg_new));
@@ -2691,6 +2894,26 @@ static kmp_task_t *__kmp_remove_my_task(kmp_info_t *thread, kmp_int32 gtid,
                 gtid, thread_data->td.td_deque_ntasks,
                 thread_data->td.td_deque_head, thread_data->td.td_deque_tail));
 
+  // The tasks the thread pushed itself come first, newest first
+  if (__kmp_ws_deque_ntasks(thread_data) != 0) {
+    taskdata = __kmp_pop_ws_deque(thread_data);
+    if (taskdata != NULL) {
+      if (!__kmp_task_is_allowed(gtid, is_constrained, taskdata,
+                                 thread->th.th_current_task)) {
+        // The TSC does not allow to execute the bottom task, put it back
+        __kmp_push_ws_deque(thread, thread_data, taskdata);
+        KA_TRACE(10, ("__kmp_remove_my_task(exit #5): T#%d TSC blocks bottom "
+                      "task of the work-stealing deque\n",
+                      gtid));
+        return NULL;
+      }
+      KA_TRACE(10, ("__kmp_remove_my_task(exit #6): T#%d task %p removed "
+                    "from the work-stealing deque\n",
+                    gtid, taskdata));
+      return KMP_TASKDATA_TO_TASK(taskdata);
+    }
+  }
+
   if (TCR_4(thread_data->td.td_deque_ntasks) == 0) {
     KA_TRACE(10,
              ("__kmp_remove_my_task(exit #1): T#%d No tasks to remove: "
@@ -2771,7 +2994,7 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
                 victim_td->td.td_deque_ntasks, victim_td->td.td_deque_head,
                 victim_td->td.td_deque_tail));
 
-  if (TCR_4(victim_td->td.td_deque_ntasks) == 0) {
+  if (!__kmp_has_queued_tasks(victim_td)) {
     KA_TRACE(10, ("__kmp_steal_task(exit #1): T#%d could not steal from T#%d: "
                   "task_team=%p ntasks=%d head=%u tail=%u\n",
                   gtid, __kmp_gtid_from_thread(victim_thr), task_team,
@@ -2780,6 +3003,33 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
     return NULL;
   }
 
+  current = __kmp_threads[gtid]->th.th_current_task;
+  if (__kmp_ws_deque_ntasks(victim_td) != 0) {
+    taskdata = __kmp_steal_ws_deque(gtid, victim_td, unfinished_threads,
+                                    thread_finished);
+    if (taskdata != NULL) {
+      if (__kmp_task_is_allowed(gtid, is_constrained, taskdata, current)) {
+        KMP_COUNT_BLOCK(TASK_stolen);
+        KA_TRACE(10, ("__kmp_steal_task(exit #6): T#%d stole task %p from "
+                      "the work-stealing deque of T#%d: task_team=%p\n",
+                      gtid, taskdata, __kmp_gtid_from_thread(victim_thr),
+                      task_team));
+        return KMP_TASKDATA_TO_TASK(taskdata);
+      }
+      // A task can only be checked once taken, as its owner may be running it
+      // otherwise. This one is left to the threads the TSC allows to run it,
+      // in the locked deque where tasks are checked before being taken.
+      __kmp_requeue_task(victim_thr, victim_td, taskdata);
+    }
+  }
+
+  if (TCR_4(victim_td->td.td_deque_ntasks) == 0) {
+    KA_TRACE(10, ("__kmp_steal_task(exit #7): T#%d could not steal from T#%d: "
+                  "task_team=%p\n",
+                  gtid, __kmp_gtid_from_thread(victim_thr), task_team));
+    return NULL;
+  }
+
   __kmp_acquire_bootstrap_lock(&victim_td->td.td_deque_lock);
 
   int ntasks = TCR_4(victim_td->td.td_deque_ntasks);
@@ -2794,7 +3044,6 @@ static kmp_task_t *__kmp_steal_task(kmp_info_t *victim_thr, kmp_int32 gtid,
   }
 
   KMP_DEBUG_ASSERT(victim_td->td.td_deque != NULL);
-  current = __kmp_threads[gtid]->th.th_current_task;
   taskdata = victim_td->td.td_deque[victim_td->td.td_deque_head];
   if (__kmp_task_is_allowed(gtid, is_constrained, taskdata, current)) {
     // Bump head pointer and Wrap.
@@ -3031,7 +3280,7 @@ static inline int __kmp_execute_tasks_template(
       KMP_YIELD(__kmp_library == library_throughput); // Yield before next task
       // If execution of a stolen task results in more tasks being placed on our
       // run queue, reset use_own_tasks
-      if (!use_own_tasks && TCR_4(threads_data[tid].td.td_deque_ntasks) != 0) {
+      if (!use_own_tasks && __kmp_has_queued_tasks(&threads_data[tid])) {
         KA_TRACE(20, ("__kmp_execute_tasks_template: T#%d stolen task spawned "
                       "other tasks, restart\n",
                       gtid));
@@ -3270,6 +3519,11 @@ static void __kmp_alloc_task_deque(kmp_info_t *thread,
   thread_data->td.td_deque = (kmp_taskdata_t **)__kmp_allocate(
       INITIAL_TASK_DEQUE_SIZE * sizeof(kmp_taskdata_t *));
   thread_data->td.td_deque_size = INITIAL_TASK_DEQUE_SIZE;
+
+  KMP_DEBUG_ASSERT(KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_array) == NULL);
+  KMP_DEBUG_ASSERT(__kmp_ws_deque_ntasks(thread_data) == 0);
+  KMP_ATOMIC_ST_REL(&thread_data->td.td_ws_array,
+                    __kmp_alloc_ws_deque_array(INITIAL_TASK_DEQUE_SIZE, NULL));
 }
 
 // __kmp_free_task_deque:
@@ -3282,6 +3536,17 @@ static void __kmp_free_task_deque(kmp_thread_data_t *thread_data) {
     __kmp_free(thread_data->td.td_deque);
     thread_data->td.td_deque = NULL;
     __kmp_release_bootstrap_lock(&thread_data->td.td_deque_lock);
+
+    kmp_task_deque_array_t *array =
+        KMP_ATOMIC_LD_RLX(&thread_data->td.td_ws_array);
+    KMP_ATOMIC_ST_RLX(&thread_data->td.td_ws_array, NULL);
+    KMP_ATOMIC_ST_RLX(&thread_data->td.td_ws_top, 0);
+    KMP_ATOMIC_ST_RLX(&thread_data->td.td_ws_bottom, 0);
+    while (array != NULL) {
+      kmp_task_deque_array_t *prev = array->tda_prev;
+      __kmp_free(array);
+      array = prev;
+    }
   }
 
 #ifdef BUILD_TIED_TASK_STACK
@@ -4565,6 +4830,7 @@ static void __kmp_taskloop(ident_t *loc, int gtid, kmp_task_t *task, int if_val,
                            int modifier, void *task_dup) {
   kmp_taskdata_t *taskdata = KMP_TASK_TO_TASKDATA(task);
   KMP_DEBUG_ASSERT(task != NULL);
+  __kmp_tdg_abort_record(__kmp_threads[gtid]->th.th_current_task);
   if (nogroup == 0) {
 #if OMPT_SUPPORT && OMPT_OPTIONAL
     OMPT_STORE_RETURN_ADDRESS(gtid);
@@ -848,6 +848,348 @@ OMPT_API_ROUTINE int ompt_get_num_devices(void) {
   return 1; // only one device (the current device) is available
 }
 
+/*****************************************************************************
+ * Tracing
+ ****************************************************************************/
+
+// Instead of receiving the host events one callback at a time, a tool can have
+// them traced: every thread writes ompt_record_ompt_t records into a buffer of
+// the tool, and hands the buffer back when it is full, flushed, or when the
+// thread ends. ompt_stop_trace hands back the buffers of all the threads. The
+// entry points are those of device tracing, with a NULL device for the host.
+// While tracing is on, the runtime owns the callbacks of the traced events.
+
+#define FOREACH_OMPT_TRACE_EVENT(macro)                                        \
+  macro(ompt_callback_implicit_task, ompt_trace_implicit_task)                 \
+  macro(ompt_callback_task_create, ompt_trace_task_create)                     \
+  macro(ompt_callback_task_schedule, ompt_trace_task_schedule)                 \
+  macro(ompt_callback_sync_region, ompt_trace_sync_region)
+
+#define OMPT_TRACE_EVENT_BIT(event) ((uint64_t)1 << (event))
+
+// The records are stamped with KMP_NOW(), which reads the time stamp counter
+// where the runtime calibrates it and returns nanoseconds elsewhere.
+#if KMP_OS_UNIX && (KMP_ARCH_X86 || KMP_ARCH_X86_64)
+static double ompt_trace_nsec_per_tick;
+#define OMPT_TRACE_TIME()                                                      \
+  ((ompt_device_time_t)(KMP_NOW() * ompt_trace_nsec_per_tick))
+#else
+#define OMPT_TRACE_TIME() ((ompt_device_time_t)KMP_NOW())
+#endif
+
+static ompt_callback_buffer_request_t ompt_trace_request;
+static ompt_callback_buffer_complete_t ompt_trace_complete;
+static int ompt_trace_device_num;
+// Set by the tool thread, read by the threads that write records
+static std::atomic<int> ompt_trace_active(0);
+
+// The traced events, all of them unless ompt_set_trace_ompt changes it
+static std::atomic<uint64_t> ompt_trace_events(
+#define ompt_trace_event_macro(event, trace_fn) OMPT_TRACE_EVENT_BIT(event) |
+    FOREACH_OMPT_TRACE_EVENT(ompt_trace_event_macro)
+#undef ompt_trace_event_macro
+    0);
+
+// The buffers of the threads that have traced. The lock is taken before the
+// busy flag of a buffer.
+static ompt_trace_buffer_t *ompt_trace_buffers = NULL;
+static kmp_bootstrap_lock_t ompt_trace_lock =
+    KMP_BOOTSTRAP_LOCK_INITIALIZER(ompt_trace_lock);
+
+// Returns the id of a task or parallel region. Tracing assigns it when the
+// tool has not, and the threads of a team may race to do so.
+static ompt_id_t ompt_trace_id(ompt_data_t *data) {
+  if (!data)
+    return ompt_id_none;
+  ompt_id_t id = data->value;
+  if (id == ompt_id_none) {
+    ompt_id_t new_id = __ompt_get_unique_id_internal();
+    if (KMP_COMPARE_AND_STORE_ACQ64((volatile kmp_int64 *)&data->value, 0,
+                                    (kmp_int64)new_id))
+      id = new_id;
+    else
+      id = data->value;
+  }
+  return id;
+}
+
+static void ompt_trace_acquire(ompt_trace_buffer_t *trace) {
+  while (trace->busy.exchange(true, std::memory_order_acquire))
+    KMP_CPU_PAUSE();
+}
+
+static void ompt_trace_release(ompt_trace_buffer_t *trace) {
+  trace->busy.store(false, std::memory_order_release);
+}
+
+// Hands the buffer back to the tool, with the busy flag held
+static void ompt_trace_flush(ompt_trace_buffer_t *trace) {
+  ompt_buffer_t *buffer = trace->buffer;
+  size_t used = trace->used;
+  trace->buffer = NULL;
+  trace->size = 0;
+  trace->used = 0;
+  if (buffer)
+    ompt_trace_complete(ompt_trace_device_num, buffer, used, 0, 1);
+}
+
+// Hands back the buffer of thread thr, which ends, and forgets it
+void __ompt_end_trace_buffer(kmp_info_t *thr) {
+  ompt_trace_buffer_t *trace = &thr->th.ompt_trace_buffer;
+  if (!trace->listed)
+    return;
+  __kmp_acquire_bootstrap_lock(&ompt_trace_lock);
+  ompt_trace_buffer_t **link = &ompt_trace_buffers;
+  while (*link != trace)
+    link = &(*link)->next;
+  *link = trace->next;
+  trace->listed = false;
+  ompt_trace_acquire(trace);
+  ompt_trace_flush(trace);
+  ompt_trace_release(trace);
+  __kmp_release_bootstrap_lock(&ompt_trace_lock);
+}
+
+// Returns the record to fill for an event of the calling thread, or NULL when
+// tracing stopped or the tool has no buffer for it. The caller fills the
+// record and then releases *trace_out.
+static ompt_record_ompt_t *ompt_trace_record(ompt_callbacks_t type,
+                                             ompt_trace_buffer_t **trace_out) {
+  kmp_info_t *thr = ompt_get_thread();
+  if (!thr)
+    return NULL;
+  ompt_trace_buffer_t *trace = &thr->th.ompt_trace_buffer;
+  if (!trace->listed) {
+    __kmp_acquire_bootstrap_lock(&ompt_trace_lock);
+    trace->next = ompt_trace_buffers;
+    ompt_trace_buffers = trace;
+    trace->listed = true;
+    __kmp_release_bootstrap_lock(&ompt_trace_lock);
+  }
+  ompt_trace_acquire(trace);
+  // An event that races with ompt_stop_trace is dropped once the buffer may
+  // have been handed back.
+  if (!ompt_trace_active.load(std::memory_order_relaxed)) {
+    ompt_trace_release(trace);
+    return NULL;
+  }
+  if (trace->used + sizeof(ompt_record_ompt_t) > trace->size) {
+    ompt_trace_flush(trace);
+    ompt_trace_request(ompt_trace_device_num, &trace->buffer, &trace->size);
+    if (trace->size < sizeof(ompt_record_ompt_t)) {
+      ompt_trace_flush(trace);
+      ompt_trace_release(trace);
+      return NULL;
+    }
+  }
+  ompt_record_ompt_t *record =
+      (ompt_record_ompt_t *)((char *)trace->buffer + trace->used);
+  trace->used += sizeof(ompt_record_ompt_t);
+  record->type = type;
+  record->time = OMPT_TRACE_TIME();
+  record->thread_id = thr->th.th_info.ds.ds_gtid;
+  record->target_id = ompt_id_none;
+  *trace_out = trace;
+  return record;
+}
+
+static void ompt_trace_implicit_task(ompt_scope_endpoint_t endpoint,
+                                     ompt_data_t *parallel_data,
+                                     ompt_data_t *task_data,
+                                     unsigned int actual_parallelism,
+                                     unsigned int index, int flags) {
+  ompt_trace_buffer_t *trace;
+  ompt_record_ompt_t *record =
+      ompt_trace_record(ompt_callback_implicit_task, &trace);
+  if (!record)
+    return;
+  ompt_record_implicit_task_t *rec = &record->record.implicit_task;
+  rec->endpoint = endpoint;
+  rec->parallel_id = ompt_trace_id(parallel_data);
+  rec->task_id = ompt_trace_id(task_data);
+  rec->actual_parallelism = actual_parallelism;
+  rec->index = index;
+  rec->flags = flags;
+  ompt_trace_release(trace);
+}
+
+static void ompt_trace_task_create(ompt_data_t *encountering_task_data,
+                                   const ompt_frame_t *encountering_task_frame,
+                                   ompt_data_t *new_task_data, int flags,
+                                   int has_dependences,
+                                   const void *codeptr_ra) {
+  ompt_trace_buffer_t *trace;
+  ompt_record_ompt_t *record =
+      ompt_trace_record(ompt_callback_task_create, &trace);
+  if (!record)
+    return;
+  ompt_record_task_create_t *rec = &record->record.task_create;
+  rec->encountering_task_id = ompt_trace_id(encountering_task_data);
+  rec->new_task_id = ompt_trace_id(new_task_data);
+  rec->flags = flags;
+  rec->has_dependences = has_dependences;
+  rec->codeptr_ra = codeptr_ra;
+  ompt_trace_release(trace);
+}
+
+static void ompt_trace_task_schedule(ompt_data_t *prior_task_data,
+                                     ompt_task_status_t prior_task_status,
+                                     ompt_data_t *next_task_data) {
+  ompt_trace_buffer_t *trace;
+  ompt_record_ompt_t *record =
+      ompt_trace_record(ompt_callback_task_schedule, &trace);
+  if (!record)
+    return;
+  ompt_record_task_schedule_t *rec = &record->record.task_schedule;
+  rec->prior_task_id = ompt_trace_id(prior_task_data);
+  rec->prior_task_status = prior_task_status;
+  rec->next_task_id = ompt_trace_id(next_task_data);
+  ompt_trace_release(trace);
+}
+
+static void ompt_trace_sync_region(ompt_sync_region_t kind,
+                                   ompt_scope_endpoint_t endpoint,
+                                   ompt_data_t *parallel_data,
+                                   ompt_data_t *task_data,
+                                   const void *codeptr_ra) {
+  ompt_trace_buffer_t *trace;
+  ompt_record_ompt_t *record =
+      ompt_trace_record(ompt_callback_sync_region, &trace);
+  if (!record)
+    return;
+  ompt_record_sync_region_t *rec = &record->record.sync_region;
+  rec->kind = kind;
+  rec->endpoint = endpoint;
+  rec->parallel_id = ompt_trace_id(parallel_data);
+  rec->task_id = ompt_trace_id(task_data);
+  rec->codeptr_ra = codeptr_ra;
+  ompt_trace_release(trace);
+}
+
+static void ompt_trace_set_callbacks(int enable) {
+  uint64_t events = ompt_trace_events.load(std::memory_order_relaxed);
+#define ompt_trace_event_macro(event, trace_fn)                                \
+  if (events & OMPT_TRACE_EVENT_BIT(event)) {                                  \
+    ompt_callbacks.ompt_callback(event) = enable ? trace_fn : NULL;            \
+    ompt_enabled.event = enable;                                               \
+  }
+
+  FOREACH_OMPT_TRACE_EVENT(ompt_trace_event_macro)
+
+#undef ompt_trace_event_macro
+}
+
+OMPT_API_ROUTINE ompt_set_result_t ompt_set_trace_ompt(ompt_device_t *device,
+                                                       unsigned int enable,
+                                                       unsigned int etype) {
+  if (device || ompt_trace_active.load(std::memory_order_relaxed))
+    return ompt_set_error;
+  uint64_t bits;
+  switch (etype) {
+  case 0:
+    bits = ~(uint64_t)0;
+    break;
+
+#define ompt_trace_event_macro(event, trace_fn)                                \
+  case event:                                                                  \
+    bits = OMPT_TRACE_EVENT_BIT(event);                                        \
+    break;
+
+    FOREACH_OMPT_TRACE_EVENT(ompt_trace_event_macro)
+
+#undef ompt_trace_event_macro
+
+  default:
+    return ompt_set_never;
+  }
+  static const uint64_t all_events =
+#define ompt_trace_event_macro(event, trace_fn) OMPT_TRACE_EVENT_BIT(event) |
+      FOREACH_OMPT_TRACE_EVENT(ompt_trace_event_macro)
+#undef ompt_trace_event_macro
+      0;
+  if (enable)
+    ompt_trace_events.fetch_or(bits & all_events, std::memory_order_relaxed);
+  else
+    ompt_trace_events.fetch_and(~bits, std::memory_order_relaxed);
+  return ompt_set_always;
+}
+
+OMPT_API_ROUTINE int ompt_start_trace(ompt_device_t *device,
+                                      ompt_callback_buffer_request_t request,
+                                      ompt_callback_buffer_complete_t complete) {
+  if (device || !request || !complete ||
+      ompt_trace_active.load(std::memory_order_relaxed))
+    return 0;
+  // The tool cannot have both a callback and records for an event
+  uint64_t events = ompt_trace_events.load(std::memory_order_relaxed);
+#define ompt_trace_event_macro(event, trace_fn)                                \
+  if ((events & OMPT_TRACE_EVENT_BIT(event)) &&                                \
+      ompt_callbacks.ompt_callback(event))                                     \
+    return 0;
+
+  FOREACH_OMPT_TRACE_EVENT(ompt_trace_event_macro)
+
+#undef ompt_trace_event_macro
+
+  ompt_trace_request = request;
+  ompt_trace_complete = complete;
+  ompt_trace_device_num = omp_get_initial_device();
+#if KMP_OS_UNIX && (KMP_ARCH_X86 || KMP_ARCH_X86_64)
+  ompt_trace_nsec_per_tick = 1e6 / __kmp_ticks_per_msec;
+#endif
+  ompt_trace_active.store(1, std::memory_order_relaxed);
+  ompt_trace_set_callbacks(1);
+  return 1;
+}
+
+// Only the buffer of the calling thread is handed back; the other threads hand
+// theirs back when they fill them, end, or tracing stops.
+OMPT_API_ROUTINE int ompt_flush_trace(ompt_device_t *device) {
+  kmp_info_t *thr = ompt_get_thread();
+  if (device || !ompt_trace_complete || !thr)
+    return 0;
+  ompt_trace_buffer_t *trace = &thr->th.ompt_trace_buffer;
+  ompt_trace_acquire(trace);
+  ompt_trace_flush(trace);
+  ompt_trace_release(trace);
+  return 1;
+}
+
+// Hands back the buffers of all the threads. A thread that writes a record
+// meanwhile either finishes it before its buffer is handed back, or finds
+// tracing stopped once it holds the buffer.
+OMPT_API_ROUTINE int ompt_stop_trace(ompt_device_t *device) {
+  if (device || !ompt_trace_active.load(std::memory_order_relaxed))
+    return 0;
+  ompt_trace_set_callbacks(0);
+  ompt_trace_active.store(0, std::memory_order_relaxed);
+  __kmp_acquire_bootstrap_lock(&ompt_trace_lock);
+  for (ompt_trace_buffer_t *trace = ompt_trace_buffers; trace;
+       trace = trace->next) {
+    ompt_trace_acquire(trace);
+    ompt_trace_flush(trace);
+    ompt_trace_release(trace);
+  }
+  __kmp_release_bootstrap_lock(&ompt_trace_lock);
+  return 1;
+}
+
+OMPT_API_ROUTINE ompt_record_ompt_t *
+ompt_get_record_ompt(ompt_buffer_t *buffer, ompt_buffer_cursor_t current) {
+  return (ompt_record_ompt_t *)((char *)buffer + current);
+}
+
+OMPT_API_ROUTINE int ompt_advance_buffer_cursor(ompt_device_t *device,
+                                                ompt_buffer_t *buffer,
+                                                size_t size,
+                                                ompt_buffer_cursor_t current,
+                                                ompt_buffer_cursor_t *next) {
+  if (current + 2 * sizeof(ompt_record_ompt_t) > size)
+    return 0;
+  *next = current + sizeof(ompt_record_ompt_t);
+  return 1;
+}
+
 /*****************************************************************************
  * API inquiry for tool
  ****************************************************************************/
@@ -861,5 +1203,13 @@ static ompt_interface_fn_t ompt_fn_lookup(const char *s) {
 
   FOREACH_OMPT_INQUIRY_FN(ompt_interface_fn)
 
+  // Tracing of the host events
+  ompt_interface_fn(ompt_set_trace_ompt)
+  ompt_interface_fn(ompt_start_trace)
+  ompt_interface_fn(ompt_flush_trace)
+  ompt_interface_fn(ompt_stop_trace)
+  ompt_interface_fn(ompt_get_record_ompt)
+  ompt_interface_fn(ompt_advance_buffer_cursor)
+
   return NULL;
 }
@@ -16,6 +16,8 @@
 #include "ompt-event-specific.h"
 #include "omp-tools.h"
 
+#include <atomic>
+
 #define OMPT_VERSION 1
 
 #define _OMP_EXTERN extern "C"
@@ -83,6 +85,20 @@ typedef struct {
   void *idle_frame;
 } ompt_thread_info_t;
 
+// Buffer of the tool for the records of a thread, see ompt_start_trace
+typedef struct ompt_trace_buffer_s {
+  ompt_buffer_t *buffer;
+  size_t size;
+  size_t used;
+  // Held by the thread while it writes a record, and by whoever hands the
+  // buffer back to the tool
+  std::atomic<bool> busy;
+  // Links the buffers of the threads that have traced, which ompt_stop_trace
+  // hands back
+  bool listed;
+  struct ompt_trace_buffer_s *next;
+} ompt_trace_buffer_t;
+
 extern ompt_callbacks_internal_t ompt_callbacks;
 
 #if OMPT_SUPPORT && OMPT_OPTIONAL
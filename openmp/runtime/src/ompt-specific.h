@@ -53,6 +53,8 @@ static uint64_t __ompt_get_get_unique_id_internal();
 
 ompt_sync_region_t __ompt_get_barrier_kind(enum barrier_type, kmp_info_t *);
 
+void __ompt_end_trace_buffer(kmp_info_t *thr);
+
 /*****************************************************************************
  * macros
  ****************************************************************************/
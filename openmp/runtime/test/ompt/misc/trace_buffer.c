@@ -0,0 +1,118 @@
+// RUN: %libomp-compile-and-run | FileCheck %s
+// REQUIRES: ompt
+
+// The host events are traced into buffers of the tool instead of being
+// delivered through callbacks. The buffers are small so that every thread
+// fills several of them.
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include <omp-tools.h>
+
+#define NTASKS 1000
+#define BUFFER_RECORDS 16
+
+static ompt_start_trace_t ompt_start_trace;
+static ompt_stop_trace_t ompt_stop_trace;
+static ompt_get_record_ompt_t ompt_get_record_ompt;
+static ompt_advance_buffer_cursor_t ompt_advance_buffer_cursor;
+
+static int buffers, records, created, completed, sync_begin, sync_end;
+static uint64_t created_ids, completed_ids;
+
+static void on_buffer_request(int device_num, ompt_buffer_t **buffer,
+                              size_t *bytes) {
+  *bytes = BUFFER_RECORDS * sizeof(ompt_record_ompt_t);
+  *buffer = malloc(*bytes);
+}
+
+static void on_buffer_complete(int device_num, ompt_buffer_t *buffer,
+                               size_t bytes, ompt_buffer_cursor_t begin,
+                               int buffer_owned) {
+  __atomic_fetch_add(&buffers, 1, __ATOMIC_RELAXED);
+  if (bytes == 0) {
+    free(buffer);
+    return;
+  }
+  ompt_buffer_cursor_t cursor = begin;
+  do {
+    ompt_record_ompt_t *record = ompt_get_record_ompt(buffer, cursor);
+    __atomic_fetch_add(&records, 1, __ATOMIC_RELAXED);
+    switch (record->type) {
+    case ompt_callback_task_create:
+      if (record->record.task_create.flags & ompt_task_explicit) {
+        __atomic_fetch_add(&created, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_xor(&created_ids, record->record.task_create.new_task_id,
+                           __ATOMIC_RELAXED);
+      }
+      break;
+    case ompt_callback_task_schedule:
+      if (record->record.task_schedule.prior_task_status ==
+          ompt_task_complete) {
+        __atomic_fetch_add(&completed, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_xor(&completed_ids,
+                           record->record.task_schedule.prior_task_id,
+                           __ATOMIC_RELAXED);
+      }
+      break;
+    case ompt_callback_sync_region:
+      if (record->record.sync_region.endpoint == ompt_scope_begin)
+        __atomic_fetch_add(&sync_begin, 1, __ATOMIC_RELAXED);
+      else
+        __atomic_fetch_add(&sync_end, 1, __ATOMIC_RELAXED);
+      break;
+    default:
+      break;
+    }
+  } while (ompt_advance_buffer_cursor(NULL, buffer, bytes, cursor, &cursor));
+  if (buffer_owned)
+    free(buffer);
+}
+
+int main() {
+  int sum = 0;
+#pragma omp parallel num_threads(4)
+#pragma omp single
+  for (int i = 0; i < NTASKS; ++i) {
+#pragma omp task shared(sum)
+    {
+#pragma omp atomic
+      sum += i;
+    }
+  }
+
+  // CHECK: sum 499500
+  printf("sum %d\n", sum);
+  return 0;
+}
+
+static int ompt_initialize(ompt_function_lookup_t lookup,
+                           int initial_device_num, ompt_data_t *tool_data) {
+  ompt_start_trace = (ompt_start_trace_t)lookup("ompt_start_trace");
+  ompt_stop_trace = (ompt_stop_trace_t)lookup("ompt_stop_trace");
+  ompt_get_record_ompt = (ompt_get_record_ompt_t)lookup("ompt_get_record_ompt");
+  ompt_advance_buffer_cursor =
+      (ompt_advance_buffer_cursor_t)lookup("ompt_advance_buffer_cursor");
+  if (!ompt_start_trace(NULL, on_buffer_request, on_buffer_complete))
+    printf("tracing not started\n");
+  return 1;
+}
+
+static void ompt_finalize(ompt_data_t *tool_data) {
+  // CHECK: created 1000, completed 1000, same ids 1
+  printf("created %d, completed %d, same ids %d\n", created, completed,
+         created_ids == completed_ids);
+  // CHECK: sync regions closed 1
+  printf("sync regions closed %d\n", sync_begin > 0 && sync_begin == sync_end);
+  // CHECK: buffers full 1
+  printf("buffers full %d\n", records > 2 * NTASKS && buffers > 4);
+}
+
+ompt_start_tool_result_t *ompt_start_tool(unsigned int omp_version,
+                                          const char *runtime_version) {
+  static ompt_start_tool_result_t ompt_start_tool_result = {
+      &ompt_initialize, &ompt_finalize, 0};
+  return &ompt_start_tool_result;
+}
@@ -0,0 +1,104 @@
+// RUN: %libomp-compile-and-run | FileCheck %s
+// REQUIRES: ompt
+
+// Stopping the trace hands back the buffers of all the threads, including the
+// partly filled buffers of the workers that wait in the pool, and no event is
+// traced afterwards.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include <omp-tools.h>
+
+#define NTASKS 1000
+#define BUFFER_RECORDS 4096
+
+static ompt_start_trace_t ompt_start_trace;
+static ompt_stop_trace_t ompt_stop_trace;
+static ompt_get_record_ompt_t ompt_get_record_ompt;
+static ompt_advance_buffer_cursor_t ompt_advance_buffer_cursor;
+
+static int created, completed;
+
+static void on_buffer_request(int device_num, ompt_buffer_t **buffer,
+                              size_t *bytes) {
+  *bytes = BUFFER_RECORDS * sizeof(ompt_record_ompt_t);
+  *buffer = malloc(*bytes);
+}
+
+static void on_buffer_complete(int device_num, ompt_buffer_t *buffer,
+                               size_t bytes, ompt_buffer_cursor_t begin,
+                               int buffer_owned) {
+  if (bytes == 0) {
+    free(buffer);
+    return;
+  }
+  ompt_buffer_cursor_t cursor = begin;
+  do {
+    ompt_record_ompt_t *record = ompt_get_record_ompt(buffer, cursor);
+    if (record->type == ompt_callback_task_create &&
+        (record->record.task_create.flags & ompt_task_explicit))
+      __atomic_fetch_add(&created, 1, __ATOMIC_RELAXED);
+    else if (record->type == ompt_callback_task_schedule &&
+             record->record.task_schedule.prior_task_status ==
+                 ompt_task_complete)
+      __atomic_fetch_add(&completed, 1, __ATOMIC_RELAXED);
+  } while (ompt_advance_buffer_cursor(NULL, buffer, bytes, cursor, &cursor));
+  if (buffer_owned)
+    free(buffer);
+}
+
+static int run_tasks() {
+  int sum = 0;
+#pragma omp parallel num_threads(4)
+#pragma omp single
+  for (int i = 0; i < NTASKS; ++i) {
+#pragma omp task shared(sum)
+    {
+#pragma omp atomic
+      sum += i;
+    }
+  }
+  return sum;
+}
+
+int main() {
+  int sum = run_tasks();
+  int stopped = ompt_stop_trace(NULL);
+
+  // CHECK: sum 499500, stopped 1
+  printf("sum %d, stopped %d\n", sum, stopped);
+  // CHECK: created 1000, completed 1000
+  printf("created %d, completed %d\n", created, completed);
+
+  sum = run_tasks();
+  stopped = ompt_stop_trace(NULL);
+
+  // CHECK: sum 499500, stopped 0
+  printf("sum %d, stopped %d\n", sum, stopped);
+  return 0;
+}
+
+static int ompt_initialize(ompt_function_lookup_t lookup,
+                           int initial_device_num, ompt_data_t *tool_data) {
+  ompt_start_trace = (ompt_start_trace_t)lookup("ompt_start_trace");
+  ompt_stop_trace = (ompt_stop_trace_t)lookup("ompt_stop_trace");
+  ompt_get_record_ompt = (ompt_get_record_ompt_t)lookup("ompt_get_record_ompt");
+  ompt_advance_buffer_cursor =
+      (ompt_advance_buffer_cursor_t)lookup("ompt_advance_buffer_cursor");
+  if (!ompt_start_trace(NULL, on_buffer_request, on_buffer_complete))
+    printf("tracing not started\n");
+  return 1;
+}
+
+static void ompt_finalize(ompt_data_t *tool_data) {
+  // CHECK: after stop: created 1000, completed 1000
+  printf("after stop: created %d, completed %d\n", created, completed);
+}
+
+ompt_start_tool_result_t *ompt_start_tool(unsigned int omp_version,
+                                          const char *runtime_version) {
+  static ompt_start_tool_result_t ompt_start_tool_result = {
+      &ompt_initialize, &ompt_finalize, 0};
+  return &ompt_start_tool_result;
+}
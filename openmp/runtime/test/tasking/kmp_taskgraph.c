@@ -0,0 +1,193 @@
+// RUN: %libomp-compile && env OMP_NUM_THREADS=4 %libomp-run
+// RUN: %libomp-compile && env OMP_NUM_THREADS=1 %libomp-run
+#include <stdio.h>
+#include <omp.h>
+
+// Taskgraph record and replay, with the tasks created through the runtime
+// interface as a compiler would:
+//   for (step = 0; step < NSTEPS; ++step)
+//     taskgraph(TDG) {
+//       for (k = 0; k < NTASKS; ++k) {
+//         task firstprivate(k) depend(inout: x) priority(k)   x = x * 3 + k
+//         task firstprivate(k) depend(in: x) final(1)   seen[2 * k] = x
+//         task firstprivate(k) depend(in: x) final(1)   seen[2 * k + 1] = x
+//       }
+//     }
+// The replayed tasks must keep their priority and final clauses.
+// The region of TDG_WAIT has a taskwait, so it is executed every time.
+
+#define NSTEPS 10
+#define NTASKS 8
+#define TDG 1
+#define TDG_WAIT 2
+
+#define TASK_TIED 1
+#define TASK_FINAL 2
+#define TASK_PRIORITY 0x20
+
+typedef int kmp_int32;
+typedef long kmp_intptr_t;
+
+typedef struct ident {
+  void *dummy;
+} ident_t;
+
+typedef struct kmp_depend_info {
+  kmp_intptr_t base_addr;
+  size_t len;
+  struct {
+    unsigned char in : 1;
+    unsigned char out : 1;
+    unsigned char mtx : 1;
+  } flags;
+} kmp_depend_info_t;
+
+struct kmp_task;
+typedef kmp_int32 (*kmp_routine_entry_t)(kmp_int32, struct kmp_task *);
+
+typedef union kmp_cmplrdata {
+  kmp_int32 priority;
+  kmp_routine_entry_t destructors;
+} kmp_cmplrdata_t;
+
+typedef struct kmp_task {
+  void *shareds;
+  kmp_routine_entry_t routine;
+  kmp_int32 part_id;
+  kmp_cmplrdata_t data1;
+  kmp_cmplrdata_t data2;
+  // privates used in the task:
+  int k;
+} kmp_task_t;
+
+// shareds used in the task
+typedef struct shar {
+  long *x;
+  long *seen;
+} *pshareds;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+kmp_int32 __kmpc_global_thread_num(ident_t *);
+kmp_task_t *__kmpc_omp_task_alloc(ident_t *loc_ref, kmp_int32 gtid,
+                                  kmp_int32 flags, size_t sizeof_kmp_task_t,
+                                  size_t sizeof_shareds,
+                                  kmp_routine_entry_t task_entry);
+kmp_int32 __kmpc_omp_task_with_deps(ident_t *loc_ref, kmp_int32 gtid,
+                                    kmp_task_t *new_task, kmp_int32 ndeps,
+                                    kmp_depend_info_t *dep_list,
+                                    kmp_int32 ndeps_noalias,
+                                    kmp_depend_info_t *noalias_dep_list);
+kmp_int32 __kmpc_omp_taskwait(ident_t *loc_ref, kmp_int32 gtid);
+kmp_int32 __kmpc_start_record_task(ident_t *loc_ref, kmp_int32 gtid,
+                                   kmp_int32 tdg_id);
+void __kmpc_end_record_task(ident_t *loc_ref, kmp_int32 gtid,
+                            kmp_int32 tdg_id);
+#ifdef __cplusplus
+}
+#endif
+
+long x;
+long seen[2 * NTASKS];
+int body_runs[3];
+int wrong_clauses;
+
+int update_entry(kmp_int32 gtid, kmp_task_t *task) {
+  pshareds psh = (pshareds)task->shareds;
+  if (task->data2.priority != task->k || omp_in_final()) {
+#pragma omp atomic
+    wrong_clauses++;
+  }
+  *psh->x = *psh->x * 3 + task->k;
+  return 0;
+}
+
+int read_entry(kmp_int32 gtid, kmp_task_t *task) {
+  pshareds psh = (pshareds)task->shareds;
+  if (!omp_in_final()) {
+#pragma omp atomic
+    wrong_clauses++;
+  }
+  psh->seen[task->k] = *psh->x;
+  return 0;
+}
+
+void create_task(kmp_int32 gtid, kmp_routine_entry_t entry, int k, int out) {
+  kmp_depend_info_t dep = {0};
+  kmp_int32 flags = TASK_TIED | (out ? TASK_PRIORITY : TASK_FINAL);
+  kmp_task_t *task = __kmpc_omp_task_alloc(
+      NULL, gtid, flags, sizeof(kmp_task_t), sizeof(struct shar), entry);
+  pshareds psh = (pshareds)task->shareds;
+  psh->x = &x;
+  psh->seen = seen;
+  task->k = k;
+  if (out)
+    task->data2.priority = k;
+  dep.base_addr = (kmp_intptr_t)&x;
+  dep.len = sizeof(x);
+  dep.flags.in = 1;
+  dep.flags.out = out;
+  __kmpc_omp_task_with_deps(NULL, gtid, task, 1, &dep, 0, NULL);
+}
+
+void region(kmp_int32 gtid, kmp_int32 tdg_id) {
+  if (__kmpc_start_record_task(NULL, gtid, tdg_id)) {
+    body_runs[tdg_id]++;
+    for (int k = 0; k < NTASKS; ++k) {
+      create_task(gtid, update_entry, k, 1);
+      create_task(gtid, read_entry, 2 * k, 0);
+      create_task(gtid, read_entry, 2 * k + 1, 0);
+      if (tdg_id == TDG_WAIT && k == NTASKS / 2)
+        __kmpc_omp_taskwait(NULL, gtid);
+    }
+  }
+  __kmpc_end_record_task(NULL, gtid, tdg_id);
+}
+
+int check(int step) {
+  long expected = step;
+  int errors = 0;
+  for (int k = 0; k < NTASKS; ++k) {
+    expected = expected * 3 + k;
+    if (seen[2 * k] != expected || seen[2 * k + 1] != expected) {
+      printf("step %d task %d: saw %ld %ld, expected %ld\n", step, k,
+             seen[2 * k], seen[2 * k + 1], expected);
+      errors++;
+    }
+  }
+  return errors;
+}
+
+int main() {
+  int errors = 0;
+  int serial = omp_get_max_threads() == 1;
+  for (int tdg_id = TDG; tdg_id <= TDG_WAIT; ++tdg_id) {
+    for (int step = 0; step < NSTEPS; ++step) {
+      x = step;
+#pragma omp parallel
+#pragma omp single
+      region(__kmpc_global_thread_num(NULL), tdg_id);
+      errors += check(step);
+    }
+  }
+  // Serial teams do not track dependences, so they do not record either
+  if (body_runs[TDG] != (serial ? NSTEPS : 1)) {
+    printf("taskgraph %d executed %d times\n", TDG, body_runs[TDG]);
+    errors++;
+  }
+  if (body_runs[TDG_WAIT] != NSTEPS) {
+    printf("taskgraph %d executed %d times\n", TDG_WAIT, body_runs[TDG_WAIT]);
+    errors++;
+  }
+  if (wrong_clauses) {
+    printf("%d tasks ran without their clauses\n", wrong_clauses);
+    errors++;
+  }
+  if (errors) {
+    printf("failed\n");
+    return 1;
+  }
+  printf("passed\n");
+  return 0;
+}
@@ -0,0 +1,51 @@
+// RUN: %libomp-compile && env KMP_ENABLE_TASK_THROTTLING=0 %libomp-run
+// RUN: %libomp-compile && env KMP_ENABLE_TASK_THROTTLING=1 %libomp-run
+
+#include <stdio.h>
+#include <omp.h>
+
+/**
+ * Test the task deques under stealing. Every thread creates many more tasks
+ * than the initial size of its deque, and the tasks create children of their
+ * own, so that the deques grow while other threads steal from them, and stolen
+ * tasks push to the deques of the thieves. Every task must run exactly once.
+ */
+
+#define NUM_TASKS 5000
+#define NUM_CHILDREN 4
+
+int main() {
+  int runs[NUM_TASKS * (NUM_CHILDREN + 1)] = {0};
+  int errors = 0;
+  int i, j;
+
+  #pragma omp parallel num_threads(4) private(i, j)
+  {
+    int tid = omp_get_thread_num();
+    int nthreads = omp_get_num_threads();
+    for (i = tid; i < NUM_TASKS; i += nthreads) {
+      #pragma omp task firstprivate(i)
+      {
+        #pragma omp atomic
+        runs[i * (NUM_CHILDREN + 1)]++;
+        for (j = 1; j <= NUM_CHILDREN; ++j) {
+          #pragma omp task firstprivate(i, j)
+          {
+            #pragma omp atomic
+            runs[i * (NUM_CHILDREN + 1) + j]++;
+          }
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < NUM_TASKS * (NUM_CHILDREN + 1); ++i)
+    if (runs[i] != 1)
+      errors++;
+  if (errors) {
+    printf("failed: %d tasks did not run exactly once\n", errors);
+    return 1;
+  }
+  printf("passed\n");
+  return 0;
+}